@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for WorkStealingDeque and BoundedQueue
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include "Basics/BoundedQueue.h"
+#include "Basics/WorkStealingDeque.h"
+
+#include <thread>
+
+using namespace triagens::basics;
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct LockfreeQueuesSetup {
+  LockfreeQueuesSetup () {
+    BOOST_TEST_MESSAGE("setup LockfreeQueues");
+  }
+
+  ~LockfreeQueuesSetup () {
+    BOOST_TEST_MESSAGE("tear-down LockfreeQueues");
+  }
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief setup
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE (LockfreeQueuesTest, LockfreeQueuesSetup)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test deque push and pop by the owner
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_deque_push_pop) {
+  WorkStealingDeque<size_t> deque(4);
+  size_t value;
+
+  BOOST_CHECK_EQUAL(false, deque.pop(value));
+  BOOST_CHECK_EQUAL(false, deque.steal(value));
+  BOOST_CHECK_EQUAL((size_t) 0, deque.size());
+
+  // grows beyond the initial capacity
+  for (size_t i = 1; i <= 100; ++i) {
+    deque.push(i);
+  }
+
+  BOOST_CHECK_EQUAL((size_t) 100, deque.size());
+
+  // owner pops from the bottom
+  BOOST_CHECK_EQUAL(true, deque.pop(value));
+  BOOST_CHECK_EQUAL((size_t) 100, value);
+
+  // thieves steal from the top
+  BOOST_CHECK_EQUAL(true, deque.steal(value));
+  BOOST_CHECK_EQUAL((size_t) 1, value);
+
+  for (size_t i = 99; i >= 2; --i) {
+    BOOST_CHECK_EQUAL(true, deque.pop(value));
+    BOOST_CHECK_EQUAL(i, value);
+  }
+
+  BOOST_CHECK_EQUAL(false, deque.pop(value));
+  BOOST_CHECK_EQUAL((size_t) 0, deque.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that concurrent thieves and the owner see every item once
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_deque_concurrent_steal) {
+  size_t const n = 200000;
+  size_t const nrThieves = 4;
+
+  WorkStealingDeque<size_t> deque(16);
+  std::vector<std::atomic<int>> seen(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    seen[i] = 0;
+  }
+
+  std::atomic<bool> done(false);
+  std::atomic<size_t> taken(0);
+  std::vector<std::thread> thieves;
+
+  for (size_t t = 0; t < nrThieves; ++t) {
+    thieves.emplace_back([&] () {
+      size_t value;
+
+      while (! done.load() || deque.size() > 0) {
+        if (deque.steal(value)) {
+          seen[value]++;
+          taken++;
+        }
+      }
+    });
+  }
+
+  size_t value;
+
+  for (size_t i = 0; i < n; ++i) {
+    deque.push(i);
+
+    if (i % 3 == 0 && deque.pop(value)) {
+      seen[value]++;
+      taken++;
+    }
+  }
+
+  while (deque.pop(value)) {
+    seen[value]++;
+    taken++;
+  }
+
+  done = true;
+
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  BOOST_CHECK_EQUAL(n, taken.load());
+
+  for (size_t i = 0; i < n; ++i) {
+    BOOST_CHECK_EQUAL(1, seen[i].load());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test bounded queue order and capacity
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_bounded_queue_fifo) {
+  BoundedQueue<size_t> queue(5);
+  size_t value;
+
+  // capacity is rounded to a power of two
+  BOOST_CHECK_EQUAL((size_t) 8, queue.capacity());
+  BOOST_CHECK_EQUAL(false, queue.pop(value));
+
+  for (size_t round = 0; round < 3; ++round) {
+    for (size_t i = 0; i < 8; ++i) {
+      BOOST_CHECK_EQUAL(true, queue.push(i));
+    }
+
+    BOOST_CHECK_EQUAL(false, queue.push(8));
+    BOOST_CHECK_EQUAL((size_t) 8, queue.size());
+
+    for (size_t i = 0; i < 8; ++i) {
+      BOOST_CHECK_EQUAL(true, queue.pop(value));
+      BOOST_CHECK_EQUAL(i, value);
+    }
+
+    BOOST_CHECK_EQUAL(false, queue.pop(value));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test bounded queue with concurrent producers and consumers
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_bounded_queue_concurrent) {
+  size_t const perProducer = 50000;
+  size_t const nrProducers = 4;
+  size_t const nrConsumers = 4;
+
+  BoundedQueue<size_t> queue(1024);
+  std::vector<std::atomic<int>> seen(perProducer * nrProducers);
+
+  for (size_t i = 0; i < seen.size(); ++i) {
+    seen[i] = 0;
+  }
+
+  std::atomic<size_t> taken(0);
+  std::vector<std::thread> threads;
+
+  for (size_t p = 0; p < nrProducers; ++p) {
+    threads.emplace_back([&, p] () {
+      for (size_t i = 0; i < perProducer; ++i) {
+        while (! queue.push(p * perProducer + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for (size_t c = 0; c < nrConsumers; ++c) {
+    threads.emplace_back([&] () {
+      size_t value;
+
+      while (taken.load() < seen.size()) {
+        if (queue.pop(value)) {
+          seen[value]++;
+          taken++;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(seen.size(), taken.load());
+
+  for (size_t i = 0; i < seen.size(); ++i) {
+    BOOST_CHECK_EQUAL(1, seen[i].load());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate tests
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
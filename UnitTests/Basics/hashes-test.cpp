@@ -423,6 +423,65 @@ BOOST_AUTO_TEST_CASE (tst_crc32_utf8) {
   BOOST_CHECK_EQUAL((uint64_t) 2590070434ULL,   TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), buffer.c_str(), strlen(buffer.c_str()))));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test crc32c for simple strings
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_crc32c_simple) {
+  std::string buffer;
+
+  buffer = "";
+  BOOST_CHECK_EQUAL((uint64_t) 0ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+  BOOST_CHECK_EQUAL((uint64_t) 0ULL, TRI_FinalCrc32(TRI_BlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = "a";
+  BOOST_CHECK_EQUAL((uint64_t) 3251651376ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+  BOOST_CHECK_EQUAL((uint64_t) 3251651376ULL, TRI_FinalCrc32(TRI_BlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = "123456789";
+  BOOST_CHECK_EQUAL((uint64_t) 3808858755ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+
+  buffer = "The quick brown fox jumps over the lazy dog";
+  BOOST_CHECK_EQUAL((uint64_t) 576848900ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+
+  // test vectors from RFC 3720
+  buffer = std::string(32, '\0');
+  BOOST_CHECK_EQUAL((uint64_t) 2324772522ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+
+  buffer = std::string(32, '\xff');
+  BOOST_CHECK_EQUAL((uint64_t) 1655221059ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+
+  buffer.clear();
+  for (int i = 0; i < 32; ++i) {
+    buffer.push_back((char) i);
+  }
+  BOOST_CHECK_EQUAL((uint64_t) 1188919630ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test crc32c with different alignments and block splits
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_crc32c_blocks) {
+  std::string buffer;
+  for (int i = 0; i < 1024; ++i) {
+    buffer.push_back((char) ((i * 31) % 251));
+  }
+
+  uint32_t expected = TRI_Crc32CHashPointer(buffer.c_str(), buffer.size());
+
+  for (size_t split = 0; split < 17; ++split) {
+    uint32_t crc = TRI_InitialCrc32();
+    crc = TRI_BlockCrc32C(crc, buffer.c_str(), split);
+    crc = TRI_BlockCrc32C(crc, buffer.c_str() + split, buffer.size() - split);
+    BOOST_CHECK_EQUAL(expected, TRI_FinalCrc32(crc));
+  }
+
+  // the same data at an unaligned position must give the same result
+  std::string shifted = "xyz" + buffer;
+  BOOST_CHECK_EQUAL(expected, TRI_Crc32CHashPointer(shifted.c_str() + 3, buffer.size()));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
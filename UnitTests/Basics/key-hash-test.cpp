@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for document key hashing
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include "VocBase/primary-index.h"
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief key hash used by the primary index
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t KeyHash (char const* key) {
+  return TRI_HashKeyPrimaryIndex(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a minimal linear probing table of keys, laid out like the primary
+/// index, which stores the hash next to the key pointer
+////////////////////////////////////////////////////////////////////////////////
+
+struct KeyTable {
+  struct Slot {
+    uint64_t _hash;
+    char const* _key;
+  };
+
+  KeyTable (size_t size, uint64_t (*hash) (char const*))
+    : _slots(size),
+      _hash(hash) {
+
+    for (auto& slot : _slots) {
+      slot._key = nullptr;
+    }
+  }
+
+  void insert (char const* key) {
+    uint64_t const hash = _hash(key);
+    size_t i = hash % _slots.size();
+
+    while (_slots[i]._key != nullptr) {
+      i = (i + 1) % _slots.size();
+    }
+
+    _slots[i]._hash = hash;
+    _slots[i]._key = key;
+  }
+
+  char const* lookup (char const* key) const {
+    uint64_t const hash = _hash(key);
+    size_t i = hash % _slots.size();
+
+    while (_slots[i]._key != nullptr) {
+      if (_slots[i]._hash == hash && strcmp(_slots[i]._key, key) == 0) {
+        return _slots[i]._key;
+      }
+      i = (i + 1) % _slots.size();
+    }
+
+    return nullptr;
+  }
+
+  vector<Slot> _slots;
+  uint64_t (*_hash) (char const*);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fills a table with the keys and checks that all of them and no
+/// others can be found
+////////////////////////////////////////////////////////////////////////////////
+
+static void CheckLookups (vector<string> const& keys) {
+  KeyTable table(2 * keys.size() + 1, &KeyHash);
+
+  for (auto const& key : keys) {
+    table.insert(key.c_str());
+  }
+
+  for (auto const& key : keys) {
+    BOOST_CHECK_EQUAL(key.c_str(), table.lookup(key.c_str()));
+  }
+
+  for (auto const& key : keys) {
+    string const other = key + "x";
+    BOOST_CHECK(table.lookup(other.c_str()) == nullptr);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks that the keys do not produce colliding hashes
+////////////////////////////////////////////////////////////////////////////////
+
+static void CheckCollisions (vector<string> const& keys) {
+  vector<uint64_t> hashes;
+  hashes.reserve(keys.size());
+
+  for (auto const& key : keys) {
+    hashes.push_back(KeyHash(key.c_str()));
+  }
+
+  sort(hashes.begin(), hashes.end());
+
+  BOOST_CHECK(unique(hashes.begin(), hashes.end()) == hashes.end());
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct KeyHashSetup {
+  KeyHashSetup () {
+    BOOST_TEST_MESSAGE("setup key hash");
+  }
+
+  ~KeyHashSetup () {
+    BOOST_TEST_MESSAGE("tear-down key hash");
+  }
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief setup
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE (KeyHashTest, KeyHashSetup)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the new hash must handle all key lengths and tails
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_key_hash_lengths) {
+  string key;
+  vector<uint64_t> hashes;
+
+  for (size_t i = 0; i < 64; ++i) {
+    hashes.push_back(KeyHash(key.c_str()));
+    key.push_back('a' + (i % 26));
+  }
+
+  sort(hashes.begin(), hashes.end());
+
+  // keys of different length must not collide
+  BOOST_CHECK(unique(hashes.begin(), hashes.end()) == hashes.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief keys that only differ in their last byte
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_key_hash_tails) {
+  vector<string> keys;
+
+  for (size_t length = 1; length <= 40; ++length) {
+    for (char c = 'a'; c <= 'z'; ++c) {
+      keys.emplace_back(string(length - 1, '0') + c);
+    }
+  }
+
+  CheckCollisions(keys);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lookups with generated numeric keys
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_key_hash_numeric_keys) {
+  vector<string> keys;
+
+  for (uint64_t i = 0; i < 10000; ++i) {
+    keys.emplace_back(to_string(12345678 + i * 7));
+  }
+
+  CheckCollisions(keys);
+  CheckLookups(keys);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lookups with long user-defined keys
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_key_hash_long_keys) {
+  vector<string> keys;
+
+  for (uint64_t i = 0; i < 10000; ++i) {
+    keys.emplace_back("user-" + to_string(i) + "-some.longer.key@example.com");
+  }
+
+  CheckCollisions(keys);
+  CheckLookups(keys);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate tests
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
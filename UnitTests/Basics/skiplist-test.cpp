@@ -439,6 +439,85 @@ BOOST_AUTO_TEST_CASE (tst_unique_remove_all) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test bulk insertion of sorted values
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_unique_insert_sorted) {
+  triagens::basics::SkipList skiplist(CmpElmElm, CmpKeyElm, nullptr, FreeElm, true);
+  
+  std::vector<int*> values; 
+  std::vector<void*> docs; 
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(new int(i));
+    docs.push_back(values[i]);
+  }
+  
+  BOOST_CHECK_EQUAL(0, skiplist.insertSorted(docs));
+  
+  BOOST_CHECK_EQUAL(1000, skiplist.getNrUsed());
+
+  // check start and end node
+  BOOST_CHECK_EQUAL((void*) 0, skiplist.startNode()->prevNode());
+  BOOST_CHECK_EQUAL(values[0], skiplist.startNode()->nextNode()->document());
+  BOOST_CHECK_EQUAL(values[999], skiplist.prevNode(skiplist.endNode())->document());
+
+  // do a forward iteration
+  triagens::basics::SkipListNode* current = skiplist.startNode()->nextNode();
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL((void*) values[i], current->document());
+
+    if (i > 0) {
+      BOOST_CHECK_EQUAL(values[i - 1], current->prevNode()->document());
+    }
+    current = current->nextNode();
+  }
+  BOOST_CHECK_EQUAL((void*) 0, current);
+
+  // the upper levels must work for lookups, too
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(values[i], skiplist.lookup(values[i])->document());
+  }
+
+  int value = 1000;
+  BOOST_CHECK_EQUAL((void*) 0, skiplist.lookup(&value));
+
+  // appending to a non-empty list inserts one by one
+  int* extra = new int(-1);
+  std::vector<void*> more = { extra };
+  BOOST_CHECK_EQUAL(0, skiplist.insertSorted(more));
+  BOOST_CHECK_EQUAL(1001, skiplist.getNrUsed());
+  BOOST_CHECK_EQUAL(extra, skiplist.startNode()->nextNode()->document());
+
+  BOOST_CHECK_EQUAL(0, skiplist.remove(values[500]));
+  BOOST_CHECK_EQUAL((void*) 0, skiplist.lookup(values[500]));
+  BOOST_CHECK_EQUAL(values[499], skiplist.lookup(values[501])->prevNode()->document());
+  
+  // clean up
+  for (auto i : values) {
+    delete i;
+  }
+  delete extra;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test bulk insertion with duplicates
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_unique_insert_sorted_duplicate) {
+  triagens::basics::SkipList skiplist(CmpElmElm, CmpKeyElm, nullptr, FreeElm, true);
+  
+  int a = 1, b = 2, c = 2;
+  std::vector<void*> docs = { &a, &b, &c };
+  
+  BOOST_CHECK_EQUAL(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED, skiplist.insertSorted(docs));
+
+  // nothing must have been inserted
+  BOOST_CHECK_EQUAL(0, skiplist.getNrUsed());
+  BOOST_CHECK_EQUAL((void*) 0, skiplist.startNode()->nextNode());
+  BOOST_CHECK_EQUAL((void*) 0, skiplist.lookup(&a));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
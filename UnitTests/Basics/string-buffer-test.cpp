@@ -603,6 +603,60 @@ BOOST_AUTO_TEST_CASE (tst_reserve) {
   TRI_DestroyStringBuffer(&sb);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tst_compress
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_compress) {
+  TRI_string_buffer_t original;
+  TRI_InitStringBuffer(&original, TRI_CORE_MEM_ZONE);
+
+  for (size_t i = 0; i < 1000; ++i) {
+    TRI_AppendStringStringBuffer(&original, STR);
+    TRI_AppendUInt32StringBuffer(&original, (uint32_t) i);
+  }
+
+  // gzip, zlib and raw deflate data are all recognised. use a small buffer
+  // size to exercise the loops
+  for (int format = 0; format < 3; ++format) {
+    TRI_string_buffer_t compressed;
+    TRI_InitStringBuffer(&compressed, TRI_CORE_MEM_ZONE);
+    TRI_AppendString2StringBuffer(&compressed, TRI_BeginStringBuffer(&original), TRI_LengthStringBuffer(&original));
+
+    BOOST_CHECK_EQUAL(TRI_ERROR_NO_ERROR, TRI_CompressStringBuffer(&compressed, 100, 1, format == 0));
+    BOOST_CHECK(TRI_LengthStringBuffer(&compressed) < TRI_LengthStringBuffer(&original) / 4);
+
+    char const* data = TRI_BeginStringBuffer(&compressed);
+    size_t length = TRI_LengthStringBuffer(&compressed);
+
+    if (format == 0) {
+      BOOST_CHECK_EQUAL(0x1f, (int) (unsigned char) data[0]);
+      BOOST_CHECK_EQUAL(0x8b, (int) (unsigned char) data[1]);
+    }
+    else if (format == 2) {
+      // strip the zlib header and trailer
+      data += 2;
+      length -= 6;
+    }
+
+    TRI_string_buffer_t uncompressed;
+    TRI_InitStringBuffer(&uncompressed, TRI_CORE_MEM_ZONE);
+
+    BOOST_CHECK_EQUAL(TRI_ERROR_NO_ERROR, TRI_InflateStringBuffer(&uncompressed, data, length, 100));
+    BOOST_CHECK_EQUAL(TRI_LengthStringBuffer(&original), TRI_LengthStringBuffer(&uncompressed));
+    BOOST_CHECK_EQUAL(0, memcmp(TRI_BeginStringBuffer(&original), TRI_BeginStringBuffer(&uncompressed), TRI_LengthStringBuffer(&original)));
+
+    // truncated data is an error
+    TRI_ClearStringBuffer(&uncompressed);
+    BOOST_CHECK(TRI_ERROR_NO_ERROR != TRI_InflateStringBuffer(&uncompressed, data, length / 2, 100));
+
+    TRI_DestroyStringBuffer(&uncompressed);
+    TRI_DestroyStringBuffer(&compressed);
+  }
+
+  TRI_DestroyStringBuffer(&original);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tst_timing
 ////////////////////////////////////////////////////////////////////////////////
@@ -225,6 +225,113 @@ BOOST_AUTO_TEST_CASE (tst_5) {
   BOOST_CHECK(words == NULL);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that sort keys, also cut off ones, are ordered like the strings
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_sort_key_prefix) {
+  std::vector<std::string> values = {
+    "",
+    "a",
+    "A",
+    "b",
+    "ab",
+    "abc",
+    "Abc",
+    "äbc",
+    "Müller",
+    "Mueller",
+    "Muller",
+    "1",
+    "10",
+    "9",
+    " leading space",
+    "ü€ and more non-ascii characters",
+    // longer than the skiplist key prefix
+    "abcdefghijklmnopqrstuvwxyz",
+    "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz",
+    // equal up to the key prefix
+    "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyA",
+    "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyZ",
+    "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxy",
+    "Grüß Gott. Здравствуйте! 日本語,中文,한글 and some more text"
+  };
+
+  auto& helper = triagens::basics::Utf8Helper::DefaultUtf8Helper;
+
+  for (size_t size = 1; size <= 64; ++size) {
+    std::vector<std::vector<uint8_t>> keys;
+    std::vector<bool> complete;
+
+    for (auto const& value : values) {
+      std::vector<uint8_t> key(size + 1, 0xee);
+      size_t length = helper.sortKeyUtf8(value.c_str(), value.size(), key.data(), size);
+
+      BOOST_CHECK(length > 0);
+      // nothing is written beyond the buffer
+      BOOST_CHECK_EQUAL(0xee, (int) key[size]);
+
+      if (length <= size) {
+        // a complete key is zero-terminated
+        BOOST_CHECK_EQUAL(0, (int) key[length - 1]);
+        key.resize(length);
+        complete.push_back(true);
+      }
+      else {
+        key.resize(size);
+        complete.push_back(false);
+      }
+
+      keys.emplace_back(key);
+    }
+
+    for (size_t i = 0; i < values.size(); ++i) {
+      for (size_t j = 0; j < values.size(); ++j) {
+        int expected = helper.compareUtf8(values[i].c_str(), values[i].size(), values[j].c_str(), values[j].size());
+        expected = (expected < 0 ? -1 : (expected > 0 ? 1 : 0));
+
+        size_t length = (std::min)(keys[i].size(), keys[j].size());
+        int actual = memcmp(keys[i].data(), keys[j].data(), length);
+        actual = (actual < 0 ? -1 : (actual > 0 ? 1 : 0));
+
+        // complete keys always decide the order, cut off keys only if
+        // they differ
+        if ((complete[i] && complete[j]) || actual != 0) {
+          BOOST_CHECK_MESSAGE(expected == actual, "'" + values[i] + "' <=> '" + values[j] + "', size " + std::to_string(size));
+        }
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the sort key of a string that does not fit into the buffer
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_sort_key_length) {
+  auto& helper = triagens::basics::Utf8Helper::DefaultUtf8Helper;
+  std::string value = "Müller";
+
+  uint8_t full[128];
+  size_t length = helper.sortKeyUtf8(value.c_str(), value.size(), full, sizeof(full));
+  BOOST_CHECK(length > 1);
+  BOOST_CHECK(length <= sizeof(full));
+  BOOST_CHECK_EQUAL(0, (int) full[length - 1]);
+
+  for (size_t size = 1; size < length; ++size) {
+    uint8_t part[128];
+    size_t partLength = helper.sortKeyUtf8(value.c_str(), value.size(), part, size);
+
+    // the key does not fit, but the buffer holds its beginning
+    BOOST_CHECK(partLength > size);
+    BOOST_CHECK_EQUAL(0, memcmp(full, part, size));
+  }
+
+  uint8_t exact[128];
+  BOOST_CHECK_EQUAL(length, helper.sortKeyUtf8(value.c_str(), value.size(), exact, length));
+  BOOST_CHECK_EQUAL(0, memcmp(full, exact, length));
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
 
 // Local Variables:
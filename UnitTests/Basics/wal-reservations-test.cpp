@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for write-ahead log slot reservations
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+#include "Wal/Reservations.h"
+
+#include <thread>
+
+using namespace triagens::basics;
+using namespace triagens::wal;
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marker size used by the tests
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t const MarkerSize = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief size of a simulated logfile. it is small, so that the writers
+/// switch logfiles often
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t const LogfileSize = 64 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a simulated write-ahead log. it mimics what
+/// LogfileManager::allocateAndWrite does: reserve a slot and space in the
+/// logfile, copy the marker into it, and return the slot. when the logfile
+/// is full, writing continues at the start of the next one
+////////////////////////////////////////////////////////////////////////////////
+
+struct SimulatedLog {
+  struct Slot {
+    uint64_t _tick;
+    uint64_t _logfile;
+    uint32_t _offset;
+    std::atomic<bool> _returned;
+  };
+
+  explicit SimulatedLog (size_t numberOfSlots)
+    : _slots(numberOfSlots),
+      _memory(LogfileSize),
+      _reservations(numberOfSlots),
+      _lock(),
+      _logfile(0),
+      _tick(0) {
+
+    for (auto& slot : _slots) {
+      slot._returned = false;
+    }
+
+    uint32_t offset;
+    _reservations.lock(offset);
+    _reservations.unlock(0, 0);
+  }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief write a marker, reserving the slot lock-free
+////////////////////////////////////////////////////////////////////////////////
+
+  void write (char const* marker) {
+    while (true) {
+      uint64_t tick = 0;
+      uint64_t logfile = 0;
+
+      auto commit = [&] (size_t, uint32_t offset) -> bool {
+        if (offset + MarkerSize > LogfileSize) {
+          return false;
+        }
+        logfile = _logfile;
+        tick = ++_tick;
+        return true;
+      };
+
+      size_t slotIndex;
+      uint32_t offset;
+
+      if (_reservations.tryReserve(MarkerSize, commit, slotIndex, offset)) {
+        Slot* slot = &_slots[slotIndex];
+        slot->_tick    = tick;
+        slot->_logfile = logfile;
+        slot->_offset  = offset;
+
+        memcpy(&_memory[offset], marker, MarkerSize);
+
+        slot->_returned = true;
+        return;
+      }
+
+      // switch to the next logfile
+      MUTEX_LOCKER(_lock);
+
+      uint32_t const position = _reservations.lock(offset);
+
+      if (offset + MarkerSize > LogfileSize) {
+        ++_logfile;
+        offset = 0;
+      }
+
+      _reservations.unlock(position, offset);
+    }
+  }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check that slots, ticks and logfile positions were handed out in
+/// the same order and without gaps or overlaps
+////////////////////////////////////////////////////////////////////////////////
+
+  void check (size_t numberOfWrites) const {
+    uint64_t previousTick = 0;
+    uint64_t expectedLogfile = 0;
+    uint32_t expectedOffset = 0;
+
+    for (size_t i = 0; i < numberOfWrites; ++i) {
+      Slot const& slot = _slots[i];
+
+      BOOST_REQUIRE(slot._returned);
+      BOOST_REQUIRE(slot._tick > previousTick);
+
+      if (expectedOffset + MarkerSize > LogfileSize) {
+        ++expectedLogfile;
+        expectedOffset = 0;
+      }
+
+      BOOST_REQUIRE_EQUAL(expectedLogfile, slot._logfile);
+      BOOST_REQUIRE_EQUAL(expectedOffset, slot._offset);
+
+      previousTick = slot._tick;
+      expectedOffset += MarkerSize;
+    }
+  }
+
+  vector<Slot> _slots;
+  vector<char> _memory;
+  Reservations _reservations;
+  Mutex _lock;
+  std::atomic<uint64_t> _logfile;
+  std::atomic<uint64_t> _tick;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes concurrently with the given number of threads and checks
+/// the resulting slots
+////////////////////////////////////////////////////////////////////////////////
+
+static void CheckWrites (size_t nrThreads,
+                         size_t writesPerThread) {
+  SimulatedLog log(nrThreads * writesPerThread);
+  vector<std::thread> threads;
+
+  for (size_t t = 0; t < nrThreads; ++t) {
+    threads.emplace_back([&] () {
+      char marker[MarkerSize];
+      memset(marker, 'x', sizeof(marker));
+
+      for (size_t i = 0; i < writesPerThread; ++i) {
+        log.write(marker);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  log.check(nrThreads * writesPerThread);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct WalReservationsSetup {
+  WalReservationsSetup () {
+    BOOST_TEST_MESSAGE("setup wal reservations");
+  }
+
+  ~WalReservationsSetup () {
+    BOOST_TEST_MESSAGE("tear-down wal reservations");
+  }
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief setup
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE (WalReservationsTest, WalReservationsSetup)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief handout positions wrap around at a multiple of the number of slots
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_wal_reservations_wrap) {
+  Reservations reservations(7);
+
+  uint32_t offset;
+  BOOST_CHECK_EQUAL((uint32_t) 0, reservations.lock(offset));
+  BOOST_CHECK_EQUAL(static_cast<uint32_t>(Reservations::LockedOffset), offset);
+
+  uint32_t const last = (UINT32_MAX / 7) * 7 - 1;
+
+  BOOST_CHECK_EQUAL((size_t) 6, reservations.slotIndex(last));
+  BOOST_CHECK_EQUAL((uint32_t) 0, reservations.next(last));
+  BOOST_CHECK_EQUAL((size_t) 0, reservations.slotIndex(reservations.next(last)));
+
+  // locked reservations never call commit
+  size_t slotIndex;
+  auto commit = [] (size_t, uint32_t) -> bool {
+    BOOST_CHECK(false);
+    return true;
+  };
+
+  BOOST_CHECK_EQUAL(false, reservations.tryReserve(8, commit, slotIndex, offset));
+
+  reservations.unlock(last, 16);
+
+  auto accept = [] (size_t, uint32_t) -> bool {
+    return true;
+  };
+
+  BOOST_CHECK_EQUAL(true, reservations.tryReserve(8, accept, slotIndex, offset));
+  BOOST_CHECK_EQUAL((size_t) 6, slotIndex);
+  BOOST_CHECK_EQUAL((uint32_t) 16, offset);
+
+  BOOST_CHECK_EQUAL(true, reservations.tryReserve(8, accept, slotIndex, offset));
+  BOOST_CHECK_EQUAL((size_t) 0, slotIndex);
+  BOOST_CHECK_EQUAL((uint32_t) 24, offset);
+
+  BOOST_CHECK_EQUAL((uint32_t) 1, reservations.position());
+  BOOST_CHECK_EQUAL((uint32_t) 32, reservations.offset());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief concurrent writers get slots, ticks and logfile positions in the
+/// same order, across many logfile switches
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_wal_reservations_concurrent) {
+  size_t const writesPerThread = 5000;
+
+  for (size_t nrThreads = 1; nrThreads <= 8; nrThreads *= 2) {
+    CheckWrites(nrThreads, writesPerThread);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate tests
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro benchmark for document key hashing
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include "Basics/hashes.h"
+#include "Basics/system-functions.h"
+#include "VocBase/primary-index.h"
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief key hash used by the primary index up to 2.5 (FNV-1a)
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t OldKeyHash (char const* key) {
+  return TRI_FnvHashString(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief key hash used by the primary index
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t NewKeyHash (char const* key) {
+  return TRI_HashKeyPrimaryIndex(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a minimal linear probing table of keys, laid out like the primary
+/// index, which stores the hash next to the key pointer
+////////////////////////////////////////////////////////////////////////////////
+
+struct KeyTable {
+  struct Slot {
+    uint64_t _hash;
+    char const* _key;
+  };
+
+  KeyTable (size_t size, uint64_t (*hash) (char const*))
+    : _slots(size),
+      _hash(hash) {
+
+    for (auto& slot : _slots) {
+      slot._key = nullptr;
+    }
+  }
+
+  void insert (char const* key) {
+    uint64_t const hash = _hash(key);
+    size_t i = hash % _slots.size();
+
+    while (_slots[i]._key != nullptr) {
+      i = (i + 1) % _slots.size();
+    }
+
+    _slots[i]._hash = hash;
+    _slots[i]._key = key;
+  }
+
+  char const* lookup (char const* key) const {
+    uint64_t const hash = _hash(key);
+    size_t i = hash % _slots.size();
+
+    while (_slots[i]._key != nullptr) {
+      if (_slots[i]._hash == hash && strcmp(_slots[i]._key, key) == 0) {
+        return _slots[i]._key;
+      }
+      i = (i + 1) % _slots.size();
+    }
+
+    return nullptr;
+  }
+
+  vector<Slot> _slots;
+  uint64_t (*_hash) (char const*);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fills a table with the keys, looks them all up several times, and
+/// returns the number of lookups per second of the fastest round
+////////////////////////////////////////////////////////////////////////////////
+
+static double MeasureLookups (vector<string> const& keys,
+                              uint64_t (*hash) (char const*)) {
+  size_t const rounds = 10;
+  KeyTable table(2 * keys.size() + 1, hash);
+
+  for (auto const& key : keys) {
+    table.insert(key.c_str());
+  }
+
+  size_t found = 0;
+  double best = 0.0;
+
+  for (size_t i = 0; i < rounds; ++i) {
+    double const start = TRI_microtime();
+
+    for (auto const& key : keys) {
+      if (table.lookup(key.c_str()) != nullptr) {
+        ++found;
+      }
+    }
+
+    double const elapsed = TRI_microtime() - start;
+
+    if (i == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+
+  BOOST_CHECK_EQUAL(rounds * keys.size(), found);
+
+  return keys.size() / (best > 0.0 ? best : 1e-9);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compares old and new key hash with the given keys
+////////////////////////////////////////////////////////////////////////////////
+
+static void CompareHashes (char const* name,
+                           vector<string> const& keys) {
+  double const oldRate = MeasureLookups(keys, &OldKeyHash);
+  double const newRate = MeasureLookups(keys, &NewKeyHash);
+
+  BOOST_TEST_MESSAGE(name << ": fnv " << (uint64_t) oldRate << " lookups/s, fasthash "
+                     << (uint64_t) newRate << " lookups/s, speedup " << (newRate / oldRate));
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct KeyHashBenchmarkSetup {
+  KeyHashBenchmarkSetup () {
+    BOOST_TEST_MESSAGE("setup key hash benchmark");
+  }
+
+  ~KeyHashBenchmarkSetup () {
+    BOOST_TEST_MESSAGE("tear-down key hash benchmark");
+  }
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief setup
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE (KeyHashBenchmarkTest, KeyHashBenchmarkSetup)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lookup throughput with generated numeric keys
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_key_hash_numeric_keys) {
+  vector<string> keys;
+
+  for (uint64_t i = 0; i < 100000; ++i) {
+    keys.emplace_back(to_string(12345678 + i * 7));
+  }
+
+  CompareHashes("numeric keys", keys);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lookup throughput with long user-defined keys
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_key_hash_long_keys) {
+  vector<string> keys;
+
+  for (uint64_t i = 0; i < 100000; ++i) {
+    keys.emplace_back("user-" + to_string(i) + "-some.longer.key@example.com");
+  }
+
+  CompareHashes("long keys", keys);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate tests
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief benchmark for concurrent writes into the write-ahead log
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include "Basics/files.h"
+#include "Basics/random.h"
+#include "Basics/system-functions.h"
+#include "Rest/InitialiseRest.h"
+#include "VocBase/server.h"
+#include "Wal/LogfileManager.h"
+#include "Wal/Marker.h"
+
+#include <thread>
+
+using namespace triagens::wal;
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes markers with the given number of threads and returns the
+/// number of writes per second
+///
+/// every thread writes transaction begin markers with
+/// LogfileManager::allocateAndWrite. the collector ignores these markers, so
+/// the logfiles can be collected and removed without any collections
+////////////////////////////////////////////////////////////////////////////////
+
+static double MeasureWrites (size_t nrThreads,
+                             size_t writesPerThread) {
+  LogfileManager* logfileManager = LogfileManager::instance();
+  vector<std::thread> threads;
+  vector<size_t> errors(nrThreads, 0);
+
+  double const start = TRI_microtime();
+
+  for (size_t t = 0; t < nrThreads; ++t) {
+    threads.emplace_back([&, t] () {
+      BeginTransactionMarker marker(0, static_cast<TRI_voc_tid_t>(t + 1));
+      Slot::TickType previousTick = 0;
+
+      for (size_t i = 0; i < writesPerThread; ++i) {
+        SlotInfoCopy result = logfileManager->allocateAndWrite(marker, false);
+
+        // the ticks of one thread must increase
+        if (result.errorCode != TRI_ERROR_NO_ERROR || result.tick <= previousTick) {
+          ++errors[t];
+        }
+        previousTick = result.tick;
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  double const elapsed = TRI_microtime() - start;
+
+  for (size_t t = 0; t < nrThreads; ++t) {
+    BOOST_CHECK_EQUAL((size_t) 0, errors[t]);
+  }
+
+  return (nrThreads * writesPerThread) / (elapsed > 0.0 ? elapsed : 1e-9);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief starts a logfile manager in a temporary directory, for a server
+/// without any databases. the logfile manager can only be started once per
+/// process, so the suite has a single test case
+////////////////////////////////////////////////////////////////////////////////
+
+struct WalBenchmarkSetup {
+  WalBenchmarkSetup ()
+    : _directory(),
+      _server(nullptr) {
+
+    BOOST_TEST_MESSAGE("setup wal benchmark");
+
+    TRIAGENS_REST_INITIALISE(boost::unit_test::framework::master_test_suite().argc,
+                             boost::unit_test::framework::master_test_suite().argv);
+
+    _directory = "/tmp/arangobenchmark-" + to_string((uint64_t) TRI_microtime()) + to_string(TRI_UInt32Random());
+
+    long systemError;
+    string errorMessage;
+    BOOST_REQUIRE_EQUAL(TRI_ERROR_NO_ERROR, TRI_CreateDirectory(_directory.c_str(), systemError, errorMessage));
+
+    TRI_InitServerGlobals();
+
+    _server = TRI_CreateServer();
+    BOOST_REQUIRE(_server != nullptr);
+
+    TRI_vocbase_defaults_t defaults;
+    memset(&defaults, 0, sizeof(defaults));
+
+    BOOST_REQUIRE_EQUAL(TRI_ERROR_NO_ERROR, TRI_InitServer(_server, nullptr, nullptr, _directory.c_str(), _directory.c_str(), &defaults, true, false));
+
+    LogfileManager::initialise(&_directory, _server);
+
+    LogfileManager* logfileManager = LogfileManager::instance();
+    BOOST_REQUIRE(logfileManager->prepare());
+    BOOST_REQUIRE(logfileManager->start());
+    BOOST_REQUIRE(logfileManager->open());
+  }
+
+  ~WalBenchmarkSetup () {
+    BOOST_TEST_MESSAGE("tear-down wal benchmark");
+
+    // stops the WAL threads after a final flush
+    delete LogfileManager::instance();
+
+    TRI_FreeServer(_server);
+    TRI_FreeServerGlobals();
+
+    // let's be sure we delete the right stuff
+    assert(_directory.size() > 10);
+    assert(_directory.compare(0, 21, "/tmp/arangobenchmark-") == 0);
+
+    TRI_RemoveDirectory(_directory.c_str());
+
+    TRIAGENS_REST_SHUTDOWN;
+  }
+
+  string _directory;
+  TRI_server_t* _server;
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief setup
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE (WalBenchmarkTest, WalBenchmarkSetup)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief write throughput of allocateAndWrite with an increasing number of
+/// threads
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_wal_allocate_and_write_scaling) {
+  size_t const writesPerThread = 100000;
+  double singleRate = 0.0;
+
+  for (size_t nrThreads = 1; nrThreads <= 16; nrThreads *= 2) {
+    double const rate = MeasureWrites(nrThreads, writesPerThread);
+
+    if (nrThreads == 1) {
+      singleRate = rate;
+    }
+
+    BOOST_TEST_MESSAGE(nrThreads << " threads: " << (uint64_t) rate
+                       << " writes/s, " << (rate / singleRate) << " times the single thread rate");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate tests
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
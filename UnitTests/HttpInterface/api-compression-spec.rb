@@ -0,0 +1,230 @@
+# coding: utf-8
+
+require 'rspec'
+require 'socket'
+require 'stringio'
+require 'zlib'
+require 'base64'
+require 'arangodb.rb'
+require 'arangomultipartbody.rb'
+
+################################################################################
+## sends a single request over a plain socket and reads the response
+##
+## the response is returned as it is on the wire, so the body is not inflated
+################################################################################
+
+def send_raw_request (method, url, headers, body = "")
+  parts = $address.split(':', 2)
+  socket = TCPSocket.open(parts[0], parts[1] || 8529)
+
+  begin
+    request = "#{method} #{url} HTTP/1.1\r\nHost: #{parts[0]}\r\nConnection: close\r\n"
+    if $user
+      request << "Authorization: Basic " + Base64.strict_encode64("#{$user}:#{$password}") + "\r\n"
+    end
+    headers.each do |key, value|
+      request << "#{key}: #{value}\r\n"
+    end
+    request << "Content-Length: #{body.bytesize}\r\n\r\n"
+    request << body
+
+    socket.send request, 0
+
+    response = "".force_encoding("BINARY")
+    while true
+      rs = IO.select([socket], [ ], [ ], 5)
+      break if rs === nil
+
+      partial = socket.recv(8192)
+      break if partial.nil? or partial.length == 0
+
+      response << partial
+    end
+  ensure
+    socket.close
+  end
+
+  header, body = response.split("\r\n\r\n", 2)
+  lines = header.split("\r\n")
+
+  result = { :status => lines[0].slice(9, 3).to_i, :headers => { }, :body => body || "" }
+  lines.drop(1).each do |line|
+    key, value = line.split(":", 2)
+    result[:headers][key.strip.downcase] = value.strip
+  end
+
+  if result[:headers].has_key?('content-length')
+    result[:body] = result[:body].slice(0, result[:headers]['content-length'].to_i)
+  end
+
+  result
+end
+
+def gzip_string (value)
+  io = StringIO.new("".force_encoding("BINARY"))
+  writer = Zlib::GzipWriter.new(io)
+  writer.write value
+  writer.close
+  io.string
+end
+
+def gunzip_string (value)
+  Zlib::GzipReader.new(StringIO.new(value)).read
+end
+
+describe ArangoDB do
+  prefix = "api-compression"
+
+  context "dealing with compressed HTTP bodies:" do
+
+################################################################################
+## compression of responses
+################################################################################
+
+    context "compressing responses:", :ssl => true do
+
+      # a response that is bigger than the default compression threshold
+      query = "{ \"query\" : \"FOR i IN 1..2000 RETURN CONCAT('value', i)\", \"batchSize\" : 2000 }"
+      expected = (1..2000).map { |i| "value#{i}" }
+
+      it "returns an uncompressed response without accept-encoding" do
+        doc = send_raw_request("POST", "/_api/cursor", { }, query)
+
+        doc[:status].should eq(201)
+        doc[:headers].has_key?('content-encoding').should eq(false)
+        JSON.parse(doc[:body])['result'].should eq(expected)
+      end
+
+      it "returns a gzip-compressed response" do
+        doc = send_raw_request("POST", "/_api/cursor", { "Accept-Encoding" => "gzip" }, query)
+
+        doc[:status].should eq(201)
+        doc[:headers]['content-encoding'].should eq("gzip")
+        doc[:body].bytesize.should eq(doc[:headers]['content-length'].to_i)
+        JSON.parse(gunzip_string(doc[:body]))['result'].should eq(expected)
+      end
+
+      it "returns a deflate-compressed response" do
+        doc = send_raw_request("POST", "/_api/cursor", { "Accept-Encoding" => "deflate" }, query)
+
+        doc[:status].should eq(201)
+        doc[:headers]['content-encoding'].should eq("deflate")
+        JSON.parse(Zlib::Inflate.inflate(doc[:body]))['result'].should eq(expected)
+      end
+
+      it "prefers gzip if both encodings are accepted" do
+        doc = send_raw_request("POST", "/_api/cursor", { "Accept-Encoding" => "deflate, gzip" }, query)
+
+        doc[:status].should eq(201)
+        doc[:headers]['content-encoding'].should eq("gzip")
+        JSON.parse(gunzip_string(doc[:body]))['result'].should eq(expected)
+      end
+
+      it "does not use an encoding with q=0" do
+        doc = send_raw_request("POST", "/_api/cursor", { "Accept-Encoding" => "gzip;q=0" }, query)
+
+        doc[:status].should eq(201)
+        doc[:headers].has_key?('content-encoding').should eq(false)
+        JSON.parse(doc[:body])['result'].should eq(expected)
+
+        doc = send_raw_request("POST", "/_api/cursor", { "Accept-Encoding" => "gzip;q=0, deflate;q=0.5" }, query)
+
+        doc[:status].should eq(201)
+        doc[:headers]['content-encoding'].should eq("deflate")
+        JSON.parse(Zlib::Inflate.inflate(doc[:body]))['result'].should eq(expected)
+
+        doc = send_raw_request("POST", "/_api/cursor", { "Accept-Encoding" => "gzip;q=0.0, deflate; q=0" }, query)
+
+        doc[:status].should eq(201)
+        doc[:headers].has_key?('content-encoding').should eq(false)
+        JSON.parse(doc[:body])['result'].should eq(expected)
+      end
+
+      it "does not compress small responses" do
+        doc = send_raw_request("GET", "/_api/version", { "Accept-Encoding" => "gzip, deflate" })
+
+        doc[:status].should eq(200)
+        doc[:headers].has_key?('content-encoding').should eq(false)
+        JSON.parse(doc[:body])['server'].should eq("arango")
+      end
+
+    end
+
+################################################################################
+## compressed request bodies
+################################################################################
+
+    context "compressed request bodies:" do
+
+      before do
+        @cn = "UnitTestsCompression"
+        ArangoDB.drop_collection(@cn)
+        ArangoDB.create_collection(@cn, false)
+      end
+
+      after do
+        ArangoDB.drop_collection(@cn)
+      end
+
+      it "accepts a gzip-compressed import" do
+        cmd = "/_api/import?collection=#{@cn}&type=documents"
+        body = (0...1000).map { |i| "{ \"_key\" : \"test#{i}\", \"value\" : #{i} }" }.join("\n")
+
+        doc = ArangoDB.log_post("#{prefix}-import-gzip", cmd, :body => gzip_string(body), :headers => { "Content-Encoding" => "gzip" })
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['created'].should eq(1000)
+        doc.parsed_response['errors'].should eq(0)
+
+        ArangoDB.size_collection(@cn).should eq(1000)
+
+        doc = ArangoDB.log_get("#{prefix}-import-gzip", "/_api/document/#{@cn}/test999")
+        doc.code.should eq(200)
+        doc.parsed_response['value'].should eq(999)
+      end
+
+      it "accepts a deflate-compressed import" do
+        cmd = "/_api/import?collection=#{@cn}&type=documents"
+        body = (0...10).map { |i| "{ \"value\" : #{i} }" }.join("\n")
+
+        doc = ArangoDB.log_post("#{prefix}-import-deflate", cmd, :body => Zlib::Deflate.deflate(body), :headers => { "Content-Encoding" => "deflate" })
+
+        doc.code.should eq(201)
+        doc.parsed_response['created'].should eq(10)
+        ArangoDB.size_collection(@cn).should eq(10)
+      end
+
+      it "accepts a gzip-compressed batch" do
+        cmd = "/_api/batch"
+        multipart = ArangoMultipartBody.new()
+
+        (0...10).each do |i|
+          multipart.addPart("POST", "/_api/document?collection=#{@cn}", { }, "{ \"_key\" : \"test#{i}\" }")
+        end
+        multipart.addPart("GET", "/_api/document/#{@cn}/test0", { }, "")
+
+        doc = ArangoDB.log_post("#{prefix}-batch-gzip", cmd, :body => gzip_string(multipart.to_s), :format => :plain, :headers => { "Content-Type" => "multipart/form-data; boundary=" + multipart.getBoundary, "Content-Encoding" => "gzip" })
+
+        doc.code.should eq(200)
+
+        parts = multipart.getParts(multipart.getBoundary, doc.response.body)
+        parts.length.should eq(11)
+
+        parts.each_with_index do |part, i|
+          if i < 10
+            part[:status].should eq(202)
+          else
+            part[:status].should eq(200)
+          end
+        end
+
+        ArangoDB.size_collection(@cn).should eq(10)
+      end
+
+    end
+
+  end
+
+end
@@ -474,6 +474,171 @@ describe ArangoDB do
       end
     end
 
+################################################################################
+## streaming cursors
+################################################################################
+
+    context "handling a streaming cursor:" do
+      before do
+        @cn = "users"
+        ArangoDB.drop_collection(@cn)
+        @cid = ArangoDB.create_collection(@cn, false)
+
+        (0...10).each{|i|
+          ArangoDB.post("/_api/document?collection=#{@cid}", :body => "{ \"n\" : #{i} }")
+        }
+      end
+
+      after do
+        ArangoDB.drop_collection(@cn)
+      end
+
+      it "creates a streaming cursor and fetches all batches" do
+        cmd = api
+        body = "{ \"query\" : \"FOR u IN #{@cn} RETURN u.n\", \"batchSize\" : 3, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-create-stream", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(201)
+        doc.parsed_response['id'].should be_kind_of(String)
+        doc.parsed_response['id'].should match(@reId)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['count'].should be_nil
+        doc.parsed_response['extra'].should be_nil
+        doc.parsed_response['result'].length.should eq(3)
+
+        id = doc.parsed_response['id']
+        values = doc.parsed_response['result']
+
+        cmd = api + "/#{id}"
+        (0...2).each{|i|
+          doc = ArangoDB.log_put("#{prefix}-create-stream-cont", cmd)
+
+          doc.code.should eq(200)
+          doc.parsed_response['error'].should eq(false)
+          doc.parsed_response['id'].should eq(id)
+          doc.parsed_response['hasMore'].should eq(true)
+          doc.parsed_response['extra'].should be_nil
+          doc.parsed_response['result'].length.should eq(3)
+          values.concat(doc.parsed_response['result'])
+        }
+        
+        doc = ArangoDB.log_put("#{prefix}-create-stream-last", cmd)
+
+        doc.code.should eq(200)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['id'].should be_nil
+        doc.parsed_response['hasMore'].should eq(false)
+        doc.parsed_response['result'].length.should eq(1)
+        doc.parsed_response['extra']['stats']['scannedFull'].should eq(10)
+        doc.parsed_response['extra']['warnings'].should eq([ ])
+        values.concat(doc.parsed_response['result'])
+
+        values.sort.should eq((0...10).to_a)
+        
+        doc = ArangoDB.log_put("#{prefix}-create-stream-exhausted", cmd)
+        
+        doc.code.should eq(404)
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(1600)
+      end
+
+      it "creates a streaming cursor and deletes it in the middle" do
+        cmd = api
+        body = "{ \"query\" : \"FOR u IN #{@cn} RETURN u.n\", \"batchSize\" : 2, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-create-stream-delete", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['result'].length.should eq(2)
+
+        id = doc.parsed_response['id']
+
+        cmd = api + "/#{id}"
+        doc = ArangoDB.log_put("#{prefix}-create-stream-delete-cont", cmd)
+        
+        doc.code.should eq(200)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['result'].length.should eq(2)
+
+        doc = ArangoDB.log_delete("#{prefix}-create-stream-delete", cmd)
+
+        doc.code.should eq(202)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['id'].should eq(id)
+        
+        doc = ArangoDB.log_put("#{prefix}-create-stream-delete-deleted", cmd)
+        
+        doc.code.should eq(404)
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(1600)
+
+        # the collection must not be locked anymore
+        doc = ArangoDB.post("/_api/document?collection=#{@cid}", :body => "{ \"n\" : 10 }")
+        doc.code.should eq(202)
+      end
+
+      it "propagates errors raised by a later batch" do
+        cmd = api
+        body = "{ \"query\" : \"FOR i IN 1..10 RETURN i == 5 ? FAIL('stream failure') : i\", \"batchSize\" : 2, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-create-stream-error", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['result'].should eq([ 1, 2 ])
+
+        id = doc.parsed_response['id']
+
+        cmd = api + "/#{id}"
+        doc = ArangoDB.log_put("#{prefix}-create-stream-error-cont", cmd)
+        
+        doc.code.should eq(200)
+        doc.parsed_response['result'].should eq([ 3, 4 ])
+        
+        doc = ArangoDB.log_put("#{prefix}-create-stream-error-fail", cmd)
+        
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(1569)
+        doc.parsed_response['errorMessage'].should include("stream failure")
+        
+        doc = ArangoDB.log_put("#{prefix}-create-stream-error-gone", cmd)
+        
+        doc.code.should eq(404)
+        doc.parsed_response['errorNum'].should eq(1600)
+      end
+
+      it "lists and kills a streaming query" do
+        cmd = api
+        query = "FOR u IN #{@cn} RETURN u.n"
+        body = "{ \"query\" : \"#{query}\", \"batchSize\" : 2, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-create-stream-kill", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.parsed_response['hasMore'].should eq(true)
+
+        id = doc.parsed_response['id']
+
+        doc = ArangoDB.get("/_api/query/current")
+        doc.code.should eq(200)
+        queries = doc.parsed_response.select{|q| q['query'] == query }
+        queries.length.should eq(1)
+        
+        doc = ArangoDB.log_delete("#{prefix}-create-stream-kill", "/_api/query/#{queries[0]['id']}")
+        doc.code.should eq(200)
+
+        # the query is either torn down on the next fetch or has already been
+        # released by the registry
+        doc = ArangoDB.log_put("#{prefix}-create-stream-kill-cont", api + "/#{id}")
+        doc.parsed_response['error'].should eq(true)
+        [ 1500, 1600 ].should include(doc.parsed_response['errorNum'])
+        
+        doc = ArangoDB.get("/_api/query/current")
+        doc.parsed_response.select{|q| q['query'] == query }.length.should eq(0)
+      end
+    end
+
 ################################################################################
 ## checking a query
 ################################################################################
@@ -112,6 +112,31 @@ describe ArangoDB do
         doc.parsed_response['ignored'].should eq(0)
       end
       
+      it "using brackets and escapes in strings" do
+        cmd = api + "?collection=#{@cn}&createCollection=true&type=array"
+        body =  "[ { \"a\" : \"]},[{\" }, { \"b\" : \"\\\"],\\\\\", \"c\" : [ { }, [ ] ] }, { \"d\" : \"\\\\\" } ]"
+        doc = ArangoDB.log_post("#{prefix}-array-brackets", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['created'].should eq(3)
+        doc.parsed_response['errors'].should eq(0)
+      end
+      
+      it "unterminated array" do
+        cmd = api + "?collection=#{@cn}&createCollection=true&type=array"
+        body =  "[ { \"this doc\" : \"isValid\" },\n{ \"again\" : \"this is ok\" }\n"
+        doc = ArangoDB.log_post("#{prefix}-array-unterminated", cmd, :body => body)
+
+        doc.code.should eq(400)
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(400)
+
+        doc = ArangoDB.log_get("#{prefix}-array-unterminated", "/_api/collection/#{@cn}/count")
+        doc.code.should eq(200)
+        doc.parsed_response['count'].should eq(0)
+      end
+      
       it "invalid documents" do
         cmd = api + "?collection=#{@cn}&createCollection=true&type=array"
         body =  "[ { \"this doc\" : \"isValid\" },\n{ \"this one\" : is not },\n{ \"again\" : \"this is ok\" },\n\n{ \"but this isn't\" }\n ]"
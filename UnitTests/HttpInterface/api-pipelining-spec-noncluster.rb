@@ -26,6 +26,91 @@ def read_socket (socket)
   response
 end
 
+################################################################################
+## splits pipelined responses. methods holds the method of each request, as
+## the responses to HEAD requests have a content-length but no body. returns
+## the complete responses and the incomplete one, if any
+################################################################################
+
+def parse_responses (data, methods)
+  responses = [ ]
+  position = 0
+
+  while responses.length < methods.length
+    header_end = data.index("\r\n\r\n", position)
+    break if header_end == nil
+
+    lines = data[position...header_end].split("\r\n")
+    response = { :status => lines[0].slice(9, 3).to_i, :headers => { }, :body => "", :complete => false }
+    lines.drop(1).each do |line|
+      key, value = line.split(":", 2)
+      response[:headers][key.strip.downcase] = value.strip
+    end
+
+    position = header_end + 4
+
+    if methods[responses.length] == "HEAD"
+      response[:complete] = true
+    elsif response[:headers]['transfer-encoding'] == "chunked"
+      response[:chunks] = [ ]
+
+      while true
+        line_end = data.index("\r\n", position)
+        break if line_end == nil
+
+        length = data[position...line_end].to_i(16)
+        break if data.bytesize < line_end + 2 + length + 2
+
+        position = line_end + 2 + length + 2
+
+        if length == 0
+          response[:complete] = true
+          break
+        end
+
+        response[:chunks].push(data[(line_end + 2)...(line_end + 2 + length)])
+      end
+
+      response[:body] = response[:chunks].join("")
+    else
+      length = response[:headers]['content-length'].to_i
+      if data.bytesize >= position + length
+        response[:body] = data[position...(position + length)]
+        response[:complete] = true
+        position += length
+      end
+    end
+
+    if not response[:complete]
+      return [ responses, response ]
+    end
+
+    responses.push(response)
+  end
+
+  [ responses, nil ]
+end
+
+################################################################################
+## reads from the socket until the responses are complete or until
+## nothing has been received for a while
+################################################################################
+
+def read_responses (socket, data, methods, timeout = 5)
+  while true
+    responses, partial = parse_responses(data, methods)
+    return [ responses, partial ] if responses.length == methods.length
+
+    rs = IO.select([socket], [ ], [ ], timeout)
+    return [ responses, partial ] if rs === nil
+
+    chunk = socket.recv(8192)
+    return [ responses, partial ] if chunk.nil? or chunk.length == 0
+
+    data << chunk
+  end
+end
+
 
 describe ArangoDB, :ssl => true do
 
@@ -160,6 +245,148 @@ describe ArangoDB, :ssl => true do
       
     end
 
+################################################################################
+## checking the order of the responses
+################################################################################
+
+    context "answering in order:" do
+      
+      before do
+        @cn = "UnitTestsCollection"
+
+        ArangoDB.drop_collection(@cn)
+        ArangoDB.create_collection(@cn, false)
+
+        (0...20).each do |i|
+          ArangoDB.post("/_api/document?collection=#{@cn}", :body => "{ \"_key\" : \"test#{i}\", \"value\" : #{i} }")
+        end
+
+        @data = "".force_encoding("BINARY")
+      end
+
+      after do
+        ArangoDB.drop_collection(@cn)
+      end
+
+      it "checks get and head requests" do
+        methods = [ ]
+        requests = ""
+
+        (0...20).each do |i|
+          method = (i % 3 == 1) ? "HEAD" : "GET"
+          methods.push(method)
+          requests << "#{method} /_api/document/#{@cn}/test#{i} HTTP/1.1\r\n\r\n"
+        end
+        methods.push("GET")
+        requests << "GET /_api/document/#{@cn}/test999 HTTP/1.1\r\n\r\n"
+
+        @socket.send requests, 0
+
+        responses, partial = read_responses(@socket, @data, methods)
+        responses.length.should eq(methods.length)
+
+        (0...20).each do |i|
+          responses[i][:status].should eq(200)
+          responses[i][:headers]['etag'].should_not be_nil
+
+          if methods[i] == "HEAD"
+            responses[i][:body].should eq("")
+          else
+            doc = JSON.parse(responses[i][:body])
+            doc['_key'].should eq("test#{i}")
+            doc['value'].should eq(i)
+          end
+        end
+
+        responses[20][:status].should eq(404)
+      end
+
+      it "checks a post request in the middle" do
+        methods = [ "GET", "HEAD", "GET", "POST", "GET", "HEAD", "GET" ]
+        body = "{ \"_key\" : \"new\", \"value\" : 99 }"
+
+        requests = ""
+        requests << "GET /_api/document/#{@cn}/new HTTP/1.1\r\n\r\n"
+        requests << "HEAD /_api/document/#{@cn}/test1 HTTP/1.1\r\n\r\n"
+        requests << "GET /_api/document/#{@cn}/test2 HTTP/1.1\r\n\r\n"
+        requests << "POST /_api/document?collection=#{@cn} HTTP/1.1\r\nContent-Length: #{body.length}\r\n\r\n#{body}"
+        requests << "GET /_api/document/#{@cn}/new HTTP/1.1\r\n\r\n"
+        requests << "HEAD /_api/document/#{@cn}/new HTTP/1.1\r\n\r\n"
+        requests << "GET /_api/document/#{@cn}/test3 HTTP/1.1\r\n\r\n"
+
+        @socket.send requests, 0
+
+        responses, partial = read_responses(@socket, @data, methods)
+        responses.length.should eq(methods.length)
+
+        # the document does not exist before the post
+        responses[0][:status].should eq(404)
+        responses[1][:status].should eq(200)
+        responses[1][:body].should eq("")
+        responses[2][:status].should eq(200)
+        JSON.parse(responses[2][:body])['value'].should eq(2)
+        responses[3][:status].should eq(202)
+        JSON.parse(responses[3][:body])['_key'].should eq("new")
+
+        # the requests after the post see the document
+        responses[4][:status].should eq(200)
+        JSON.parse(responses[4][:body])['value'].should eq(99)
+        responses[5][:status].should eq(200)
+        responses[5][:body].should eq("")
+        responses[6][:status].should eq(200)
+        JSON.parse(responses[6][:body])['value'].should eq(3)
+      end
+
+      it "checks a chunked response in the middle" do
+        methods = [ "GET", "GET", "GET", "HEAD", "GET" ]
+
+        requests = ""
+        requests << "GET /_api/document/#{@cn}/test0 HTTP/1.1\r\n\r\n"
+        requests << "GET /_admin/long_echo HTTP/1.1\r\n\r\n"
+        requests << "GET /_api/document/#{@cn}/test1 HTTP/1.1\r\n\r\n"
+        requests << "HEAD /_api/document/#{@cn}/test2 HTTP/1.1\r\n\r\n"
+        requests << "GET /_api/version HTTP/1.1\r\n\r\n"
+
+        @socket.send requests, 0
+
+        # the chunked response is not finished, so the responses after it
+        # are held back
+        responses, partial = read_responses(@socket, @data, methods, 2)
+        responses.length.should eq(1)
+        JSON.parse(responses[0][:body])['value'].should eq(0)
+
+        partial.should_not be_nil
+        partial[:status].should eq(200)
+        partial[:headers]['transfer-encoding'].should eq("chunked")
+        partial[:chunks].length.should eq(1)
+
+        echo = JSON.parse(partial[:chunks][0])
+        echo['url'].should eq("/_admin/long_echo")
+
+        # send another chunk and finish the response
+        task = "{ \"offset\" : 0, \"params\" : { \"id\" : \"#{echo['client']['id']}\" }, " +
+               "\"command\" : \"(function (params) { var internal = require('internal'); " +
+               "internal.sendChunk(params.id, 'second chunk'); internal.sendChunk(params.id, ''); })(params)\" }"
+        doc = ArangoDB.post("/_api/tasks", :body => task)
+        doc.code.should eq(200)
+
+        responses, partial = read_responses(@socket, @data, methods)
+        responses.length.should eq(methods.length)
+        partial.should be_nil
+
+        responses[1][:chunks].length.should eq(2)
+        responses[1][:chunks][1].should eq("second chunk")
+
+        responses[2][:status].should eq(200)
+        JSON.parse(responses[2][:body])['value'].should eq(1)
+        responses[3][:status].should eq(200)
+        responses[3][:body].should eq("")
+        responses[4][:status].should eq(200)
+        JSON.parse(responses[4][:body])['server'].should eq("arango")
+      end
+      
+    end
+
   end
 
 end
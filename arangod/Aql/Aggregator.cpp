@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, aggregate functions for COLLECT ... AGGREGATE
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/Aggregator.h"
+#include "Aql/Query.h"
+#include "Basics/Exceptions.h"
+#include "Basics/json-utilities.h"
+
+using namespace triagens::aql;
+using Json = triagens::basics::Json;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 struct Aggregator
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an aggregator for the function with the given name
+////////////////////////////////////////////////////////////////////////////////
+
+Aggregator* Aggregator::fromTypeString (Query* query,
+                                        triagens::arango::AqlTransaction* trx,
+                                        std::string const& type) {
+  if (type == "LENGTH" || type == "COUNT") {
+    return new AggregatorLength(query, trx);
+  }
+  if (type == "MIN") {
+    return new AggregatorMinMax(query, trx, true);
+  }
+  if (type == "MAX") {
+    return new AggregatorMinMax(query, trx, false);
+  }
+  if (type == "SUM") {
+    return new AggregatorSum(query, trx, false);
+  }
+  if (type == "AVERAGE" || type == "AVG") {
+    return new AggregatorSum(query, trx, true);
+  }
+
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_INVALID_AGGREGATE_EXPRESSION, "unknown aggregate function '" + type + "'");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a function can be used in COLLECT ... AGGREGATE
+////////////////////////////////////////////////////////////////////////////////
+
+bool Aggregator::isSupported (std::string const& type) {
+  return (type == "LENGTH" ||
+          type == "COUNT" ||
+          type == "MIN" ||
+          type == "MAX" ||
+          type == "SUM" ||
+          type == "AVERAGE" ||
+          type == "AVG");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register a warning for a value of the wrong type
+////////////////////////////////////////////////////////////////////////////////
+
+void Aggregator::registerInvalidArgument () {
+  std::string const msg = triagens::basics::Exception::FillExceptionString(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, name());
+  _query->registerWarning(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, msg.c_str());
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           struct AggregatorLength
+// -----------------------------------------------------------------------------
+
+void AggregatorLength::reset () {
+  _count = 0;
+}
+
+void AggregatorLength::reduce (AqlValue const&,
+                               TRI_document_collection_t const*) {
+  ++_count;
+}
+
+AqlValue AggregatorLength::stealValue () {
+  uint64_t const count = _count;
+  reset();
+
+  return AqlValue(new Json(static_cast<double>(count)));
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           struct AggregatorMinMax
+// -----------------------------------------------------------------------------
+
+AggregatorMinMax::~AggregatorMinMax () {
+  reset();
+}
+
+void AggregatorMinMax::reset () {
+  if (_value != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _value);
+    _value = nullptr;
+  }
+}
+
+void AggregatorMinMax::reduce (AqlValue const& value,
+                               TRI_document_collection_t const* collection) {
+  if (value.isNull(true)) {
+    // null values are ignored, as in MIN() and MAX()
+    return;
+  }
+
+  TRI_json_t const* json;
+  Json converted;
+
+  if (value._type == AqlValue::JSON) {
+    json = value._json->json();
+  }
+  else {
+    // documents, ranges etc. need to be converted first
+    converted = value.toJson(_trx, collection);
+    json = converted.json();
+  }
+
+  if (_value != nullptr) {
+    int const cmp = TRI_CompareValuesJson(json, _value);
+
+    if ((_isMin && cmp >= 0) || (! _isMin && cmp <= 0)) {
+      return;
+    }
+  }
+
+  TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  reset();
+  _value = copy;
+}
+
+AqlValue AggregatorMinMax::stealValue () {
+  if (_value == nullptr) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  auto result = new Json(TRI_UNKNOWN_MEM_ZONE, _value);
+  _value = nullptr;
+
+  return AqlValue(result);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                              struct AggregatorSum
+// -----------------------------------------------------------------------------
+
+void AggregatorSum::reset () {
+  _sum = 0.0;
+  _count = 0;
+  _invalid = false;
+}
+
+void AggregatorSum::reduce (AqlValue const& value,
+                            TRI_document_collection_t const*) {
+  if (_invalid || value.isNull(true)) {
+    // null values are ignored, as in SUM() and AVERAGE()
+    return;
+  }
+
+  if (! value.isNumber()) {
+    // the whole group has no sum
+    _invalid = true;
+    registerInvalidArgument();
+    return;
+  }
+
+  double const number = value._json->json()->_value._number;
+
+  if (! std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
+    _sum += number;
+    ++_count;
+  }
+}
+
+AqlValue AggregatorSum::stealValue () {
+  double const sum = _sum;
+  uint64_t const count = _count;
+  bool const invalid = _invalid;
+  reset();
+
+  if (invalid ||
+      std::isnan(sum) || sum == HUGE_VAL || sum == -HUGE_VAL) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  if (_isAverage) {
+    if (count == 0) {
+      return AqlValue(new Json(Json::Null));
+    }
+    return AqlValue(new Json(sum / static_cast<double>(count)));
+  }
+
+  return AqlValue(new Json(sum));
+}
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, aggregate functions for COLLECT ... AGGREGATE
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_AGGREGATOR_H
+#define ARANGODB_AQL_AGGREGATOR_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+
+struct TRI_json_t;
+
+namespace triagens {
+  namespace aql {
+
+    class Query;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 struct Aggregator
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief running aggregate for one group. the values of the group are fed
+/// into the aggregator one by one, so it only needs constant memory
+////////////////////////////////////////////////////////////////////////////////
+
+    struct Aggregator {
+
+      Aggregator () = delete;
+      Aggregator (Aggregator const&) = delete;
+      Aggregator& operator= (Aggregator const&) = delete;
+
+      Aggregator (Query* query,
+                  triagens::arango::AqlTransaction* trx)
+        : _query(query),
+          _trx(trx) {
+      }
+
+      virtual ~Aggregator () {
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief name of the aggregate function
+////////////////////////////////////////////////////////////////////////////////
+
+      virtual char const* name () const = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reset the aggregator for a new group
+////////////////////////////////////////////////////////////////////////////////
+
+      virtual void reset () = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add a value of the group
+////////////////////////////////////////////////////////////////////////////////
+
+      virtual void reduce (AqlValue const&,
+                           TRI_document_collection_t const*) = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the result for the group and reset the aggregator
+////////////////////////////////////////////////////////////////////////////////
+
+      virtual AqlValue stealValue () = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an aggregator for the function with the given name
+////////////////////////////////////////////////////////////////////////////////
+
+      static Aggregator* fromTypeString (Query*,
+                                         triagens::arango::AqlTransaction*,
+                                         std::string const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a function can be used in COLLECT ... AGGREGATE
+////////////////////////////////////////////////////////////////////////////////
+
+      static bool isSupported (std::string const&);
+
+      protected:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register a warning for a value of the wrong type
+////////////////////////////////////////////////////////////////////////////////
+
+      void registerInvalidArgument ();
+
+        Query* _query;
+
+        triagens::arango::AqlTransaction* _trx;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           struct AggregatorLength
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief LENGTH / COUNT: number of values in the group
+////////////////////////////////////////////////////////////////////////////////
+
+    struct AggregatorLength final : public Aggregator {
+
+      AggregatorLength (Query* query,
+                        triagens::arango::AqlTransaction* trx)
+        : Aggregator(query, trx),
+          _count(0) {
+      }
+
+      char const* name () const override final {
+        return "LENGTH";
+      }
+
+      void reset () override final;
+      void reduce (AqlValue const&,
+                   TRI_document_collection_t const*) override final;
+      AqlValue stealValue () override final;
+
+      uint64_t _count;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           struct AggregatorMinMax
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief MIN / MAX: smallest or greatest non-null value of the group
+////////////////////////////////////////////////////////////////////////////////
+
+    struct AggregatorMinMax final : public Aggregator {
+
+      AggregatorMinMax (Query* query,
+                        triagens::arango::AqlTransaction* trx,
+                        bool isMin)
+        : Aggregator(query, trx),
+          _value(nullptr),
+          _isMin(isMin) {
+      }
+
+      ~AggregatorMinMax ();
+
+      char const* name () const override final {
+        return _isMin ? "MIN" : "MAX";
+      }
+
+      void reset () override final;
+      void reduce (AqlValue const&,
+                   TRI_document_collection_t const*) override final;
+      AqlValue stealValue () override final;
+
+      TRI_json_t* _value;
+      bool const _isMin;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                              struct AggregatorSum
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief SUM / AVERAGE: sum or average of the non-null values of the group
+////////////////////////////////////////////////////////////////////////////////
+
+    struct AggregatorSum final : public Aggregator {
+
+      AggregatorSum (Query* query,
+                     triagens::arango::AqlTransaction* trx,
+                     bool isAverage)
+        : Aggregator(query, trx),
+          _sum(0.0),
+          _count(0),
+          _invalid(false),
+          _isAverage(isAverage) {
+      }
+
+      char const* name () const override final {
+        return _isAverage ? "AVERAGE" : "SUM";
+      }
+
+      void reset () override final;
+      void reduce (AqlValue const&,
+                   TRI_document_collection_t const*) override final;
+      AqlValue stealValue () override final;
+
+      double _sum;
+      uint64_t _count;
+      bool _invalid;
+      bool const _isAverage;
+    };
+
+  }  // namespace triagens::aql
+}  // namespace triagens
+
+#endif
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
@@ -27,11 +27,312 @@
 
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionNode.h"
+#include "ShapedJson/Legends.h"
 
 using namespace triagens::aql;
 
 using Json = triagens::basics::Json;
 using JsonHelper = triagens::basics::JsonHelper;
+using StringBuffer = triagens::basics::StringBuffer;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief magic number and version of the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+  uint32_t const BinaryMagic   = 0x424c5141; // "AQLB"
+  uint32_t const BinaryVersion = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief entry types of the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+  enum BinaryEntryType : uint8_t {
+    BINARY_EMPTY     = 0,
+    BINARY_RANGE     = 1,
+    BINARY_JSON      = 2,
+    BINARY_SHAPED    = 3,
+    BINARY_REFERENCE = 4
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief value types of Json values in the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+  enum BinaryJsonType : uint8_t {
+    BINARY_JSON_NULL   = 0,
+    BINARY_JSON_FALSE  = 1,
+    BINARY_JSON_TRUE   = 2,
+    BINARY_JSON_NUMBER = 3,
+    BINARY_JSON_STRING = 4,
+    BINARY_JSON_ARRAY  = 5,
+    BINARY_JSON_OBJECT = 6
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief appends values in binary format to a string buffer. values are
+/// written in host byte order, all servers of a cluster must share it
+////////////////////////////////////////////////////////////////////////////////
+
+  class BinaryWriter {
+
+    public:
+
+      explicit BinaryWriter (StringBuffer& buffer)
+        : _buffer(buffer),
+          _start(buffer.length()) {
+      }
+
+      template<typename T>
+      void append (T value) {
+        _buffer.appendText(reinterpret_cast<char const*>(&value), sizeof(T));
+      }
+
+      void appendBytes (char const* value,
+                        size_t length) {
+        _buffer.appendText(value, length);
+      }
+
+      void appendString (char const* value,
+                         size_t length) {
+        append<uint32_t>(static_cast<uint32_t>(length));
+        _buffer.appendText(value, length);
+      }
+
+      void appendString (std::string const& value) {
+        appendString(value.c_str(), value.size());
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pad the data written so far to a multiple of 8 bytes
+////////////////////////////////////////////////////////////////////////////////
+
+      void align () {
+        while ((_buffer.length() - _start) % 8 != 0) {
+          _buffer.appendChar('\0');
+        }
+      }
+
+      void appendJson (TRI_json_t const* json) {
+        if (json == nullptr) {
+          append<uint8_t>(BINARY_JSON_NULL);
+          return;
+        }
+
+        switch (json->_type) {
+          case TRI_JSON_UNUSED:
+          case TRI_JSON_NULL: {
+            append<uint8_t>(BINARY_JSON_NULL);
+            break;
+          }
+
+          case TRI_JSON_BOOLEAN: {
+            append<uint8_t>(json->_value._boolean ? BINARY_JSON_TRUE : BINARY_JSON_FALSE);
+            break;
+          }
+
+          case TRI_JSON_NUMBER: {
+            append<uint8_t>(BINARY_JSON_NUMBER);
+            append<double>(json->_value._number);
+            break;
+          }
+
+          case TRI_JSON_STRING:
+          case TRI_JSON_STRING_REFERENCE: {
+            append<uint8_t>(BINARY_JSON_STRING);
+            appendString(json->_value._string.data, json->_value._string.length - 1);
+            break;
+          }
+
+          case TRI_JSON_ARRAY: {
+            size_t const n = TRI_LengthVector(&json->_value._objects);
+            append<uint8_t>(BINARY_JSON_ARRAY);
+            append<uint32_t>(static_cast<uint32_t>(n));
+
+            for (size_t i = 0; i < n; ++i) {
+              appendJson(static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i)));
+            }
+            break;
+          }
+
+          case TRI_JSON_OBJECT: {
+            size_t const n = TRI_LengthVector(&json->_value._objects);
+            append<uint8_t>(BINARY_JSON_OBJECT);
+            append<uint32_t>(static_cast<uint32_t>(n / 2));
+
+            for (size_t i = 0; i < n; i += 2) {
+              auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+              appendString(key->_value._string.data, key->_value._string.length - 1);
+              appendJson(static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i + 1)));
+            }
+            break;
+          }
+        }
+      }
+
+    private:
+
+      StringBuffer& _buffer;
+
+      size_t const _start;
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads values written by a BinaryWriter, throws if the data is
+/// truncated or corrupt
+////////////////////////////////////////////////////////////////////////////////
+
+  class BinaryReader {
+
+    public:
+
+      BinaryReader (char const* data,
+                    size_t length)
+        : _start(data),
+          _position(data),
+          _end(data + length) {
+      }
+
+      template<typename T>
+      T read () {
+        check(sizeof(T));
+        T value;
+        memcpy(&value, _position, sizeof(T));
+        _position += sizeof(T);
+        return value;
+      }
+
+      char const* readBytes (size_t length) {
+        check(length);
+        char const* result = _position;
+        _position += length;
+        return result;
+      }
+
+      char const* readString (size_t& length) {
+        length = read<uint32_t>();
+        return readBytes(length);
+      }
+
+      std::string readString () {
+        size_t length;
+        char const* value = readString(length);
+        return std::string(value, length);
+      }
+
+      void align () {
+        size_t const offset = static_cast<size_t>(_position - _start) % 8;
+
+        if (offset != 0) {
+          readBytes(8 - offset);
+        }
+      }
+
+      size_t position () const {
+        return static_cast<size_t>(_position - _start);
+      }
+
+      TRI_json_t* readJson () {
+        TRI_json_t* json = nullptr;
+
+        switch (read<uint8_t>()) {
+          case BINARY_JSON_NULL: {
+            json = TRI_CreateNullJson(TRI_UNKNOWN_MEM_ZONE);
+            break;
+          }
+
+          case BINARY_JSON_FALSE: {
+            json = TRI_CreateBooleanJson(TRI_UNKNOWN_MEM_ZONE, false);
+            break;
+          }
+
+          case BINARY_JSON_TRUE: {
+            json = TRI_CreateBooleanJson(TRI_UNKNOWN_MEM_ZONE, true);
+            break;
+          }
+
+          case BINARY_JSON_NUMBER: {
+            json = TRI_CreateNumberJson(TRI_UNKNOWN_MEM_ZONE, read<double>());
+            break;
+          }
+
+          case BINARY_JSON_STRING: {
+            size_t length;
+            char const* value = readString(length);
+            json = TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, value, length);
+            break;
+          }
+
+          case BINARY_JSON_ARRAY: {
+            size_t const n = read<uint32_t>();
+            Json array(TRI_UNKNOWN_MEM_ZONE, TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, n));
+
+            if (array.json() == nullptr) {
+              THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+              if (TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, array.json(), readJson()) != TRI_ERROR_NO_ERROR) {
+                THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+              }
+            }
+
+            json = array.steal();
+            break;
+          }
+
+          case BINARY_JSON_OBJECT: {
+            size_t const n = read<uint32_t>();
+            Json object(TRI_UNKNOWN_MEM_ZONE, TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, 2 * n));
+
+            if (object.json() == nullptr) {
+              THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+              std::string const key(readString());
+              TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, object.json(), key.c_str(), readJson());
+            }
+
+            json = object.steal();
+            break;
+          }
+
+          default: {
+            THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                           "found invalid value in binary AqlItemBlock");
+          }
+        }
+
+        if (json == nullptr) {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+        }
+
+        return json;
+      }
+
+    private:
+
+      void check (size_t length) const {
+        if (static_cast<size_t>(_end - _position) < length) {
+          THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                         "binary AqlItemBlock is truncated");
+        }
+      }
+
+      char const* _start;
+
+      char const* _position;
+
+      char const* const _end;
+  };
+
+}
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                      AqlItemBlock
@@ -171,6 +472,187 @@ AqlItemBlock::AqlItemBlock (Json const& json) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the block from its binary format (see toBinary), note that
+/// this can throw
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock::AqlItemBlock (char const* data,
+                            size_t length) {
+  // legends and shaped data are read in place and must be 8-byte aligned
+  std::unique_ptr<uint64_t[]> aligned;
+  if (reinterpret_cast<uintptr_t>(data) % 8 != 0) {
+    aligned.reset(new uint64_t[length / 8 + 1]);
+    memcpy(aligned.get(), data, length);
+    data = reinterpret_cast<char const*>(aligned.get());
+  }
+
+  BinaryReader reader(data, length);
+
+  if (reader.read<uint32_t>() != BinaryMagic || 
+      reader.read<uint32_t>() != BinaryVersion) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid binary AqlItemBlock");
+  }
+
+  _nrItems = static_cast<size_t>(reader.read<uint64_t>());
+  if (_nrItems == 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "nrItems must be > 0");
+  }
+
+  _nrRegs = static_cast<RegisterId>(reader.read<uint64_t>());
+  if (_nrRegs > ExecutionNode::MaxRegisterId) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid nrRegs");
+  }
+
+  // read the legends and collection names of the columns
+  std::vector<std::unique_ptr<triagens::basics::LegendReader>> legends;
+  std::vector<std::string> collectionNames;
+  legends.reserve(_nrRegs);
+  collectionNames.reserve(_nrRegs);
+
+  for (RegisterId column = 0; column < _nrRegs; column++) {
+    size_t const legendLength = static_cast<size_t>(reader.read<uint64_t>());
+
+    if (legendLength > 0) {
+      legends.emplace_back(new triagens::basics::LegendReader(reader.readBytes(legendLength)));
+      // the shapes are converted into Json in our memory zone
+      legends.back()->_memoryZone = TRI_UNKNOWN_MEM_ZONE;
+    }
+    else {
+      legends.emplace_back(nullptr);
+    }
+
+    collectionNames.emplace_back(reader.readString());
+    reader.align();
+  }
+
+  // Initialize the data vector:
+  if (_nrRegs > 0) {
+    _data.resize(_nrItems * _nrRegs);
+    _docColls.reserve(_nrRegs);
+    for (size_t i = 0; i < _nrRegs; ++i) {
+      _docColls.emplace_back(nullptr);
+    }
+  }
+
+  // Now put in the data:
+  uint64_t emptyRun = 0;
+  std::vector<AqlValue> madeHere;
+
+  try {
+    for (RegisterId column = 0; column < _nrRegs; column++) {
+      for (size_t i = 0; i < _nrItems; i++) {
+        if (emptyRun > 0) {
+          emptyRun--;
+          continue;
+        }
+
+        uint8_t const type = reader.read<uint8_t>();
+
+        if (type == BINARY_EMPTY) {
+          emptyRun = reader.read<uint64_t>();
+          if (emptyRun == 0) {
+            THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                           "found invalid empty run");
+          }
+          emptyRun--;
+        }
+        else if (type == BINARY_RANGE) {
+          int64_t low = reader.read<int64_t>();
+          int64_t high = reader.read<int64_t>();
+          AqlValue a(low, high);
+          try {
+            setValue(i, column, a);
+          }
+          catch (...) {
+            a.destroy();
+            throw;
+          }
+        }
+        else if (type == BINARY_JSON || type == BINARY_SHAPED) {
+          TRI_json_t* json;
+
+          if (type == BINARY_JSON) {
+            json = reader.readJson();
+          }
+          else {
+            // a document, which is converted into Json using the shapes
+            // of the column's legend
+            TRI_shape_sid_t const sid = reader.read<uint64_t>();
+            TRI_voc_rid_t const rid = reader.read<uint64_t>();
+            std::string const key(reader.readString());
+            bool const isEdge = (reader.read<uint8_t>() != 0);
+            std::string from;
+            std::string to;
+            if (isEdge) {
+              from = reader.readString();
+              to = reader.readString();
+            }
+            size_t const dataLength = static_cast<size_t>(reader.read<uint64_t>());
+            reader.align();
+
+            TRI_shaped_json_t shaped;
+            shaped._sid = sid;
+            shaped._data.data = const_cast<char*>(reader.readBytes(dataLength));
+            shaped._data.length = static_cast<uint32_t>(dataLength);
+            reader.align();
+
+            if (legends[column] == nullptr) {
+              THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                             "found document without legend");
+            }
+
+            Json document(TRI_UNKNOWN_MEM_ZONE, TRI_JsonShapedJson(legends[column].get(), &shaped));
+            if (document.json() == nullptr) {
+              THROW_ARANGO_EXCEPTION(TRI_ERROR_LEGEND_INCOMPLETE);
+            }
+
+            // append the internal attributes, see AqlValue::toJson
+            document(TRI_VOC_ATTRIBUTE_ID, Json(collectionNames[column] + "/" + key));
+            document(TRI_VOC_ATTRIBUTE_REV, Json(std::to_string(rid)));
+            document(TRI_VOC_ATTRIBUTE_KEY, Json(key));
+
+            if (isEdge) {
+              document(TRI_VOC_ATTRIBUTE_FROM, Json(from));
+              document(TRI_VOC_ATTRIBUTE_TO, Json(to));
+            }
+
+            json = document.steal();
+          }
+
+          AqlValue a(new Json(TRI_UNKNOWN_MEM_ZONE, json));
+          try {
+            setValue(i, column, a);  // if this throws, a is destroyed again
+          }
+          catch (...) {
+            a.destroy();
+            throw;
+          }
+          madeHere.emplace_back(a);
+        }
+        else if (type == BINARY_REFERENCE) {
+          size_t const n = static_cast<size_t>(reader.read<uint64_t>());
+          if (n >= madeHere.size()) {
+            THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                           "found invalid reference");
+          }
+          setValue(i, column, madeHere[n]);
+          // If this throws, all is OK, because it was already put into
+          // the block elsewhere.
+        }
+        else {
+          THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                         "found undefined data value");
+        }
+      }
+    }
+  }
+  catch (...) {
+    destroy();
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the block, used in the destructor and elsewhere
 ////////////////////////////////////////////////////////////////////////////////
@@ -615,6 +1097,215 @@ Json AqlItemBlock::toJson (triagens::arango::AqlTransaction* trx) const {
   return json;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toBinary, transfer a whole AqlItemBlock to a compact binary format,
+/// which avoids stringifying and parsing Json when blocks are sent between
+/// cluster nodes. All numbers are written in host byte order.
+///
+///  uint32 magic ("AQLB"), uint32 version
+///  uint64 number of rows, uint64 number of registers
+///  for each register:
+///    uint64 length of the legend, followed by the legend (see Legends.cpp)
+///      containing the shapes of all documents in this column, or 0
+///    string with the name of the column's collection (or empty)
+///    padding to a multiple of 8 bytes
+///  the entries, columnwise like in toJson, each starting with a uint8 type:
+///    BINARY_EMPTY followed by a uint64 N means a run of N empty entries
+///    BINARY_RANGE followed by two int64 LOW and HIGH means a range
+///    BINARY_JSON followed by a Json value in binary form (type byte, then
+///      a double, a string, or a uint32 count followed by the members)
+///    BINARY_SHAPED means a document: uint64 shape id, uint64 revision,
+///      string key, uint8 edge flag (followed by strings _from and _to if
+///      set), uint64 length of the shaped data, then the shaped data from
+///      the document's marker, aligned to 8 bytes
+///    BINARY_REFERENCE followed by a uint64 N means the same value as the
+///      N-th BINARY_JSON or BINARY_SHAPED entry, counted from 0
+/// Strings are written as uint32 length followed by the bytes. Documents are
+/// sent without converting them into Json, the receiver converts them using
+/// the legend.
+////////////////////////////////////////////////////////////////////////////////
+
+void AqlItemBlock::toBinary (triagens::arango::AqlTransaction* trx,
+                             StringBuffer& buffer) const {
+  // the entries are written first, because this determines the shapes
+  // that go into the legends
+  StringBuffer data(TRI_UNKNOWN_MEM_ZONE);
+  BinaryWriter dataWriter(data);
+
+  std::vector<std::unique_ptr<triagens::basics::JsonLegend>> legends;
+  legends.resize(_nrRegs);
+
+  std::unordered_map<AqlValue, uint64_t> table;   // remember duplicates
+  uint64_t pos = 0;   // number of values written
+
+  uint64_t emptyCount = 0;  // here we count runs of empty AqlValues
+
+  auto commitEmpties = [&] () {  // this commits an empty run to the data
+    if (emptyCount > 0) {
+      dataWriter.append<uint8_t>(BINARY_EMPTY);
+      dataWriter.append<uint64_t>(emptyCount);
+      emptyCount = 0;
+    }
+  };
+
+  for (RegisterId column = 0; column < _nrRegs; column++) {
+    for (size_t i = 0; i < _nrItems; i++) {
+      AqlValue const& a(_data[i * _nrRegs + column]);
+      if (a.isEmpty()) {
+        emptyCount++;
+        continue;
+      }
+
+      commitEmpties();
+      if (a._type == AqlValue::RANGE) {
+        dataWriter.append<uint8_t>(BINARY_RANGE);
+        dataWriter.append<int64_t>(a._range->_low);
+        dataWriter.append<int64_t>(a._range->_high);
+        continue;
+      }
+
+      auto it = table.find(a);
+      if (it != table.end()) {
+        dataWriter.append<uint8_t>(BINARY_REFERENCE);
+        dataWriter.append<uint64_t>(it->second);
+        continue;
+      }
+
+      table.emplace(std::make_pair(a, pos++));
+
+      if (a._type == AqlValue::SHAPED) {
+        TRI_document_collection_t const* document = _docColls[column];
+        TRI_ASSERT(document != nullptr);
+
+        TRI_shaped_json_t shaped;
+        TRI_EXTRACT_SHAPED_JSON_MARKER(shaped, a._marker);
+
+        if (legends[column] == nullptr) {
+          legends[column].reset(new triagens::basics::JsonLegend(document->getShaper()));
+        }
+
+        int res = legends[column]->addShape(shaped._sid, &shaped._data);
+        if (res != TRI_ERROR_NO_ERROR) {
+          THROW_ARANGO_EXCEPTION(res);
+        }
+
+        dataWriter.append<uint8_t>(BINARY_SHAPED);
+        dataWriter.append<uint64_t>(shaped._sid);
+        dataWriter.append<uint64_t>(TRI_EXTRACT_MARKER_RID(a._marker));
+        dataWriter.appendString(TRI_EXTRACT_MARKER_KEY(a._marker), strlen(TRI_EXTRACT_MARKER_KEY(a._marker)));
+
+        if (TRI_IS_EDGE_MARKER(a._marker)) {
+          std::string from(trx->resolver()->getCollectionNameCluster(TRI_EXTRACT_MARKER_FROM_CID(a._marker)));
+          from.push_back('/');
+          from.append(TRI_EXTRACT_MARKER_FROM_KEY(a._marker));
+
+          std::string to(trx->resolver()->getCollectionNameCluster(TRI_EXTRACT_MARKER_TO_CID(a._marker)));
+          to.push_back('/');
+          to.append(TRI_EXTRACT_MARKER_TO_KEY(a._marker));
+
+          dataWriter.append<uint8_t>(1);
+          dataWriter.appendString(from);
+          dataWriter.appendString(to);
+        }
+        else {
+          dataWriter.append<uint8_t>(0);
+        }
+
+        dataWriter.append<uint64_t>(shaped._data.length);
+        dataWriter.align();
+        dataWriter.appendBytes(shaped._data.data, shaped._data.length);
+        dataWriter.align();
+      }
+      else {
+        dataWriter.append<uint8_t>(BINARY_JSON);
+
+        if (a._type == AqlValue::JSON) {
+          dataWriter.appendJson(a._json->json());
+        }
+        else {
+          Json json(a.toJson(trx, _docColls[column]));
+          dataWriter.appendJson(json.json());
+        }
+      }
+    }
+  }
+  commitEmpties();
+
+  // now the header
+  BinaryWriter writer(buffer);
+  writer.append<uint32_t>(BinaryMagic);
+  writer.append<uint32_t>(BinaryVersion);
+  writer.append<uint64_t>(_nrItems);
+  writer.append<uint64_t>(_nrRegs);
+
+  for (RegisterId column = 0; column < _nrRegs; column++) {
+    if (legends[column] == nullptr) {
+      writer.append<uint64_t>(0);
+      writer.appendString("", 0);
+    }
+    else {
+      size_t const legendLength = legends[column]->getSize();
+      std::unique_ptr<uint64_t[]> legend(new uint64_t[legendLength / 8 + 1]);
+      legends[column]->dump(legend.get());
+
+      writer.append<uint64_t>(legendLength);
+      writer.appendBytes(reinterpret_cast<char const*>(legend.get()), legendLength);
+      writer.appendString(trx->resolver()->getCollectionName(_docColls[column]->_info._cid));
+    }
+    writer.align();
+  }
+
+  // the entries start at a multiple of 8, so they stay aligned
+  writer.appendBytes(data.c_str(), data.length());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writeBinaryMessage, the message consists of the length of the
+/// stringified envelope (uint32), the envelope, padding to a multiple of 8
+/// bytes and the block in binary format, if any
+////////////////////////////////////////////////////////////////////////////////
+
+void AqlItemBlock::writeBinaryMessage (triagens::arango::AqlTransaction* trx,
+                                       StringBuffer& buffer,
+                                       Json const& envelope,
+                                       AqlItemBlock const* block) {
+  BinaryWriter writer(buffer);
+  writer.appendString(envelope.toString());
+  writer.align();
+
+  if (block != nullptr) {
+    block->toBinary(trx, buffer);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief readBinaryMessage
+////////////////////////////////////////////////////////////////////////////////
+
+Json AqlItemBlock::readBinaryMessage (char const* data,
+                                      size_t length,
+                                      AqlItemBlock*& block) {
+  block = nullptr;
+
+  BinaryReader reader(data, length);
+  size_t envelopeLength;
+  char const* envelope = reader.readString(envelopeLength);
+  Json result(TRI_UNKNOWN_MEM_ZONE, JsonHelper::fromString(envelope, envelopeLength));
+  reader.align();
+
+  if (reader.position() < length) {
+    block = new AqlItemBlock(data + reader.position(), length - reader.position());
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief content type of binary messages
+////////////////////////////////////////////////////////////////////////////////
+
+char const* const AqlItemBlock::BinaryContentType = "application/x-arango-aql-block";
+
 // Local Variables:
 // mode: outline-minor
 // outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
@@ -30,6 +30,7 @@
 
 #include "Basics/Common.h"
 #include "Basics/JsonHelper.h"
+#include "Basics/StringBuffer.h"
 #include "Aql/AqlValue.h"
 #include "Aql/Range.h"
 #include "Aql/types.h"
@@ -79,6 +80,9 @@ namespace triagens {
 
         AqlItemBlock (triagens::basics::Json const& json);
 
+        AqlItemBlock (char const* data, 
+                      size_t length);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the block
 ////////////////////////////////////////////////////////////////////////////////
@@ -360,6 +364,41 @@ namespace triagens {
 
         triagens::basics::Json toJson (triagens::arango::AqlTransaction* trx) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toBinary, append the whole AqlItemBlock in binary format to the
+/// buffer, the result can be used to recreate the AqlItemBlock via the
+/// binary constructor
+////////////////////////////////////////////////////////////////////////////////
+
+        void toBinary (triagens::arango::AqlTransaction* trx,
+                       triagens::basics::StringBuffer& buffer) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writeBinaryMessage, append a Json envelope (e.g. the statistics)
+/// and optionally a block in binary format to the buffer
+////////////////////////////////////////////////////////////////////////////////
+
+        static void writeBinaryMessage (triagens::arango::AqlTransaction* trx,
+                                        triagens::basics::StringBuffer& buffer,
+                                        triagens::basics::Json const& envelope,
+                                        AqlItemBlock const* block);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief readBinaryMessage, the counterpart of writeBinaryMessage. returns
+/// the envelope and sets block to the block contained, or to a nullptr if the
+/// message does not contain a block
+////////////////////////////////////////////////////////////////////////////////
+
+        static triagens::basics::Json readBinaryMessage (char const* data,
+                                                         size_t length,
+                                                         AqlItemBlock*& block);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief content type of binary messages
+////////////////////////////////////////////////////////////////////////////////
+
+        static char const* const BinaryContentType;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Aql/Ast.h"
+#include "Aql/Aggregator.h"
 #include "Aql/Arithmetic.h"
 #include "Aql/Collection.h"
 #include "Aql/Executor.h"
@@ -562,6 +563,66 @@ AstNode* Ast::createNodeCollectCount (AstNode const* list,
   return node;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST collect node, AGGREGATE
+///
+/// each aggregate must be a call of a supported aggregate function with a
+/// single argument. the calls are split into the argument expressions and
+/// the function names, so the calls themselves are never evaluated
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::createNodeCollectAggregate (AstNode const* list,
+                                          AstNode const* aggregates,
+                                          AstNode const* options) {
+  AstNode* node = createNode(NODE_TYPE_COLLECT_AGGREGATE);
+  
+  if (options == nullptr) {
+    // no options given. now use default options
+    options = &NopNode;
+  }
+  node->addMember(options);
+
+  node->addMember(list);
+
+  AstNode* expressions = createNodeArray();
+  AstNode* functions = createNodeArray();
+
+  size_t const n = aggregates->numMembers();
+
+  for (size_t i = 0; i < n; ++i) {
+    auto aggregate = aggregates->getMember(i);
+    TRI_ASSERT(aggregate->type == NODE_TYPE_ASSIGN);
+
+    auto call = aggregate->getMember(1);
+
+    if (call->type != NODE_TYPE_FCALL ||
+        call->getMember(0)->numMembers() != 1) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_INVALID_AGGREGATE_EXPRESSION);
+    }
+
+    auto func = static_cast<Function const*>(call->getData());
+    TRI_ASSERT(func != nullptr);
+
+    if (! Aggregator::isSupported(func->externalName)) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_INVALID_AGGREGATE_EXPRESSION, 
+                                     std::string("function '") + func->externalName + "' cannot be used in AGGREGATE");
+    }
+
+    auto assign = createNode(NODE_TYPE_ASSIGN);
+    assign->addMember(aggregate->getMember(0));
+    assign->addMember(call->getMember(0)->getMember(0));
+    expressions->addMember(assign);
+
+    char* name = _query->registerString(func->externalName.c_str(), func->externalName.size(), false);
+    functions->addMember(createNodeValueString(name));
+  }
+
+  node->addMember(expressions);
+  node->addMember(functions);
+
+  return node;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an AST sort node
 ////////////////////////////////////////////////////////////////////////////////
@@ -1549,6 +1610,52 @@ AstNode* Ast::executeConstExpression (AstNode const* node) {
   return value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes a call to a function that has a C++ implementation, with
+/// constant parameters. this does not need to enter V8
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::executeConstFunctionCall (AstNode const* node) {
+  auto func = static_cast<Function*>(node->getData());
+  TRI_ASSERT(func != nullptr);
+  TRI_ASSERT(func->implementation != nullptr);
+
+  TRI_json_t* arguments = node->getMember(0)->toJsonValue(TRI_UNKNOWN_MEM_ZONE);
+
+  if (arguments == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  AqlValue parameters(new triagens::basics::Json(TRI_UNKNOWN_MEM_ZONE, arguments));
+  AqlValue result;
+
+  try {
+    result = func->implementation(_query, nullptr, nullptr, parameters);
+  }
+  catch (...) {
+    parameters.destroy();
+    throw;
+  }
+
+  parameters.destroy();
+
+  AstNode* value = nullptr;
+  try {
+    TRI_ASSERT(result._type == AqlValue::JSON);
+    value = nodeFromJson(result._json->json());
+  }
+  catch (...) {
+  }
+
+  result.destroy();
+
+  if (value == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief optimizes the unary operators + and -
 /// the unary plus will be converted into a simple value node if the operand of
@@ -2046,6 +2153,11 @@ AstNode* Ast::optimizeFunctionCall (AstNode* node) {
     return node;
   }
 
+  if (func->implementation != nullptr) {
+    // the function can be evaluated natively
+    return executeConstFunctionCall(node);
+  }
+
   return executeConstExpression(node);
 }
 
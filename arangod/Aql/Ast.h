@@ -335,6 +335,14 @@ namespace triagens {
                                          char const*,
                                          AstNode const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST collect node, AGGREGATE
+////////////////////////////////////////////////////////////////////////////////
+
+        AstNode* createNodeCollectAggregate (AstNode const*,
+                                             AstNode const*,
+                                             AstNode const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an AST sort node
 ////////////////////////////////////////////////////////////////////////////////
@@ -596,6 +604,13 @@ namespace triagens {
 
         AstNode* executeConstExpression (AstNode const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes a call to a function that has a C++ implementation, with
+/// constant parameters. this does not need to enter V8
+////////////////////////////////////////////////////////////////////////////////
+
+        AstNode* executeConstFunctionCall (AstNode const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief optimizes the unary operators + and -
 /// the unary plus will be converted into a simple value node if the operand of
@@ -122,6 +122,7 @@ std::unordered_map<int, std::string const> const AstNode::TypeNames{
   { static_cast<int>(NODE_TYPE_NOP),                      "no-op" },
   { static_cast<int>(NODE_TYPE_COLLECT_COUNT),            "collect count" },
   { static_cast<int>(NODE_TYPE_COLLECT_EXPRESSION),       "collect expression" },
+  { static_cast<int>(NODE_TYPE_COLLECT_AGGREGATE),        "collect aggregate" },
   { static_cast<int>(NODE_TYPE_CALCULATED_OBJECT_ELEMENT),"calculated object element" }
 };
 
@@ -505,6 +506,7 @@ AstNode::AstNode (Ast* ast,
     case NODE_TYPE_COLLECT:
     case NODE_TYPE_COLLECT_COUNT:
     case NODE_TYPE_COLLECT_EXPRESSION:
+    case NODE_TYPE_COLLECT_AGGREGATE:
     case NODE_TYPE_SORT:
     case NODE_TYPE_SORT_ELEMENT:
     case NODE_TYPE_LIMIT:
@@ -28,6 +28,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "CollectionScanner.h"
+#include "Basics/memory-map.h"
+#include "VocBase/datafile.h"
 
 using namespace triagens::aql;
 
@@ -120,6 +122,127 @@ void LinearCollectionScanner::reset () {
   position = 0;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                struct SequentialCollectionScanner
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of documents in a window
+////////////////////////////////////////////////////////////////////////////////
+
+size_t const SequentialCollectionScanner::MaxWindowSize = 65536;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+SequentialCollectionScanner::SequentialCollectionScanner (triagens::arango::AqlTransaction* trx,
+                                                          TRI_transaction_collection_t* trxCollection) 
+  : CollectionScanner(trx, trxCollection),
+    window(),
+    windowPosition(0) {
+
+}
+
+int SequentialCollectionScanner::scan (std::vector<TRI_doc_mptr_copy_t>& docs,
+                                       size_t batchSize) {
+  if (windowPosition >= window.size()) {
+    // fetch the next window from the primary index
+    window.clear();
+    windowPosition = 0;
+
+    size_t windowSize = batchSize * 64;
+    if (windowSize > MaxWindowSize) {
+      windowSize = (std::max)(batchSize, MaxWindowSize);
+    }
+
+    int res = trx->readIncremental(trxCollection,
+                                   window,
+                                   position,
+                                   static_cast<TRI_voc_size_t>(windowSize),
+                                   0,
+                                   TRI_QRY_NO_LIMIT,
+                                   &totalCount);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+
+    if (window.empty()) {
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    sortByPosition(window);
+    adviseWillNeed(window, 0, batchSize);
+  }
+
+  size_t const end = (std::min)(window.size(), windowPosition + batchSize);
+  docs.insert(docs.end(), window.begin() + windowPosition, window.begin() + end);
+  windowPosition = end;
+
+  // the markers of the next batch will be needed soon
+  adviseWillNeed(window, windowPosition, batchSize);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+void SequentialCollectionScanner::reset () {
+  position = 0;
+  window.clear();
+  windowPosition = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sort master pointers by datafile and position in the datafile
+////////////////////////////////////////////////////////////////////////////////
+
+void SequentialCollectionScanner::sortByPosition (std::vector<TRI_doc_mptr_copy_t>& docs) {
+  std::sort(docs.begin(), docs.end(), [] (TRI_doc_mptr_copy_t const& lhs, TRI_doc_mptr_copy_t const& rhs) {
+    if (lhs._fid != rhs._fid) {
+      return lhs._fid < rhs._fid;
+    }
+    return std::less<void const*>()(lhs.getDataPtr(), rhs.getDataPtr());
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ask the kernel to read ahead the markers of documents that were
+/// sorted with sortByPosition
+///
+/// consecutive documents from the same datafile are advised as one range, so
+/// there is one madvise() call per datafile touched by the documents
+////////////////////////////////////////////////////////////////////////////////
+
+void SequentialCollectionScanner::adviseWillNeed (std::vector<TRI_doc_mptr_copy_t> const& docs,
+                                                  size_t from,
+                                                  size_t count) {
+  size_t const end = (std::min)(docs.size(), from + count);
+  size_t i = from;
+
+  while (i < end) {
+    TRI_voc_fid_t const fid = docs[i]._fid;
+    char const* start = static_cast<char const*>(docs[i].getDataPtr());
+    char const* stop = start;
+
+    for (; i < end && docs[i]._fid == fid; ++i) {
+      auto marker = static_cast<TRI_df_marker_t const*>(docs[i].getDataPtr());
+      char const* markerEnd = reinterpret_cast<char const*>(marker) + marker->_size;
+
+      if (markerEnd > stop) {
+        stop = markerEnd;
+      }
+    }
+
+    if (start != nullptr && stop > start) {
+      TRI_MMFileAdvise(start, static_cast<size_t>(stop - start), TRI_MADVISE_WILLNEED);
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -109,6 +109,67 @@ namespace triagens {
       void reset () override;
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                struct SequentialCollectionScanner
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief scanner that returns the documents in datafile order
+///
+/// the primary index is read in windows of up to MaxWindowSize documents.
+/// each window is sorted by datafile and position in the datafile, so the
+/// documents are accessed sequentially instead of in hash order. the kernel
+/// is asked to read ahead the markers of the next batch
+////////////////////////////////////////////////////////////////////////////////
+
+    struct SequentialCollectionScanner final : public CollectionScanner {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      SequentialCollectionScanner (triagens::arango::AqlTransaction*,
+                                   TRI_transaction_collection_t*);
+
+      int scan (std::vector<TRI_doc_mptr_copy_t>&,
+                size_t) override;
+
+      void reset () override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sort master pointers by datafile and position in the datafile
+////////////////////////////////////////////////////////////////////////////////
+
+      static void sortByPosition (std::vector<TRI_doc_mptr_copy_t>&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ask the kernel to read ahead the markers of documents that were
+/// sorted with sortByPosition
+////////////////////////////////////////////////////////////////////////////////
+
+      static void adviseWillNeed (std::vector<TRI_doc_mptr_copy_t> const&,
+                                  size_t,
+                                  size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the current window of documents, sorted by position
+////////////////////////////////////////////////////////////////////////////////
+
+      std::vector<TRI_doc_mptr_copy_t> window;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of documents in the window that were already returned
+////////////////////////////////////////////////////////////////////////////////
+
+      size_t windowPosition;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of documents in a window
+////////////////////////////////////////////////////////////////////////////////
+
+      static size_t const MaxWindowSize;
+    };
+
   }
 }
 
@@ -0,0 +1,931 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, expressions compiled into a linear program
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/CompiledExpression.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AstNode.h"
+#include "Aql/Expression.h"
+#include "Aql/Functions.h"
+#include "Aql/Query.h"
+#include "Aql/Variable.h"
+#include "Basics/Exceptions.h"
+#include "Basics/json-utilities.h"
+#include "VocBase/document-collection.h"
+#include "VocBase/voc-shaper.h"
+
+using namespace triagens::aql;
+using Json = triagens::basics::Json;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a value is true, same rules as in AqlValue::isTrue
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool IsTrue (TRI_json_t const* json) {
+  switch (json->_type) {
+    case TRI_JSON_BOOLEAN:
+      return json->_value._boolean;
+    case TRI_JSON_NUMBER:
+      return json->_value._number != 0.0;
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE:
+      // the trailing NULL byte counts, too...
+      return json->_value._string.length != 1;
+    case TRI_JSON_ARRAY:
+    case TRI_JSON_OBJECT:
+      return true;
+    case TRI_JSON_UNUSED:
+    case TRI_JSON_NULL:
+      break;
+  }
+
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile the expression
+////////////////////////////////////////////////////////////////////////////////
+
+CompiledExpression::CompiledExpression (Query* query,
+                                        AstNode const* node)
+  : _query(query),
+    _instructions(),
+    _loads(),
+    _slots(),
+    _buffer(TRI_UNKNOWN_MEM_ZONE) {
+
+  TRI_ASSERT(isCompilable(node));
+
+  uint32_t result = allocateRegister();
+  TRI_ASSERT(result == 0);
+  compile(node, result);
+
+  // the slots may point to their own values, so they must be initialized
+  // only when the register file has its final size
+  for (auto& slot : _slots) {
+    slot.owned = nullptr;
+    slot.setNull();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the compiled expression
+////////////////////////////////////////////////////////////////////////////////
+
+CompiledExpression::~CompiledExpression () {
+  releaseSlots();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an expression can be compiled
+////////////////////////////////////////////////////////////////////////////////
+
+bool CompiledExpression::isCompilable (AstNode const* node) {
+  switch (node->type) {
+    case NODE_TYPE_VALUE:
+    case NODE_TYPE_REFERENCE:
+      return true;
+
+    case NODE_TYPE_ARRAY:
+    case NODE_TYPE_OBJECT:
+      return node->isConstant();
+
+    case NODE_TYPE_ATTRIBUTE_ACCESS: {
+      while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+        node = node->getMember(0);
+      }
+      return (node->type == NODE_TYPE_REFERENCE);
+    }
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT:
+    case NODE_TYPE_OPERATOR_UNARY_PLUS:
+    case NODE_TYPE_OPERATOR_UNARY_MINUS:
+      return isCompilable(node->getMember(0));
+
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR:
+    case NODE_TYPE_OPERATOR_BINARY_PLUS:
+    case NODE_TYPE_OPERATOR_BINARY_MINUS:
+    case NODE_TYPE_OPERATOR_BINARY_TIMES:
+    case NODE_TYPE_OPERATOR_BINARY_DIV:
+    case NODE_TYPE_OPERATOR_BINARY_MOD:
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+    case NODE_TYPE_OPERATOR_BINARY_IN:
+    case NODE_TYPE_OPERATOR_BINARY_NIN:
+      return (isCompilable(node->getMember(0)) && isCompilable(node->getMember(1)));
+
+    case NODE_TYPE_OPERATOR_TERNARY:
+      return (isCompilable(node->getMember(0)) &&
+              isCompilable(node->getMember(1)) &&
+              isCompilable(node->getMember(2)));
+
+    default: {
+      // everything else is executed by the regular expression code
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute the program for a row of an item block
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue CompiledExpression::execute (triagens::arango::AqlTransaction* trx,
+                                      AqlItemBlock const* argv,
+                                      size_t startPos,
+                                      std::vector<Variable*> const& vars,
+                                      std::vector<RegisterId> const& regs) {
+  try {
+    size_t const n = _instructions.size();
+    size_t pc = 0;
+
+    while (pc < n) {
+      auto const& instruction = _instructions[pc++];
+
+      switch (instruction.opCode) {
+        case OP_CONSTANT: {
+          _slots[instruction.result].setBorrowed(instruction.constant, true);
+          break;
+        }
+
+        case OP_LOAD: {
+          load(_slots[instruction.result], _loads[instruction.lhs], trx, argv, startPos, vars, regs);
+          break;
+        }
+
+        case OP_NOT: {
+          _slots[instruction.result].setBoolean(! IsTrue(_slots[instruction.lhs].json));
+          break;
+        }
+
+        case OP_EQ:
+        case OP_NE:
+        case OP_LT:
+        case OP_LE:
+        case OP_GT:
+        case OP_GE: {
+          TRI_json_t const* lhs = _slots[instruction.lhs].json;
+          TRI_json_t const* rhs = _slots[instruction.rhs].json;
+          int compareResult;
+
+          if (lhs->_type == TRI_JSON_NUMBER && rhs->_type == TRI_JSON_NUMBER) {
+            // fast path for numbers
+            double const l = lhs->_value._number;
+            double const r = rhs->_value._number;
+            compareResult = (l == r ? 0 : (l < r ? -1 : 1));
+          }
+          else {
+            // for equality and non-equality we can use a binary comparison
+            bool const compareUtf8 = (instruction.opCode != OP_EQ && instruction.opCode != OP_NE);
+            compareResult = TRI_CompareValuesJson(lhs, rhs, compareUtf8);
+          }
+
+          bool result;
+          switch (instruction.opCode) {
+            case OP_EQ:
+              result = (compareResult == 0);
+              break;
+            case OP_NE:
+              result = (compareResult != 0);
+              break;
+            case OP_LT:
+              result = (compareResult < 0);
+              break;
+            case OP_LE:
+              result = (compareResult <= 0);
+              break;
+            case OP_GT:
+              result = (compareResult > 0);
+              break;
+            default:
+              result = (compareResult >= 0);
+              break;
+          }
+          _slots[instruction.result].setBoolean(result);
+          break;
+        }
+
+        case OP_IN:
+        case OP_NIN: {
+          TRI_json_t const* rhs = _slots[instruction.rhs].json;
+          bool result = false;
+
+          // right operand must be an array, otherwise the result is false
+          if (TRI_IsArrayJson(rhs)) {
+            result = findInArray(_slots[instruction.lhs].json, rhs, instruction.sorted);
+
+            if (instruction.opCode == OP_NIN) {
+              // revert the result in case of a NOT IN
+              result = ! result;
+            }
+          }
+          _slots[instruction.result].setBoolean(result);
+          break;
+        }
+
+        case OP_UNARY_PLUS:
+        case OP_UNARY_MINUS:
+        case OP_PLUS:
+        case OP_MINUS:
+        case OP_TIMES:
+        case OP_DIV:
+        case OP_MOD: {
+          arithmetic(instruction.opCode, _slots[instruction.result], _slots[instruction.lhs], _slots[instruction.rhs]);
+          break;
+        }
+
+        case OP_JUMP: {
+          pc = instruction.result;
+          break;
+        }
+
+        case OP_JUMP_IF_FALSE: {
+          if (! IsTrue(_slots[instruction.lhs].json)) {
+            pc = instruction.result;
+          }
+          break;
+        }
+
+        case OP_JUMP_IF_TRUE: {
+          if (IsTrue(_slots[instruction.lhs].json)) {
+            pc = instruction.result;
+          }
+          break;
+        }
+      }
+    }
+
+    AqlValue value = result(_slots[0]);
+    releaseSlots();
+    return value;
+  }
+  catch (...) {
+    releaseSlots();
+    throw;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile a node, writing its value into the given register
+////////////////////////////////////////////////////////////////////////////////
+
+void CompiledExpression::compile (AstNode const* node,
+                                  uint32_t result) {
+  switch (node->type) {
+    case NODE_TYPE_VALUE:
+    case NODE_TYPE_ARRAY:
+    case NODE_TYPE_OBJECT: {
+      // we do not own the JSON but the node does!
+      auto json = node->computeJson();
+
+      if (json == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+
+      emit(OP_CONSTANT, result, 0, 0, json);
+      return;
+    }
+
+    case NODE_TYPE_REFERENCE:
+    case NODE_TYPE_ATTRIBUTE_ACCESS: {
+      Load l{ nullptr, std::vector<std::string>(), std::string(), true, nullptr, 0 };
+
+      while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+        l.path.emplace(l.path.begin(), node->getStringValue());
+        node = node->getMember(0);
+      }
+
+      TRI_ASSERT(node->type == NODE_TYPE_REFERENCE);
+      l.variable = static_cast<Variable const*>(node->getData());
+
+      for (auto const& name : l.path) {
+        if (name.find('.') != std::string::npos) {
+          // cannot build an attribute path from the names
+          l.canUsePid = false;
+        }
+        if (! l.dottedPath.empty()) {
+          l.dottedPath.push_back('.');
+        }
+        l.dottedPath.append(name);
+      }
+
+      _loads.emplace_back(std::move(l));
+      emit(OP_LOAD, result, static_cast<uint32_t>(_loads.size() - 1));
+      return;
+    }
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT: {
+      compileOperator(node, OP_NOT, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_UNARY_PLUS: {
+      compileOperator(node, OP_UNARY_PLUS, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_UNARY_MINUS: {
+      compileOperator(node, OP_UNARY_MINUS, result);
+      return;
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR: {
+      // AND returns the left operand if it is false, OR returns it if it is
+      // true. the right operand is only evaluated if needed
+      compile(node->getMember(0), result);
+      size_t jump = emit(node->type == NODE_TYPE_OPERATOR_BINARY_AND ? OP_JUMP_IF_FALSE : OP_JUMP_IF_TRUE, 0, result);
+      compile(node->getMember(1), result);
+      _instructions[jump].result = static_cast<uint32_t>(_instructions.size());
+      return;
+    }
+
+    case NODE_TYPE_OPERATOR_TERNARY: {
+      uint32_t condition = allocateRegister();
+      compile(node->getMember(0), condition);
+      size_t jumpToFalse = emit(OP_JUMP_IF_FALSE, 0, condition);
+      compile(node->getMember(1), result);
+      size_t jumpToEnd = emit(OP_JUMP, 0);
+      _instructions[jumpToFalse].result = static_cast<uint32_t>(_instructions.size());
+      compile(node->getMember(2), result);
+      _instructions[jumpToEnd].result = static_cast<uint32_t>(_instructions.size());
+      return;
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_PLUS: {
+      compileOperator(node, OP_PLUS, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_MINUS: {
+      compileOperator(node, OP_MINUS, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_TIMES: {
+      compileOperator(node, OP_TIMES, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_DIV: {
+      compileOperator(node, OP_DIV, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_MOD: {
+      compileOperator(node, OP_MOD, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_EQ: {
+      compileOperator(node, OP_EQ, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_NE: {
+      compileOperator(node, OP_NE, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_LT: {
+      compileOperator(node, OP_LT, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_LE: {
+      compileOperator(node, OP_LE, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_GT: {
+      compileOperator(node, OP_GT, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_GE: {
+      compileOperator(node, OP_GE, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_IN: {
+      compileOperator(node, OP_IN, result);
+      return;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_NIN: {
+      compileOperator(node, OP_NIN, result);
+      return;
+    }
+
+    default: {
+      // fall-through to exception
+    }
+  }
+
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unhandled type in compiled expression");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile a unary or binary operator
+////////////////////////////////////////////////////////////////////////////////
+
+void CompiledExpression::compileOperator (AstNode const* node,
+                                          OpCode opCode,
+                                          uint32_t result) {
+  uint32_t lhs = allocateRegister();
+  compile(node->getMember(0), lhs);
+
+  if (node->numMembers() == 1) {
+    emit(opCode, result, lhs, lhs);
+    return;
+  }
+
+  uint32_t rhs = allocateRegister();
+  compile(node->getMember(1), rhs);
+
+  size_t position = emit(opCode, result, lhs, rhs);
+
+  if (opCode == OP_IN || opCode == OP_NIN) {
+    // sorted arrays can be searched with a binary search
+    _instructions[position].sorted = node->getMember(1)->isSorted();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief allocate a new register
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t CompiledExpression::allocateRegister () {
+  _slots.emplace_back(Slot());
+  return static_cast<uint32_t>(_slots.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append an instruction to the program
+////////////////////////////////////////////////////////////////////////////////
+
+size_t CompiledExpression::emit (OpCode opCode,
+                                 uint32_t result,
+                                 uint32_t lhs,
+                                 uint32_t rhs,
+                                 TRI_json_t const* constant) {
+  _instructions.emplace_back(Instruction{ opCode, result, lhs, rhs, constant, false });
+  return _instructions.size() - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute a load instruction
+////////////////////////////////////////////////////////////////////////////////
+
+void CompiledExpression::load (Slot& slot,
+                               Load& l,
+                               triagens::arango::AqlTransaction* trx,
+                               AqlItemBlock const* argv,
+                               size_t startPos,
+                               std::vector<Variable*> const& vars,
+                               std::vector<RegisterId> const& regs) {
+  size_t const n = vars.size();
+  size_t i = 0;
+
+  while (i < n && vars[i]->id != l.variable->id) {
+    ++i;
+  }
+
+  if (i == n) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found in compiled expression");
+  }
+
+  RegisterId const reg = regs[i];
+  AqlValue const& value = argv->getValueReference(startPos, reg);
+
+  switch (value._type) {
+    case AqlValue::EMPTY: {
+      slot.setNull();
+      return;
+    }
+
+    case AqlValue::JSON: {
+      // point into the value of the register, without copying it
+      TRI_json_t const* json = value._json->json();
+
+      for (auto const& name : l.path) {
+        if (! TRI_IsObjectJson(json)) {
+          json = nullptr;
+          break;
+        }
+
+        json = TRI_LookupObjectJson(json, name.c_str());
+
+        if (json == nullptr) {
+          break;
+        }
+      }
+
+      slot.setBorrowed(json, false);
+      return;
+    }
+
+    case AqlValue::SHAPED: {
+      if (! l.path.empty() &&
+          loadShaped(slot, l, value._marker, argv->getDocumentCollection(reg))) {
+        return;
+      }
+      break;
+    }
+
+    default: {
+      break;
+    }
+  }
+
+  // generic case, which requires a copy of the value
+  auto collection = argv->getDocumentCollection(reg);
+  Json json = l.path.empty() ? value.toJson(trx, collection)
+                             : value.extractObjectMember(trx, collection, l.path[0].c_str(), true, _buffer);
+  TRI_json_t* owned = json.steal();
+
+  if (owned != nullptr && l.path.size() > 1) {
+    TRI_json_t const* found = owned;
+
+    for (size_t j = 1; j < l.path.size(); ++j) {
+      if (! TRI_IsObjectJson(found)) {
+        found = nullptr;
+        break;
+      }
+
+      found = TRI_LookupObjectJson(found, l.path[j].c_str());
+
+      if (found == nullptr) {
+        break;
+      }
+    }
+
+    TRI_json_t* copy = nullptr;
+
+    if (found != nullptr) {
+      copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, found);
+    }
+
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, owned);
+
+    if (found != nullptr && copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    owned = copy;
+  }
+
+  slot.setOwned(owned);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief load an attribute from a shaped document without converting it
+/// into JSON if it is a scalar. returns false if the attribute cannot be
+/// accessed this way
+////////////////////////////////////////////////////////////////////////////////
+
+bool CompiledExpression::loadShaped (Slot& slot,
+                                     Load& l,
+                                     TRI_df_marker_t const* marker,
+                                     TRI_document_collection_t const* collection) {
+  if (! l.canUsePid || collection == nullptr) {
+    return false;
+  }
+
+  std::string const& first = l.path[0];
+
+  if (first[0] == '_') {
+    if (first == TRI_VOC_ATTRIBUTE_KEY && l.path.size() == 1) {
+      // the key can be referenced directly in the marker
+      char const* key = TRI_EXTRACT_MARKER_KEY(marker);
+      slot.setStringReference(key, strlen(key));
+      return true;
+    }
+
+    if (first == TRI_VOC_ATTRIBUTE_KEY ||
+        first == TRI_VOC_ATTRIBUTE_ID ||
+        first == TRI_VOC_ATTRIBUTE_REV ||
+        first == TRI_VOC_ATTRIBUTE_FROM ||
+        first == TRI_VOC_ATTRIBUTE_TO) {
+      // these are not part of the shape
+      return false;
+    }
+  }
+
+  TRI_shaper_t* shaper = collection->getShaper();
+
+  if (l.shaper != shaper || l.pid == 0) {
+    // the attribute may not have been used in the collection yet
+    l.shaper = shaper;
+    l.pid    = shaper->lookupAttributePathByName(shaper, l.dottedPath.c_str());
+  }
+
+  if (l.pid == 0) {
+    // no document has the attribute
+    slot.setNull();
+    return true;
+  }
+
+  TRI_shaped_json_t document;
+  TRI_EXTRACT_SHAPED_JSON_MARKER(document, marker);
+
+  TRI_shaped_json_t json;
+  TRI_shape_t const* shape;
+
+  if (! TRI_ExtractShapedJsonVocShaper(shaper, &document, 0, l.pid, &json, &shape) ||
+      shape == nullptr) {
+    slot.setNull();
+    return true;
+  }
+
+  char const* data = json._data.data;
+
+  switch (shape->_type) {
+    case TRI_SHAPE_NULL: {
+      slot.setNull();
+      break;
+    }
+
+    case TRI_SHAPE_BOOLEAN: {
+      slot.setBoolean(* (TRI_shape_boolean_t const*) data != 0);
+      break;
+    }
+
+    case TRI_SHAPE_NUMBER: {
+      slot.setNumber(* (TRI_shape_number_t const*) (void const*) data);
+      break;
+    }
+
+    case TRI_SHAPE_SHORT_STRING: {
+      TRI_shape_length_short_string_t length = * (TRI_shape_length_short_string_t const*) data;
+      slot.setStringReference(data + sizeof(TRI_shape_length_short_string_t), static_cast<size_t>(length - 1));
+      break;
+    }
+
+    case TRI_SHAPE_LONG_STRING: {
+      TRI_shape_length_long_string_t length = * (TRI_shape_length_long_string_t const*) (void const*) data;
+      slot.setStringReference(data + sizeof(TRI_shape_length_long_string_t), static_cast<size_t>(length - 1));
+      break;
+    }
+
+    default: {
+      // arrays, objects and compressed strings must be converted
+      TRI_json_t* result = TRI_JsonShapedJson(shaper, &json);
+
+      if (result == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+
+      slot.setOwned(result);
+      break;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute an arithmetic operator. the operands are converted into
+/// numbers like in the JavaScript implementation of the operators. invalid
+/// operands and results that are not finite produce null
+////////////////////////////////////////////////////////////////////////////////
+
+void CompiledExpression::arithmetic (OpCode opCode,
+                                     Slot& result,
+                                     Slot const& lhs,
+                                     Slot const& rhs) {
+  bool failed = false;
+  double l;
+
+  if (lhs.json->_type == TRI_JSON_NUMBER) {
+    // fast path for numbers
+    l = lhs.json->_value._number;
+  }
+  else {
+    l = Functions::ValueToNumber(lhs.json, failed);
+
+    if (failed) {
+      result.setNull();
+      return;
+    }
+  }
+
+  double value;
+
+  if (opCode == OP_UNARY_PLUS) {
+    value = l;
+  }
+  else if (opCode == OP_UNARY_MINUS) {
+    value = - l;
+  }
+  else {
+    double r;
+
+    if (rhs.json->_type == TRI_JSON_NUMBER) {
+      // fast path for numbers
+      r = rhs.json->_value._number;
+    }
+    else {
+      r = Functions::ValueToNumber(rhs.json, failed);
+    }
+
+    if ((opCode == OP_DIV || opCode == OP_MOD) && (failed || r == 0.0)) {
+      _query->registerWarning(TRI_ERROR_QUERY_DIVISION_BY_ZERO);
+      result.setNull();
+      return;
+    }
+
+    if (failed) {
+      result.setNull();
+      return;
+    }
+
+    switch (opCode) {
+      case OP_PLUS:
+        value = l + r;
+        break;
+      case OP_MINUS:
+        value = l - r;
+        break;
+      case OP_TIMES:
+        value = l * r;
+        break;
+      case OP_DIV:
+        value = l / r;
+        break;
+      default:
+        value = fmod(l, r);
+        break;
+    }
+  }
+
+  if (value != value || // intentional!
+      value == HUGE_VAL ||
+      value == - HUGE_VAL) {
+    // NaN or +/- infinity
+    result.setNull();
+    return;
+  }
+
+  result.setNumber(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a value in an array
+/// this performs either a binary search (if the array is sorted) or a
+/// linear search (if the array is not sorted)
+////////////////////////////////////////////////////////////////////////////////
+
+bool CompiledExpression::findInArray (TRI_json_t const* value,
+                                      TRI_json_t const* array,
+                                      bool sorted) {
+  size_t const n = TRI_LengthArrayJson(array);
+
+  if (n == 0) {
+    return false;
+  }
+
+  if (sorted) {
+    // array values are sorted. can use binary search
+    size_t l = 0;
+    size_t r = n - 1;
+
+    while (true) {
+      // determine midpoint
+      size_t m = l + ((r - l) / 2);
+
+      int compareResult = TRI_CompareValuesJson(value, TRI_LookupArrayJson(array, m), false);
+
+      if (compareResult == 0) {
+        // item found in the array
+        return true;
+      }
+
+      if (compareResult < 0) {
+        if (m == 0) {
+          // not found
+          return false;
+        }
+        r = m - 1;
+      }
+      else {
+        l = m + 1;
+      }
+      if (r < l) {
+        return false;
+      }
+    }
+  }
+
+  // use linear search
+  for (size_t i = 0; i < n; ++i) {
+    if (TRI_CompareValuesJson(value, TRI_LookupArrayJson(array, i), false) == 0) {
+      // item found in the array
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert the value of a register into an AqlValue
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue CompiledExpression::result (Slot& slot) {
+  if (slot.owned != nullptr) {
+    // hand over the temporary value
+    TRI_ASSERT(slot.json == slot.owned);
+    auto json = new Json(TRI_UNKNOWN_MEM_ZONE, slot.owned);
+    slot.owned = nullptr;
+    slot.json  = &slot.value;
+    return AqlValue(json);
+  }
+
+  if (slot.isConstant) {
+    // we do not own the JSON but the node does!
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, slot.json, Json::NOFREE));
+  }
+
+  TRI_json_t const* json = slot.json;
+  TRI_json_t* copy;
+
+  switch (json->_type) {
+    case TRI_JSON_UNUSED:
+    case TRI_JSON_NULL: {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &Expression::NullJson, Json::NOFREE));
+    }
+
+    case TRI_JSON_BOOLEAN: {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, json->_value._boolean ? &Expression::TrueJson : &Expression::FalseJson, Json::NOFREE));
+    }
+
+    case TRI_JSON_STRING_REFERENCE: {
+      // the referenced string belongs to the current row
+      copy = TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, json->_value._string.data, json->_value._string.length - 1);
+      break;
+    }
+
+    default: {
+      copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json);
+      break;
+    }
+  }
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, copy));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free all temporaries owned by the registers
+////////////////////////////////////////////////////////////////////////////////
+
+void CompiledExpression::releaseSlots () {
+  for (auto& slot : _slots) {
+    if (slot.owned != nullptr) {
+      slot.setNull();
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -0,0 +1,363 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, expressions compiled into a linear program
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_COMPILED_EXPRESSION_H
+#define ARANGODB_AQL_COMPILED_EXPRESSION_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+#include "Aql/types.h"
+#include "Basics/StringBuffer.h"
+#include "Basics/json.h"
+#include "ShapedJson/shaped-json.h"
+#include "Utils/AqlTransaction.h"
+
+struct TRI_document_collection_t;
+
+namespace triagens {
+  namespace aql {
+
+    class AqlItemBlock;
+    struct AstNode;
+    class Query;
+    struct Variable;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                          class CompiledExpression
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief an expression that was flattened into a linear program. the program
+/// works on a register file whose slots hold their values in place, so
+/// intermediate results (numbers, booleans, strings from documents) do not
+/// need to be allocated on the heap
+////////////////////////////////////////////////////////////////////////////////
+
+    class CompiledExpression {
+
+        enum OpCode : uint32_t {
+          OP_CONSTANT,
+          OP_LOAD,
+          OP_NOT,
+          OP_UNARY_PLUS,
+          OP_UNARY_MINUS,
+          OP_EQ,
+          OP_NE,
+          OP_LT,
+          OP_LE,
+          OP_GT,
+          OP_GE,
+          OP_IN,
+          OP_NIN,
+          OP_PLUS,
+          OP_MINUS,
+          OP_TIMES,
+          OP_DIV,
+          OP_MOD,
+          OP_JUMP,
+          OP_JUMP_IF_FALSE,
+          OP_JUMP_IF_TRUE
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a single instruction. the meaning of the operands depends on the
+/// opcode: registers for operators, an index into the loads for OP_LOAD and
+/// the target instruction for jumps
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Instruction {
+          OpCode             opCode;
+          uint32_t           result;
+          uint32_t           lhs;
+          uint32_t           rhs;
+          TRI_json_t const*  constant;
+          bool               sorted;
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read access to a variable, optionally followed by attribute names
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Load {
+          Variable const*          variable;
+          std::vector<std::string> path;
+          std::string              dottedPath;
+          bool                     canUsePid;
+          TRI_shaper_t*            shaper;
+          TRI_shape_pid_t          pid;
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a register. its value either lives in the slot itself, is borrowed
+/// from the current row or from the AST, or is a temporary owned by the slot
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Slot {
+          TRI_json_t         value;
+          TRI_json_t const*  json;
+          TRI_json_t*        owned;
+          bool               isConstant;
+
+          inline void release () {
+            if (owned != nullptr) {
+              TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, owned);
+              owned = nullptr;
+            }
+          }
+
+          inline void setNull () {
+            release();
+            value._type = TRI_JSON_NULL;
+            json        = &value;
+            isConstant  = false;
+          }
+
+          inline void setBoolean (bool v) {
+            release();
+            value._type           = TRI_JSON_BOOLEAN;
+            value._value._boolean = v;
+            json                  = &value;
+            isConstant            = false;
+          }
+
+          inline void setNumber (double v) {
+            release();
+            value._type          = TRI_JSON_NUMBER;
+            value._value._number = v;
+            json                 = &value;
+            isConstant           = false;
+          }
+
+          inline void setStringReference (char const* data,
+                                          size_t length) {
+            release();
+            TRI_InitStringReferenceJson(&value, data, length);
+            json       = &value;
+            isConstant = false;
+          }
+
+          inline void setBorrowed (TRI_json_t const* v,
+                                   bool constant) {
+            if (v == nullptr) {
+              setNull();
+              return;
+            }
+            release();
+            json       = v;
+            isConstant = constant;
+          }
+
+          inline void setOwned (TRI_json_t* v) {
+            if (v == nullptr) {
+              setNull();
+              return;
+            }
+            release();
+            owned      = v;
+            json       = v;
+            isConstant = false;
+          }
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        CompiledExpression (CompiledExpression const&) = delete;
+        CompiledExpression& operator= (CompiledExpression const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile the expression. the node must be compilable
+////////////////////////////////////////////////////////////////////////////////
+
+        CompiledExpression (Query*,
+                            AstNode const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the compiled expression
+////////////////////////////////////////////////////////////////////////////////
+
+        ~CompiledExpression ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an expression can be compiled
+////////////////////////////////////////////////////////////////////////////////
+
+        static bool isCompilable (AstNode const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute the program for a row of an item block
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue execute (triagens::arango::AqlTransaction*,
+                          AqlItemBlock const*,
+                          size_t,
+                          std::vector<Variable*> const&,
+                          std::vector<RegisterId> const&);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile a node, writing its value into the given register
+////////////////////////////////////////////////////////////////////////////////
+
+        void compile (AstNode const*,
+                      uint32_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile a unary or binary operator
+////////////////////////////////////////////////////////////////////////////////
+
+        void compileOperator (AstNode const*,
+                              OpCode,
+                              uint32_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief allocate a new register
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t allocateRegister ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append an instruction to the program
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t emit (OpCode,
+                     uint32_t,
+                     uint32_t = 0,
+                     uint32_t = 0,
+                     TRI_json_t const* = nullptr);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute a load instruction
+////////////////////////////////////////////////////////////////////////////////
+
+        void load (Slot&,
+                   Load&,
+                   triagens::arango::AqlTransaction*,
+                   AqlItemBlock const*,
+                   size_t,
+                   std::vector<Variable*> const&,
+                   std::vector<RegisterId> const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief load an attribute from a shaped document without converting it
+/// into JSON if it is a scalar. returns false if the attribute cannot be
+/// accessed this way
+////////////////////////////////////////////////////////////////////////////////
+
+        bool loadShaped (Slot&,
+                         Load&,
+                         TRI_df_marker_t const*,
+                         TRI_document_collection_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute an arithmetic operator
+////////////////////////////////////////////////////////////////////////////////
+
+        void arithmetic (OpCode,
+                         Slot&,
+                         Slot const&,
+                         Slot const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a value in an array
+////////////////////////////////////////////////////////////////////////////////
+
+        static bool findInArray (TRI_json_t const*,
+                                 TRI_json_t const*,
+                                 bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert the value of a register into an AqlValue
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue result (Slot&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free all temporaries owned by the registers
+////////////////////////////////////////////////////////////////////////////////
+
+        void releaseSlots ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the query, used for registering warnings
+////////////////////////////////////////////////////////////////////////////////
+
+        Query* _query;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the program
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Instruction> _instructions;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the variable accesses of the program
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Load> _loads;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the register file. register 0 holds the result
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Slot> _slots;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief buffer for temporary strings
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::StringBuffer _buffer;
+    };
+
+  }  // namespace triagens::aql
+}  // namespace triagens
+
+#endif
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, extraction of the used attributes of documents
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DocumentProjector.h"
+#include "Basics/Exceptions.h"
+#include "Basics/json.h"
+#include "ShapedJson/shape-accessor.h"
+#include "VocBase/document-collection.h"
+#include "VocBase/voc-shaper.h"
+
+using namespace triagens::aql;
+using Json = triagens::basics::Json;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a projector for the attributes
+////////////////////////////////////////////////////////////////////////////////
+
+DocumentProjector::DocumentProjector (std::vector<std::string> const& attributes,
+                                      triagens::arango::AqlTransaction* trx,
+                                      TRI_document_collection_t const* collection)
+  : _attributes(),
+    _trx(trx),
+    _collection(collection),
+    _shaper(const_cast<TRI_document_collection_t*>(collection)->getShaper()),
+    _accessors(),
+    _buffer(TRI_UNKNOWN_MEM_ZONE),
+    _collectionName(),
+    _names() {
+
+  TRI_ASSERT(_collection != nullptr);
+
+  _attributes.reserve(attributes.size());
+
+  for (auto const& name : attributes) {
+    AttributeType type = ATTRIBUTE_TYPE_REGULAR;
+
+    if (name == TRI_VOC_ATTRIBUTE_KEY) {
+      type = ATTRIBUTE_TYPE_KEY;
+    }
+    else if (name == TRI_VOC_ATTRIBUTE_REV) {
+      type = ATTRIBUTE_TYPE_REV;
+    }
+    else if (name == TRI_VOC_ATTRIBUTE_ID) {
+      type = ATTRIBUTE_TYPE_ID;
+    }
+    else if (name == TRI_VOC_ATTRIBUTE_FROM) {
+      type = ATTRIBUTE_TYPE_FROM;
+    }
+    else if (name == TRI_VOC_ATTRIBUTE_TO) {
+      type = ATTRIBUTE_TYPE_TO;
+    }
+
+    _attributes.emplace_back(Attribute{ name, type, 0 });
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the projector
+////////////////////////////////////////////////////////////////////////////////
+
+DocumentProjector::~DocumentProjector () {
+  // the accessors are owned by the shaper
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the projection of a document. attributes that the document
+/// does not have are left out
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue DocumentProjector::project (TRI_df_marker_t const* marker) {
+  bool const isEdge = (marker->_type == TRI_DOC_MARKER_KEY_EDGE ||
+                       marker->_type == TRI_WAL_MARKER_EDGE);
+
+  TRI_shaped_json_t document;
+  TRI_EXTRACT_SHAPED_JSON_MARKER(document, marker);
+
+  auto const& acc = accessors(document._sid);
+
+  std::unique_ptr<Json> result(new Json(TRI_UNKNOWN_MEM_ZONE, Json::Object, _attributes.size()));
+  size_t i = 0;
+
+  for (auto const& attribute : _attributes) {
+    char const* name = attribute.name.c_str();
+
+    switch (attribute.type) {
+      case ATTRIBUTE_TYPE_KEY: {
+        (*result)(name, Json(TRI_UNKNOWN_MEM_ZONE, TRI_EXTRACT_MARKER_KEY(marker)));
+        break;
+      }
+
+      case ATTRIBUTE_TYPE_REV: {
+        _buffer.reset();
+        _buffer.appendInteger(TRI_EXTRACT_MARKER_RID(marker));
+        (*result)(name, Json(TRI_UNKNOWN_MEM_ZONE, _buffer.c_str(), _buffer.length()));
+        break;
+      }
+
+      case ATTRIBUTE_TYPE_ID: {
+        if (_collectionName.empty()) {
+          _collectionName = _trx->resolver()->getCollectionName(_collection->_info._cid);
+        }
+        (*result)(name, documentHandle(_collectionName, TRI_EXTRACT_MARKER_KEY(marker)));
+        break;
+      }
+
+      case ATTRIBUTE_TYPE_FROM: {
+        if (isEdge) {
+          (*result)(name, documentHandle(collectionName(TRI_EXTRACT_MARKER_FROM_CID(marker)), TRI_EXTRACT_MARKER_FROM_KEY(marker)));
+        }
+        break;
+      }
+
+      case ATTRIBUTE_TYPE_TO: {
+        if (isEdge) {
+          (*result)(name, documentHandle(collectionName(TRI_EXTRACT_MARKER_TO_CID(marker)), TRI_EXTRACT_MARKER_TO_KEY(marker)));
+        }
+        break;
+      }
+
+      case ATTRIBUTE_TYPE_REGULAR:
+      default: {
+        auto accessor = acc[i];
+
+        if (accessor != nullptr && accessor->_resultSid != TRI_SHAPE_ILLEGAL) {
+          TRI_shaped_json_t shaped;
+
+          if (TRI_ExecuteShapeAccessor(accessor, &document, &shaped)) {
+            TRI_json_t* json = TRI_JsonShapedJson(_shaper, &shaped);
+
+            if (json == nullptr) {
+              THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+            }
+
+            (*result)(name, json);
+          }
+        }
+        break;
+      }
+    }
+
+    ++i;
+  }
+
+  auto value = AqlValue(result.get());
+  result.release();
+  return value;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the accessors for a shape id, one per attribute
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<TRI_shape_access_t const*> const& DocumentProjector::accessors (TRI_shape_sid_t sid) {
+  auto it = _accessors.find(sid);
+
+  if (it != _accessors.end()) {
+    return (*it).second;
+  }
+
+  std::vector<TRI_shape_access_t const*> acc;
+  acc.reserve(_attributes.size());
+
+  for (auto& attribute : _attributes) {
+    TRI_shape_access_t const* accessor = nullptr;
+
+    if (attribute.type == ATTRIBUTE_TYPE_REGULAR) {
+      if (attribute.pid == 0) {
+        // the attribute may not have been used in the collection yet
+        attribute.pid = _shaper->lookupAttributePathByName(_shaper, attribute.name.c_str());
+      }
+
+      if (attribute.pid != 0) {
+        accessor = TRI_FindAccessorVocShaper(_shaper, sid, attribute.pid);
+      }
+    }
+
+    acc.emplace_back(accessor);
+  }
+
+  return (*_accessors.emplace(sid, std::move(acc)).first).second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the name of the collection referenced by an edge
+////////////////////////////////////////////////////////////////////////////////
+
+std::string const& DocumentProjector::collectionName (TRI_voc_cid_t cid) {
+  auto it = _names.find(cid);
+
+  if (it == _names.end()) {
+    it = _names.emplace(cid, _trx->resolver()->getCollectionNameCluster(cid)).first;
+  }
+
+  return (*it).second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build a document handle from a collection name and a key
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* DocumentProjector::documentHandle (std::string const& collectionName,
+                                               char const* key) {
+  _buffer.reset();
+  _buffer.appendText(collectionName);
+  _buffer.appendChar('/');
+  _buffer.appendText(key);
+
+  TRI_json_t* json = TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, _buffer.c_str(), _buffer.length());
+
+  if (json == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return json;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
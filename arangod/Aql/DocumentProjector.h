@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, extraction of the used attributes of documents
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_DOCUMENT_PROJECTOR_H
+#define ARANGODB_AQL_DOCUMENT_PROJECTOR_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+#include "Basics/StringBuffer.h"
+#include "ShapedJson/shaped-json.h"
+#include "Utils/AqlTransaction.h"
+
+struct TRI_df_marker_s;
+struct TRI_document_collection_t;
+struct TRI_shape_access_s;
+
+namespace triagens {
+  namespace aql {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           class DocumentProjector
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief turns documents into objects that only contain the given top-level
+/// attributes. the shape accessors are looked up once per shape id and are
+/// then cached in the projector
+////////////////////////////////////////////////////////////////////////////////
+
+    class DocumentProjector {
+
+        enum AttributeType {
+          ATTRIBUTE_TYPE_KEY,
+          ATTRIBUTE_TYPE_REV,
+          ATTRIBUTE_TYPE_ID,
+          ATTRIBUTE_TYPE_FROM,
+          ATTRIBUTE_TYPE_TO,
+          ATTRIBUTE_TYPE_REGULAR
+        };
+
+        struct Attribute {
+          std::string name;
+          AttributeType type;
+          TRI_shape_pid_t pid;
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        DocumentProjector (DocumentProjector const&) = delete;
+        DocumentProjector& operator= (DocumentProjector const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a projector for the attributes
+////////////////////////////////////////////////////////////////////////////////
+
+        DocumentProjector (std::vector<std::string> const&,
+                           triagens::arango::AqlTransaction*,
+                           struct TRI_document_collection_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the projector
+////////////////////////////////////////////////////////////////////////////////
+
+        ~DocumentProjector ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the projection of a document. attributes that the document
+/// does not have are left out
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue project (struct TRI_df_marker_s const*);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the accessors for a shape id, one per attribute
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<struct TRI_shape_access_s const*> const& accessors (TRI_shape_sid_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the name of the collection referenced by an edge
+////////////////////////////////////////////////////////////////////////////////
+
+        std::string const& collectionName (TRI_voc_cid_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build a document handle from a collection name and a key
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_json_t* documentHandle (std::string const&,
+                                    char const*);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the projected attributes
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Attribute> _attributes;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the transaction, used for resolving collection names
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::arango::AqlTransaction* _trx;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the collection of the documents
+////////////////////////////////////////////////////////////////////////////////
+
+        struct TRI_document_collection_t const* _collection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the shaper of the collection
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_shaper_t* _shaper;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief accessors per shape id
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_map<TRI_shape_sid_t, std::vector<struct TRI_shape_access_s const*>> _accessors;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief buffer for temporary strings
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::StringBuffer _buffer;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief name of the collection of the documents, used for _id
+////////////////////////////////////////////////////////////////////////////////
+
+        std::string _collectionName;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collection name lookup cache for _from and _to
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_map<TRI_voc_cid_t, std::string> _names;
+    };
+
+  }  // namespace triagens::aql
+}  // namespace triagens
+
+#endif
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
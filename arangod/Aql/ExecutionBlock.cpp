@@ -27,6 +27,7 @@
 
 #include "Aql/ExecutionBlock.h"
 #include "Aql/CollectionScanner.h"
+#include "Aql/DocumentProjector.h"
 #include "Aql/ExecutionEngine.h"
 #include "Basics/ScopeGuard.h"
 #include "Basics/StringUtils.h"
@@ -486,6 +487,20 @@ bool ExecutionBlock::getBlock (size_t atLeast, size_t atMost) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
   }
 
+  TRI_IF_FAILURE("ExecutionBlock::binaryRoundTrip") {
+    // pass every block through the binary format used between cluster
+    // nodes, so the format can be tested with any query
+    StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+    docs->toBinary(_trx, buffer);
+    docs.reset(new AqlItemBlock(buffer.c_str(), buffer.length()));
+  }
+
+  TRI_IF_FAILURE("ExecutionBlock::jsonRoundTrip") {
+    // same for the Json format
+    Json json(docs->toJson(_trx));
+    docs.reset(new AqlItemBlock(json));
+  }
+
   _buffer.emplace_back(docs.get());
   docs.release();
 
@@ -822,17 +837,26 @@ EnumerateCollectionBlock::EnumerateCollectionBlock (ExecutionEngine* engine,
     _scanner(nullptr),
     _posInDocuments(0),
     _random(ep->_random),
-    _mustStoreResult(true) {
+    _mustStoreResult(true),
+    _projector(nullptr) {
 
   auto trxCollection = _trx->trxCollection(_collection->cid());
   if (trxCollection != nullptr) {
     _trx->orderBarrier(trxCollection);
+
+    if (! ep->projections().empty()) {
+      _projector = new DocumentProjector(ep->projections(), _trx, _trx->documentCollection(_collection->cid()));
+    }
   }
 
   if (_random) {
     // random scan
     _scanner = new RandomCollectionScanner(_trx, trxCollection);
   }
+  else if (ep->getDepth() == 1) {
+    // outermost loop, only scanned once: read the documents in datafile order
+    _scanner = new SequentialCollectionScanner(_trx, trxCollection);
+  }
   else {
     // default: linear scan
     _scanner = new LinearCollectionScanner(_trx, trxCollection);
@@ -841,6 +865,7 @@ EnumerateCollectionBlock::EnumerateCollectionBlock (ExecutionEngine* engine,
 
 EnumerateCollectionBlock::~EnumerateCollectionBlock () {
   delete _scanner;
+  delete _projector;
 }
 
 bool EnumerateCollectionBlock::moreDocuments (size_t hint) {
@@ -962,9 +987,24 @@ AqlItemBlock* EnumerateCollectionBlock::getSome (size_t, // atLeast,
       // The result is in the first variable of this depth,
       // we do not need to do a lookup in getPlanNode()->_registerPlan->varInfo,
       // but can just take cur->getNrRegs() as registerId:
-      res->setShaped(j, 
-                     static_cast<triagens::aql::RegisterId>(curRegs),
-                     reinterpret_cast<TRI_df_marker_t const*>(_documents[_posInDocuments].getDataPtr()));
+      auto marker = reinterpret_cast<TRI_df_marker_t const*>(_documents[_posInDocuments].getDataPtr());
+
+      if (_projector != nullptr) {
+        AqlValue projected = _projector->project(marker);
+
+        try {
+          res->setValue(j, static_cast<triagens::aql::RegisterId>(curRegs), projected);
+        }
+        catch (...) {
+          projected.destroy();
+          throw;
+        }
+      }
+      else {
+        res->setShaped(j, 
+                       static_cast<triagens::aql::RegisterId>(curRegs),
+                       marker);
+      }
       // No harm done, if the setValue throws!
     }
 
@@ -1062,12 +1102,17 @@ IndexRangeBlock::IndexRangeBlock (ExecutionEngine* engine,
     _posInRanges(0),
     _sortCoords(),
     _freeCondition(true),
-    _hasV8Expression(false) {
+    _hasV8Expression(false),
+    _projector(nullptr) {
 
   auto trxCollection = _trx->trxCollection(_collection->cid());
 
   if (trxCollection != nullptr) {
     _trx->orderBarrier(trxCollection);
+
+    if (! en->projections().empty()) {
+      _projector = new DocumentProjector(en->projections(), _trx, _trx->documentCollection(_collection->cid()));
+    }
   }
     
   std::vector<std::vector<RangeInfo>> const& orRanges = en->_ranges;
@@ -1119,6 +1164,7 @@ IndexRangeBlock::~IndexRangeBlock () {
   }
  
   delete _edgeIndexIterator; 
+  delete _projector;
 }
 
 bool IndexRangeBlock::useHighBounds () const {
@@ -1906,9 +1952,23 @@ AqlItemBlock* IndexRangeBlock::getSome (size_t atLeast,
         // The result is in the first variable of this depth,
         // we do not need to do a lookup in getPlanNode()->_registerPlan->varInfo,
         // but can just take cur->getNrRegs() as registerId:
-        res->setValue(j, static_cast<triagens::aql::RegisterId>(curRegs),
-                      AqlValue(reinterpret_cast<TRI_df_marker_t
-                               const*>(_documents[_posInDocs++].getDataPtr())));
+        auto marker = reinterpret_cast<TRI_df_marker_t const*>(_documents[_posInDocs++].getDataPtr());
+
+        if (_projector != nullptr) {
+          AqlValue projected = _projector->project(marker);
+
+          try {
+            res->setValue(j, static_cast<triagens::aql::RegisterId>(curRegs), projected);
+          }
+          catch (...) {
+            projected.destroy();
+            throw;
+          }
+        }
+        else {
+          res->setValue(j, static_cast<triagens::aql::RegisterId>(curRegs),
+                        AqlValue(marker));
+        }
         // No harm done, if the setValue throws!
       }
     }
@@ -2772,188 +2832,790 @@ void EnumerateListBlock::throwArrayExpectedException () {
 }
 
 // -----------------------------------------------------------------------------
-// --SECTION--                                            class CalculationBlock
+// --SECTION--                                              class TraversalBlock
 // -----------------------------------------------------------------------------
-        
-CalculationBlock::CalculationBlock (ExecutionEngine* engine,
-                                    CalculationNode const* en)
-  : ExecutionBlock(engine, en),
-    _expression(en->expression()),
-    _inVars(),
-    _inRegs(),
-    _outReg(ExecutionNode::MaxRegisterId) {
 
-  std::unordered_set<Variable*> const& inVars = _expression->variables();
-  _inVars.reserve(inVars.size());
-  _inRegs.reserve(inVars.size());
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parent index of the start vertex in breadth-first traversals
+////////////////////////////////////////////////////////////////////////////////
 
-  for (auto it = inVars.begin(); it != inVars.end(); ++it) {
-    _inVars.emplace_back(*it);
-    auto it2 = en->getRegisterPlan()->varInfo.find((*it)->id);
+static size_t const NoParent = SIZE_MAX;
 
-    TRI_ASSERT(it2 != en->getRegisterPlan()->varInfo.end());
-    TRI_ASSERT(it2->second.registerId < ExecutionNode::MaxRegisterId);
-    _inRegs.emplace_back(it2->second.registerId);
+TraversalBlock::TraversalBlock (ExecutionEngine* engine,
+                                TraversalNode const* en)
+  : ExecutionBlock(engine, en),
+    _vertexCollection(en->_vertexCollection),
+    _edgeDocument(nullptr),
+    _direction(en->_direction),
+    _options(en->_options),
+    _inVarRegId(ExecutionNode::MaxRegisterId),
+    _running(false),
+    _steps(),
+    _position(0),
+    _path(),
+    _connected(),
+    _visitedVertices(),
+    _visitedEdges(),
+    _iterations(0) {
+
+  auto it = en->getRegisterPlan()->varInfo.find(en->_inVariable->id);
+
+  if (it == en->getRegisterPlan()->varInfo.end()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
   }
 
-  // check if the expression is "only" a reference to another variable
-  // this allows further optimizations inside doEvaluation
-  _isReference = (_expression->node()->type == NODE_TYPE_REFERENCE);
+  _inVarRegId = (*it).second.registerId;
+  TRI_ASSERT(_inVarRegId < ExecutionNode::MaxRegisterId);
 
-  if (_isReference) {
-    TRI_ASSERT(_inRegs.size() == 1);
+  if (! en->_edgeCollection->isEdgeCollection()) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_TYPE_INVALID);
   }
 
-  auto it3 = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
-  TRI_ASSERT(it3 != en->getRegisterPlan()->varInfo.end());
-  _outReg = it3->second.registerId;
-  TRI_ASSERT(_outReg < ExecutionNode::MaxRegisterId);
-  
-  if (en->_conditionVariable != nullptr) {
-    auto it = en->getRegisterPlan()->varInfo.find(en->_conditionVariable->id);
-    TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
-    _conditionReg = it->second.registerId;
-    TRI_ASSERT(_conditionReg < ExecutionNode::MaxRegisterId);
+  auto trxCollection = _trx->trxCollection(en->_edgeCollection->cid());
+
+  if (trxCollection == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "edge collection not part of the transaction");
   }
-}
 
-CalculationBlock::~CalculationBlock () {
+  _trx->orderBarrier(trxCollection);
+  _edgeDocument = trxCollection->_collection->_collection;
 }
 
-int CalculationBlock::initialize () {
-  return ExecutionBlock::initialize();
+TraversalBlock::~TraversalBlock () {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief fill the target register in the item block with a reference to 
-/// another variable
+/// @brief initialize
 ////////////////////////////////////////////////////////////////////////////////
 
-void CalculationBlock::fillBlockWithReference (AqlItemBlock* result) {
-  result->setDocumentCollection(_outReg, result->getDocumentCollection(_inRegs[0]));
+int TraversalBlock::initialize () {
+  return ExecutionBlock::initialize();
+}
 
-  size_t const n = result->size();
-  for (size_t i = 0; i < n; i++) {
-    // need not clone to avoid a copy, the AqlItemBlock's hash takes
-    // care of correct freeing:
-    auto a = result->getValueReference(i, _inRegs[0]);
+int TraversalBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
+  int res = ExecutionBlock::initializeCursor(items, pos);
 
-    try {
-      TRI_IF_FAILURE("CalculationBlock::fillBlockWithReference") {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-      }
-      result->setValue(i, _outReg, a);
-    }
-    catch (...) {
-      a.destroy();
-      throw;
-    }
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
   }
+
+  // forget about the traversal of the previous input
+  _running = false;
+  _steps.clear();
+  _path.clear();
+  _visitedVertices.clear();
+  _visitedEdges.clear();
+
+  return TRI_ERROR_NO_ERROR;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief shared code for executing a simple or a V8 expression
-////////////////////////////////////////////////////////////////////////////////
+AqlItemBlock* TraversalBlock::getSome (size_t, size_t atMost) {
+  if (_done) {
+    return nullptr;
+  }
 
-void CalculationBlock::executeExpression (AqlItemBlock* result) {
-  result->setDocumentCollection(_outReg, nullptr);
+  unique_ptr<AqlItemBlock> res(nullptr);
+  size_t count = 0;
 
-  bool const hasCondition = (static_cast<CalculationNode const*>(_exeNode)->_conditionVariable != nullptr);
+  do {
+    // repeatedly try to get more stuff from upstream
+    // note that a traversal can return no vertices at all, in which case 
+    // we have to try again with the next input row
 
-  size_t const n = result->size();
+    if (_buffer.empty()) {
+      size_t toFetch = (std::min)(DefaultBatchSize, atMost);
+      if (! ExecutionBlock::getBlock(toFetch, toFetch)) {
+        _done = true;
+        return nullptr;
+      }
+      _pos = 0;           // this is in the first block
+    }
 
-  for (size_t i = 0; i < n; i++) {
-    // check the condition variable (if any)
-    if (hasCondition) {
-      AqlValue conditionResult = result->getValueReference(i, _conditionReg);
+    // if we make it here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
 
-      if (! conditionResult.isTrue()) {
-        TRI_IF_FAILURE("CalculationBlock::executeExpressionWithCondition") {
+    if (! _running) {
+      _running = startTraversal(cur);
+    }
+
+    while (_running && count < atMost) {
+      if (! next()) {
+        _running = false;
+        break;
+      }
+
+      if (res.get() == nullptr) {
+        // create the result
+        res.reset(new AqlItemBlock(atMost, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+
+        inheritRegisters(cur, res.get(), _pos);
+      }
+      else {
+        // re-use already copied aqlvalues
+        for (RegisterId i = 0; i < cur->getNrRegs(); i++) {
+          res->setValue(count, i, res->getValueReference(0, i));
+        }
+      }
+
+      AqlValue a = buildResult();
+
+      try {
+        TRI_IF_FAILURE("TraversalBlock::getSome") {
           THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
         }
-        result->setValue(i, _outReg, AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &Expression::NullJson, Json::NOFREE)));
-        continue;
+        res->setValue(count, cur->getNrRegs(), a);
       }
-    }
-    
-    // execute the expression
-    TRI_document_collection_t const* myCollection = nullptr;
-    AqlValue a = _expression->execute(_trx, result, i, _inVars, _inRegs, &myCollection);
-    
-    try {
-      TRI_IF_FAILURE("CalculationBlock::executeExpression") {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      catch (...) {
+        a.destroy();
+        throw;
       }
-      result->setValue(i, _outReg, a);
+
+      ++count;
     }
-    catch (...) {
-      a.destroy();
-      throw;
+
+    if (! _running) {
+      // advance read position in the current block . . .
+      if (++_pos == cur->size()) {
+        delete cur;
+        _buffer.pop_front();  // does not throw
+        _pos = 0;
+      }
     }
-    throwIfKilled(); // check if we were aborted
   }
-}
+  while (res.get() == nullptr);
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief doEvaluation, private helper to do the work
-////////////////////////////////////////////////////////////////////////////////
+  if (count < atMost) {
+    res->shrink(count);
+  }
 
-void CalculationBlock::doEvaluation (AqlItemBlock* result) {
-  TRI_ASSERT(result != nullptr);
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+  return res.release();
+}
 
-  if (_isReference) {
-    // the calculation is a reference to a variable only.
-    // no need to execute the expression at all
-    fillBlockWithReference(result);
-    throwIfKilled(); // check if we were aborted
-    return;
+size_t TraversalBlock::skipSome (size_t atLeast, size_t atMost) {
+  if (_done) {
+    return 0;
   }
 
-  // non-reference expression
-
-  TRI_ASSERT(_expression != nullptr);
+  size_t skipped = 0;
 
-  if (! _expression->isV8()) {
-    // an expression that does not require V8
-    executeExpression(result);
-  }
-  else {
-    // must have a V8 context here to protect Expression::execute()
-    triagens::basics::ScopeGuard guard{
-      [&]() -> void {
-        _engine->getQuery()->enterContext(); 
-      },
-      [&]() -> void { 
-        // must invalidate the expression now as we might be called from
-        // different threads
-        if (triagens::arango::ServerState::instance()->isRunningInCluster() ||
-            _engine->getQuery()->willExitContext()) {
-          _expression->invalidate();
-        }
-        _engine->getQuery()->exitContext(); 
+  while (skipped < atLeast) {
+    if (_buffer.empty()) {
+      size_t toFetch = (std::min)(DefaultBatchSize, atMost);
+      if (! ExecutionBlock::getBlock(toFetch, toFetch)) {
+        _done = true;
+        return skipped;
       }
-    };
+      _pos = 0;           // this is in the first block
+    }
 
-    ISOLATE;
-    v8::HandleScope scope(isolate); // do not delete this!
+    // if we make it here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
 
-    // do not merge the following function call with the same function call above!
-    // the V8 expression execution must happen in the scope that contains
-    // the V8 handle scope and the scope guard
-    executeExpression(result);
+    if (! _running) {
+      _running = startTraversal(cur);
+    }
+
+    while (_running && skipped < atMost) {
+      if (! next()) {
+        _running = false;
+        break;
+      }
+      ++skipped;
+    }
+
+    if (! _running) {
+      if (++_pos == cur->size()) {
+        delete cur;
+        _buffer.pop_front();
+        _pos = 0;
+      }
+    }
   }
+
+  return skipped;
 }
 
-AqlItemBlock* CalculationBlock::getSome (size_t atLeast,
-                                         size_t atMost) {
+////////////////////////////////////////////////////////////////////////////////
+/// @brief start a new traversal for the value in the input register.
+/// the start vertex can be given as a document or as a document id. a plain
+/// key is looked up in the vertex collection, as TRAVERSAL() does
+////////////////////////////////////////////////////////////////////////////////
 
-  std::unique_ptr<AqlItemBlock> res(ExecutionBlock::getSomeWithoutRegisterClearout(atLeast, atMost));
+bool TraversalBlock::startTraversal (AqlItemBlock const* cur) {
+  _steps.clear();
+  _position = 0;
+  _path.clear();
+  _visitedVertices.clear();
+  _visitedEdges.clear();
+  _iterations = 0;
 
-  if (res.get() == nullptr) {
-    return nullptr;
+  AqlValue const& value = cur->getValueReference(_pos, _inVarRegId);
+  Json start = value.toJson(_trx, cur->getDocumentCollection(_inVarRegId));
+  TRI_json_t const* json = start.json();
+
+  if (TRI_IsObjectJson(json)) {
+    json = TRI_LookupObjectJson(json, TRI_VOC_ATTRIBUTE_ID);
   }
 
-  doEvaluation(res.get());
+  if (! TRI_IsStringJson(json)) {
+    return false;
+  }
+
+  std::string id(json->_value._string.data, json->_value._string.length - 1);
+  size_t pos = id.find('/');
+
+  if (pos == std::string::npos) {
+    if (json != start.json()) {
+      // _id attribute without a collection name
+      return false;
+    }
+    id = _vertexCollection->getName() + "/" + id;
+    pos = _vertexCollection->getName().size();
+  }
+
+  TRI_voc_cid_t cid = _trx->resolver()->getCollectionId(id.substr(0, pos));
+
+  if (cid == 0) {
+    return false;
+  }
+
+  TRI_doc_mptr_copy_t vertex;
+  auto document = lookupVertex(cid, const_cast<TRI_voc_key_t>(id.c_str() + pos + 1), vertex);
+
+  if (document == nullptr) {
+    return false;
+  }
+
+  _steps.emplace_back(vertex, document, nullptr, NoParent);
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief advance the traversal to the next vertex that is returned
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalBlock::next () {
+  if (_options.strategy == TraversalOptions::STRATEGY_BREADTH_FIRST) {
+    return nextBreadthFirst();
+  }
+  return nextDepthFirst();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief depth-first traversal. each step stays on the stack until all
+/// vertices reachable from it have been processed, so the stack contains the
+/// current path
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalBlock::nextDepthFirst () {
+  while (! _steps.empty()) {
+    countIteration();
+
+    Step& current = _steps.back();
+
+    if (current._seen) {
+      // all connected vertices are done
+      _steps.pop_back();
+      _path.pop_back();
+      continue;
+    }
+
+    current._seen = true;
+
+    if (! checkUniqueness(current)) {
+      _steps.pop_back();
+      continue;
+    }
+
+    _path.emplace_back(current);
+
+    bool visit, expandVertex;
+    applyFilters(visit, expandVertex);
+
+    if (expandVertex) {
+      expand(0, _connected);
+
+      // push in reverse order so the first edge is visited first
+      for (auto it = _connected.rbegin(); it != _connected.rend(); ++it) {
+        _steps.emplace_back(*it);
+      }
+    }
+
+    if (visit) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief breadth-first traversal. steps are never removed from _steps, so
+/// the path of a step can be rebuilt from the parent indexes
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalBlock::nextBreadthFirst () {
+  while (_position < _steps.size()) {
+    countIteration();
+
+    size_t const index = _position++;
+
+    _path.clear();
+    for (size_t i = _steps[index]._parent; i != NoParent; i = _steps[i]._parent) {
+      _path.emplace_back(_steps[i]);
+    }
+    std::reverse(_path.begin(), _path.end());
+
+    if (! checkUniqueness(_steps[index])) {
+      continue;
+    }
+
+    _path.emplace_back(_steps[index]);
+
+    bool visit, expandVertex;
+    applyFilters(visit, expandVertex);
+
+    if (expandVertex) {
+      expand(index, _connected);
+      _steps.insert(_steps.end(), _connected.begin(), _connected.end());
+    }
+
+    if (visit) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief count an iteration and throw if there were too many
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalBlock::countIteration () {
+  if (_iterations++ > _options.maxIterations) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_GRAPH_TOO_MANY_ITERATIONS);
+  }
+
+  throwIfKilled();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check the uniqueness options for a step. the vertex is checked
+/// (and remembered) before the edge, as in the JavaScript traverser
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalBlock::checkUniqueness (Step const& step) {
+  void const* vertex = step._vertex.getDataPtr();
+
+  if (_options.uniqueVertices == TraversalOptions::UNIQUE_PATH) {
+    for (auto const& it : _path) {
+      if (it._vertex.getDataPtr() == vertex) {
+        return false;
+      }
+    }
+  }
+  else if (_options.uniqueVertices == TraversalOptions::UNIQUE_GLOBAL) {
+    if (! _visitedVertices.emplace(vertex).second) {
+      return false;
+    }
+  }
+
+  if (! step._hasEdge) {
+    return true;
+  }
+
+  void const* edge = step._edge.getDataPtr();
+
+  if (_options.uniqueEdges == TraversalOptions::UNIQUE_PATH) {
+    for (auto const& it : _path) {
+      if (it._hasEdge && it._edge.getDataPtr() == edge) {
+        return false;
+      }
+    }
+  }
+  else if (_options.uniqueEdges == TraversalOptions::UNIQUE_GLOBAL) {
+    if (! _visitedEdges.emplace(edge).second) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief apply depth and vertex filters and the pushed FILTER conditions
+/// to the last vertex in _path
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalBlock::applyFilters (bool& visit, 
+                                   bool& expandVertex) {
+  uint64_t const depth = _path.size() - 1;
+
+  visit = (depth >= _options.minDepth);
+  expandVertex = (_options.maxDepth == 0 || depth < _options.maxDepth);
+
+  bool const checkConditions = (visit && ! _options.vertexConditions.empty());
+
+  if (_options.filterVertices == nullptr && ! checkConditions) {
+    return;
+  }
+
+  Step const& current = _path.back();
+  Json vertex = documentToJson(current._vertex, current._vertexCollection);
+
+  if (_options.filterVertices != nullptr &&
+      ! _options.matchesVertex(vertex.json())) {
+    if (_options.excludeFilteredVertices) {
+      visit = false;
+    }
+    if (_options.pruneFilteredVertices) {
+      expandVertex = false;
+    }
+  }
+
+  if (checkConditions && visit) {
+    // FILTER conditions pushed into the traversal only remove vertices from
+    // the result. the traversal continues below them
+    visit = _options.matchesVertexConditions(vertex.json());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fetch the connected vertices of the last vertex in _path. vertices
+/// that do not exist are skipped, the same as in the JavaScript expanders
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalBlock::expand (size_t parent,
+                             std::vector<Step>& result) {
+  result.clear();
+
+  Step const& current = _path.back();
+  TRI_voc_cid_t const cid = current._vertexCollection->_info._cid;
+  auto key = const_cast<TRI_voc_key_t>(TRI_EXTRACT_MARKER_KEY(&current._vertex));
+
+  std::vector<TRI_doc_mptr_copy_t> edges = TRI_LookupEdgesDocumentCollection(_edgeDocument, _direction, cid, key);
+  _engine->_stats.scannedIndex += static_cast<int64_t>(edges.size());
+
+  for (auto const& edge : edges) {
+    auto marker = static_cast<TRI_df_marker_t const*>(edge.getDataPtr());
+    bool useTo;
+
+    if (_direction == TRI_EDGE_OUT) {
+      useTo = true;
+    }
+    else if (_direction == TRI_EDGE_IN) {
+      useTo = false;
+    }
+    else {
+      // the vertex on the other side
+      useTo = (TRI_EXTRACT_MARKER_FROM_CID(marker) == cid &&
+               strcmp(TRI_EXTRACT_MARKER_FROM_KEY(marker), key) == 0);
+    }
+
+    TRI_doc_mptr_copy_t peer;
+    TRI_document_collection_t* document;
+
+    if (useTo) {
+      document = lookupVertex(TRI_EXTRACT_MARKER_TO_CID(marker),
+                              const_cast<TRI_voc_key_t>(TRI_EXTRACT_MARKER_TO_KEY(marker)), 
+                              peer);
+    }
+    else {
+      document = lookupVertex(TRI_EXTRACT_MARKER_FROM_CID(marker),
+                              const_cast<TRI_voc_key_t>(TRI_EXTRACT_MARKER_FROM_KEY(marker)),
+                              peer);
+    }
+
+    if (document == nullptr) {
+      continue;
+    }
+
+    if (_options.followEdges != nullptr) {
+      Json json = documentToJson(edge, _edgeDocument);
+
+      if (! _options.matchesEdge(json.json())) {
+        continue;
+      }
+    }
+
+    result.emplace_back(peer, document, &edge, parent);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a vertex by its collection id and key
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_document_collection_t* TraversalBlock::lookupVertex (TRI_voc_cid_t cid,
+                                                         TRI_voc_key_t key,
+                                                         TRI_doc_mptr_copy_t& result) {
+  auto trxCollection = _trx->trxCollection(cid);
+
+  if (trxCollection == nullptr) {
+    // the edges lead into a collection that the query does not use. it is
+    // added for reading, as the JavaScript traverser does
+    int res = _trx->addCollectionAtRuntime(cid);
+
+    if (res == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+      // a dangling edge. the vertex does not exist
+      return nullptr;
+    }
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+
+    trxCollection = _trx->trxCollection(cid);
+
+    if (trxCollection == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+    }
+  }
+
+  if (_trx->orderBarrier(trxCollection) == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  TRI_document_collection_t* document = trxCollection->_collection->_collection;
+
+  ++_engine->_stats.scannedIndex;
+
+  auto found = static_cast<TRI_doc_mptr_t const*>(TRI_LookupByKeyPrimaryIndex(&document->_primaryIndex, key));
+
+  if (found == nullptr) {
+    return nullptr;
+  }
+
+  result = *found;
+  return document;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert a document to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+Json TraversalBlock::documentToJson (TRI_doc_mptr_copy_t const& mptr,
+                                     TRI_document_collection_t const* document) {
+  return AqlValue(reinterpret_cast<TRI_df_marker_t const*>(mptr.getDataPtr())).toJson(_trx, document);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the result value for the last vertex in _path: 
+/// { vertex } or { vertex, path: { edges, vertices } }
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue TraversalBlock::buildResult () {
+  Step const& current = _path.back();
+
+  Json result(Json::Object, 2);
+  result("vertex", documentToJson(current._vertex, current._vertexCollection));
+
+  if (_options.paths) {
+    Json edges(Json::Array, _path.size());
+    Json vertices(Json::Array, _path.size());
+
+    for (auto const& step : _path) {
+      if (step._hasEdge) {
+        edges(documentToJson(step._edge, _edgeDocument));
+      }
+      vertices(documentToJson(step._vertex, step._vertexCollection));
+    }
+
+    Json path(Json::Object, 2);
+    path("edges", edges)("vertices", vertices);
+    result("path", path);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                            class CalculationBlock
+// -----------------------------------------------------------------------------
+        
+CalculationBlock::CalculationBlock (ExecutionEngine* engine,
+                                    CalculationNode const* en)
+  : ExecutionBlock(engine, en),
+    _expression(en->expression()),
+    _inVars(),
+    _inRegs(),
+    _outReg(ExecutionNode::MaxRegisterId) {
+
+  std::unordered_set<Variable*> const& inVars = _expression->variables();
+  _inVars.reserve(inVars.size());
+  _inRegs.reserve(inVars.size());
+
+  for (auto it = inVars.begin(); it != inVars.end(); ++it) {
+    _inVars.emplace_back(*it);
+    auto it2 = en->getRegisterPlan()->varInfo.find((*it)->id);
+
+    TRI_ASSERT(it2 != en->getRegisterPlan()->varInfo.end());
+    TRI_ASSERT(it2->second.registerId < ExecutionNode::MaxRegisterId);
+    _inRegs.emplace_back(it2->second.registerId);
+  }
+
+  // check if the expression is "only" a reference to another variable
+  // this allows further optimizations inside doEvaluation
+  _isReference = (_expression->node()->type == NODE_TYPE_REFERENCE);
+
+  if (_isReference) {
+    TRI_ASSERT(_inRegs.size() == 1);
+  }
+
+  auto it3 = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
+  TRI_ASSERT(it3 != en->getRegisterPlan()->varInfo.end());
+  _outReg = it3->second.registerId;
+  TRI_ASSERT(_outReg < ExecutionNode::MaxRegisterId);
+  
+  if (en->_conditionVariable != nullptr) {
+    auto it = en->getRegisterPlan()->varInfo.find(en->_conditionVariable->id);
+    TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
+    _conditionReg = it->second.registerId;
+    TRI_ASSERT(_conditionReg < ExecutionNode::MaxRegisterId);
+  }
+}
+
+CalculationBlock::~CalculationBlock () {
+}
+
+int CalculationBlock::initialize () {
+  return ExecutionBlock::initialize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fill the target register in the item block with a reference to 
+/// another variable
+////////////////////////////////////////////////////////////////////////////////
+
+void CalculationBlock::fillBlockWithReference (AqlItemBlock* result) {
+  result->setDocumentCollection(_outReg, result->getDocumentCollection(_inRegs[0]));
+
+  size_t const n = result->size();
+  for (size_t i = 0; i < n; i++) {
+    // need not clone to avoid a copy, the AqlItemBlock's hash takes
+    // care of correct freeing:
+    auto a = result->getValueReference(i, _inRegs[0]);
+
+    try {
+      TRI_IF_FAILURE("CalculationBlock::fillBlockWithReference") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+      result->setValue(i, _outReg, a);
+    }
+    catch (...) {
+      a.destroy();
+      throw;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shared code for executing a simple or a V8 expression
+////////////////////////////////////////////////////////////////////////////////
+
+void CalculationBlock::executeExpression (AqlItemBlock* result) {
+  result->setDocumentCollection(_outReg, nullptr);
+
+  bool const hasCondition = (static_cast<CalculationNode const*>(_exeNode)->_conditionVariable != nullptr);
+
+  size_t const n = result->size();
+
+  for (size_t i = 0; i < n; i++) {
+    // check the condition variable (if any)
+    if (hasCondition) {
+      AqlValue conditionResult = result->getValueReference(i, _conditionReg);
+
+      if (! conditionResult.isTrue()) {
+        TRI_IF_FAILURE("CalculationBlock::executeExpressionWithCondition") {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+        }
+        result->setValue(i, _outReg, AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &Expression::NullJson, Json::NOFREE)));
+        continue;
+      }
+    }
+    
+    // execute the expression
+    TRI_document_collection_t const* myCollection = nullptr;
+    AqlValue a = _expression->execute(_trx, result, i, _inVars, _inRegs, &myCollection);
+    
+    try {
+      TRI_IF_FAILURE("CalculationBlock::executeExpression") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+      result->setValue(i, _outReg, a);
+    }
+    catch (...) {
+      a.destroy();
+      throw;
+    }
+    throwIfKilled(); // check if we were aborted
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief doEvaluation, private helper to do the work
+////////////////////////////////////////////////////////////////////////////////
+
+void CalculationBlock::doEvaluation (AqlItemBlock* result) {
+  TRI_ASSERT(result != nullptr);
+
+  if (_isReference) {
+    // the calculation is a reference to a variable only.
+    // no need to execute the expression at all
+    fillBlockWithReference(result);
+    throwIfKilled(); // check if we were aborted
+    return;
+  }
+
+  // non-reference expression
+
+  TRI_ASSERT(_expression != nullptr);
+
+  if (! _expression->isV8()) {
+    // an expression that does not require V8
+    executeExpression(result);
+  }
+  else {
+    // must have a V8 context here to protect Expression::execute()
+    triagens::basics::ScopeGuard guard{
+      [&]() -> void {
+        _engine->getQuery()->enterContext(); 
+      },
+      [&]() -> void { 
+        // must invalidate the expression now as we might be called from
+        // different threads
+        if (triagens::arango::ServerState::instance()->isRunningInCluster() ||
+            _engine->getQuery()->willExitContext()) {
+          _expression->invalidate();
+        }
+        _engine->getQuery()->exitContext(); 
+      }
+    };
+
+    ISOLATE;
+    v8::HandleScope scope(isolate); // do not delete this!
+
+    // do not merge the following function call with the same function call above!
+    // the V8 expression execution must happen in the scope that contains
+    // the V8 handle scope and the scope guard
+    executeExpression(result);
+  }
+}
+
+AqlItemBlock* CalculationBlock::getSome (size_t atLeast,
+                                         size_t atMost) {
+
+  std::unique_ptr<AqlItemBlock> res(ExecutionBlock::getSomeWithoutRegisterClearout(atLeast, atMost));
+
+  if (res.get() == nullptr) {
+    return nullptr;
+  }
+
+  doEvaluation(res.get());
   // Clear out registers no longer needed later:
   clearRegisters(res.get());
   return res.release();
@@ -3324,6 +3986,8 @@ SortedAggregateBlock::SortedAggregateBlock (ExecutionEngine* engine,
                                             AggregateNode const* en)
   : ExecutionBlock(engine, en),
     _aggregateRegisters(),
+    _aggregateFunctionRegisters(),
+    _aggregators(),
     _currentGroup(en->_count),
     _expressionRegister(ExecutionNode::MaxRegisterId),
     _groupRegister(ExecutionNode::MaxRegisterId),
@@ -3342,6 +4006,19 @@ SortedAggregateBlock::SortedAggregateBlock (ExecutionEngine* engine,
     _aggregateRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
   }
 
+  for (auto const& p : en->_aggregateFunctions) {
+    auto itOut = en->getRegisterPlan()->varInfo.find(p.first->id);
+    TRI_ASSERT(itOut != en->getRegisterPlan()->varInfo.end());
+
+    auto itIn = en->getRegisterPlan()->varInfo.find(p.second.first->id);
+    TRI_ASSERT(itIn != en->getRegisterPlan()->varInfo.end());
+    TRI_ASSERT((*itIn).second.registerId < ExecutionNode::MaxRegisterId);
+    TRI_ASSERT((*itOut).second.registerId < ExecutionNode::MaxRegisterId);
+    _aggregateFunctionRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
+
+    _aggregators.emplace_back(Aggregator::fromTypeString(engine->getQuery(), _trx, p.second.second));
+  }
+
   if (en->_outVariable != nullptr) {
     auto const& registerPlan = en->getRegisterPlan()->varInfo;
     auto it = registerPlan.find(en->_outVariable->id);
@@ -3513,10 +4190,20 @@ int SortedAggregateBlock::getOrSkipSome (size_t atLeast,
       if (! skipping) {
         _currentGroup.setFirstRow(_pos);
       }
+
+      for (auto& it : _aggregators) {
+        it->reset();
+      }
     }
 
     if (! skipping) {
       _currentGroup.setLastRow(_pos);
+
+      // feed the row into the running aggregates
+      size_t j = 0;
+      for (auto const& it : _aggregateFunctionRegisters) {
+        _aggregators[j++]->reduce(cur->getValueReference(_pos, it.second), cur->getDocumentCollection(it.second));
+      }
     }
 
     if (++_pos >= cur->size()) {
@@ -3620,6 +4307,11 @@ void SortedAggregateBlock::emitGroup (AqlItemBlock const* cur,
     ++i;
   }
 
+  i = 0;
+  for (auto const& it : _aggregateFunctionRegisters) {
+    res->setValue(row, it.first, _aggregators[i++]->stealValue());
+  }
+
   if (_groupRegister != ExecutionNode::MaxRegisterId) {
     // set the group values
     _currentGroup.addValues(cur, _groupRegister);
@@ -3656,6 +4348,7 @@ HashedAggregateBlock::HashedAggregateBlock (ExecutionEngine* engine,
                                             AggregateNode const* en)
   : ExecutionBlock(engine, en),
     _aggregateRegisters(),
+    _aggregateFunctionRegisters(),
     _groupRegister(ExecutionNode::MaxRegisterId) {
  
   for (auto p : en->_aggregateVariables) {
@@ -3671,6 +4364,17 @@ HashedAggregateBlock::HashedAggregateBlock (ExecutionEngine* engine,
     _aggregateRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
   }
 
+  for (auto const& p : en->_aggregateFunctions) {
+    auto itOut = en->getRegisterPlan()->varInfo.find(p.first->id);
+    TRI_ASSERT(itOut != en->getRegisterPlan()->varInfo.end());
+
+    auto itIn = en->getRegisterPlan()->varInfo.find(p.second.first->id);
+    TRI_ASSERT(itIn != en->getRegisterPlan()->varInfo.end());
+    TRI_ASSERT((*itIn).second.registerId < ExecutionNode::MaxRegisterId);
+    TRI_ASSERT((*itOut).second.registerId < ExecutionNode::MaxRegisterId);
+    _aggregateFunctionRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
+  }
+
   if (en->_outVariable != nullptr) {
     TRI_ASSERT(static_cast<AggregateNode const*>(_exeNode)->_count);
 
@@ -3734,7 +4438,7 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
     colls.emplace_back(cur->getDocumentCollection(it.second));
   }
 
-  std::unordered_map<std::vector<AqlValue>, size_t, GroupKeyHash, GroupKeyEqual> allGroups(
+  std::unordered_map<std::vector<AqlValue>, GroupState, GroupKeyHash, GroupKeyEqual> allGroups(
     1024, 
     GroupKeyHash(_trx, colls), 
     GroupKeyEqual(_trx, colls)
@@ -3772,7 +4476,12 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
     
       if (planNode->_count) {
         // set group count in result register
-        result->setValue(row, _groupRegister, AqlValue(new Json(static_cast<double>(it.second))));
+        result->setValue(row, _groupRegister, AqlValue(new Json(static_cast<double>(it.second.count))));
+      }
+
+      i = 0;
+      for (auto const& aggregator : it.second.aggregators) {
+        result->setValue(row, _aggregateFunctionRegisters[i++].first, aggregator->stealValue());
       }
 
       ++row;
@@ -3790,6 +4499,8 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
   std::vector<AqlValue> group;
   group.reserve(n);
 
+  auto const& aggregateFunctions = static_cast<AggregateNode const*>(getPlanNode())->_aggregateFunctions;
+
   try {
     while (skipped < atMost) {
       groupValues.clear();
@@ -3811,11 +4522,22 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
           group.emplace_back(cur->getValueReference(_pos, _aggregateRegisters[i].second).clone());
         }
 
-        allGroups.emplace(group, 1);
+        GroupState state;
+        state.count = 0;
+        state.aggregators.reserve(aggregateFunctions.size());
+        for (auto const& f : aggregateFunctions) {
+          state.aggregators.emplace_back(Aggregator::fromTypeString(_engine->getQuery(), _trx, f.second.second));
+        }
+
+        it = allGroups.emplace(group, std::move(state)).first;
       }
-      else {
-        // existing group. simply increase the counter
-        (*it).second++;
+
+      // increase the counter and feed the row into the running aggregates
+      (*it).second.count++;
+
+      size_t j = 0;
+      for (auto const& reg : _aggregateFunctionRegisters) {
+        (*it).second.aggregators[j++]->reduce(cur->getValueReference(_pos, reg.second), cur->getDocumentCollection(reg.second));
       }
 
       if (++_pos >= cur->size()) {
@@ -3926,7 +4648,8 @@ SortBlock::SortBlock (ExecutionEngine* engine,
                       SortNode const* en)
   : ExecutionBlock(engine, en),
     _sortRegisters(),
-    _stable(en->_stable) {
+    _stable(en->_stable),
+    _limit(en->_limit) {
   
   for (auto p : en->_elements) {
     auto it = en->getRegisterPlan()->varInfo.find(p.first->id);
@@ -3949,7 +4672,21 @@ int SortBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
     return res;
   }
   // suck all blocks into _buffer
+  size_t rows = 0;
+
   while (getBlock(DefaultBatchSize, DefaultBatchSize)) {
+    if (_limit == 0) {
+      continue;
+    }
+
+    rows += _buffer.back()->size();
+
+    if (rows >= _limit + (std::max)(_limit, DefaultBatchSize)) {
+      // top-k mode: reduce the buffer to the first _limit rows, and free
+      // the input blocks. this keeps memory usage at O(_limit) rows
+      doSorting();
+      rows = _limit;
+    }
   }
 
   if (_buffer.empty()) {
@@ -3997,8 +4734,19 @@ void SortBlock::doSorting () {
   // comparison function
   OurLessThan ourLessThan(_trx, _buffer, _sortRegisters, colls);
 
+  // in top-k mode, only the first _limit rows are needed
+  if (_limit > 0 && _limit < sum) {
+    if (_stable) {
+      std::stable_sort(coords.begin(), coords.end(), ourLessThan);
+    }
+    else {
+      // heap-based selection of the first _limit rows
+      std::partial_sort(coords.begin(), coords.begin() + _limit, coords.end(), ourLessThan);
+    }
+    sum = _limit;
+  }
   // sort coords
-  if (_stable) {
+  else if (_stable) {
     std::stable_sort(coords.begin(), coords.end(), ourLessThan);
   }
   else {
@@ -5608,6 +6356,8 @@ bool GatherBlock::hasMore () {
     }
   }
   else {
+    prefetchDependencies(0, _dependencies.size(), DefaultBatchSize, DefaultBatchSize);
+
     for (size_t i = 0; i < _gatherBlockBuffer.size(); i++) { 
       if (! _gatherBlockBuffer.at(i).empty()) {
         return true;
@@ -5635,9 +6385,13 @@ AqlItemBlock* GatherBlock::getSome (size_t atLeast, size_t atMost) {
 
   // the simple case . . .  
   if (_isSimple) {
+    // let the next dependency work while we are reading the current one
+    prefetchDependencies(_atDep, _atDep + 2, atLeast, atMost);
+
     auto res = _dependencies.at(_atDep)->getSome(atLeast, atMost);
     while (res == nullptr && _atDep < _dependencies.size() - 1) {
       _atDep++;
+      prefetchDependencies(_atDep, _atDep + 2, atLeast, atMost);
       res = _dependencies.at(_atDep)->getSome(atLeast, atMost);
     }
     if (res == nullptr) {
@@ -5650,6 +6404,9 @@ AqlItemBlock* GatherBlock::getSome (size_t atLeast, size_t atMost) {
   size_t available = 0; // nr of available rows
   size_t index = 0;     // an index of a non-empty buffer
   
+  // request blocks from all shards at once . . .
+  prefetchDependencies(0, _dependencies.size(), atLeast, atMost);
+
   // pull more blocks from dependencies . . .
   for (size_t i = 0; i < _dependencies.size(); i++) {
     
@@ -5773,6 +6530,9 @@ size_t GatherBlock::skipSome (size_t atLeast, size_t atMost) {
   size_t index = 0;     // an index of a non-empty buffer
   TRI_ASSERT(_dependencies.size() != 0); 
 
+  // request blocks from all shards at once . . .
+  prefetchDependencies(0, _dependencies.size(), atLeast, atMost);
+
   // pull more blocks from dependencies . . .
   for (size_t i = 0; i < _dependencies.size(); i++) {
     if (_gatherBlockBuffer.at(i).empty()) {
@@ -5845,14 +6605,39 @@ bool GatherBlock::getBlock (size_t i, size_t atLeast, size_t atMost) {
     try {
       _gatherBlockBuffer.at(i).emplace_back(docs);
     }
-    catch (...) {
-      delete docs;
-      throw;
+    catch (...) {
+      delete docs;
+      throw;
+    }
+    return true;
+  }
+
+  return false;
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prefetchDependencies: ask the remote dependencies in [from, to)
+/// with an empty buffer to fetch their next block asynchronously
+////////////////////////////////////////////////////////////////////////////////
+
+void GatherBlock::prefetchDependencies (size_t from,
+                                        size_t to,
+                                        size_t atLeast,
+                                        size_t atMost) {
+  ENTER_BLOCK
+  to = (std::min)(to, _dependencies.size());
+
+  for (size_t i = from; i < to; i++) {
+    if (! _isSimple && ! _gatherBlockBuffer.at(i).empty()) {
+      continue;
+    }
+
+    auto dep = _dependencies.at(i);
+    if (dep->getPlanNode()->getType() == ExecutionNode::REMOTE) {
+      static_cast<RemoteBlock*>(dep)->prefetch(atLeast, atMost);
     }
-    return true;
   }
-
-  return false;
   LEAVE_BLOCK
 }
 
@@ -6661,6 +7446,73 @@ std::string DistributeBlock::createKey () const {
 // --SECTION--                                                 class RemoteBlock
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief local helper to throw an exception from an error response body
+////////////////////////////////////////////////////////////////////////////////
+
+static bool throwExceptionFromErrorBody (ClusterCommResult const* res,
+                                         char const* body,
+                                         bool isShutdown) {
+  ENTER_BLOCK
+  std::string errorMessage;
+
+  // extract error number and message from response
+  int errorNum = TRI_ERROR_NO_ERROR;
+  TRI_json_t* json = TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, body);
+
+  if (JsonHelper::getBooleanValue(json, "error", true)) {
+    errorNum = TRI_ERROR_INTERNAL;
+    errorMessage = std::string("Error message received from shard '") + 
+      std::string(res->shardID) + 
+      std::string("' on cluster node '") +
+      std::string(res->serverID) +
+      std::string("': ");
+  }
+
+  if (TRI_IsObjectJson(json)) {
+    TRI_json_t const* v = TRI_LookupObjectJson(json, "errorNum");
+
+    if (TRI_IsNumberJson(v)) {
+      if (static_cast<int>(v->_value._number) != TRI_ERROR_NO_ERROR) {
+        /* if we've got an error num, error has to be true. */
+        TRI_ASSERT(errorNum == TRI_ERROR_INTERNAL);
+        errorNum = static_cast<int>(v->_value._number);
+      }
+    }
+
+    v = TRI_LookupObjectJson(json, "errorMessage");
+    if (TRI_IsStringJson(v)) {
+      errorMessage += std::string(v->_value._string.data, v->_value._string.length - 1);
+    }
+    else {
+      errorMessage += std::string("(no valid error in response)");
+    }
+  }
+  else {
+    errorMessage += std::string("(no valid response)");
+  }
+
+  if (json != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+  }
+
+  if (isShutdown && 
+      errorNum == TRI_ERROR_QUERY_NOT_FOUND) {
+    // this error may happen on shutdown and is thus tolerated
+    // pass the info to the caller who can opt to ignore this error
+    return true;
+  }
+
+  // In this case a proper HTTP error was reported by the DBserver,
+  if (errorNum > 0 && ! errorMessage.empty()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(errorNum, errorMessage);
+  }
+
+  // default error
+  THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
+  LEAVE_BLOCK
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief local helper to throw an exception if a HTTP request went wrong
 ////////////////////////////////////////////////////////////////////////////////
@@ -6696,63 +7548,33 @@ static bool throwExceptionAfterBadSyncRequest (ClusterCommResult* res,
       
     StringBuffer const& responseBodyBuf(res->result->getBody());
  
-    // extract error number and message from response
-    int errorNum = TRI_ERROR_NO_ERROR;
-    TRI_json_t* json = TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, responseBodyBuf.c_str());
-
-    if (JsonHelper::getBooleanValue(json, "error", true)) {
-      errorNum = TRI_ERROR_INTERNAL;
-      errorMessage = std::string("Error message received from shard '") + 
-        std::string(res->shardID) + 
-        std::string("' on cluster node '") +
-        std::string(res->serverID) +
-        std::string("': ");
-    }
-
-    if (TRI_IsObjectJson(json)) {
-      TRI_json_t const* v = TRI_LookupObjectJson(json, "errorNum");
-
-      if (TRI_IsNumberJson(v)) {
-        if (static_cast<int>(v->_value._number) != TRI_ERROR_NO_ERROR) {
-          /* if we've got an error num, error has to be true. */
-          TRI_ASSERT(errorNum == TRI_ERROR_INTERNAL);
-          errorNum = static_cast<int>(v->_value._number);
-        }
-      }
-
-      v = TRI_LookupObjectJson(json, "errorMessage");
-      if (TRI_IsStringJson(v)) {
-        errorMessage += std::string(v->_value._string.data, v->_value._string.length - 1);
-      }
-      else {
-        errorMessage += std::string("(no valid error in response)");
-      }
-    }
-    else {
-      errorMessage += std::string("(no valid response)");
-    }
+    return throwExceptionFromErrorBody(res, responseBodyBuf.c_str(), isShutdown);
+  }
 
-    if (json != nullptr) {
-      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
-    }
+  return false;
+  LEAVE_BLOCK
+}
 
-    if (isShutdown && 
-        errorNum == TRI_ERROR_QUERY_NOT_FOUND) {
-      // this error may happen on shutdown and is thus tolerated
-      // pass the info to the caller who can opt to ignore this error
-      return true;
-    }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief local helper to throw an exception if an asynchronous HTTP request
+/// went wrong
+////////////////////////////////////////////////////////////////////////////////
 
-    // In this case a proper HTTP error was reported by the DBserver,
-    if (errorNum > 0 && ! errorMessage.empty()) {
-      THROW_ARANGO_EXCEPTION_MESSAGE(errorNum, errorMessage);
-    }
+static void throwExceptionAfterBadAsyncRequest (ClusterCommResult* res) {
+  ENTER_BLOCK
+  if (res->status == CL_COMM_TIMEOUT ||
+      res->status == CL_COMM_ERROR) {
+    throwExceptionAfterBadSyncRequest(res, false);
+  }
 
-    // default error
+  if (res->status != CL_COMM_RECEIVED || res->answer == nullptr) {
+    // the operation was dropped or is unknown
     THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
   }
 
-  return false;
+  if (res->answer_code != triagens::rest::HttpResponse::OK) {
+    throwExceptionFromErrorBody(res, res->answer->body(), false);
+  }
   LEAVE_BLOCK
 }
 
@@ -6774,7 +7596,12 @@ RemoteBlock::RemoteBlock (ExecutionEngine* engine,
   : ExecutionBlock(engine, en),
     _server(server),
     _ownName(ownName),
-    _queryId(queryId) {
+    _queryId(queryId),
+    _prefetchTransaction(0),
+    _prefetchOperation(0),
+    _prefetched(),
+    _prefetchedPos(0),
+    _exhausted(false) {
 
   TRI_ASSERT(! queryId.empty());
   TRI_ASSERT_EXPENSIVE((triagens::arango::ServerState::instance()->isCoordinator() && ownName.empty()) ||
@@ -6782,6 +7609,13 @@ RemoteBlock::RemoteBlock (ExecutionEngine* engine,
 }
 
 RemoteBlock::~RemoteBlock () {
+  if (_prefetchOperation != 0) {
+    ClusterComm::instance()->drop("AQL", _prefetchTransaction, _prefetchOperation, "");
+  }
+
+  for (auto it : _prefetched) {
+    delete it;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -6791,7 +7625,8 @@ RemoteBlock::~RemoteBlock () {
 ClusterCommResult* RemoteBlock::sendRequest (
           triagens::rest::HttpRequest::HttpRequestType type,
           std::string const& urlPart,
-          std::string const& body) const {
+          std::string const& body,
+          bool acceptBinary) const {
   ENTER_BLOCK
   ClusterComm* cc = ClusterComm::instance();
 
@@ -6802,6 +7637,13 @@ ClusterCommResult* RemoteBlock::sendRequest (
   if (! _ownName.empty()) {
     headers.emplace(make_pair("Shard-Id", _ownName));
   }
+  TRI_IF_FAILURE("RemoteBlock::noBinaryFormat") {
+    // make the server answer in Json
+    acceptBinary = false;
+  }
+  if (acceptBinary) {
+    headers.emplace(make_pair("Accept", AqlItemBlock::BinaryContentType));
+  }
 
   auto currentThread = triagens::rest::DispatcherThread::currentDispatcherThread;
 
@@ -6828,6 +7670,242 @@ ClusterCommResult* RemoteBlock::sendRequest (
   LEAVE_BLOCK
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the body of a getSome response
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* RemoteBlock::processGetSomeResponse (char const* body,
+                                                   size_t length,
+                                                   char const* contentType) const {
+  ENTER_BLOCK
+  if (contentType != nullptr &&
+      strcmp(contentType, AqlItemBlock::BinaryContentType) == 0) {
+    // the server has understood that we can read the binary format
+    AqlItemBlock* block;
+    Json envelope(AqlItemBlock::readBinaryMessage(body, length, block));
+    std::unique_ptr<AqlItemBlock> result(block);
+
+    ExecutionStats newStats(envelope.get("stats"));
+  
+    _engine->_stats.addDelta(_deltaStats, newStats);
+    _deltaStats = newStats;
+
+    if (result == nullptr) {
+      _exhausted = true;
+    }
+
+    return result.release();
+  }
+
+  TRI_IF_FAILURE("RemoteBlock::requireBinaryFormat") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  Json responseBodyJson(TRI_UNKNOWN_MEM_ZONE,
+                        TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, body));
+
+  ExecutionStats newStats(responseBodyJson.get("stats"));
+  
+  _engine->_stats.addDelta(_deltaStats, newStats);
+  _deltaStats = newStats;
+  
+  if (JsonHelper::getBooleanValue(responseBodyJson.json(), "exhausted", true)) {
+    _exhausted = true;
+    return nullptr;
+  }
+    
+  return new triagens::aql::AqlItemBlock(responseBodyJson);
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prefetch, send an asynchronous getSome request for the next block
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::prefetch (size_t atLeast,
+                            size_t atMost) {
+  ENTER_BLOCK
+  // only the coordinator receives the answers of asynchronous requests.
+  // we keep at most one request in flight and do not fetch further ahead
+  // than one block
+  if (! _ownName.empty() ||
+      _exhausted ||
+      _prefetchOperation != 0 ||
+      _prefetched.size() > 1) {
+    return;
+  }
+
+  Json body(Json::Object, 2);
+  body("atLeast", Json(static_cast<double>(atLeast)))
+      ("atMost", Json(static_cast<double>(atMost)));
+
+  std::unique_ptr<std::string> bodyString(new std::string(body.toString()));
+  std::unique_ptr<std::map<std::string, std::string>> headers(new std::map<std::string, std::string>);
+  bool acceptBinary = true;
+  TRI_IF_FAILURE("RemoteBlock::noBinaryFormat") {
+    // make the server answer in Json
+    acceptBinary = false;
+  }
+  if (acceptBinary) {
+    headers->emplace(make_pair("Accept", AqlItemBlock::BinaryContentType));
+  }
+
+  ClusterComm* cc = ClusterComm::instance();
+  CoordTransactionID const coordTransactionId = TRI_NewTickServer();
+
+  std::unique_ptr<ClusterCommResult> res;
+  res.reset(cc->asyncRequest("AQL",
+                             coordTransactionId,
+                             _server,
+                             rest::HttpRequest::HTTP_REQUEST_PUT,
+                             std::string("/_db/") 
+                             + triagens::basics::StringUtils::urlEncode(_engine->getQuery()->trx()->vocbase()->_name)
+                             + "/_api/aql/getSome/" + _queryId,
+                             bodyString.release(),
+                             true,
+                             headers.release(),
+                             nullptr,
+                             defaultTimeOut));
+
+  if (res->status == CL_COMM_SUBMITTED) {
+    _prefetchTransaction = coordTransactionId;
+    _prefetchOperation = res->operationID;
+  }
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait for the prefetch request in flight and buffer its result
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::collectPrefetch () const {
+  ENTER_BLOCK
+  if (_prefetchOperation == 0) {
+    return;
+  }
+
+  OperationID const operationId = _prefetchOperation;
+  _prefetchOperation = 0;
+
+  // wait() tells the dispatcher that the thread is blocked
+  std::unique_ptr<ClusterCommResult> res;
+  res.reset(ClusterComm::instance()->wait("AQL",
+                                          _prefetchTransaction,
+                                          operationId,
+                                          "",
+                                          defaultTimeOut));
+  throwExceptionAfterBadAsyncRequest(res.get());
+
+  AqlItemBlock* block = processGetSomeResponse(res->answer->body(),
+                                               res->answer->bodySize(),
+                                               res->answer->header("content-type"));
+
+  if (block != nullptr) {
+    try {
+      _prefetched.emplace_back(block);
+    }
+    catch (...) {
+      delete block;
+      throw;
+    }
+  }
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait for the prefetch request in flight and throw away all
+/// prefetched data
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::discardPrefetch () {
+  ENTER_BLOCK
+  if (_prefetchOperation != 0) {
+    OperationID const operationId = _prefetchOperation;
+    _prefetchOperation = 0;
+
+    // the answer is not needed anymore, but the server must be done with
+    // the request before we can send the next one
+    std::unique_ptr<ClusterCommResult> res;
+    res.reset(ClusterComm::instance()->wait("AQL",
+                                            _prefetchTransaction,
+                                            operationId,
+                                            "",
+                                            defaultTimeOut));
+  }
+
+  for (auto it : _prefetched) {
+    delete it;
+  }
+  _prefetched.clear();
+  _prefetchedPos = 0;
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return at most atMost rows from the prefetched blocks
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* RemoteBlock::takePrefetched (size_t atMost) {
+  ENTER_BLOCK
+  if (_prefetched.empty()) {
+    collectPrefetch();
+
+    if (_prefetched.empty()) {
+      return nullptr;
+    }
+  }
+
+  AqlItemBlock* cur = _prefetched.front();
+  size_t const available = cur->size() - _prefetchedPos;
+
+  if (_prefetchedPos == 0 && available <= atMost) {
+    // hand out the whole block
+    _prefetched.pop_front();
+    return cur;
+  }
+
+  size_t const n = (std::min)(available, atMost);
+  std::unique_ptr<AqlItemBlock> res(cur->slice(_prefetchedPos, _prefetchedPos + n));
+
+  _prefetchedPos += n;
+  if (_prefetchedPos == cur->size()) {
+    delete cur;
+    _prefetched.pop_front();
+    _prefetchedPos = 0;
+  }
+
+  return res.release();
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skip at most atMost rows of the prefetched blocks
+////////////////////////////////////////////////////////////////////////////////
+
+size_t RemoteBlock::skipPrefetched (size_t atMost) {
+  ENTER_BLOCK
+  if (_prefetched.empty()) {
+    collectPrefetch();
+
+    if (_prefetched.empty()) {
+      return 0;
+    }
+  }
+
+  AqlItemBlock* cur = _prefetched.front();
+  size_t const n = (std::min)(cur->size() - _prefetchedPos, atMost);
+
+  _prefetchedPos += n;
+  if (_prefetchedPos == cur->size()) {
+    delete cur;
+    _prefetched.pop_front();
+    _prefetchedPos = 0;
+  }
+
+  return n;
+  LEAVE_BLOCK
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief initialize
 ////////////////////////////////////////////////////////////////////////////////
@@ -6850,6 +7928,9 @@ int RemoteBlock::initialize () {
 
 int RemoteBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
   ENTER_BLOCK
+  discardPrefetch();
+  _exhausted = false;
+
   // For every call we simply forward via HTTP
 
   Json body(Json::Object, 4);
@@ -6890,6 +7971,8 @@ int RemoteBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
 
 int RemoteBlock::shutdown (int errorCode) {
   ENTER_BLOCK
+  discardPrefetch();
+
   // For every call we simply forward via HTTP
 
   std::unique_ptr<ClusterCommResult> res;
@@ -6937,36 +8020,65 @@ int RemoteBlock::shutdown (int errorCode) {
 AqlItemBlock* RemoteBlock::getSome (size_t atLeast,
                                     size_t atMost) {
   ENTER_BLOCK
-  // For every call we simply forward via HTTP
+  if (_prefetched.empty() && _prefetchOperation == 0) {
+    if (_exhausted) {
+      return nullptr;
+    }
 
-  Json body(Json::Object, 2);
-  body("atLeast", Json(static_cast<double>(atLeast)))
-      ("atMost", Json(static_cast<double>(atMost)));
-  std::string bodyString(body.toString());
+    // nothing was prefetched, so we forward via HTTP and wait
+    Json body(Json::Object, 2);
+    body("atLeast", Json(static_cast<double>(atLeast)))
+        ("atMost", Json(static_cast<double>(atMost)));
+    std::string bodyString(body.toString());
 
-  std::unique_ptr<ClusterCommResult> res;
-  res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_PUT,
-                        "/_api/aql/getSome/",
-                        bodyString));
-  throwExceptionAfterBadSyncRequest(res.get(), false);
+    std::unique_ptr<ClusterCommResult> res;
+    res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_PUT,
+                          "/_api/aql/getSome/",
+                          bodyString,
+                          true));
+    throwExceptionAfterBadSyncRequest(res.get(), false);
 
-  // If we get here, then res->result is the response which will be
-  // a serialized AqlItemBlock:
-  StringBuffer const& responseBodyBuf(res->result->getBody());
-  Json responseBodyJson(TRI_UNKNOWN_MEM_ZONE,
-                        TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, 
-                                       responseBodyBuf.begin()));
+    // If we get here, then res->result is the response which will be
+    // a serialized AqlItemBlock:
+    bool found;
+    std::string const contentType(res->result->getHeaderField("content-type", found));
+    StringBuffer const& responseBodyBuf(res->result->getBody());
+    AqlItemBlock* block = processGetSomeResponse(responseBodyBuf.c_str(),
+                                                 responseBodyBuf.length(),
+                                                 found ? contentType.c_str() : nullptr);
 
-  ExecutionStats newStats(responseBodyJson.get("stats"));
-  
-  _engine->_stats.addDelta(_deltaStats, newStats);
-  _deltaStats = newStats;
-  
-  if (JsonHelper::getBooleanValue(responseBodyJson.json(), "exhausted", true)) {
-    return nullptr;
+    if (block == nullptr) {
+      return nullptr;
+    }
+
+    if (block->size() <= atMost) {
+      prefetch(atLeast, atMost);
+      return block;
+    }
+
+    try {
+      _prefetched.emplace_back(block);
+    }
+    catch (...) {
+      delete block;
+      throw;
+    }
   }
-    
-  return new triagens::aql::AqlItemBlock(responseBodyJson);
+
+  AqlItemBlock* res = takePrefetched(atMost);
+
+  if (res != nullptr) {
+    // keep the server busy while our caller processes the block
+    try {
+      prefetch(atLeast, atMost);
+    }
+    catch (...) {
+      delete res;
+      throw;
+    }
+  }
+
+  return res;
   LEAVE_BLOCK
 }
 
@@ -6976,6 +8088,15 @@ AqlItemBlock* RemoteBlock::getSome (size_t atLeast,
 
 size_t RemoteBlock::skipSome (size_t atLeast, size_t atMost) {
   ENTER_BLOCK
+  if (! _prefetched.empty() || _prefetchOperation != 0) {
+    // skip what we have already fetched first
+    return skipPrefetched(atMost);
+  }
+
+  if (_exhausted) {
+    return 0;
+  }
+
   // For every call we simply forward via HTTP
 
   Json body(Json::Object, 2);
@@ -7010,6 +8131,16 @@ size_t RemoteBlock::skipSome (size_t atLeast, size_t atMost) {
 
 bool RemoteBlock::hasMore () {
   ENTER_BLOCK
+  collectPrefetch();
+
+  if (! _prefetched.empty()) {
+    return true;
+  }
+
+  if (_exhausted) {
+    return false;
+  }
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res;
   res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_GET,
@@ -7036,6 +8167,8 @@ bool RemoteBlock::hasMore () {
 
 int64_t RemoteBlock::count () const {
   ENTER_BLOCK
+  collectPrefetch();
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res;
   res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_GET,
@@ -7063,6 +8196,15 @@ int64_t RemoteBlock::count () const {
 
 int64_t RemoteBlock::remaining () {
   ENTER_BLOCK
+  collectPrefetch();
+
+  // rows we have already fetched are not counted by the server anymore
+  int64_t buffered = 0;
+  for (auto it : _prefetched) {
+    buffered += static_cast<int64_t>(it->size());
+  }
+  buffered -= static_cast<int64_t>(_prefetchedPos);
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res;
   res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_GET,
@@ -7079,8 +8221,13 @@ int64_t RemoteBlock::remaining () {
   if (JsonHelper::getBooleanValue(responseBodyJson.json(), "error", true)) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
   }
-  return JsonHelper::getNumericValue<int64_t>
-               (responseBodyJson.json(), "remaining", 0);
+  int64_t remaining = JsonHelper::getNumericValue<int64_t>
+                        (responseBodyJson.json(), "remaining", 0);
+  if (remaining < 0) {
+    // unknown
+    return remaining;
+  }
+  return remaining + buffered;
   LEAVE_BLOCK
 }
 
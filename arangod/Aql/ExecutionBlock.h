@@ -29,6 +29,7 @@
 #define ARANGODB_AQL_EXECUTION_BLOCK_H 1
 
 #include "Basics/JsonHelper.h"
+#include "Aql/Aggregator.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/Collection.h"
 #include "Aql/CollectionScanner.h"
@@ -54,6 +55,8 @@ namespace triagens {
 
     struct CollectionScanner;
 
+    class DocumentProjector;
+
     class ExecutionEngine;
 
 // -----------------------------------------------------------------------------
@@ -569,6 +572,12 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         bool _mustStoreResult;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reduces the documents to the used attributes, if set
+////////////////////////////////////////////////////////////////////////////////
+
+        DocumentProjector* _projector;
     };
 
 // -----------------------------------------------------------------------------
@@ -868,6 +877,12 @@ namespace triagens {
 
         bool _hasV8Expression;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reduces the documents to the used attributes, if set
+////////////////////////////////////////////////////////////////////////////////
+
+        DocumentProjector* _projector;
+
     };
 
 // -----------------------------------------------------------------------------
@@ -967,6 +982,225 @@ namespace triagens {
 
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    TraversalBlock
+// -----------------------------------------------------------------------------
+
+    class TraversalBlock : public ExecutionBlock {
+
+      public:
+
+        TraversalBlock (ExecutionEngine*,
+                        TraversalNode const*);
+
+        ~TraversalBlock ();
+
+        int initialize () override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initializeCursor, resets the current traversal
+////////////////////////////////////////////////////////////////////////////////
+
+        int initializeCursor (AqlItemBlock* items, size_t pos) override;
+
+        AqlItemBlock* getSome (size_t atLeast, size_t atMost) override final;
+
+////////////////////////////////////////////////////////////////////////////////
+// skip between atLeast and atMost returns the number actually skipped . . .
+// will only return less than atLeast if there aren't atLeast many
+// things to skip overall.
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t skipSome (size_t atLeast, size_t atMost) override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a vertex reached during the traversal, together with the edge it
+/// was reached by
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Step {
+          Step (TRI_doc_mptr_copy_t const& vertex,
+                TRI_document_collection_t const* vertexCollection,
+                TRI_doc_mptr_copy_t const* edge,
+                size_t parent)
+            : _vertex(vertex),
+              _vertexCollection(vertexCollection),
+              _edge(),
+              _hasEdge(edge != nullptr),
+              _seen(false),
+              _parent(parent) {
+
+            if (edge != nullptr) {
+              _edge = *edge;
+            }
+          }
+
+          TRI_doc_mptr_copy_t _vertex;
+          TRI_document_collection_t const* _vertexCollection;
+          TRI_doc_mptr_copy_t _edge;
+          bool _hasEdge;
+          bool _seen;     // depth-first only
+          size_t _parent; // breadth-first only
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief start a new traversal for the value in the input register.
+/// returns false if the start vertex does not exist
+////////////////////////////////////////////////////////////////////////////////
+
+        bool startTraversal (AqlItemBlock const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief advance the traversal to the next vertex that is returned.
+/// returns false if the traversal is exhausted. the vertex and the path
+/// leading to it are in _path afterwards
+////////////////////////////////////////////////////////////////////////////////
+
+        bool next ();
+
+        bool nextDepthFirst ();
+
+        bool nextBreadthFirst ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief count an iteration and throw if there were too many
+////////////////////////////////////////////////////////////////////////////////
+
+        void countIteration ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check the uniqueness options for a step. _path must contain the
+/// ancestors of the step
+////////////////////////////////////////////////////////////////////////////////
+
+        bool checkUniqueness (Step const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief apply depth and vertex filters and the pushed FILTER conditions
+/// to the last vertex in _path
+////////////////////////////////////////////////////////////////////////////////
+
+        void applyFilters (bool&, bool&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fetch the connected vertices of the last vertex in _path, in the
+/// order in which the edge index returns the edges
+////////////////////////////////////////////////////////////////////////////////
+
+        void expand (size_t, std::vector<Step>&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a vertex by its collection id and key. returns nullptr if
+/// the vertex does not exist. collections that are not part of the query
+/// are added to its transaction for reading
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_document_collection_t* lookupVertex (TRI_voc_cid_t,
+                                                 TRI_voc_key_t,
+                                                 TRI_doc_mptr_copy_t&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert a document to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Json documentToJson (TRI_doc_mptr_copy_t const&,
+                                               TRI_document_collection_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the result value for the last vertex in _path
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue buildResult ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the vertex collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection const* _vertexCollection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the underlying edge collection
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_document_collection_t* _edgeDocument;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the direction in which edges are followed
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_edge_direction_e _direction;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief traversal options
+////////////////////////////////////////////////////////////////////////////////
+
+        TraversalOptions const& _options;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the register index containing the start vertex
+////////////////////////////////////////////////////////////////////////////////
+
+        RegisterId _inVarRegId;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a traversal for the current input row is running
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _running;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pending steps. a stack for depth-first traversals, a queue (read
+/// from _position on) for breadth-first traversals
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Step> _steps;
+
+        size_t _position;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the current path, from the start vertex to the current vertex
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Step> _path;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief connected vertices, reused between expansions
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Step> _connected;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief vertices and edges seen so far, for global uniqueness
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_set<void const*> _visitedVertices;
+
+        std::unordered_set<void const*> _visitedEdges;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of iterations of the current traversal
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _iterations;
+
+    };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                  CalculationBlock
 // -----------------------------------------------------------------------------
@@ -1227,6 +1461,19 @@ namespace triagens {
 
         std::vector<std::pair<RegisterId, RegisterId>> _aggregateRegisters;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pairs, consisting of out register and in register, for the
+/// aggregate functions
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<RegisterId, RegisterId>> _aggregateFunctionRegisters;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief running aggregates of the current group, one per aggregate function
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::unique_ptr<Aggregator>> _aggregators;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief details about the current group
 ////////////////////////////////////////////////////////////////////////////////
@@ -1287,6 +1534,13 @@ namespace triagens {
 
         std::vector<std::pair<RegisterId, RegisterId>> _aggregateRegisters;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pairs, consisting of out register and in register, for the
+/// aggregate functions
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<RegisterId, RegisterId>> _aggregateFunctionRegisters;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the optional register that contains the values for each group
 /// if no values should be returned, then this has a value of MaxRegisterId
@@ -1294,6 +1548,15 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         RegisterId _groupRegister;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief state of a group: number of rows and running aggregates
+////////////////////////////////////////////////////////////////////////////////
+
+        struct GroupState {
+          size_t count;
+          std::vector<std::unique_ptr<Aggregator>> aggregators;
+        };
         
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief hasher for a vector of AQL values
@@ -1399,6 +1662,14 @@ namespace triagens {
 
         bool _stable;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of rows to keep (0 = unlimited)
+/// if set, the block only keeps the first <_limit> rows in sort order and 
+/// frees all other input rows as early as possible
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t const _limit;
+
     };
 
 // -----------------------------------------------------------------------------
@@ -1945,6 +2216,17 @@ namespace triagens {
         
         bool getBlock (size_t i, size_t atLeast, size_t atMost);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prefetchDependencies: ask all remote dependencies in the range
+/// [from, to) whose buffer is empty to fetch their next block asynchronously,
+/// so that the shards work in parallel
+////////////////////////////////////////////////////////////////////////////////
+
+        void prefetchDependencies (size_t from,
+                                   size_t to,
+                                   size_t atLeast,
+                                   size_t atMost);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief _gatherBlockBuffer: buffer the incoming block from each dependency
 /// separately 
@@ -2449,6 +2731,15 @@ namespace triagens {
 
         int64_t remaining () override final;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prefetch, send an asynchronous getSome request for the next block
+/// unless one is already in flight or a block is buffered. this is only done
+/// on the coordinator, other callers ignore it
+////////////////////////////////////////////////////////////////////////////////
+
+        void prefetch (size_t atLeast,
+                       size_t atMost);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief internal method to send a request
 ////////////////////////////////////////////////////////////////////////////////
@@ -2458,7 +2749,45 @@ namespace triagens {
         triagens::arango::ClusterCommResult* sendRequest (
                   rest::HttpRequest::HttpRequestType type,
                   std::string const& urlPart,
-                  std::string const& body) const;
+                  std::string const& body,
+                  bool acceptBinary = false) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the body of a getSome response, which is either Json or a
+/// binary message, depending on the content type. returns the block or a
+/// nullptr if the remote side is exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlItemBlock* processGetSomeResponse (char const* body,
+                                              size_t length,
+                                              char const* contentType) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait for the prefetch request in flight (if any) and buffer its
+/// result
+////////////////////////////////////////////////////////////////////////////////
+
+        void collectPrefetch () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait for the prefetch request in flight (if any) and throw away
+/// all prefetched data
+////////////////////////////////////////////////////////////////////////////////
+
+        void discardPrefetch ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return at most atMost rows from the prefetched blocks, or a
+/// nullptr if nothing is buffered
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlItemBlock* takePrefetched (size_t atMost);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skip at most atMost rows of the prefetched blocks
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t skipPrefetched (size_t atMost);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief our server, can be like "shard:S1000" or like "server:Claus"
@@ -2480,11 +2809,38 @@ namespace triagens {
         std::string _queryId;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief the ID of the query on the server as a string
+/// @brief the statistics last reported by the server
 ////////////////////////////////////////////////////////////////////////////////
 
-        ExecutionStats _deltaStats;
-        
+        mutable ExecutionStats _deltaStats;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the transaction and operation id of the getSome request in flight,
+/// the operation id is 0 if there is none. the server handles only one
+/// request per query at a time, so every other request must wait for it
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::arango::CoordTransactionID _prefetchTransaction;
+
+        mutable triagens::arango::OperationID _prefetchOperation;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief blocks received ahead of consumption
+////////////////////////////////////////////////////////////////////////////////
+
+        mutable std::deque<AqlItemBlock*> _prefetched;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief position in the first prefetched block
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _prefetchedPos;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the server has reported that it is exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+        mutable bool _exhausted;
 
     };
 
@@ -75,7 +75,8 @@ std::unordered_map<int, std::string const> const ExecutionNode::TypeNames{
   { static_cast<int>(DISTRIBUTE),                   "DistributeNode" },
   { static_cast<int>(GATHER),                       "GatherNode" },
   { static_cast<int>(NORESULTS),                    "NoResultsNode" },
-  { static_cast<int>(UPSERT),                       "UpsertNode" }
+  { static_cast<int>(UPSERT),                       "UpsertNode" },
+  { static_cast<int>(TRAVERSAL),                    "TraversalNode" }
 };
           
 // -----------------------------------------------------------------------------
@@ -137,6 +138,8 @@ ExecutionNode* ExecutionNode::fromJsonFactory (ExecutionPlan* plan,
       return new EnumerateCollectionNode(plan, oneNode);
     case ENUMERATE_LIST:
       return new EnumerateListNode(plan, oneNode);
+    case TRAVERSAL:
+      return new TraversalNode(plan, oneNode);
     case FILTER:
       return new FilterNode(plan, oneNode);
     case LIMIT:
@@ -182,6 +185,21 @@ ExecutionNode* ExecutionNode::fromJsonFactory (ExecutionPlan* plan,
 
         aggregateVariables.emplace_back(std::make_pair(outVar, inVar));
       }
+      
+      std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> aggregateFunctions;
+      triagens::basics::Json jsonAggregateFunctions = oneNode.get("aggregateFunctions");
+      if (jsonAggregateFunctions.isArray()) {
+        size_t const n = jsonAggregateFunctions.size();
+        aggregateFunctions.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+          triagens::basics::Json oneJsonAggregate = jsonAggregateFunctions.at(static_cast<int>(i));
+          Variable* outVar = varFromJson(plan->getAst(), oneJsonAggregate, "outVariable");
+          Variable* inVar =  varFromJson(plan->getAst(), oneJsonAggregate, "inVariable");
+          std::string const type = JsonHelper::checkAndGetStringValue(oneJsonAggregate.json(), "type");
+
+          aggregateFunctions.emplace_back(std::make_pair(outVar, std::make_pair(inVar, type)));
+        }
+      }
 
       bool count = JsonHelper::checkAndGetBooleanValue(oneNode.json(), "count");
 
@@ -192,6 +210,7 @@ ExecutionNode* ExecutionNode::fromJsonFactory (ExecutionPlan* plan,
                                keepVariables,
                                plan->getAst()->variables()->variables(false),
                                aggregateVariables,  
+                               aggregateFunctions,
                                count);
     }
     case INSERT:
@@ -910,6 +929,22 @@ void ExecutionNode::RegisterPlan::after (ExecutionNode *en) {
       break;
     }
 
+    case ExecutionNode::TRAVERSAL: {
+      depth++;
+      nrRegsHere.emplace_back(1);
+      // create a copy of the last value here
+      // this is requried because back returns a reference and emplace/push_back may invalidate all references
+      RegisterId registerId = 1 + nrRegs.back();
+      nrRegs.emplace_back(registerId);
+
+      auto ep = static_cast<TraversalNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(make_pair(ep->_outVariable->id,
+                               VarInfo(depth, totalNrRegs)));
+      totalNrRegs++;
+      break;
+    }
+
     case ExecutionNode::CALCULATION: {
       nrRegsHere[depth]++;
       nrRegs[depth]++;
@@ -953,6 +988,14 @@ void ExecutionNode::RegisterPlan::after (ExecutionNode *en) {
                                  VarInfo(depth, totalNrRegs)));
         totalNrRegs++;
       }
+      for (auto const& p : ep->_aggregateFunctions) {
+        // the aggregate results also live in the new frame
+        nrRegsHere[depth]++;
+        nrRegs[depth]++;
+        varInfo.emplace(make_pair(p.first->id,
+                                 VarInfo(depth, totalNrRegs)));
+        totalNrRegs++;
+      }
       if (ep->_outVariable != nullptr) {
         nrRegsHere[depth]++;
         nrRegs[depth]++;
@@ -1164,13 +1207,58 @@ double SingletonNode::estimateCost (size_t& nrItems) const {
 // --SECTION--                                methods of EnumerateCollectionNode
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the projected attributes of a collection or index scan
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<std::string> ProjectionsFromJson (triagens::basics::Json const& base) {
+  std::vector<std::string> projections;
+  triagens::basics::Json json = base.get("projections");
+
+  if (json.isArray()) {
+    size_t const n = json.size();
+    projections.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      triagens::basics::Json attribute = json.at(static_cast<int>(i));
+
+      if (attribute.isString()) {
+        projections.emplace_back(JsonHelper::getStringValue(attribute.json(), ""));
+      }
+    }
+  }
+
+  return projections;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add the projected attributes of a collection or index scan to its
+/// JSON representation
+////////////////////////////////////////////////////////////////////////////////
+
+static void ProjectionsToJson (triagens::basics::Json& json,
+                               std::vector<std::string> const& projections) {
+  if (projections.empty()) {
+    return;
+  }
+
+  triagens::basics::Json values(triagens::basics::Json::Array, projections.size());
+
+  for (auto const& attribute : projections) {
+    values(triagens::basics::Json(attribute));
+  }
+
+  json("projections", values);
+}
+
 EnumerateCollectionNode::EnumerateCollectionNode (ExecutionPlan* plan,
                                                   triagens::basics::Json const& base)
   : ExecutionNode(plan, base),
     _vocbase(plan->getAst()->query()->vocbase()),
     _collection(plan->getAst()->query()->collections()->get(JsonHelper::checkAndGetStringValue(base.json(), "collection"))),
     _outVariable(varFromJson(plan->getAst(), base, "outVariable")),
-    _random(JsonHelper::checkAndGetBooleanValue(base.json(), "random")) {
+    _random(JsonHelper::checkAndGetBooleanValue(base.json(), "random")),
+    _projections(ProjectionsFromJson(base)) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1192,6 +1280,8 @@ void EnumerateCollectionNode::toJsonHelper (triagens::basics::Json& nodes,
       ("outVariable", _outVariable->toJson())
       ("random", triagens::basics::Json(_random));
 
+  ProjectionsToJson(json, _projections);
+
   // And add it:
   nodes(json);
 }
@@ -1210,6 +1300,7 @@ ExecutionNode* EnumerateCollectionNode::clone (ExecutionPlan* plan,
   }
     
   auto c = new EnumerateCollectionNode(plan, _id, _vocbase, _collection, outVariable, _random);
+  c->_projections = _projections;
 
   CloneHelper(c, plan, withDependencies, withProperties);
 
@@ -1455,6 +1546,146 @@ double EnumerateListNode::estimateCost (size_t& nrItems) const {
   return depCost + static_cast<double>(length) * incoming; 
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                          methods of TraversalNode
+// -----------------------------------------------------------------------------
+
+TraversalNode::TraversalNode (ExecutionPlan* plan,
+                              triagens::basics::Json const& base)
+  : ExecutionNode(plan, base),
+    _vocbase(plan->getAst()->query()->vocbase()),
+    _vertexCollection(plan->getAst()->query()->collections()->get(JsonHelper::checkAndGetStringValue(base.json(), "vertexCollection"))),
+    _edgeCollection(plan->getAst()->query()->collections()->get(JsonHelper::checkAndGetStringValue(base.json(), "edgeCollection"))),
+    _inVariable(varFromJson(plan->getAst(), base, "inVariable")),
+    _outVariable(varFromJson(plan->getAst(), base, "outVariable")),
+    _direction(TRI_EDGE_OUT),
+    _options() {
+
+  if (_vertexCollection == nullptr || _edgeCollection == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "no collection for TraversalNode");
+  }
+
+  if (! directionFromString(JsonHelper::checkAndGetStringValue(base.json(), "direction"), _direction)) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid direction for TraversalNode");
+  }
+
+  if (! _options.parse(base.get("traversalOptions").json()) ||
+      ! _options.parseVertexConditions(base.get("vertexConditions").json())) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid options for TraversalNode");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toJson, for TraversalNode
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalNode::toJsonHelper (triagens::basics::Json& nodes,
+                                  TRI_memory_zone_t* zone,
+                                  bool verbose) const {
+  triagens::basics::Json json(ExecutionNode::toJsonHelperGeneric(nodes, zone, verbose));  // call base class method
+  if (json.isEmpty()) {
+    return;
+  }
+
+  json("database", triagens::basics::Json(_vocbase->_name))
+      ("vertexCollection", triagens::basics::Json(_vertexCollection->getName()))
+      ("edgeCollection", triagens::basics::Json(_edgeCollection->getName()))
+      ("direction", triagens::basics::Json(directionToString(_direction)))
+      ("inVariable",  _inVariable->toJson())
+      ("outVariable", _outVariable->toJson());
+
+  _options.toJson(json, zone);
+
+  // And add it:
+  nodes(json);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* TraversalNode::clone (ExecutionPlan* plan,
+                                     bool withDependencies,
+                                     bool withProperties) const {
+  auto outVariable = _outVariable;
+  auto inVariable = _inVariable;
+
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    inVariable = plan->getAst()->variables()->createVariable(inVariable);
+  }
+
+  auto c = new TraversalNode(plan, _id, _vocbase, _vertexCollection, _edgeCollection, 
+                             inVariable, outVariable, _direction, _options);
+
+  CloneHelper(c, plan, withDependencies, withProperties);
+
+  return static_cast<ExecutionNode*>(c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a traversal node
+////////////////////////////////////////////////////////////////////////////////
+        
+double TraversalNode::estimateCost (size_t& nrItems) const {
+  size_t incoming = 0;
+  double depCost = _dependencies.at(0)->getCost(incoming);
+
+  // the number of vertices reached from a start vertex is only known at 
+  // runtime. a traversal cannot return more vertices than there are edges
+  // (plus the start vertex) unless uniqueness is switched off, so use the
+  // number of edges as an upper bound and assume 100 as the JavaScript 
+  // version (EnumerateListNode) does
+  size_t length = _edgeCollection->count() + 1;
+  if (length > 100) {
+    length = 100;
+  }
+
+  nrItems = length * incoming;
+  return depCost + static_cast<double>(length) * incoming; 
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert a direction string as accepted by TRAVERSAL()
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalNode::directionFromString (std::string const& value,
+                                         TRI_edge_direction_e& direction) {
+  std::string lower(value);
+  for (auto& c : lower) {
+    c = static_cast<char>(::tolower(c));
+  }
+
+  if (lower == "outbound") {
+    direction = TRI_EDGE_OUT;
+  }
+  else if (lower == "inbound") {
+    direction = TRI_EDGE_IN;
+  }
+  else if (lower == "any") {
+    direction = TRI_EDGE_ANY;
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stringify a direction
+////////////////////////////////////////////////////////////////////////////////
+
+std::string TraversalNode::directionToString (TRI_edge_direction_e direction) {
+  if (direction == TRI_EDGE_OUT) {
+    return std::string("outbound");
+  }
+  if (direction == TRI_EDGE_IN) {
+    return std::string("inbound");
+  }
+  return std::string("any");
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                         methods of IndexRangeNode
 // -----------------------------------------------------------------------------
@@ -1493,6 +1724,8 @@ void IndexRangeNode::toJsonHelper (triagens::basics::Json& nodes,
   json("index", _index->toJson()); 
   json("reverse", triagens::basics::Json(_reverse));
 
+  ProjectionsToJson(json, _projections);
+
   // And add it:
   nodes(json);
 }
@@ -1517,6 +1750,7 @@ ExecutionNode* IndexRangeNode::clone (ExecutionPlan* plan,
 
   auto c = new IndexRangeNode(plan, _id, _vocbase, _collection, 
                               outVariable, _index, ranges, _reverse);
+  c->_projections = _projections;
 
   CloneHelper(c, plan, withDependencies, withProperties);
 
@@ -1535,7 +1769,8 @@ IndexRangeNode::IndexRangeNode (ExecutionPlan* plan,
     _outVariable(varFromJson(plan->getAst(), json, "outVariable")),
     _index(nullptr), 
     _ranges(),
-    _reverse(false) {
+    _reverse(false),
+    _projections(ProjectionsFromJson(json)) {
 
   triagens::basics::Json rangeArrayJson(TRI_UNKNOWN_MEM_ZONE, JsonHelper::checkAndGetArrayValue(json.json(), "ranges"));
 
@@ -2136,7 +2371,8 @@ SortNode::SortNode (ExecutionPlan* plan,
                     bool stable)
   : ExecutionNode(plan, base),
     _elements(elements),
-    _stable(stable) {
+    _stable(stable),
+    _limit(JsonHelper::getNumericValue<size_t>(base.json(), "limit", 0)) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2160,6 +2396,7 @@ void SortNode::toJsonHelper (triagens::basics::Json& nodes,
   }
   json("elements", values);
   json("stable", triagens::basics::Json(_stable));
+  json("limit", triagens::basics::Json(static_cast<double>(_limit)));
 
   // And add it:
   nodes(json);
@@ -2297,6 +2534,11 @@ double SortNode::estimateCost (size_t& nrItems) const {
   if (nrItems <= 3.0) {
     return depCost + nrItems;
   }
+  if (_limit > 0 && _limit < nrItems) {
+    // top-k sort: every row is compared against a heap of <limit> rows only
+    double const k = (std::max)(static_cast<double>(_limit), 3.0);
+    return depCost + nrItems * log(k);
+  }
   return depCost + nrItems * log(nrItems);
 }
 
@@ -2311,10 +2553,12 @@ AggregateNode::AggregateNode (ExecutionPlan* plan,
                               std::vector<Variable const*> const& keepVariables,
                               std::unordered_map<VariableId, std::string const> const& variableMap,
                               std::vector<std::pair<Variable const*, Variable const*>> const& aggregateVariables,
+                              std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> const& aggregateFunctions,
                               bool count)
   : ExecutionNode(plan, base),
     _options(base),
     _aggregateVariables(aggregateVariables), 
+    _aggregateFunctions(aggregateFunctions), 
     _expressionVariable(expressionVariable),
     _outVariable(outVariable),
     _keepVariables(keepVariables),
@@ -2347,6 +2591,19 @@ void AggregateNode::toJsonHelper (triagens::basics::Json& nodes,
   }
   json("aggregates", values);
 
+  if (! _aggregateFunctions.empty()) {
+    triagens::basics::Json functions(triagens::basics::Json::Array, _aggregateFunctions.size());
+
+    for (auto const& it : _aggregateFunctions) {
+      triagens::basics::Json function(triagens::basics::Json::Object);
+      function("outVariable", it.first->toJson())
+              ("inVariable", it.second.first->toJson())
+              ("type", triagens::basics::Json(it.second.second));
+      functions(function);
+    }
+    json("aggregateFunctions", functions);
+  }
+
   // expression variable might be empty
   if (_expressionVariable != nullptr) {
     json("expressionVariable", _expressionVariable->toJson());
@@ -2385,6 +2642,7 @@ ExecutionNode* AggregateNode::clone (ExecutionPlan* plan,
   auto outVariable = _outVariable;
   auto expressionVariable = _expressionVariable;
   auto aggregateVariables = _aggregateVariables;
+  auto aggregateFunctions = _aggregateFunctions;
 
   if (withProperties) {
     if (expressionVariable != nullptr) {
@@ -2403,12 +2661,21 @@ ExecutionNode* AggregateNode::clone (ExecutionPlan* plan,
       auto in  = plan->getAst()->variables()->createVariable(it.second);
       aggregateVariables.emplace_back(std::make_pair(out, in));
     }
+
+    aggregateFunctions.clear();
+
+    for (auto const& it : _aggregateFunctions) {
+      auto out = plan->getAst()->variables()->createVariable(it.first);
+      auto in  = plan->getAst()->variables()->createVariable(it.second.first);
+      aggregateFunctions.emplace_back(std::make_pair(out, std::make_pair(in, it.second.second)));
+    }
   }
 
   auto c = new AggregateNode(plan, 
                              _id,
                              _options, 
                              aggregateVariables, 
+                             aggregateFunctions, 
                              expressionVariable, 
                              outVariable, 
                              _keepVariables, 
@@ -2442,6 +2709,7 @@ struct UserVarFinder : public WalkerWorker<ExecutionNode> {
     else if (en->getType() == ExecutionNode::ENUMERATE_COLLECTION ||
              en->getType() == ExecutionNode::INDEX_RANGE ||
              en->getType() == ExecutionNode::ENUMERATE_LIST ||
+             en->getType() == ExecutionNode::TRAVERSAL ||
              en->getType() == ExecutionNode::AGGREGATE) {
       depth += 1;
     }
@@ -2462,6 +2730,9 @@ std::vector<Variable const*> AggregateNode::getVariablesUsedHere () const {
   for (auto p : _aggregateVariables) {
     v.insert(p.second);
   }
+  for (auto const& p : _aggregateFunctions) {
+    v.insert(p.second.first);
+  }
 
   if (_expressionVariable != nullptr) {
     v.insert(_expressionVariable);
@@ -2517,7 +2788,8 @@ double AggregateNode::estimateCost (size_t& nrItems) const {
   // and thus this potential overestimation does not really matter.
 
 
-  if (_count && _aggregateVariables.empty()) {
+  if (_aggregateVariables.empty() && 
+      (_count || ! _aggregateFunctions.empty())) {
     // we are known to only produce a single output row
     nrItems = 1;
   }
@@ -38,11 +38,13 @@
 #include "Aql/Query.h"
 #include "Aql/RangeInfo.h"
 #include "Aql/Range.h"
+#include "Aql/TraversalOptions.h"
 #include "Aql/types.h"
 #include "Aql/Variable.h"
 #include "Aql/WalkerWorker.h"
 #include "Basics/JsonHelper.h"
 #include "lib/Basics/json-utilities.h"
+#include "VocBase/edge-collection.h"
 #include "VocBase/voc-types.h"
 #include "VocBase/vocbase.h"
 
@@ -101,7 +103,8 @@ namespace triagens {
           RETURN                  = 18,
           NORESULTS               = 19,
           DISTRIBUTE              = 20,
-          UPSERT                  = 21
+          UPSERT                  = 21,
+          TRAVERSAL               = 22
         };
 
 // -----------------------------------------------------------------------------
@@ -960,6 +963,23 @@ namespace triagens {
           return _outVariable;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the attributes the documents are reduced to. an empty list
+/// means the complete documents are produced
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> const& projections () const {
+          return _projections;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the attributes the documents are reduced to
+////////////////////////////////////////////////////////////////////////////////
+
+        void setProjections (std::vector<std::string> const& projections) {
+          _projections = projections;
+        }
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -989,6 +1009,12 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         bool _random;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the attributes the documents are reduced to
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> _projections;
     };
 
 // -----------------------------------------------------------------------------
@@ -1092,6 +1118,173 @@ namespace triagens {
 
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                               class TraversalNode
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief class TraversalNode, a native replacement for
+/// FOR x IN TRAVERSAL(vertexCollection, edgeCollection, start, direction, params)
+////////////////////////////////////////////////////////////////////////////////
+
+    class TraversalNode : public ExecutionNode {
+      
+      friend class ExecutionNode;
+      friend class ExecutionBlock;
+      friend class TraversalBlock;
+      friend class RedundantCalculationsReplacer;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor
+////////////////////////////////////////////////////////////////////////////////
+
+      public:
+
+        TraversalNode (ExecutionPlan* plan,
+                       size_t id,
+                       TRI_vocbase_t* vocbase, 
+                       Collection* vertexCollection,
+                       Collection* edgeCollection,
+                       Variable const* inVariable,
+                       Variable const* outVariable,
+                       TRI_edge_direction_e direction,
+                       TraversalOptions const& options) 
+          : ExecutionNode(plan, id), 
+            _vocbase(vocbase),
+            _vertexCollection(vertexCollection),
+            _edgeCollection(edgeCollection),
+            _inVariable(inVariable), 
+            _outVariable(outVariable),
+            _direction(direction),
+            _options(options) {
+
+          TRI_ASSERT(_vocbase != nullptr);
+          TRI_ASSERT(_vertexCollection != nullptr);
+          TRI_ASSERT(_edgeCollection != nullptr);
+          TRI_ASSERT(_inVariable != nullptr);
+          TRI_ASSERT(_outVariable != nullptr);
+        }
+        
+        TraversalNode (ExecutionPlan*, triagens::basics::Json const& base);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the type of the node
+////////////////////////////////////////////////////////////////////////////////
+
+        NodeType getType () const override final {
+          return TRAVERSAL;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief export to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+        void toJsonHelper (triagens::basics::Json&,
+                           TRI_memory_zone_t*,
+                           bool) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+        ExecutionNode* clone (ExecutionPlan* plan,
+                              bool withDependencies,
+                              bool withProperties) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a traversal node
+////////////////////////////////////////////////////////////////////////////////
+        
+        double estimateCost (size_t&) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getVariablesUsedHere
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Variable const*> getVariablesUsedHere () const override final {
+          return std::vector<Variable const*>{ _inVariable };
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getVariablesSetHere
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Variable const*> getVariablesSetHere () const override final {
+          return std::vector<Variable const*>{ _outVariable };
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the traversal options. the optimizer adds FILTER conditions to them
+////////////////////////////////////////////////////////////////////////////////
+
+        TraversalOptions& options () {
+          return _options;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert a direction string ("outbound", "inbound", "any") as
+/// accepted by TRAVERSAL(). returns false for all other values
+////////////////////////////////////////////////////////////////////////////////
+
+        static bool directionFromString (std::string const&,
+                                         TRI_edge_direction_e&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stringify a direction
+////////////////////////////////////////////////////////////////////////////////
+
+        static std::string directionToString (TRI_edge_direction_e);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the database
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_vocbase_t* _vocbase;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the collection the vertices are read from
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection* _vertexCollection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the edge collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection* _edgeCollection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief input variable containing the start vertex
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* _inVariable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief output variable to write to
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* _outVariable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the direction in which edges are followed
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_edge_direction_e _direction;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief traversal options
+////////////////////////////////////////////////////////////////////////////////
+
+        TraversalOptions _options;
+
+    };
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief class IndexRangeNode
 ////////////////////////////////////////////////////////////////////////////////
@@ -1168,6 +1361,23 @@ namespace triagens {
           return _outVariable;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the attributes the documents are reduced to. an empty list
+/// means the complete documents are produced
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> const& projections () const {
+          return _projections;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the attributes the documents are reduced to
+////////////////////////////////////////////////////////////////////////////////
+
+        void setProjections (std::vector<std::string> const& projections) {
+          _projections = projections;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the ranges
 ////////////////////////////////////////////////////////////////////////////////
@@ -1289,6 +1499,12 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         bool _reverse;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the attributes the documents are reduced to
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> _projections;
     };
 
 // -----------------------------------------------------------------------------
@@ -1381,6 +1597,30 @@ namespace triagens {
           _fullCount = true;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the offset
+////////////////////////////////////////////////////////////////////////////////
+
+        inline size_t offset () const {
+          return _offset;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the limit
+////////////////////////////////////////////////////////////////////////////////
+
+        inline size_t limit () const {
+          return _limit;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the node fully counts what it limits
+////////////////////////////////////////////////////////////////////////////////
+
+        inline bool fullCount () const {
+          return _fullCount;
+        }
+
       private:
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1872,7 +2112,8 @@ namespace triagens {
                   bool stable) 
           : ExecutionNode(plan, id),
             _elements(elements),
-            _stable(stable) {
+            _stable(stable),
+            _limit(0) {
         }
         
         SortNode (ExecutionPlan* plan,
@@ -1896,6 +2137,23 @@ namespace triagens {
           return _stable;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the maximum number of rows the sort needs to produce (0 = all)
+////////////////////////////////////////////////////////////////////////////////
+
+        inline size_t limit () const {
+          return _limit;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restrict the sort to its first <limit> rows
+/// this is set by the optimizer if the sort is followed by a LIMIT
+////////////////////////////////////////////////////////////////////////////////
+
+        void setLimit (size_t limit) {
+          _limit = limit;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief export to JSON
 ////////////////////////////////////////////////////////////////////////////////
@@ -1912,6 +2170,7 @@ namespace triagens {
                               bool withDependencies,
                               bool withProperties) const override final {
           auto c = new SortNode(plan, _id, _elements, _stable);
+          c->setLimit(_limit);
 
           CloneHelper(c, plan, withDependencies, withProperties);
 
@@ -1980,6 +2239,12 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         bool _stable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of rows to produce (0 = unlimited)
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _limit;
     };
 
 
@@ -2011,6 +2276,7 @@ namespace triagens {
                        size_t id,
                        AggregationOptions const& options,
                        std::vector<std::pair<Variable const*, Variable const*>> const& aggregateVariables,
+                       std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> const& aggregateFunctions,
                        Variable const* expressionVariable,
                        Variable const* outVariable,
                        std::vector<Variable const*> const& keepVariables,
@@ -2019,6 +2285,7 @@ namespace triagens {
           : ExecutionNode(plan, id), 
             _options(options),
             _aggregateVariables(aggregateVariables), 
+            _aggregateFunctions(aggregateFunctions), 
             _expressionVariable(expressionVariable),
             _outVariable(outVariable),
             _keepVariables(keepVariables),
@@ -2038,6 +2305,7 @@ namespace triagens {
                        std::vector<Variable const*> const& keepVariables,
                        std::unordered_map<VariableId, std::string const> const& variableMap,
                        std::vector<std::pair<Variable const*, Variable const*>> const& aggregateVariables,
+                       std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> const& aggregateFunctions,
                        bool count);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2170,6 +2438,14 @@ namespace triagens {
           return _aggregateVariables;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get all aggregate functions (out, (in, function name))
+////////////////////////////////////////////////////////////////////////////////
+        
+        std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> const& aggregateFunctions () const {
+          return _aggregateFunctions;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief getVariablesUsedHere
 ////////////////////////////////////////////////////////////////////////////////
@@ -2182,10 +2458,13 @@ namespace triagens {
 
         std::vector<Variable const*> getVariablesSetHere () const override final {
           std::vector<Variable const*> v;
-          size_t const n = _aggregateVariables.size() + (_outVariable == nullptr ? 0 : 1);
+          size_t const n = _aggregateVariables.size() + _aggregateFunctions.size() + (_outVariable == nullptr ? 0 : 1);
           v.reserve(n);
 
-          for (auto p : _aggregateVariables) {
+          for (auto const& p : _aggregateVariables) {
+            v.emplace_back(p.first);
+          }
+          for (auto const& p : _aggregateFunctions) {
             v.emplace_back(p.first);
           }
           if (_outVariable != nullptr) {
@@ -2212,6 +2491,13 @@ namespace triagens {
 
         std::vector<std::pair<Variable const*, Variable const*>> _aggregateVariables;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief aggregate functions, computed per group while the input is read
+/// (out, (in, function name))
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> _aggregateFunctions;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief input expression variable (might be null)
 ////////////////////////////////////////////////////////////////////////////////
@@ -720,6 +720,7 @@ ExecutionNode* ExecutionPlan::fromNodeCollect (ExecutionNode* previous,
                                            nextId(),
                                            options, 
                                            aggregateVariables, 
+                                           std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>>(), 
                                            nullptr, 
                                            outVariable, 
                                            keepVariables, 
@@ -805,6 +806,7 @@ ExecutionNode* ExecutionPlan::fromNodeCollectExpression (ExecutionNode* previous
                                            nextId(), 
                                            options,
                                            aggregateVariables, 
+                                           std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>>(), 
                                            expressionVariable, 
                                            outVariable, 
                                            std::vector<Variable const*>(), 
@@ -875,6 +877,7 @@ ExecutionNode* ExecutionPlan::fromNodeCollectCount (ExecutionNode* previous,
                                            nextId(),
                                            options, 
                                            aggregateVariables, 
+                                           std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>>(), 
                                            nullptr, 
                                            outVariable, 
                                            std::vector<Variable const*>(), 
@@ -884,6 +887,114 @@ ExecutionNode* ExecutionPlan::fromNodeCollectCount (ExecutionNode* previous,
   return addDependency(previous, en);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an execution plan element from an AST COLLECT node,
+/// AGGREGATE
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* ExecutionPlan::fromNodeCollectAggregate (ExecutionNode* previous,
+                                                        AstNode const* node) {
+  TRI_ASSERT(node != nullptr && 
+             node->type == NODE_TYPE_COLLECT_AGGREGATE);
+  TRI_ASSERT(node->numMembers() == 4);
+
+  auto options = createAggregationOptions(node->getMember(0));
+
+  auto list = node->getMember(1);
+  size_t const numVars = list->numMembers();
+  
+  std::vector<std::pair<Variable const*, Variable const*>> aggregateVariables;
+  aggregateVariables.reserve(numVars);
+  for (size_t i = 0; i < numVars; ++i) {
+    auto assigner = list->getMember(i);
+
+    if (assigner == nullptr) {
+      continue;
+    }
+
+    TRI_ASSERT(assigner->type == NODE_TYPE_ASSIGN);
+    auto out = assigner->getMember(0);
+    TRI_ASSERT(out != nullptr);
+    auto v = static_cast<Variable*>(out->getData());
+    TRI_ASSERT(v != nullptr);
+   
+    auto expression = assigner->getMember(1);
+      
+    if (expression->type == NODE_TYPE_REFERENCE) {
+      // operand is a variable
+      auto e = static_cast<Variable*>(expression->getData());
+      aggregateVariables.emplace_back(std::make_pair(v, e));
+    }
+    else {
+      // operand is some misc expression
+      auto calc = createTemporaryCalculation(expression);
+
+      calc->addDependency(previous);
+      previous = calc;
+
+      aggregateVariables.emplace_back(std::make_pair(v, calc->outVariable()));
+    }
+  }
+
+  auto expressions = node->getMember(2);
+  auto functions = node->getMember(3);
+  size_t const numFunctions = expressions->numMembers();
+  TRI_ASSERT(numFunctions == functions->numMembers());
+
+  std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> aggregateFunctions;
+  aggregateFunctions.reserve(numFunctions);
+  for (size_t i = 0; i < numFunctions; ++i) {
+    auto assigner = expressions->getMember(i);
+    TRI_ASSERT(assigner->type == NODE_TYPE_ASSIGN);
+    auto v = static_cast<Variable*>(assigner->getMember(0)->getData());
+    TRI_ASSERT(v != nullptr);
+   
+    auto expression = assigner->getMember(1);
+
+    // the aggregate input is evaluated before the group variables are set
+    for (auto const& it : Ast::getReferencedVariables(expression)) {
+      for (auto const& group : aggregateVariables) {
+        if (it == group.first) {
+          THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_INVALID_AGGREGATE_EXPRESSION, 
+                                         std::string("cannot use COLLECT variable '") + it->name + "' in AGGREGATE expression");
+        }
+      }
+    }
+
+    Variable const* in;
+      
+    if (expression->type == NODE_TYPE_REFERENCE) {
+      // operand is a variable
+      in = static_cast<Variable*>(expression->getData());
+    }
+    else {
+      // operand is some misc expression
+      auto calc = createTemporaryCalculation(expression);
+
+      calc->addDependency(previous);
+      previous = calc;
+
+      in = calc->outVariable();
+    }
+
+    std::string const type(functions->getMember(i)->getStringValue());
+    aggregateFunctions.emplace_back(std::make_pair(v, std::make_pair(in, type)));
+  }
+
+  auto en = registerNode(new AggregateNode(this, 
+                                           nextId(),
+                                           options, 
+                                           aggregateVariables, 
+                                           aggregateFunctions, 
+                                           nullptr, 
+                                           nullptr, 
+                                           std::vector<Variable const*>(), 
+                                           _ast->variables()->variables(false), 
+                                           false));
+
+  return addDependency(previous, en);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an execution plan element from an AST LIMIT node
 ////////////////////////////////////////////////////////////////////////////////
@@ -1265,6 +1376,11 @@ ExecutionNode* ExecutionPlan::fromNode (AstNode const* node) {
         en = fromNodeCollectCount(en, member);
         break;
       }
+
+      case NODE_TYPE_COLLECT_AGGREGATE: {
+        en = fromNodeCollectAggregate(en, member);
+        break;
+      }
       
       case NODE_TYPE_LIMIT: {
         en = fromNodeLimit(en, member);
@@ -1723,6 +1839,7 @@ bool ExecutionPlan::isDeadSimple () const {
     if (nodeType == ExecutionNode::SUBQUERY ||
         nodeType == ExecutionNode::ENUMERATE_COLLECTION ||
         nodeType == ExecutionNode::ENUMERATE_LIST ||
+        nodeType == ExecutionNode::TRAVERSAL ||
         nodeType == ExecutionNode::INDEX_RANGE) {
       // these node types are not simple
       return false;
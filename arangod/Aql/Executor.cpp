@@ -102,42 +102,42 @@ std::unordered_map<std::string, Function const> const Executor::FunctionNames{
   { "IS_DOCUMENT",                 Function("IS_DOCUMENT",                 "AQL_IS_DOCUMENT", ".", true, false, true, &Functions::IsObject) }, 
   
   // type cast functions
-  { "TO_NUMBER",                   Function("TO_NUMBER",                   "AQL_TO_NUMBER", ".", true, false, true) },
-  { "TO_STRING",                   Function("TO_STRING",                   "AQL_TO_STRING", ".", true, false, true) },
-  { "TO_BOOL",                     Function("TO_BOOL",                     "AQL_TO_BOOL", ".", true, false, true) },
-  { "TO_ARRAY",                    Function("TO_ARRAY",                    "AQL_TO_ARRAY", ".", true, false, true) },
+  { "TO_NUMBER",                   Function("TO_NUMBER",                   "AQL_TO_NUMBER", ".", true, false, true, &Functions::ToNumber) },
+  { "TO_STRING",                   Function("TO_STRING",                   "AQL_TO_STRING", ".", true, false, true, &Functions::ToString) },
+  { "TO_BOOL",                     Function("TO_BOOL",                     "AQL_TO_BOOL", ".", true, false, true, &Functions::ToBool) },
+  { "TO_ARRAY",                    Function("TO_ARRAY",                    "AQL_TO_ARRAY", ".", true, false, true, &Functions::ToArray) },
   // TO_LIST is an alias for TO_ARRAY
-  { "TO_LIST",                     Function("TO_LIST",                     "AQL_TO_LIST", ".", true, false, true) },
+  { "TO_LIST",                     Function("TO_LIST",                     "AQL_TO_LIST", ".", true, false, true, &Functions::ToArray) },
   
   // string functions
   { "CONCAT",                      Function("CONCAT",                      "AQL_CONCAT", "szl|+", true, false, true, &Functions::Concat) },
-  { "CONCAT_SEPARATOR",            Function("CONCAT_SEPARATOR",            "AQL_CONCAT_SEPARATOR", "s,szl|+", true, false, true) },
-  { "CHAR_LENGTH",                 Function("CHAR_LENGTH",                 "AQL_CHAR_LENGTH", "s", true, false, true) },
-  { "LOWER",                       Function("LOWER",                       "AQL_LOWER", "s", true, false, true) },
-  { "UPPER",                       Function("UPPER",                       "AQL_UPPER", "s", true, false, true) },
-  { "SUBSTRING",                   Function("SUBSTRING",                   "AQL_SUBSTRING", "s,n|n", true, false, true) },
-  { "CONTAINS",                    Function("CONTAINS",                    "AQL_CONTAINS", "s,s|b", true, false, true) },
-  { "LIKE",                        Function("LIKE",                        "AQL_LIKE", "s,r|b", true, false, true) },
-  { "LEFT",                        Function("LEFT",                        "AQL_LEFT", "s,n", true, false, true) },
-  { "RIGHT",                       Function("RIGHT",                       "AQL_RIGHT", "s,n", true, false, true) },
-  { "TRIM",                        Function("TRIM",                        "AQL_TRIM", "s|ns", true, false, true) },
-  { "LTRIM",                       Function("LTRIM",                       "AQL_LTRIM", "s|s", true, false, true) },
-  { "RTRIM",                       Function("RTRIM",                       "AQL_RTRIM", "s|s", true, false, true) },
-  { "FIND_FIRST",                  Function("FIND_FIRST",                  "AQL_FIND_FIRST", "s,s|zn,zn", true, false, true) },
-  { "FIND_LAST",                   Function("FIND_LAST",                   "AQL_FIND_LAST", "s,s|zn,zn", true, false, true) },
-  { "SPLIT",                       Function("SPLIT",                       "AQL_SPLIT", "s|sl,n", true, false, true) },
-  { "SUBSTITUTE",                  Function("SUBSTITUTE",                  "AQL_SUBSTITUTE", "s,las|lsn,n", true, false, true) },
+  { "CONCAT_SEPARATOR",            Function("CONCAT_SEPARATOR",            "AQL_CONCAT_SEPARATOR", "s,szl|+", true, false, true, &Functions::ConcatSeparator) },
+  { "CHAR_LENGTH",                 Function("CHAR_LENGTH",                 "AQL_CHAR_LENGTH", "s", true, false, true, &Functions::CharLength) },
+  { "LOWER",                       Function("LOWER",                       "AQL_LOWER", "s", true, false, true, &Functions::Lower) },
+  { "UPPER",                       Function("UPPER",                       "AQL_UPPER", "s", true, false, true, &Functions::Upper) },
+  { "SUBSTRING",                   Function("SUBSTRING",                   "AQL_SUBSTRING", "s,n|n", true, false, true, &Functions::Substring) },
+  { "CONTAINS",                    Function("CONTAINS",                    "AQL_CONTAINS", "s,s|b", true, false, true, &Functions::Contains) },
+  { "LIKE",                        Function("LIKE",                        "AQL_LIKE", "s,r|b", true, false, true, &Functions::Like) },
+  { "LEFT",                        Function("LEFT",                        "AQL_LEFT", "s,n", true, false, true, &Functions::Left) },
+  { "RIGHT",                       Function("RIGHT",                       "AQL_RIGHT", "s,n", true, false, true, &Functions::Right) },
+  { "TRIM",                        Function("TRIM",                        "AQL_TRIM", "s|ns", true, false, true, &Functions::Trim) },
+  { "LTRIM",                       Function("LTRIM",                       "AQL_LTRIM", "s|s", true, false, true, &Functions::LTrim) },
+  { "RTRIM",                       Function("RTRIM",                       "AQL_RTRIM", "s|s", true, false, true, &Functions::RTrim) },
+  { "FIND_FIRST",                  Function("FIND_FIRST",                  "AQL_FIND_FIRST", "s,s|zn,zn", true, false, true, &Functions::FindFirst) },
+  { "FIND_LAST",                   Function("FIND_LAST",                   "AQL_FIND_LAST", "s,s|zn,zn", true, false, true, &Functions::FindLast) },
+  { "SPLIT",                       Function("SPLIT",                       "AQL_SPLIT", "s|sl,n", true, false, true, &Functions::Split) },
+  { "SUBSTITUTE",                  Function("SUBSTITUTE",                  "AQL_SUBSTITUTE", "s,las|lsn,n", true, false, true, &Functions::Substitute) },
   { "MD5",                         Function("MD5",                         "AQL_MD5", "s", true, false, true, &Functions::Md5) },
   { "SHA1",                        Function("SHA1",                        "AQL_SHA1", "s", true, false, true, &Functions::Sha1) },
   { "RANDOM_TOKEN",                Function("RANDOM_TOKEN",                "AQL_RANDOM_TOKEN", "n", false, true, true) },
 
   // numeric functions
-  { "FLOOR",                       Function("FLOOR",                       "AQL_FLOOR", "n", true, false, true) },
-  { "CEIL",                        Function("CEIL",                        "AQL_CEIL", "n", true, false, true) },
-  { "ROUND",                       Function("ROUND",                       "AQL_ROUND", "n", true, false, true) },
-  { "ABS",                         Function("ABS",                         "AQL_ABS", "n", true, false, true) },
-  { "RAND",                        Function("RAND",                        "AQL_RAND", "", false, false, true) },
-  { "SQRT",                        Function("SQRT",                        "AQL_SQRT", "n", true, false, true) },
+  { "FLOOR",                       Function("FLOOR",                       "AQL_FLOOR", "n", true, false, true, &Functions::Floor) },
+  { "CEIL",                        Function("CEIL",                        "AQL_CEIL", "n", true, false, true, &Functions::Ceil) },
+  { "ROUND",                       Function("ROUND",                       "AQL_ROUND", "n", true, false, true, &Functions::Round) },
+  { "ABS",                         Function("ABS",                         "AQL_ABS", "n", true, false, true, &Functions::Abs) },
+  { "RAND",                        Function("RAND",                        "AQL_RAND", "", false, false, true, &Functions::Rand) },
+  { "SQRT",                        Function("SQRT",                        "AQL_SQRT", "n", true, false, true, &Functions::Sqrt) },
   
   // list functions
   { "RANGE",                       Function("RANGE",                       "AQL_RANGE", "n,n|n", true, false, true) },
@@ -145,24 +145,26 @@ std::unordered_map<std::string, Function const> const Executor::FunctionNames{
   { "UNION_DISTINCT",              Function("UNION_DISTINCT",              "AQL_UNION_DISTINCT", "l,l|+", true, false, true, &Functions::UnionDistinct) },
   { "MINUS",                       Function("MINUS",                       "AQL_MINUS", "l,l|+", true, false, true) },
   { "INTERSECTION",                Function("INTERSECTION",                "AQL_INTERSECTION", "l,l|+", true, false, true, &Functions::Intersection) },
-  { "FLATTEN",                     Function("FLATTEN",                     "AQL_FLATTEN", "l|n", true, false, true) },
+  { "FLATTEN",                     Function("FLATTEN",                     "AQL_FLATTEN", "l|n", true, false, true, &Functions::Flatten) },
   { "LENGTH",                      Function("LENGTH",                      "AQL_LENGTH", "las", true, false, true, &Functions::Length) },
+  { "COUNT",                       Function("COUNT",                       "AQL_LENGTH", "las", true, false, true, &Functions::Length) },
   { "MIN",                         Function("MIN",                         "AQL_MIN", "l", true, false, true, &Functions::Min) },
   { "MAX",                         Function("MAX",                         "AQL_MAX", "l", true, false, true, &Functions::Max) },
   { "SUM",                         Function("SUM",                         "AQL_SUM", "l", true, false, true, &Functions::Sum) },
   { "MEDIAN",                      Function("MEDIAN",                      "AQL_MEDIAN", "l", true, false, true) }, 
   { "PERCENTILE",                  Function("PERCENTILE",                  "AQL_PERCENTILE", "l,n|s", true, false, true) }, 
   { "AVERAGE",                     Function("AVERAGE",                     "AQL_AVERAGE", "l", true, false, true, &Functions::Average) },
+  { "AVG",                         Function("AVG",                         "AQL_AVERAGE", "l", true, false, true, &Functions::Average) },
   { "VARIANCE_SAMPLE",             Function("VARIANCE_SAMPLE",             "AQL_VARIANCE_SAMPLE", "l", true, false, true) },
   { "VARIANCE_POPULATION",         Function("VARIANCE_POPULATION",         "AQL_VARIANCE_POPULATION", "l", true, false, true) },
   { "STDDEV_SAMPLE",               Function("STDDEV_SAMPLE",               "AQL_STDDEV_SAMPLE", "l", true, false, true) },
   { "STDDEV_POPULATION",           Function("STDDEV_POPULATION",           "AQL_STDDEV_POPULATION", "l", true, false, true) },
   { "UNIQUE",                      Function("UNIQUE",                      "AQL_UNIQUE", "l", true, false, true, &Functions::Unique) },
   { "SLICE",                       Function("SLICE",                       "AQL_SLICE", "l,n|n", true, false, true) },
-  { "REVERSE",                     Function("REVERSE",                     "AQL_REVERSE", "ls", true, false, true) },    // note: REVERSE() can be applied on strings, too
-  { "FIRST",                       Function("FIRST",                       "AQL_FIRST", "l", true, false, true) },
-  { "LAST",                        Function("LAST",                        "AQL_LAST", "l", true, false, true) },
-  { "NTH",                         Function("NTH",                         "AQL_NTH", "l,n", true, false, true) },
+  { "REVERSE",                     Function("REVERSE",                     "AQL_REVERSE", "ls", true, false, true, &Functions::Reverse) },    // note: REVERSE() can be applied on strings, too
+  { "FIRST",                       Function("FIRST",                       "AQL_FIRST", "l", true, false, true, &Functions::First) },
+  { "LAST",                        Function("LAST",                        "AQL_LAST", "l", true, false, true, &Functions::Last) },
+  { "NTH",                         Function("NTH",                         "AQL_NTH", "l,n", true, false, true, &Functions::Nth) },
   { "POSITION",                    Function("POSITION",                    "AQL_POSITION", "l,.|b", true, false, true) },
   { "CALL",                        Function("CALL",                        "AQL_CALL", "s|.+", false, true, false) },
   { "APPLY",                       Function("APPLY",                       "AQL_APPLY", "s|l", false, true, false) },
@@ -177,16 +179,16 @@ std::unordered_map<std::string, Function const> const Executor::FunctionNames{
 
   // document functions
   { "HAS",                         Function("HAS",                         "AQL_HAS", "az,s", true, false, true, &Functions::Has) },
-  { "ATTRIBUTES",                  Function("ATTRIBUTES",                  "AQL_ATTRIBUTES", "a|b,b", true, false, true) },
-  { "VALUES",                      Function("VALUES",                      "AQL_VALUES", "a|b", true, false, true) },
+  { "ATTRIBUTES",                  Function("ATTRIBUTES",                  "AQL_ATTRIBUTES", "a|b,b", true, false, true, &Functions::Attributes) },
+  { "VALUES",                      Function("VALUES",                      "AQL_VALUES", "a|b", true, false, true, &Functions::Values) },
   { "MERGE",                       Function("MERGE",                       "AQL_MERGE", "a,a|+", true, false, true, &Functions::Merge) },
   { "MERGE_RECURSIVE",             Function("MERGE_RECURSIVE",             "AQL_MERGE_RECURSIVE", "a,a|+", true, false, true) },
   { "DOCUMENT",                    Function("DOCUMENT",                    "AQL_DOCUMENT", "h.|.", false, true, false) },
-  { "MATCHES",                     Function("MATCHES",                     "AQL_MATCHES", ".,l|b", true, false, true) },
+  { "MATCHES",                     Function("MATCHES",                     "AQL_MATCHES", ".,l|b", true, false, true, &Functions::Matches) },
   { "UNSET",                       Function("UNSET",                       "AQL_UNSET", "a,sl|+", true, false, true, &Functions::Unset) },
   { "KEEP",                        Function("KEEP",                        "AQL_KEEP", "a,sl|+", true, false, true, &Functions::Keep) },
   { "TRANSLATE",                   Function("TRANSLATE",                   "AQL_TRANSLATE", ".,a|.", true, false, true) },
-  { "ZIP",                         Function("ZIP",                         "AQL_ZIP", "l,l", true, false, true) },
+  { "ZIP",                         Function("ZIP",                         "AQL_ZIP", "l,l", true, false, true, &Functions::Zip) },
 
   // geo functions
   { "NEAR",                        Function("NEAR",                        "AQL_NEAR", "h,n,n|nz,s", false, true, false) },
@@ -224,17 +226,17 @@ std::unordered_map<std::string, Function const> const Executor::FunctionNames{
   { "GRAPH_RADIUS",                Function("GRAPH_RADIUS",                "AQL_GRAPH_RADIUS", "s|a", false, true, false) },
 
   // date functions
-  { "DATE_NOW",                    Function("DATE_NOW",                    "AQL_DATE_NOW", "", false, false, true) },
-  { "DATE_TIMESTAMP",              Function("DATE_TIMESTAMP",              "AQL_DATE_TIMESTAMP", "ns|ns,ns,ns,ns,ns,ns", true, false, true) },
-  { "DATE_ISO8601",                Function("DATE_ISO8601",                "AQL_DATE_ISO8601", "ns|ns,ns,ns,ns,ns,ns", true, false, true) },
-  { "DATE_DAYOFWEEK",              Function("DATE_DAYOFWEEK",              "AQL_DATE_DAYOFWEEK", "ns", true, false, true) },
-  { "DATE_YEAR",                   Function("DATE_YEAR",                   "AQL_DATE_YEAR", "ns", true, false, true) },
-  { "DATE_MONTH",                  Function("DATE_MONTH",                  "AQL_DATE_MONTH", "ns", true, false, true) },
-  { "DATE_DAY",                    Function("DATE_DAY",                    "AQL_DATE_DAY", "ns", true, false, true) },
-  { "DATE_HOUR",                   Function("DATE_HOUR",                   "AQL_DATE_HOUR", "ns", true, false, true) },
-  { "DATE_MINUTE",                 Function("DATE_MINUTE",                 "AQL_DATE_MINUTE", "ns", true, false, true) },
-  { "DATE_SECOND",                 Function("DATE_SECOND",                 "AQL_DATE_SECOND", "ns", true, false, true) },
-  { "DATE_MILLISECOND",            Function("DATE_MILLISECOND",            "AQL_DATE_MILLISECOND", "ns", true, false, true) },
+  { "DATE_NOW",                    Function("DATE_NOW",                    "AQL_DATE_NOW", "", false, false, true, &Functions::DateNow) },
+  { "DATE_TIMESTAMP",              Function("DATE_TIMESTAMP",              "AQL_DATE_TIMESTAMP", "ns|ns,ns,ns,ns,ns,ns", true, false, true, &Functions::DateTimestamp) },
+  { "DATE_ISO8601",                Function("DATE_ISO8601",                "AQL_DATE_ISO8601", "ns|ns,ns,ns,ns,ns,ns", true, false, true, &Functions::DateIso8601) },
+  { "DATE_DAYOFWEEK",              Function("DATE_DAYOFWEEK",              "AQL_DATE_DAYOFWEEK", "ns", true, false, true, &Functions::DateDayOfWeek) },
+  { "DATE_YEAR",                   Function("DATE_YEAR",                   "AQL_DATE_YEAR", "ns", true, false, true, &Functions::DateYear) },
+  { "DATE_MONTH",                  Function("DATE_MONTH",                  "AQL_DATE_MONTH", "ns", true, false, true, &Functions::DateMonth) },
+  { "DATE_DAY",                    Function("DATE_DAY",                    "AQL_DATE_DAY", "ns", true, false, true, &Functions::DateDay) },
+  { "DATE_HOUR",                   Function("DATE_HOUR",                   "AQL_DATE_HOUR", "ns", true, false, true, &Functions::DateHour) },
+  { "DATE_MINUTE",                 Function("DATE_MINUTE",                 "AQL_DATE_MINUTE", "ns", true, false, true, &Functions::DateMinute) },
+  { "DATE_SECOND",                 Function("DATE_SECOND",                 "AQL_DATE_SECOND", "ns", true, false, true, &Functions::DateSecond) },
+  { "DATE_MILLISECOND",            Function("DATE_MILLISECOND",            "AQL_DATE_MILLISECOND", "ns", true, false, true, &Functions::DateMillisecond) },
 
   // misc functions
   { "FAIL",                        Function("FAIL",                        "AQL_FAIL", "|s", false, true, true) },
@@ -242,9 +244,9 @@ std::unordered_map<std::string, Function const> const Executor::FunctionNames{
   { "NOOPT",                       Function("NOOPT",                       "AQL_PASSTHRU", ".", false, false, true, &Functions::Passthru ) },
   { "SLEEP",                       Function("SLEEP",                       "AQL_SLEEP", "n", false, true, true) },
   { "COLLECTIONS",                 Function("COLLECTIONS",                 "AQL_COLLECTIONS", "", false, true, false) },
-  { "NOT_NULL",                    Function("NOT_NULL",                    "AQL_NOT_NULL", ".|+", true, false, true) },
-  { "FIRST_LIST",                  Function("FIRST_LIST",                  "AQL_FIRST_LIST", ".|+", true, false, true) },
-  { "FIRST_DOCUMENT",              Function("FIRST_DOCUMENT",              "AQL_FIRST_DOCUMENT", ".|+", true, false, true) },
+  { "NOT_NULL",                    Function("NOT_NULL",                    "AQL_NOT_NULL", ".|+", true, false, true, &Functions::NotNull) },
+  { "FIRST_LIST",                  Function("FIRST_LIST",                  "AQL_FIRST_LIST", ".|+", true, false, true, &Functions::FirstList) },
+  { "FIRST_DOCUMENT",              Function("FIRST_DOCUMENT",              "AQL_FIRST_DOCUMENT", ".|+", true, false, true, &Functions::FirstDocument) },
   { "PARSE_IDENTIFIER",            Function("PARSE_IDENTIFIER",            "AQL_PARSE_IDENTIFIER", ".", true, false, true) },
   { "SKIPLIST",                    Function("SKIPLIST",                    "AQL_SKIPLIST", "h,a|n,n", false, true, false) },
   { "CURRENT_USER",                Function("CURRENT_USER",                "AQL_CURRENT_USER", "", false, false, false) },
@@ -32,6 +32,7 @@
 #include "Aql/AqlValue.h"
 #include "Aql/Ast.h"
 #include "Aql/AttributeAccessor.h"
+#include "Aql/CompiledExpression.h"
 #include "Aql/Executor.h"
 #include "Aql/V8Expression.h"
 #include "Aql/Variable.h"
@@ -126,6 +127,12 @@ Expression::~Expression () {
         break;
       }
 
+      case COMPILED: {
+        TRI_ASSERT(_compiled != nullptr);
+        delete _compiled;
+        break;
+      }
+
       case V8:
         delete _func;
         break;
@@ -185,6 +192,11 @@ AqlValue Expression::execute (triagens::arango::AqlTransaction* trx,
       TRI_ASSERT(_accessor != nullptr);
       return _accessor->get(trx, argv, startPos, vars, regs);
     }
+
+    case COMPILED: {
+      TRI_ASSERT(_compiled != nullptr);
+      return _compiled->execute(trx, argv, startPos, vars, regs);
+    }
     
     case V8: {
       TRI_ASSERT(_func != nullptr);
@@ -336,6 +348,19 @@ void Expression::analyzeExpression () {
     _isDeterministic  = true;
     _data             = nullptr;
   }
+  else if (CompiledExpression::isCompilable(_node) &&
+           _node->type != NODE_TYPE_REFERENCE &&
+           (_node->type != NODE_TYPE_ATTRIBUTE_ACCESS ||
+            _node->getMember(0)->type != NODE_TYPE_REFERENCE)) {
+    // expression can be compiled into a program that does not need V8.
+    // plain references and attribute accesses are handled more efficiently
+    // by the simple expression code below
+    _type             = COMPILED;
+    _canThrow         = _node->canThrow();
+    _canRunOnDBServer = _node->canRunOnDBServer();
+    _isDeterministic  = _node->isDeterministic();
+    _compiled         = nullptr;
+  }
   else if (_node->isSimple()) {
     // expression is a simple expression
     _type             = SIMPLE;
@@ -404,6 +429,11 @@ void Expression::buildExpression () {
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid json in simple expression");
     }
   }
+  else if (_type == COMPILED) {
+    TRI_ASSERT(_compiled == nullptr);
+    // flatten the expression into a linear program
+    _compiled = new CompiledExpression(_ast->query(), _node);
+  }
   else if (_type == V8) {
     // generate a V8 expression
     _func = _executor->generateExpression(_node);
@@ -437,6 +467,21 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
     auto member = node->getMemberUnchecked(0);
     auto name = static_cast<char const*>(node->getData());
 
+    if (member->type == NODE_TYPE_REFERENCE) {
+      // read the attribute directly from the register, without copying the
+      // complete value first. this matters for documents that were reduced
+      // to objects with their used attributes by the optimizer
+      auto v = static_cast<Variable const*>(member->getData());
+
+      size_t i = 0;
+      for (auto it = vars.begin(); it != vars.end(); ++it, ++i) {
+        if ((*it)->name == v->name) {
+          auto j = argv->getValueReference(startPos, regs[i]).extractObjectMember(trx, argv->getDocumentCollection(regs[i]), name, true, _buffer);
+          return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+        }
+      }
+    }
+
     TRI_document_collection_t const* myCollection = nullptr;
     AqlValue result = executeSimpleExpression(member, &myCollection, trx, argv, startPos, vars, regs);
 
@@ -821,7 +866,8 @@ std::pair<std::string, std::string> Expression::getAttributeAccess () {
   }
 
   if (_type != SIMPLE && 
-      _type != ATTRIBUTE) {
+      _type != ATTRIBUTE &&
+      _type != COMPILED) {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
                                    "getMultipleAttributes works only on simple expressions or attribute accesses!");
   }
@@ -51,6 +51,7 @@ namespace triagens {
     struct AqlValue;
     class Ast;
     class AttributeAccessor;
+    class CompiledExpression;
     class Executor;
     struct V8Expression;
 
@@ -65,7 +66,8 @@ namespace triagens {
         JSON,
         V8,
         SIMPLE,
-        ATTRIBUTE
+        ATTRIBUTE,
+        COMPILED
       };
 
 // -----------------------------------------------------------------------------
@@ -217,6 +219,8 @@ namespace triagens {
               return "simple";
             case ATTRIBUTE:
               return "attribute";
+            case COMPILED:
+              return "compiled";
             case V8:
               return "v8";
             case UNPROCESSED: {
@@ -351,6 +355,8 @@ namespace triagens {
           struct TRI_json_t*      _data;
 
           AttributeAccessor*      _accessor;
+
+          CompiledExpression*     _compiled;
         };
 
 ////////////////////////////////////////////////////////////////////////////////
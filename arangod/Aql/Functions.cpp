@@ -34,8 +34,13 @@
 #include "Basics/JsonHelper.h"
 #include "Basics/json-utilities.h"
 #include "Basics/StringBuffer.h"
+#include "Basics/Utf8Helper.h"
+#include "Basics/random.h"
+#include "Basics/system-functions.h"
 #include "Rest/SslInterface.h"
 
+#include "unicode/uchar.h"
+
 using namespace triagens::aql;
 using Json = triagens::basics::Json;
 
@@ -170,962 +175,3738 @@ static void AppendAsString (triagens::basics::StringBuffer& buffer,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_NULL
+/// @brief whether or not a value is true, same rules as AQL's TO_BOOL()
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsNull (triagens::aql::Query*, 
-                            triagens::arango::AqlTransaction* trx,
-                            TRI_document_collection_t const* collection,
-                            AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isNull()));
-}
+static bool ValueToBoolean (TRI_json_t const* json) {
+  if (json == nullptr) {
+    return false;
+  }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_BOOL
-////////////////////////////////////////////////////////////////////////////////
+  switch (json->_type) {
+    case TRI_JSON_BOOLEAN:
+      return json->_value._boolean;
+    case TRI_JSON_NUMBER:
+      return json->_value._number != 0.0;
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE:
+      // the trailing NULL byte counts, too...
+      return json->_value._string.length != 1;
+    case TRI_JSON_ARRAY:
+    case TRI_JSON_OBJECT:
+      return true;
+    case TRI_JSON_UNUSED:
+    case TRI_JSON_NULL:
+      break;
+  }
 
-AqlValue Functions::IsBool (triagens::aql::Query*,
-                            triagens::arango::AqlTransaction* trx,
-                            TRI_document_collection_t const* collection,
-                            AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isBoolean()));
+  return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_NUMBER
+/// @brief extract a function argument as a number. values that cannot be
+/// converted are treated as 0, as in JavaScript's Math functions
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsNumber (triagens::aql::Query*,
-                              triagens::arango::AqlTransaction* trx,
-                              TRI_document_collection_t const* collection,
-                              AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isNumber()));
+static double ExtractNumber (triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const& parameters,
+                             size_t position) {
+  Json value(parameters.extractArrayMember(trx, collection, position, false));
+
+  bool failed = false;
+  double number = Functions::ValueToNumber(value.json(), failed);
+
+  if (failed || std::isnan(number) || ! std::isfinite(number)) {
+    return 0.0;
+  }
+
+  return number;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_STRING
+/// @brief create a number result, converting invalid values into null
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsString (triagens::aql::Query*,
-                              triagens::arango::AqlTransaction* trx,
-                              TRI_document_collection_t const* collection,
-                              AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isString()));
+static AqlValue NumericValue (double value) {
+  if (std::isnan(value) || ! std::isfinite(value)) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return AqlValue(new Json(value));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_ARRAY
+/// @brief create a string result from the contents of a string buffer
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsArray (triagens::aql::Query*,
-                             triagens::arango::AqlTransaction* trx,
-                             TRI_document_collection_t const* collection,
-                             AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isArray()));
+static AqlValue StringValue (triagens::basics::StringBuffer& buffer) {
+  // steal the StringBuffer's char* pointer so we can avoid copying data around
+  // multiple times
+  size_t length = buffer.length();
+  std::unique_ptr<TRI_json_t> j(TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length));
+
+  if (j == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
+  return AqlValue(jr);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_OBJECT
+/// @brief create a result from a copy of the value
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsObject (triagens::aql::Query*,
-                              triagens::arango::AqlTransaction* trx,
-                              TRI_document_collection_t const* collection,
-                              AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isObject()));
+static AqlValue CopiedValue (TRI_json_t const* json) {
+  if (json == nullptr) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  std::unique_ptr<TRI_json_t> copy(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json));
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, copy.get());
+  copy.release();
+  return AqlValue(jr);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function LENGTH
+/// @brief convert a UTF-8 string into UTF-16 code units
+/// the string functions work on UTF-16 code units, as their JavaScript
+/// counterparts do, so positions and lengths are the same in both
+/// implementations. surrogates encoded on their own are kept as they are,
+/// invalid sequences are replaced by U+FFFD
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Length (triagens::aql::Query*,
-                            triagens::arango::AqlTransaction* trx,
-                            TRI_document_collection_t const* collection,
-                            AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
+static void ToUtf16 (char const* p,
+                     size_t length,
+                     std::u16string& result) {
+  unsigned char const* s = reinterpret_cast<unsigned char const*>(p);
+  unsigned char const* end = s + length;
 
-  TRI_json_t const* json = j.json();
-  size_t length = 0;
+  result.clear();
+  result.reserve(length);
 
-  if (json != nullptr) {
-    switch (json->_type) {
-      case TRI_JSON_UNUSED:
-      case TRI_JSON_NULL: {
-        length = 0;
-        break;
-      }
+  while (s < end) {
+    uint32_t c = *s;
+    size_t n = 0;
 
-      case TRI_JSON_BOOLEAN: {
-        length = (json->_value._boolean ? 1 : 0);
-        break;
-      }
+    if (c < 0x80) {
+      result.push_back(static_cast<char16_t>(c));
+      ++s;
+      continue;
+    }
+    else if (c >= 0xc2 && c < 0xe0) {
+      c &= 0x1f;
+      n = 1;
+    }
+    else if (c >= 0xe0 && c < 0xf0) {
+      c &= 0x0f;
+      n = 2;
+    }
+    else if (c >= 0xf0 && c < 0xf5) {
+      c &= 0x07;
+      n = 3;
+    }
+    else {
+      result.push_back(0xfffd);
+      ++s;
+      continue;
+    }
 
-      case TRI_JSON_NUMBER: {
-        if (std::isnan(json->_value._number) ||
-            ! std::isfinite(json->_value._number)) {
-          // invalid value
-          length = strlen("null");
-        }
-        else {
-          // convert to a string representation of the number
-          char buffer[24];
-          length = static_cast<size_t>(fpconv_dtoa(json->_value._number, buffer));
-        }
-        break;
-      }
+    if (static_cast<size_t>(end - s) <= n) {
+      result.push_back(0xfffd);
+      ++s;
+      continue;
+    }
 
-      case TRI_JSON_STRING:
-      case TRI_JSON_STRING_REFERENCE: {
-        // return number of characters (not bytes) in string
-        length = TRI_CharLengthUtf8String(json->_value._string.data);
+    size_t i;
+    for (i = 1; i <= n; ++i) {
+      if ((s[i] & 0xc0) != 0x80) {
         break;
       }
+      c = (c << 6) | (s[i] & 0x3f);
+    }
 
-      case TRI_JSON_OBJECT: {
-        // return number of attributes
-        length = TRI_LengthVector(&json->_value._objects) / 2;
-        break;
-      }
+    if (i <= n ||
+        (n == 2 && c < 0x800) ||
+        (n == 3 && (c < 0x10000 || c > 0x10ffff))) {
+      result.push_back(0xfffd);
+      ++s;
+      continue;
+    }
 
-      case TRI_JSON_ARRAY: {
-        // return list length
-        length = TRI_LengthArrayJson(json);
-        break;
-      }
+    if (c >= 0x10000) {
+      c -= 0x10000;
+      result.push_back(static_cast<char16_t>(0xd800 + (c >> 10)));
+      result.push_back(static_cast<char16_t>(0xdc00 + (c & 0x3ff)));
+    }
+    else {
+      result.push_back(static_cast<char16_t>(c));
     }
-  }
 
-  return AqlValue(new Json(static_cast<double>(length)));
+    s += n + 1;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function CONCAT
+/// @brief append UTF-16 code units to a string buffer as UTF-8
+/// unpaired surrogates are encoded on their own, as V8 does when it converts
+/// such a string into UTF-8
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Concat (triagens::aql::Query*,
-                            triagens::arango::AqlTransaction* trx,
-                            TRI_document_collection_t const* collection,
-                            AqlValue const parameters) {
-  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
-
-  size_t const n = parameters.arraySize();
+static void AppendUtf16 (triagens::basics::StringBuffer& buffer,
+                         char16_t const* p,
+                         size_t length) {
+  char16_t const* end = p + length;
 
-  for (size_t i = 0; i < n; ++i) {
-    Json member = parameters.at(trx, i);
+  while (p < end) {
+    uint32_t c = *p++;
 
-    if (member.isEmpty() || member.isNull()) {
-      continue;
+    if (c >= 0xd800 && c < 0xdc00 && p < end && *p >= 0xdc00 && *p < 0xe000) {
+      c = 0x10000 + ((c - 0xd800) << 10) + (*p++ - 0xdc00);
     }
-      
-    TRI_json_t const* json = member.json();
-    
-    if (member.isArray()) {
-      // append each member individually
-      size_t const subLength = TRI_LengthArrayJson(json);
 
-      for (size_t j = 0; j < subLength; ++j) {
-        auto sub = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, j));
-
-        if (sub == nullptr || sub->_type == TRI_JSON_NULL) {
-          continue;
-        }
-
-        AppendAsString(buffer, sub);
-      }
+    if (c < 0x80) {
+      buffer.appendChar(static_cast<char>(c));
+    }
+    else if (c < 0x800) {
+      buffer.appendChar(static_cast<char>(0xc0 | (c >> 6)));
+      buffer.appendChar(static_cast<char>(0x80 | (c & 0x3f)));
+    }
+    else if (c < 0x10000) {
+      buffer.appendChar(static_cast<char>(0xe0 | (c >> 12)));
+      buffer.appendChar(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+      buffer.appendChar(static_cast<char>(0x80 | (c & 0x3f)));
     }
     else {
-      // convert member to a string and append
-      AppendAsString(buffer, json);
+      buffer.appendChar(static_cast<char>(0xf0 | (c >> 18)));
+      buffer.appendChar(static_cast<char>(0x80 | ((c >> 12) & 0x3f)));
+      buffer.appendChar(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+      buffer.appendChar(static_cast<char>(0x80 | (c & 0x3f)));
     }
   }
-  
-  // steal the StringBuffer's char* pointer so we can avoid copying data around
-  // multiple times
-  size_t length = buffer.length();
-  std::unique_ptr<TRI_json_t> j(TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length));
-
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
-  j.release();
-  return AqlValue(jr);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function PASSTHRU
+/// @brief convert a value into a string of UTF-16 code units, using the
+/// rules of TO_STRING()
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Passthru (triagens::aql::Query*,
-                              triagens::arango::AqlTransaction* trx,
-                              TRI_document_collection_t const* collection,
-                              AqlValue const parameters) {
+static void ValueToUtf16 (TRI_json_t const* json,
+                          std::u16string& result) {
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  AppendAsString(buffer, json);
 
-  Json j(parameters.extractArrayMember(trx, collection, 0, true));
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.json());
-  j.steal();
-  return AqlValue(jr);
+  ToUtf16(buffer.c_str(), buffer.length(), result);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function UNSET
+/// @brief create a string result from UTF-16 code units
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Unset (triagens::aql::Query* query,
-                           triagens::arango::AqlTransaction* trx,
-                           TRI_document_collection_t const* collection,
-                           AqlValue const parameters) {
-  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+static AqlValue Utf16Value (char16_t const* p,
+                            size_t length) {
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, length + 1);
+  AppendUtf16(buffer, p, length);
 
-  if (! value.isObject()) {
-    RegisterInvalidArgumentWarning(query, "UNSET");
-    return AqlValue(new Json(Json::Null));
-  }
- 
-  std::unordered_set<std::string> names;
-  ExtractKeys(names, query, trx, collection, parameters, 1, "UNSET");
+  return StringValue(buffer);
+}
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compute the range of String.prototype.substr(offset, count) in a
+/// string with the specified number of code units
+////////////////////////////////////////////////////////////////////////////////
 
-  // create result object
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthVector(&valueJson->_value._objects);
+static void SubstrRange (size_t length,
+                         double offset,
+                         double count,
+                         size_t& from,
+                         size_t& to) {
+  double const units = static_cast<double>(length);
 
-  size_t size;
-  if (names.size() >= n / 2) {
-    size = 4; 
-  }
-  else {
-    size = (n / 2) - names.size(); 
+  offset = std::trunc(offset);
+  if (offset < 0.0) {
+    offset = (std::max)(units + offset, 0.0);
   }
+  offset = (std::min)(offset, units);
 
-  std::unique_ptr<TRI_json_t> j(TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, size));
-
-  if (j == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+  count = (std::min)((std::max)(std::trunc(count), 0.0), units - offset);
 
-  for (size_t i = 0; i < n; i += 2) {
-    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
-    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i + 1));
+  from = static_cast<size_t>(offset);
+  to = from + static_cast<size_t>(count);
+}
 
-    if (TRI_IsStringJson(key) && 
-        names.find(key->_value._string.data) == names.end()) {
-      auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return a part of a UTF-8 string, using the semantics of
+/// String.prototype.substr()
+////////////////////////////////////////////////////////////////////////////////
 
-      if (copy == nullptr) {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-      } 
+static AqlValue SubstringValue (char const* data,
+                                size_t length,
+                                double offset,
+                                double count) {
+  std::u16string value;
+  ToUtf16(data, length, value);
 
-      TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, j.get(), key->_value._string.data, copy);
-    }
-  } 
+  size_t from, to;
+  SubstrRange(value.size(), offset, count, from, to);
 
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
-  j.release();
-  return AqlValue(jr);
+  return Utf16Value(value.data() + from, to - from);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function KEEP
+/// @brief String.prototype.indexOf(). returns -1 if search is not found
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Keep (triagens::aql::Query* query,
-                          triagens::arango::AqlTransaction* trx,
-                          TRI_document_collection_t const* collection,
-                          AqlValue const parameters) {
-  Json value(parameters.extractArrayMember(trx, collection, 0, false));
-
-  if (! value.isObject()) {
-    RegisterInvalidArgumentWarning(query, "KEEP");
-    return AqlValue(new Json(Json::Null));
+static double IndexOf (std::u16string const& value,
+                       std::u16string const& search,
+                       size_t from) {
+  if (from > value.size()) {
+    from = value.size();
   }
- 
-  std::unordered_set<std::string> names;
-  ExtractKeys(names, query, trx, collection, parameters, 1, "KEEP");
 
+  size_t const position = value.find(search, from);
 
-  // create result object
-  std::unique_ptr<TRI_json_t> j(TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, names.size()));
+  if (position == std::u16string::npos) {
+    return -1.0;
+  }
 
-  if (j == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+  return static_cast<double>(position);
+}
 
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthVector(&valueJson->_value._objects);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief String.prototype.lastIndexOf(). returns -1 if search is not found
+////////////////////////////////////////////////////////////////////////////////
 
-  for (size_t i = 0; i < n; i += 2) {
-    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
-    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i + 1));
+static double LastIndexOf (std::u16string const& value,
+                           std::u16string const& search) {
+  size_t const position = value.rfind(search);
 
-    if (TRI_IsStringJson(key) && 
-        names.find(key->_value._string.data) != names.end()) {
-      auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
+  if (position == std::u16string::npos) {
+    return -1.0;
+  }
 
-      if (copy == nullptr) {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-      } 
+  return static_cast<double>(position);
+}
 
-      TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, j.get(), key->_value._string.data, copy);
-    }
-  } 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a code unit is white space, as matched by \s in a
+/// JavaScript regex
+////////////////////////////////////////////////////////////////////////////////
 
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
-  j.release();
-  return AqlValue(jr);
+static bool IsWhitespace (char16_t c) {
+  return (c == 0x09 || c == 0x0a || c == 0x0b || c == 0x0c || c == 0x0d || c == 0x20 ||
+          c == 0xa0 || c == 0x1680 || c == 0x180e || (c >= 0x2000 && c <= 0x200a) ||
+          c == 0x2028 || c == 0x2029 || c == 0x202f || c == 0x205f || c == 0x3000 ||
+          c == 0xfeff);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function MERGE
+/// @brief whether or not a code unit is a line terminator, which is not
+/// matched by . in a JavaScript regex
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Merge (triagens::aql::Query* query,
-                           triagens::arango::AqlTransaction* trx,
-                           TRI_document_collection_t const* collection,
-                           AqlValue const parameters) {
-  size_t const n = parameters.arraySize();
+static bool IsLineTerminator (char16_t c) {
+  return (c == 0x0a || c == 0x0d || c == 0x2028 || c == 0x2029);
+}
 
-  if (n == 0) {
-    // no parameters
-    return AqlValue(new Json(Json::Object));
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a set of code units to trim, built from the characters passed to
+/// TRIM(), LTRIM() and RTRIM()
+/// the JavaScript implementation puts the characters into a regex character
+/// class, in which a - between two characters denotes a range. an empty
+/// set of ranges means white space
+////////////////////////////////////////////////////////////////////////////////
 
-  // use the first argument as the preliminary result
-  Json initial(parameters.extractArrayMember(trx, collection, 0, true));
+struct TrimCharacters {
+  std::vector<std::pair<char16_t, char16_t>> ranges;
+  bool whitespace = true;
 
-  if (! initial.isObject()) {
-    RegisterInvalidArgumentWarning(query, "MERGE");
-    return AqlValue(new Json(Json::Null));
+  bool contains (char16_t c) const {
+    if (whitespace) {
+      return IsWhitespace(c);
+    }
+
+    for (auto const& range : ranges) {
+      if (c >= range.first && c <= range.second) {
+        return true;
+      }
+    }
+
+    return false;
   }
+};
 
-  std::unique_ptr<TRI_json_t> result(initial.steal());
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the set of code units to trim. returns false if the
+/// characters contain a range in the wrong order
+////////////////////////////////////////////////////////////////////////////////
 
-  // now merge in all other arguments
-  for (size_t i = 1; i < n; ++i) {
-    Json param(parameters.extractArrayMember(trx, collection, i, false));
+static bool MakeTrimCharacters (std::u16string const& chars,
+                                TrimCharacters& result) {
+  size_t const n = chars.size();
 
-    if (! param.isObject()) {
-      RegisterInvalidArgumentWarning(query, "MERGE");
-      return AqlValue(new Json(Json::Null));
-    }
- 
-    auto merged = TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(), param.json(), false, true);
+  result.whitespace = false;
+  result.ranges.clear();
 
-    if (merged == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  for (size_t i = 0; i < n; ++i) {
+    if (i + 2 < n && chars[i + 1] == u'-') {
+      if (chars[i] > chars[i + 2]) {
+        return false;
+      }
+      result.ranges.emplace_back(chars[i], chars[i + 2]);
+      i += 2;
     }
+    else {
+      result.ranges.emplace_back(chars[i], chars[i]);
+    }
+  }
 
-    result.reset(merged);
-  } 
-
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-  result.release();
-  return AqlValue(jr);
+  return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function HAS
+/// @brief trim a string of UTF-16 code units
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Has (triagens::aql::Query* query,
-                         triagens::arango::AqlTransaction* trx,
-                         TRI_document_collection_t const* collection,
-                         AqlValue const parameters) {
-  size_t const n = parameters.arraySize();
+static AqlValue TrimValue (std::u16string const& value,
+                           TrimCharacters const& chars,
+                           bool left,
+                           bool right) {
+  size_t from = 0;
+  size_t to = value.size();
 
-  if (n < 2) {
-    // no parameters
-    return AqlValue(new Json(false));
+  if (left) {
+    while (from < to && chars.contains(value[from])) {
+      ++from;
+    }
   }
-    
-  Json value(parameters.extractArrayMember(trx, collection, 0, false));
 
-  if (! value.isObject()) {
-    // not an object
-    return AqlValue(new Json(false));
+  if (right) {
+    while (to > from && chars.contains(value[to - 1])) {
+      --to;
+    }
   }
- 
-  // process name parameter 
-  Json name(parameters.extractArrayMember(trx, collection, 1, false));
 
-  char const* p;
+  return Utf16Value(value.data() + from, to - from);
+}
 
-  if (! name.isString()) {
-    triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
-    AppendAsString(buffer, name.json());
-    p = buffer.c_str();
-  }
-  else {
-    p = name.json()->_value._string.data;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the first of the alternatives that matches at a position.
+/// this is how a JavaScript regex built from alternatives of literal strings
+/// matches. returns the length of the match or std::u16string::npos
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t MatchAlternatives (std::u16string const& value,
+                                 size_t position,
+                                 std::vector<std::u16string> const& alternatives) {
+  for (auto const& alternative : alternatives) {
+    if (position + alternative.size() <= value.size() &&
+        value.compare(position, alternative.size(), alternative) == 0) {
+      return alternative.size();
+    }
   }
- 
-  bool const hasAttribute = (TRI_LookupObjectJson(value.json(), p) != nullptr);
-  return AqlValue(new Json(hasAttribute));
+
+  return std::u16string::npos;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function MIN
+/// @brief canonicalize a code unit for a case-insensitive comparison, in
+/// the way a JavaScript regex with the i flag does
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Min (triagens::aql::Query* query,
-                         triagens::arango::AqlTransaction* trx,
-                         TRI_document_collection_t const* collection,
-                         AqlValue const parameters) {
-  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+static char16_t CanonicalizeCase (char16_t c) {
+  UChar32 upper = u_toupper(static_cast<UChar32>(c));
 
-  if (! value.isArray()) {
-    // not an array
-    RegisterWarning(query, "MIN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+  if (upper > 0xffff || (c >= 128 && upper < 128)) {
+    return c;
   }
 
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
-  TRI_json_t const* minValue = nullptr;;
+  return static_cast<char16_t>(upper);
+}
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
+////////////////////////////////////////////////////////////////////////////////
+/// @brief match a string against a LIKE pattern
+/// % matches any sequence and _ matches any single code unit, except line
+/// terminators. a backslash escapes % and _ and itself
+////////////////////////////////////////////////////////////////////////////////
 
-    if (TRI_IsNullJson(value)) {
+static bool MatchLikePattern (std::u16string const& value,
+                              std::u16string const& pattern,
+                              bool caseInsensitive) {
+  enum TokenType {
+    TOKEN_LITERAL,
+    TOKEN_ANY,
+    TOKEN_ANY_SEQUENCE
+  };
+
+  std::vector<std::pair<TokenType, char16_t>> tokens;
+  bool escaped = false;
+
+  for (auto c : pattern) {
+    if (c == u'\\') {
+      if (escaped) {
+        tokens.emplace_back(TOKEN_LITERAL, c);
+      }
+      escaped = ! escaped;
       continue;
     }
 
-    if (minValue == nullptr ||
-        TRI_CompareValuesJson(value, minValue) < 0) {
-      minValue = value;
+    if (c == u'%' && ! escaped) {
+      tokens.emplace_back(TOKEN_ANY_SEQUENCE, c);
     }
-  } 
+    else if (c == u'_' && ! escaped) {
+      tokens.emplace_back(TOKEN_ANY, c);
+    }
+    else {
+      if (escaped && c != u'%' && c != u'_' &&
+          std::u16string(u".*+?^=!:${}()|[]/").find(c) == std::u16string::npos) {
+        // a backslash followed by no special character is a literal backslash
+        tokens.emplace_back(TOKEN_LITERAL, u'\\');
+      }
+      tokens.emplace_back(TOKEN_LITERAL, c);
+    }
+    escaped = false;
+  }
 
-  if (minValue != nullptr) {
-    std::unique_ptr<TRI_json_t> result(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, minValue));
-    
-    if (result != nullptr) {
-      auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-      result.release();
-      return AqlValue(jr);
+  // positions in value that the tokens processed so far can end at
+  size_t const n = value.size();
+  std::vector<bool> current(n + 1, false);
+  std::vector<bool> next(n + 1, false);
+  current[0] = true;
+
+  for (auto const& token : tokens) {
+    std::fill(next.begin(), next.end(), false);
+    bool any = false;
+
+    for (size_t i = 0; i <= n; ++i) {
+      if (token.first == TOKEN_ANY_SEQUENCE) {
+        if (current[i] || (i > 0 && next[i - 1] && ! IsLineTerminator(value[i - 1]))) {
+          next[i] = true;
+        }
+      }
+      else if (current[i] && i < n) {
+        if (token.first == TOKEN_ANY) {
+          next[i + 1] = ! IsLineTerminator(value[i]);
+        }
+        else if (caseInsensitive) {
+          next[i + 1] = (CanonicalizeCase(value[i]) == CanonicalizeCase(token.second));
+        }
+        else {
+          next[i + 1] = (value[i] == token.second);
+        }
+      }
+    }
+
+    current.swap(next);
+
+    for (size_t i = 0; i <= n; ++i) {
+      any = any || current[i];
+    }
+    if (! any) {
+      return false;
     }
   }
 
-  return AqlValue(new Json(Json::Null));
+  return current[n];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function MAX
+/// @brief split a string at the separators, using the semantics of
+/// String.prototype.split() with a regex of alternative literal strings
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Max (triagens::aql::Query* query,
-                         triagens::arango::AqlTransaction* trx,
-                         TRI_document_collection_t const* collection,
-                         AqlValue const parameters) {
-  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+static void SplitValue (std::u16string const& value,
+                        std::vector<std::u16string> const& separators,
+                        double limit,
+                        std::vector<std::u16string>& result) {
+  size_t const n = value.size();
 
-  if (! value.isArray()) {
-    // not an array
-    RegisterWarning(query, "MAX", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+  result.clear();
+
+  if (limit <= 0.0) {
+    return;
   }
 
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
-  TRI_json_t const* maxValue = nullptr;;
+  if (n == 0) {
+    if (MatchAlternatives(value, 0, separators) == std::u16string::npos) {
+      result.emplace_back(value);
+    }
+    return;
+  }
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
+  size_t p = 0;
+  size_t q = 0;
 
-    if (TRI_IsNullJson(value)) {
+  while (q < n) {
+    size_t const length = MatchAlternatives(value, q, separators);
+
+    if (length == std::u16string::npos || (length == 0 && q == p)) {
+      ++q;
       continue;
     }
 
-    if (maxValue == nullptr ||
-        TRI_CompareValuesJson(value, maxValue) > 0) {
-      maxValue = value;
-    }
-  } 
+    result.emplace_back(value.substr(p, q - p));
 
-  if (maxValue != nullptr) {
-    std::unique_ptr<TRI_json_t> result(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, maxValue));
-    
-    if (result != nullptr) {
-      auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-      result.release();
-      return AqlValue(jr);
+    if (static_cast<double>(result.size()) >= limit) {
+      return;
     }
+
+    p = q + length;
+    q = p;
   }
 
-  return AqlValue(new Json(Json::Null));
+  result.emplace_back(value.substr(p));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function SUM
+/// @brief replace the search strings in a string, using the semantics of
+/// String.prototype.replace() with a global regex of alternative literal
+/// strings. only the first limit matches are replaced
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Sum (triagens::aql::Query* query,
-                         triagens::arango::AqlTransaction* trx,
-                         TRI_document_collection_t const* collection,
-                         AqlValue const parameters) {
-  Json value(parameters.extractArrayMember(trx, collection, 0, false));
-
-  if (! value.isArray()) {
-    // not an array
-    RegisterWarning(query, "SUM", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
-  }
+static void SubstituteValue (std::u16string const& value,
+                             std::vector<std::u16string> const& search,
+                             std::unordered_map<std::u16string, std::u16string> const& replacements,
+                             double limit,
+                             std::u16string& result) {
+  size_t const n = value.size();
+  size_t position = 0;
 
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
-  double sum = 0.0;
+  result.clear();
+  result.reserve(n);
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
+  while (position <= n) {
+    size_t const length = MatchAlternatives(value, position, search);
 
-    if (TRI_IsNullJson(value)) {
+    if (length == std::u16string::npos) {
+      if (position < n) {
+        result.push_back(value[position]);
+      }
+      ++position;
       continue;
     }
 
-    if (! TRI_IsNumberJson(value)) {
-      RegisterInvalidArgumentWarning(query, "SUM");
-      return AqlValue(new Json(Json::Null));
+    if (limit > 0.0) {
+      limit -= 1.0;
+      result.append(replacements.find(value.substr(position, length))->second);
+    }
+    else {
+      result.append(value, position, length);
     }
 
-    // got a numeric value
-    double const number = value->_value._number;
+    if (length == 0) {
+      // an empty match does not consume the following code unit
+      if (position < n) {
+        result.push_back(value[position]);
+      }
+      ++position;
+    }
+    else {
+      position += length;
+    }
+  }
+}
 
-    if (! std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
-      sum += number;
-    } 
-  } 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append the members of an array to another array, flattening
+/// sub-arrays up to the specified depth
+////////////////////////////////////////////////////////////////////////////////
 
-  if (! std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
-    return AqlValue(new Json(sum));
-  } 
+static void FlattenArray (TRI_json_t* result,
+                          TRI_json_t const* array,
+                          double maxDepth,
+                          double depth) {
+  size_t const n = TRI_LengthArrayJson(array);
 
-  return AqlValue(new Json(Json::Null));
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&array->_value._objects, i));
+
+    if (depth < maxDepth && TRI_IsArrayJson(value)) {
+      FlattenArray(result, value, maxDepth, depth + 1.0);
+      continue;
+    }
+
+    auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result, copy);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function AVERAGE
+/// @brief return the first argument with the requested type
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Average (triagens::aql::Query* query,
-                             triagens::arango::AqlTransaction* trx,
+static AqlValue FirstOfType (triagens::arango::AqlTransaction* trx,
                              TRI_document_collection_t const* collection,
-                             AqlValue const parameters) {
-  Json value(parameters.extractArrayMember(trx, collection, 0, false));
-
-  if (! value.isArray()) {
-    // not an array
-    RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
-  }
-
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
-  double sum = 0.0;
-  size_t count = 0;
+                             AqlValue const& parameters,
+                             std::function<bool(Json const&)> const& predicate) {
+  size_t const n = parameters.arraySize();
 
   for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
-
-    if (TRI_IsNullJson(value)) {
-      continue;
-    }
+    Json value(parameters.extractArrayMember(trx, collection, i, false));
 
-    if (! TRI_IsNumberJson(value)) {
-      RegisterInvalidArgumentWarning(query, "AVERAGE");
-      return AqlValue(new Json(Json::Null));
+    if (predicate(value)) {
+      return CopiedValue(value.json());
     }
-
-    // got a numeric value
-    double const number = value->_value._number;
-
-    if (! std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
-      sum += number;
-      ++count;
-    } 
-  } 
-
-  if (count > 0 && 
-      ! std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
-    return AqlValue(new Json(sum / static_cast<size_t>(count)));
-  } 
+  }
 
   return AqlValue(new Json(Json::Null));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function MD5
+/// @brief number of milliseconds per day
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Md5 (triagens::aql::Query* query,
-                         triagens::arango::AqlTransaction* trx,
-                         TRI_document_collection_t const* collection,
-                         AqlValue const parameters) {
-  Json value(parameters.extractArrayMember(trx, collection, 0, false));
-    
-  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
-  AppendAsString(buffer, value.json());
-  
-  // create md5
-  char hash[17]; 
-  char* p = &hash[0];
-  size_t length;
-
-  triagens::rest::SslInterface::sslMD5(buffer.c_str(), buffer.length(), p, length);
-
-  // as hex
-  char hex[33];
-  p = &hex[0];
+static double const MillisecondsPerDay = 86400000.0;
 
-  triagens::rest::SslInterface::sslHEX(hash, 16, p, length);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief largest absolute timestamp value that JavaScript dates can hold
+////////////////////////////////////////////////////////////////////////////////
 
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, hex, 32));
-}
+static double const MaxTimestamp = 8.64e15;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function SHA1
+/// @brief number of days since the Unix epoch for a date in the proleptic
+/// Gregorian calendar. month is 1-based
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Sha1 (triagens::aql::Query* query,
-                          triagens::arango::AqlTransaction* trx,
-                          TRI_document_collection_t const* collection,
-                          AqlValue const parameters) {
-  Json value(parameters.extractArrayMember(trx, collection, 0, false));
-    
-  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
-  AppendAsString(buffer, value.json());
-  
-  // create sha1
-  char hash[21];
-  char* p = &hash[0];
-  size_t length;
-
-  triagens::rest::SslInterface::sslSHA1(buffer.c_str(), buffer.length(), p, length);
+static int64_t DaysFromCivil (int64_t year,
+                              int64_t month,
+                              int64_t day) {
+  year -= (month <= 2 ? 1 : 0);
+  int64_t const era = (year >= 0 ? year : year - 399) / 400;
+  int64_t const yoe = year - era * 400;
+  int64_t const doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  int64_t const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
 
-  // as hex
-  char hex[41];
-  p = &hex[0];
+  return era * 146097 + doe - 719468;
+}
 
-  triagens::rest::SslInterface::sslHEX(hash, 20, p, length);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the calendar date for a number of days since the Unix epoch. month
+/// is 1-based
+////////////////////////////////////////////////////////////////////////////////
 
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, hex, 40));
+static void CivilFromDays (int64_t days,
+                           int64_t& year,
+                           int64_t& month,
+                           int64_t& day) {
+  days += 719468;
+  int64_t const era = (days >= 0 ? days : days - 146096) / 146097;
+  int64_t const doe = days - era * 146097;
+  int64_t const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  int64_t const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  int64_t const mp = (5 * doy + 2) / 153;
+
+  day = doy - (153 * mp + 2) / 5 + 1;
+  month = (mp < 10 ? mp + 3 : mp - 9);
+  year = yoe + era * 400 + (month <= 2 ? 1 : 0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function UNIQUE
+/// @brief build a timestamp from date components, like JavaScript's
+/// Date.UTC() does. month is 0-based and may overflow into the year. returns
+/// NaN if the date is out of range
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Unique (triagens::aql::Query* query,
-                            triagens::arango::AqlTransaction* trx,
-                            TRI_document_collection_t const* collection,
-                            AqlValue const parameters) {
-  Json value(parameters.extractArrayMember(trx, collection, 0, false));
-
-  if (! value.isArray()) {
-    // not an array
-    RegisterWarning(query, "UNIQUE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+static double MakeTimestamp (double year,
+                             double month,
+                             double day,
+                             double hour,
+                             double minute,
+                             double second,
+                             double millisecond) {
+  double components[] = { year, month, day, hour, minute, second, millisecond };
+
+  for (auto& it : components) {
+    if (std::isnan(it) || ! std::isfinite(it)) {
+      return NAN;
+    }
+    it = std::trunc(it);
   }
 
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
+  if (std::abs(components[0]) > 400000.0 || std::abs(components[1]) > 4800000.0) {
+    return NAN;
+  }
 
-  std::unordered_set<TRI_json_t const*, triagens::basics::JsonHash, triagens::basics::JsonEqual> values(
-    512, 
-    triagens::basics::JsonHash(), 
-    triagens::basics::JsonEqual()
-  );
+  int64_t y = static_cast<int64_t>(components[0]) + static_cast<int64_t>(std::floor(components[1] / 12.0));
+  int64_t m = static_cast<int64_t>(components[1]) % 12;
+  if (m < 0) {
+    m += 12;
+  }
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(TRI_AddressVector(&valueJson->_value._objects, i));
+  double const days = static_cast<double>(DaysFromCivil(y, m + 1, 1)) + components[2] - 1.0;
+  double const timestamp = days * MillisecondsPerDay +
+                           components[3] * 3600000.0 +
+                           components[4] * 60000.0 +
+                           components[5] * 1000.0 +
+                           components[6];
 
-    if (value == nullptr) {
-      continue;
-    }
+  if (std::isnan(timestamp) || ! std::isfinite(timestamp) || std::abs(timestamp) > MaxTimestamp) {
+    return NAN;
+  }
 
-    values.emplace(value); 
-  } 
+  return timestamp;
+}
 
-  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, values.size()));
- 
-  for (auto const& it : values) {
-    auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, it);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse an unsigned number with a limited number of digits
+////////////////////////////////////////////////////////////////////////////////
 
-    if (copy == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
- 
-    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy); 
+static bool ParseDigits (char const*& p,
+                         char const* end,
+                         int minDigits,
+                         int maxDigits,
+                         int64_t& result) {
+  int digits = 0;
+  result = 0;
+
+  while (p < end && digits < maxDigits && *p >= '0' && *p <= '9') {
+    result = result * 10 + (*p - '0');
+    ++p;
+    ++digits;
   }
-      
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-  result.release();
-  return AqlValue(jr);
+
+  return (digits >= minDigits);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function UNION
+/// @brief parse a date string into a timestamp. the accepted formats are the
+/// ones documented for the AQL date functions:
+/// YYYY[-MM[-DD]][(T| )HH:MM[:SS[.MMM]]][Z|(+|-)HH[:MM]]
+/// dates without a timezone are treated as UTC. returns NaN for invalid dates
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Union (triagens::aql::Query* query,
-                           triagens::arango::AqlTransaction* trx,
-                           TRI_document_collection_t const* collection,
-                           AqlValue const parameters) {
-  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, 16));
+static double ParseDate (char const* p,
+                         size_t length) {
+  char const* end = p + length;
 
-  size_t const n = parameters.arraySize();
+  while (p < end && isspace(*p)) {
+    ++p;
+  }
+  while (end > p && isspace(*(end - 1))) {
+    --end;
+  }
 
-  for (size_t i = 0; i < n; ++i) {
-    Json value(parameters.extractArrayMember(trx, collection, i, false));
+  int64_t year, month = 1, day = 1, hour = 0, minute = 0, second = 0, millisecond = 0;
+  int64_t offset = 0;
 
-    if (! value.isArray()) {
-      // not an array
-      RegisterWarning(query, "UNION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-      return AqlValue(new Json(Json::Null));
+  // extended years have a sign and six digits
+  if (p < end && (*p == '+' || *p == '-')) {
+    bool const negative = (*p == '-');
+    ++p;
+    if (! ParseDigits(p, end, 6, 6, year)) {
+      return NAN;
+    }
+    if (negative) {
+      year = -year;
     }
+  }
+  else if (! ParseDigits(p, end, 4, 4, year)) {
+    return NAN;
+  }
 
-    TRI_json_t const* valueJson = value.json();
-    size_t const nrValues = TRI_LengthArrayJson(valueJson);
+  if (p < end && *p == '-') {
+    ++p;
+    if (! ParseDigits(p, end, 1, 2, month)) {
+      return NAN;
+    }
 
-    if (TRI_ReserveVector(&(result.get()->_value._objects), nrValues) != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    if (p < end && *p == '-') {
+      ++p;
+      if (! ParseDigits(p, end, 1, 2, day)) {
+        return NAN;
+      }
     }
+  }
 
-    TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  if (p < end && (*p == 'T' || *p == 't' || *p == ' ')) {
+    ++p;
+    if (! ParseDigits(p, end, 1, 2, hour) ||
+        p >= end || *p != ':') {
+      return NAN;
+    }
+    ++p;
+    if (! ParseDigits(p, end, 1, 2, minute)) {
+      return NAN;
     }
-    
-    // this passes ownership for the JSON contens into result
-    for (size_t j = 0; j < nrValues; ++j) {
-      TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, TRI_LookupArrayJson(valueJson, j));
 
-      if (copy == nullptr) {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    if (p < end && *p == ':') {
+      ++p;
+      if (! ParseDigits(p, end, 1, 2, second)) {
+        return NAN;
       }
-    
-      TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
 
-      TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      if (p < end && *p == '.') {
+        ++p;
+        // only the first three digits of the fraction are significant
+        int64_t scale = 100;
+        if (p >= end || *p < '0' || *p > '9') {
+          return NAN;
+        }
+        while (p < end && *p >= '0' && *p <= '9') {
+          millisecond += (*p - '0') * scale;
+          scale /= 10;
+          ++p;
+        }
       }
-    } 
-  } 
-      
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
   }
 
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-  result.release();
-  return AqlValue(jr);
+  if (p < end) {
+    if (*p == 'Z' || *p == 'z') {
+      ++p;
+    }
+    else if (*p == '+' || *p == '-') {
+      int64_t const sign = (*p == '-' ? -1 : 1);
+      int64_t offsetHours, offsetMinutes = 0;
+
+      ++p;
+      if (! ParseDigits(p, end, 1, 2, offsetHours)) {
+        return NAN;
+      }
+      if (p < end && *p == ':') {
+        ++p;
+        if (! ParseDigits(p, end, 2, 2, offsetMinutes)) {
+          return NAN;
+        }
+      }
+      else if (p < end && ! ParseDigits(p, end, 2, 2, offsetMinutes)) {
+        return NAN;
+      }
+
+      offset = sign * (offsetHours * 60 + offsetMinutes);
+    }
+  }
+
+  if (p != end) {
+    // trailing garbage
+    return NAN;
+  }
+
+  if (month < 1 || month > 12 ||
+      day < 1 || day > 31 ||
+      hour > 23 || minute > 59 || second > 59) {
+    return NAN;
+  }
+
+  return MakeTimestamp(static_cast<double>(year),
+                       static_cast<double>(month - 1),
+                       static_cast<double>(day),
+                       static_cast<double>(hour),
+                       static_cast<double>(minute - offset),
+                       static_cast<double>(second),
+                       static_cast<double>(millisecond));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function UNION_DISTINCT
+/// @brief convert a date component given as a string, like parseInt() does
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::UnionDistinct (triagens::aql::Query* query,
-                                   triagens::arango::AqlTransaction* trx,
-                                   TRI_document_collection_t const* collection,
-                                   AqlValue const parameters) {
-  std::unordered_set<TRI_json_t*, triagens::basics::JsonHash, triagens::basics::JsonEqual> values(
-    512, 
-    triagens::basics::JsonHash(), 
-    triagens::basics::JsonEqual()
-  );
+static double ParseDateComponent (char const* p,
+                                  size_t length) {
+  char const* end = p + length;
 
-  auto freeValues = [&values] () -> void {
-    for (auto& it : values) {
-      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it);
-    }
-  };
+  while (p < end && isspace(*p)) {
+    ++p;
+  }
 
-  std::unique_ptr<TRI_json_t> result;
-  size_t const n = parameters.arraySize();
+  bool negative = false;
+  if (p < end && (*p == '+' || *p == '-')) {
+    negative = (*p == '-');
+    ++p;
+  }
 
-  try {
-    for (size_t i = 0; i < n; ++i) {
-      Json value(parameters.extractArrayMember(trx, collection, i, false));
+  if (p >= end || *p < '0' || *p > '9') {
+    return NAN;
+  }
 
-      if (! value.isArray()) {
-        // not an array
-        freeValues();
-        RegisterWarning(query, "UNION_DISTINCT", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-        return AqlValue(new Json(Json::Null));
-      }
+  double result = 0.0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    result = result * 10.0 + (*p - '0');
+    ++p;
+  }
 
-      TRI_json_t const* valueJson = value.json();
-      size_t const nrValues = TRI_LengthArrayJson(valueJson);
+  return negative ? -result : result;
+}
 
-      for (size_t j = 0; j < nrValues; ++j) {
-        auto value = static_cast<TRI_json_t*>(TRI_AddressVector(&valueJson->_value._objects, j));
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a timestamp from the arguments of a date function, which are
+/// either a single timestamp or date string, or the individual components of
+/// the date. returns false if the arguments were invalid and a warning was
+/// registered. timestamp is NaN if the arguments do not make up a valid date
+////////////////////////////////////////////////////////////////////////////////
 
-        if (values.find(value) == values.end()) { 
-          std::unique_ptr<TRI_json_t> copy(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value));
+static bool MakeDate (triagens::aql::Query* query,
+                      triagens::arango::AqlTransaction* trx,
+                      TRI_document_collection_t const* collection,
+                      AqlValue const& parameters,
+                      char const* functionName,
+                      double& timestamp) {
+  size_t const n = parameters.arraySize();
 
-          if (copy == nullptr) {
-            THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-          }
-      
-          TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
-            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-          }
+  if (n == 1) {
+    Json value(parameters.extractArrayMember(trx, collection, 0, false));
 
-          values.emplace(copy.get());
-          copy.release();
-        }
+    if (value.isNumber()) {
+      timestamp = value.json()->_value._number;
+
+      if (std::isnan(timestamp) || ! std::isfinite(timestamp) || std::abs(timestamp) > MaxTimestamp) {
+        timestamp = NAN;
+      }
+      else {
+        timestamp = std::trunc(timestamp);
       }
+      return true;
     }
 
-    result.reset(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, values.size()));
-
-    if (result == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
-          
-    TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    if (value.isString()) {
+      TRI_json_t const* json = value.json();
+      timestamp = ParseDate(json->_value._string.data, json->_value._string.length - 1);
+      return true;
+    }
+
+    RegisterInvalidArgumentWarning(query, functionName);
+    return false;
+  }
+
+  if (n < 3) {
+    RegisterWarning(query, functionName, TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH);
+    return false;
+  }
+
+  // year, month, day, hour, minute, second, millisecond
+  double components[] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+  for (size_t i = 0; i < n && i < 7; ++i) {
+    Json value(parameters.extractArrayMember(trx, collection, i, false));
+
+    if (value.isNull()) {
+      continue;
+    }
+
+    if (value.isString()) {
+      TRI_json_t const* json = value.json();
+      components[i] = ParseDateComponent(json->_value._string.data, json->_value._string.length - 1);
+    }
+    else if (value.isNumber()) {
+      components[i] = value.json()->_value._number;
+    }
+    else {
+      RegisterInvalidArgumentWarning(query, functionName);
+      return false;
+    }
+
+    if (components[i] < 0.0) {
+      RegisterWarning(query, functionName, TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+      return false;
+    }
+
+    if (i == 1) {
+      // months are 1-based in AQL
+      components[i] -= 1.0;
+    }
+  }
+
+  // two-digit years refer to the 20th century, as in Date.UTC()
+  double const year = std::trunc(components[0]);
+  if (year >= 0.0 && year <= 99.0) {
+    components[0] = 1900.0 + year;
+  }
+
+  timestamp = MakeTimestamp(components[0], components[1], components[2], components[3],
+                            components[4], components[5], components[6]);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief split a timestamp into the components of its UTC date
+////////////////////////////////////////////////////////////////////////////////
+
+static void SplitTimestamp (double timestamp,
+                            int64_t& year,
+                            int64_t& month,
+                            int64_t& day,
+                            int64_t& weekday,
+                            int64_t& millisecondOfDay) {
+  double const days = std::floor(timestamp / MillisecondsPerDay);
+  millisecondOfDay = static_cast<int64_t>(timestamp - days * MillisecondsPerDay);
+
+  CivilFromDays(static_cast<int64_t>(days), year, month, day);
+
+  // January 1st 1970 was a Thursday
+  weekday = (static_cast<int64_t>(days) + 4) % 7;
+  if (weekday < 0) {
+    weekday += 7;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shared implementation of the functions that return a single date
+/// component
+////////////////////////////////////////////////////////////////////////////////
+
+enum DateComponent {
+  DATE_COMPONENT_DAYOFWEEK,
+  DATE_COMPONENT_YEAR,
+  DATE_COMPONENT_MONTH,
+  DATE_COMPONENT_DAY,
+  DATE_COMPONENT_HOUR,
+  DATE_COMPONENT_MINUTE,
+  DATE_COMPONENT_SECOND,
+  DATE_COMPONENT_MILLISECOND
+};
+
+static AqlValue ExtractDateComponent (triagens::aql::Query* query,
+                                      triagens::arango::AqlTransaction* trx,
+                                      TRI_document_collection_t const* collection,
+                                      AqlValue const& parameters,
+                                      char const* functionName,
+                                      DateComponent component) {
+  double timestamp;
+
+  if (! MakeDate(query, trx, collection, parameters, functionName, timestamp)) {
+    RegisterWarning(query, functionName, TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  if (std::isnan(timestamp)) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  int64_t year, month, day, weekday, millisecondOfDay;
+  SplitTimestamp(timestamp, year, month, day, weekday, millisecondOfDay);
+
+  int64_t result = 0;
+
+  switch (component) {
+    case DATE_COMPONENT_DAYOFWEEK:
+      result = weekday;
+      break;
+    case DATE_COMPONENT_YEAR:
+      result = year;
+      break;
+    case DATE_COMPONENT_MONTH:
+      result = month;
+      break;
+    case DATE_COMPONENT_DAY:
+      result = day;
+      break;
+    case DATE_COMPONENT_HOUR:
+      result = millisecondOfDay / 3600000;
+      break;
+    case DATE_COMPONENT_MINUTE:
+      result = (millisecondOfDay / 60000) % 60;
+      break;
+    case DATE_COMPONENT_SECOND:
+      result = (millisecondOfDay / 1000) % 60;
+      break;
+    case DATE_COMPONENT_MILLISECOND:
+      result = millisecondOfDay % 1000;
+      break;
+  }
+
+  return AqlValue(new Json(static_cast<double>(result)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert a string into a number, using the rules of the JavaScript
+/// Number() function for decimal and hexadecimal values
+////////////////////////////////////////////////////////////////////////////////
+
+static double StringToNumber (char const* p,
+                              size_t length,
+                              bool& failed) {
+  char const* e = p + length;
+
+  while (p < e && isspace(*p)) {
+    ++p;
+  }
+  while (e > p && isspace(*(e - 1))) {
+    --e;
+  }
+
+  if (p == e) {
+    // empty string => 0
+    return 0.0;
+  }
+
+  if (e - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+    double result = 0.0;
+
+    for (p += 2; p < e; ++p) {
+      int digit;
+
+      if (*p >= '0' && *p <= '9') {
+        digit = *p - '0';
+      }
+      else if (*p >= 'a' && *p <= 'f') {
+        digit = *p - 'a' + 10;
+      }
+      else if (*p >= 'A' && *p <= 'F') {
+        digit = *p - 'A' + 10;
+      }
+      else {
+        failed = true;
+        return 0.0;
+      }
+      result = result * 16.0 + digit;
+    }
+
+    return result;
+  }
+
+  // only accept plain decimal numbers, strtod() would also accept "inf",
+  // "nan" and hexadecimal floats
+  for (char const* q = p; q < e; ++q) {
+    char c = *q;
+
+    if ((c < '0' || c > '9') && c != '.' && c != '-' && c != '+' && c != 'e' && c != 'E') {
+      failed = true;
+      return 0.0;
+    }
+  }
+
+  char* end;
+  double result = strtod(p, &end);
+
+  if (end != e) {
+    failed = true;
+    return 0.0;
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert a value into a number, same rules as AQL's TO_NUMBER()
+////////////////////////////////////////////////////////////////////////////////
+
+double Functions::ValueToNumber (TRI_json_t const* json,
+                                 bool& failed) {
+  switch (json->_type) {
+    case TRI_JSON_UNUSED:
+    case TRI_JSON_NULL:
+      return 0.0;
+    case TRI_JSON_BOOLEAN:
+      return json->_value._boolean ? 1.0 : 0.0;
+    case TRI_JSON_NUMBER:
+      return json->_value._number;
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE:
+      return StringToNumber(json->_value._string.data, json->_value._string.length - 1, failed);
+    case TRI_JSON_ARRAY: {
+      size_t const n = TRI_LengthArrayJson(json);
+
+      if (n == 0) {
+        return 0.0;
+      }
+      if (n == 1) {
+        return ValueToNumber(TRI_LookupArrayJson(json, 0), failed);
+      }
+      break;
+    }
+    case TRI_JSON_OBJECT:
+      break;
+  }
+
+  failed = true;
+  return 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_NULL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsNull (triagens::aql::Query*, 
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json j(parameters.extractArrayMember(trx, collection, 0, false));
+  return AqlValue(new Json(j.isNull()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_BOOL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsBool (triagens::aql::Query*,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json j(parameters.extractArrayMember(trx, collection, 0, false));
+  return AqlValue(new Json(j.isBoolean()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_NUMBER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsNumber (triagens::aql::Query*,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json j(parameters.extractArrayMember(trx, collection, 0, false));
+  return AqlValue(new Json(j.isNumber()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_STRING
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsString (triagens::aql::Query*,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json j(parameters.extractArrayMember(trx, collection, 0, false));
+  return AqlValue(new Json(j.isString()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_ARRAY
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsArray (triagens::aql::Query*,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json j(parameters.extractArrayMember(trx, collection, 0, false));
+  return AqlValue(new Json(j.isArray()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_OBJECT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsObject (triagens::aql::Query*,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json j(parameters.extractArrayMember(trx, collection, 0, false));
+  return AqlValue(new Json(j.isObject()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LENGTH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Length (triagens::aql::Query*,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json j(parameters.extractArrayMember(trx, collection, 0, false));
+
+  TRI_json_t const* json = j.json();
+  size_t length = 0;
+
+  if (json != nullptr) {
+    switch (json->_type) {
+      case TRI_JSON_UNUSED:
+      case TRI_JSON_NULL: {
+        length = 0;
+        break;
+      }
+
+      case TRI_JSON_BOOLEAN: {
+        length = (json->_value._boolean ? 1 : 0);
+        break;
+      }
+
+      case TRI_JSON_NUMBER: {
+        if (std::isnan(json->_value._number) ||
+            ! std::isfinite(json->_value._number)) {
+          // invalid value
+          length = strlen("null");
+        }
+        else {
+          // convert to a string representation of the number
+          char buffer[24];
+          length = static_cast<size_t>(fpconv_dtoa(json->_value._number, buffer));
+        }
+        break;
+      }
+
+      case TRI_JSON_STRING:
+      case TRI_JSON_STRING_REFERENCE: {
+        // return number of characters (not bytes) in string
+        length = TRI_CharLengthUtf8String(json->_value._string.data);
+        break;
+      }
+
+      case TRI_JSON_OBJECT: {
+        // return number of attributes
+        length = TRI_LengthVector(&json->_value._objects) / 2;
+        break;
+      }
+
+      case TRI_JSON_ARRAY: {
+        // return list length
+        length = TRI_LengthArrayJson(json);
+        break;
+      }
+    }
+  }
+
+  return AqlValue(new Json(static_cast<double>(length)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CONCAT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Concat (triagens::aql::Query*,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+
+  size_t const n = parameters.arraySize();
+
+  for (size_t i = 0; i < n; ++i) {
+    Json member = parameters.at(trx, i);
+
+    if (member.isEmpty() || member.isNull()) {
+      continue;
+    }
+      
+    TRI_json_t const* json = member.json();
+    
+    if (member.isArray()) {
+      // append each member individually
+      size_t const subLength = TRI_LengthArrayJson(json);
+
+      for (size_t j = 0; j < subLength; ++j) {
+        auto sub = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, j));
+
+        if (sub == nullptr || sub->_type == TRI_JSON_NULL) {
+          continue;
+        }
+
+        AppendAsString(buffer, sub);
+      }
+    }
+    else {
+      // convert member to a string and append
+      AppendAsString(buffer, json);
+    }
+  }
+  
+  // steal the StringBuffer's char* pointer so we can avoid copying data around
+  // multiple times
+  size_t length = buffer.length();
+  std::unique_ptr<TRI_json_t> j(TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length));
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function PASSTHRU
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Passthru (triagens::aql::Query*,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+
+  Json j(parameters.extractArrayMember(trx, collection, 0, true));
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.json());
+  j.steal();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNSET
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Unset (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isObject()) {
+    RegisterInvalidArgumentWarning(query, "UNSET");
+    return AqlValue(new Json(Json::Null));
+  }
+ 
+  std::unordered_set<std::string> names;
+  ExtractKeys(names, query, trx, collection, parameters, 1, "UNSET");
+
+
+  // create result object
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthVector(&valueJson->_value._objects);
+
+  size_t size;
+  if (names.size() >= n / 2) {
+    size = 4; 
+  }
+  else {
+    size = (n / 2) - names.size(); 
+  }
+
+  std::unique_ptr<TRI_json_t> j(TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, size));
+
+  if (j == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i + 1));
+
+    if (TRI_IsStringJson(key) && 
+        names.find(key->_value._string.data) == names.end()) {
+      auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
+
+      if (copy == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      } 
+
+      TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, j.get(), key->_value._string.data, copy);
+    }
+  } 
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function KEEP
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Keep (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isObject()) {
+    RegisterInvalidArgumentWarning(query, "KEEP");
+    return AqlValue(new Json(Json::Null));
+  }
+ 
+  std::unordered_set<std::string> names;
+  ExtractKeys(names, query, trx, collection, parameters, 1, "KEEP");
+
+
+  // create result object
+  std::unique_ptr<TRI_json_t> j(TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, names.size()));
+
+  if (j == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthVector(&valueJson->_value._objects);
+
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i + 1));
+
+    if (TRI_IsStringJson(key) && 
+        names.find(key->_value._string.data) != names.end()) {
+      auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
+
+      if (copy == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      } 
+
+      TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, j.get(), key->_value._string.data, copy);
+    }
+  } 
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MERGE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Merge (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  size_t const n = parameters.arraySize();
+
+  if (n == 0) {
+    // no parameters
+    return AqlValue(new Json(Json::Object));
+  }
+
+  // use the first argument as the preliminary result
+  Json initial(parameters.extractArrayMember(trx, collection, 0, true));
+
+  if (! initial.isObject()) {
+    RegisterInvalidArgumentWarning(query, "MERGE");
+    return AqlValue(new Json(Json::Null));
+  }
+
+  std::unique_ptr<TRI_json_t> result(initial.steal());
+
+  // now merge in all other arguments
+  for (size_t i = 1; i < n; ++i) {
+    Json param(parameters.extractArrayMember(trx, collection, i, false));
+
+    if (! param.isObject()) {
+      RegisterInvalidArgumentWarning(query, "MERGE");
+      return AqlValue(new Json(Json::Null));
+    }
+ 
+    auto merged = TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(), param.json(), false, true);
+
+    if (merged == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    result.reset(merged);
+  } 
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function HAS
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Has (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  size_t const n = parameters.arraySize();
+
+  if (n < 2) {
+    // no parameters
+    return AqlValue(new Json(false));
+  }
+    
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isObject()) {
+    // not an object
+    return AqlValue(new Json(false));
+  }
+ 
+  // process name parameter 
+  Json name(parameters.extractArrayMember(trx, collection, 1, false));
+
+  char const* p;
+
+  if (! name.isString()) {
+    triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+    AppendAsString(buffer, name.json());
+    p = buffer.c_str();
+  }
+  else {
+    p = name.json()->_value._string.data;
+  }
+ 
+  bool const hasAttribute = (TRI_LookupObjectJson(value.json(), p) != nullptr);
+  return AqlValue(new Json(hasAttribute));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MATCHES
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Matches (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json element(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! element.isObject()) {
+    return AqlValue(new Json(false));
+  }
+
+  Json examples(parameters.extractArrayMember(trx, collection, 1, false));
+
+  bool returnIndex = false;
+
+  if (parameters.arraySize() > 2) {
+    Json flag(parameters.extractArrayMember(trx, collection, 2, false));
+    returnIndex = ValueToBoolean(flag.json());
+  }
+
+  std::vector<TRI_json_t const*> list;
+
+  if (examples.isArray()) {
+    size_t const n = examples.size();
+    for (size_t i = 0; i < n; ++i) {
+      list.emplace_back(static_cast<TRI_json_t const*>(TRI_AtVector(&examples.json()->_value._objects, i)));
+    }
+  }
+  else {
+    list.emplace_back(examples.json());
+  }
+
+  if (list.empty()) {
+    RegisterInvalidArgumentWarning(query, "MATCHES");
+    return AqlValue(new Json(false));
+  }
+
+  static TRI_json_t const NullJson = { TRI_JSON_NULL, { false } };
+
+  for (size_t i = 0; i < list.size(); ++i) {
+    TRI_json_t const* example = list[i];
+
+    if (! TRI_IsObjectJson(example)) {
+      RegisterInvalidArgumentWarning(query, "MATCHES");
+      continue;
+    }
+
+    bool matches = true;
+    size_t const n = TRI_LengthVector(&example->_value._objects);
+
+    for (size_t j = 0; j < n; j += 2) {
+      auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&example->_value._objects, j));
+      auto expected = static_cast<TRI_json_t const*>(TRI_AtVector(&example->_value._objects, j + 1));
+      TRI_json_t const* actual = TRI_LookupObjectJson(element.json(), key->_value._string.data);
+
+      if (actual == nullptr) {
+        // a missing attribute is equal to null
+        actual = &NullJson;
+      }
+
+      if (TRI_CompareValuesJson(actual, expected, true) != 0) {
+        matches = false;
+        break;
+      }
+    }
+
+    if (matches) {
+      if (returnIndex) {
+        return AqlValue(new Json(static_cast<double>(i)));
+      }
+      return AqlValue(new Json(true));
+    }
+  }
+
+  if (returnIndex) {
+    return AqlValue(new Json(-1.0));
+  }
+  return AqlValue(new Json(false));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MIN
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Min (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isArray()) {
+    // not an array
+    RegisterWarning(query, "MIN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
+  TRI_json_t const* minValue = nullptr;;
+
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
+
+    if (TRI_IsNullJson(value)) {
+      continue;
+    }
+
+    if (minValue == nullptr ||
+        TRI_CompareValuesJson(value, minValue) < 0) {
+      minValue = value;
+    }
+  } 
+
+  if (minValue != nullptr) {
+    std::unique_ptr<TRI_json_t> result(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, minValue));
+    
+    if (result != nullptr) {
+      auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+      result.release();
+      return AqlValue(jr);
+    }
+  }
+
+  return AqlValue(new Json(Json::Null));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MAX
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Max (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isArray()) {
+    // not an array
+    RegisterWarning(query, "MAX", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
+  TRI_json_t const* maxValue = nullptr;;
+
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
+
+    if (TRI_IsNullJson(value)) {
+      continue;
+    }
+
+    if (maxValue == nullptr ||
+        TRI_CompareValuesJson(value, maxValue) > 0) {
+      maxValue = value;
+    }
+  } 
+
+  if (maxValue != nullptr) {
+    std::unique_ptr<TRI_json_t> result(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, maxValue));
+    
+    if (result != nullptr) {
+      auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+      result.release();
+      return AqlValue(jr);
+    }
+  }
+
+  return AqlValue(new Json(Json::Null));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SUM
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Sum (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isArray()) {
+    // not an array
+    RegisterWarning(query, "SUM", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
+  double sum = 0.0;
+
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
+
+    if (TRI_IsNullJson(value)) {
+      continue;
+    }
+
+    if (! TRI_IsNumberJson(value)) {
+      RegisterInvalidArgumentWarning(query, "SUM");
+      return AqlValue(new Json(Json::Null));
+    }
+
+    // got a numeric value
+    double const number = value->_value._number;
+
+    if (! std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
+      sum += number;
+    } 
+  } 
+
+  if (! std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
+    return AqlValue(new Json(sum));
+  } 
+
+  return AqlValue(new Json(Json::Null));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function AVERAGE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Average (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isArray()) {
+    // not an array
+    RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
+  double sum = 0.0;
+  size_t count = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
+
+    if (TRI_IsNullJson(value)) {
+      continue;
+    }
+
+    if (! TRI_IsNumberJson(value)) {
+      RegisterInvalidArgumentWarning(query, "AVERAGE");
+      return AqlValue(new Json(Json::Null));
+    }
+
+    // got a numeric value
+    double const number = value->_value._number;
+
+    if (! std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
+      sum += number;
+      ++count;
+    } 
+  } 
+
+  if (count > 0 && 
+      ! std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
+    return AqlValue(new Json(sum / static_cast<size_t>(count)));
+  } 
+
+  return AqlValue(new Json(Json::Null));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MD5
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Md5 (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+    
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  AppendAsString(buffer, value.json());
+  
+  // create md5
+  char hash[17]; 
+  char* p = &hash[0];
+  size_t length;
+
+  triagens::rest::SslInterface::sslMD5(buffer.c_str(), buffer.length(), p, length);
+
+  // as hex
+  char hex[33];
+  p = &hex[0];
+
+  triagens::rest::SslInterface::sslHEX(hash, 16, p, length);
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, hex, 32));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SHA1
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Sha1 (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+    
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  AppendAsString(buffer, value.json());
+  
+  // create sha1
+  char hash[21];
+  char* p = &hash[0];
+  size_t length;
+
+  triagens::rest::SslInterface::sslSHA1(buffer.c_str(), buffer.length(), p, length);
+
+  // as hex
+  char hex[41];
+  p = &hex[0];
+
+  triagens::rest::SslInterface::sslHEX(hash, 20, p, length);
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, hex, 40));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNIQUE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Unique (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isArray()) {
+    // not an array
+    RegisterWarning(query, "UNIQUE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
+
+  std::unordered_set<TRI_json_t const*, triagens::basics::JsonHash, triagens::basics::JsonEqual> values(
+    512, 
+    triagens::basics::JsonHash(), 
+    triagens::basics::JsonEqual()
+  );
+
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(TRI_AddressVector(&valueJson->_value._objects, i));
+
+    if (value == nullptr) {
+      continue;
+    }
+
+    values.emplace(value); 
+  } 
+
+  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, values.size()));
+ 
+  for (auto const& it : values) {
+    auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, it);
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+ 
+    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy); 
+  }
+      
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNION
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Union (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, 16));
+
+  size_t const n = parameters.arraySize();
+
+  for (size_t i = 0; i < n; ++i) {
+    Json value(parameters.extractArrayMember(trx, collection, i, false));
+
+    if (! value.isArray()) {
+      // not an array
+      RegisterWarning(query, "UNION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+      return AqlValue(new Json(Json::Null));
+    }
+
+    TRI_json_t const* valueJson = value.json();
+    size_t const nrValues = TRI_LengthArrayJson(valueJson);
+
+    if (TRI_ReserveVector(&(result.get()->_value._objects), nrValues) != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+    
+    // this passes ownership for the JSON contens into result
+    for (size_t j = 0; j < nrValues; ++j) {
+      TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, TRI_LookupArrayJson(valueJson, j));
+
+      if (copy == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+    
+      TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+
+      TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+    } 
+  } 
+      
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNION_DISTINCT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::UnionDistinct (triagens::aql::Query* query,
+                                   triagens::arango::AqlTransaction* trx,
+                                   TRI_document_collection_t const* collection,
+                                   AqlValue const parameters) {
+  std::unordered_set<TRI_json_t*, triagens::basics::JsonHash, triagens::basics::JsonEqual> values(
+    512, 
+    triagens::basics::JsonHash(), 
+    triagens::basics::JsonEqual()
+  );
+
+  auto freeValues = [&values] () -> void {
+    for (auto& it : values) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it);
+    }
+  };
+
+  std::unique_ptr<TRI_json_t> result;
+  size_t const n = parameters.arraySize();
+
+  try {
+    for (size_t i = 0; i < n; ++i) {
+      Json value(parameters.extractArrayMember(trx, collection, i, false));
+
+      if (! value.isArray()) {
+        // not an array
+        freeValues();
+        RegisterWarning(query, "UNION_DISTINCT", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+        return AqlValue(new Json(Json::Null));
+      }
+
+      TRI_json_t const* valueJson = value.json();
+      size_t const nrValues = TRI_LengthArrayJson(valueJson);
+
+      for (size_t j = 0; j < nrValues; ++j) {
+        auto value = static_cast<TRI_json_t*>(TRI_AddressVector(&valueJson->_value._objects, j));
+
+        if (values.find(value) == values.end()) { 
+          std::unique_ptr<TRI_json_t> copy(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value));
+
+          if (copy == nullptr) {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+          }
+      
+          TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+          }
+
+          values.emplace(copy.get());
+          copy.release();
+        }
+      }
+    }
+
+    result.reset(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, values.size()));
+
+    if (result == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+          
+    TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
     }
    
     for (auto const& it : values) {
-      TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), it); 
+      TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), it); 
+    }
+
+  }
+  catch (...) {  
+    freeValues();
+    throw;
+  }
+    
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+      
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function INTERSECTION
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Intersection (triagens::aql::Query* query,
+                                  triagens::arango::AqlTransaction* trx,
+                                  TRI_document_collection_t const* collection,
+                                  AqlValue const parameters) {
+  std::unordered_map<TRI_json_t*, size_t, triagens::basics::JsonHash, triagens::basics::JsonEqual> values(
+    512, 
+    triagens::basics::JsonHash(), 
+    triagens::basics::JsonEqual()
+  );
+
+  auto freeValues = [&values] () -> void {
+    for (auto& it : values) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.first);
+    }
+    values.clear();
+  };
+
+  std::unique_ptr<TRI_json_t> result;
+  size_t const n = parameters.arraySize();
+
+  try {
+    for (size_t i = 0; i < n; ++i) {
+      Json value(parameters.extractArrayMember(trx, collection, i, false));
+
+      if (! value.isArray()) {
+        // not an array
+        freeValues();
+        RegisterWarning(query, "INTERSECTION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+        return AqlValue(new Json(Json::Null));
+      }
+
+      TRI_json_t const* valueJson = value.json();
+      size_t const nrValues = TRI_LengthArrayJson(valueJson);
+
+      for (size_t j = 0; j < nrValues; ++j) {
+        auto value = static_cast<TRI_json_t const*>(TRI_AddressVector(&valueJson->_value._objects, j));
+
+        if (i == 0) {
+          // round one
+          std::unique_ptr<TRI_json_t> copy(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value));
+
+          if (copy == nullptr) {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+          }
+    
+          TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+          }
+
+          auto r = values.emplace(copy.get(), 1);
+ 
+          if (r.second) {
+            // successfully inserted
+            copy.release();
+          }
+        }
+        else {
+          // check if we have seen the same element before
+          auto it = values.find(const_cast<TRI_json_t*>(value));
+
+          if (it != values.end()) {
+            // already seen
+            TRI_ASSERT((*it).second > 0);
+            ++((*it).second);
+          }
+        }
+      }
+    }
+ 
+    // count how many valid we have 
+    size_t total = 0;
+
+    for (auto const& it : values) {
+      if (it.second == n) {
+        ++total;
+      }
+    }
+
+    result.reset(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, total));
+
+    if (result == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+          
+    TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+   
+    for (auto& it : values) {
+      if (it.second == n) {
+        TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), it.first); 
+      }
+      else {
+        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.first);
+      }
+    }
+    values.clear();
+   
+  } 
+  catch (...) {
+    freeValues();
+    throw;
+  }
+    
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+      
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TO_NUMBER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ToNumber (triagens::aql::Query*,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  bool failed = false;
+  double number = ValueToNumber(value.json(), failed);
+
+  if (failed) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return NumericValue(number);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TO_STRING
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ToString (triagens::aql::Query*,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  AppendAsString(buffer, value.json());
+
+  return StringValue(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TO_BOOL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ToBool (triagens::aql::Query*,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+  return AqlValue(new Json(ValueToBoolean(value.json())));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TO_ARRAY
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ToArray (triagens::aql::Query*,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (value.isNull()) {
+    return AqlValue(new Json(Json::Array));
+  }
+
+  if (value.isArray()) {
+    return CopiedValue(value.json());
+  }
+
+  if (value.isObject()) {
+    TRI_json_t const* valueJson = value.json();
+    size_t const n = TRI_LengthVector(&valueJson->_value._objects);
+
+    std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, n / 2));
+
+    if (result == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    for (size_t i = 1; i < n; i += 2) {
+      auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i)));
+
+      if (copy == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+
+      TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+    }
+
+    auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+    result.release();
+    return AqlValue(jr);
+  }
+
+  // a scalar value
+  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, 1));
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value.json());
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CONCAT_SEPARATOR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ConcatSeparator (triagens::aql::Query*,
+                                     triagens::arango::AqlTransaction* trx,
+                                     TRI_document_collection_t const* collection,
+                                     AqlValue const parameters) {
+  triagens::basics::StringBuffer separator(TRI_UNKNOWN_MEM_ZONE, 8);
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+
+  size_t const n = parameters.arraySize();
+
+  if (n > 0) {
+    Json member(parameters.extractArrayMember(trx, collection, 0, false));
+    AppendAsString(separator, member.json());
+  }
+
+  bool found = false;
+
+  for (size_t i = 1; i < n; ++i) {
+    Json member(parameters.extractArrayMember(trx, collection, i, false));
+
+    if (member.isEmpty() || member.isNull()) {
+      continue;
+    }
+
+    if (found) {
+      buffer.appendText(separator.c_str(), separator.length());
+    }
+
+    TRI_json_t const* json = member.json();
+
+    if (member.isArray()) {
+      // append each member individually
+      size_t const subLength = TRI_LengthArrayJson(json);
+      found = false;
+
+      for (size_t j = 0; j < subLength; ++j) {
+        auto sub = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, j));
+
+        if (sub == nullptr || sub->_type == TRI_JSON_NULL) {
+          continue;
+        }
+
+        if (found) {
+          buffer.appendText(separator.c_str(), separator.length());
+        }
+
+        AppendAsString(buffer, sub);
+        found = true;
+      }
+    }
+    else {
+      // convert member to a string and append
+      AppendAsString(buffer, json);
+      found = true;
+    }
+  }
+
+  return StringValue(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CHAR_LENGTH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::CharLength (triagens::aql::Query*,
+                                triagens::arango::AqlTransaction* trx,
+                                TRI_document_collection_t const* collection,
+                                AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  return AqlValue(new Json(static_cast<double>(string.size())));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LOWER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Lower (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  AppendAsString(buffer, value.json());
+
+  int32_t length = 0;
+  char* lower = TRI_tolower_utf8(TRI_UNKNOWN_MEM_ZONE, buffer.c_str(), static_cast<int32_t>(buffer.length()), &length);
+
+  if (lower == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  std::unique_ptr<TRI_json_t> j(TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, lower, static_cast<size_t>(length)));
+
+  if (j == nullptr) {
+    TRI_FreeString(TRI_UNKNOWN_MEM_ZONE, lower);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UPPER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Upper (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  AppendAsString(buffer, value.json());
+
+  int32_t length = 0;
+  char* upper = TRI_toupper_utf8(TRI_UNKNOWN_MEM_ZONE, buffer.c_str(), static_cast<int32_t>(buffer.length()), &length);
+
+  if (upper == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  std::unique_ptr<TRI_json_t> j(TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, upper, static_cast<size_t>(length)));
+
+  if (j == nullptr) {
+    TRI_FreeString(TRI_UNKNOWN_MEM_ZONE, upper);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SUBSTRING
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Substring (triagens::aql::Query*,
+                               triagens::arango::AqlTransaction* trx,
+                               TRI_document_collection_t const* collection,
+                               AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  AppendAsString(buffer, value.json());
+
+  double const offset = ExtractNumber(trx, collection, parameters, 1);
+  double count = static_cast<double>(buffer.length());
+
+  if (parameters.arraySize() > 2) {
+    count = ExtractNumber(trx, collection, parameters, 2);
+  }
+
+  return SubstringValue(buffer.c_str(), buffer.length(), offset, count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CONTAINS
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Contains (triagens::aql::Query*,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+  Json search(parameters.extractArrayMember(trx, collection, 1, false));
+
+  bool returnIndex = false;
+
+  if (parameters.arraySize() > 2) {
+    Json flag(parameters.extractArrayMember(trx, collection, 2, false));
+    returnIndex = ValueToBoolean(flag.json());
+  }
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  std::u16string needle;
+  ValueToUtf16(search.json(), needle);
+
+  double position = -1.0;
+
+  if (! needle.empty()) {
+    position = IndexOf(string, needle, 0);
+  }
+
+  if (returnIndex) {
+    return AqlValue(new Json(position));
+  }
+
+  return AqlValue(new Json(position != -1.0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LEFT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Left (triagens::aql::Query*,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  AppendAsString(buffer, value.json());
+
+  double const length = ExtractNumber(trx, collection, parameters, 1);
+
+  return SubstringValue(buffer.c_str(), buffer.length(), 0.0, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function RIGHT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Right (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  double const length = ExtractNumber(trx, collection, parameters, 1);
+
+  size_t from, to;
+  SubstrRange(string.size(), (std::max)(static_cast<double>(string.size()) - length, 0.0), length, from, to);
+
+  return Utf16Value(string.data() + from, to - from);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LIKE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Like (triagens::aql::Query*,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+  Json regex(parameters.extractArrayMember(trx, collection, 1, false));
+
+  bool caseInsensitive = false;
+
+  if (parameters.arraySize() > 2) {
+    Json flag(parameters.extractArrayMember(trx, collection, 2, false));
+    caseInsensitive = ValueToBoolean(flag.json());
+  }
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  std::u16string pattern;
+  ValueToUtf16(regex.json(), pattern);
+
+  return AqlValue(new Json(MatchLikePattern(string, pattern, caseInsensitive)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shared implementation of TRIM, LTRIM and RTRIM with a list of
+/// characters
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue TrimCharactersValue (std::u16string const& value,
+                                     TRI_json_t const* json,
+                                     bool left,
+                                     bool right,
+                                     char const* functionName) {
+  std::u16string characters;
+  ValueToUtf16(json, characters);
+
+  TrimCharacters chars;
+
+  if (! MakeTrimCharacters(characters, chars)) {
+    // the JavaScript implementation fails to build its regex
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, functionName);
+  }
+
+  return TrimValue(value, chars, left, right);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TRIM
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Trim (triagens::aql::Query*,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  bool left = true;
+  bool right = true;
+
+  if (parameters.arraySize() > 1) {
+    Json chars(parameters.extractArrayMember(trx, collection, 1, false));
+
+    if (chars.isNumber() && chars.json()->_value._number == 1.0) {
+      right = false;
+    }
+    else if (chars.isNumber() && chars.json()->_value._number == 2.0) {
+      left = false;
+    }
+    else if (! chars.isNull() &&
+             ! (chars.isNumber() && chars.json()->_value._number == 0.0)) {
+      return TrimCharactersValue(string, chars.json(), true, true, "TRIM");
+    }
+  }
+
+  return TrimValue(string, TrimCharacters(), left, right);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LTRIM
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::LTrim (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  if (parameters.arraySize() > 1) {
+    Json chars(parameters.extractArrayMember(trx, collection, 1, false));
+
+    if (! chars.isNull()) {
+      return TrimCharactersValue(string, chars.json(), true, false, "LTRIM");
+    }
+  }
+
+  return TrimValue(string, TrimCharacters(), true, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function RTRIM
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::RTrim (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  if (parameters.arraySize() > 1) {
+    Json chars(parameters.extractArrayMember(trx, collection, 1, false));
+
+    if (! chars.isNull()) {
+      return TrimCharactersValue(string, chars.json(), false, true, "RTRIM");
+    }
+  }
+
+  return TrimValue(string, TrimCharacters(), false, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIND_FIRST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::FindFirst (triagens::aql::Query*,
+                               triagens::arango::AqlTransaction* trx,
+                               TRI_document_collection_t const* collection,
+                               AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+  Json search(parameters.extractArrayMember(trx, collection, 1, false));
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  std::u16string needle;
+  ValueToUtf16(search.json(), needle);
+
+  double start = 0.0;
+
+  if (parameters.arraySize() > 2 &&
+      ! Json(parameters.extractArrayMember(trx, collection, 2, false)).isNull()) {
+    start = ExtractNumber(trx, collection, parameters, 2);
+
+    if (start < 0.0) {
+      return AqlValue(new Json(-1.0));
+    }
+  }
+
+  if (parameters.arraySize() > 3 &&
+      ! Json(parameters.extractArrayMember(trx, collection, 3, false)).isNull()) {
+    double const end = ExtractNumber(trx, collection, parameters, 3);
+
+    if (end < start || end < 0.0) {
+      return AqlValue(new Json(-1.0));
+    }
+
+    size_t from, to;
+    SubstrRange(string.size(), 0.0, end + 1.0, from, to);
+    string.resize(to);
+  }
+
+  start = (std::min)(std::trunc(start), static_cast<double>(string.size()));
+
+  return AqlValue(new Json(IndexOf(string, needle, static_cast<size_t>(start))));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIND_LAST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::FindLast (triagens::aql::Query*,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+  Json search(parameters.extractArrayMember(trx, collection, 1, false));
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  std::u16string needle;
+  ValueToUtf16(search.json(), needle);
+
+  bool const hasStart = (parameters.arraySize() > 2 &&
+                         ! Json(parameters.extractArrayMember(trx, collection, 2, false)).isNull());
+  bool const hasEnd = (parameters.arraySize() > 3 &&
+                       ! Json(parameters.extractArrayMember(trx, collection, 3, false)).isNull());
+
+  double const start = (hasStart ? ExtractNumber(trx, collection, parameters, 2) : 0.0);
+  double const end = (hasEnd ? ExtractNumber(trx, collection, parameters, 3) : 0.0);
+
+  if (hasEnd && ((hasStart && end < start) || end < 0.0)) {
+    return AqlValue(new Json(-1.0));
+  }
+
+  if (! (start > 0.0 || hasEnd)) {
+    return AqlValue(new Json(LastIndexOf(string, needle)));
+  }
+
+  if (! hasStart) {
+    // the JavaScript implementation searches an empty string here, and an
+    // empty search string is found at an undefined position
+    if (needle.empty()) {
+      return AqlValue(new Json(Json::Null));
+    }
+    return AqlValue(new Json(-1.0));
+  }
+
+  size_t from, to;
+  SubstrRange(string.size(), start, (hasEnd ? end - start + 1.0 : HUGE_VAL), from, to);
+
+  double result = LastIndexOf(string.substr(from, to - from), needle);
+
+  if (result != -1.0) {
+    result += start;
+  }
+
+  return NumericValue(result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SPLIT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Split (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  std::vector<std::u16string> separators;
+  bool hasSeparator = false;
+
+  if (parameters.arraySize() > 1) {
+    Json separator(parameters.extractArrayMember(trx, collection, 1, false));
+
+    if (separator.isArray()) {
+      size_t const n = separator.size();
+      for (size_t i = 0; i < n; ++i) {
+        std::u16string s;
+        ValueToUtf16(separator.at(i).json(), s);
+        separators.emplace_back(std::move(s));
+      }
+      hasSeparator = true;
+    }
+    else if (! separator.isNull()) {
+      std::u16string s;
+      ValueToUtf16(separator.json(), s);
+      separators.emplace_back(std::move(s));
+      hasSeparator = true;
+    }
+  }
+
+  // no limit is the same as the maximum limit of String.prototype.split()
+  double limit = 4294967295.0;
+
+  if (parameters.arraySize() > 2 &&
+      ! Json(parameters.extractArrayMember(trx, collection, 2, false)).isNull()) {
+    limit = ExtractNumber(trx, collection, parameters, 2);
+
+    if (limit < 0.0) {
+      RegisterInvalidArgumentWarning(query, "SPLIT");
+      return AqlValue(new Json(Json::Null));
+    }
+
+    // String.prototype.split() converts the limit into an unsigned 32 bit value
+    limit = std::fmod(std::trunc(limit), 4294967296.0);
+  }
+
+  std::vector<std::u16string> parts;
+
+  if (hasSeparator) {
+    SplitValue(string, separators, limit, parts);
+  }
+  else {
+    parts.emplace_back(string);
+  }
+
+  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, parts.size()));
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  for (auto const& part : parts) {
+    triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, part.size() + 1);
+    AppendUtf16(buffer, part.data(), part.size());
+
+    size_t const length = buffer.length();
+    auto s = TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length);
+
+    if (s == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), s);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an attribute name is an array index. V8 enumerates
+/// such attributes first, in ascending order
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsArrayIndex (char const* p,
+                          size_t length,
+                          uint64_t& index) {
+  if (length == 0 || length > 10 || (length > 1 && *p == '0')) {
+    return false;
+  }
+
+  index = 0;
+  for (size_t i = 0; i < length; ++i) {
+    if (p[i] < '0' || p[i] > '9') {
+      return false;
+    }
+    index = index * 10 + static_cast<uint64_t>(p[i] - '0');
+  }
+
+  return index < 4294967295ULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SUBSTITUTE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Substitute (triagens::aql::Query* query,
+                                triagens::arango::AqlTransaction* trx,
+                                TRI_document_collection_t const* collection,
+                                AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+  Json search(parameters.extractArrayMember(trx, collection, 1, false));
+  Json replace(Json::Null);
+
+  if (parameters.arraySize() > 2) {
+    replace = parameters.extractArrayMember(trx, collection, 2, false);
+  }
+
+  std::u16string string;
+  ValueToUtf16(value.json(), string);
+
+  std::vector<std::u16string> patterns;
+  std::unordered_map<std::u16string, std::u16string> replacements;
+  size_t limitPosition = 3;
+
+  if (search.isObject()) {
+    // the mapping of search strings to replacements. the limit is the third
+    // parameter then
+    TRI_json_t const* json = search.json();
+    size_t const n = TRI_LengthVector(&json->_value._objects);
+
+    std::vector<std::pair<uint64_t, size_t>> indexes;
+    std::vector<size_t> others;
+
+    for (size_t i = 0; i < n; i += 2) {
+      auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+      uint64_t index;
+
+      if (IsArrayIndex(key->_value._string.data, key->_value._string.length - 1, index)) {
+        indexes.emplace_back(index, i);
+      }
+      else {
+        others.emplace_back(i);
+      }
+    }
+
+    std::sort(indexes.begin(), indexes.end());
+
+    std::vector<size_t> positions;
+    for (auto const& it : indexes) {
+      positions.emplace_back(it.second);
+    }
+    positions.insert(positions.end(), others.begin(), others.end());
+
+    for (auto i : positions) {
+      auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+      auto member = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i + 1));
+
+      std::u16string k;
+      ToUtf16(key->_value._string.data, key->_value._string.length - 1, k);
+      ValueToUtf16(member, replacements[k]);
+      patterns.emplace_back(std::move(k));
+    }
+
+    limitPosition = 2;
+  }
+  else if (search.isArray()) {
+    size_t const n = search.size();
+
+    if (n == 0) {
+      RegisterInvalidArgumentWarning(query, "SUBSTITUTE");
+      return Utf16Value(string.data(), string.size());
+    }
+
+    std::u16string constant;
+    if (! replace.isArray() && ! replace.isNull()) {
+      ValueToUtf16(replace.json(), constant);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+      std::u16string k;
+      ValueToUtf16(search.at(i).json(), k);
+
+      if (! replace.isArray()) {
+        // replace all occurrences with a constant string
+        replacements[k] = constant;
+      }
+      else if (i < replace.size()) {
+        // replace each occurrence with a member from the second list
+        ValueToUtf16(replace.at(i).json(), replacements[k]);
+      }
+      else {
+        replacements[k].clear();
+      }
+      patterns.emplace_back(std::move(k));
+    }
+  }
+  else {
+    std::u16string k;
+    ValueToUtf16(search.json(), k);
+
+    std::u16string& r = replacements[k];
+    if (! replace.isNull()) {
+      ValueToUtf16(replace.json(), r);
+    }
+    patterns.emplace_back(std::move(k));
+  }
+
+  double limit = HUGE_VAL;
+
+  if (parameters.arraySize() > limitPosition &&
+      ! Json(parameters.extractArrayMember(trx, collection, limitPosition, false)).isNull()) {
+    limit = ExtractNumber(trx, collection, parameters, limitPosition);
+
+    if (limit < 0.0) {
+      RegisterInvalidArgumentWarning(query, "SUBSTITUTE");
+      return AqlValue(new Json(Json::Null));
+    }
+  }
+
+  std::u16string result;
+  SubstituteValue(string, patterns, replacements, limit, result);
+
+  return Utf16Value(result.data(), result.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FLOOR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Floor (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  return NumericValue(std::floor(ExtractNumber(trx, collection, parameters, 0)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CEIL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Ceil (triagens::aql::Query*,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  return NumericValue(std::ceil(ExtractNumber(trx, collection, parameters, 0)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ROUND
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Round (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  double const number = ExtractNumber(trx, collection, parameters, 0);
+
+  // round half up, as JavaScript's Math.round() does
+  double result = std::floor(number);
+  if (number - result >= 0.5) {
+    result += 1.0;
+  }
+
+  return NumericValue(result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ABS
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Abs (triagens::aql::Query*,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  return NumericValue(std::abs(ExtractNumber(trx, collection, parameters, 0)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function RAND
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Rand (triagens::aql::Query*,
+                          triagens::arango::AqlTransaction*,
+                          TRI_document_collection_t const*,
+                          AqlValue const) {
+  // a value in the range [0, 1)
+  return AqlValue(new Json(static_cast<double>(TRI_UInt32Random()) / 4294967296.0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SQRT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Sqrt (triagens::aql::Query*,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  return NumericValue(std::sqrt(ExtractNumber(trx, collection, parameters, 0)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FLATTEN
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Flatten (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isArray()) {
+    // not an array
+    RegisterWarning(query, "FLATTEN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  double maxDepth = 1.0;
+
+  if (parameters.arraySize() > 1) {
+    Json depth(parameters.extractArrayMember(trx, collection, 1, false));
+    bool failed = false;
+    maxDepth = ValueToNumber(depth.json(), failed);
+
+    if (failed || std::isnan(maxDepth) || maxDepth < 1.0) {
+      maxDepth = 1.0;
+    }
+  }
+
+  TRI_json_t const* valueJson = value.json();
+  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, TRI_LengthArrayJson(valueJson)));
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  FlattenArray(result.get(), valueJson, maxDepth, 0.0);
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIRST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::First (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isArray()) {
+    // not an array
+    RegisterWarning(query, "FIRST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return CopiedValue(TRI_LookupArrayJson(value.json(), 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LAST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Last (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isArray()) {
+    // not an array
+    RegisterWarning(query, "LAST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  size_t const n = TRI_LengthArrayJson(value.json());
+
+  if (n == 0) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return CopiedValue(TRI_LookupArrayJson(value.json(), n - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function NTH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Nth (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isArray()) {
+    // not an array
+    RegisterWarning(query, "NTH", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  Json position(parameters.extractArrayMember(trx, collection, 1, false));
+
+  bool failed = false;
+  double const p = ValueToNumber(position.json(), failed);
+  size_t const n = TRI_LengthArrayJson(value.json());
+
+  if (failed || p < 0.0 || p >= static_cast<double>(n) || p != std::floor(p)) {
+    // out of bounds or not an integer
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return CopiedValue(TRI_LookupArrayJson(value.json(), static_cast<size_t>(p)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function REVERSE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Reverse (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+  TRI_json_t const* valueJson = value.json();
+
+  if (value.isString()) {
+    // reverse the UTF-16 code units, as the JavaScript implementation does
+    std::u16string string;
+    ToUtf16(valueJson->_value._string.data, valueJson->_value._string.length - 1, string);
+    std::reverse(string.begin(), string.end());
+
+    return Utf16Value(string.data(), string.size());
+  }
+
+  if (! value.isArray()) {
+    RegisterWarning(query, "REVERSE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  size_t const n = TRI_LengthArrayJson(valueJson);
+  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, n));
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  for (size_t i = n; i > 0; --i) {
+    auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i - 1)));
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ATTRIBUTES
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Attributes (triagens::aql::Query* query,
+                                triagens::arango::AqlTransaction* trx,
+                                TRI_document_collection_t const* collection,
+                                AqlValue const parameters) {
+  size_t const n = parameters.arraySize();
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
+
+  if (! value.isObject()) {
+    RegisterInvalidArgumentWarning(query, "ATTRIBUTES");
+    return AqlValue(new Json(Json::Null));
+  }
+
+  bool removeInternal = false;
+  bool doSort = false;
+
+  if (n > 1) {
+    Json flag(parameters.extractArrayMember(trx, collection, 1, false));
+    removeInternal = ValueToBoolean(flag.json());
+  }
+  if (n > 2) {
+    Json flag(parameters.extractArrayMember(trx, collection, 2, false));
+    doSort = ValueToBoolean(flag.json());
+  }
+
+  TRI_json_t const* valueJson = value.json();
+  size_t const numMembers = TRI_LengthVector(&valueJson->_value._objects);
+
+  std::vector<TRI_json_t const*> keys;
+  keys.reserve(numMembers / 2);
+
+  for (size_t i = 0; i < numMembers; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
+
+    if (! TRI_IsStringJson(key) ||
+        (removeInternal && key->_value._string.data[0] == '_')) {
+      continue;
+    }
+
+    keys.emplace_back(key);
+  }
+
+  if (doSort) {
+    std::sort(keys.begin(), keys.end(), [] (TRI_json_t const* lhs, TRI_json_t const* rhs) {
+      return strcmp(lhs->_value._string.data, rhs->_value._string.data) < 0;
+    });
+  }
+
+  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, keys.size()));
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  for (auto const& it : keys) {
+    auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, it);
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
     }
 
+    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
   }
-  catch (...) {  
-    freeValues();
-    throw;
-  }
-    
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-  }
-      
+
   auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
   result.release();
   return AqlValue(jr);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function INTERSECTION
+/// @brief function VALUES
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Intersection (triagens::aql::Query* query,
-                                  triagens::arango::AqlTransaction* trx,
-                                  TRI_document_collection_t const* collection,
-                                  AqlValue const parameters) {
-  std::unordered_map<TRI_json_t*, size_t, triagens::basics::JsonHash, triagens::basics::JsonEqual> values(
-    512, 
-    triagens::basics::JsonHash(), 
-    triagens::basics::JsonEqual()
-  );
+AqlValue Functions::Values (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json value(parameters.extractArrayMember(trx, collection, 0, false));
 
-  auto freeValues = [&values] () -> void {
-    for (auto& it : values) {
-      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.first);
-    }
-    values.clear();
-  };
+  if (! value.isObject()) {
+    RegisterInvalidArgumentWarning(query, "VALUES");
+    return AqlValue(new Json(Json::Null));
+  }
 
-  std::unique_ptr<TRI_json_t> result;
-  size_t const n = parameters.arraySize();
+  bool removeInternal = false;
 
-  try {
-    for (size_t i = 0; i < n; ++i) {
-      Json value(parameters.extractArrayMember(trx, collection, i, false));
+  if (parameters.arraySize() > 1) {
+    Json flag(parameters.extractArrayMember(trx, collection, 1, false));
+    removeInternal = ValueToBoolean(flag.json());
+  }
 
-      if (! value.isArray()) {
-        // not an array
-        freeValues();
-        RegisterWarning(query, "INTERSECTION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-        return AqlValue(new Json(Json::Null));
-      }
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthVector(&valueJson->_value._objects);
 
-      TRI_json_t const* valueJson = value.json();
-      size_t const nrValues = TRI_LengthArrayJson(valueJson);
+  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, n / 2));
 
-      for (size_t j = 0; j < nrValues; ++j) {
-        auto value = static_cast<TRI_json_t const*>(TRI_AddressVector(&valueJson->_value._objects, j));
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
 
-        if (i == 0) {
-          // round one
-          std::unique_ptr<TRI_json_t> copy(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value));
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i));
 
-          if (copy == nullptr) {
-            THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-          }
-    
-          TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
-            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-          }
+    if (! TRI_IsStringJson(key) ||
+        (removeInternal && key->_value._string.data[0] == '_')) {
+      continue;
+    }
 
-          auto r = values.emplace(copy.get(), 1);
- 
-          if (r.second) {
-            // successfully inserted
-            copy.release();
-          }
-        }
-        else {
-          // check if we have seen the same element before
-          auto it = values.find(const_cast<TRI_json_t*>(value));
+    auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, static_cast<TRI_json_t const*>(TRI_AtVector(&valueJson->_value._objects, i + 1)));
 
-          if (it != values.end()) {
-            // already seen
-            TRI_ASSERT((*it).second > 0);
-            ++((*it).second);
-          }
-        }
-      }
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
     }
- 
-    // count how many valid we have 
-    size_t total = 0;
 
-    for (auto const& it : values) {
-      if (it.second == n) {
-        ++total;
-      }
+    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ZIP
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Zip (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json keys(parameters.extractArrayMember(trx, collection, 0, false));
+  Json values(parameters.extractArrayMember(trx, collection, 1, false));
+
+  if (! keys.isArray() ||
+      ! values.isArray() ||
+      keys.size() != values.size()) {
+    RegisterInvalidArgumentWarning(query, "ZIP");
+    return AqlValue(new Json(Json::Null));
+  }
+
+  TRI_json_t const* keysJson = keys.json();
+  TRI_json_t const* valuesJson = values.json();
+  size_t const n = TRI_LengthArrayJson(keysJson);
+
+  std::unique_ptr<TRI_json_t> result(TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, n));
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  std::unordered_set<std::string> names;
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+
+  for (size_t i = 0; i < n; ++i) {
+    buffer.reset();
+    AppendAsString(buffer, static_cast<TRI_json_t const*>(TRI_AtVector(&keysJson->_value._objects, i)));
+
+    auto value = static_cast<TRI_json_t*>(TRI_AtVector(&valuesJson->_value._objects, i));
+
+    if (! names.emplace(std::string(buffer.c_str(), buffer.length())).second) {
+      // a later value for the same key wins
+      TRI_ReplaceObjectJson(TRI_UNKNOWN_MEM_ZONE, result.get(), buffer.c_str(), value);
+      continue;
     }
 
-    result.reset(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, total));
+    auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
 
-    if (result == nullptr) {
+    if (copy == nullptr) {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
     }
-          
-    TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-    }
-   
-    for (auto& it : values) {
-      if (it.second == n) {
-        TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), it.first); 
-      }
-      else {
-        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.first);
-      }
-    }
-    values.clear();
-   
-  } 
-  catch (...) {
-    freeValues();
-    throw;
-  }
-    
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, result.get(), buffer.c_str(), copy);
   }
-      
+
   auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
   result.release();
   return AqlValue(jr);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function NOT_NULL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::NotNull (triagens::aql::Query*,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  return FirstOfType(trx, collection, parameters, [] (Json const& value) {
+    return ! value.isNull();
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIRST_LIST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::FirstList (triagens::aql::Query*,
+                               triagens::arango::AqlTransaction* trx,
+                               TRI_document_collection_t const* collection,
+                               AqlValue const parameters) {
+  return FirstOfType(trx, collection, parameters, [] (Json const& value) {
+    return value.isArray();
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIRST_DOCUMENT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::FirstDocument (triagens::aql::Query*,
+                                   triagens::arango::AqlTransaction* trx,
+                                   TRI_document_collection_t const* collection,
+                                   AqlValue const parameters) {
+  return FirstOfType(trx, collection, parameters, [] (Json const& value) {
+    return value.isObject();
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_NOW
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateNow (triagens::aql::Query*,
+                             triagens::arango::AqlTransaction*,
+                             TRI_document_collection_t const*,
+                             AqlValue const) {
+  return AqlValue(new Json(std::floor(TRI_microtime() * 1000.0)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_TIMESTAMP
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateTimestamp (triagens::aql::Query* query,
+                                   triagens::arango::AqlTransaction* trx,
+                                   TRI_document_collection_t const* collection,
+                                   AqlValue const parameters) {
+  double timestamp;
+
+  if (! MakeDate(query, trx, collection, parameters, "DATE_TIMESTAMP", timestamp)) {
+    RegisterWarning(query, "DATE_TIMESTAMP", TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return NumericValue(timestamp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_ISO8601
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateIso8601 (triagens::aql::Query* query,
+                                 triagens::arango::AqlTransaction* trx,
+                                 TRI_document_collection_t const* collection,
+                                 AqlValue const parameters) {
+  double timestamp;
+
+  if (! MakeDate(query, trx, collection, parameters, "DATE_ISO8601", timestamp) ||
+      std::isnan(timestamp)) {
+    RegisterWarning(query, "DATE_ISO8601", TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  int64_t year, month, day, weekday, millisecondOfDay;
+  SplitTimestamp(timestamp, year, month, day, weekday, millisecondOfDay);
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 32);
+
+  if (year >= 0 && year <= 9999) {
+    buffer.appendInteger4(static_cast<uint32_t>(year));
+  }
+  else {
+    // extended year format
+    buffer.appendChar(year < 0 ? '-' : '+');
+    buffer.appendInteger2(static_cast<uint32_t>(std::abs(year) / 10000));
+    buffer.appendInteger4(static_cast<uint32_t>(std::abs(year) % 10000));
+  }
+
+  buffer.appendChar('-');
+  buffer.appendInteger2(static_cast<uint32_t>(month));
+  buffer.appendChar('-');
+  buffer.appendInteger2(static_cast<uint32_t>(day));
+  buffer.appendChar('T');
+  buffer.appendInteger2(static_cast<uint32_t>(millisecondOfDay / 3600000));
+  buffer.appendChar(':');
+  buffer.appendInteger2(static_cast<uint32_t>((millisecondOfDay / 60000) % 60));
+  buffer.appendChar(':');
+  buffer.appendInteger2(static_cast<uint32_t>((millisecondOfDay / 1000) % 60));
+  buffer.appendChar('.');
+  buffer.appendInteger3(static_cast<uint32_t>(millisecondOfDay % 1000));
+  buffer.appendChar('Z');
+
+  return StringValue(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_DAYOFWEEK
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateDayOfWeek (triagens::aql::Query* query,
+                                   triagens::arango::AqlTransaction* trx,
+                                   TRI_document_collection_t const* collection,
+                                   AqlValue const parameters) {
+  return ExtractDateComponent(query, trx, collection, parameters, "DATE_DAYOFWEEK", DATE_COMPONENT_DAYOFWEEK);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_YEAR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateYear (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  return ExtractDateComponent(query, trx, collection, parameters, "DATE_YEAR", DATE_COMPONENT_YEAR);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_MONTH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateMonth (triagens::aql::Query* query,
+                               triagens::arango::AqlTransaction* trx,
+                               TRI_document_collection_t const* collection,
+                               AqlValue const parameters) {
+  return ExtractDateComponent(query, trx, collection, parameters, "DATE_MONTH", DATE_COMPONENT_MONTH);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_DAY
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateDay (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  return ExtractDateComponent(query, trx, collection, parameters, "DATE_DAY", DATE_COMPONENT_DAY);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_HOUR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateHour (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  return ExtractDateComponent(query, trx, collection, parameters, "DATE_HOUR", DATE_COMPONENT_HOUR);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_MINUTE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateMinute (triagens::aql::Query* query,
+                                triagens::arango::AqlTransaction* trx,
+                                TRI_document_collection_t const* collection,
+                                AqlValue const parameters) {
+  return ExtractDateComponent(query, trx, collection, parameters, "DATE_MINUTE", DATE_COMPONENT_MINUTE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_SECOND
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateSecond (triagens::aql::Query* query,
+                                triagens::arango::AqlTransaction* trx,
+                                TRI_document_collection_t const* collection,
+                                AqlValue const parameters) {
+  return ExtractDateComponent(query, trx, collection, parameters, "DATE_SECOND", DATE_COMPONENT_SECOND);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_MILLISECOND
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateMillisecond (triagens::aql::Query* query,
+                                     triagens::arango::AqlTransaction* trx,
+                                     TRI_document_collection_t const* collection,
+                                     AqlValue const parameters) {
+  return ExtractDateComponent(query, trx, collection, parameters, "DATE_MILLISECOND", DATE_COMPONENT_MILLISECOND);
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -493,6 +493,14 @@ void Optimizer::setupRules () {
                removeUnnecessaryFiltersRule,
                removeUnnecessaryFiltersRule_pass5,
                true);
+
+  if (! triagens::arango::ServerState::instance()->isCoordinator()) {
+    // replace FOR ... IN TRAVERSAL(...) with a native traversal
+    registerRule("use-native-traversal",
+                 useNativeTraversalRule,
+                 useNativeTraversalRule_pass5,
+                 true);
+  }
   
   // remove redundant sort node
   registerRule("remove-redundant-sorts-2",
@@ -582,6 +590,18 @@ void Optimizer::setupRules () {
                moveCalculationsDownRule_pass9,
                true);
 
+  // make SORT only produce the rows needed by a following LIMIT
+  registerRule("sort-limit",
+               applySortLimitRule,
+               applySortLimitRule_pass9,
+               true);
+
+  // extract only the used attributes of documents
+  registerRule("reduce-extraction-to-projection",
+               reduceExtractionToProjectionRule,
+               reduceExtractionToProjectionRule_pass9,
+               true);
+
   if (triagens::arango::ServerState::instance()->isCoordinator()) {
     // distribute operations in cluster
     registerRule("scatter-in-cluster",
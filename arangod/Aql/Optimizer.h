@@ -150,6 +150,9 @@ namespace triagens {
         pass5                                         = 700,
         removeUnnecessaryFiltersRule_pass5            = 710,
 
+        // replace FOR ... IN TRAVERSAL(...) with a native traversal
+        useNativeTraversalRule_pass5                  = 715,
+
         // remove redundant sort blocks
         removeRedundantSortsRule_pass5                = 720,
 
@@ -198,6 +201,14 @@ namespace triagens {
 
         moveCalculationsDownRule_pass9                = 900,
 
+        // restrict SORT operations followed by a LIMIT to the first 
+        // offset + count rows (top-k sort)
+        applySortLimitRule_pass9                      = 910,
+
+        // make collection and index scans only produce the attributes that
+        // are used later
+        reduceExtractionToProjectionRule_pass9        = 920,
+
 //////////////////////////////////////////////////////////////////////////////
 /// "Pass 10": final transformations for the cluster
 //////////////////////////////////////////////////////////////////////////////
@@ -145,7 +145,8 @@ int triagens::aql::removeRedundantSortsRule (Optimizer* opt,
           }
         }
         else if (current->getType() == EN::ENUMERATE_LIST ||
-                 current->getType() == EN::ENUMERATE_COLLECTION) {
+                 current->getType() == EN::ENUMERATE_COLLECTION ||
+                 current->getType() == EN::TRAVERSAL) {
           // ok, but we cannot remove two different sorts if one of these node types is between them
           // example: in the following query, the one sort will be optimized away:
           //   FOR i IN [ { a: 1 }, { a: 2 } , { a: 3 } ] SORT i.a ASC SORT i.a DESC RETURN i
@@ -847,9 +848,10 @@ int triagens::aql::removeSortRandRule (Optimizer* opt,
         case EN::FILTER: 
         case EN::SUBQUERY:
         case EN::ENUMERATE_LIST:
+        case EN::TRAVERSAL:
         case EN::INDEX_RANGE: {
           // if we found another SortNode, an AggregateNode, FilterNode, a SubqueryNode, 
-          // an EnumerateListNode or an IndexRangeNode
+          // an EnumerateListNode, a TraversalNode or an IndexRangeNode
           // this means we cannot apply our optimization
           collectionNode = nullptr;
           current = nullptr;
@@ -1056,6 +1058,7 @@ int triagens::aql::moveCalculationsDownRule (Optimizer* opt,
       else if (currentType == EN::INDEX_RANGE ||
                currentType == EN::ENUMERATE_COLLECTION ||
                currentType == EN::ENUMERATE_LIST ||
+               currentType == EN::TRAVERSAL ||
                currentType == EN::AGGREGATE ||
                currentType == EN::NORESULTS) {
         // we will not push further down than such nodes
@@ -1093,6 +1096,67 @@ int triagens::aql::moveCalculationsDownRule (Optimizer* opt,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restrict a SORT that is followed by a LIMIT to the first 
+/// offset + count rows
+/// this rule modifies the plan in place
+/// the SortBlock will then keep only a bounded number of rows instead of 
+/// buffering and sorting its complete input
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::applySortLimitRule (Optimizer* opt, 
+                                       ExecutionPlan* plan, 
+                                       Optimizer::Rule const* rule) {
+  std::vector<ExecutionNode*> nodes = plan->findNodesOfType(EN::LIMIT, true);
+  bool modified = false;
+  
+  for (auto n : nodes) {
+    auto limitNode = static_cast<LimitNode*>(n);
+
+    if (limitNode->fullCount()) {
+      // fullCount needs to see all rows
+      continue;
+    }
+
+    size_t const keep = limitNode->offset() + limitNode->limit();
+
+    if (keep == 0 || keep < limitNode->offset()) {
+      // nothing to keep, or overflow
+      continue;
+    }
+
+    auto deps = n->getDependencies();
+
+    while (deps.size() == 1) {
+      auto current = deps[0];
+      auto const currentType = current->getType();
+
+      if (currentType == EN::SORT) {
+        auto sortNode = static_cast<SortNode*>(current);
+
+        if (sortNode->limit() == 0 || keep < sortNode->limit()) {
+          sortNode->setLimit(keep);
+          modified = true;
+        }
+        break;
+      }
+
+      if (currentType != EN::CALCULATION ||
+          static_cast<CalculationNode*>(current)->expression()->canThrow()) {
+        // only calculations that do not throw can be bypassed. all other
+        // nodes might change the number of rows
+        break;
+      }
+
+      deps = current->getDependencies();
+    }
+  }
+  
+  opt->addPlan(plan, rule, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief determine the "right" type of AggregateNode and 
 /// add a sort node for each COLLECT (note: the sort may be removed later) 
@@ -1385,6 +1449,11 @@ class triagens::aql::RedundantCalculationsReplacer : public WalkerWorker<Executi
           replaceInVariable<EnumerateListNode>(en);
           break;
         }
+
+        case EN::TRAVERSAL: {
+          replaceInVariable<TraversalNode>(en);
+          break;
+        }
       
         case EN::RETURN: {
           replaceInVariable<ReturnNode>(en);
@@ -1403,9 +1472,12 @@ class triagens::aql::RedundantCalculationsReplacer : public WalkerWorker<Executi
 
         case EN::AGGREGATE: {
           auto node = static_cast<AggregateNode*>(en);
-          for (auto variable : node->_aggregateVariables) {
+          for (auto& variable : node->_aggregateVariables) {
             variable.second = Variable::replace(variable.second, _replacements);
           }
+          for (auto& function : node->_aggregateFunctions) {
+            function.second.first = Variable::replace(function.second.first, _replacements);
+          }
           break;
         }
 
@@ -1963,6 +2035,7 @@ class FilterToEnumCollFinder : public WalkerWorker<ExecutionNode> {
 
       switch (en->getType()) {
         case EN::ENUMERATE_LIST:
+        case EN::TRAVERSAL:
           break;
 
         case EN::CALCULATION: {
@@ -2713,7 +2786,8 @@ class SortToIndexNode : public WalkerWorker<ExecutionNode> {
 
         if (node->getType() == EN::ENUMERATE_COLLECTION ||
             node->getType() == EN::INDEX_RANGE ||
-            node->getType() == EN::ENUMERATE_LIST) {
+            node->getType() == EN::ENUMERATE_LIST ||
+            node->getType() == EN::TRAVERSAL) {
           // we are contained in an outer loop
           return true;
 
@@ -2818,6 +2892,7 @@ class SortToIndexNode : public WalkerWorker<ExecutionNode> {
     bool before (ExecutionNode* en) override final {
       switch (en->getType()) {
       case EN::ENUMERATE_LIST:
+      case EN::TRAVERSAL:
       case EN::CALCULATION:
       case EN::SUBQUERY:
       case EN::FILTER:
@@ -3636,6 +3711,7 @@ int triagens::aql::distributeFilternCalcToClusterRule (Optimizer* opt,
 
       switch (inspectNode->getType()) {
         case EN::ENUMERATE_LIST:
+        case EN::TRAVERSAL:
         case EN::SINGLETON:
         case EN::INSERT:
         case EN::REMOVE:
@@ -3732,6 +3808,7 @@ int triagens::aql::distributeSortToClusterRule (Optimizer* opt,
 
       switch (inspectNode->getType()) {
         case EN::ENUMERATE_LIST:
+        case EN::TRAVERSAL:
         case EN::SINGLETON:
         case EN::AGGREGATE:
         case EN::INSERT:
@@ -4015,6 +4092,7 @@ class RemoveToEnumCollFinder : public WalkerWorker<ExecutionNode> {
         }
         case EN::SINGLETON:
         case EN::ENUMERATE_LIST:
+        case EN::TRAVERSAL:
         case EN::SUBQUERY:        
         case EN::AGGREGATE:
         case EN::INSERT:
@@ -4534,6 +4612,446 @@ int triagens::aql::removeDataModificationOutVariablesRule (Optimizer* opt,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a FILTER condition on the vertex of a traversal
+////////////////////////////////////////////////////////////////////////////////
+
+struct VertexConditionPart {
+  std::vector<std::string> attribute;
+  std::string op;
+  std::unique_ptr<TRI_json_t, void (*)(TRI_json_t*)> value;
+
+  VertexConditionPart ()
+    : value(nullptr, [] (TRI_json_t* json) { TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json); }) {
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the attribute path of an access to variable.vertex.<path>.
+/// the leading "vertex" is not part of the result
+////////////////////////////////////////////////////////////////////////////////
+
+static bool GetVertexAttributePath (AstNode const* node,
+                                    Variable const* variable,
+                                    std::vector<std::string>& path) {
+  path.clear();
+
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    path.emplace_back(node->getStringValue());
+    node = node->getMember(0);
+  }
+
+  if (node->type != NODE_TYPE_REFERENCE ||
+      static_cast<Variable const*>(node->getData()) != variable ||
+      path.size() < 2 ||
+      path.back() != "vertex") {
+    return false;
+  }
+
+  path.pop_back();
+  std::reverse(path.begin(), path.end());
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect the comparisons of a FILTER condition that the traversal
+/// can evaluate on its own. returns false if any part of the condition is
+/// something else, in which case the FILTER must stay where it is
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CollectVertexConditions (AstNode const* node,
+                                     Variable const* variable,
+                                     std::vector<VertexConditionPart>& parts) {
+  if (node->type == NODE_TYPE_OPERATOR_BINARY_AND) {
+    return CollectVertexConditions(node->getMember(0), variable, parts) &&
+           CollectVertexConditions(node->getMember(1), variable, parts);
+  }
+
+  auto type = node->type;
+
+  if (type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+      type != NODE_TYPE_OPERATOR_BINARY_NE &&
+      type != NODE_TYPE_OPERATOR_BINARY_LT &&
+      type != NODE_TYPE_OPERATOR_BINARY_LE &&
+      type != NODE_TYPE_OPERATOR_BINARY_GT &&
+      type != NODE_TYPE_OPERATOR_BINARY_GE &&
+      type != NODE_TYPE_OPERATOR_BINARY_IN) {
+    return false;
+  }
+
+  auto lhs = node->getMember(0);
+  auto rhs = node->getMember(1);
+
+  VertexConditionPart part;
+
+  if (! GetVertexAttributePath(lhs, variable, part.attribute)) {
+    if (type == NODE_TYPE_OPERATOR_BINARY_IN ||
+        ! GetVertexAttributePath(rhs, variable, part.attribute)) {
+      return false;
+    }
+    // constant on the left side
+    std::swap(lhs, rhs);
+    type = Ast::ReverseOperator(type);
+  }
+
+  if (! rhs->isConstant()) {
+    return false;
+  }
+
+  switch (type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+      part.op = "==";
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+      part.op = "!=";
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+      part.op = "<";
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+      part.op = "<=";
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+      part.op = ">";
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      part.op = ">=";
+      break;
+    default:
+      part.op = "IN";
+      break;
+  }
+
+  part.value.reset(rhs->toJsonValue(TRI_UNKNOWN_MEM_ZONE));
+
+  if (part.value == nullptr ||
+      (part.op == "IN" && ! TRI_IsArrayJson(part.value.get()))) {
+    // a non-array right-hand side of IN is left to the FILTER
+    return false;
+  }
+
+  parts.emplace_back(std::move(part));
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief move FILTERs on the vertex of a traversal into the TraversalNode
+/// FILTERs are only moved if they follow the TraversalNode directly or with
+/// deterministic calculations in between, and if their conditions only
+/// compare attributes of the vertex with constants
+////////////////////////////////////////////////////////////////////////////////
+
+static void PushFiltersIntoTraversal (ExecutionPlan* plan,
+                                      TraversalNode* traversalNode,
+                                      Variable const* outVariable) {
+  ExecutionNode* current = traversalNode;
+
+  while (true) {
+    auto parents = current->getParents();
+
+    if (parents.size() != 1) {
+      break;
+    }
+
+    current = parents[0];
+
+    if (current->getType() == EN::CALCULATION) {
+      if (! static_cast<CalculationNode*>(current)->expression()->isDeterministic()) {
+        break;
+      }
+      continue;
+    }
+
+    if (current->getType() != EN::FILTER) {
+      break;
+    }
+
+    auto setter = plan->getVarSetBy(current->getVariablesUsedHere()[0]->id);
+
+    if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+      continue;
+    }
+
+    std::vector<VertexConditionPart> parts;
+
+    if (! CollectVertexConditions(static_cast<CalculationNode*>(setter)->expression()->node(), outVariable, parts)) {
+      continue;
+    }
+
+    for (auto const& part : parts) {
+      if (! traversalNode->options().addVertexCondition(part.attribute, part.op, part.value.get())) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+      }
+    }
+
+    // the calculation of the condition is now unused and will be removed by
+    // remove-unnecessary-calculations-2
+    auto filter = current;
+    current = current->getDependencies()[0];
+    plan->unlinkNode(filter);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace FOR x IN TRAVERSAL(...) with a native TraversalNode if the
+/// traversal options are constant and supported natively
+/// simple FILTERs on the vertex are moved into the TraversalNode
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::useNativeTraversalRule (Optimizer* opt, 
+                                           ExecutionPlan* plan, 
+                                           Optimizer::Rule const* rule) {
+  bool modified = false;
+  std::vector<ExecutionNode*> nodes = plan->findNodesOfType(EN::ENUMERATE_LIST, true);
+  
+  for (auto n : nodes) {
+    auto inVariable = n->getVariablesUsedHere()[0];
+    auto setter = plan->getVarSetBy(inVariable->id);
+
+    if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+      continue;
+    }
+
+    auto expression = static_cast<CalculationNode*>(setter)->expression();
+
+    if (expression == nullptr ||
+        expression->node() == nullptr ||
+        expression->node()->type != NODE_TYPE_FCALL) {
+      continue;
+    }
+
+    auto fcall = expression->node();
+    auto func = static_cast<Function const*>(fcall->getData());
+
+    if (func->externalName != "TRAVERSAL") {
+      continue;
+    }
+
+    auto args = fcall->getMember(0);
+    size_t const n_args = args->numMembers();
+
+    if (n_args < 4 || n_args > 5) {
+      continue;
+    }
+
+    auto vertexArg = args->getMember(0);
+    auto edgeArg = args->getMember(1);
+    auto startArg = args->getMember(2);
+    auto directionArg = args->getMember(3);
+
+    if (vertexArg->type != NODE_TYPE_COLLECTION ||
+        edgeArg->type != NODE_TYPE_COLLECTION ||
+        ! directionArg->isStringValue()) {
+      continue;
+    }
+
+    auto collections = plan->getAst()->query()->collections();
+    auto vertexCollection = collections->get(vertexArg->getStringValue());
+    auto edgeCollection = collections->get(edgeArg->getStringValue());
+
+    if (vertexCollection == nullptr ||
+        edgeCollection == nullptr ||
+        ! edgeCollection->isEdgeCollection()) {
+      // let the JavaScript implementation produce the error
+      continue;
+    }
+
+    TRI_edge_direction_e direction;
+    if (! TraversalNode::directionFromString(directionArg->getStringValue(), direction)) {
+      continue;
+    }
+
+    TraversalOptions options;
+
+    if (n_args == 5) {
+      auto params = args->getMember(4);
+
+      if (! params->isConstant()) {
+        continue;
+      }
+
+      std::unique_ptr<TRI_json_t, void (*)(TRI_json_t*)> json(params->toJsonValue(TRI_UNKNOWN_MEM_ZONE),
+                                                               [] (TRI_json_t* json) { TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json); });
+
+      if (json == nullptr || ! options.parse(json.get())) {
+        // e.g. visitor or filter functions
+        continue;
+      }
+    }
+
+    // the start vertex needs to be in a variable
+    Variable const* startVariable = nullptr;
+
+    if (startArg->type == NODE_TYPE_REFERENCE) {
+      startVariable = static_cast<Variable const*>(startArg->getData());
+    }
+    else {
+      auto outVar = plan->getAst()->variables()->createTemporaryVariable();
+      auto startExpression = new Expression(plan->getAst(), startArg);
+      ExecutionNode* calculationNode = nullptr;
+
+      try {
+        calculationNode = new CalculationNode(plan, plan->nextId(), startExpression, outVar);
+      }
+      catch (...) {
+        delete startExpression;
+        throw;
+      }
+      plan->registerNode(calculationNode);
+      plan->insertDependency(n, calculationNode);
+      startVariable = outVar;
+    }
+
+    auto traversalNode = new TraversalNode(plan, 
+                                           plan->nextId(), 
+                                           plan->getAst()->query()->vocbase(),
+                                           vertexCollection,
+                                           edgeCollection,
+                                           startVariable,
+                                           n->getVariablesSetHere()[0],
+                                           direction,
+                                           options);
+    plan->registerNode(traversalNode);
+    plan->replaceNode(n, traversalNode);
+
+    PushFiltersIntoTraversal(plan, traversalNode, traversalNode->getVariablesSetHere()[0]);
+
+    // the calculation of TRAVERSAL() is now unused and will be removed by
+    // remove-unnecessary-calculations-2
+    modified = true;
+  }
+  
+  if (modified) {
+    plan->findVarUsage();
+  }
+  
+  opt->addPlan(plan, rule, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collects all nodes of a plan, including the nodes of subqueries
+////////////////////////////////////////////////////////////////////////////////
+
+class AllNodesFinder : public WalkerWorker<ExecutionNode> {
+
+  public:
+
+    std::vector<ExecutionNode*> nodes;
+
+    bool before (ExecutionNode* en) override final {
+      nodes.emplace_back(en);
+      return false;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect the top-level attributes of a variable that are used in an
+/// expression. returns false if the variable is used in any other way than
+/// for accessing an attribute, e.g. when it is returned or passed to a
+/// function as a whole
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CollectProjectedAttributes (AstNode const* node,
+                                        Variable const* variable,
+                                        std::unordered_set<std::string>& attributes) {
+  if (node == nullptr) {
+    return true;
+  }
+
+  if (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    auto sub = node->getMember(0);
+
+    if (sub->type == NODE_TYPE_REFERENCE &&
+        static_cast<Variable const*>(sub->getData()) == variable) {
+      // variable.attribute
+      attributes.emplace(node->getStringValue());
+      return true;
+    }
+  }
+  else if (node->type == NODE_TYPE_REFERENCE) {
+    // the variable itself is used
+    return (static_cast<Variable const*>(node->getData()) != variable);
+  }
+
+  size_t const n = node->numMembers();
+
+  for (size_t i = 0; i < n; ++i) {
+    if (! CollectProjectedAttributes(node->getMember(i), variable, attributes)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reduce the documents produced by collection and index scans to the
+/// attributes that are actually used later
+/// this rule modifies the plan in place
+/// it can only be applied if the document variable is used for attribute
+/// accesses only. the scans will then produce objects with just these
+/// attributes, extracted once per document, instead of the complete documents
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::reduceExtractionToProjectionRule (Optimizer* opt, 
+                                                     ExecutionPlan* plan, 
+                                                     Optimizer::Rule const* rule) {
+  std::vector<ExecutionNode*> nodes = plan->findNodesOfType({ EN::ENUMERATE_COLLECTION, EN::INDEX_RANGE }, true);
+  bool modified = false;
+
+  if (! nodes.empty()) {
+    AllNodesFinder finder;
+    plan->root()->walk(&finder);
+
+    for (auto n : nodes) {
+      auto const variable = n->getVariablesSetHere()[0];
+      std::unordered_set<std::string> attributes;
+      bool valid = true;
+
+      for (auto other : finder.nodes) {
+        if (other == n || other->getType() == EN::SUBQUERY) {
+          // the nodes inside subqueries are inspected separately
+          continue;
+        }
+
+        auto const used = other->getVariablesUsedHere();
+
+        if (std::find(used.begin(), used.end(), variable) == used.end()) {
+          continue;
+        }
+
+        if (other->getType() != EN::CALCULATION ||
+            ! CollectProjectedAttributes(static_cast<CalculationNode*>(other)->expression()->node(), variable, attributes)) {
+          // the complete document is needed
+          valid = false;
+          break;
+        }
+      }
+
+      if (! valid || attributes.empty()) {
+        continue;
+      }
+
+      std::vector<std::string> projections(attributes.begin(), attributes.end());
+      std::sort(projections.begin(), projections.end());
+
+      if (n->getType() == EN::ENUMERATE_COLLECTION) {
+        static_cast<EnumerateCollectionNode*>(n)->setProjections(projections);
+      }
+      else {
+        static_cast<IndexRangeNode*>(n)->setProjections(projections);
+      }
+      modified = true;
+    }
+  }
+
+  opt->addPlan(plan, rule, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 // Local Variables:
 // mode: outline-minor
 // outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
@@ -98,6 +98,21 @@ namespace triagens {
 
     int moveCalculationsDownRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restrict a SORT that is followed by a LIMIT to the first 
+/// offset + count rows
+/// this rule modifies the plan in place
+////////////////////////////////////////////////////////////////////////////////
+
+    int applySortLimitRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reduce the documents produced by collection and index scans to the
+/// attributes that are actually used later
+////////////////////////////////////////////////////////////////////////////////
+
+    int reduceExtractionToProjectionRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief determine the "right" type of AggregateNode and 
 /// add a sort node for each COLLECT (may be removed later) 
@@ -237,6 +252,12 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
     int removeDataModificationOutVariablesRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace FOR ... IN TRAVERSAL(...) with a native TraversalNode
+////////////////////////////////////////////////////////////////////////////////
+
+    int useNativeTraversalRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
     
   }  // namespace aql
 }  // namespace triagens
@@ -0,0 +1,751 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, cache for optimized execution plans
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/PlanCache.h"
+#include "Aql/AstNode.h"
+#include "Basics/Exceptions.h"
+#include "Basics/JsonHelper.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+
+using namespace triagens::aql;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prefix of string placeholders
+////////////////////////////////////////////////////////////////////////////////
+
+static char const PlaceholderPrefix[] = "\x1f" "plan-cache-placeholder:";
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a placeholder and the bind parameter value it stands for
+////////////////////////////////////////////////////////////////////////////////
+
+struct Placeholder {
+  std::string       name;
+  TRI_json_t const* value;
+  std::string       string;
+  double            number;
+  bool              found;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the value of a templated bind parameter is replaced
+/// by a placeholder
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool UsesPlaceholder (std::string const& name,
+                                    TRI_json_t const* value,
+                                    std::unordered_set<std::string> const& templated) {
+  return ((TRI_IsStringJson(value) || TRI_IsNumberJson(value)) &&
+          templated.find(name) != templated.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the placeholders for the bind parameters. the placeholders
+/// only depend on the names and types of the templated parameters
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<Placeholder> BuildPlaceholders (BindParametersType const& parameters,
+                                                   std::unordered_set<std::string> const& templated) {
+  std::vector<std::string> names;
+
+  for (auto const& it : parameters) {
+    if (UsesPlaceholder(it.first, it.second.first, templated)) {
+      names.emplace_back(it.first);
+    }
+  }
+
+  std::sort(names.begin(), names.end());
+
+  std::vector<Placeholder> placeholders;
+  placeholders.reserve(names.size());
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    Placeholder placeholder;
+    placeholder.name   = names[i];
+    placeholder.value  = (*parameters.find(names[i])).second.first;
+    placeholder.string = std::string(PlaceholderPrefix) + names[i];
+    // a tiny number that no plan will contain otherwise
+    placeholder.number = -1.0e-300 * static_cast<double>(i + 1);
+    placeholder.found  = false;
+
+    placeholders.emplace_back(placeholder);
+  }
+
+  return placeholders;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the placeholder a JSON value is equal to, or a nullptr
+////////////////////////////////////////////////////////////////////////////////
+
+static Placeholder* FindPlaceholder (TRI_json_t const* json,
+                                     std::vector<Placeholder>& placeholders) {
+  if (TRI_IsStringJson(json)) {
+    size_t const length = json->_value._string.length - 1;
+    size_t const prefixLength = sizeof(PlaceholderPrefix) - 1;
+
+    if (length <= prefixLength ||
+        memcmp(json->_value._string.data, PlaceholderPrefix, prefixLength) != 0) {
+      return nullptr;
+    }
+
+    for (auto& placeholder : placeholders) {
+      if (TRI_IsStringJson(placeholder.value) &&
+          placeholder.string.size() == length &&
+          memcmp(placeholder.string.c_str(), json->_value._string.data, length) == 0) {
+        return &placeholder;
+      }
+    }
+  }
+  else if (TRI_IsNumberJson(json)) {
+    for (auto& placeholder : placeholders) {
+      if (TRI_IsNumberJson(placeholder.value) &&
+          placeholder.number == json->_value._number) {
+        return &placeholder;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the placeholders in a plan, and optionally replace them with
+/// the bind parameter values
+////////////////////////////////////////////////////////////////////////////////
+
+static void VisitPlaceholders (TRI_json_t* json,
+                               std::vector<Placeholder>& placeholders,
+                               bool fill) {
+  switch (json->_type) {
+    case TRI_JSON_OBJECT: {
+      size_t const n = TRI_LengthVector(&json->_value._objects);
+
+      // only look at the values, not at the keys
+      for (size_t i = 1; i < n; i += 2) {
+        VisitPlaceholders(static_cast<TRI_json_t*>(TRI_AtVector(&json->_value._objects, i)), placeholders, fill);
+      }
+      break;
+    }
+
+    case TRI_JSON_ARRAY: {
+      size_t const n = TRI_LengthVector(&json->_value._objects);
+
+      for (size_t i = 0; i < n; ++i) {
+        VisitPlaceholders(static_cast<TRI_json_t*>(TRI_AtVector(&json->_value._objects, i)), placeholders, fill);
+      }
+      break;
+    }
+
+    case TRI_JSON_NUMBER:
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE: {
+      auto placeholder = FindPlaceholder(json, placeholders);
+
+      if (placeholder != nullptr) {
+        placeholder->found = true;
+
+        if (fill) {
+          TRI_DestroyJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+          if (TRI_CopyToJson(TRI_UNKNOWN_MEM_ZONE, json, placeholder->value) != TRI_ERROR_NO_ERROR) {
+            // leave a valid value behind
+            TRI_InitNullJson(json);
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+          }
+        }
+      }
+      break;
+    }
+
+    default: {
+      break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the key for the shapes of the bind parameters. templated
+/// parameters contribute their type, all others their value
+////////////////////////////////////////////////////////////////////////////////
+
+static std::string ShapeKey (BindParametersType const& parameters,
+                             std::unordered_set<std::string> const& templated) {
+  std::vector<std::string> names;
+  names.reserve(parameters.size());
+
+  for (auto const& it : parameters) {
+    names.emplace_back(it.first);
+  }
+
+  std::sort(names.begin(), names.end());
+
+  std::string key;
+
+  for (auto const& name : names) {
+    auto value = (*parameters.find(name)).second.first;
+
+    key.append(name);
+    key.push_back('=');
+
+    if (! UsesPlaceholder(name, value, templated)) {
+      key.append(triagens::basics::JsonHelper::toString(value));
+    }
+    else if (TRI_IsStringJson(value)) {
+      key.append("<string>");
+    }
+    else {
+      key.append("<number>");
+    }
+
+    key.push_back('\n');
+  }
+
+  return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a node is a comparison
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool IsComparison (AstNode const* node) {
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+    case NODE_TYPE_OPERATOR_BINARY_IN:
+    case NODE_TYPE_OPERATOR_BINARY_NIN:
+      return true;
+    default:
+      return false;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the name of the value bind parameter a node refers to
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool ValueParameterName (AstNode const* node,
+                                       std::string& name) {
+  if (node->type != NODE_TYPE_PARAMETER) {
+    return false;
+  }
+
+  char const* value = node->getStringValue();
+
+  if (value == nullptr || *value == '@') {
+    // collection parameter
+    return false;
+  }
+
+  name = value;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the attribute name of an attribute access on a variable,
+/// e.g. "a.b" for "doc.a.b". the variable itself is ignored so that aliases
+/// of the same attribute are not told apart
+////////////////////////////////////////////////////////////////////////////////
+
+static bool AttributeName (AstNode const* node,
+                           std::string& name) {
+  if (node->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+    return false;
+  }
+
+  std::string result;
+
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    char const* attribute = node->getStringValue();
+
+    if (attribute == nullptr) {
+      return false;
+    }
+
+    if (result.empty()) {
+      result = attribute;
+    }
+    else {
+      result = std::string(attribute) + "." + result;
+    }
+
+    node = node->getMember(0);
+  }
+
+  if (node->type != NODE_TYPE_REFERENCE) {
+    return false;
+  }
+
+  name = result;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                             struct PlanCacheEntry
+// -----------------------------------------------------------------------------
+
+PlanCacheEntry::PlanCacheEntry (std::unordered_set<std::string> const& templated)
+  : templated(templated),
+    plans() {
+}
+
+PlanCacheEntry::~PlanCacheEntry () {
+  for (auto& it : plans) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.second);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   class PlanCache
+// -----------------------------------------------------------------------------
+
+size_t const PlanCache::MaxPlans = 1024;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+PlanCache::PlanCache ()
+  : _lock(),
+    _entries(),
+    _numberOfPlans(0),
+    _generation(0),
+    _hits(0),
+    _misses(0),
+    _invalidations(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+PlanCache::~PlanCache () {
+  WRITE_LOCKER(_lock);
+  clear();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of plans in the cache
+////////////////////////////////////////////////////////////////////////////////
+
+size_t PlanCache::size () {
+  READ_LOCKER(_lock);
+  return _numberOfPlans;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a plan
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* PlanCache::lookup (std::string const& key,
+                               BindParametersType const& parameters) {
+  {
+    READ_LOCKER(_lock);
+
+    auto it = _entries.find(key);
+
+    if (it != _entries.end()) {
+      auto entry = (*it).second;
+      auto it2 = entry->plans.find(ShapeKey(parameters, entry->templated));
+
+      if (it2 != entry->plans.end()) {
+        TRI_json_t* plan = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, (*it2).second);
+
+        if (plan == nullptr) {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+        }
+
+        try {
+          fillPlaceholders(plan, parameters, entry->templated);
+        }
+        catch (...) {
+          TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, plan);
+          throw;
+        }
+
+        ++_hits;
+        return plan;
+      }
+    }
+  }
+
+  ++_misses;
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store a plan with placeholders
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::store (std::string const& key,
+                       std::unordered_set<std::string> const& templated,
+                       BindParametersType const& parameters,
+                       TRI_json_t* plan,
+                       uint64_t generation) {
+  TRI_ASSERT(plan != nullptr);
+
+  try {
+    std::string const shape = ShapeKey(parameters, templated);
+
+    WRITE_LOCKER(_lock);
+
+    if (generation != _generation.load()) {
+      // collections or indexes have changed while the plan was created
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, plan);
+      return;
+    }
+
+    if (_numberOfPlans >= MaxPlans) {
+      clear();
+    }
+
+    PlanCacheEntry* entry;
+    auto it = _entries.find(key);
+
+    if (it == _entries.end()) {
+      std::unique_ptr<PlanCacheEntry> created(new PlanCacheEntry(templated));
+      _entries.emplace(key, created.get());
+      entry = created.release();
+    }
+    else {
+      entry = (*it).second;
+
+      if (entry->templated != templated) {
+        // the plans of the entry were created with other placeholders
+        _numberOfPlans -= entry->plans.size();
+
+        for (auto& it2 : entry->plans) {
+          TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it2.second);
+        }
+        entry->plans.clear();
+        entry->templated = templated;
+      }
+    }
+
+    auto it2 = entry->plans.find(shape);
+
+    if (it2 != entry->plans.end()) {
+      // another thread was faster
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, (*it2).second);
+      (*it2).second = plan;
+    }
+    else {
+      entry->plans.emplace(shape, plan);
+      ++_numberOfPlans;
+    }
+  }
+  catch (...) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, plan);
+    throw;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::invalidate () {
+  WRITE_LOCKER(_lock);
+
+  ++_generation;
+  ++_invalidations;
+  clear();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                             public static methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the cache key for a query string and its options
+////////////////////////////////////////////////////////////////////////////////
+
+std::string PlanCache::buildKey (char const* queryString,
+                                 size_t length,
+                                 TRI_json_t const* options) {
+  enum {
+    STATE_DEFAULT,
+    STATE_STRING,
+    STATE_COMMENT_SINGLE,
+    STATE_COMMENT_MULTI
+  } state = STATE_DEFAULT;
+
+  std::string normalized;
+  normalized.reserve(length);
+
+  char const* p = queryString;
+  char const* end = queryString + length;
+  char quote = '\0';
+  bool whitespace = false;
+
+  while (p < end) {
+    char const c = *p;
+
+    if (state == STATE_DEFAULT) {
+      if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+        whitespace = true;
+        ++p;
+        continue;
+      }
+
+      if (whitespace && ! normalized.empty()) {
+        normalized.push_back(' ');
+      }
+      whitespace = false;
+
+      if (c == '\'' || c == '"' || c == '`') {
+        state = STATE_STRING;
+        quote = c;
+      }
+      else if (c == '/' && p + 1 < end && (p[1] == '/' || p[1] == '*')) {
+        state = (p[1] == '/' ? STATE_COMMENT_SINGLE : STATE_COMMENT_MULTI);
+        normalized.append(p, 2);
+        p += 2;
+        continue;
+      }
+    }
+    else if (state == STATE_STRING) {
+      if (c == '\\' && p + 1 < end) {
+        normalized.append(p, 2);
+        p += 2;
+        continue;
+      }
+      if (c == quote) {
+        state = STATE_DEFAULT;
+      }
+    }
+    else if (state == STATE_COMMENT_SINGLE) {
+      if (c == '\n') {
+        state = STATE_DEFAULT;
+      }
+    }
+    else if (c == '*' && p + 1 < end && p[1] == '/') {
+      state = STATE_DEFAULT;
+      normalized.append(p, 2);
+      p += 2;
+      continue;
+    }
+
+    normalized.push_back(c);
+    ++p;
+  }
+
+  std::string key(std::to_string(normalized.size()));
+  key.push_back(':');
+  key.append(normalized);
+
+  if (options != nullptr) {
+    key.append(triagens::basics::JsonHelper::toString(options));
+  }
+
+  return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the bind parameters that can be replaced by placeholders
+////////////////////////////////////////////////////////////////////////////////
+
+std::unordered_set<std::string> PlanCache::findTemplatable (AstNode const* root) {
+  // number of uses per bind parameter
+  std::unordered_map<std::string, size_t> uses;
+  // attribute per bind parameter compared against one
+  std::unordered_map<std::string, std::string> compared;
+  // number of comparisons per attribute
+  std::unordered_map<std::string, size_t> comparisons;
+
+  std::function<void(AstNode const*)> visitor = [&] (AstNode const* node) -> void {
+    if (node == nullptr) {
+      return;
+    }
+
+    size_t const n = node->numMembers();
+
+    for (size_t i = 0; i < n; ++i) {
+      visitor(node->getMember(i));
+    }
+
+    if (node->type == NODE_TYPE_PARAMETER) {
+      char const* name = node->getStringValue();
+
+      if (name != nullptr) {
+        ++uses[std::string(name)];
+      }
+      return;
+    }
+
+    if (! IsComparison(node)) {
+      return;
+    }
+
+    bool const isIn = (node->type == NODE_TYPE_OPERATOR_BINARY_IN ||
+                       node->type == NODE_TYPE_OPERATOR_BINARY_NIN);
+
+    for (size_t i = 0; i < 2; ++i) {
+      std::string attribute;
+
+      if (! AttributeName(node->getMember(i), attribute)) {
+        continue;
+      }
+
+      ++comparisons[attribute];
+
+      std::string parameter;
+
+      if (! isIn && ValueParameterName(node->getMember(1 - i), parameter)) {
+        compared[parameter] = attribute;
+      }
+    }
+  };
+
+  visitor(root);
+
+  std::unordered_set<std::string> templated;
+
+  for (auto const& it : compared) {
+    if (uses[it.first] == 1 && comparisons[it.second] == 1) {
+      templated.emplace(it.first);
+    }
+  }
+
+  return templated;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create bind parameters with placeholders
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* PlanCache::createPlaceholders (BindParametersType const& parameters,
+                                           std::unordered_set<std::string> const& templated) {
+  auto placeholders = BuildPlaceholders(parameters, templated);
+
+  triagens::basics::Json result(triagens::basics::Json::Object, parameters.size());
+
+  for (auto const& placeholder : placeholders) {
+    if (TRI_IsStringJson(placeholder.value)) {
+      result.set(placeholder.name, triagens::basics::Json(placeholder.string));
+    }
+    else {
+      result.set(placeholder.name, triagens::basics::Json(placeholder.number));
+    }
+  }
+
+  for (auto const& it : parameters) {
+    if (UsesPlaceholder(it.first, it.second.first, templated)) {
+      continue;
+    }
+
+    TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, it.second.first);
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    result.set(it.first.c_str(), copy);
+  }
+
+  return result.steal();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check that the placeholders of all templated parameters made it
+/// into the plan
+////////////////////////////////////////////////////////////////////////////////
+
+bool PlanCache::checkPlaceholders (TRI_json_t const* plan,
+                                   BindParametersType const& parameters,
+                                   std::unordered_set<std::string>& templated) {
+  auto placeholders = BuildPlaceholders(parameters, templated);
+
+  VisitPlaceholders(const_cast<TRI_json_t*>(plan), placeholders, false);
+
+  bool result = true;
+
+  for (auto const& placeholder : placeholders) {
+    if (! placeholder.found) {
+      templated.erase(placeholder.name);
+      result = false;
+    }
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace the placeholders in a plan with the bind parameter values
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::fillPlaceholders (TRI_json_t* plan,
+                                  BindParametersType const& parameters,
+                                  std::unordered_set<std::string> const& templated) {
+  auto placeholders = BuildPlaceholders(parameters, templated);
+
+  if (! placeholders.empty()) {
+    VisitPlaceholders(plan, placeholders, true);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::clear () {
+  for (auto& it : _entries) {
+    delete it.second;
+  }
+
+  _entries.clear();
+  _numberOfPlans = 0;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -0,0 +1,303 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, cache for optimized execution plans
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_PLAN_CACHE_H
+#define ARANGODB_AQL_PLAN_CACHE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/BindParameters.h"
+#include "Basics/ReadWriteLock.h"
+
+namespace triagens {
+  namespace aql {
+
+    struct AstNode;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                             struct PlanCacheEntry
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cached plans for one query string
+////////////////////////////////////////////////////////////////////////////////
+
+    struct PlanCacheEntry {
+      PlanCacheEntry (std::unordered_set<std::string> const&);
+
+      ~PlanCacheEntry ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bind parameters that are replaced by placeholders in the plans
+////////////////////////////////////////////////////////////////////////////////
+
+      std::unordered_set<std::string> templated;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief plans, keyed by the shapes of the bind parameters
+////////////////////////////////////////////////////////////////////////////////
+
+      std::unordered_map<std::string, TRI_json_t*> plans;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   class PlanCache
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cache for optimized execution plans of a database
+///
+/// plans are stored in the JSON format that is also used for shipping plans
+/// to DB servers. bind parameter values end up in the plans as constants.
+/// a bind parameter that is only compared once against an attribute cannot
+/// influence any optimizer decision though, so for such parameters the plan
+/// is created with a placeholder value, which is replaced with the actual
+/// value when the plan is taken from the cache. the plans for all other bind
+/// parameters are cached per value.
+////////////////////////////////////////////////////////////////////////////////
+
+    class PlanCache {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        PlanCache ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        ~PlanCache ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache hits
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t hits () const {
+          return _hits.load();
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache misses
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t misses () const {
+          return _misses.load();
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of times the cache was invalidated
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t invalidations () const {
+          return _invalidations.load();
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current generation of the cache. plans created in an older
+/// generation are not stored
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t generation () const {
+          return _generation.load();
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of plans in the cache
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t size ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a plan. returns a copy of the plan with the bind parameter
+/// values filled in, or a nullptr if there is no plan
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_json_t* lookup (std::string const&,
+                            BindParametersType const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store a plan with placeholders. the cache takes ownership of the
+/// plan
+////////////////////////////////////////////////////////////////////////////////
+
+        void store (std::string const&,
+                    std::unordered_set<std::string> const&,
+                    BindParametersType const&,
+                    TRI_json_t*,
+                    uint64_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans, called when collections or indexes change
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidate ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                             public static methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the cache key for a query string and its options. runs of
+/// whitespace outside of strings and comments are collapsed
+////////////////////////////////////////////////////////////////////////////////
+
+        static std::string buildKey (char const*,
+                                     size_t,
+                                     TRI_json_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the bind parameters that can be replaced by placeholders,
+/// using the AST of the parsed query (before the bind parameters are injected)
+///
+/// these are the parameters that are used exactly once, as the operand of a
+/// comparison with an attribute, if the attribute name is not compared
+/// anywhere else in the query. the value of such a parameter cannot be
+/// merged with other values by the optimizer
+////////////////////////////////////////////////////////////////////////////////
+
+        static std::unordered_set<std::string> findTemplatable (AstNode const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create bind parameters with placeholders for the templated
+/// parameters that have a string or number value
+////////////////////////////////////////////////////////////////////////////////
+
+        static TRI_json_t* createPlaceholders (BindParametersType const&,
+                                               std::unordered_set<std::string> const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check that the placeholders of all templated parameters made it
+/// into the plan. parameters whose placeholder is missing were folded into
+/// something else and are removed from the templated parameters
+////////////////////////////////////////////////////////////////////////////////
+
+        static bool checkPlaceholders (TRI_json_t const*,
+                                       BindParametersType const&,
+                                       std::unordered_set<std::string>&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace the placeholders in a plan with the bind parameter values
+////////////////////////////////////////////////////////////////////////////////
+
+        static void fillPlaceholders (TRI_json_t*,
+                                      BindParametersType const&,
+                                      std::unordered_set<std::string> const&);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans, must be called with the write lock held
+////////////////////////////////////////////////////////////////////////////////
+
+        void clear ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief r/w lock for the cache
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::ReadWriteLock _lock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cached plans, keyed by query string and options
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_map<std::string, PlanCacheEntry*> _entries;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief total number of cached plans
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _numberOfPlans;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current generation
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _generation;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache hits
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _hits;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache misses
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _misses;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of invalidations
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _invalidations;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of plans in the cache
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t const MaxPlans;
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
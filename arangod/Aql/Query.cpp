@@ -34,6 +34,7 @@
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Parser.h"
+#include "Aql/PlanCache.h"
 #include "Aql/QueryList.h"
 #include "Basics/JsonHelper.h"
 #include "Basics/json.h"
@@ -518,7 +519,16 @@ QueryResult Query::prepare (QueryRegistry* registry) {
     std::unique_ptr<Parser> parser(new Parser(this));
     std::unique_ptr<ExecutionPlan> plan;
 
-    if (_queryString != nullptr) {
+    if (_queryJson.isEmpty() && cachePlan()) {
+      TRI_json_t* cached = planFromCache();
+
+      if (cached != nullptr) {
+        // the cached plan is instanciated like a plan from a coordinator
+        _queryJson = triagens::basics::Json(TRI_UNKNOWN_MEM_ZONE, cached);
+      }
+    }
+
+    if (_queryJson.isEmpty()) {
       parser->parse(false);
       // put in bind parameters
       parser->ast()->injectBindParameters(_bindParameters);
@@ -530,7 +540,7 @@ QueryResult Query::prepare (QueryRegistry* registry) {
 
     bool planRegisters;
 
-    if (_queryString != nullptr) {
+    if (_queryJson.isEmpty()) {
       // we have an AST
       int res = _trx->begin();
 
@@ -561,7 +571,7 @@ QueryResult Query::prepare (QueryRegistry* registry) {
       plan.reset(opt.stealBest()); // Now we own the best one again
       planRegisters = true;
     }
-    else {   // no queryString, we are instanciating from _queryJson
+    else {   // no AST, we are instanciating from _queryJson
       enterState(PLAN_INSTANCIATION);
       ExecutionPlan::getCollectionsFromJson(parser->ast(), _queryJson);
 
@@ -1140,6 +1150,155 @@ QueryResult Query::transactionError (int errorCode) const {
   return QueryResult(errorCode, err);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the plan for the query in the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* Query::planFromCache () {
+  if (_queryString == nullptr ||
+      _part != PART_MAIN ||
+      triagens::arango::ServerState::instance()->isRunningInCluster()) {
+    return nullptr;
+  }
+
+  auto planCache = static_cast<QueryList*>(_vocbase->_queries)->planCache();
+  auto const& parameters = _bindParameters();
+  std::string const key = PlanCache::buildKey(_queryString, _queryLength, _options);
+
+  TRI_json_t* plan = planCache->lookup(key, parameters);
+
+  if (plan != nullptr) {
+    return plan;
+  }
+
+  // plans that were created while collections or indexes changed are not stored
+  uint64_t const generation = planCache->generation();
+  std::unordered_set<std::string> templated;
+
+  try {
+    // the second attempt is made if the optimizer folded a templated bind
+    // parameter into something else. the parameter is not templated then
+    for (int attempt = 0; attempt < 2; ++attempt) {
+      TRI_json_t* options = nullptr;
+
+      if (_options != nullptr) {
+        options = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, _options);
+
+        if (options == nullptr) {
+          return nullptr;
+        }
+      }
+
+      TRI_json_t* json;
+
+      {
+        Query query(_applicationV8, 
+                    _contextOwnedByExterior,
+                    _vocbase,
+                    _queryString,
+                    _queryLength,
+                    nullptr,
+                    options,
+                    PART_MAIN);
+
+        json = query.planTemplate(parameters, templated, attempt == 0);
+      }
+
+      if (json == nullptr) {
+        return nullptr;
+      }
+
+      if (! PlanCache::checkPlaceholders(json, parameters, templated)) {
+        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+        continue;
+      }
+
+      plan = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+      if (plan == nullptr) {
+        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+        return nullptr;
+      }
+
+      // the cache takes over the template
+      planCache->store(key, templated, parameters, json, generation);
+
+      PlanCache::fillPlaceholders(plan, parameters, templated);
+      return plan;
+    }
+  }
+  catch (...) {
+    // errors are reported when the query is planned the regular way
+    if (plan != nullptr) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, plan);
+    }
+  }
+
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the plan for the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* Query::planTemplate (BindParametersType const& parameters,
+                                 std::unordered_set<std::string>& templated,
+                                 bool findTemplated) {
+  enterState(PARSING);
+
+  Parser parser(this);
+  parser.parse(false);
+
+  if (findTemplated) {
+    templated = PlanCache::findTemplatable(parser.ast()->root());
+  }
+
+  // put in bind parameters, with placeholders for the templated ones
+  BindParameters placeholders(PlanCache::createPlaceholders(parameters, templated));
+  parser.ast()->injectBindParameters(placeholders);
+
+  _trx = new triagens::arango::AqlTransaction(createTransactionContext(), _vocbase, _collections.collections(), true);
+
+  int res = _trx->begin();
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  enterState(AST_OPTIMIZATION);
+  parser.ast()->validateAndOptimize();
+
+  enterState(PLAN_INSTANCIATION);
+  std::unique_ptr<ExecutionPlan> plan(ExecutionPlan::instanciateFromAst(parser.ast()));
+
+  if (plan.get() == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+  }
+
+  enterState(PLAN_OPTIMIZATION);
+  triagens::aql::Optimizer opt(maxNumberOfPlans());
+  opt.createPlans(plan.release(), getRulesFromOptions(), inspectSimplePlans());
+  plan.reset(opt.stealBest());
+
+  TRI_ASSERT(plan.get() != nullptr);
+
+  // the register plan is part of the JSON, as for plans sent to DB servers
+  plan->findVarUsage();
+  plan->planRegisters();
+
+  enterState(FINALIZATION);
+  triagens::basics::Json json(plan->toJson(parser.ast(), TRI_UNKNOWN_MEM_ZONE, true));
+
+  _trx->commit();
+
+  if (! _warnings.empty()) {
+    // warnings are only reported if the query is planned every time
+    return nullptr;
+  }
+
+  return json.steal();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief read the "optimizer.inspectSimplePlans" section from the options
 ////////////////////////////////////////////////////////////////////////////////
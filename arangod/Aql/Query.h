@@ -284,6 +284,14 @@ namespace triagens {
           return getBooleanOption("profile", false);
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief should the plan be taken from and stored in the plan cache?
+////////////////////////////////////////////////////////////////////////////////
+
+        bool cachePlan () const {  
+          return getBooleanOption("cachePlan", false);
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief maximum number of plans to produce
 ////////////////////////////////////////////////////////////////////////////////
@@ -496,6 +504,24 @@ namespace triagens {
 
         QueryResult transactionError (int errorCode) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the plan for the query in the plan cache. on a cache miss,
+/// the plan is created and stored. returns a nullptr if the query cannot be
+/// cached
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_json_t* planFromCache ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the plan for the plan cache, with placeholders for the
+/// templated bind parameters. if the last parameter is true, the templated
+/// bind parameters are determined from the query string
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_json_t* planTemplate (BindParametersType const&,
+                                  std::unordered_set<std::string>&,
+                                  bool);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief enter a new state
 ////////////////////////////////////////////////////////////////////////////////
@@ -594,7 +620,7 @@ namespace triagens {
 /// @brief query in a JSON structure
 ////////////////////////////////////////////////////////////////////////////////
 
-        triagens::basics::Json const      _queryJson;
+        triagens::basics::Json            _queryJson;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief bind parameters for the query
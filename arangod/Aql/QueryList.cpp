@@ -87,7 +87,8 @@ QueryList::QueryList (TRI_vocbase_t*)
     _trackSlowQueries(true),
     _slowQueryThreshold(QueryList::DefaultSlowQueryThreshold),
     _maxSlowQueries(QueryList::DefaultMaxSlowQueries),
-    _maxQueryStringLength(QueryList::DefaultMaxQueryStringLength) {
+    _maxQueryStringLength(QueryList::DefaultMaxQueryStringLength),
+    _planCache() {
 
   _current.reserve(64);
 }
@@ -31,6 +31,7 @@
 #define ARANGODB_AQL_QUERY_LIST_H 1
 
 #include "Basics/Common.h"
+#include "Aql/PlanCache.h"
 #include "Basics/ReadWriteLock.h"
 #include "VocBase/voc-types.h"
 
@@ -253,6 +254,14 @@ namespace triagens {
 
         void clearSlow ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the plan cache of the database
+////////////////////////////////////////////////////////////////////////////////
+
+        inline PlanCache* planCache () {
+          return &_planCache;
+        }
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -313,6 +322,12 @@ namespace triagens {
 
         size_t _maxQueryStringLength;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cache for optimized plans
+////////////////////////////////////////////////////////////////////////////////
+
+        PlanCache _planCache;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief default threshold for slow queries
 ////////////////////////////////////////////////////////////////////////////////
@@ -300,7 +300,9 @@ void QueryRegistry::expireQueries () {
         // y.first is a QueryId and
         // y.second is a QueryInfo*
         QueryInfo*& qi = y.second;
-        if (! qi->_isOpen && now > qi->_expires) {
+        // queries killed while parked are released early, so a killed
+        // streaming cursor does not hold its locks until it expires
+        if (! qi->_isOpen && (now > qi->_expires || qi->_query->killed())) {
           toDelete.emplace_back(x.first, y.first);
         }
       }
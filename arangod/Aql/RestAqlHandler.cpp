@@ -723,6 +723,31 @@ void RestAqlHandler::handleUseQuery (std::string const& operation,
       }
       items.reset(block->getSomeForShard(atLeast, atMost, shardId));
     }
+
+    // a caller that understands the binary format asks for it
+    char const* accept = _request->header("accept", found);
+    if (found && 
+        accept != nullptr && 
+        strcmp(accept, AqlItemBlock::BinaryContentType) == 0) {
+      answerBody("exhausted", Json(items.get() == nullptr))
+                ("error", Json(false))
+                ("stats", query->getStats());
+      try {
+        _response = createResponse(triagens::rest::HttpResponse::OK);
+        _response->setContentType(AqlItemBlock::BinaryContentType);
+        AqlItemBlock::writeBinaryMessage(query->trx(), 
+                                         _response->body(), 
+                                         answerBody, 
+                                         items.get());
+      }
+      catch (...) {
+        LOG_ERROR("cannot transform AqlItemBlock to binary format");
+        generateError(HttpResponse::SERVER_ERROR, TRI_ERROR_HTTP_SERVER_ERROR,
+                      "cannot transform AqlItemBlock to binary format");
+      }
+      return;
+    }
+
     if (items.get() == nullptr) {
       answerBody("exhausted", Json(true))
         ("error", Json(false))
@@ -0,0 +1,678 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, options for native traversals
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/TraversalOptions.h"
+#include "Basics/Exceptions.h"
+#include "Basics/json-utilities.h"
+
+using namespace triagens::aql;
+using Json = triagens::basics::Json;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief normalize an option string the same way the JavaScript traverser
+/// does: lower-case it and remove the first dash
+////////////////////////////////////////////////////////////////////////////////
+
+static std::string NormalizeOption (TRI_json_t const* json) {
+  std::string value(json->_value._string.data, json->_value._string.length - 1);
+
+  for (auto& c : value) {
+    c = static_cast<char>(::tolower(c));
+  }
+
+  auto pos = value.find('-');
+  if (pos != std::string::npos) {
+    value.erase(pos, 1);
+  }
+
+  return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract a depth value. only integral numbers and null are supported
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ParseDepth (TRI_json_t const* json,
+                        uint64_t& depth) {
+  if (json->_type == TRI_JSON_NULL) {
+    depth = 0;
+    return true;
+  }
+
+  if (json->_type != TRI_JSON_NUMBER) {
+    return false;
+  }
+
+  double const value = json->_value._number;
+
+  if (value != std::floor(value)) {
+    return false;
+  }
+
+  depth = (value > 0.0 ? static_cast<uint64_t>(value) : 0);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the names of the vertex condition operators
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<std::pair<std::string, TraversalOptions::VertexCondition::Operator>> const VertexConditionOperators = {
+  { "==", TraversalOptions::VertexCondition::OPERATOR_EQ },
+  { "!=", TraversalOptions::VertexCondition::OPERATOR_NE },
+  { "<",  TraversalOptions::VertexCondition::OPERATOR_LT },
+  { "<=", TraversalOptions::VertexCondition::OPERATOR_LE },
+  { ">",  TraversalOptions::VertexCondition::OPERATOR_GT },
+  { ">=", TraversalOptions::VertexCondition::OPERATOR_GE },
+  { "IN", TraversalOptions::VertexCondition::OPERATOR_IN }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a null value, for vertex attributes that do not exist
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_json_t const NullJson = { TRI_JSON_NULL, { false } };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor, using default values
+////////////////////////////////////////////////////////////////////////////////
+
+TraversalOptions::TraversalOptions ()
+  : minDepth(0),
+    maxDepth(256),
+    maxIterations(10000000),
+    uniqueVertices(UNIQUE_NONE),
+    uniqueEdges(UNIQUE_PATH),
+    strategy(STRATEGY_DEPTH_FIRST),
+    paths(false),
+    excludeFilteredVertices(true),
+    pruneFilteredVertices(true),
+    followEdges(nullptr),
+    filterVertices(nullptr),
+    vertexConditions(),
+    _json(nullptr),
+    _vertexConditions(nullptr) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief copy constructor
+////////////////////////////////////////////////////////////////////////////////
+
+TraversalOptions::TraversalOptions (TraversalOptions const& other)
+  : TraversalOptions() {
+
+  if (! parse(other._json) ||
+      ! parseVertexConditions(other._vertexConditions)) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid traversal options");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destructor
+////////////////////////////////////////////////////////////////////////////////
+
+TraversalOptions::~TraversalOptions () {
+  if (_json != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _json);
+  }
+
+  if (_vertexConditions != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _vertexConditions);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up the options from the params argument of TRAVERSAL()
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalOptions::parse (TRI_json_t const* json) {
+  if (_json != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _json);
+    _json = nullptr;
+  }
+  followEdges = nullptr;
+  filterVertices = nullptr;
+
+  if (json == nullptr || json->_type == TRI_JSON_NULL) {
+    // no params at all, use defaults
+    return true;
+  }
+
+  if (! TRI_IsObjectJson(json)) {
+    return false;
+  }
+
+  _json = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+  if (_json == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  size_t const n = TRI_LengthVector(&_json->_value._objects);
+
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&_json->_value._objects, i));
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&_json->_value._objects, i + 1));
+
+    if (! TRI_IsStringJson(key) || value == nullptr) {
+      return false;
+    }
+
+    std::string const name(key->_value._string.data, key->_value._string.length - 1);
+
+    if (name == "minDepth") {
+      if (! ParseDepth(value, minDepth)) {
+        return false;
+      }
+    }
+    else if (name == "maxDepth") {
+      if (! ParseDepth(value, maxDepth)) {
+        return false;
+      }
+    }
+    else if (name == "maxIterations") {
+      if (value->_type != TRI_JSON_NUMBER || value->_value._number < 0.0) {
+        return false;
+      }
+      maxIterations = static_cast<uint64_t>(value->_value._number);
+    }
+    else if (name == "paths") {
+      if (! TRI_IsBooleanJson(value)) {
+        return false;
+      }
+      paths = value->_value._boolean;
+    }
+    else if (name == "uniqueness") {
+      if (value->_type == TRI_JSON_NULL) {
+        continue;
+      }
+      if (! TRI_IsObjectJson(value) ||
+          ! parseUniqueness(TRI_LookupObjectJson(value, "vertices"), uniqueVertices) ||
+          ! parseUniqueness(TRI_LookupObjectJson(value, "edges"), uniqueEdges)) {
+        return false;
+      }
+    }
+    else if (name == "strategy") {
+      if (value->_type == TRI_JSON_NULL) {
+        continue;
+      }
+      if (! TRI_IsStringJson(value)) {
+        return false;
+      }
+      std::string const s = NormalizeOption(value);
+      if (s == "depthfirst") {
+        strategy = STRATEGY_DEPTH_FIRST;
+      }
+      else if (s == "breadthfirst") {
+        strategy = STRATEGY_BREADTH_FIRST;
+      }
+      else {
+        // shortest path strategies are left to the JavaScript implementation
+        return false;
+      }
+    }
+    else if (name == "order") {
+      if (value->_type != TRI_JSON_NULL &&
+          (! TRI_IsStringJson(value) || NormalizeOption(value) != "preorder")) {
+        return false;
+      }
+    }
+    else if (name == "itemOrder") {
+      if (value->_type != TRI_JSON_NULL &&
+          (! TRI_IsStringJson(value) || NormalizeOption(value) != "forward")) {
+        return false;
+      }
+    }
+    else if (name == "followEdges") {
+      if (! parseExamples(value, followEdges)) {
+        return false;
+      }
+    }
+    else if (name == "filterVertices") {
+      if (! parseExamples(value, filterVertices)) {
+        return false;
+      }
+    }
+    else if (name == "vertexFilterMethod") {
+      // an empty string or null means the default, as in the JavaScript
+      // implementation. an empty array means neither exclude nor prune
+      std::vector<TRI_json_t const*> methods;
+
+      if (TRI_IsStringJson(value)) {
+        if (value->_value._string.length <= 1) {
+          continue;
+        }
+        methods.emplace_back(value);
+      }
+      else if (TRI_IsArrayJson(value)) {
+        size_t const m = TRI_LengthArrayJson(value);
+        for (size_t j = 0; j < m; ++j) {
+          methods.emplace_back(TRI_LookupArrayJson(value, j));
+        }
+      }
+      else if (value->_type != TRI_JSON_NULL) {
+        return false;
+      }
+
+      if (value->_type != TRI_JSON_NULL) {
+        excludeFilteredVertices = false;
+        pruneFilteredVertices = false;
+
+        for (auto method : methods) {
+          if (! TRI_IsStringJson(method)) {
+            return false;
+          }
+          std::string const s(method->_value._string.data, method->_value._string.length - 1);
+          if (s == "exclude") {
+            excludeFilteredVertices = true;
+          }
+          else if (s == "prune") {
+            pruneFilteredVertices = true;
+          }
+          else if (! s.empty()) {
+            return false;
+          }
+        }
+      }
+    }
+    else {
+      // visitors, filter functions etc. require the JavaScript implementation
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert the options to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalOptions::toJson (triagens::basics::Json& json,
+                               TRI_memory_zone_t* zone) const {
+  if (_vertexConditions != nullptr) {
+    TRI_json_t* copy = TRI_CopyJson(zone, _vertexConditions);
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    json("vertexConditions", Json(zone, copy));
+  }
+
+  if (_json == nullptr) {
+    json("traversalOptions", Json(Json::Null));
+    return;
+  }
+
+  TRI_json_t* copy = TRI_CopyJson(zone, _json);
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  json("traversalOptions", Json(zone, copy));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an edge may be followed
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalOptions::matchesEdge (TRI_json_t const* edge) const {
+  if (followEdges == nullptr) {
+    return true;
+  }
+
+  return matchesExamples(edge, followEdges);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a vertex passes the vertex filter
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalOptions::matchesVertex (TRI_json_t const* vertex) const {
+  if (filterVertices == nullptr) {
+    return true;
+  }
+
+  return matchesExamples(vertex, filterVertices);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add a condition on the vertices that are returned
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalOptions::addVertexCondition (std::vector<std::string> const& attribute,
+                                           std::string const& op,
+                                           TRI_json_t const* value) {
+  if (attribute.empty() || value == nullptr) {
+    return false;
+  }
+
+  Json condition(Json::Object, 3);
+  Json path(Json::Array, attribute.size());
+
+  for (auto const& name : attribute) {
+    path(Json(name));
+  }
+
+  TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  condition("attribute", path)
+           ("operator", Json(op))
+           ("value", Json(TRI_UNKNOWN_MEM_ZONE, copy));
+
+  Json conditions(TRI_UNKNOWN_MEM_ZONE, _vertexConditions == nullptr ?
+                                        TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE) :
+                                        TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, _vertexConditions));
+
+  if (conditions.json() == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  conditions(condition);
+
+  return parseVertexConditions(conditions.json());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up the vertex conditions from their JSON representation
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalOptions::parseVertexConditions (TRI_json_t const* json) {
+  TRI_json_t* copy = nullptr;
+
+  if (json != nullptr && json->_type != TRI_JSON_NULL) {
+    if (! TRI_IsArrayJson(json)) {
+      return false;
+    }
+
+    copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+  }
+
+  if (_vertexConditions != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _vertexConditions);
+  }
+  _vertexConditions = copy;
+
+  return setupVertexConditions();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a vertex satisfies all vertex conditions. the
+/// comparisons are the same as those of the AQL operators
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalOptions::matchesVertexConditions (TRI_json_t const* vertex) const {
+  for (auto const& condition : vertexConditions) {
+    TRI_json_t const* value = vertex;
+
+    for (auto const& name : condition.attribute) {
+      if (! TRI_IsObjectJson(value)) {
+        value = nullptr;
+        break;
+      }
+
+      value = TRI_LookupObjectJson(value, name.c_str());
+
+      if (value == nullptr) {
+        break;
+      }
+    }
+
+    if (value == nullptr) {
+      value = &NullJson;
+    }
+
+    bool matches = false;
+
+    if (condition.op == VertexCondition::OPERATOR_IN) {
+      size_t const n = TRI_LengthArrayJson(condition.value);
+
+      for (size_t i = 0; i < n; ++i) {
+        if (TRI_CompareValuesJson(value, TRI_LookupArrayJson(condition.value, i), false) == 0) {
+          matches = true;
+          break;
+        }
+      }
+    }
+    else {
+      // equality can use a binary comparison, as the AQL operators do
+      bool const useUtf8 = (condition.op != VertexCondition::OPERATOR_EQ &&
+                            condition.op != VertexCondition::OPERATOR_NE);
+      int const result = TRI_CompareValuesJson(value, condition.value, useUtf8);
+
+      switch (condition.op) {
+        case VertexCondition::OPERATOR_EQ: matches = (result == 0); break;
+        case VertexCondition::OPERATOR_NE: matches = (result != 0); break;
+        case VertexCondition::OPERATOR_LT: matches = (result < 0); break;
+        case VertexCondition::OPERATOR_LE: matches = (result <= 0); break;
+        case VertexCondition::OPERATOR_GT: matches = (result > 0); break;
+        case VertexCondition::OPERATOR_GE: matches = (result >= 0); break;
+        case VertexCondition::OPERATOR_IN: break;
+      }
+    }
+
+    if (! matches) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse a uniqueness level
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalOptions::parseUniqueness (TRI_json_t const* json,
+                                        UniquenessLevel& level) {
+  if (json == nullptr || json->_type == TRI_JSON_NULL) {
+    // keep the default
+    return true;
+  }
+
+  if (! TRI_IsStringJson(json)) {
+    return false;
+  }
+
+  std::string const s = NormalizeOption(json);
+
+  if (s == "none") {
+    level = UNIQUE_NONE;
+  }
+  else if (s == "path") {
+    level = UNIQUE_PATH;
+  }
+  else if (s == "global") {
+    level = UNIQUE_GLOBAL;
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse an example list. only non-empty arrays of objects are
+/// supported. null disables the filter
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalOptions::parseExamples (TRI_json_t const* json,
+                                      TRI_json_t const*& examples) {
+  if (json->_type == TRI_JSON_NULL) {
+    examples = nullptr;
+    return true;
+  }
+
+  if (! TRI_IsArrayJson(json)) {
+    return false;
+  }
+
+  size_t const n = TRI_LengthArrayJson(json);
+
+  if (n == 0) {
+    return false;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    if (! TRI_IsObjectJson(TRI_LookupArrayJson(json, i))) {
+      return false;
+    }
+  }
+
+  examples = json;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a document matches at least one of the examples.
+/// this is the same as MATCHES(document, examples)
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalOptions::matchesExamples (TRI_json_t const* document,
+                                        TRI_json_t const* examples) {
+  if (! TRI_IsObjectJson(document)) {
+    return false;
+  }
+
+  size_t const n = TRI_LengthArrayJson(examples);
+
+  for (size_t i = 0; i < n; ++i) {
+    auto example = TRI_LookupArrayJson(examples, i);
+    size_t const m = TRI_LengthVector(&example->_value._objects);
+    bool matches = true;
+
+    for (size_t j = 0; j < m; j += 2) {
+      auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&example->_value._objects, j));
+      auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&example->_value._objects, j + 1));
+
+      if (TRI_CompareValuesJson(TRI_LookupObjectJson(document, key->_value._string.data), value, false) != 0) {
+        matches = false;
+        break;
+      }
+    }
+
+    if (matches) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build vertexConditions from _vertexConditions
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalOptions::setupVertexConditions () {
+  vertexConditions.clear();
+
+  if (_vertexConditions == nullptr) {
+    return true;
+  }
+
+  size_t const n = TRI_LengthArrayJson(_vertexConditions);
+
+  for (size_t i = 0; i < n; ++i) {
+    auto json = TRI_LookupArrayJson(_vertexConditions, i);
+    auto attribute = TRI_LookupObjectJson(json, "attribute");
+    auto op = TRI_LookupObjectJson(json, "operator");
+    auto value = TRI_LookupObjectJson(json, "value");
+
+    if (! TRI_IsArrayJson(attribute) ||
+        TRI_LengthArrayJson(attribute) == 0 ||
+        ! TRI_IsStringJson(op) ||
+        value == nullptr) {
+      return false;
+    }
+
+    VertexCondition condition;
+    condition.value = value;
+
+    size_t const m = TRI_LengthArrayJson(attribute);
+
+    for (size_t j = 0; j < m; ++j) {
+      auto name = TRI_LookupArrayJson(attribute, j);
+
+      if (! TRI_IsStringJson(name)) {
+        return false;
+      }
+
+      condition.attribute.emplace_back(name->_value._string.data, name->_value._string.length - 1);
+    }
+
+    std::string const name(op->_value._string.data, op->_value._string.length - 1);
+    bool found = false;
+
+    for (auto const& it : VertexConditionOperators) {
+      if (it.first == name) {
+        condition.op = it.second;
+        found = true;
+        break;
+      }
+    }
+
+    if (! found ||
+        (condition.op == VertexCondition::OPERATOR_IN && ! TRI_IsArrayJson(value))) {
+      return false;
+    }
+
+    vertexConditions.emplace_back(condition);
+  }
+
+  return true;
+}
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, options for native traversals
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_TRAVERSAL_OPTIONS_H
+#define ARANGODB_AQL_TRAVERSAL_OPTIONS_H 1
+
+#include "Basics/Common.h"
+#include "Basics/JsonHelper.h"
+
+namespace triagens {
+  namespace aql {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief TraversalOptions
+///
+/// the subset of the TRAVERSAL() options that the native TraversalBlock
+/// handles. the semantics are the same as in the JavaScript traverser
+/// (js/common/modules/org/arangodb/graph/traversal.js)
+////////////////////////////////////////////////////////////////////////////////
+
+    struct TraversalOptions {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      public types
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief uniqueness level for vertices and edges
+////////////////////////////////////////////////////////////////////////////////
+
+      enum UniquenessLevel {
+        UNIQUE_NONE,
+        UNIQUE_PATH,
+        UNIQUE_GLOBAL
+      };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief traversal strategy
+////////////////////////////////////////////////////////////////////////////////
+
+      enum Strategy {
+        STRATEGY_DEPTH_FIRST,
+        STRATEGY_BREADTH_FIRST
+      };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a FILTER condition that the optimizer pushed into the traversal.
+/// it compares an attribute of the vertex with a constant value
+////////////////////////////////////////////////////////////////////////////////
+
+      struct VertexCondition {
+        enum Operator {
+          OPERATOR_EQ,
+          OPERATOR_NE,
+          OPERATOR_LT,
+          OPERATOR_LE,
+          OPERATOR_GT,
+          OPERATOR_GE,
+          OPERATOR_IN
+        };
+
+        std::vector<std::string> attribute;
+        Operator op;
+        TRI_json_t const* value; // points into _vertexConditions
+      };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor, using default values
+////////////////////////////////////////////////////////////////////////////////
+
+      TraversalOptions ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief copy constructor
+////////////////////////////////////////////////////////////////////////////////
+
+      TraversalOptions (TraversalOptions const&);
+
+      TraversalOptions& operator= (TraversalOptions const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destructor
+////////////////////////////////////////////////////////////////////////////////
+
+      ~TraversalOptions ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up the options from the params argument of TRAVERSAL().
+/// returns false if the params contain anything that the native traversal
+/// does not support, e.g. a visitor or filter function
+////////////////////////////////////////////////////////////////////////////////
+
+      bool parse (TRI_json_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert the options to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+      void toJson (triagens::basics::Json&,
+                   TRI_memory_zone_t*) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an edge may be followed
+////////////////////////////////////////////////////////////////////////////////
+
+      bool matchesEdge (TRI_json_t const*) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a vertex passes the vertex filter
+////////////////////////////////////////////////////////////////////////////////
+
+      bool matchesVertex (TRI_json_t const*) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add a condition on the vertices that are returned. op is one of
+/// ==, !=, <, <=, >, >= and IN. returns false if the condition is not
+/// supported
+////////////////////////////////////////////////////////////////////////////////
+
+      bool addVertexCondition (std::vector<std::string> const&,
+                               std::string const&,
+                               TRI_json_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up the vertex conditions from their JSON representation
+////////////////////////////////////////////////////////////////////////////////
+
+      bool parseVertexConditions (TRI_json_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a vertex satisfies all vertex conditions
+////////////////////////////////////////////////////////////////////////////////
+
+      bool matchesVertexConditions (TRI_json_t const*) const;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+    private:
+
+      static bool parseUniqueness (TRI_json_t const*,
+                                   UniquenessLevel&);
+
+      static bool parseExamples (TRI_json_t const*,
+                                 TRI_json_t const*&);
+
+      static bool matchesExamples (TRI_json_t const*,
+                                   TRI_json_t const*);
+
+      bool setupVertexConditions ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public variables
+// -----------------------------------------------------------------------------
+
+    public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief vertices with a smaller depth are not returned
+////////////////////////////////////////////////////////////////////////////////
+
+      uint64_t minDepth;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief vertices at this depth are not expanded. 0 means unlimited
+////////////////////////////////////////////////////////////////////////////////
+
+      uint64_t maxDepth;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of traversal steps
+////////////////////////////////////////////////////////////////////////////////
+
+      uint64_t maxIterations;
+
+      UniquenessLevel uniqueVertices;
+
+      UniquenessLevel uniqueEdges;
+
+      Strategy strategy;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the path is returned with each vertex
+////////////////////////////////////////////////////////////////////////////////
+
+      bool paths;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether vertices failing the vertex filter are excluded and/or
+/// pruned
+////////////////////////////////////////////////////////////////////////////////
+
+      bool excludeFilteredVertices;
+
+      bool pruneFilteredVertices;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief edge examples (followEdges), points into _json
+////////////////////////////////////////////////////////////////////////////////
+
+      TRI_json_t const* followEdges;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief vertex examples (filterVertices), points into _json
+////////////////////////////////////////////////////////////////////////////////
+
+      TRI_json_t const* filterVertices;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief conditions pushed into the traversal by the optimizer
+////////////////////////////////////////////////////////////////////////////////
+
+      std::vector<VertexCondition> vertexConditions;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+    private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the original params, used for serialization
+////////////////////////////////////////////////////////////////////////////////
+
+      TRI_json_t* _json;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the vertex conditions, as an array of
+/// { attribute, operator, value } objects
+////////////////////////////////////////////////////////////////////////////////
+
+      TRI_json_t* _vertexConditions;
+
+    };
+
+  }  // namespace triagens::aql
+}  // namespace triagens
+
+#endif
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
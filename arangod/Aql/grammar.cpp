@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.2"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -66,9 +71,8 @@
 #define yydebug         Aqldebug
 #define yynerrs         Aqlnerrs
 
-
-/* Copy the first part of user declarations.  */
-#line 9 "arangod/Aql/grammar.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 9 "arangod/Aql/grammar.y"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -81,26 +85,66 @@
 #include "Aql/Function.h"
 #include "Aql/Parser.h"
 
-#line 85 "arangod/Aql/grammar.cpp" /* yacc.c:339  */
+#line 89 "arangod/Aql/grammar.cpp"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
-/* In a future release of Bison, this section will be replaced
-   by #include "grammar.hpp".  */
 #ifndef YY_AQL_ARANGOD_AQL_GRAMMAR_HPP_INCLUDED
 # define YY_AQL_ARANGOD_AQL_GRAMMAR_HPP_INCLUDED
 /* Debug traces.  */
@@ -111,87 +155,92 @@
 extern int Aqldebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    T_END = 0,
-    T_FOR = 258,
-    T_LET = 259,
-    T_FILTER = 260,
-    T_RETURN = 261,
-    T_COLLECT = 262,
-    T_SORT = 263,
-    T_LIMIT = 264,
-    T_ASC = 265,
-    T_DESC = 266,
-    T_IN = 267,
-    T_WITH = 268,
-    T_INTO = 269,
-    T_REMOVE = 270,
-    T_INSERT = 271,
-    T_UPDATE = 272,
-    T_REPLACE = 273,
-    T_UPSERT = 274,
-    T_NULL = 275,
-    T_TRUE = 276,
-    T_FALSE = 277,
-    T_STRING = 278,
-    T_QUOTED_STRING = 279,
-    T_INTEGER = 280,
-    T_DOUBLE = 281,
-    T_PARAMETER = 282,
-    T_ASSIGN = 283,
-    T_NOT = 284,
-    T_AND = 285,
-    T_OR = 286,
-    T_EQ = 287,
-    T_NE = 288,
-    T_LT = 289,
-    T_GT = 290,
-    T_LE = 291,
-    T_GE = 292,
-    T_PLUS = 293,
-    T_MINUS = 294,
-    T_TIMES = 295,
-    T_DIV = 296,
-    T_MOD = 297,
-    T_EXPAND = 298,
-    T_QUESTION = 299,
-    T_COLON = 300,
-    T_SCOPE = 301,
-    T_RANGE = 302,
-    T_COMMA = 303,
-    T_OPEN = 304,
-    T_CLOSE = 305,
-    T_OBJECT_OPEN = 306,
-    T_OBJECT_CLOSE = 307,
-    T_ARRAY_OPEN = 308,
-    T_ARRAY_CLOSE = 309,
-    T_NIN = 310,
-    UMINUS = 311,
-    UPLUS = 312,
-    FUNCCALL = 313,
-    REFERENCE = 314,
-    INDEXED = 315
+    YYEMPTY = -2,
+    T_END = 0,                     /* "end of query string"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    T_FOR = 258,                   /* "FOR declaration"  */
+    T_LET = 259,                   /* "LET declaration"  */
+    T_FILTER = 260,                /* "FILTER declaration"  */
+    T_RETURN = 261,                /* "RETURN declaration"  */
+    T_COLLECT = 262,               /* "COLLECT declaration"  */
+    T_SORT = 263,                  /* "SORT declaration"  */
+    T_LIMIT = 264,                 /* "LIMIT declaration"  */
+    T_ASC = 265,                   /* "ASC keyword"  */
+    T_DESC = 266,                  /* "DESC keyword"  */
+    T_IN = 267,                    /* "IN keyword"  */
+    T_WITH = 268,                  /* "WITH keyword"  */
+    T_INTO = 269,                  /* "INTO keyword"  */
+    T_REMOVE = 270,                /* "REMOVE command"  */
+    T_INSERT = 271,                /* "INSERT command"  */
+    T_UPDATE = 272,                /* "UPDATE command"  */
+    T_REPLACE = 273,               /* "REPLACE command"  */
+    T_UPSERT = 274,                /* "UPSERT command"  */
+    T_NULL = 275,                  /* "null"  */
+    T_TRUE = 276,                  /* "true"  */
+    T_FALSE = 277,                 /* "false"  */
+    T_STRING = 278,                /* "identifier"  */
+    T_QUOTED_STRING = 279,         /* "quoted string"  */
+    T_INTEGER = 280,               /* "integer number"  */
+    T_DOUBLE = 281,                /* "number"  */
+    T_PARAMETER = 282,             /* "bind parameter"  */
+    T_ASSIGN = 283,                /* "assignment"  */
+    T_NOT = 284,                   /* "not operator"  */
+    T_AND = 285,                   /* "and operator"  */
+    T_OR = 286,                    /* "or operator"  */
+    T_EQ = 287,                    /* "== operator"  */
+    T_NE = 288,                    /* "!= operator"  */
+    T_LT = 289,                    /* "< operator"  */
+    T_GT = 290,                    /* "> operator"  */
+    T_LE = 291,                    /* "<= operator"  */
+    T_GE = 292,                    /* ">= operator"  */
+    T_PLUS = 293,                  /* "+ operator"  */
+    T_MINUS = 294,                 /* "- operator"  */
+    T_TIMES = 295,                 /* "* operator"  */
+    T_DIV = 296,                   /* "/ operator"  */
+    T_MOD = 297,                   /* "% operator"  */
+    T_EXPAND = 298,                /* "[*] operator"  */
+    T_QUESTION = 299,              /* "?"  */
+    T_COLON = 300,                 /* ":"  */
+    T_SCOPE = 301,                 /* "::"  */
+    T_RANGE = 302,                 /* ".."  */
+    T_COMMA = 303,                 /* ","  */
+    T_OPEN = 304,                  /* "("  */
+    T_CLOSE = 305,                 /* ")"  */
+    T_OBJECT_OPEN = 306,           /* "{"  */
+    T_OBJECT_CLOSE = 307,          /* "}"  */
+    T_ARRAY_OPEN = 308,            /* "["  */
+    T_ARRAY_CLOSE = 309,           /* "]"  */
+    T_NIN = 310,                   /* T_NIN  */
+    UMINUS = 311,                  /* UMINUS  */
+    UPLUS = 312,                   /* UPLUS  */
+    FUNCCALL = 313,                /* FUNCCALL  */
+    REFERENCE = 314,               /* REFERENCE  */
+    INDEXED = 315                  /* INDEXED  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
 union YYSTYPE
 {
-#line 22 "arangod/Aql/grammar.y" /* yacc.c:355  */
+#line 22 "arangod/Aql/grammar.y"
 
   triagens::aql::AstNode*  node;
   char*                    strval;
   bool                     boolval;
   int64_t                  intval;
 
-#line 194 "arangod/Aql/grammar.cpp" /* yacc.c:355  */
+#line 131 "arangod/Aql/grammar.hpp"
+
 };
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
 #endif
@@ -212,12 +261,154 @@ struct YYLTYPE
 
 
 
+
 int Aqlparse (triagens::aql::Parser* parser);
 
+
 #endif /* !YY_AQL_ARANGOD_AQL_GRAMMAR_HPP_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of query string"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_T_FOR = 3,                      /* "FOR declaration"  */
+  YYSYMBOL_T_LET = 4,                      /* "LET declaration"  */
+  YYSYMBOL_T_FILTER = 5,                   /* "FILTER declaration"  */
+  YYSYMBOL_T_RETURN = 6,                   /* "RETURN declaration"  */
+  YYSYMBOL_T_COLLECT = 7,                  /* "COLLECT declaration"  */
+  YYSYMBOL_T_SORT = 8,                     /* "SORT declaration"  */
+  YYSYMBOL_T_LIMIT = 9,                    /* "LIMIT declaration"  */
+  YYSYMBOL_T_ASC = 10,                     /* "ASC keyword"  */
+  YYSYMBOL_T_DESC = 11,                    /* "DESC keyword"  */
+  YYSYMBOL_T_IN = 12,                      /* "IN keyword"  */
+  YYSYMBOL_T_WITH = 13,                    /* "WITH keyword"  */
+  YYSYMBOL_T_INTO = 14,                    /* "INTO keyword"  */
+  YYSYMBOL_T_REMOVE = 15,                  /* "REMOVE command"  */
+  YYSYMBOL_T_INSERT = 16,                  /* "INSERT command"  */
+  YYSYMBOL_T_UPDATE = 17,                  /* "UPDATE command"  */
+  YYSYMBOL_T_REPLACE = 18,                 /* "REPLACE command"  */
+  YYSYMBOL_T_UPSERT = 19,                  /* "UPSERT command"  */
+  YYSYMBOL_T_NULL = 20,                    /* "null"  */
+  YYSYMBOL_T_TRUE = 21,                    /* "true"  */
+  YYSYMBOL_T_FALSE = 22,                   /* "false"  */
+  YYSYMBOL_T_STRING = 23,                  /* "identifier"  */
+  YYSYMBOL_T_QUOTED_STRING = 24,           /* "quoted string"  */
+  YYSYMBOL_T_INTEGER = 25,                 /* "integer number"  */
+  YYSYMBOL_T_DOUBLE = 26,                  /* "number"  */
+  YYSYMBOL_T_PARAMETER = 27,               /* "bind parameter"  */
+  YYSYMBOL_T_ASSIGN = 28,                  /* "assignment"  */
+  YYSYMBOL_T_NOT = 29,                     /* "not operator"  */
+  YYSYMBOL_T_AND = 30,                     /* "and operator"  */
+  YYSYMBOL_T_OR = 31,                      /* "or operator"  */
+  YYSYMBOL_T_EQ = 32,                      /* "== operator"  */
+  YYSYMBOL_T_NE = 33,                      /* "!= operator"  */
+  YYSYMBOL_T_LT = 34,                      /* "< operator"  */
+  YYSYMBOL_T_GT = 35,                      /* "> operator"  */
+  YYSYMBOL_T_LE = 36,                      /* "<= operator"  */
+  YYSYMBOL_T_GE = 37,                      /* ">= operator"  */
+  YYSYMBOL_T_PLUS = 38,                    /* "+ operator"  */
+  YYSYMBOL_T_MINUS = 39,                   /* "- operator"  */
+  YYSYMBOL_T_TIMES = 40,                   /* "* operator"  */
+  YYSYMBOL_T_DIV = 41,                     /* "/ operator"  */
+  YYSYMBOL_T_MOD = 42,                     /* "% operator"  */
+  YYSYMBOL_T_EXPAND = 43,                  /* "[*] operator"  */
+  YYSYMBOL_T_QUESTION = 44,                /* "?"  */
+  YYSYMBOL_T_COLON = 45,                   /* ":"  */
+  YYSYMBOL_T_SCOPE = 46,                   /* "::"  */
+  YYSYMBOL_T_RANGE = 47,                   /* ".."  */
+  YYSYMBOL_T_COMMA = 48,                   /* ","  */
+  YYSYMBOL_T_OPEN = 49,                    /* "("  */
+  YYSYMBOL_T_CLOSE = 50,                   /* ")"  */
+  YYSYMBOL_T_OBJECT_OPEN = 51,             /* "{"  */
+  YYSYMBOL_T_OBJECT_CLOSE = 52,            /* "}"  */
+  YYSYMBOL_T_ARRAY_OPEN = 53,              /* "["  */
+  YYSYMBOL_T_ARRAY_CLOSE = 54,             /* "]"  */
+  YYSYMBOL_T_NIN = 55,                     /* T_NIN  */
+  YYSYMBOL_UMINUS = 56,                    /* UMINUS  */
+  YYSYMBOL_UPLUS = 57,                     /* UPLUS  */
+  YYSYMBOL_FUNCCALL = 58,                  /* FUNCCALL  */
+  YYSYMBOL_REFERENCE = 59,                 /* REFERENCE  */
+  YYSYMBOL_INDEXED = 60,                   /* INDEXED  */
+  YYSYMBOL_61_ = 61,                       /* '.'  */
+  YYSYMBOL_YYACCEPT = 62,                  /* $accept  */
+  YYSYMBOL_query = 63,                     /* query  */
+  YYSYMBOL_optional_post_modification_lets = 64, /* optional_post_modification_lets  */
+  YYSYMBOL_optional_post_modification_block = 65, /* optional_post_modification_block  */
+  YYSYMBOL_optional_statement_block_statements = 66, /* optional_statement_block_statements  */
+  YYSYMBOL_statement_block_statement = 67, /* statement_block_statement  */
+  YYSYMBOL_for_statement = 68,             /* for_statement  */
+  YYSYMBOL_filter_statement = 69,          /* filter_statement  */
+  YYSYMBOL_let_statement = 70,             /* let_statement  */
+  YYSYMBOL_let_list = 71,                  /* let_list  */
+  YYSYMBOL_let_element = 72,               /* let_element  */
+  YYSYMBOL_count_into = 73,                /* count_into  */
+  YYSYMBOL_collect_variable_list = 74,     /* collect_variable_list  */
+  YYSYMBOL_aggregate = 75,                 /* aggregate  */
+  YYSYMBOL_collect_statement = 76,         /* collect_statement  */
+  YYSYMBOL_collect_list = 77,              /* collect_list  */
+  YYSYMBOL_collect_element = 78,           /* collect_element  */
+  YYSYMBOL_optional_into = 79,             /* optional_into  */
+  YYSYMBOL_variable_list = 80,             /* variable_list  */
+  YYSYMBOL_keep = 81,                      /* keep  */
+  YYSYMBOL_sort_statement = 82,            /* sort_statement  */
+  YYSYMBOL_83_1 = 83,                      /* $@1  */
+  YYSYMBOL_sort_list = 84,                 /* sort_list  */
+  YYSYMBOL_sort_element = 85,              /* sort_element  */
+  YYSYMBOL_sort_direction = 86,            /* sort_direction  */
+  YYSYMBOL_limit_statement = 87,           /* limit_statement  */
+  YYSYMBOL_return_statement = 88,          /* return_statement  */
+  YYSYMBOL_in_or_into_collection = 89,     /* in_or_into_collection  */
+  YYSYMBOL_remove_statement = 90,          /* remove_statement  */
+  YYSYMBOL_insert_statement = 91,          /* insert_statement  */
+  YYSYMBOL_update_parameters = 92,         /* update_parameters  */
+  YYSYMBOL_update_statement = 93,          /* update_statement  */
+  YYSYMBOL_replace_parameters = 94,        /* replace_parameters  */
+  YYSYMBOL_replace_statement = 95,         /* replace_statement  */
+  YYSYMBOL_update_or_replace = 96,         /* update_or_replace  */
+  YYSYMBOL_upsert_statement = 97,          /* upsert_statement  */
+  YYSYMBOL_98_2 = 98,                      /* $@2  */
+  YYSYMBOL_expression = 99,                /* expression  */
+  YYSYMBOL_100_3 = 100,                    /* $@3  */
+  YYSYMBOL_function_name = 101,            /* function_name  */
+  YYSYMBOL_function_call = 102,            /* function_call  */
+  YYSYMBOL_103_4 = 103,                    /* $@4  */
+  YYSYMBOL_operator_unary = 104,           /* operator_unary  */
+  YYSYMBOL_operator_binary = 105,          /* operator_binary  */
+  YYSYMBOL_operator_ternary = 106,         /* operator_ternary  */
+  YYSYMBOL_optional_function_call_arguments = 107, /* optional_function_call_arguments  */
+  YYSYMBOL_expression_or_query = 108,      /* expression_or_query  */
+  YYSYMBOL_109_5 = 109,                    /* $@5  */
+  YYSYMBOL_function_arguments_list = 110,  /* function_arguments_list  */
+  YYSYMBOL_compound_type = 111,            /* compound_type  */
+  YYSYMBOL_array = 112,                    /* array  */
+  YYSYMBOL_113_6 = 113,                    /* $@6  */
+  YYSYMBOL_optional_array_elements = 114,  /* optional_array_elements  */
+  YYSYMBOL_array_elements_list = 115,      /* array_elements_list  */
+  YYSYMBOL_options = 116,                  /* options  */
+  YYSYMBOL_object = 117,                   /* object  */
+  YYSYMBOL_118_7 = 118,                    /* $@7  */
+  YYSYMBOL_optional_object_elements = 119, /* optional_object_elements  */
+  YYSYMBOL_object_elements_list = 120,     /* object_elements_list  */
+  YYSYMBOL_object_element = 121,           /* object_element  */
+  YYSYMBOL_reference = 122,                /* reference  */
+  YYSYMBOL_123_8 = 123,                    /* $@8  */
+  YYSYMBOL_single_reference = 124,         /* single_reference  */
+  YYSYMBOL_expansion = 125,                /* expansion  */
+  YYSYMBOL_atomic_value = 126,             /* atomic_value  */
+  YYSYMBOL_numeric_value = 127,            /* numeric_value  */
+  YYSYMBOL_value_literal = 128,            /* value_literal  */
+  YYSYMBOL_collection_name = 129,          /* collection_name  */
+  YYSYMBOL_bind_parameter = 130,           /* bind_parameter  */
+  YYSYMBOL_object_element_name = 131,      /* object_element_name  */
+  YYSYMBOL_variable_name = 132             /* variable_name  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Copy the second part of user declarations.  */
-#line 29 "arangod/Aql/grammar.y" /* yacc.c:358  */
+
+/* Second part of user prologue.  */
+#line 29 "arangod/Aql/grammar.y"
 
 
 using namespace triagens::aql;
@@ -251,34 +442,94 @@ void Aqlerror (YYLTYPE* locp,
 #define scanner parser->scanner()
 
 
-#line 255 "arangod/Aql/grammar.cpp" /* yacc.c:358  */
+#line 289 "arangod/Aql/grammar.cpp"
+
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef short int yytype_int16;
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -286,15 +537,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -308,47 +572,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -361,8 +621,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -427,8 +701,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -438,18 +711,19 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -462,11 +736,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -478,12 +752,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -495,28 +769,31 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  3
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   793
+#define YYLAST   771
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  62
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  72
+#define YYNNTS  71
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  157
+#define YYNRULES  158
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  273
+#define YYNSTATES  277
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   315
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -553,35 +830,42 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   203,   203,   205,   207,   209,   211,   213,   218,   220,
-     225,   229,   235,   237,   242,   244,   246,   248,   250,   252,
-     257,   266,   274,   279,   281,   286,   293,   303,   303,   317,
-     333,   360,   387,   419,   449,   451,   456,   463,   466,   472,
-     486,   503,   503,   517,   517,   528,   531,   537,   543,   546,
-     549,   552,   558,   563,   570,   578,   581,   587,   598,   609,
-     618,   630,   635,   644,   656,   661,   664,   670,   670,   726,
-     729,   729,   745,   748,   751,   754,   757,   760,   763,   769,
-     776,   793,   793,   805,   808,   811,   817,   820,   823,   826,
-     829,   832,   835,   838,   841,   844,   847,   850,   853,   856,
-     859,   865,   871,   873,   878,   881,   881,   900,   903,   909,
-     912,   918,   918,   927,   929,   934,   937,   943,   946,   960,
-     960,   969,   971,   976,   978,   983,   986,   989,  1004,  1008,
-    1008,  1032,  1068,  1075,  1079,  1083,  1090,  1095,  1100,  1105,
-    1109,  1113,  1120,  1123,  1129,  1136,  1146,  1149,  1152,  1155,
-    1158,  1164,  1171,  1178,  1192,  1198,  1205,  1214
+       0,   205,   205,   207,   209,   211,   213,   215,   220,   222,
+     227,   231,   237,   239,   244,   246,   248,   250,   252,   254,
+     259,   268,   276,   281,   283,   288,   295,   305,   311,   321,
+     337,   364,   391,   423,   450,   477,   514,   519,   526,   532,
+     535,   541,   558,   576,   586,   586,   597,   600,   606,   612,
+     615,   618,   621,   627,   632,   639,   647,   650,   656,   667,
+     678,   687,   699,   704,   713,   725,   730,   733,   739,   739,
+     795,   798,   798,   814,   817,   820,   823,   826,   829,   832,
+     838,   845,   862,   862,   874,   877,   880,   886,   889,   892,
+     895,   898,   901,   904,   907,   910,   913,   916,   919,   922,
+     925,   928,   934,   940,   942,   947,   950,   950,   969,   972,
+     978,   981,   987,   987,   996,   998,  1003,  1006,  1012,  1015,
+    1029,  1029,  1038,  1040,  1045,  1047,  1052,  1055,  1058,  1073,
+    1077,  1077,  1101,  1137,  1144,  1148,  1152,  1159,  1164,  1169,
+    1174,  1178,  1182,  1189,  1192,  1198,  1205,  1215,  1218,  1221,
+    1224,  1227,  1233,  1240,  1247,  1261,  1267,  1274,  1283
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "\"end of query string\"", "error", "$undefined", "\"FOR declaration\"",
-  "\"LET declaration\"", "\"FILTER declaration\"",
+  "\"end of query string\"", "error", "\"invalid token\"",
+  "\"FOR declaration\"", "\"LET declaration\"", "\"FILTER declaration\"",
   "\"RETURN declaration\"", "\"COLLECT declaration\"",
   "\"SORT declaration\"", "\"LIMIT declaration\"", "\"ASC keyword\"",
   "\"DESC keyword\"", "\"IN keyword\"", "\"WITH keyword\"",
@@ -600,261 +884,250 @@ static const char *const yytname[] =
   "optional_post_modification_block",
   "optional_statement_block_statements", "statement_block_statement",
   "for_statement", "filter_statement", "let_statement", "let_list",
-  "let_element", "count_into", "collect_variable_list", "$@1",
+  "let_element", "count_into", "collect_variable_list", "aggregate",
   "collect_statement", "collect_list", "collect_element", "optional_into",
-  "variable_list", "keep", "$@2", "sort_statement", "$@3", "sort_list",
+  "variable_list", "keep", "sort_statement", "$@1", "sort_list",
   "sort_element", "sort_direction", "limit_statement", "return_statement",
   "in_or_into_collection", "remove_statement", "insert_statement",
   "update_parameters", "update_statement", "replace_parameters",
-  "replace_statement", "update_or_replace", "upsert_statement", "$@4",
-  "expression", "$@5", "function_name", "function_call", "$@6",
+  "replace_statement", "update_or_replace", "upsert_statement", "$@2",
+  "expression", "$@3", "function_name", "function_call", "$@4",
   "operator_unary", "operator_binary", "operator_ternary",
-  "optional_function_call_arguments", "expression_or_query", "$@7",
-  "function_arguments_list", "compound_type", "array", "$@8",
+  "optional_function_call_arguments", "expression_or_query", "$@5",
+  "function_arguments_list", "compound_type", "array", "$@6",
   "optional_array_elements", "array_elements_list", "options", "object",
-  "$@9", "optional_object_elements", "object_elements_list",
-  "object_element", "reference", "$@10", "single_reference", "expansion",
+  "$@7", "optional_object_elements", "object_elements_list",
+  "object_element", "reference", "$@8", "single_reference", "expansion",
   "atomic_value", "numeric_value", "value_literal", "collection_name",
   "bind_parameter", "object_element_name", "variable_name", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,    46
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -114
+#define YYPACT_NINF (-118)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-114)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -154
+#define YYTABLE_NINF (-155)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-    -114,     8,   712,  -114,     2,     2,   719,   719,     7,  -114,
-     202,   719,   719,   719,   719,  -114,  -114,  -114,  -114,  -114,
-      57,  -114,  -114,  -114,  -114,    20,    20,    20,    20,    20,
-    -114,     3,   -17,  -114,    24,  -114,  -114,  -114,    -8,  -114,
-    -114,  -114,  -114,   719,   719,   719,   719,  -114,  -114,   626,
-     -10,  -114,  -114,  -114,  -114,  -114,  -114,  -114,    18,   -34,
-    -114,  -114,  -114,  -114,   626,    73,    90,     2,   719,    74,
-     500,   500,  -114,   402,  -114,   438,   719,     2,    90,    98,
-      56,  -114,  -114,  -114,  -114,  -114,   719,     2,   719,    97,
-      97,    97,   325,  -114,    26,   719,   719,   116,   719,   719,
-     719,   719,   719,   719,   719,   719,   719,   719,   719,   719,
-     719,   719,   719,   106,    81,    99,   719,    59,   125,    93,
-    -114,   101,  -114,   113,   102,  -114,   366,   202,   740,    45,
-      90,    90,   719,    90,   719,    90,   533,   119,  -114,    93,
-      90,  -114,  -114,  -114,   626,  -114,   626,  -114,   103,  -114,
-    -114,   107,   719,   104,   109,  -114,   110,   626,   100,   128,
-     162,   719,   642,   133,   657,   657,    96,    96,    96,    96,
-       6,     6,    97,    97,    97,   564,    51,  -114,   685,   -31,
-     201,  -114,  -114,     2,  -114,     2,   719,   719,  -114,  -114,
-    -114,  -114,  -114,    28,    17,    33,  -114,  -114,  -114,  -114,
-    -114,  -114,  -114,   500,  -114,   500,  -114,   719,   719,     2,
-    -114,  -114,   719,   232,  -114,    26,   719,  -114,   719,   162,
-     719,   626,   114,  -114,  -114,   130,   719,    61,     5,  -114,
-    -114,  -114,   626,  -114,    90,    90,   469,   595,   134,  -114,
-     626,   138,  -114,   626,   626,   626,  -114,  -114,   719,   263,
-    -114,  -114,   719,    89,  -114,  -114,  -114,  -114,   719,  -114,
-       2,   719,  -114,  -114,   294,  -114,  -114,   500,  -114,   626,
-    -114,    90,  -114
+    -118,    35,   690,  -118,    18,    18,   697,   697,    50,  -118,
+     129,   697,   697,   697,   697,  -118,  -118,  -118,  -118,  -118,
+      62,  -118,  -118,  -118,  -118,    17,    17,    17,    17,    17,
+    -118,    32,    -1,  -118,    38,  -118,  -118,  -118,   -29,  -118,
+    -118,  -118,  -118,   697,   697,   697,   697,  -118,  -118,   621,
+      23,  -118,  -118,  -118,  -118,  -118,  -118,  -118,    52,   -34,
+    -118,  -118,  -118,  -118,   621,    88,    18,    89,    89,    65,
+    -118,    95,   697,    80,   495,   495,  -118,    20,  -118,   433,
+     697,    18,    89,   125,   133,  -118,  -118,  -118,  -118,  -118,
+     697,    18,   697,   130,   130,   130,   356,  -118,    93,   697,
+     697,   146,   697,   697,   697,   697,   697,   697,   697,   697,
+     697,   697,   697,   697,   697,   697,   697,   137,   113,   121,
+     697,    58,   157,    65,   122,  -118,  -118,    18,   697,   124,
+    -118,   397,   129,   718,   102,    89,    89,   697,    89,   697,
+      89,   528,   148,  -118,    -8,    89,    89,  -118,  -118,  -118,
+     621,  -118,   621,  -118,   127,  -118,  -118,   134,   697,   132,
+     138,  -118,   135,   621,   136,   140,   414,   697,   198,   162,
+     635,   635,   128,   128,   128,   128,   -11,   -11,   130,   130,
+     130,   559,   214,  -118,   663,    30,   232,  -118,  -118,    18,
+    -118,  -118,   621,   697,  -118,  -118,  -118,  -118,  -118,    22,
+      42,   115,  -118,  -118,  -118,  -118,  -118,  -118,  -118,   495,
+    -118,   495,  -118,   697,   697,   141,    95,  -118,  -118,  -118,
+     697,   263,  -118,    93,   697,  -118,   697,   414,   697,   621,
+     131,  -118,  -118,   145,   697,   107,    71,  -118,  -118,  -118,
+      89,    89,   464,   590,    18,   621,   160,  -118,   621,   621,
+     621,  -118,  -118,   697,   294,  -118,  -118,   697,   117,  -118,
+    -118,  -118,  -118,   697,  -118,  -118,   697,  -118,  -118,   325,
+    -118,  -118,   495,   621,  -118,    89,  -118
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-      12,     0,     0,     1,     0,     0,     0,     0,    27,    43,
-       0,     0,     0,     0,     0,    67,    13,    14,    16,    15,
-      37,    17,    18,    19,     2,    10,    10,    10,    10,    10,
-     157,     0,    22,    23,     0,   148,   149,   150,   131,   146,
-     144,   145,   154,     0,     0,     0,    70,   119,   111,    21,
-      81,   132,    72,    73,    74,    75,   109,   110,    77,   128,
-      76,   147,   142,   143,    54,     0,   117,     0,     0,    52,
-       0,     0,    61,     0,    64,     0,     0,     0,   117,   117,
-       0,     3,     4,     5,     6,     7,     0,     0,     0,    85,
-      83,    84,     0,    12,   121,   113,     0,     0,     0,     0,
+      12,     0,     0,     1,     0,     0,     0,     0,     0,    44,
+       0,     0,     0,     0,     0,    68,    13,    14,    16,    15,
+      39,    17,    18,    19,     2,    10,    10,    10,    10,    10,
+     158,     0,    22,    23,     0,   149,   150,   151,   132,   147,
+     145,   146,   155,     0,     0,     0,    71,   120,   112,    21,
+      82,   133,    73,    74,    75,    76,   110,   111,    78,   129,
+      77,   148,   143,   144,    55,     0,   158,   118,   118,    27,
+      36,     0,     0,    53,     0,     0,    62,     0,    65,     0,
+       0,     0,   118,   118,     0,     3,     4,     5,     6,     7,
+       0,     0,     0,    86,    84,    85,     0,    12,   122,   114,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-      29,    28,    34,     0,    44,    45,    48,     0,     0,     0,
-     117,   117,     0,   117,     0,   117,     0,    38,    30,    41,
-     117,    31,     9,    11,    20,    24,    25,    69,     0,   155,
-     156,     0,     0,     0,   122,   123,     0,   115,     0,   114,
-      99,     0,    87,    86,    93,    94,    95,    96,    97,    98,
-      88,    89,    90,    91,    92,     0,    78,    80,   105,     0,
-       0,   133,   134,     0,   118,     0,     0,     0,    49,    50,
-      47,    51,    53,   131,   146,   154,    55,   151,   152,   153,
-      56,    57,    58,     0,    59,     0,    62,     0,     0,     0,
-      32,    71,     0,     0,   120,     0,     0,   112,     0,   100,
-       0,   104,     0,   107,    12,   103,     0,     0,   130,   135,
-      26,    35,    36,    46,   117,   117,     0,   117,    42,    39,
-     127,     0,   124,   125,   116,   101,    82,   106,   105,     0,
-     136,   137,     0,     0,    60,    63,    65,    66,     0,    33,
-       0,     0,   108,   138,     0,   139,   140,     0,    40,   126,
-     141,   117,    68
+       0,     0,     0,    28,     0,    29,    34,     0,     0,    45,
+      46,    49,     0,     0,     0,   118,   118,     0,   118,     0,
+     118,     0,    40,    30,     0,   118,   118,    31,     9,    11,
+      20,    24,    25,    70,     0,   156,   157,     0,     0,     0,
+     123,   124,     0,   116,     0,   115,   100,     0,    88,    87,
+      94,    95,    96,    97,    98,    99,    89,    90,    91,    92,
+      93,     0,    79,    81,   106,     0,     0,   134,   135,     0,
+     119,    37,    38,     0,    50,    51,    48,    52,    54,   132,
+     147,   155,    56,   152,   153,   154,    57,    58,    59,     0,
+      60,     0,    63,     0,     0,    43,    41,    35,    32,    72,
+       0,     0,   121,     0,     0,   113,     0,   101,     0,   105,
+       0,   108,    12,   104,     0,     0,   131,   136,    26,    47,
+     118,   118,     0,   118,     0,   128,     0,   125,   126,   117,
+     102,    83,   107,   106,     0,   137,   138,     0,     0,    61,
+      64,    66,    67,     0,    33,    42,     0,   109,   139,     0,
+     140,   141,     0,   127,   142,   118,    69
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -114,   -92,  -114,    91,  -114,  -114,  -114,  -114,   108,  -114,
-     105,   164,  -114,  -114,  -114,  -114,     1,  -114,  -114,  -114,
-    -114,  -114,  -114,  -114,     0,  -114,  -114,   132,   -57,  -114,
-    -114,  -114,  -114,  -114,  -114,  -114,  -114,  -114,    -1,  -114,
-    -114,  -114,  -114,  -114,  -114,  -114,  -114,   -59,  -114,  -114,
-    -114,  -114,  -114,  -114,  -114,   -76,  -110,  -114,  -114,  -114,
-     -25,  -114,  -114,  -114,  -114,    -3,  -114,  -114,    64,  -113,
-    -114,    -4
+    -118,   -85,  -118,   197,  -118,  -118,  -118,  -118,   164,  -118,
+     120,   192,  -118,   158,  -118,   205,    92,  -118,  -118,  -118,
+    -118,  -118,  -118,    28,  -118,  -118,   165,   -66,  -118,  -118,
+    -118,  -118,  -118,  -118,  -118,  -118,  -118,    -6,  -118,  -118,
+    -118,  -118,  -118,  -118,  -118,  -118,   -38,  -118,  -118,  -118,
+    -118,  -118,  -118,  -118,   -58,  -108,  -118,  -118,  -118,    -7,
+    -118,  -118,  -118,  -118,     4,  -118,  -118,   112,  -117,  -118,
+      -2
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-      -1,     1,    80,    81,     2,    16,    17,    18,    19,    32,
-      33,    66,    20,    67,    21,   121,   122,    79,   238,   140,
-     209,    22,    68,   124,   125,   190,    23,    24,   130,    25,
-      26,    72,    27,    74,    28,   258,    29,    76,   126,    93,
-      50,    51,   114,    52,    53,    54,   222,   223,   224,   225,
-      55,    56,    95,   158,   159,   120,    57,    94,   153,   154,
-     155,    58,   115,    59,   228,    60,    61,    62,   196,    63,
-     156,    34
+       0,     1,    84,    85,     2,    16,    17,    18,    19,    32,
+      33,    67,    20,    68,    21,   123,    70,    83,   215,   146,
+      22,    72,   129,   130,   196,    23,    24,   135,    25,    26,
+      76,    27,    78,    28,   263,    29,    80,   131,    97,    50,
+      51,   118,    52,    53,    54,   230,   231,   232,   233,    55,
+      56,    99,   164,   165,   125,    57,    98,   159,   160,   161,
+      58,   119,    59,   236,    60,    61,    62,   202,    63,   162,
+      71
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      31,   148,   138,   141,   182,    49,    64,    69,     3,   184,
-      70,    71,    73,    75,   131,    86,   133,  -152,   135,   116,
-      65,  -152,   226,  -152,    -8,    30,    -8,   117,  -151,   184,
-     227,    87,  -151,  -153,  -151,    97,   113,  -153,   -79,  -153,
-    -152,   -79,    89,    90,    91,    92,   108,   109,   110,   149,
-     150,  -151,    88,   151,   201,   202,  -153,   204,   252,   206,
-       5,  -129,     7,   123,   210,  -152,   253,  -152,   197,   198,
-      65,    77,   199,   137,   -79,   136,  -151,   -79,  -151,   152,
-      97,  -153,   181,  -153,   250,   144,    42,   146,    42,   106,
-     107,   108,   109,   110,   157,   160,   118,   162,   163,   164,
-     165,   166,   167,   168,   169,   170,   171,   172,   173,   174,
-     175,   176,   265,   119,   251,   180,    42,    82,    83,    84,
-      85,   139,   127,   191,   192,    97,    97,   160,   161,   177,
-     178,   203,   247,   205,   106,   107,   108,   109,   110,   183,
-     266,   186,   179,   112,    47,    96,   234,   208,   235,   185,
-     187,   213,   212,   211,   217,   216,   214,   215,   254,   255,
-     219,   259,    97,    98,   246,   100,   101,   102,   103,   104,
-     105,   106,   107,   108,   109,   110,   218,   221,   248,   230,
-     112,   123,   260,   261,    78,   232,   231,   233,   142,   262,
-     242,    97,   145,   200,     0,   272,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,   239,   236,   237,     0,   112,
-     271,   240,   143,    96,     0,   243,     0,   244,     0,   245,
-       0,     0,    35,    36,    37,   249,    39,    40,    41,    42,
-      97,    98,    99,   100,   101,   102,   103,   104,   105,   106,
-     107,   108,   109,   110,    96,   111,     0,   221,   112,     0,
-       0,   264,     0,     0,     0,   229,   268,   267,     0,     0,
-     269,    97,    98,    99,   100,   101,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,    96,   111,     0,     0,   112,
-       0,     0,     0,     0,     0,     0,   241,     0,     0,     0,
-       0,     0,    97,    98,    99,   100,   101,   102,   103,   104,
-     105,   106,   107,   108,   109,   110,    96,   111,     0,     0,
-     112,     0,     0,     0,     0,     0,     0,   263,     0,     0,
-       0,     0,     0,    97,    98,    99,   100,   101,   102,   103,
-     104,   105,   106,   107,   108,   109,   110,    96,   111,     0,
-       0,   112,     0,     0,     0,     0,     0,     0,   270,     0,
-       0,     0,     0,     0,    97,    98,    99,   100,   101,   102,
-     103,   104,   105,   106,   107,   108,   109,   110,     0,   111,
-       0,     0,   112,     0,     0,   147,   188,   189,    96,     0,
-       0,     0,     0,     0,     0,     0,    35,    36,    37,     0,
-      39,    40,    41,    42,     0,    97,    98,    99,   100,   101,
-     102,   103,   104,   105,   106,   107,   108,   109,   110,     0,
-     111,     0,     0,   112,   128,   132,   129,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    97,    98,    99,   100,   101,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,     0,   111,     0,     0,   112,
-     128,   134,   129,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,    97,    98,    99,
-     100,   101,   102,   103,   104,   105,   106,   107,   108,   109,
-     110,    96,   111,     0,     0,   112,   256,   257,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    97,    98,
-      99,   100,   101,   102,   103,   104,   105,   106,   107,   108,
-     109,   110,   128,   111,   129,     0,   112,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    97,
-      98,    99,   100,   101,   102,   103,   104,   105,   106,   107,
-     108,   109,   110,     0,   111,    96,     0,   112,     0,   207,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,    97,    98,    99,   100,   101,   102,   103,   104,
-     105,   106,   107,   108,   109,   110,    96,   111,     0,     0,
-     112,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,    97,    98,    99,   100,   101,   102,   103,
-     104,   105,   106,   107,   108,   109,   110,    96,   111,   220,
-       0,   112,     0,     0,     0,     0,     0,     0,   119,     0,
-       0,     0,     0,     0,    97,    98,    99,   100,   101,   102,
-     103,   104,   105,   106,   107,   108,   109,   110,    96,   111,
-       0,     0,   112,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,    96,    97,    98,    99,   100,   101,
-     102,   103,   104,   105,   106,   107,   108,   109,   110,    96,
-     111,    97,     0,   112,   100,   101,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,     0,    97,     0,     0,   112,
-       0,   102,   103,   104,   105,   106,   107,   108,   109,   110,
-       0,     0,     0,     0,   112,    35,    36,    37,    38,    39,
-      40,    41,    42,     0,    43,     4,     5,     6,     7,     8,
-       9,    10,     0,    44,    45,     0,     0,    11,    12,    13,
-      14,    15,     0,     0,    46,  -102,    47,     0,    48,    35,
-      36,    37,    38,    39,    40,    41,    42,     0,    43,     0,
-       0,     0,     0,     0,     0,     0,     0,    44,    45,     0,
-      35,    36,    37,   193,   194,    40,    41,   195,    46,    43,
-      47,     0,    48,     0,     0,     0,     0,     0,    44,    45,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    46,
-       0,    47,     0,    48
+      49,    64,    31,    34,   188,    74,    75,    77,    79,   136,
+     126,   138,   154,   140,    73,    30,   190,   -80,   101,   120,
+     -80,    -8,  -152,    -8,   143,   147,  -152,   121,  -152,   112,
+     113,   114,   133,   137,   134,     3,   190,    93,    94,    95,
+      96,    30,  -153,    47,    90,  -152,  -153,    91,  -153,   101,
+     102,   103,   104,   105,   106,   107,   108,   109,   110,   111,
+     112,   113,   114,    65,   115,  -153,    92,   116,   -80,   117,
+    -152,   -80,  -152,    66,   141,    65,    81,   207,   208,   142,
+     210,   187,   212,   234,   150,    42,   152,   217,   218,    34,
+    -153,   235,  -153,   163,   166,  -130,   168,   169,   170,   171,
+     172,   173,   174,   175,   176,   177,   178,   179,   180,   181,
+     182,   122,   124,   127,   186,  -154,   155,   156,   256,  -154,
+     157,  -154,   192,   128,   257,   203,   204,   166,   132,   205,
+     255,   209,   258,   211,    42,   197,   198,     5,  -154,     7,
+     270,   271,   216,   240,    42,   241,   158,   252,   144,    35,
+      36,    37,   221,    39,    40,    41,    42,   101,   167,   101,
+     183,   227,   184,  -154,   185,  -154,   110,   111,   112,   113,
+     114,   189,   193,    47,   100,   116,   214,   219,   229,   220,
+     224,   251,   259,   260,   222,   264,   223,   238,   226,   244,
+     225,   101,   102,   253,   104,   105,   106,   107,   108,   109,
+     110,   111,   112,   113,   114,   266,   275,   242,   243,   116,
+     100,   151,    82,    69,   245,   267,   247,   276,   248,   191,
+     249,   239,   250,    86,    87,    88,    89,   101,   254,     0,
+     104,   105,   106,   107,   108,   109,   110,   111,   112,   113,
+     114,   145,   265,   101,   100,   116,   206,   229,   148,   149,
+       0,   269,   110,   111,   112,   113,   114,   272,     0,     0,
+     273,   101,   102,   103,   104,   105,   106,   107,   108,   109,
+     110,   111,   112,   113,   114,   100,   115,     0,     0,   116,
+       0,     0,     0,     0,     0,     0,   237,     0,     0,     0,
+       0,     0,   101,   102,   103,   104,   105,   106,   107,   108,
+     109,   110,   111,   112,   113,   114,   100,   115,     0,     0,
+     116,     0,     0,     0,     0,     0,     0,   246,     0,     0,
+       0,     0,     0,   101,   102,   103,   104,   105,   106,   107,
+     108,   109,   110,   111,   112,   113,   114,   100,   115,     0,
+       0,   116,     0,     0,     0,     0,     0,     0,   268,     0,
+       0,     0,     0,     0,   101,   102,   103,   104,   105,   106,
+     107,   108,   109,   110,   111,   112,   113,   114,   100,   115,
+       0,     0,   116,     0,     0,     0,     0,     0,     0,   274,
+       0,     0,     0,     0,     0,   101,   102,   103,   104,   105,
+     106,   107,   108,   109,   110,   111,   112,   113,   114,     0,
+     115,     0,     0,   116,     0,     0,   153,   194,   195,   100,
+       0,     0,     0,     0,     0,     0,     0,    35,    36,    37,
+       0,    39,    40,    41,    42,     0,   101,   102,   103,   104,
+     105,   106,   107,   108,   109,   110,   111,   112,   113,   114,
+       0,   115,     0,   101,   116,   133,   139,   134,   106,   107,
+     108,   109,   110,   111,   112,   113,   114,     0,     0,     0,
+       0,   116,   101,   102,   103,   104,   105,   106,   107,   108,
+     109,   110,   111,   112,   113,   114,   100,   115,     0,     0,
+     116,   261,   262,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,   101,   102,   103,   104,   105,   106,   107,
+     108,   109,   110,   111,   112,   113,   114,   133,   115,   134,
+       0,   116,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   101,   102,   103,   104,   105,   106,
+     107,   108,   109,   110,   111,   112,   113,   114,     0,   115,
+     100,     0,   116,     0,   213,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   101,   102,   103,
+     104,   105,   106,   107,   108,   109,   110,   111,   112,   113,
+     114,   100,   115,     0,     0,   116,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   101,   102,
+     103,   104,   105,   106,   107,   108,   109,   110,   111,   112,
+     113,   114,   100,   115,   228,     0,   116,     0,     0,     0,
+       0,     0,     0,   124,     0,     0,     0,     0,     0,   101,
+     102,   103,   104,   105,   106,   107,   108,   109,   110,   111,
+     112,   113,   114,   100,   115,     0,     0,   116,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   100,     0,     0,
+     101,   102,   103,   104,   105,   106,   107,   108,   109,   110,
+     111,   112,   113,   114,   101,   115,     0,     0,   116,   106,
+     107,   108,   109,   110,   111,   112,   113,   114,     0,     0,
+       0,     0,   116,    35,    36,    37,    38,    39,    40,    41,
+      42,     0,    43,     4,     5,     6,     7,     8,     9,    10,
+       0,    44,    45,     0,     0,    11,    12,    13,    14,    15,
+       0,     0,    46,  -103,    47,     0,    48,    35,    36,    37,
+      38,    39,    40,    41,    42,     0,    43,     0,     0,     0,
+       0,     0,     0,     0,     0,    44,    45,     0,    35,    36,
+      37,   199,   200,    40,    41,   201,    46,    43,    47,     0,
+      48,     0,     0,     0,     0,     0,    44,    45,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    46,     0,    47,
+       0,    48
 };
 
 static const yytype_int16 yycheck[] =
 {
-       4,    93,    78,    79,   117,     6,     7,    10,     0,   119,
-      11,    12,    13,    14,    71,    12,    73,     0,    75,    53,
-      13,     4,    53,     6,     4,    23,     6,    61,     0,   139,
-      61,    48,     4,     0,     6,    29,    46,     4,    46,     6,
-      23,    49,    43,    44,    45,    46,    40,    41,    42,    23,
-      24,    23,    28,    27,   130,   131,    23,   133,    53,   135,
-       4,    43,     6,    67,   140,    48,    61,    50,    23,    24,
-      13,    14,    27,    77,    46,    76,    48,    49,    50,    53,
-      29,    48,    23,    50,    23,    86,    27,    88,    27,    38,
-      39,    40,    41,    42,    95,    96,    23,    98,    99,   100,
-     101,   102,   103,   104,   105,   106,   107,   108,   109,   110,
-     111,   112,    23,    23,   227,   116,    27,    26,    27,    28,
-      29,    23,    48,   126,   127,    29,    29,   128,    12,    23,
-      49,   132,   224,   134,    38,    39,    40,    41,    42,    14,
-     253,    28,    43,    47,    51,    12,   203,    28,   205,    48,
-      48,   152,    45,    50,    54,    45,    52,    48,   234,   235,
-     161,   237,    29,    30,    50,    32,    33,    34,    35,    36,
-      37,    38,    39,    40,    41,    42,    48,   178,    48,   183,
-      47,   185,    48,    45,    20,   186,   185,   187,    80,   248,
-     215,    29,    87,   129,    -1,   271,    34,    35,    36,    37,
-      38,    39,    40,    41,    42,   209,   207,   208,    -1,    47,
-     267,   212,    80,    12,    -1,   216,    -1,   218,    -1,   220,
-      -1,    -1,    20,    21,    22,   226,    24,    25,    26,    27,
-      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
-      39,    40,    41,    42,    12,    44,    -1,   248,    47,    -1,
-      -1,   252,    -1,    -1,    -1,    54,   260,   258,    -1,    -1,
-     261,    29,    30,    31,    32,    33,    34,    35,    36,    37,
+       6,     7,     4,     5,   121,    11,    12,    13,    14,    75,
+      68,    77,    97,    79,    10,    23,   124,    46,    29,    53,
+      49,     4,     0,     6,    82,    83,     4,    61,     6,    40,
+      41,    42,    12,    13,    14,     0,   144,    43,    44,    45,
+      46,    23,     0,    51,    12,    23,     4,    48,     6,    29,
+      30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
+      40,    41,    42,    13,    44,    23,    28,    47,    46,    46,
+      48,    49,    50,    23,    80,    13,    14,   135,   136,    81,
+     138,    23,   140,    53,    90,    27,    92,   145,   146,    91,
+      48,    61,    50,    99,   100,    43,   102,   103,   104,   105,
+     106,   107,   108,   109,   110,   111,   112,   113,   114,   115,
+     116,    23,    23,    48,   120,     0,    23,    24,   235,     4,
+      27,     6,   128,    28,    53,    23,    24,   133,    48,    27,
+      23,   137,    61,   139,    27,   131,   132,     4,    23,     6,
+      23,   258,   144,   209,    27,   211,    53,   232,    23,    20,
+      21,    22,   158,    24,    25,    26,    27,    29,    12,    29,
+      23,   167,    49,    48,    43,    50,    38,    39,    40,    41,
+      42,    14,    48,    51,    12,    47,    28,    50,   184,    45,
+      45,    50,   240,   241,    52,   243,    48,   189,    48,    48,
+      54,    29,    30,    48,    32,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    45,   272,   213,   214,    47,
+      12,    91,    20,     8,   220,   253,   223,   275,   224,   127,
+     226,   193,   228,    26,    27,    28,    29,    29,   234,    -1,
+      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
+      42,    83,   244,    29,    12,    47,   134,   253,    84,    84,
+      -1,   257,    38,    39,    40,    41,    42,   263,    -1,    -1,
+     266,    29,    30,    31,    32,    33,    34,    35,    36,    37,
       38,    39,    40,    41,    42,    12,    44,    -1,    -1,    47,
       -1,    -1,    -1,    -1,    -1,    -1,    54,    -1,    -1,    -1,
       -1,    -1,    29,    30,    31,    32,    33,    34,    35,    36,
@@ -864,162 +1137,160 @@ static const yytype_int16 yycheck[] =
       36,    37,    38,    39,    40,    41,    42,    12,    44,    -1,
       -1,    47,    -1,    -1,    -1,    -1,    -1,    -1,    54,    -1,
       -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    -1,    44,
-      -1,    -1,    47,    -1,    -1,    50,    10,    11,    12,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    20,    21,    22,    -1,
-      24,    25,    26,    27,    -1,    29,    30,    31,    32,    33,
+      35,    36,    37,    38,    39,    40,    41,    42,    12,    44,
+      -1,    -1,    47,    -1,    -1,    -1,    -1,    -1,    -1,    54,
+      -1,    -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,
       34,    35,    36,    37,    38,    39,    40,    41,    42,    -1,
-      44,    -1,    -1,    47,    12,    13,    14,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    29,    30,    31,    32,    33,    34,    35,    36,    37,
-      38,    39,    40,    41,    42,    -1,    44,    -1,    -1,    47,
-      12,    13,    14,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      44,    -1,    -1,    47,    -1,    -1,    50,    10,    11,    12,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    20,    21,    22,
+      -1,    24,    25,    26,    27,    -1,    29,    30,    31,    32,
+      33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
+      -1,    44,    -1,    29,    47,    12,    13,    14,    34,    35,
+      36,    37,    38,    39,    40,    41,    42,    -1,    -1,    -1,
+      -1,    47,    29,    30,    31,    32,    33,    34,    35,    36,
+      37,    38,    39,    40,    41,    42,    12,    44,    -1,    -1,
+      47,    17,    18,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    29,    30,    31,    32,    33,    34,    35,
+      36,    37,    38,    39,    40,    41,    42,    12,    44,    14,
+      -1,    47,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    -1,    44,
+      12,    -1,    47,    -1,    16,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,    30,    31,
       32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,    12,    44,    -1,    -1,    47,    17,    18,    -1,    -1,
+      42,    12,    44,    -1,    -1,    47,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,    30,
       31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
-      41,    42,    12,    44,    14,    -1,    47,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,
+      41,    42,    12,    44,    45,    -1,    47,    -1,    -1,    -1,
+      -1,    -1,    -1,    23,    -1,    -1,    -1,    -1,    -1,    29,
       30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
-      40,    41,    42,    -1,    44,    12,    -1,    47,    -1,    16,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    29,    30,    31,    32,    33,    34,    35,    36,
-      37,    38,    39,    40,    41,    42,    12,    44,    -1,    -1,
-      47,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    29,    30,    31,    32,    33,    34,    35,
-      36,    37,    38,    39,    40,    41,    42,    12,    44,    45,
-      -1,    47,    -1,    -1,    -1,    -1,    -1,    -1,    23,    -1,
-      -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    12,    44,
-      -1,    -1,    47,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    12,    29,    30,    31,    32,    33,
-      34,    35,    36,    37,    38,    39,    40,    41,    42,    12,
-      44,    29,    -1,    47,    32,    33,    34,    35,    36,    37,
-      38,    39,    40,    41,    42,    -1,    29,    -1,    -1,    47,
-      -1,    34,    35,    36,    37,    38,    39,    40,    41,    42,
-      -1,    -1,    -1,    -1,    47,    20,    21,    22,    23,    24,
-      25,    26,    27,    -1,    29,     3,     4,     5,     6,     7,
-       8,     9,    -1,    38,    39,    -1,    -1,    15,    16,    17,
-      18,    19,    -1,    -1,    49,    50,    51,    -1,    53,    20,
-      21,    22,    23,    24,    25,    26,    27,    -1,    29,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    38,    39,    -1,
-      20,    21,    22,    23,    24,    25,    26,    27,    49,    29,
-      51,    -1,    53,    -1,    -1,    -1,    -1,    -1,    38,    39,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    49,
-      -1,    51,    -1,    53
+      40,    41,    42,    12,    44,    -1,    -1,    47,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    12,    -1,    -1,
+      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    29,    44,    -1,    -1,    47,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    -1,    -1,
+      -1,    -1,    47,    20,    21,    22,    23,    24,    25,    26,
+      27,    -1,    29,     3,     4,     5,     6,     7,     8,     9,
+      -1,    38,    39,    -1,    -1,    15,    16,    17,    18,    19,
+      -1,    -1,    49,    50,    51,    -1,    53,    20,    21,    22,
+      23,    24,    25,    26,    27,    -1,    29,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    38,    39,    -1,    20,    21,
+      22,    23,    24,    25,    26,    27,    49,    29,    51,    -1,
+      53,    -1,    -1,    -1,    -1,    -1,    38,    39,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    49,    -1,    51,
+      -1,    53
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_uint8 yystos[] =
 {
        0,    63,    66,     0,     3,     4,     5,     6,     7,     8,
        9,    15,    16,    17,    18,    19,    67,    68,    69,    70,
-      74,    76,    83,    88,    89,    91,    92,    94,    96,    98,
-      23,   133,    71,    72,   133,    20,    21,    22,    23,    24,
-      25,    26,    27,    29,    38,    39,    49,    51,    53,   100,
-     102,   103,   105,   106,   107,   112,   113,   118,   123,   125,
-     127,   128,   129,   131,   100,    13,    73,    75,    84,   127,
-     100,   100,    93,   100,    95,   100,    99,    14,    73,    79,
-      64,    65,    65,    65,    65,    65,    12,    48,    28,   100,
-     100,   100,   100,   101,   119,   114,    12,    29,    30,    31,
-      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,    44,    47,    46,   104,   124,    53,    61,    23,    23,
-     117,    77,    78,   133,    85,    86,   100,    48,    12,    14,
-      90,    90,    13,    90,    13,    90,   100,   133,   117,    23,
-      81,   117,    70,    89,   100,    72,   100,    50,    63,    23,
-      24,    27,    53,   120,   121,   122,   132,   100,   115,   116,
-     100,    12,   100,   100,   100,   100,   100,   100,   100,   100,
-     100,   100,   100,   100,   100,   100,   100,    23,    49,    43,
-     100,    23,   131,    14,   118,    48,    28,    48,    10,    11,
-      87,   127,   127,    23,    24,    27,   130,    23,    24,    27,
-     130,   117,   117,   100,   117,   100,   117,    16,    28,    82,
-     117,    50,    45,   100,    52,    48,    45,    54,    48,   100,
-      45,   100,   108,   109,   110,   111,    53,    61,   126,    54,
-     133,    78,   100,    86,    90,    90,   100,   100,    80,   133,
-     100,    54,   122,   100,   100,   100,    50,    63,    48,   100,
-      23,   131,    53,    61,   117,   117,    17,    18,    97,   117,
-      48,    45,   109,    54,   100,    23,   131,   100,   133,   100,
-      54,    90,   117
+      74,    76,    82,    87,    88,    90,    91,    93,    95,    97,
+      23,   132,    71,    72,   132,    20,    21,    22,    23,    24,
+      25,    26,    27,    29,    38,    39,    49,    51,    53,    99,
+     101,   102,   104,   105,   106,   111,   112,   117,   122,   124,
+     126,   127,   128,   130,    99,    13,    23,    73,    75,    77,
+      78,   132,    83,   126,    99,    99,    92,    99,    94,    99,
+      98,    14,    73,    79,    64,    65,    65,    65,    65,    65,
+      12,    48,    28,    99,    99,    99,    99,   100,   118,   113,
+      12,    29,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    44,    47,    46,   103,   123,
+      53,    61,    23,    77,    23,   116,   116,    48,    28,    84,
+      85,    99,    48,    12,    14,    89,    89,    13,    89,    13,
+      89,    99,   132,   116,    23,    75,    81,   116,    70,    88,
+      99,    72,    99,    50,    63,    23,    24,    27,    53,   119,
+     120,   121,   131,    99,   114,   115,    99,    12,    99,    99,
+      99,    99,    99,    99,    99,    99,    99,    99,    99,    99,
+      99,    99,    99,    23,    49,    43,    99,    23,   130,    14,
+     117,    78,    99,    48,    10,    11,    86,   126,   126,    23,
+      24,    27,   129,    23,    24,    27,   129,   116,   116,    99,
+     116,    99,   116,    16,    28,    80,   132,   116,   116,    50,
+      45,    99,    52,    48,    45,    54,    48,    99,    45,    99,
+     107,   108,   109,   110,    53,    61,   125,    54,   132,    85,
+      89,    89,    99,    99,    48,    99,    54,   121,    99,    99,
+      99,    50,    63,    48,    99,    23,   130,    53,    61,   116,
+     116,    17,    18,    96,   116,   132,    45,   108,    54,    99,
+      23,   130,    99,    99,    54,    89,   116
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_uint8 yyr1[] =
 {
        0,    62,    63,    63,    63,    63,    63,    63,    64,    64,
       65,    65,    66,    66,    67,    67,    67,    67,    67,    67,
-      68,    69,    70,    71,    71,    72,    73,    75,    74,    76,
-      76,    76,    76,    76,    77,    77,    78,    79,    79,    80,
-      80,    82,    81,    84,    83,    85,    85,    86,    87,    87,
-      87,    87,    88,    88,    89,    90,    90,    91,    92,    93,
-      93,    94,    95,    95,    96,    97,    97,    99,    98,   100,
-     101,   100,   100,   100,   100,   100,   100,   100,   100,   102,
-     102,   104,   103,   105,   105,   105,   106,   106,   106,   106,
-     106,   106,   106,   106,   106,   106,   106,   106,   106,   106,
-     106,   107,   108,   108,   109,   110,   109,   111,   111,   112,
-     112,   114,   113,   115,   115,   116,   116,   117,   117,   119,
-     118,   120,   120,   121,   121,   122,   122,   122,   123,   124,
-     123,   125,   125,   125,   125,   125,   126,   126,   126,   126,
-     126,   126,   127,   127,   128,   128,   129,   129,   129,   129,
-     129,   130,   130,   130,   131,   132,   132,   133
+      68,    69,    70,    71,    71,    72,    73,    74,    75,    76,
+      76,    76,    76,    76,    76,    76,    77,    77,    78,    79,
+      79,    80,    80,    81,    83,    82,    84,    84,    85,    86,
+      86,    86,    86,    87,    87,    88,    89,    89,    90,    91,
+      92,    92,    93,    94,    94,    95,    96,    96,    98,    97,
+      99,   100,    99,    99,    99,    99,    99,    99,    99,    99,
+     101,   101,   103,   102,   104,   104,   104,   105,   105,   105,
+     105,   105,   105,   105,   105,   105,   105,   105,   105,   105,
+     105,   105,   106,   107,   107,   108,   109,   108,   110,   110,
+     111,   111,   113,   112,   114,   114,   115,   115,   116,   116,
+     118,   117,   119,   119,   120,   120,   121,   121,   121,   122,
+     123,   122,   124,   124,   124,   124,   124,   125,   125,   125,
+     125,   125,   125,   126,   126,   127,   127,   128,   128,   128,
+     128,   128,   129,   129,   129,   130,   131,   131,   132
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     3,     3,     3,     3,     3,     0,     2,
        0,     2,     0,     2,     1,     1,     1,     1,     1,     1,
-       4,     2,     2,     1,     3,     3,     4,     0,     3,     3,
-       3,     3,     4,     6,     1,     3,     3,     0,     2,     1,
-       3,     0,     3,     0,     3,     1,     3,     2,     0,     1,
-       1,     1,     2,     4,     2,     2,     2,     4,     4,     3,
-       5,     2,     3,     5,     2,     1,     1,     0,     9,     3,
-       0,     4,     1,     1,     1,     1,     1,     1,     3,     1,
-       3,     0,     5,     2,     2,     2,     3,     3,     3,     3,
+       4,     2,     2,     1,     3,     3,     4,     2,     2,     3,
+       3,     3,     4,     6,     3,     4,     1,     3,     3,     0,
+       2,     1,     3,     2,     0,     3,     1,     3,     2,     0,
+       1,     1,     1,     2,     4,     2,     2,     2,     4,     4,
+       3,     5,     2,     3,     5,     2,     1,     1,     0,     9,
+       3,     0,     4,     1,     1,     1,     1,     1,     1,     3,
+       1,     3,     0,     5,     2,     2,     2,     3,     3,     3,
        3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       4,     5,     0,     1,     1,     0,     2,     1,     3,     1,
-       1,     0,     4,     0,     1,     1,     3,     0,     2,     0,
-       4,     0,     1,     1,     3,     3,     5,     3,     1,     0,
-       4,     1,     1,     3,     3,     4,     2,     2,     3,     3,
-       3,     4,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1
+       3,     4,     5,     0,     1,     1,     0,     2,     1,     3,
+       1,     1,     0,     4,     0,     1,     1,     3,     0,     2,
+       0,     4,     0,     1,     1,     3,     3,     5,     3,     1,
+       0,     4,     1,     1,     3,     3,     4,     2,     2,     3,
+       3,     3,     4,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (&yylloc, parser, YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, parser, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -1063,20 +1334,27 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
 YY_ATTRIBUTE_UNUSED
-static unsigned
+static int
 yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  unsigned res = 0;
+  int res = 0;
   int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
   if (0 <= yylocp->first_line)
     {
@@ -1096,64 +1374,72 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location, parser); \
+                  Kind, Value, Location, parser); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, triagens::aql::Parser* parser)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, triagens::aql::Parser* parser)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (yylocationp);
-  YYUSE (parser);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (parser);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, triagens::aql::Parser* parser)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, triagens::aql::Parser* parser)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp, parser);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, parser);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1162,7 +1448,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYL
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1185,21 +1471,22 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule, triagens::aql::Parser* parser)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, triagens::aql::Parser* parser)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       , parser);
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), parser);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1214,8 +1501,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1238,28 +1525,77 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1273,10 +1609,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1284,14 +1620,13 @@ yystpcpy (char *yydest, const char *yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1302,7 +1637,10 @@ yytnamerr (char *yyres, const char *yystr)
           case '\\':
             if (*++yyp != '\\')
               goto do_not_strip_quotes;
-            /* Fall through.  */
+            else
+              goto append;
+
+          append:
           default:
             if (yyres)
               yyres[yyn] = *yyp;
@@ -1317,36 +1655,20 @@ yytnamerr (char *yyres, const char *yystr)
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
+  /* Actual size of YYARG. */
   int yycount = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1370,63 +1692,78 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
+    default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
       YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1435,7 +1772,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1447,41 +1784,44 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
         {
-          yyp++;
-          yyformat++;
+          ++yyp;
+          ++yyformat;
         }
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, triagens::aql::Parser* parser)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, triagens::aql::Parser* parser)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-  YYUSE (parser);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (parser);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1489,7 +1829,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocatio
 int
 yyparse (triagens::aql::Parser* parser)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1508,55 +1848,50 @@ static YYLTYPE yyloc_default
 YYLTYPE yylloc = yyloc_default;
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYSIZE_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1564,43 +1899,49 @@ YYLTYPE yylloc = yyloc_default;
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
         YYLTYPE *yyls1 = yyls;
 
         /* Each stack pointer address is followed by the size of the
@@ -1608,32 +1949,29 @@ YYLTYPE yylloc = yyloc_default;
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
-                    &yyls1, yysize * sizeof (*yylsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
                     &yystacksize);
-
-        yyls = yyls1;
         yyss = yyss1;
         yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
@@ -1642,31 +1980,32 @@ YYLTYPE yylloc = yyloc_default;
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1677,18 +2016,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, &yylloc, scanner);
     }
 
-  if (yychar <= YYEOF)
+  if (yychar <= T_END)
     {
-      yychar = yytoken = YYEOF;
+      yychar = T_END;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1716,15 +2067,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1739,7 +2089,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1755,228 +2105,227 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-  /* Default location.  */
+  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 203 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 2: /* query: optional_statement_block_statements return_statement  */
+#line 205 "arangod/Aql/grammar.y"
+                                                         {
     }
-#line 1768 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1962 "arangod/Aql/grammar.cpp"
     break;
 
-  case 3:
-#line 205 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 3: /* query: optional_statement_block_statements remove_statement optional_post_modification_block  */
+#line 207 "arangod/Aql/grammar.y"
+                                                                                          {
     }
-#line 1775 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1969 "arangod/Aql/grammar.cpp"
     break;
 
-  case 4:
-#line 207 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 4: /* query: optional_statement_block_statements insert_statement optional_post_modification_block  */
+#line 209 "arangod/Aql/grammar.y"
+                                                                                          {
     }
-#line 1782 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1976 "arangod/Aql/grammar.cpp"
     break;
 
-  case 5:
-#line 209 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 5: /* query: optional_statement_block_statements update_statement optional_post_modification_block  */
+#line 211 "arangod/Aql/grammar.y"
+                                                                                          {
     }
-#line 1789 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1983 "arangod/Aql/grammar.cpp"
     break;
 
-  case 6:
-#line 211 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 6: /* query: optional_statement_block_statements replace_statement optional_post_modification_block  */
+#line 213 "arangod/Aql/grammar.y"
+                                                                                           {
     }
-#line 1796 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1990 "arangod/Aql/grammar.cpp"
     break;
 
-  case 7:
-#line 213 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 7: /* query: optional_statement_block_statements upsert_statement optional_post_modification_block  */
+#line 215 "arangod/Aql/grammar.y"
+                                                                                          {
     }
-#line 1803 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1997 "arangod/Aql/grammar.cpp"
     break;
 
-  case 8:
-#line 218 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 8: /* optional_post_modification_lets: %empty  */
+#line 220 "arangod/Aql/grammar.y"
+                {
     }
-#line 1810 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2004 "arangod/Aql/grammar.cpp"
     break;
 
-  case 9:
-#line 220 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 9: /* optional_post_modification_lets: optional_post_modification_lets let_statement  */
+#line 222 "arangod/Aql/grammar.y"
+                                                  {
     }
-#line 1817 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2011 "arangod/Aql/grammar.cpp"
     break;
 
-  case 10:
-#line 225 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 10: /* optional_post_modification_block: %empty  */
+#line 227 "arangod/Aql/grammar.y"
+                {
       // still need to close the scope opened by the data-modification statement
       parser->ast()->scopes()->endNested();
     }
-#line 1826 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2020 "arangod/Aql/grammar.cpp"
     break;
 
-  case 11:
-#line 229 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 11: /* optional_post_modification_block: optional_post_modification_lets return_statement  */
+#line 231 "arangod/Aql/grammar.y"
+                                                     {
       // the RETURN statement will close the scope opened by the data-modification statement
     }
-#line 1834 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2028 "arangod/Aql/grammar.cpp"
     break;
 
-  case 12:
-#line 235 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 12: /* optional_statement_block_statements: %empty  */
+#line 237 "arangod/Aql/grammar.y"
+                {
     }
-#line 1841 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2035 "arangod/Aql/grammar.cpp"
     break;
 
-  case 13:
-#line 237 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 13: /* optional_statement_block_statements: optional_statement_block_statements statement_block_statement  */
+#line 239 "arangod/Aql/grammar.y"
+                                                                  {
     }
-#line 1848 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2042 "arangod/Aql/grammar.cpp"
     break;
 
-  case 14:
-#line 242 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 14: /* statement_block_statement: for_statement  */
+#line 244 "arangod/Aql/grammar.y"
+                  {
     }
-#line 1855 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2049 "arangod/Aql/grammar.cpp"
     break;
 
-  case 15:
-#line 244 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 15: /* statement_block_statement: let_statement  */
+#line 246 "arangod/Aql/grammar.y"
+                  {
     }
-#line 1862 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2056 "arangod/Aql/grammar.cpp"
     break;
 
-  case 16:
-#line 246 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 16: /* statement_block_statement: filter_statement  */
+#line 248 "arangod/Aql/grammar.y"
+                     {
     }
-#line 1869 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2063 "arangod/Aql/grammar.cpp"
     break;
 
-  case 17:
-#line 248 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 17: /* statement_block_statement: collect_statement  */
+#line 250 "arangod/Aql/grammar.y"
+                      {
     }
-#line 1876 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2070 "arangod/Aql/grammar.cpp"
     break;
 
-  case 18:
-#line 250 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 18: /* statement_block_statement: sort_statement  */
+#line 252 "arangod/Aql/grammar.y"
+                   {
     }
-#line 1883 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2077 "arangod/Aql/grammar.cpp"
     break;
 
-  case 19:
-#line 252 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 19: /* statement_block_statement: limit_statement  */
+#line 254 "arangod/Aql/grammar.y"
+                    {
     }
-#line 1890 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2084 "arangod/Aql/grammar.cpp"
     break;
 
-  case 20:
-#line 257 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 20: /* for_statement: "FOR declaration" variable_name "IN keyword" expression  */
+#line 259 "arangod/Aql/grammar.y"
+                                        {
       parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_FOR);
      
       auto node = parser->ast()->createNodeFor((yyvsp[-2].strval), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 1901 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2095 "arangod/Aql/grammar.cpp"
     break;
 
-  case 21:
-#line 266 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 21: /* filter_statement: "FILTER declaration" expression  */
+#line 268 "arangod/Aql/grammar.y"
+                        {
       // operand is a reference. can use it directly
       auto node = parser->ast()->createNodeFilter((yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 1911 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2105 "arangod/Aql/grammar.cpp"
     break;
 
-  case 22:
-#line 274 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 22: /* let_statement: "LET declaration" let_list  */
+#line 276 "arangod/Aql/grammar.y"
+                   {
     }
-#line 1918 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2112 "arangod/Aql/grammar.cpp"
     break;
 
-  case 23:
-#line 279 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 23: /* let_list: let_element  */
+#line 281 "arangod/Aql/grammar.y"
+                {
     }
-#line 1925 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2119 "arangod/Aql/grammar.cpp"
     break;
 
-  case 24:
-#line 281 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 24: /* let_list: let_list "," let_element  */
+#line 283 "arangod/Aql/grammar.y"
+                                 {
     }
-#line 1932 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2126 "arangod/Aql/grammar.cpp"
     break;
 
-  case 25:
-#line 286 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 25: /* let_element: variable_name "assignment" expression  */
+#line 288 "arangod/Aql/grammar.y"
+                                      {
       auto node = parser->ast()->createNodeLet((yyvsp[-2].strval), (yyvsp[0].node), true);
       parser->ast()->addOperation(node);
     }
-#line 1941 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2135 "arangod/Aql/grammar.cpp"
     break;
 
-  case 26:
-#line 293 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 26: /* count_into: "WITH keyword" "identifier" "INTO keyword" variable_name  */
+#line 295 "arangod/Aql/grammar.y"
+                                         {
       if (! TRI_CaseEqualString((yyvsp[-2].strval), "COUNT")) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'COUNT'", (yyvsp[-2].strval), yylloc.first_line, yylloc.first_column);
       }
 
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 1953 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2147 "arangod/Aql/grammar.cpp"
     break;
 
-  case 27:
-#line 303 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
-      auto node = parser->ast()->createNodeArray();
-      parser->pushStack(node);
+  case 27: /* collect_variable_list: "COLLECT declaration" collect_list  */
+#line 305 "arangod/Aql/grammar.y"
+                           { 
+      (yyval.node) = (yyvsp[0].node);
     }
-#line 1962 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2155 "arangod/Aql/grammar.cpp"
     break;
 
-  case 28:
-#line 306 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    { 
-      auto list = static_cast<AstNode*>(parser->popStack());
-
-      if (list == nullptr) {
-        ABORT_OOM
+  case 28: /* aggregate: "identifier" collect_list  */
+#line 311 "arangod/Aql/grammar.y"
+                          {
+      if (! TRI_CaseEqualString((yyvsp[-1].strval), "AGGREGATE")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'AGGREGATE'", (yyvsp[-1].strval), yylloc.first_line, yylloc.first_column);
       }
-      (yyval.node) = list;
+
+      (yyval.node) = (yyvsp[0].node);
     }
-#line 1975 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2167 "arangod/Aql/grammar.cpp"
     break;
 
-  case 29:
-#line 317 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 29: /* collect_statement: "COLLECT declaration" count_into options  */
+#line 321 "arangod/Aql/grammar.y"
+                                 {
       auto scopes = parser->ast()->scopes();
 
       // check if we are in the main scope
@@ -1992,12 +2341,12 @@ yyreduce:
       auto node = parser->ast()->createNodeCollectCount(parser->ast()->createNodeArray(), (yyvsp[-1].strval), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 1996 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2188 "arangod/Aql/grammar.cpp"
     break;
 
-  case 30:
-#line 333 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 30: /* collect_statement: collect_variable_list count_into options  */
+#line 337 "arangod/Aql/grammar.y"
+                                             {
       auto scopes = parser->ast()->scopes();
 
       // check if we are in the main scope
@@ -2024,12 +2373,12 @@ yyreduce:
       auto node = parser->ast()->createNodeCollectCount((yyvsp[-2].node), (yyvsp[-1].strval), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2028 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2220 "arangod/Aql/grammar.cpp"
     break;
 
-  case 31:
-#line 360 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 31: /* collect_statement: collect_variable_list optional_into options  */
+#line 364 "arangod/Aql/grammar.y"
+                                                {
       auto scopes = parser->ast()->scopes();
 
       // check if we are in the main scope
@@ -2056,12 +2405,12 @@ yyreduce:
       auto node = parser->ast()->createNodeCollect((yyvsp[-2].node), (yyvsp[-1].strval), nullptr, (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2060 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2252 "arangod/Aql/grammar.cpp"
     break;
 
-  case 32:
-#line 387 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 32: /* collect_statement: collect_variable_list optional_into keep options  */
+#line 391 "arangod/Aql/grammar.y"
+                                                     {
       auto scopes = parser->ast()->scopes();
 
       // check if we are in the main scope
@@ -2093,12 +2442,12 @@ yyreduce:
       auto node = parser->ast()->createNodeCollect((yyvsp[-3].node), (yyvsp[-2].strval), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2097 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2289 "arangod/Aql/grammar.cpp"
     break;
 
-  case 33:
-#line 419 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 33: /* collect_statement: collect_variable_list "INTO keyword" variable_name "assignment" expression options  */
+#line 423 "arangod/Aql/grammar.y"
+                                                                           {
       auto scopes = parser->ast()->scopes();
 
       // check if we are in the main scope
@@ -2125,51 +2474,126 @@ yyreduce:
       auto node = parser->ast()->createNodeCollectExpression((yyvsp[-5].node), (yyvsp[-3].strval), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2129 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2321 "arangod/Aql/grammar.cpp"
     break;
 
-  case 34:
-#line 449 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 34: /* collect_statement: "COLLECT declaration" aggregate options  */
+#line 450 "arangod/Aql/grammar.y"
+                                {
+      auto scopes = parser->ast()->scopes();
+
+      // check if we are in the main scope
+      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
+
+      if (reRegisterVariables) {
+        // end the active scopes
+        scopes->endNested();
+        // start a new scope
+        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
+
+        size_t const n = (yyvsp[-1].node)->numMembers();
+        for (size_t i = 0; i < n; ++i) {
+          auto member = (yyvsp[-1].node)->getMember(i);
+
+          if (member != nullptr) {
+            TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
+            auto v = static_cast<Variable*>(member->getMember(0)->getData());
+            scopes->addVariable(v);
+          }
+        }
+      }
+
+      auto node = parser->ast()->createNodeCollectAggregate(parser->ast()->createNodeArray(), (yyvsp[-1].node), (yyvsp[0].node));
+      parser->ast()->addOperation(node);
     }
-#line 2136 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2353 "arangod/Aql/grammar.cpp"
     break;
 
-  case 35:
-#line 451 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 35: /* collect_statement: collect_variable_list optional_into aggregate options  */
+#line 477 "arangod/Aql/grammar.y"
+                                                          {
+      auto scopes = parser->ast()->scopes();
+
+      // check if we are in the main scope
+      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
+
+      if (reRegisterVariables) {
+        // end the active scopes
+        scopes->endNested();
+        // start a new scope
+        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
+
+        // register the group variables and the aggregate variables
+        for (auto const& list : { (yyvsp[-3].node), (yyvsp[-1].node) }) {
+          size_t const n = list->numMembers();
+          for (size_t i = 0; i < n; ++i) {
+            auto member = list->getMember(i);
+
+            if (member != nullptr) {
+              TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
+              auto v = static_cast<Variable*>(member->getMember(0)->getData());
+              scopes->addVariable(v);
+            }
+          }
+        }
+      }
+
+      if ((yyvsp[-2].strval) != nullptr) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of 'INTO' together with 'AGGREGATE'", yylloc.first_line, yylloc.first_column);
+      } 
+
+      auto node = parser->ast()->createNodeCollectAggregate((yyvsp[-3].node), (yyvsp[-1].node), (yyvsp[0].node));
+      parser->ast()->addOperation(node);
     }
-#line 2143 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2392 "arangod/Aql/grammar.cpp"
     break;
 
-  case 36:
-#line 456 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
-      auto node = parser->ast()->createNodeAssign((yyvsp[-2].strval), (yyvsp[0].node));
-      parser->pushArrayElement(node);
+  case 36: /* collect_list: collect_element  */
+#line 514 "arangod/Aql/grammar.y"
+                    {
+      auto node = parser->ast()->createNodeArray();
+      node->addMember((yyvsp[0].node));
+      (yyval.node) = node;
     }
-#line 2152 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2402 "arangod/Aql/grammar.cpp"
     break;
 
-  case 37:
-#line 463 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 37: /* collect_list: collect_list "," collect_element  */
+#line 519 "arangod/Aql/grammar.y"
+                                         {
+      (yyvsp[-2].node)->addMember((yyvsp[0].node));
+      (yyval.node) = (yyvsp[-2].node);
+    }
+#line 2411 "arangod/Aql/grammar.cpp"
+    break;
+
+  case 38: /* collect_element: variable_name "assignment" expression  */
+#line 526 "arangod/Aql/grammar.y"
+                                      {
+      (yyval.node) = parser->ast()->createNodeAssign((yyvsp[-2].strval), (yyvsp[0].node));
+    }
+#line 2419 "arangod/Aql/grammar.cpp"
+    break;
+
+  case 39: /* optional_into: %empty  */
+#line 532 "arangod/Aql/grammar.y"
+                {
       (yyval.strval) = nullptr;
     }
-#line 2160 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2427 "arangod/Aql/grammar.cpp"
     break;
 
-  case 38:
-#line 466 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 40: /* optional_into: "INTO keyword" variable_name  */
+#line 535 "arangod/Aql/grammar.y"
+                         {
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 2168 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2435 "arangod/Aql/grammar.cpp"
     break;
 
-  case 39:
-#line 472 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 41: /* variable_list: variable_name  */
+#line 541 "arangod/Aql/grammar.y"
+                  {
       if (! parser->ast()->scopes()->existsVariable((yyvsp[0].strval))) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of unknown variable '%s' for KEEP", (yyvsp[0].strval), yylloc.first_line, yylloc.first_column);
       }
@@ -2181,14 +2605,17 @@ yyreduce:
 
       // indicate the this node is a reference to the variable name, not the variable value
       node->setFlag(FLAG_KEEP_VARIABLENAME);
-      parser->pushArrayElement(node);
+
+      auto list = parser->ast()->createNodeArray();
+      list->addMember(node);
+      (yyval.node) = list;
     }
-#line 2187 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2457 "arangod/Aql/grammar.cpp"
     break;
 
-  case 40:
-#line 486 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 42: /* variable_list: variable_list "," variable_name  */
+#line 558 "arangod/Aql/grammar.y"
+                                        {
       if (! parser->ast()->scopes()->existsVariable((yyvsp[0].strval))) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of unknown variable '%s' for KEEP", (yyvsp[0].strval), yylloc.first_line, yylloc.first_column);
       }
@@ -2200,156 +2627,147 @@ yyreduce:
 
       // indicate the this node is a reference to the variable name, not the variable value
       node->setFlag(FLAG_KEEP_VARIABLENAME);
-      parser->pushArrayElement(node);
+      (yyvsp[-2].node)->addMember(node);
+      (yyval.node) = (yyvsp[-2].node);
     }
-#line 2206 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2477 "arangod/Aql/grammar.cpp"
     break;
 
-  case 41:
-#line 503 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
-      if (! TRI_CaseEqualString((yyvsp[0].strval), "KEEP")) {
-        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'KEEP'", (yyvsp[0].strval), yylloc.first_line, yylloc.first_column);
+  case 43: /* keep: "identifier" variable_list  */
+#line 576 "arangod/Aql/grammar.y"
+                           {
+      if (! TRI_CaseEqualString((yyvsp[-1].strval), "KEEP")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'KEEP'", (yyvsp[-1].strval), yylloc.first_line, yylloc.first_column);
       }
 
-      auto node = parser->ast()->createNodeArray();
-      parser->pushStack(node);
-    }
-#line 2219 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
-    break;
-
-  case 42:
-#line 510 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
-      auto list = static_cast<AstNode*>(parser->popStack());
-      (yyval.node) = list;
+      (yyval.node) = (yyvsp[0].node);
     }
-#line 2228 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2489 "arangod/Aql/grammar.cpp"
     break;
 
-  case 43:
-#line 517 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 44: /* $@1: %empty  */
+#line 586 "arangod/Aql/grammar.y"
+           {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2237 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2498 "arangod/Aql/grammar.cpp"
     break;
 
-  case 44:
-#line 520 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 45: /* sort_statement: "SORT declaration" $@1 sort_list  */
+#line 589 "arangod/Aql/grammar.y"
+                {
       auto list = static_cast<AstNode const*>(parser->popStack());
       auto node = parser->ast()->createNodeSort(list);
       parser->ast()->addOperation(node);
     }
-#line 2247 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2508 "arangod/Aql/grammar.cpp"
     break;
 
-  case 45:
-#line 528 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 46: /* sort_list: sort_element  */
+#line 597 "arangod/Aql/grammar.y"
+                 {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2255 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2516 "arangod/Aql/grammar.cpp"
     break;
 
-  case 46:
-#line 531 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 47: /* sort_list: sort_list "," sort_element  */
+#line 600 "arangod/Aql/grammar.y"
+                                   {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2263 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2524 "arangod/Aql/grammar.cpp"
     break;
 
-  case 47:
-#line 537 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 48: /* sort_element: expression sort_direction  */
+#line 606 "arangod/Aql/grammar.y"
+                              {
       (yyval.node) = parser->ast()->createNodeSortElement((yyvsp[-1].node), (yyvsp[0].node));
     }
-#line 2271 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2532 "arangod/Aql/grammar.cpp"
     break;
 
-  case 48:
-#line 543 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 49: /* sort_direction: %empty  */
+#line 612 "arangod/Aql/grammar.y"
+                {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 2279 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2540 "arangod/Aql/grammar.cpp"
     break;
 
-  case 49:
-#line 546 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 50: /* sort_direction: "ASC keyword"  */
+#line 615 "arangod/Aql/grammar.y"
+          {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 2287 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2548 "arangod/Aql/grammar.cpp"
     break;
 
-  case 50:
-#line 549 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 51: /* sort_direction: "DESC keyword"  */
+#line 618 "arangod/Aql/grammar.y"
+           {
       (yyval.node) = parser->ast()->createNodeValueBool(false);
     }
-#line 2295 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2556 "arangod/Aql/grammar.cpp"
     break;
 
-  case 51:
-#line 552 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 52: /* sort_direction: atomic_value  */
+#line 621 "arangod/Aql/grammar.y"
+                 {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2303 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2564 "arangod/Aql/grammar.cpp"
     break;
 
-  case 52:
-#line 558 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 53: /* limit_statement: "LIMIT declaration" atomic_value  */
+#line 627 "arangod/Aql/grammar.y"
+                         {
       auto offset = parser->ast()->createNodeValueInt(0);
       auto node = parser->ast()->createNodeLimit(offset, (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2313 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2574 "arangod/Aql/grammar.cpp"
     break;
 
-  case 53:
-#line 563 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 54: /* limit_statement: "LIMIT declaration" atomic_value "," atomic_value  */
+#line 632 "arangod/Aql/grammar.y"
+                                              {
       auto node = parser->ast()->createNodeLimit((yyvsp[-2].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2322 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2583 "arangod/Aql/grammar.cpp"
     break;
 
-  case 54:
-#line 570 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 55: /* return_statement: "RETURN declaration" expression  */
+#line 639 "arangod/Aql/grammar.y"
+                        {
       auto node = parser->ast()->createNodeReturn((yyvsp[0].node));
       parser->ast()->addOperation(node);
       parser->ast()->scopes()->endNested();
     }
-#line 2332 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2593 "arangod/Aql/grammar.cpp"
     break;
 
-  case 55:
-#line 578 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 56: /* in_or_into_collection: "IN keyword" collection_name  */
+#line 647 "arangod/Aql/grammar.y"
+                         {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2340 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2601 "arangod/Aql/grammar.cpp"
     break;
 
-  case 56:
-#line 581 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 57: /* in_or_into_collection: "INTO keyword" collection_name  */
+#line 650 "arangod/Aql/grammar.y"
+                           {
        (yyval.node) = (yyvsp[0].node);
      }
-#line 2348 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2609 "arangod/Aql/grammar.cpp"
     break;
 
-  case 57:
-#line 587 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 58: /* remove_statement: "REMOVE command" expression in_or_into_collection options  */
+#line 656 "arangod/Aql/grammar.y"
+                                                      {
       if (! parser->configureWriteQuery(AQL_QUERY_REMOVE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2357,12 +2775,12 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2361 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2622 "arangod/Aql/grammar.cpp"
     break;
 
-  case 58:
-#line 598 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 59: /* insert_statement: "INSERT command" expression in_or_into_collection options  */
+#line 667 "arangod/Aql/grammar.y"
+                                                      {
       if (! parser->configureWriteQuery(AQL_QUERY_INSERT, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2370,12 +2788,12 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2374 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2635 "arangod/Aql/grammar.cpp"
     break;
 
-  case 59:
-#line 609 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 60: /* update_parameters: expression in_or_into_collection options  */
+#line 678 "arangod/Aql/grammar.y"
+                                             {
       if (! parser->configureWriteQuery(AQL_QUERY_UPDATE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2384,12 +2802,12 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2388 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2649 "arangod/Aql/grammar.cpp"
     break;
 
-  case 60:
-#line 618 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 61: /* update_parameters: expression "WITH keyword" expression in_or_into_collection options  */
+#line 687 "arangod/Aql/grammar.y"
+                                                               {
       if (! parser->configureWriteQuery(AQL_QUERY_UPDATE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2398,19 +2816,19 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2402 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2663 "arangod/Aql/grammar.cpp"
     break;
 
-  case 61:
-#line 630 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 62: /* update_statement: "UPDATE command" update_parameters  */
+#line 699 "arangod/Aql/grammar.y"
+                               {
     }
-#line 2409 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2670 "arangod/Aql/grammar.cpp"
     break;
 
-  case 62:
-#line 635 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 63: /* replace_parameters: expression in_or_into_collection options  */
+#line 704 "arangod/Aql/grammar.y"
+                                             {
       if (! parser->configureWriteQuery(AQL_QUERY_REPLACE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2419,12 +2837,12 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2423 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2684 "arangod/Aql/grammar.cpp"
     break;
 
-  case 63:
-#line 644 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 64: /* replace_parameters: expression "WITH keyword" expression in_or_into_collection options  */
+#line 713 "arangod/Aql/grammar.y"
+                                                               {
       if (! parser->configureWriteQuery(AQL_QUERY_REPLACE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2433,45 +2851,45 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2437 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2698 "arangod/Aql/grammar.cpp"
     break;
 
-  case 64:
-#line 656 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 65: /* replace_statement: "REPLACE command" replace_parameters  */
+#line 725 "arangod/Aql/grammar.y"
+                                 {
     }
-#line 2444 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2705 "arangod/Aql/grammar.cpp"
     break;
 
-  case 65:
-#line 661 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 66: /* update_or_replace: "UPDATE command"  */
+#line 730 "arangod/Aql/grammar.y"
+             {
       (yyval.intval) = static_cast<int64_t>(NODE_TYPE_UPDATE);
     }
-#line 2452 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2713 "arangod/Aql/grammar.cpp"
     break;
 
-  case 66:
-#line 664 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 67: /* update_or_replace: "REPLACE command"  */
+#line 733 "arangod/Aql/grammar.y"
+              {
       (yyval.intval) = static_cast<int64_t>(NODE_TYPE_REPLACE);
     }
-#line 2460 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2721 "arangod/Aql/grammar.cpp"
     break;
 
-  case 67:
-#line 670 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    { 
+  case 68: /* $@2: %empty  */
+#line 739 "arangod/Aql/grammar.y"
+             { 
       // reserve a variable named "$OLD", we might need it in the update expression
       // and in a later return thing
       parser->pushStack(parser->ast()->createNodeVariable("$OLD", true));
     }
-#line 2470 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2731 "arangod/Aql/grammar.cpp"
     break;
 
-  case 68:
-#line 674 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 69: /* upsert_statement: "UPSERT command" $@2 expression "INSERT command" expression update_or_replace expression in_or_into_collection options  */
+#line 743 "arangod/Aql/grammar.y"
+                                                                                                {
       if (! parser->configureWriteQuery(AQL_QUERY_UPSERT, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2520,32 +2938,32 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2524 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2785 "arangod/Aql/grammar.cpp"
     break;
 
-  case 69:
-#line 726 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 70: /* expression: "(" expression ")"  */
+#line 795 "arangod/Aql/grammar.y"
+                              {
       (yyval.node) = (yyvsp[-1].node);
     }
-#line 2532 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2793 "arangod/Aql/grammar.cpp"
     break;
 
-  case 70:
-#line 729 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 71: /* $@3: %empty  */
+#line 798 "arangod/Aql/grammar.y"
+           {
       if (parser->isModificationQuery()) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected subquery after data-modification operation", yylloc.first_line, yylloc.first_column);
       }
       parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_SUBQUERY);
       parser->ast()->startSubQuery();
     }
-#line 2544 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2805 "arangod/Aql/grammar.cpp"
     break;
 
-  case 71:
-#line 735 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 72: /* expression: "(" $@3 query ")"  */
+#line 804 "arangod/Aql/grammar.y"
+                    {
       AstNode* node = parser->ast()->endSubQuery();
       parser->ast()->scopes()->endCurrent();
 
@@ -2555,80 +2973,80 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeReference(variableName.c_str());
     }
-#line 2559 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2820 "arangod/Aql/grammar.cpp"
     break;
 
-  case 72:
-#line 745 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 73: /* expression: operator_unary  */
+#line 814 "arangod/Aql/grammar.y"
+                   {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2567 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2828 "arangod/Aql/grammar.cpp"
     break;
 
-  case 73:
-#line 748 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 74: /* expression: operator_binary  */
+#line 817 "arangod/Aql/grammar.y"
+                    {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2575 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2836 "arangod/Aql/grammar.cpp"
     break;
 
-  case 74:
-#line 751 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 75: /* expression: operator_ternary  */
+#line 820 "arangod/Aql/grammar.y"
+                     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2583 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2844 "arangod/Aql/grammar.cpp"
     break;
 
-  case 75:
-#line 754 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 76: /* expression: compound_type  */
+#line 823 "arangod/Aql/grammar.y"
+                  {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2591 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2852 "arangod/Aql/grammar.cpp"
     break;
 
-  case 76:
-#line 757 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 77: /* expression: atomic_value  */
+#line 826 "arangod/Aql/grammar.y"
+                 {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2599 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2860 "arangod/Aql/grammar.cpp"
     break;
 
-  case 77:
-#line 760 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 78: /* expression: reference  */
+#line 829 "arangod/Aql/grammar.y"
+              {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2607 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2868 "arangod/Aql/grammar.cpp"
     break;
 
-  case 78:
-#line 763 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 79: /* expression: expression ".." expression  */
+#line 832 "arangod/Aql/grammar.y"
+                                  {
       (yyval.node) = parser->ast()->createNodeRange((yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2615 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2876 "arangod/Aql/grammar.cpp"
     break;
 
-  case 79:
-#line 769 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 80: /* function_name: "identifier"  */
+#line 838 "arangod/Aql/grammar.y"
+             {
       (yyval.strval) = (yyvsp[0].strval);
 
       if ((yyval.strval) == nullptr) {
         ABORT_OOM
       }
     }
-#line 2627 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2888 "arangod/Aql/grammar.cpp"
     break;
 
-  case 80:
-#line 776 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 81: /* function_name: function_name "::" "identifier"  */
+#line 845 "arangod/Aql/grammar.y"
+                                   {
       if ((yyvsp[-2].strval) == nullptr || (yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
@@ -2642,205 +3060,205 @@ yyreduce:
         ABORT_OOM
       }
     }
-#line 2646 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2907 "arangod/Aql/grammar.cpp"
     break;
 
-  case 81:
-#line 793 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 82: /* $@4: %empty  */
+#line 862 "arangod/Aql/grammar.y"
+                  {
       parser->pushStack((yyvsp[0].strval));
 
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2657 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2918 "arangod/Aql/grammar.cpp"
     break;
 
-  case 82:
-#line 798 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 83: /* function_call: function_name $@4 "(" optional_function_call_arguments ")"  */
+#line 867 "arangod/Aql/grammar.y"
+                                                                     {
       auto list = static_cast<AstNode const*>(parser->popStack());
       (yyval.node) = parser->ast()->createNodeFunctionCall(static_cast<char const*>(parser->popStack()), list);
     }
-#line 2666 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2927 "arangod/Aql/grammar.cpp"
     break;
 
-  case 83:
-#line 805 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 84: /* operator_unary: "+ operator" expression  */
+#line 874 "arangod/Aql/grammar.y"
+                                  {
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_PLUS, (yyvsp[0].node));
     }
-#line 2674 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2935 "arangod/Aql/grammar.cpp"
     break;
 
-  case 84:
-#line 808 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 85: /* operator_unary: "- operator" expression  */
+#line 877 "arangod/Aql/grammar.y"
+                                    {
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_MINUS, (yyvsp[0].node));
     }
-#line 2682 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2943 "arangod/Aql/grammar.cpp"
     break;
 
-  case 85:
-#line 811 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    { 
+  case 86: /* operator_unary: "not operator" expression  */
+#line 880 "arangod/Aql/grammar.y"
+                                 { 
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_NOT, (yyvsp[0].node));
     }
-#line 2690 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2951 "arangod/Aql/grammar.cpp"
     break;
 
-  case 86:
-#line 817 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 87: /* operator_binary: expression "or operator" expression  */
+#line 886 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_OR, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2698 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2959 "arangod/Aql/grammar.cpp"
     break;
 
-  case 87:
-#line 820 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 88: /* operator_binary: expression "and operator" expression  */
+#line 889 "arangod/Aql/grammar.y"
+                                {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2706 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2967 "arangod/Aql/grammar.cpp"
     break;
 
-  case 88:
-#line 823 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 89: /* operator_binary: expression "+ operator" expression  */
+#line 892 "arangod/Aql/grammar.y"
+                                 {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_PLUS, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2714 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2975 "arangod/Aql/grammar.cpp"
     break;
 
-  case 89:
-#line 826 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 90: /* operator_binary: expression "- operator" expression  */
+#line 895 "arangod/Aql/grammar.y"
+                                  {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_MINUS, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2722 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2983 "arangod/Aql/grammar.cpp"
     break;
 
-  case 90:
-#line 829 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 91: /* operator_binary: expression "* operator" expression  */
+#line 898 "arangod/Aql/grammar.y"
+                                  {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_TIMES, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2730 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2991 "arangod/Aql/grammar.cpp"
     break;
 
-  case 91:
-#line 832 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 92: /* operator_binary: expression "/ operator" expression  */
+#line 901 "arangod/Aql/grammar.y"
+                                {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_DIV, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2738 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2999 "arangod/Aql/grammar.cpp"
     break;
 
-  case 92:
-#line 835 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 93: /* operator_binary: expression "% operator" expression  */
+#line 904 "arangod/Aql/grammar.y"
+                                {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_MOD, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2746 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3007 "arangod/Aql/grammar.cpp"
     break;
 
-  case 93:
-#line 838 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 94: /* operator_binary: expression "== operator" expression  */
+#line 907 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_EQ, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2754 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3015 "arangod/Aql/grammar.cpp"
     break;
 
-  case 94:
-#line 841 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 95: /* operator_binary: expression "!= operator" expression  */
+#line 910 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_NE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2762 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3023 "arangod/Aql/grammar.cpp"
     break;
 
-  case 95:
-#line 844 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 96: /* operator_binary: expression "< operator" expression  */
+#line 913 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_LT, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2770 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3031 "arangod/Aql/grammar.cpp"
     break;
 
-  case 96:
-#line 847 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 97: /* operator_binary: expression "> operator" expression  */
+#line 916 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GT, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2778 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3039 "arangod/Aql/grammar.cpp"
     break;
 
-  case 97:
-#line 850 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 98: /* operator_binary: expression "<= operator" expression  */
+#line 919 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_LE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2786 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3047 "arangod/Aql/grammar.cpp"
     break;
 
-  case 98:
-#line 853 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 99: /* operator_binary: expression ">= operator" expression  */
+#line 922 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2794 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3055 "arangod/Aql/grammar.cpp"
     break;
 
-  case 99:
-#line 856 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 100: /* operator_binary: expression "IN keyword" expression  */
+#line 925 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_IN, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2802 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3063 "arangod/Aql/grammar.cpp"
     break;
 
-  case 100:
-#line 859 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 101: /* operator_binary: expression "not operator" "IN keyword" expression  */
+#line 928 "arangod/Aql/grammar.y"
+                                                 {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_NIN, (yyvsp[-3].node), (yyvsp[0].node));
     }
-#line 2810 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3071 "arangod/Aql/grammar.cpp"
     break;
 
-  case 101:
-#line 865 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 102: /* operator_ternary: expression "?" expression ":" expression  */
+#line 934 "arangod/Aql/grammar.y"
+                                                        {
       (yyval.node) = parser->ast()->createNodeTernaryOperator((yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2818 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3079 "arangod/Aql/grammar.cpp"
     break;
 
-  case 102:
-#line 871 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 103: /* optional_function_call_arguments: %empty  */
+#line 940 "arangod/Aql/grammar.y"
+                {
     }
-#line 2825 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3086 "arangod/Aql/grammar.cpp"
     break;
 
-  case 103:
-#line 873 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 104: /* optional_function_call_arguments: function_arguments_list  */
+#line 942 "arangod/Aql/grammar.y"
+                            {
     }
-#line 2832 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3093 "arangod/Aql/grammar.cpp"
     break;
 
-  case 104:
-#line 878 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 105: /* expression_or_query: expression  */
+#line 947 "arangod/Aql/grammar.y"
+               {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2840 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3101 "arangod/Aql/grammar.cpp"
     break;
 
-  case 105:
-#line 881 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 106: /* $@5: %empty  */
+#line 950 "arangod/Aql/grammar.y"
     {
       if (parser->isModificationQuery()) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected subquery after data-modification operation", yylloc.first_line, yylloc.first_column);
@@ -2848,12 +3266,12 @@ yyreduce:
       parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_SUBQUERY);
       parser->ast()->startSubQuery();
     }
-#line 2852 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3113 "arangod/Aql/grammar.cpp"
     break;
 
-  case 106:
-#line 887 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 107: /* expression_or_query: $@5 query  */
+#line 956 "arangod/Aql/grammar.y"
+            {
       AstNode* node = parser->ast()->endSubQuery();
       parser->ast()->scopes()->endCurrent();
 
@@ -2863,99 +3281,99 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeReference(variableName.c_str());
     }
-#line 2867 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3128 "arangod/Aql/grammar.cpp"
     break;
 
-  case 107:
-#line 900 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 108: /* function_arguments_list: expression_or_query  */
+#line 969 "arangod/Aql/grammar.y"
+                        {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2875 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3136 "arangod/Aql/grammar.cpp"
     break;
 
-  case 108:
-#line 903 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 109: /* function_arguments_list: function_arguments_list "," expression_or_query  */
+#line 972 "arangod/Aql/grammar.y"
+                                                        {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2883 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3144 "arangod/Aql/grammar.cpp"
     break;
 
-  case 109:
-#line 909 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 110: /* compound_type: array  */
+#line 978 "arangod/Aql/grammar.y"
+          {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2891 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3152 "arangod/Aql/grammar.cpp"
     break;
 
-  case 110:
-#line 912 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 111: /* compound_type: object  */
+#line 981 "arangod/Aql/grammar.y"
+           {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2899 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3160 "arangod/Aql/grammar.cpp"
     break;
 
-  case 111:
-#line 918 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 112: /* $@6: %empty  */
+#line 987 "arangod/Aql/grammar.y"
+                 {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2908 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3169 "arangod/Aql/grammar.cpp"
     break;
 
-  case 112:
-#line 921 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 113: /* array: "[" $@6 optional_array_elements "]"  */
+#line 990 "arangod/Aql/grammar.y"
+                                            {
       (yyval.node) = static_cast<AstNode*>(parser->popStack());
     }
-#line 2916 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3177 "arangod/Aql/grammar.cpp"
     break;
 
-  case 113:
-#line 927 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 114: /* optional_array_elements: %empty  */
+#line 996 "arangod/Aql/grammar.y"
+                {
     }
-#line 2923 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3184 "arangod/Aql/grammar.cpp"
     break;
 
-  case 114:
-#line 929 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 115: /* optional_array_elements: array_elements_list  */
+#line 998 "arangod/Aql/grammar.y"
+                        {
     }
-#line 2930 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3191 "arangod/Aql/grammar.cpp"
     break;
 
-  case 115:
-#line 934 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 116: /* array_elements_list: expression  */
+#line 1003 "arangod/Aql/grammar.y"
+               {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2938 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3199 "arangod/Aql/grammar.cpp"
     break;
 
-  case 116:
-#line 937 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 117: /* array_elements_list: array_elements_list "," expression  */
+#line 1006 "arangod/Aql/grammar.y"
+                                           {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2946 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3207 "arangod/Aql/grammar.cpp"
     break;
 
-  case 117:
-#line 943 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 118: /* options: %empty  */
+#line 1012 "arangod/Aql/grammar.y"
+                {
       (yyval.node) = nullptr;
     }
-#line 2954 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3215 "arangod/Aql/grammar.cpp"
     break;
 
-  case 118:
-#line 946 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 119: /* options: "identifier" object  */
+#line 1015 "arangod/Aql/grammar.y"
+                    {
       if ((yyvsp[-1].strval) == nullptr || (yyvsp[0].node) == nullptr) {
         ABORT_OOM
       }
@@ -2966,73 +3384,73 @@ yyreduce:
 
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2970 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3231 "arangod/Aql/grammar.cpp"
     break;
 
-  case 119:
-#line 960 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 120: /* $@7: %empty  */
+#line 1029 "arangod/Aql/grammar.y"
+                  {
       auto node = parser->ast()->createNodeObject();
       parser->pushStack(node);
     }
-#line 2979 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3240 "arangod/Aql/grammar.cpp"
     break;
 
-  case 120:
-#line 963 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 121: /* object: "{" $@7 optional_object_elements "}"  */
+#line 1032 "arangod/Aql/grammar.y"
+                                              {
       (yyval.node) = static_cast<AstNode*>(parser->popStack());
     }
-#line 2987 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3248 "arangod/Aql/grammar.cpp"
     break;
 
-  case 121:
-#line 969 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 122: /* optional_object_elements: %empty  */
+#line 1038 "arangod/Aql/grammar.y"
+                {
     }
-#line 2994 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3255 "arangod/Aql/grammar.cpp"
     break;
 
-  case 122:
-#line 971 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 123: /* optional_object_elements: object_elements_list  */
+#line 1040 "arangod/Aql/grammar.y"
+                         {
     }
-#line 3001 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3262 "arangod/Aql/grammar.cpp"
     break;
 
-  case 123:
-#line 976 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 124: /* object_elements_list: object_element  */
+#line 1045 "arangod/Aql/grammar.y"
+                   {
     }
-#line 3008 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3269 "arangod/Aql/grammar.cpp"
     break;
 
-  case 124:
-#line 978 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 125: /* object_elements_list: object_elements_list "," object_element  */
+#line 1047 "arangod/Aql/grammar.y"
+                                                {
     }
-#line 3015 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3276 "arangod/Aql/grammar.cpp"
     break;
 
-  case 125:
-#line 983 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 126: /* object_element: object_element_name ":" expression  */
+#line 1052 "arangod/Aql/grammar.y"
+                                           {
       parser->pushObjectElement((yyvsp[-2].strval), (yyvsp[0].node));
     }
-#line 3023 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3284 "arangod/Aql/grammar.cpp"
     break;
 
-  case 126:
-#line 986 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 127: /* object_element: "[" expression "]" ":" expression  */
+#line 1055 "arangod/Aql/grammar.y"
+                                                             {
       parser->pushObjectElement((yyvsp[-3].node), (yyvsp[0].node));
     }
-#line 3031 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3292 "arangod/Aql/grammar.cpp"
     break;
 
-  case 127:
-#line 989 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 128: /* object_element: "bind parameter" ":" expression  */
+#line 1058 "arangod/Aql/grammar.y"
+                                   {
       if ((yyvsp[-2].strval) == nullptr) {
         ABORT_OOM
       }
@@ -3044,21 +3462,21 @@ yyreduce:
       auto param = parser->ast()->createNodeParameter((yyvsp[-2].strval));
       parser->pushObjectElement(param, (yyvsp[0].node));
     }
-#line 3048 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3309 "arangod/Aql/grammar.cpp"
     break;
 
-  case 128:
-#line 1004 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 129: /* reference: single_reference  */
+#line 1073 "arangod/Aql/grammar.y"
+                     {
       // start of reference (collection or variable name)
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3057 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3318 "arangod/Aql/grammar.cpp"
     break;
 
-  case 129:
-#line 1008 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 130: /* $@8: %empty  */
+#line 1077 "arangod/Aql/grammar.y"
+              {
       // expanded variable access, e.g. variable[*]
 
       // create a temporary iterator variable
@@ -3069,12 +3487,12 @@ yyreduce:
       parser->pushStack(iterator);
       parser->pushStack(parser->ast()->createNodeReference(iteratorName));
     }
-#line 3073 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3334 "arangod/Aql/grammar.cpp"
     break;
 
-  case 130:
-#line 1018 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 131: /* reference: reference $@8 "[*] operator" expansion  */
+#line 1087 "arangod/Aql/grammar.y"
+                         {
       // return from the "expansion" subrule
 
       // push the expand node into the statement list
@@ -3085,12 +3503,12 @@ yyreduce:
         ABORT_OOM
       }
     }
-#line 3089 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3350 "arangod/Aql/grammar.cpp"
     break;
 
-  case 131:
-#line 1032 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 132: /* single_reference: "identifier"  */
+#line 1101 "arangod/Aql/grammar.y"
+             {
       // variable or collection
       auto ast = parser->ast();
       AstNode* node = nullptr;
@@ -3126,212 +3544,212 @@ yyreduce:
 
       (yyval.node) = node;
     }
-#line 3130 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3391 "arangod/Aql/grammar.cpp"
     break;
 
-  case 132:
-#line 1068 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 133: /* single_reference: function_call  */
+#line 1137 "arangod/Aql/grammar.y"
+                  {
       (yyval.node) = (yyvsp[0].node);
       
       if ((yyval.node) == nullptr) {
         ABORT_OOM
       }
     }
-#line 3142 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3403 "arangod/Aql/grammar.cpp"
     break;
 
-  case 133:
-#line 1075 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 134: /* single_reference: single_reference '.' "identifier"  */
+#line 1144 "arangod/Aql/grammar.y"
+                                                  {
       // named variable access, e.g. variable.reference
       (yyval.node) = parser->ast()->createNodeAttributeAccess((yyvsp[-2].node), (yyvsp[0].strval));
     }
-#line 3151 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3412 "arangod/Aql/grammar.cpp"
     break;
 
-  case 134:
-#line 1079 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 135: /* single_reference: single_reference '.' bind_parameter  */
+#line 1148 "arangod/Aql/grammar.y"
+                                                        {
       // named variable access, e.g. variable.@reference
       (yyval.node) = parser->ast()->createNodeBoundAttributeAccess((yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3160 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3421 "arangod/Aql/grammar.cpp"
     break;
 
-  case 135:
-#line 1083 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 136: /* single_reference: single_reference "[" expression "]"  */
+#line 1152 "arangod/Aql/grammar.y"
+                                                                         {
       // indexed variable access, e.g. variable[index]
       (yyval.node) = parser->ast()->createNodeIndexedAccess((yyvsp[-3].node), (yyvsp[-1].node));
     }
-#line 3169 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3430 "arangod/Aql/grammar.cpp"
     break;
 
-  case 136:
-#line 1090 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 137: /* expansion: '.' "identifier"  */
+#line 1159 "arangod/Aql/grammar.y"
+                                 {
       // named variable access, continuation from * expansion, e.g. [*].variable.reference
       auto node = static_cast<AstNode*>(parser->popStack());
       (yyval.node) = parser->ast()->createNodeAttributeAccess(node, (yyvsp[0].strval));
     }
-#line 3179 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3440 "arangod/Aql/grammar.cpp"
     break;
 
-  case 137:
-#line 1095 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 138: /* expansion: '.' bind_parameter  */
+#line 1164 "arangod/Aql/grammar.y"
+                                       {
       // named variable access w/ bind parameter, continuation from * expansion, e.g. [*].variable.@reference
       auto node = static_cast<AstNode*>(parser->popStack());
       (yyval.node) = parser->ast()->createNodeBoundAttributeAccess(node, (yyvsp[0].node));
     }
-#line 3189 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3450 "arangod/Aql/grammar.cpp"
     break;
 
-  case 138:
-#line 1100 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 139: /* expansion: "[" expression "]"  */
+#line 1169 "arangod/Aql/grammar.y"
+                                                        {
       // indexed variable access, continuation from * expansion, e.g. [*].variable[index]
       auto node = static_cast<AstNode*>(parser->popStack());
       (yyval.node) = parser->ast()->createNodeIndexedAccess(node, (yyvsp[-1].node));
     }
-#line 3199 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3460 "arangod/Aql/grammar.cpp"
     break;
 
-  case 139:
-#line 1105 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 140: /* expansion: expansion '.' "identifier"  */
+#line 1174 "arangod/Aql/grammar.y"
+                                           {
       // named variable access, continuation from * expansion, e.g. [*].variable.xx.reference
       (yyval.node) = parser->ast()->createNodeAttributeAccess((yyvsp[-2].node), (yyvsp[0].strval));
     }
-#line 3208 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3469 "arangod/Aql/grammar.cpp"
     break;
 
-  case 140:
-#line 1109 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 141: /* expansion: expansion '.' bind_parameter  */
+#line 1178 "arangod/Aql/grammar.y"
+                                                 {
       // named variable access w/ bind parameter, continuation from * expansion, e.g. [*].variable.xx.@reference
       (yyval.node) = parser->ast()->createNodeBoundAttributeAccess((yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3217 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3478 "arangod/Aql/grammar.cpp"
     break;
 
-  case 141:
-#line 1113 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 142: /* expansion: expansion "[" expression "]"  */
+#line 1182 "arangod/Aql/grammar.y"
+                                                                  {
       // indexed variable access, continuation from * expansion, e.g. [*].variable.xx.[index]
       (yyval.node) = parser->ast()->createNodeIndexedAccess((yyvsp[-3].node), (yyvsp[-1].node));
     }
-#line 3226 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3487 "arangod/Aql/grammar.cpp"
     break;
 
-  case 142:
-#line 1120 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 143: /* atomic_value: value_literal  */
+#line 1189 "arangod/Aql/grammar.y"
+                  {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3234 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3495 "arangod/Aql/grammar.cpp"
     break;
 
-  case 143:
-#line 1123 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 144: /* atomic_value: bind_parameter  */
+#line 1192 "arangod/Aql/grammar.y"
+                   {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3242 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3503 "arangod/Aql/grammar.cpp"
     break;
 
-  case 144:
-#line 1129 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 145: /* numeric_value: "integer number"  */
+#line 1198 "arangod/Aql/grammar.y"
+              {
       if ((yyvsp[0].node) == nullptr) {
         ABORT_OOM
       }
       
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3254 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3515 "arangod/Aql/grammar.cpp"
     break;
 
-  case 145:
-#line 1136 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 146: /* numeric_value: "number"  */
+#line 1205 "arangod/Aql/grammar.y"
+             {
       if ((yyvsp[0].node) == nullptr) {
         ABORT_OOM
       }
 
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3266 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3527 "arangod/Aql/grammar.cpp"
     break;
 
-  case 146:
-#line 1146 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 147: /* value_literal: "quoted string"  */
+#line 1215 "arangod/Aql/grammar.y"
+                    {
       (yyval.node) = parser->ast()->createNodeValueString((yyvsp[0].strval)); 
     }
-#line 3274 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3535 "arangod/Aql/grammar.cpp"
     break;
 
-  case 147:
-#line 1149 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 148: /* value_literal: numeric_value  */
+#line 1218 "arangod/Aql/grammar.y"
+                  {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3282 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3543 "arangod/Aql/grammar.cpp"
     break;
 
-  case 148:
-#line 1152 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 149: /* value_literal: "null"  */
+#line 1221 "arangod/Aql/grammar.y"
+           {
       (yyval.node) = parser->ast()->createNodeValueNull();
     }
-#line 3290 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3551 "arangod/Aql/grammar.cpp"
     break;
 
-  case 149:
-#line 1155 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 150: /* value_literal: "true"  */
+#line 1224 "arangod/Aql/grammar.y"
+           {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 3298 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3559 "arangod/Aql/grammar.cpp"
     break;
 
-  case 150:
-#line 1158 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 151: /* value_literal: "false"  */
+#line 1227 "arangod/Aql/grammar.y"
+            {
       (yyval.node) = parser->ast()->createNodeValueBool(false);
     }
-#line 3306 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3567 "arangod/Aql/grammar.cpp"
     break;
 
-  case 151:
-#line 1164 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 152: /* collection_name: "identifier"  */
+#line 1233 "arangod/Aql/grammar.y"
+             {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
 
       (yyval.node) = parser->ast()->createNodeCollection((yyvsp[0].strval), TRI_TRANSACTION_WRITE);
     }
-#line 3318 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3579 "arangod/Aql/grammar.cpp"
     break;
 
-  case 152:
-#line 1171 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 153: /* collection_name: "quoted string"  */
+#line 1240 "arangod/Aql/grammar.y"
+                    {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
 
       (yyval.node) = parser->ast()->createNodeCollection((yyvsp[0].strval), TRI_TRANSACTION_WRITE);
     }
-#line 3330 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3591 "arangod/Aql/grammar.cpp"
     break;
 
-  case 153:
-#line 1178 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 154: /* collection_name: "bind parameter"  */
+#line 1247 "arangod/Aql/grammar.y"
+                {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
@@ -3342,51 +3760,52 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeParameter((yyvsp[0].strval));
     }
-#line 3346 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3607 "arangod/Aql/grammar.cpp"
     break;
 
-  case 154:
-#line 1192 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 155: /* bind_parameter: "bind parameter"  */
+#line 1261 "arangod/Aql/grammar.y"
+                {
       (yyval.node) = parser->ast()->createNodeParameter((yyvsp[0].strval));
     }
-#line 3354 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3615 "arangod/Aql/grammar.cpp"
     break;
 
-  case 155:
-#line 1198 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 156: /* object_element_name: "identifier"  */
+#line 1267 "arangod/Aql/grammar.y"
+             {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
 
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 3366 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3627 "arangod/Aql/grammar.cpp"
     break;
 
-  case 156:
-#line 1205 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 157: /* object_element_name: "quoted string"  */
+#line 1274 "arangod/Aql/grammar.y"
+                    {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
 
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 3378 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3639 "arangod/Aql/grammar.cpp"
     break;
 
-  case 157:
-#line 1214 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 158: /* variable_name: "identifier"  */
+#line 1283 "arangod/Aql/grammar.y"
+             {
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 3386 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3647 "arangod/Aql/grammar.cpp"
     break;
 
 
-#line 3390 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3651 "arangod/Aql/grammar.cpp"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -3400,11 +3819,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -3412,14 +3830,13 @@ yyreduce:
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -3430,59 +3847,54 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (&yylloc, parser, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (&yylloc, parser, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
          error, discard it.  */
 
-      if (yychar <= YYEOF)
+      if (yychar <= T_END)
         {
           /* Return failure if at end of input.  */
-          if (yychar == YYEOF)
+          if (yychar == T_END)
             YYABORT;
         }
       else
@@ -3502,14 +3914,12 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  yyerror_range[1] = yylsp[1-yylen];
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
@@ -3525,13 +3935,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -3545,7 +3956,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp, parser);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, parser);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -3556,13 +3967,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -3573,26 +3982,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (&yylloc, parser, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -3608,16 +4021,15 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, yylsp, parser);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, parser);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
+
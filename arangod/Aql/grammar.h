@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_AQL_ARANGOD_AQL_GRAMMAR_HPP_INCLUDED
 # define YY_AQL_ARANGOD_AQL_GRAMMAR_HPP_INCLUDED
 /* Debug traces.  */
@@ -40,87 +45,92 @@
 extern int Aqldebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    T_END = 0,
-    T_FOR = 258,
-    T_LET = 259,
-    T_FILTER = 260,
-    T_RETURN = 261,
-    T_COLLECT = 262,
-    T_SORT = 263,
-    T_LIMIT = 264,
-    T_ASC = 265,
-    T_DESC = 266,
-    T_IN = 267,
-    T_WITH = 268,
-    T_INTO = 269,
-    T_REMOVE = 270,
-    T_INSERT = 271,
-    T_UPDATE = 272,
-    T_REPLACE = 273,
-    T_UPSERT = 274,
-    T_NULL = 275,
-    T_TRUE = 276,
-    T_FALSE = 277,
-    T_STRING = 278,
-    T_QUOTED_STRING = 279,
-    T_INTEGER = 280,
-    T_DOUBLE = 281,
-    T_PARAMETER = 282,
-    T_ASSIGN = 283,
-    T_NOT = 284,
-    T_AND = 285,
-    T_OR = 286,
-    T_EQ = 287,
-    T_NE = 288,
-    T_LT = 289,
-    T_GT = 290,
-    T_LE = 291,
-    T_GE = 292,
-    T_PLUS = 293,
-    T_MINUS = 294,
-    T_TIMES = 295,
-    T_DIV = 296,
-    T_MOD = 297,
-    T_EXPAND = 298,
-    T_QUESTION = 299,
-    T_COLON = 300,
-    T_SCOPE = 301,
-    T_RANGE = 302,
-    T_COMMA = 303,
-    T_OPEN = 304,
-    T_CLOSE = 305,
-    T_OBJECT_OPEN = 306,
-    T_OBJECT_CLOSE = 307,
-    T_ARRAY_OPEN = 308,
-    T_ARRAY_CLOSE = 309,
-    T_NIN = 310,
-    UMINUS = 311,
-    UPLUS = 312,
-    FUNCCALL = 313,
-    REFERENCE = 314,
-    INDEXED = 315
+    YYEMPTY = -2,
+    T_END = 0,                     /* "end of query string"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    T_FOR = 258,                   /* "FOR declaration"  */
+    T_LET = 259,                   /* "LET declaration"  */
+    T_FILTER = 260,                /* "FILTER declaration"  */
+    T_RETURN = 261,                /* "RETURN declaration"  */
+    T_COLLECT = 262,               /* "COLLECT declaration"  */
+    T_SORT = 263,                  /* "SORT declaration"  */
+    T_LIMIT = 264,                 /* "LIMIT declaration"  */
+    T_ASC = 265,                   /* "ASC keyword"  */
+    T_DESC = 266,                  /* "DESC keyword"  */
+    T_IN = 267,                    /* "IN keyword"  */
+    T_WITH = 268,                  /* "WITH keyword"  */
+    T_INTO = 269,                  /* "INTO keyword"  */
+    T_REMOVE = 270,                /* "REMOVE command"  */
+    T_INSERT = 271,                /* "INSERT command"  */
+    T_UPDATE = 272,                /* "UPDATE command"  */
+    T_REPLACE = 273,               /* "REPLACE command"  */
+    T_UPSERT = 274,                /* "UPSERT command"  */
+    T_NULL = 275,                  /* "null"  */
+    T_TRUE = 276,                  /* "true"  */
+    T_FALSE = 277,                 /* "false"  */
+    T_STRING = 278,                /* "identifier"  */
+    T_QUOTED_STRING = 279,         /* "quoted string"  */
+    T_INTEGER = 280,               /* "integer number"  */
+    T_DOUBLE = 281,                /* "number"  */
+    T_PARAMETER = 282,             /* "bind parameter"  */
+    T_ASSIGN = 283,                /* "assignment"  */
+    T_NOT = 284,                   /* "not operator"  */
+    T_AND = 285,                   /* "and operator"  */
+    T_OR = 286,                    /* "or operator"  */
+    T_EQ = 287,                    /* "== operator"  */
+    T_NE = 288,                    /* "!= operator"  */
+    T_LT = 289,                    /* "< operator"  */
+    T_GT = 290,                    /* "> operator"  */
+    T_LE = 291,                    /* "<= operator"  */
+    T_GE = 292,                    /* ">= operator"  */
+    T_PLUS = 293,                  /* "+ operator"  */
+    T_MINUS = 294,                 /* "- operator"  */
+    T_TIMES = 295,                 /* "* operator"  */
+    T_DIV = 296,                   /* "/ operator"  */
+    T_MOD = 297,                   /* "% operator"  */
+    T_EXPAND = 298,                /* "[*] operator"  */
+    T_QUESTION = 299,              /* "?"  */
+    T_COLON = 300,                 /* ":"  */
+    T_SCOPE = 301,                 /* "::"  */
+    T_RANGE = 302,                 /* ".."  */
+    T_COMMA = 303,                 /* ","  */
+    T_OPEN = 304,                  /* "("  */
+    T_CLOSE = 305,                 /* ")"  */
+    T_OBJECT_OPEN = 306,           /* "{"  */
+    T_OBJECT_CLOSE = 307,          /* "}"  */
+    T_ARRAY_OPEN = 308,            /* "["  */
+    T_ARRAY_CLOSE = 309,           /* "]"  */
+    T_NIN = 310,                   /* T_NIN  */
+    UMINUS = 311,                  /* UMINUS  */
+    UPLUS = 312,                   /* UPLUS  */
+    FUNCCALL = 313,                /* FUNCCALL  */
+    REFERENCE = 314,               /* REFERENCE  */
+    INDEXED = 315                  /* INDEXED  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
 union YYSTYPE
 {
-#line 22 "arangod/Aql/grammar.y" /* yacc.c:1909  */
+#line 22 "arangod/Aql/grammar.y"
 
   triagens::aql::AstNode*  node;
   char*                    strval;
   bool                     boolval;
   int64_t                  intval;
 
-#line 123 "arangod/Aql/grammar.hpp" /* yacc.c:1909  */
+#line 131 "arangod/Aql/grammar.hpp"
+
 };
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
 #endif
@@ -141,6 +151,8 @@ struct YYLTYPE
 
 
 
+
 int Aqlparse (triagens::aql::Parser* parser);
 
+
 #endif /* !YY_AQL_ARANGOD_AQL_GRAMMAR_HPP_INCLUDED  */
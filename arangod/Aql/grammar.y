@@ -159,7 +159,9 @@ void Aqlerror (YYLTYPE* locp,
 %type <node> collect_list;
 %type <node> collect_element;
 %type <node> collect_variable_list;
+%type <node> aggregate;
 %type <node> keep;
+%type <node> variable_list;
 %type <strval> optional_into;
 %type <strval> count_into;
 %type <node> expression;
@@ -300,16 +302,18 @@ count_into:
   ;
 
 collect_variable_list:
-    T_COLLECT {
-      auto node = parser->ast()->createNodeArray();
-      parser->pushStack(node);
-    } collect_list { 
-      auto list = static_cast<AstNode*>(parser->popStack());
+    T_COLLECT collect_list { 
+      $$ = $2;
+    }
+  ;
 
-      if (list == nullptr) {
-        ABORT_OOM
+aggregate:
+    T_STRING collect_list {
+      if (! TRI_CaseEqualString($1, "AGGREGATE")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'AGGREGATE'", $1, yylloc.first_line, yylloc.first_column);
       }
-      $$ = list;
+
+      $$ = $2;
     }
   ;
 
@@ -443,19 +447,84 @@ collect_statement:
       auto node = parser->ast()->createNodeCollectExpression($1, $3, $5, $6);
       parser->ast()->addOperation(node);
     }
+  | T_COLLECT aggregate options {
+      auto scopes = parser->ast()->scopes();
+
+      // check if we are in the main scope
+      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
+
+      if (reRegisterVariables) {
+        // end the active scopes
+        scopes->endNested();
+        // start a new scope
+        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
+
+        size_t const n = $2->numMembers();
+        for (size_t i = 0; i < n; ++i) {
+          auto member = $2->getMember(i);
+
+          if (member != nullptr) {
+            TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
+            auto v = static_cast<Variable*>(member->getMember(0)->getData());
+            scopes->addVariable(v);
+          }
+        }
+      }
+
+      auto node = parser->ast()->createNodeCollectAggregate(parser->ast()->createNodeArray(), $2, $3);
+      parser->ast()->addOperation(node);
+    }
+  | collect_variable_list optional_into aggregate options {
+      auto scopes = parser->ast()->scopes();
+
+      // check if we are in the main scope
+      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
+
+      if (reRegisterVariables) {
+        // end the active scopes
+        scopes->endNested();
+        // start a new scope
+        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
+
+        // register the group variables and the aggregate variables
+        for (auto const& list : { $1, $3 }) {
+          size_t const n = list->numMembers();
+          for (size_t i = 0; i < n; ++i) {
+            auto member = list->getMember(i);
+
+            if (member != nullptr) {
+              TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
+              auto v = static_cast<Variable*>(member->getMember(0)->getData());
+              scopes->addVariable(v);
+            }
+          }
+        }
+      }
+
+      if ($2 != nullptr) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of 'INTO' together with 'AGGREGATE'", yylloc.first_line, yylloc.first_column);
+      } 
+
+      auto node = parser->ast()->createNodeCollectAggregate($1, $3, $4);
+      parser->ast()->addOperation(node);
+    }
   ;
 
 collect_list: 
     collect_element {
+      auto node = parser->ast()->createNodeArray();
+      node->addMember($1);
+      $$ = node;
     }
   | collect_list T_COMMA collect_element {
+      $1->addMember($3);
+      $$ = $1;
     }
   ;
 
 collect_element:
     variable_name T_ASSIGN expression {
-      auto node = parser->ast()->createNodeAssign($1, $3);
-      parser->pushArrayElement(node);
+      $$ = parser->ast()->createNodeAssign($1, $3);
     }
   ;
 
@@ -481,7 +550,10 @@ variable_list:
 
       // indicate the this node is a reference to the variable name, not the variable value
       node->setFlag(FLAG_KEEP_VARIABLENAME);
-      parser->pushArrayElement(node);
+
+      auto list = parser->ast()->createNodeArray();
+      list->addMember(node);
+      $$ = list;
     }
   | variable_list T_COMMA variable_name {
       if (! parser->ast()->scopes()->existsVariable($3)) {
@@ -495,21 +567,18 @@ variable_list:
 
       // indicate the this node is a reference to the variable name, not the variable value
       node->setFlag(FLAG_KEEP_VARIABLENAME);
-      parser->pushArrayElement(node);
+      $1->addMember(node);
+      $$ = $1;
     }
   ;
 
 keep: 
-    T_STRING {
+    T_STRING variable_list {
       if (! TRI_CaseEqualString($1, "KEEP")) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'KEEP'", $1, yylloc.first_line, yylloc.first_column);
       }
 
-      auto node = parser->ast()->createNodeArray();
-      parser->pushStack(node);
-    } variable_list {
-      auto list = static_cast<AstNode*>(parser->popStack());
-      $$ = list;
+      $$ = $2;
     }
   ;
 
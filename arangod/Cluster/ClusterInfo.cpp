@@ -725,6 +725,7 @@ TRI_col_info_t ClusterInfo::getCollectionProperties (CollectionInfo const& colle
   
   info._keyOptions   = collection.keyOptions();
 
+  info._compressStrings = collection.compressStrings();
   info._deleted      = collection.deleted();
   info._doCompact    = collection.doCompact();
   info._isSystem     = collection.isSystem();
@@ -173,6 +173,14 @@ namespace triagens {
           return triagens::basics::JsonHelper::getBooleanValue(_json, "isVolatile", false);
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the compressStrings flag
+////////////////////////////////////////////////////////////////////////////////
+
+        bool compressStrings () const {
+          return triagens::basics::JsonHelper::getBooleanValue(_json, "compressStrings", false);
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns the indexes
 ////////////////////////////////////////////////////////////////////////////////
@@ -417,6 +417,7 @@ int figuresOnCoordinator (string const& dbname,
             result->_numberShapes         += ExtractFigure<TRI_voc_ssize_t>(figures, "shapes", "count");
             result->_numberAttributes     += ExtractFigure<TRI_voc_ssize_t>(figures, "attributes", "count");
             result->_numberIndexes        += ExtractFigure<TRI_voc_ssize_t>(figures, "indexes", "count");
+            result->_numberIndexFillPending += ExtractFigure<TRI_voc_ssize_t>(figures, "indexes", "fillPending");
 
             result->_sizeAlive            += ExtractFigure<int64_t>(figures, "alive", "size");
             result->_sizeDead             += ExtractFigure<int64_t>(figures, "dead", "size");
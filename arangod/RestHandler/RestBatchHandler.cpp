@@ -193,6 +193,14 @@ Handler::status_t RestBatchHandler::execute () {
     return status_t(Handler::HANDLER_DONE);
   }
 
+  // the whole multipart message may be compressed
+  int res = _request->uncompressBody();
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    generateError(HttpResponse::BAD, res, "invalid compressed request body");
+    return status_t(Handler::HANDLER_FAILED);
+  }
+
   string boundary;
 
   // invalid content-type or boundary sent
@@ -292,6 +292,27 @@ triagens::basics::Json RestCursorHandler::buildExtra (triagens::aql::QueryResult
 /// - *maxPlans*: limits the maximum number of plans that are created by the AQL
 ///   query optimizer.
 ///
+/// - *cachePlan*: if set to *true*, the optimized execution plan of the query is
+///   put into the database's plan cache, and later executions of the same query
+///   string with the same options reuse it instead of parsing and optimizing the
+///   query again. Bind parameters that are only compared once against an
+///   attribute are replaced in the cached plan, so the plan is shared for all
+///   their values; plans for other bind parameters are cached per value. The
+///   plan cache is cleared whenever an index is created or dropped, or a
+///   collection is dropped or renamed.
+///
+/// - *stream*: if set to *true*, the query will not be executed completely
+///   before the first results are returned. Instead, the server will keep the
+///   query's execution state and produce only *batchSize* results for every
+///   call to `PUT /_api/cursor/<cursor-id>`. This keeps memory usage and
+///   time-to-first-result bounded for queries with huge results. The *count*
+///   attribute is not available for streaming cursors, and the *extra* attribute
+///   with the query's statistics and warnings is only returned with the last
+///   batch. Note that the query's transaction (and its collection locks) will be
+///   kept until the cursor is exhausted, deleted or expires. Until then, the
+///   query is reported by `GET /_api/query/current` and can be killed using
+///   `DELETE /_api/query/<query-id>`.
+///
 /// - *optimizer.rules*: a list of to-be-included or to-be-excluded optimizer rules
 ///   can be put into this attribute, telling the optimizer to include or exclude
 ///   specific rules. To disable a rule, prefix its name with a `-`, to enable a rule, prefix it
@@ -602,6 +623,11 @@ void RestCursorHandler::createCursor () {
     }
     
     auto options = buildOptions(json.get());
+
+    if (triagens::basics::JsonHelper::getBooleanValue(options.json(), "stream", false)) {
+      createStreamCursor(queryString, bindVars, options);
+      return;
+    }
   
     triagens::aql::Query query(_applicationV8, 
                                false, 
@@ -712,6 +738,77 @@ void RestCursorHandler::createCursor () {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a streaming cursor and return the first results
+////////////////////////////////////////////////////////////////////////////////
+
+void RestCursorHandler::createStreamCursor (TRI_json_t const* queryString,
+                                            TRI_json_t const* bindVars,
+                                            triagens::basics::Json const& options) {
+  std::unique_ptr<triagens::aql::Query> query(new triagens::aql::Query(
+    _applicationV8, 
+    false, 
+    _vocbase, 
+    queryString->_value._string.data,
+    static_cast<size_t>(queryString->_value._string.length - 1),
+    (bindVars != nullptr ? TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, bindVars) : nullptr),
+    TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, options.json()), 
+    triagens::aql::PART_MAIN
+  ));
+
+  // only prepare the query here. it will be executed piecewise by the cursor
+  registerQuery(query.get()); 
+  auto queryResult = query->prepare(_queryRegistry);
+  unregisterQuery(); 
+
+  if (queryResult.code != TRI_ERROR_NO_ERROR) {
+    if (queryResult.code == TRI_ERROR_REQUEST_CANCELED ||
+        (queryResult.code == TRI_ERROR_QUERY_KILLED && wasCancelled())) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_REQUEST_CANCELED);
+    }
+
+    THROW_ARANGO_EXCEPTION_MESSAGE(queryResult.code, queryResult.details);
+  }
+
+  size_t batchSize = triagens::basics::JsonHelper::getNumericValue<size_t>(options.json(), "batchSize", 1000);
+  double ttl = triagens::basics::JsonHelper::getNumericValue<double>(options.json(), "ttl", 30);
+
+  // park the query in the registry. the cursor will take it out for each batch
+  auto const queryId = static_cast<triagens::aql::QueryId>(TRI_NewTickServer());
+  _queryRegistry->insert(queryId, query.get(), ttl);
+  query.release();
+
+  auto cursors = static_cast<triagens::arango::CursorRepository*>(_vocbase->_cursorRepository);
+  TRI_ASSERT(cursors != nullptr);
+
+  triagens::arango::StreamCursor* cursor = nullptr;
+
+  try {
+    cursor = cursors->createFromQuery(queryId, batchSize, ttl);
+  }
+  catch (...) {
+    _queryRegistry->destroy(_vocbase, queryId, TRI_ERROR_INTERNAL);
+    throw;
+  }
+  
+  _response = createResponse(HttpResponse::CREATED);
+  _response->setContentType("application/json; charset=utf-8");
+
+  try {
+    _response->body().appendChar('{');
+    cursor->dump(_response->body());
+    _response->body().appendText(",\"error\":false,\"code\":");
+    _response->body().appendInteger(static_cast<uint32_t>(_response->responseCode()));
+    _response->body().appendChar('}');
+
+    cursors->release(cursor);
+  }
+  catch (...) {
+    cursors->release(cursor);
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @startDocuBlock JSF_post_api_cursor_identifier
 /// @brief return the next results from an existing cursor
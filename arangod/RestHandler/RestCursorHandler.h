@@ -142,6 +142,14 @@ namespace triagens {
 
         void createCursor ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a streaming cursor and return the first results
+////////////////////////////////////////////////////////////////////////////////
+
+        void createStreamCursor (TRI_json_t const*,
+                                 TRI_json_t const*,
+                                 triagens::basics::Json const&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the next results from an existing cursor
 ////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,70 @@ using namespace triagens::basics;
 using namespace triagens::rest;
 using namespace triagens::arango;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skips whitespace
+////////////////////////////////////////////////////////////////////////////////
+
+static char const* SkipWhitespace (char const* ptr,
+                                   char const* end) {
+  while (ptr < end &&
+         (*ptr == ' ' || *ptr == '\t' || *ptr == '\r' || *ptr == '\n' || *ptr == '\b' || *ptr == '\f')) {
+    ++ptr;
+  }
+
+  return ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finds the end of a JSON array element
+///
+/// returns the position of the comma or closing bracket following the
+/// element, or end if there is none. the element itself is not validated
+////////////////////////////////////////////////////////////////////////////////
+
+static char const* FindElementEnd (char const* ptr,
+                                   char const* end) {
+  int depth = 0;
+  bool inString = false;
+
+  while (ptr < end) {
+    char const c = *ptr;
+
+    if (inString) {
+      if (c == '\\') {
+        // skip the escaped character
+        ++ptr;
+      }
+      else if (c == '"') {
+        inString = false;
+      }
+    }
+    else if (c == '"') {
+      inString = true;
+    }
+    else if (c == '{' || c == '[') {
+      ++depth;
+    }
+    else if (c == '}' || c == ']') {
+      if (depth == 0) {
+        return ptr;
+      }
+      --depth;
+    }
+    else if (c == ',' && depth == 0) {
+      return ptr;
+    }
+
+    ++ptr;
+  }
+
+  return end;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -71,6 +135,14 @@ HttpHandler::status_t RestImportHandler::execute () {
     return status_t(HANDLER_DONE);
   }
   
+  // clients may send big imports compressed
+  int res = _request->uncompressBody();
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    generateError(HttpResponse::BAD, res, "invalid compressed request body");
+    return status_t(HANDLER_FAILED);
+  }
+
   // set default value for onDuplicate
   _onDuplicateAction = DUPLICATE_ERROR;
       
@@ -868,27 +940,59 @@ bool RestImportHandler::createFromJson (string const& type) {
   }
 
   else {
-    // the entire request body is one JSON document
-    TRI_json_t* documents = TRI_Json2String(TRI_UNKNOWN_MEM_ZONE, _request->body(), nullptr);
+    // the entire request body is one JSON array. the array elements are
+    // parsed and imported one at a time, so there is only ever one document
+    // in memory besides the request body. if the body turns out to be
+    // invalid, the transaction is rolled back
+    char const* ptr = SkipWhitespace(_request->body(), _request->body() + _request->bodySize());
+    char const* end = _request->body() + _request->bodySize();
+    bool valid = (ptr < end && *ptr == '[');
+    size_t i = 0;
 
-    if (! TRI_IsArrayJson(documents)) {
-      if (documents != nullptr) {
-        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, documents);
-      }
+    if (valid) {
+      ptr = SkipWhitespace(ptr + 1, end);
 
-      generateError(HttpResponse::BAD,
-                    TRI_ERROR_HTTP_BAD_PARAMETER,
-                    "expecting a JSON array in the request");
-      return false;
+      if (ptr < end && *ptr == ']') {
+        // empty array
+        ptr = SkipWhitespace(ptr + 1, end);
+        valid = (ptr == end || *ptr == '\0');
+        ptr = end;
+      }
     }
 
-    size_t const n = TRI_LengthArrayJson(documents);
+    while (valid && ptr < end) {
+      char const* elementEnd = FindElementEnd(ptr, end);
 
-    for (size_t i = 0; i < n; ++i) {
-      TRI_json_t const* json = static_cast<TRI_json_t const*>(TRI_AtVector(&documents->_value._objects, i));
+      if (elementEnd == end) {
+        // unterminated array
+        valid = false;
+        break;
+      }
+
+      // temporarily terminate the element, the parser expects a C string
+      char const separator = *elementEnd;
+      *(const_cast<char*>(elementEnd)) = '\0';
+      TRI_json_t* json = parseJsonLine(ptr, elementEnd);
+      *(const_cast<char*>(elementEnd)) = separator;
+
+      if (json == nullptr) {
+        valid = false;
+        break;
+      }
+
+      res = handleSingleDocument(trx, result, nullptr, json, isEdgeCollection, waitForSync, ++i);
+
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+      if (separator == ']') {
+        ptr = SkipWhitespace(elementEnd + 1, end);
+        valid = (ptr == end || *ptr == '\0');
+        ptr = end;
+      }
+      else {
+        ptr = elementEnd + 1;
+      }
 
-      res = handleSingleDocument(trx, result, nullptr, json, isEdgeCollection, waitForSync, i + 1);
-      
       if (res != TRI_ERROR_NO_ERROR) {
         if (complete) {
           // only perform a full import: abort
@@ -899,7 +1003,13 @@ bool RestImportHandler::createFromJson (string const& type) {
       }
     }
 
-    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, documents);
+    if (! valid) {
+      // the transaction is rolled back when it goes out of scope
+      generateError(HttpResponse::BAD,
+                    TRI_ERROR_HTTP_BAD_PARAMETER,
+                    "expecting a JSON array in the request");
+      return false;
+    }
   }
 
 
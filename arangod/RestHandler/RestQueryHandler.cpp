@@ -284,6 +284,54 @@ bool RestQueryHandler::readQuery (bool slow) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @startDocuBlock GetApiQueryPlanCache
+/// @brief returns the statistics of the AQL plan cache
+///
+/// @RESTHEADER{GET /_api/query/plan-cache, Returns the statistics of the AQL plan cache}
+///
+/// Returns the statistics of the plan cache for queries that were executed
+/// with the *cachePlan* option. The result is a JSON object with the following
+/// attributes:
+///
+/// - *hits*: number of queries whose execution plan was taken from the cache
+///
+/// - *misses*: number of queries whose execution plan was not in the cache
+///
+/// - *invalidations*: number of times the cache was cleared because an index
+///   was created or dropped, or a collection was dropped or renamed
+///
+/// - *plans*: number of plans currently in the cache
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// Is returned when the statistics can be retrieved successfully.
+///
+/// @RESTRETURNCODE{400}
+/// The server will respond with *HTTP 400* in case of a malformed request,
+///
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::readQueryPlanCache () {
+  auto queryList = static_cast<QueryList*>(_vocbase->_queries);
+  auto planCache = queryList->planCache();
+
+  Json result(Json::Object);
+
+  result
+  .set("error", Json(false))
+  .set("code", Json(HttpResponse::OK))
+  .set("hits", Json(static_cast<double>(planCache->hits())))
+  .set("misses", Json(static_cast<double>(planCache->misses())))
+  .set("invalidations", Json(static_cast<double>(planCache->invalidations())))
+  .set("plans", Json(static_cast<double>(planCache->size())));
+
+  generateResult(HttpResponse::OK, result.json());
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns AQL query tracking
 ////////////////////////////////////////////////////////////////////////////////
@@ -309,10 +357,13 @@ bool RestQueryHandler::readQuery () {
   else if (name == "properties") {
     return readQueryProperties();
   }
+  else if (name == "plan-cache") {
+    return readQueryPlanCache();
+  }
 
   generateError(HttpResponse::NOT_FOUND,
                 TRI_ERROR_HTTP_NOT_FOUND,
-                "unknown type '" + name + "', expecting 'slow', 'current', or 'properties'");
+                "unknown type '" + name + "', expecting 'slow', 'current', 'properties', or 'plan-cache'");
   return true;
 }
 
@@ -349,6 +400,40 @@ bool RestQueryHandler::deleteQuerySlow () {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @startDocuBlock DeleteApiQueryPlanCache
+/// @brief clears the AQL plan cache
+///
+/// @RESTHEADER{DELETE /_api/query/plan-cache, Clears the AQL plan cache}
+///
+/// Removes all execution plans from the plan cache. The statistics of the
+/// cache are kept.
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// The server will respond with *HTTP 200* when the plan cache was cleared
+/// successfully.
+///
+/// @RESTRETURNCODE{400}
+/// The server will respond with *HTTP 400* in case of a malformed request.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::deleteQueryPlanCache () {
+  auto queryList = static_cast<triagens::aql::QueryList*>(_vocbase->_queries);
+  queryList->planCache()->invalidate();
+
+  Json result(Json::Object);
+
+  result
+  .set("error", Json(false))
+  .set("code", Json(HttpResponse::OK));
+
+  generateResult(HttpResponse::OK, result.json());
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @startDocuBlock DeleteApiQueryKill
 /// @brief kills an AQL query
@@ -411,7 +496,7 @@ bool RestQueryHandler::deleteQuery () {
   if (suffix.size() != 1) {
     generateError(HttpResponse::BAD,
                   TRI_ERROR_HTTP_BAD_PARAMETER,
-                  "expecting DELETE /_api/query/<id> or /_api/query/slow");
+                  "expecting DELETE /_api/query/<id>, /_api/query/slow or /_api/query/plan-cache");
     return true;
   }
 
@@ -420,6 +505,9 @@ bool RestQueryHandler::deleteQuery () {
   if (name == "slow") {
     return deleteQuerySlow();
   }
+  else if (name == "plan-cache") {
+    return deleteQueryPlanCache();
+  }
   else {
     return deleteQuery(name);
   }
@@ -106,12 +106,24 @@ namespace triagens {
 
         bool readQuery ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the plan cache statistics
+////////////////////////////////////////////////////////////////////////////////
+
+        bool readQueryPlanCache ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief removes the slow log
 ////////////////////////////////////////////////////////////////////////////////
 
         bool deleteQuerySlow ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes all plans from the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        bool deleteQueryPlanCache ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief interrupts a named query
 ////////////////////////////////////////////////////////////////////////////////
@@ -1473,6 +1473,7 @@ int RestReplicationHandler::createCollection (TRI_json_t const* json,
   params._doCompact   = JsonHelper::getBooleanValue(json, "doCompact", true);
   params._waitForSync = JsonHelper::getBooleanValue(json, "waitForSync", _vocbase->_settings.defaultWaitForSync);
   params._isVolatile  = JsonHelper::getBooleanValue(json, "isVolatile", false);
+  params._compressStrings = JsonHelper::getBooleanValue(json, "compressStrings", false);
   params._isSystem    = (name[0] == '_');
   params._planId      = 0;
 
@@ -59,6 +59,60 @@
 // lists: lexicographically and within each slot according to these rules.
 // ...........................................................................
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compares the normalized key prefixes of two values
+///
+/// returns 0 if the prefixes do not decide the order, in which case the
+/// values must be compared with TRI_CompareShapeTypes
+////////////////////////////////////////////////////////////////////////////////
+
+static inline int ComparePrefixes (uint8_t const* left,
+                                   size_t leftLength,
+                                   uint8_t const* right,
+                                   size_t rightLength) {
+  size_t const length = (leftLength < rightLength ? leftLength : rightLength);
+
+  if (length == 0) {
+    return 0;
+  }
+
+  int compareResult = memcmp(left, right, length);
+
+  if (compareResult < 0) {
+    return -1;
+  }
+  else if (compareResult > 0) {
+    return 1;
+  }
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes the normalized key prefix of a lookup key
+////////////////////////////////////////////////////////////////////////////////
+
+static void NormalizeKey (SkiplistIndex* skiplistIndex,
+                          TRI_skiplist_index_key_t* key) {
+  TRI_shaper_t* shaper = skiplistIndex->_collection->getShaper();  // ONLY IN INDEX, PROTECTED by RUNTIME
+
+  size_t length = 0;
+
+  for (size_t j = 0;  j < key->_numFields;  j++) {
+    bool complete;
+    length += TRI_NormalizeShapeType(&key->_fields[j],
+                                     shaper,
+                                     key->_prefix + length,
+                                     TRI_SKIPLIST_INDEX_PREFIX_SIZE - length,
+                                     complete);
+
+    if (! complete) {
+      break;
+    }
+  }
+
+  key->_prefixLength = static_cast<uint8_t>(length);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief compares a key with an element, version with proper types
 ////////////////////////////////////////////////////////////////////////////////
@@ -132,6 +186,20 @@ static int CmpElmElm (void* sli,
     return 0;
   }
 
+  // ..........................................................................
+  // Most comparisons are decided by the normalized key prefixes. Only if
+  // these are equal, the values themselves must be compared.
+  // ..........................................................................
+
+  int prefixResult = ComparePrefixes(leftElement->_prefix,
+                                     leftElement->_prefixLength,
+                                     rightElement->_prefix,
+                                     rightElement->_prefixLength);
+
+  if (prefixResult != 0) {
+    return prefixResult;
+  }
+
   SkiplistIndex* skiplistindex = static_cast<SkiplistIndex*>(sli);
   shaper = skiplistindex->_collection->getShaper();  // ONLY IN INDEX, PROTECTED by RUNTIME
   for (size_t j = 0;  j < skiplistindex->_numFields;  j++) {
@@ -184,6 +252,17 @@ static int CmpKeyElm (void* sli,
   TRI_ASSERT(nullptr != left);
   TRI_ASSERT(nullptr != right);
 
+  // The prefix of the key only covers the fields of the key, so a difference
+  // within the common length is a difference in one of these fields
+  int prefixResult = ComparePrefixes(leftKey->_prefix,
+                                     leftKey->_prefixLength,
+                                     rightElement->_prefix,
+                                     rightElement->_prefixLength);
+
+  if (prefixResult != 0) {
+    return prefixResult;
+  }
+
   SkiplistIndex* skiplistindex = static_cast<SkiplistIndex*>(sli);
   TRI_shaper_t* shaper = skiplistindex->_collection->getShaper();  // ONLY IN INDEX, PROTECTED by RUNTIME
 
@@ -616,6 +695,7 @@ static void SkiplistIndex_findHelper (SkiplistIndex* skiplistIndex,
 
       values._fields     = relationOperator->_fields;
       values._numFields  = relationOperator->_numFields;
+      NormalizeKey(skiplistIndex, &values);
       break;   // this is to silence a compiler warning
 
     default: {
@@ -785,6 +865,38 @@ TRI_skiplist_iterator_t* SkiplistIndex_find (
   return results;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes the normalized key prefix of an element
+////////////////////////////////////////////////////////////////////////////////
+
+void SkiplistIndex_normalizeElement (SkiplistIndex* skiplistIndex,
+                                     TRI_skiplist_index_element_t* element) {
+  TRI_shaper_t* shaper = skiplistIndex->_collection->getShaper();  // ONLY IN INDEX, PROTECTED by RUNTIME
+  char const* ptr = element->_document->getShapedJsonPtr();  // ONLY IN INDEX, PROTECTED by RUNTIME
+  auto subObjects = SkiplistIndex_Subobjects(element);
+
+  size_t length = 0;
+
+  for (size_t j = 0;  j < skiplistIndex->_numFields;  j++) {
+    TRI_shaped_json_t value;
+    value._sid = subObjects[j]._sid;
+    TRI_InspectShapedSub(&subObjects[j], ptr, value);
+
+    bool complete;
+    length += TRI_NormalizeShapeType(&value,
+                                     shaper,
+                                     element->_prefix + length,
+                                     TRI_SKIPLIST_INDEX_PREFIX_SIZE - length,
+                                     complete);
+
+    if (! complete) {
+      break;
+    }
+  }
+
+  element->_prefixLength = static_cast<uint8_t>(length);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief inserts a data element into the skip list
 /// ownership for the element is transferred to the index
@@ -801,6 +913,94 @@ int SkiplistIndex_insert (SkiplistIndex* skiplistIndex,
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sorts a run of elements in the order of the skip list
+///
+/// this only reads the elements and the collection's shaper, so runs can be
+/// sorted by multiple threads in parallel
+////////////////////////////////////////////////////////////////////////////////
+
+void SkiplistIndex_sortElements (SkiplistIndex* skiplistIndex,
+                                 std::vector<TRI_skiplist_index_element_t*>& elements) {
+  std::sort(elements.begin(), elements.end(), 
+    [&skiplistIndex] (TRI_skiplist_index_element_t* left, 
+                      TRI_skiplist_index_element_t* right) -> bool {
+      return CmpElmElm(skiplistIndex, left, right, triagens::basics::SKIPLIST_CMP_TOTORDER) < 0;
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts sorted runs of elements into the skip list
+///
+/// the runs are merged and then appended to the skip list in one go. 
+/// ownership for the elements is transferred to the index, elements that
+/// could not be inserted are freed
+////////////////////////////////////////////////////////////////////////////////
+
+int SkiplistIndex_insertSorted (SkiplistIndex* skiplistIndex,
+                                std::vector<std::vector<TRI_skiplist_index_element_t*>>& runs) {
+  auto less = [&skiplistIndex] (void* left, void* right) -> bool {
+    return CmpElmElm(skiplistIndex, left, right, triagens::basics::SKIPLIST_CMP_TOTORDER) < 0;
+  };
+
+  std::vector<void*> merged;
+  int res = TRI_ERROR_NO_ERROR;
+
+  try {
+    size_t total = 0;
+    for (auto const& run : runs) {
+      total += run.size();
+    }
+
+    std::vector<void*> other;
+    merged.reserve(total);
+    other.reserve(total);
+
+    for (auto const& run : runs) {
+      other.clear();
+      std::merge(merged.begin(), merged.end(), run.begin(), run.end(), std::back_inserter(other), less);
+      merged.swap(other);
+    }
+  }
+  catch (...) {
+    res = TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    if (skiplistIndex->skiplist->getNrUsed() == 0) {
+      // fast path: build the skip list from scratch
+      res = skiplistIndex->skiplist->insertSorted(merged);
+
+      if (res == TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+    }
+    else {
+      for (size_t i = 0; i < merged.size(); ++i) {
+        res = SkiplistIndex_insert(skiplistIndex, static_cast<TRI_skiplist_index_element_t*>(merged[i]));
+
+        if (res != TRI_ERROR_NO_ERROR) {
+          // free the elements not yet inserted
+          for (size_t j = i + 1; j < merged.size(); ++j) {
+            FreeElm(merged[j]);
+          }
+          return res;
+        }
+      }
+      return res;
+    }
+  }
+
+  // nothing was inserted
+  for (auto& run : runs) {
+    for (auto element : run) {
+      FreeElm(element);
+    }
+  }
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief removes an entry from the skip list
 /// ownership for the element is transferred to the index
@@ -44,6 +44,19 @@
 struct TRI_doc_mptr_t;
 struct TRI_document_collection_t;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public constants
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief size of the normalized key prefix stored with elements and keys
+///
+/// chosen so that the element header (document pointer, prefix length and
+/// prefix) fills 32 bytes
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_SKIPLIST_INDEX_PREFIX_SIZE 23
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                        skiplistIndex public types
 // -----------------------------------------------------------------------------
@@ -62,11 +75,16 @@ typedef struct {
   size_t _numFields;   // Note that the number of fields coming from
                        // a query can be smaller than the number of
                        // fields indexed
+  uint8_t _prefixLength; // length of the normalized key prefix
+  uint8_t _prefix[TRI_SKIPLIST_INDEX_PREFIX_SIZE];
 }
 TRI_skiplist_index_key_t;
 
 typedef struct {
   struct TRI_doc_mptr_t* _document; // master document pointer
+  uint8_t _prefixLength; // length of the normalized key prefix
+  uint8_t _prefix[TRI_SKIPLIST_INDEX_PREFIX_SIZE]; // memcmp-comparable
+                                                    // prefix of the values
   // note: the index element also contains a list of shaped subs as follows
   // TRI_shaped_sub_t* _subObjects; 
 }
@@ -149,6 +167,30 @@ TRI_skiplist_iterator_t* SkiplistIndex_find (SkiplistIndex*,
 
 int SkiplistIndex_insert (SkiplistIndex*, TRI_skiplist_index_element_t*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes the normalized key prefix of an element
+///
+/// must be called after the shaped subs of the element have been filled, and
+/// before the element is inserted, removed or compared
+////////////////////////////////////////////////////////////////////////////////
+
+void SkiplistIndex_normalizeElement (SkiplistIndex*,
+                                     TRI_skiplist_index_element_t*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sorts a run of elements in the order of the skip list
+////////////////////////////////////////////////////////////////////////////////
+
+void SkiplistIndex_sortElements (SkiplistIndex*,
+                                 std::vector<TRI_skiplist_index_element_t*>&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts sorted runs of elements into the skip list
+////////////////////////////////////////////////////////////////////////////////
+
+int SkiplistIndex_insertSorted (SkiplistIndex*,
+                                std::vector<std::vector<TRI_skiplist_index_element_t*>>&);
+
 int SkiplistIndex_remove (SkiplistIndex*, TRI_skiplist_index_element_t*);
 
 bool SkiplistIndex_update (SkiplistIndex*, const TRI_skiplist_index_element_t*,
@@ -171,7 +213,7 @@ size_t SkiplistIndex_memoryUsage (SkiplistIndex const*);
 ////////////////////////////////////////////////////////////////////////////////
 
 inline size_t SkiplistIndex_ElementSize (SkiplistIndex const* idx) {
-  return sizeof(TRI_doc_mptr_t*) + (sizeof(TRI_shaped_sub_t) * idx->_numFields);
+  return sizeof(TRI_skiplist_index_element_t) + (sizeof(TRI_shaped_sub_t) * idx->_numFields);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -179,7 +221,7 @@ inline size_t SkiplistIndex_ElementSize (SkiplistIndex const* idx) {
 ////////////////////////////////////////////////////////////////////////////////
   
 inline TRI_shaped_sub_t const* SkiplistIndex_Subobjects (TRI_skiplist_index_element_t const* element) {
-  return reinterpret_cast<TRI_shaped_sub_t const*>(reinterpret_cast<char const*>(element) + sizeof(TRI_doc_mptr_t*));
+  return reinterpret_cast<TRI_shaped_sub_t const*>(reinterpret_cast<char const*>(element) + sizeof(TRI_skiplist_index_element_t));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -187,7 +229,7 @@ inline TRI_shaped_sub_t const* SkiplistIndex_Subobjects (TRI_skiplist_index_elem
 ////////////////////////////////////////////////////////////////////////////////
   
 inline TRI_shaped_sub_t* SkiplistIndex_Subobjects (TRI_skiplist_index_element_t* element) {
-  return reinterpret_cast<TRI_shaped_sub_t*>(reinterpret_cast<char*>(element) + sizeof(TRI_doc_mptr_t*));
+  return reinterpret_cast<TRI_shaped_sub_t*>(reinterpret_cast<char*>(element) + sizeof(TRI_skiplist_index_element_t));
 }
 
 #endif
@@ -29,11 +29,13 @@
 
 #include "Utils/CollectionExport.h"
 #include "Basics/JsonHelper.h"
+#include "Basics/memory-map.h"
 #include "Utils/CollectionGuard.h"
 #include "Utils/CollectionReadLocker.h"
 #include "Utils/transactions.h"
 #include "VocBase/barrier.h"
 #include "VocBase/compactor.h"
+#include "VocBase/datafile.h"
 #include "VocBase/vocbase.h"
 
 using namespace triagens::arango;
@@ -124,15 +126,15 @@ void CollectionExport::run (uint64_t maxWaitTime) {
       THROW_ARANGO_EXCEPTION(res);
     }
 
-    size_t const n = static_cast<size_t>(_document->_primaryIndex._nrAlloc);
+    uint64_t const n = TRI_SlotsPrimaryIndex(&_document->_primaryIndex);
   
     _documents->reserve(static_cast<size_t>(_document->_primaryIndex._nrUsed));
   
-    for (size_t i = 0; i < n; ++i) {
-      auto ptr = _document->_primaryIndex._table[i];
+    for (uint64_t i = 0; i < n; ++i) {
+      auto ptr = TRI_SlotPrimaryIndex(&_document->_primaryIndex, i);
 
       if (ptr != nullptr) {
-        void const* marker = static_cast<TRI_doc_mptr_t const*>(ptr)->getDataPtr();
+        void const* marker = ptr->getDataPtr();
 
         // it is only safe to use the markers from the datafiles, not the WAL
         if (! TRI_IsWalDataMarkerDatafile(marker)) {
@@ -143,6 +145,44 @@ void CollectionExport::run (uint64_t maxWaitTime) {
 
     trx.finish(res);
   }
+
+  // the markers are all located in datafiles, so sorting them by address
+  // turns the hash order of the primary index into sequential reads
+  std::sort(_documents->begin(), _documents->end(), std::less<void const*>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ask the kernel to read ahead the markers of the documents in the
+/// given range
+///
+/// markers that are close to each other are advised as one range. a bigger
+/// gap means the next marker is in a different part of the datafile or in a
+/// different datafile
+////////////////////////////////////////////////////////////////////////////////
+
+void CollectionExport::adviseWillNeed (size_t from,
+                                       size_t count) const {
+  static size_t const MaxGap = 65536;
+
+  size_t const end = (std::min)(_documents->size(), from + count);
+  size_t i = from;
+
+  while (i < end) {
+    char const* start = static_cast<char const*>(_documents->at(i));
+    char const* stop = start;
+
+    for (; i < end; ++i) {
+      char const* ptr = static_cast<char const*>(_documents->at(i));
+
+      if (ptr > stop + MaxGap) {
+        break;
+      }
+
+      stop = ptr + static_cast<TRI_df_marker_t const*>(_documents->at(i))->_size;
+    }
+
+    TRI_MMFileAdvise(start, static_cast<size_t>(stop - start), TRI_MADVISE_WILLNEED);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -88,6 +88,14 @@ namespace triagens {
 
         void run (uint64_t);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ask the kernel to read ahead the markers of the documents in the
+/// given range
+////////////////////////////////////////////////////////////////////////////////
+
+        void adviseWillNeed (size_t,
+                             size_t) const;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
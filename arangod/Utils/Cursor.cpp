@@ -28,10 +28,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Utils/Cursor.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
+#include "Aql/QueryRegistry.h"
 #include "Basics/JsonHelper.h"
 #include "ShapedJson/shaped-json.h"
 #include "Utils/CollectionExport.h"
 #include "VocBase/document-collection.h"
+#include "VocBase/server.h"
 #include "VocBase/vocbase.h"
 #include "VocBase/voc-shaper.h"
 
@@ -294,6 +298,10 @@ void ExportCursor::dump (triagens::basics::StringBuffer& buffer) {
 
   size_t const n = batchSize();
 
+  if (_position == 0) {
+    _ex->adviseWillNeed(_position, n);
+  }
+
   for (size_t i = 0; i < n; ++i) {
     if (! hasNext()) {
       break;
@@ -402,6 +410,9 @@ void ExportCursor::dump (triagens::basics::StringBuffer& buffer) {
     buffer.appendText(",\"id\":\"");
     buffer.appendInteger(id());
     buffer.appendText("\"");
+
+    // the next batch can be read from disk while the client fetches this one
+    _ex->adviseWillNeed(_position, n);
   }
 
   if (hasCount()) {
@@ -418,6 +429,221 @@ void ExportCursor::dump (triagens::basics::StringBuffer& buffer) {
   }
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class StreamCursor
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+StreamCursor::StreamCursor (TRI_vocbase_t* vocbase,
+                            CursorId id,
+                            uint64_t queryId,
+                            size_t batchSize,
+                            double ttl)
+  : Cursor(id, batchSize, nullptr, ttl, false),
+    _vocbase(vocbase),
+    _queryId(queryId),
+    _hasMore(true) {
+
+  TRI_UseVocBase(vocbase);
+}
+        
+StreamCursor::~StreamCursor () {
+  // the cursor may have been garbage-collected before it was fully consumed
+  destroyQuery(TRI_ERROR_TRANSACTION_ABORTED);
+
+  TRI_ReleaseVocBase(_vocbase);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether the cursor contains more data
+////////////////////////////////////////////////////////////////////////////////
+
+bool StreamCursor::hasNext () {
+  return _hasMore;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the next element (not implemented)
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* StreamCursor::next () {
+  // should not be called directly
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the cursor size
+/// the total number of results is unknown until the query is exhausted, so
+/// this returns the number of results handed out so far
+////////////////////////////////////////////////////////////////////////////////
+
+size_t StreamCursor::count () const {
+  return _position;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dump the next batch of results into a string buffer
+////////////////////////////////////////////////////////////////////////////////
+        
+void StreamCursor::dump (triagens::basics::StringBuffer& buffer) {
+  auto registry = queryRegistry();
+
+  if (_queryId == 0 || registry == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_CURSOR_NOT_FOUND);
+  }
+
+  triagens::aql::Query* query = registry->open(_vocbase, _queryId);
+
+  if (query == nullptr) {
+    // query has already been expired by the registry
+    _queryId = 0;
+    _hasMore = false;
+    this->deleted();
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_CURSOR_NOT_FOUND);
+  }
+
+  try {
+    if (query->killed()) {
+      // query was killed via the list of running queries while it was parked
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_KILLED);
+    }
+
+    auto engine = query->engine();
+    auto trx = query->trx();
+    auto const resultRegister = engine->resultRegister();
+
+    buffer.appendText("\"result\":[");
+
+    size_t const n = batchSize();
+    size_t written = 0;
+
+    while (written < n) {
+      // pull only as many rows as are missing for the current batch
+      std::unique_ptr<triagens::aql::AqlItemBlock> value(engine->getSome(n - written, n - written));
+
+      if (value.get() == nullptr) {
+        _hasMore = false;
+        break;
+      }
+
+      auto doc = value->getDocumentCollection(resultRegister);
+      size_t const rows = value->size();
+
+      for (size_t i = 0; i < rows; ++i) {
+        auto const& val = value->getValueReference(i, resultRegister);
+
+        if (val.isEmpty()) {
+          continue;
+        }
+
+        if (written > 0) {
+          buffer.appendChar(',');
+        }
+
+        triagens::basics::Json json(val.toJson(trx, doc));
+        int res = TRI_StringifyJson(buffer.stringBuffer(), json.json());
+
+        if (res != TRI_ERROR_NO_ERROR) {
+          THROW_ARANGO_EXCEPTION(res);
+        }
+
+        ++written;
+      }
+    }
+
+    _position += written;
+
+    if (_hasMore) {
+      _hasMore = engine->hasMore();
+    }
+
+    buffer.appendText("],\"hasMore\":");
+    buffer.appendText(_hasMore ? "true" : "false");
+
+    if (_hasMore) {
+      // only return cursor id if there are more documents
+      buffer.appendText(",\"id\":\"");
+      buffer.appendInteger(id());
+      buffer.appendText("\"");
+
+      registry->close(_vocbase, _queryId, ttl());
+      return;
+    }
+
+    // query is exhausted. return its statistics and warnings with the last batch
+    triagens::basics::Json extra(triagens::basics::Json::Object, 2);
+    extra.set("stats", engine->_stats.toJson());
+      
+    TRI_json_t* warnings = query->warningsToJson(TRI_UNKNOWN_MEM_ZONE);
+
+    if (warnings == nullptr) {
+      extra.set("warnings", triagens::basics::Json(triagens::basics::Json::Array));
+    }
+    else {
+      extra.set("warnings", triagens::basics::Json(TRI_UNKNOWN_MEM_ZONE, warnings, triagens::basics::Json::AUTOFREE));
+    }
+
+    buffer.appendText(",\"extra\":");
+    extra.dump(buffer);
+  }
+  catch (...) {
+    _hasMore = false;
+    destroyQuery(TRI_ERROR_INTERNAL);
+    this->deleted();
+    throw;
+  }
+
+  // this will commit the query's transaction
+  destroyQuery(TRI_ERROR_NO_ERROR);
+
+  // mark the cursor as deleted
+  this->deleted();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the query registry
+/// the registry is looked up via the server, because it is destroyed before
+/// the databases (and their cursors) on shutdown
+////////////////////////////////////////////////////////////////////////////////
+
+triagens::aql::QueryRegistry* StreamCursor::queryRegistry () const {
+  return static_cast<triagens::aql::QueryRegistry*>(_vocbase->_server->_queryRegistry);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove the query from the registry
+////////////////////////////////////////////////////////////////////////////////
+
+void StreamCursor::destroyQuery (int errorCode) {
+  if (_queryId == 0) {
+    return;
+  }
+
+  auto registry = queryRegistry();
+
+  if (registry != nullptr) {
+    try {
+      registry->destroy(_vocbase, _queryId, errorCode);
+    }
+    catch (...) {
+      // query may have been expired by the registry already
+    }
+  }
+
+  _queryId = 0;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
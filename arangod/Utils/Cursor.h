@@ -38,6 +38,10 @@ struct TRI_json_t;
 struct TRI_vocbase_s;
 
 namespace triagens {
+  namespace aql {
+    class QueryRegistry;
+  }
+
   namespace arango {
 
     class CollectionExport;
@@ -233,6 +237,64 @@ namespace triagens {
         size_t const                        _size;
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class StreamCursor
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a cursor that produces its results lazily from an AQL query
+/// the query (including its execution engine and transaction) is parked in
+/// the query registry between two batches. every call to dump() will pull
+/// at most batchSize rows from the query's execution engine. the query stays
+/// in the vocbase's list of running queries until it is destroyed
+////////////////////////////////////////////////////////////////////////////////
+    
+    class StreamCursor : public Cursor {
+      public:
+
+        StreamCursor (struct TRI_vocbase_s*,
+                      CursorId,
+                      uint64_t,
+                      size_t,
+                      double);
+
+        ~StreamCursor ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+      public:
+
+        bool hasNext () override final;
+
+        struct TRI_json_t* next () override final;
+        
+        size_t count () const override final;
+
+        void dump (triagens::basics::StringBuffer&) override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+      private:
+
+        triagens::aql::QueryRegistry* queryRegistry () const;
+
+        void destroyQuery (int);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+        struct TRI_vocbase_s*               _vocbase;
+        uint64_t                            _queryId;
+        bool                                _hasMore;
+    };
+
   }
 }
 
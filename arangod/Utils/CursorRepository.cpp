@@ -171,6 +171,31 @@ ExportCursor* CursorRepository::createFromExport (triagens::arango::CollectionEx
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a streaming cursor for a query and stores it in the registry
+////////////////////////////////////////////////////////////////////////////////
+
+StreamCursor* CursorRepository::createFromQuery (uint64_t queryId,
+                                                 size_t batchSize,
+                                                 double ttl) {
+  TRI_ASSERT(queryId != 0);
+
+  CursorId const id = TRI_NewTickServer();
+  triagens::arango::StreamCursor* cursor = new triagens::arango::StreamCursor(_vocbase, id, queryId, batchSize, ttl);
+
+  cursor->use();
+
+  try {
+    MUTEX_LOCKER(_lock);
+    _cursors.emplace(std::make_pair(id, cursor));
+    return cursor;
+  }
+  catch (...) {
+    delete cursor;
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief remove a cursor by id
 ////////////////////////////////////////////////////////////////////////////////
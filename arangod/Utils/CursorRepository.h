@@ -95,6 +95,16 @@ namespace triagens {
                                         double, 
                                         bool);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a streaming cursor for a query and stores it in the registry
+/// the query must have been prepared and put into the query registry with
+/// the specified id before. the cursor will take over responsibility for it
+////////////////////////////////////////////////////////////////////////////////
+
+        StreamCursor* createFromQuery (uint64_t,
+                                       size_t,
+                                       double);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief remove a cursor by id
 ////////////////////////////////////////////////////////////////////////////////
@@ -348,6 +348,33 @@ namespace triagens {
            return TRI_GetCollectionTransaction(_trx, cid, TRI_TRANSACTION_READ);
          }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add a collection for reading while the transaction is running
+///
+/// this is for collections that only become known during execution. the
+/// collection is used and locked at the nesting level of this transaction,
+/// so it is released together with the collections added before the start
+////////////////////////////////////////////////////////////////////////////////
+
+         int addCollectionAtRuntime (TRI_voc_cid_t cid) {
+           if (_trx == nullptr || getStatus() != TRI_TRANSACTION_RUNNING) {
+             return TRI_ERROR_TRANSACTION_INTERNAL;
+           }
+
+           if (cid == 0 ||
+               TRI_LookupCollectionByIdVocBase(_vocbase, cid) == nullptr) {
+             return TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND;
+           }
+
+           int res = TRI_AddCollectionTransaction(_trx, cid, TRI_TRANSACTION_READ, _nestingLevel, true);
+
+           if (res == TRI_ERROR_NO_ERROR) {
+             res = TRI_EnsureCollectionsTransaction(_trx, _nestingLevel);
+           }
+
+           return res;
+         }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief order a barrier for a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -409,22 +436,17 @@ namespace triagens {
             return TRI_ERROR_OUT_OF_MEMORY;
           }
 
-          void** beg = document->_primaryIndex._table;
-          void** end = beg + document->_primaryIndex._nrAlloc;
-
-          if (internalSkip > 0) {
-            beg += internalSkip;
-          }
-
-          void** ptr = beg;
+          TRI_primary_index_t const* primaryIndex = &document->_primaryIndex;
+          uint64_t const end = TRI_SlotsPrimaryIndex(primaryIndex);
+          uint64_t position = internalSkip;
           uint32_t count = 0;
-          *total = (uint32_t) document->_primaryIndex._nrUsed;
+          *total = (uint32_t) primaryIndex->_nrUsed;
 
           // fetch documents, taking limit into account
-          for (; ptr < end && count < batchSize; ++ptr, ++internalSkip) {
-            if (*ptr) {
-              TRI_doc_mptr_t* d = (TRI_doc_mptr_t*) *ptr;
+          for (; position < end && count < batchSize; ++position, ++internalSkip) {
+            TRI_doc_mptr_t* d = TRI_SlotPrimaryIndex(primaryIndex, position);
 
+            if (d != nullptr) {
               if (skip > 0) {
                 --skip;
               }
@@ -483,8 +505,9 @@ namespace triagens {
             return TRI_ERROR_OUT_OF_MEMORY;
           }
 
-          *total = (uint32_t) document->_primaryIndex._nrAlloc;
           if (*step == 0) {
+            *total = (uint32_t) TRI_SlotsPrimaryIndex(&document->_primaryIndex);
+
             TRI_ASSERT(initialPosition == 0);
 
             // find a co-prime for total
@@ -502,7 +525,9 @@ namespace triagens {
 
           TRI_voc_size_t numRead = 0;
           do {
-            TRI_doc_mptr_t* d = (TRI_doc_mptr_t*) document->_primaryIndex._table[position];
+            // the index may have been resized since the first call. positions
+            // outside of the index are empty
+            TRI_doc_mptr_t* d = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
             if (d != nullptr) {
               docs.emplace_back(*d);
               ++numRead;
@@ -840,15 +865,15 @@ namespace triagens {
               return TRI_ERROR_OUT_OF_MEMORY;
             }
 
-            uint32_t total = (uint32_t) document->_primaryIndex._nrAlloc;
-            uint32_t pos = TRI_UInt32Random() % total;
-            void** beg = document->_primaryIndex._table;
+            uint32_t total = (uint32_t) TRI_SlotsPrimaryIndex(&document->_primaryIndex);
+            TRI_doc_mptr_t* d;
 
-            while (beg[pos] == nullptr) {
-              pos = TRI_UInt32Random() % total;
+            do {
+              d = TRI_SlotPrimaryIndex(&document->_primaryIndex, TRI_UInt32Random() % total);
             }
+            while (d == nullptr);
 
-            *mptr = *((TRI_doc_mptr_t*) beg[pos]);
+            *mptr = *d;
           }
 
           this->unlock(trxCollection, TRI_TRANSACTION_READ);
@@ -883,12 +908,12 @@ namespace triagens {
 
             ids.reserve((size_t) document->_primaryIndex._nrUsed);
 
-            void** ptr = document->_primaryIndex._table;
-            void** end = ptr + document->_primaryIndex._nrAlloc;
+            uint64_t const end = TRI_SlotsPrimaryIndex(&document->_primaryIndex);
 
-            for (;  ptr < end;  ++ptr) {
-              if (*ptr) {
-                TRI_doc_mptr_t const* d = (TRI_doc_mptr_t const*) *ptr;
+            for (uint64_t position = 0;  position < end;  ++position) {
+              TRI_doc_mptr_t const* d = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
+
+              if (d != nullptr) {
                 ids.push_back(TRI_EXTRACT_MARKER_KEY(d));  // PROTECTED by trx in trxCollection
               }
             }
@@ -1001,28 +1026,30 @@ namespace triagens {
             return TRI_ERROR_OUT_OF_MEMORY;
           }
 
-          void** beg = document->_primaryIndex._table;
-          void** ptr = beg;
-          void** end = ptr + document->_primaryIndex._nrAlloc;
+          TRI_primary_index_t const* primaryIndex = &document->_primaryIndex;
+          uint64_t const end = TRI_SlotsPrimaryIndex(primaryIndex);
+          uint64_t position = 0;
           uint32_t count = 0;
 
-          *total = (uint32_t) document->_primaryIndex._nrUsed;
+          *total = (uint32_t) primaryIndex->_nrUsed;
 
           // apply skip
           if (skip > 0) {
             // skip from the beginning
-            for (;  ptr < end && 0 < skip;  ++ptr) {
-              if (*ptr) {
+            for (;  position < end && 0 < skip;  ++position) {
+              if (TRI_SlotPrimaryIndex(primaryIndex, position) != nullptr) {
                 --skip;
               }
             }
           }
           else if (skip < 0) {
             // skip from the end
-            ptr = end - 1;
+            position = end;
+
+            while (position > 0) {
+              --position;
 
-            for (; beg <= ptr; --ptr) {
-              if (*ptr) {
+              if (TRI_SlotPrimaryIndex(primaryIndex, position) != nullptr) {
                 ++skip;
 
                 if (skip == 0) {
@@ -1030,17 +1057,13 @@ namespace triagens {
                 }
               }
             }
-
-            if (ptr < beg) {
-              ptr = beg;
-            }
           }
 
           // fetch documents, taking limit into account
-          for (; ptr < end && count < limit; ++ptr) {
-            if (*ptr) {
-              TRI_doc_mptr_t* d = (TRI_doc_mptr_t*) *ptr;
+          for (; position < end && count < limit; ++position) {
+            TRI_doc_mptr_t* d = TRI_SlotPrimaryIndex(primaryIndex, position);
 
+            if (d != nullptr) {
               docs.emplace_back(*d);
               ++count;
             }
@@ -1079,13 +1102,13 @@ namespace triagens {
             return TRI_ERROR_OUT_OF_MEMORY;
           }
 
-          void** ptr = document->_primaryIndex._table;
-          void** end = ptr + document->_primaryIndex._nrAlloc;
+          uint64_t const end = TRI_SlotsPrimaryIndex(&document->_primaryIndex);
 
           // fetch documents, taking limit into account
-          for (; ptr < end; ++ptr) {
-            if (*ptr) {
-              TRI_doc_mptr_t* d = (TRI_doc_mptr_t*) *ptr;
+          for (uint64_t position = 0; position < end; ++position) {
+            TRI_doc_mptr_t* d = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
+
+            if (d != nullptr) {
               docs.push_back(d);
             }
           }
@@ -1123,28 +1146,20 @@ namespace triagens {
             
             docs.reserve(static_cast<size_t>(document->_primaryIndex._nrUsed) % static_cast<size_t>(numberOfPartitions));
           
-            void** ptr = document->_primaryIndex._table;
-            void** end = ptr + document->_primaryIndex._nrAlloc;
+            uint64_t const end = TRI_SlotsPrimaryIndex(&document->_primaryIndex);
             *total = (uint32_t) document->_primaryIndex._nrUsed;
 
             // fetch documents, taking partition into account
-            for (; ptr < end; ++ptr) {
-              if (*ptr) {
-                TRI_doc_mptr_t const* d = (TRI_doc_mptr_t const*) *ptr;
+            for (uint64_t position = 0; position < end; ++position) {
+              TRI_doc_mptr_t const* d = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
 
+              if (d != nullptr) {
                 if (d->_hash % numberOfPartitions == partitionId) {
                   // correct partition
                   docs.emplace_back(*d);
                 }
               }
             }
-
-            for (;  ptr < end;  ++ptr) {
-              if (*ptr) {
-                TRI_doc_mptr_t const* d = (TRI_doc_mptr_t const*) *ptr;
-                docs.push_back(*d);  // PROTECTED by trx in trxCollection
-              }
-            }
           }
 
           this->unlock(trxCollection, TRI_TRANSACTION_READ);
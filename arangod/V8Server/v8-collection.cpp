@@ -1746,6 +1746,8 @@ static TRI_doc_collection_info_t* GetFigures (TRI_vocbase_col_t* collection) {
 /// * *indexes.count*: The total number of indexes defined for the
 ///   collection, including the pre-defined indexes (e.g. primary index).
 /// * *indexes.size*: The total memory allocated for indexes in bytes.
+/// * *indexes.fillPending*: The number of documents that still need to be
+///   inserted into indexes of the collection that are currently being built.
 /// * *maxTick*: The tick of the last marker that was stored in a journal
 ///   of the collection. This might be 0 if the collection does not yet have
 ///   a journal.
@@ -1864,6 +1866,7 @@ static void JS_FiguresVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& arg
   result->Set(TRI_V8_ASCII_STRING("indexes"),    indexes);
   indexes->Set(TRI_V8_ASCII_STRING("count"),     v8::Number::New(isolate, (double) info->_numberIndexes));
   indexes->Set(TRI_V8_ASCII_STRING("size"),      v8::Number::New(isolate, (double) info->_sizeIndexes));
+  indexes->Set(TRI_V8_ASCII_STRING("fillPending"), v8::Number::New(isolate, (double) info->_numberIndexFillPending));
 
   result->Set(TRI_V8_ASCII_STRING("lastTick"),   V8TickId(isolate, info->_tickMax));
   result->Set(TRI_V8_ASCII_STRING("uncollectedLogfileEntries"), v8::Number::New(isolate, (double) info->_uncollectedLogfileEntries));
@@ -1999,6 +2002,9 @@ static void JS_PlanIdVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& args
 ///   kept in memory only and ArangoDB will not write or sync the data
 ///   to disk.
 ///
+/// * *compressStrings*: If *true* then long string values are stored
+///   deflated.
+///
 /// * *keyOptions* (optional) additional options for key generation. This is
 ///   a JSON array containing the following attributes (note: some of the
 ///   attributes are optional):
@@ -2036,7 +2042,8 @@ static void JS_PlanIdVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& args
 /// then size of the largest document already stored in the collection.
 ///
 /// **Note**: some other collection properties, such as *type*, *isVolatile*,
-/// or *keyOptions* cannot be changed once the collection is created.
+/// *compressStrings* or *keyOptions* cannot be changed once the collection is
+/// created.
 ///
 /// @EXAMPLES
 ///
@@ -2115,6 +2122,16 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
           }
         }
 
+        TRI_GET_GLOBAL_STRING(CompressStringsKey);
+        if (po->Has(CompressStringsKey)) {
+          if (TRI_ObjectToBoolean(po->Get(CompressStringsKey)) != info._compressStrings) {
+            if (info._keyOptions != nullptr) {
+              TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, info._keyOptions);
+            }
+            TRI_V8_THROW_EXCEPTION_PARAMETER("compressStrings option cannot be changed at runtime");
+          }
+        }
+
         if (info._isVolatile && info._waitForSync) {
           if (info._keyOptions != nullptr) {
             TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, info._keyOptions);
@@ -2137,11 +2154,13 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
     // return the current parameter set
     v8::Handle<v8::Object> result = v8::Object::New(isolate);
 
+    TRI_GET_GLOBAL_STRING(CompressStringsKey);
     TRI_GET_GLOBAL_STRING(DoCompactKey);
     TRI_GET_GLOBAL_STRING(IsSystemKey);
     TRI_GET_GLOBAL_STRING(IsVolatileKey);
     TRI_GET_GLOBAL_STRING(JournalSizeKey);
     TRI_GET_GLOBAL_STRING(WaitForSyncKey);
+    result->Set(CompressStringsKey, v8::Boolean::New(isolate, info._compressStrings));
     result->Set(DoCompactKey,   v8::Boolean::New(isolate, info._doCompact));
     result->Set(IsSystemKey,    v8::Boolean::New(isolate, info._isSystem));
     result->Set(IsVolatileKey,  v8::Boolean::New(isolate, info._isVolatile));
@@ -2222,6 +2241,14 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
         }
       }
 
+      TRI_GET_GLOBAL_STRING(CompressStringsKey);
+      if (po->Has(CompressStringsKey)) {
+        if (TRI_ObjectToBoolean(po->Get(CompressStringsKey)) != base->_info._compressStrings) {
+          ReleaseCollection(collection);
+          TRI_V8_THROW_EXCEPTION_PARAMETER("compressStrings option cannot be changed at runtime");
+        }
+      }
+
       if (base->_info._isVolatile && waitForSync) {
         // the combination of waitForSync and isVolatile makes no sense
         ReleaseCollection(collection);
@@ -2276,10 +2303,12 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
   // return the current parameter set
   v8::Handle<v8::Object> result = v8::Object::New(isolate);
 
+  TRI_GET_GLOBAL_STRING(CompressStringsKey);
   TRI_GET_GLOBAL_STRING(DoCompactKey);
   TRI_GET_GLOBAL_STRING(IsSystemKey);
   TRI_GET_GLOBAL_STRING(IsVolatileKey);
   TRI_GET_GLOBAL_STRING(JournalSizeKey);
+  result->Set(CompressStringsKey, v8::Boolean::New(isolate, base->_info._compressStrings));
   result->Set(DoCompactKey,   v8::Boolean::New(isolate, base->_info._doCompact));
   result->Set(IsSystemKey,    v8::Boolean::New(isolate, base->_info._isSystem));
   result->Set(IsVolatileKey,  v8::Boolean::New(isolate, base->_info._isVolatile));
@@ -3480,12 +3509,13 @@ static void JS_CheckPointersVocbaseCol (const v8::FunctionCallbackInfo<v8::Value
   TRI_document_collection_t* document = trx.documentCollection();
 
   // iterate over the primary index and de-reference all the pointers to data
-  void** ptr = document->_primaryIndex._table;
-  void** end = ptr + document->_primaryIndex._nrAlloc;
+  uint64_t const end = TRI_SlotsPrimaryIndex(&document->_primaryIndex);
+
+  for (uint64_t position = 0;  position < end;  ++position) {
+    TRI_doc_mptr_t const* mptr = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
 
-  for (;  ptr < end;  ++ptr) {
-    if (*ptr) {
-      char const* key = TRI_EXTRACT_MARKER_KEY((TRI_doc_mptr_t const*) *ptr);
+    if (mptr != nullptr) {
+      char const* key = TRI_EXTRACT_MARKER_KEY(mptr);
 
       TRI_ASSERT(key != nullptr);
       // dereference the key
@@ -1244,7 +1244,8 @@ static void JS_Nth3Query (const v8::FunctionCallbackInfo<v8::Value>& args) {
     TRI_V8_THROW_EXCEPTION_PARAMETER("invalid value for <numberOfPartitions>");
   }
   
-  uint64_t hash = TRI_FnvHashPointer(static_cast<void const*>(key.c_str()), key.size());
+  // must use the same hash as the primary index, see NTH2
+  uint64_t hash = TRI_HashKeyPrimaryIndex(key.c_str(), key.size());
 
   TRI_V8_RETURN(v8::Number::New(isolate, static_cast<int>(hash % numberOfPartitions)));
 }
@@ -553,6 +553,48 @@ static void JS_FlushWal (const v8::FunctionCallbackInfo<v8::Value>& args) {
   TRI_V8_RETURN_TRUE();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the state of the write-ahead log garbage collector
+/// @startDocuBlock walStatistics
+/// `internal.wal.statistics()`
+///
+/// Returns how far the write-ahead log garbage collector is behind. The
+/// result is a JSON object with the following attributes:
+/// - *pendingLogfiles*: the number of full logfiles that are not yet
+///   collected
+/// - *pendingOperations*: the number of operations that were transferred
+///   into collection datafiles, but are still waiting to be applied to the
+///   collections
+/// - *collectorThreads*: the number of garbage collector threads
+/// - *writeThrottled*: whether or not write-throttling is currently active
+///
+/// @EXAMPLES
+///
+/// @EXAMPLE_ARANGOSH_OUTPUT{WalStatistics}
+///   require("internal").wal.statistics();
+/// @END_EXAMPLE_ARANGOSH_OUTPUT
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+static void JS_StatisticsWal (const v8::FunctionCallbackInfo<v8::Value>& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  if (args.Length() != 0) {
+    TRI_V8_THROW_EXCEPTION_USAGE("statistics()");
+  }
+
+  auto l = triagens::wal::LogfileManager::instance();
+
+  v8::Handle<v8::Object> result = v8::Object::New(isolate);
+  result->Set(TRI_V8_ASCII_STRING("pendingLogfiles"),   v8::Number::New(isolate, (double) l->numPendingLogfiles()));
+  result->Set(TRI_V8_ASCII_STRING("pendingOperations"), v8::Number::New(isolate, (double) l->numPendingCollectorOperations()));
+  result->Set(TRI_V8_ASCII_STRING("collectorThreads"),  v8::Number::New(isolate, (double) l->collectorThreads()));
+  result->Set(TRI_V8_ASCII_STRING("writeThrottled"),    v8::Boolean::New(isolate, l->isThrottled()));
+
+  TRI_V8_RETURN(result);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief normalize UTF 16 strings
 ////////////////////////////////////////////////////////////////////////////////
@@ -1429,6 +1471,43 @@ static void JS_QueriesSlowAql (const v8::FunctionCallbackInfo<v8::Value>& args)
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the plan cache statistics, or clears the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+static void JS_QueriesPlanCacheAql (const v8::FunctionCallbackInfo<v8::Value>& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  TRI_vocbase_t* vocbase = GetContextVocBase(isolate);
+
+  if (vocbase == nullptr) {
+    TRI_V8_THROW_EXCEPTION(TRI_ERROR_ARANGO_DATABASE_NOT_FOUND);
+  }
+  
+  auto queryList = static_cast<triagens::aql::QueryList*>(vocbase->_queries);
+  TRI_ASSERT(queryList != nullptr);
+
+  auto planCache = queryList->planCache();
+  
+  if (args.Length() == 1) {
+    planCache->invalidate();
+    TRI_V8_RETURN_TRUE();
+  }
+  
+  if (args.Length() != 0) {
+    TRI_V8_THROW_EXCEPTION_USAGE("AQL_QUERIES_PLAN_CACHE()");
+  }
+
+  auto result = v8::Object::New(isolate);
+  result->Set(TRI_V8_ASCII_STRING("hits"), v8::Number::New(isolate, static_cast<double>(planCache->hits())));
+  result->Set(TRI_V8_ASCII_STRING("misses"), v8::Number::New(isolate, static_cast<double>(planCache->misses())));
+  result->Set(TRI_V8_ASCII_STRING("invalidations"), v8::Number::New(isolate, static_cast<double>(planCache->invalidations())));
+  result->Set(TRI_V8_ASCII_STRING("plans"), v8::Number::New(isolate, static_cast<double>(planCache->size())));
+
+  TRI_V8_RETURN(result);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief kills an AQL query
 ////////////////////////////////////////////////////////////////////////////////
@@ -2792,6 +2871,7 @@ void TRI_InitV8VocBridge (v8::Isolate* isolate,
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("AQL_QUERIES_CURRENT"), JS_QueriesCurrentAql, true);
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("AQL_QUERIES_SLOW"), JS_QueriesSlowAql, true);
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("AQL_QUERIES_KILL"), JS_QueriesKillAql, true);
+  TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("AQL_QUERIES_PLAN_CACHE"), JS_QueriesPlanCacheAql, true);
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("AQL_QUERY_SLEEP"), JS_QuerySleepAql, true);
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("AQL_QUERY_IS_KILLED"), JS_QueryIsKilledAql, true);
 
@@ -2811,6 +2891,7 @@ void TRI_InitV8VocBridge (v8::Isolate* isolate,
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("TRANSACTION"), JS_Transaction, true);
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("WAL_FLUSH"), JS_FlushWal, true);
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("WAL_PROPERTIES"), JS_PropertiesWal, true);
+  TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("WAL_STATISTICS"), JS_StatisticsWal, true);
   
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("ENABLE_NATIVE_BACKTRACES"), JS_EnableNativeBacktraces, true);
 
@@ -1071,6 +1071,7 @@ static void CreateCollectionCoordinator (const v8::FunctionCallbackInfo<v8::Valu
   TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "name",        TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, name.c_str(), name.size()));
   TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "type",        TRI_CreateNumberJson(TRI_UNKNOWN_MEM_ZONE, (int) collectionType));
   TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "status",      TRI_CreateNumberJson(TRI_UNKNOWN_MEM_ZONE, (int) TRI_VOC_COL_STATUS_LOADED));
+  TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "compressStrings", TRI_CreateBooleanJson(TRI_UNKNOWN_MEM_ZONE, parameters._compressStrings));
   TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "deleted",     TRI_CreateBooleanJson(TRI_UNKNOWN_MEM_ZONE, parameters._deleted));
   TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "doCompact",   TRI_CreateBooleanJson(TRI_UNKNOWN_MEM_ZONE, parameters._doCompact));
   TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "isSystem",    TRI_CreateBooleanJson(TRI_UNKNOWN_MEM_ZONE, parameters._isSystem));
@@ -1682,6 +1683,11 @@ static void CreateVocBase (const v8::FunctionCallbackInfo<v8::Value>& args,
       parameters._isSystem = TRI_ObjectToBoolean(p->Get(IsSystemKey));
     }
 
+    TRI_GET_GLOBAL_STRING(CompressStringsKey);
+    if (p->Has(CompressStringsKey)) {
+      parameters._compressStrings = TRI_ObjectToBoolean(p->Get(CompressStringsKey));
+    }
+
     TRI_GET_GLOBAL_STRING(IsVolatileKey);
     if (p->Has(IsVolatileKey)) {
 #ifdef TRI_HAVE_ANONYMOUS_MMAP
@@ -1774,6 +1780,13 @@ static void CreateVocBase (const v8::FunctionCallbackInfo<v8::Value>& args,
 ///   enforce any synchronization to disk and does not calculate any CRC
 ///   checksums for datafiles (as there are no datafiles).
 ///
+/// * *compressStrings* (optional, default is *false*): If *true*, string
+///   values of at least 256 bytes are stored deflated in the write-ahead log
+///   and in the datafiles, and are uncompressed whenever they are read. This
+///   saves disk space and memory for documents with long texts, at the
+///   expense of CPU time. The option cannot be changed after the collection
+///   was created.
+///
 /// * *keyOptions* (optional): additional options for key generation. If
 ///   specified, then *keyOptions* should be a JSON array containing the
 ///   following attributes (**note**: some of them are optional):
@@ -422,13 +422,13 @@ bool TRI_LoadAuthInfo (TRI_vocbase_t* vocbase) {
   TRI_WriteLockReadWriteLock(&vocbase->_authInfoLock);
   ClearAuthInfo(vocbase);
 
-  void** beg = document->_primaryIndex._table;
-  void** end = beg + document->_primaryIndex._nrAlloc;
-  void** ptr = beg;
+  uint64_t const end = TRI_SlotsPrimaryIndex(&document->_primaryIndex);
 
-  for (;  ptr < end;  ++ptr) {
-    if (*ptr) {
-      TRI_vocbase_auth_t* auth = ConvertAuthInfo(vocbase, document, (TRI_doc_mptr_t const*) *ptr);
+  for (uint64_t position = 0;  position < end;  ++position) {
+    TRI_doc_mptr_t const* mptr = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
+
+    if (mptr != nullptr) {
+      TRI_vocbase_auth_t* auth = ConvertAuthInfo(vocbase, document, mptr);
 
       if (auth != nullptr) {
         TRI_vocbase_auth_t* old = static_cast<TRI_vocbase_auth_t*>(TRI_InsertKeyAssociativePointer(&vocbase->_authInfo, auth->_username, auth, true));
@@ -851,7 +851,10 @@ static void FillParametersFromJson (TRI_col_info_t* parameters,
       }
     }
     else if (value->_type == TRI_JSON_BOOLEAN) {
-      if (TRI_EqualString(key->_value._string.data, "deleted")) {
+      if (TRI_EqualString(key->_value._string.data, "compressStrings")) {
+        parameters->_compressStrings = value->_value._boolean;
+      }
+      else if (TRI_EqualString(key->_value._string.data, "deleted")) {
         parameters->_deleted = value->_value._boolean;
       }
       else if (TRI_EqualString(key->_value._string.data, "doCompact")) {
@@ -912,6 +915,7 @@ void TRI_InitCollectionInfo (TRI_vocbase_t* vocbase,
     parameters->_keyOptions  = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, keyOptions);
   }
 
+  parameters->_compressStrings = false;
   parameters->_deleted       = false;
   parameters->_doCompact     = true;
   parameters->_isVolatile    = false;
@@ -954,6 +958,7 @@ void TRI_CopyCollectionInfo (TRI_col_info_t* dst,
     dst->_keyOptions  = nullptr;
   }
 
+  dst->_compressStrings = src->_compressStrings;
   dst->_deleted       = src->_deleted;
   dst->_doCompact     = src->_doCompact;
   dst->_isSystem      = src->_isSystem;
@@ -1330,6 +1335,7 @@ TRI_json_t* TRI_CreateJsonCollectionInfo (TRI_col_info_t const* info) {
     TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "count",  TRI_CreateNumberJson(TRI_CORE_MEM_ZONE, (double) info->_initialCount));
   }
 
+  TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "compressStrings", TRI_CreateBooleanJson(TRI_CORE_MEM_ZONE, info->_compressStrings));
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "deleted",      TRI_CreateBooleanJson(TRI_CORE_MEM_ZONE, info->_deleted));
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "doCompact",    TRI_CreateBooleanJson(TRI_CORE_MEM_ZONE, info->_doCompact));
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "maximalSize",  TRI_CreateNumberJson(TRI_CORE_MEM_ZONE, (double) info->_maximalSize));
@@ -1470,6 +1476,7 @@ int TRI_UpdateCollectionInfo (TRI_vocbase_t* vocbase,
     // - _type
     // - _isSystem
     // - _isVolatile
+    // - _compressStrings
     // ... probably a few others missing here ...
   }
 
@@ -1787,7 +1794,8 @@ int TRI_UpgradeCollection20 (TRI_vocbase_t* vocbase,
 
         // datafile header
         TRI_InitMarkerDatafile((char*) &header, TRI_DF_MARKER_HEADER, sizeof(TRI_df_header_marker_t));
-        header._version     = TRI_DF_VERSION;
+        // the shape markers are copied with their original CRC32 checksums
+        header._version     = TRI_DF_VERSION_1;
         header._maximalSize = 0; // TODO: seems ok to set this to 0, check if this is ok
         header._fid         = tick;
         header.base._tick   = tick;
@@ -180,6 +180,7 @@ typedef struct TRI_col_info_s {
   struct TRI_json_t* _keyOptions;      // options for key creation
 
   // flags
+  bool               _compressStrings; // if true, long strings are stored deflated
   bool               _deleted;         // if true, collection has been deleted
   bool               _doCompact;       // if true, collection will be compacted
   bool               _isSystem;        // if true, this is a system collection
@@ -138,14 +138,9 @@ static int TruncateDatafile (TRI_datafile_t* const datafile, const off_t length)
 /// @brief checks a CRC of a marker
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool CheckCrcMarker (TRI_df_marker_t const* marker,
+static bool CheckCrcMarker (TRI_df_version_t version,
+                            TRI_df_marker_t const* marker,
                             char const* end) {
-  TRI_voc_size_t zero = 0;
-  off_t o = offsetof(TRI_df_marker_t, _crc);
-  size_t n = sizeof(TRI_voc_crc_t);
-
-  char const* ptr = (char const*) marker;
-
   if (marker->_size < sizeof(TRI_df_marker_t)) {
     return false;
   }
@@ -154,15 +149,7 @@ static bool CheckCrcMarker (TRI_df_marker_t const* marker,
     return false;
   }
 
-  TRI_voc_crc_t crc = TRI_InitialCrc32();
-
-  crc = TRI_BlockCrc32(crc, ptr, o);
-  crc = TRI_BlockCrc32(crc, (char*) &zero, n);
-  crc = TRI_BlockCrc32(crc, ptr + o + n, marker->_size - o - n);
-
-  crc = TRI_FinalCrc32(crc);
-
-  return marker->_crc == crc;
+  return marker->_crc == TRI_ChecksumMarkerDatafile(version, marker);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -248,6 +235,7 @@ static void InitDatafile (TRI_datafile_t* datafile,
 
   datafile->_state       = TRI_DF_STATE_READ;
   datafile->_fid         = fid;
+  datafile->_version     = TRI_DF_VERSION;
 
   datafile->_filename    = filename;
   datafile->_fd          = fd;
@@ -523,7 +511,7 @@ static TRI_df_scan_t ScanDatafile (TRI_datafile_t const* datafile) {
       return scan;
     }
 
-    ok = CheckCrcMarker(marker, end);
+    ok = CheckCrcMarker(datafile->_version, marker, end);
 
     if (! ok) {
       entry._status = 5;
@@ -665,7 +653,7 @@ static bool CheckDatafile (TRI_datafile_t* datafile,
     }
 
     if (marker->_type != 0) {
-      bool ok = CheckCrcMarker(marker, end);
+      bool ok = CheckCrcMarker(datafile->_version, marker, end);
 
       if (! ok) {
         if (marker->_size > 0) {
@@ -863,8 +851,8 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
   
   char const* end = static_cast<char const*>(ptr) + len;
 
-  // check CRC
-  ok = CheckCrcMarker(&header.base, end);
+  // check CRC. the checksum function depends on the version stored in the header
+  ok = CheckCrcMarker(header._version, &header.base, end);
 
   if (! ok) {
     TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
@@ -879,7 +867,8 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
 
   // check the datafile version
   if (ok) {
-    if (header._version != TRI_DF_VERSION) {
+    if (header._version != TRI_DF_VERSION_1 &&
+        header._version != TRI_DF_VERSION_2) {
       TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
 
       LOG_ERROR("unknown datafile version '%u' in datafile '%s'",
@@ -931,6 +920,9 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
                fid,
                static_cast<char*>(data));
 
+  // existing datafiles keep the checksum function they were created with
+  datafile->_version = header._version;
+
   return datafile;
 }
 
@@ -1522,6 +1514,34 @@ void TRI_UpdateTicksDatafile (TRI_datafile_t* datafile,
   */
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief calculates the checksum of a marker
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_voc_crc_t TRI_ChecksumMarkerDatafile (TRI_df_version_t version,
+                                          TRI_df_marker_t const* marker) {
+  TRI_voc_crc_t zero = 0;
+  off_t o = offsetof(TRI_df_marker_t, _crc);
+  size_t n = sizeof(TRI_voc_crc_t);
+
+  char const* ptr = (char const*) marker;
+
+  TRI_voc_crc_t crc = TRI_InitialCrc32();
+
+  if (version == TRI_DF_VERSION_1) {
+    crc = TRI_BlockCrc32(crc, ptr, o);
+    crc = TRI_BlockCrc32(crc, (char*) &zero, n);
+    crc = TRI_BlockCrc32(crc, ptr + o + n, marker->_size - o - n);
+  }
+  else {
+    crc = TRI_BlockCrc32C(crc, ptr, o);
+    crc = TRI_BlockCrc32C(crc, (char*) &zero, n);
+    crc = TRI_BlockCrc32C(crc, ptr + o + n, marker->_size - o - n);
+  }
+
+  return TRI_FinalCrc32(crc);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checksums and writes a marker to the datafile
 ////////////////////////////////////////////////////////////////////////////////
@@ -1533,10 +1553,7 @@ int TRI_WriteCrcElementDatafile (TRI_datafile_t* datafile,
   TRI_ASSERT(marker->_tick != 0);
 
   if (datafile->isPhysical(datafile)) {
-    TRI_voc_crc_t crc = TRI_InitialCrc32();
-
-    crc = TRI_BlockCrc32(crc, (char const*) marker, marker->_size);
-    marker->_crc = TRI_FinalCrc32(crc);
+    marker->_crc = TRI_ChecksumMarkerDatafile(datafile->_version, marker);
   }
 
   return TRI_WriteElementDatafile(datafile, position, marker, forceSync);
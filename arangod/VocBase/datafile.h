@@ -96,10 +96,27 @@
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief datafile version
+/// @brief datafile version 1
+///
+/// marker checksums in version 1 datafiles are CRC32 values
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_VERSION_1        (1)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief datafile version 2
+///
+/// marker checksums in version 2 datafiles are CRC32C (Castagnoli) values,
+/// which can be computed with the SSE 4.2 crc32 instruction
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_VERSION_2        (2)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief datafile version used for new datafiles
 ////////////////////////////////////////////////////////////////////////////////
 
-#define TRI_DF_VERSION          (1)
+#define TRI_DF_VERSION          TRI_DF_VERSION_2
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief alignment in datafile blocks
@@ -252,6 +269,7 @@ TRI_df_scan_entry_t;
 
 typedef struct TRI_datafile_s {
   TRI_voc_fid_t _fid;            // datafile identifier
+  TRI_df_version_t _version;     // datafile version, determines the checksum
 
   TRI_df_state_e _state;         // state of the datafile (READ or WRITE)
   int _fd;                       // underlying file descriptor
@@ -678,6 +696,16 @@ int TRI_WriteElementDatafile (TRI_datafile_t* datafile,
                               TRI_df_marker_t const* marker,
                               bool sync) TRI_WARN_UNUSED_RESULT;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief calculates the checksum of a marker
+///
+/// the marker's _crc value is treated as zero. the checksum function depends
+/// on the version of the datafile the marker is or will be stored in
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_voc_crc_t TRI_ChecksumMarkerDatafile (TRI_df_version_t,
+                                          TRI_df_marker_t const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checksums and writes a marker to the datafile
 ////////////////////////////////////////////////////////////////////////////////
@@ -112,7 +112,8 @@ void TRI_doc_mptr_copy_t::setDataPtr (void const* d) {
 TRI_document_collection_t::TRI_document_collection_t () 
   : _useSecondaryIndexes(true),
     _keyGenerator(nullptr),
-    _uncollectedLogfileEntries(0) {
+    _uncollectedLogfileEntries(0),
+    _indexFillPending(0) {
 
   _tickMax = 0;
 }
@@ -149,7 +150,8 @@ int TRI_AddOperationTransaction (triagens::wal::DocumentOperation&, bool&);
 // -----------------------------------------------------------------------------
 
 static int FillIndex (TRI_document_collection_t*,
-                      TRI_index_t*);
+                      TRI_index_t*,
+                      bool = true);
 
 static int CapConstraintFromJson (TRI_document_collection_t*,
                                   TRI_json_t const*,
@@ -491,6 +493,9 @@ static int AddIndex (TRI_document_collection_t* document,
     SetIndexCleanupFlag(document, true);
   }
 
+  // cached plans do not use the new index yet
+  TRI_InvalidatePlanCacheVocBase(document->_vocbase);
+
   return TRI_ERROR_NO_ERROR;
 }
 
@@ -1924,6 +1929,8 @@ static TRI_doc_collection_info_t* Figures (TRI_document_collection_t* document)
   info->_shapefileSize    = 0;
   info->_numberShapefiles = 0;
 
+  info->_numberIndexFillPending = document->_indexFillPending;
+
   info->_uncollectedLogfileEntries = document->_uncollectedLogfileEntries;
   info->_tickMax = document->_tickMax;
 
@@ -2559,13 +2566,12 @@ size_t TRI_DocumentIteratorDocumentCollection (TransactionBase const*,
   size_t const nrUsed = (size_t) document->_primaryIndex._nrUsed;
 
   if (nrUsed > 0) {
-    void** ptr = document->_primaryIndex._table;
-    void** end = ptr + document->_primaryIndex._nrAlloc;
+    uint64_t const end = TRI_SlotsPrimaryIndex(&document->_primaryIndex);
 
-    for (;  ptr < end;  ++ptr) {
-      if (*ptr) {
-        TRI_doc_mptr_t const* d = (TRI_doc_mptr_t const*) *ptr;
+    for (uint64_t position = 0;  position < end;  ++position) {
+      TRI_doc_mptr_t const* d = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
 
+      if (d != nullptr) {
         if (! callback(d, document, data)) {
           break;
         }
@@ -2815,7 +2821,9 @@ class IndexFiller {
       int res = TRI_ERROR_INTERNAL;
 
       try {
-        res = FillIndex(_document, _idx);
+        // we are running in an index thread ourselves, so we must not
+        // distribute the work for this index any further
+        res = FillIndex(_document, _idx, false);
       }
       catch (...) {
       }
@@ -3098,54 +3106,111 @@ static TRI_json_t* ExtractFields (TRI_json_t const* json,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief initialises an index with all existing documents
+///
+/// if the index supports batch inserts, all documents are handed to the index
+/// at once, and the index may use the index threads to process them in
+/// partitions. this is only allowed if the caller is not an index thread
+/// itself. otherwise the documents are inserted one by one
 ////////////////////////////////////////////////////////////////////////////////
 
 static int FillIndex (TRI_document_collection_t* document,
-                      TRI_index_t* idx) {
+                      TRI_index_t* idx,
+                      bool allowDistribution) {
 
   if (! document->useSecondaryIndexes()) {
     return TRI_ERROR_NO_ERROR;
   }
 
-  void** ptr = document->_primaryIndex._table;
-  void** end = ptr + document->_primaryIndex._nrAlloc;
+  uint64_t const end = TRI_SlotsPrimaryIndex(&document->_primaryIndex);
 
+  int64_t const total = static_cast<int64_t>(document->_primaryIndex._nrUsed);
+  
   if (idx->sizeHint != nullptr) {
     // give the index a size hint
-    idx->sizeHint(idx, (size_t) document->_primaryIndex._nrUsed);
+    idx->sizeHint(idx, (size_t) total);
   }
+  
+  // the number of documents still to be indexed is reported in the figures
+  document->_indexFillPending += total;
+  std::atomic<int64_t> done(0);
 
-#ifdef TRI_ENABLE_MAINTAINER_MODE
-  static const int LoopSize = 10000;
-  int counter = 0;
-  int loops = 0;
-#endif
+  // may be called concurrently by the index threads
+  auto reportProgress = [&document, &done] (size_t count) -> void {
+    done += static_cast<int64_t>(count);
+    document->_indexFillPending -= static_cast<int64_t>(count);
+  };
 
-  for (;  ptr < end;  ++ptr) {
-    TRI_doc_mptr_t const* mptr = static_cast<TRI_doc_mptr_t const*>(*ptr);
+  auto finishProgress = [&document, &total, &done] () -> void {
+    TRI_IF_FAILURE("FillIndex::keepPending") {
+      // leave the documents not yet reported as pending
+      return;
+    }
 
-    if (mptr != nullptr) {
-      int res = idx->insert(idx, mptr, false);
+    document->_indexFillPending -= (total - done.load());
+  };
 
-      if (res != TRI_ERROR_NO_ERROR) {
-        return res;
+  int res = TRI_ERROR_NO_ERROR;
+  
+  try {
+    if (idx->batchInsert != nullptr && total > 0) {
+      std::vector<TRI_doc_mptr_t const*> documents;
+      documents.reserve(static_cast<size_t>(total));
+
+      for (uint64_t position = 0;  position < end;  ++position) {
+        TRI_doc_mptr_t const* mptr = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
+
+        if (mptr != nullptr) {
+          documents.emplace_back(mptr);
+        }
       }
 
-#ifdef TRI_ENABLE_MAINTAINER_MODE
-      if (++counter == LoopSize) {
-        counter = 0;
-        ++loops;
+      size_t numThreads = 1;
+
+      if (allowDistribution) {
+        auto indexPool = static_cast<triagens::basics::ThreadPool*>(document->_vocbase->_server->_indexPool);
 
-        LOG_TRACE("indexed %llu documents of collection %llu",
-                  (unsigned long long) (LoopSize * loops),
-                  (unsigned long long) document->_info._cid);
+        if (indexPool != nullptr) {
+          // the calling thread will do some of the work, too
+          numThreads += indexPool->numThreads();
+        }
       }
-#endif
 
+      res = idx->batchInsert(idx, &documents, numThreads, reportProgress);
+    }
+    else {
+      static const int64_t LoopSize = 10000;
+      int64_t counter = 0;
+
+      for (uint64_t position = 0;  position < end;  ++position) {
+        TRI_doc_mptr_t const* mptr = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
+
+        if (mptr != nullptr) {
+          res = idx->insert(idx, mptr, false);
+
+          if (res != TRI_ERROR_NO_ERROR) {
+            break;
+          }
+
+          if (++counter == LoopSize) {
+            counter = 0;
+            reportProgress(LoopSize);
+
+            LOG_TRACE("indexed %llu documents of collection %llu",
+                      (unsigned long long) done.load(),
+                      (unsigned long long) document->_info._cid);
+          }
+        }
+      }
     }
   }
+  catch (...) {
+    finishProgress();
+    throw;
+  }
+  
+  finishProgress();
 
-  return TRI_ERROR_NO_ERROR;
+  return res;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3485,6 +3550,9 @@ bool TRI_DropIndexDocumentCollection (TRI_document_collection_t* document,
 
   if (found != nullptr) {
     RebuildIndexInfo(document);
+
+    // cached plans may use the index
+    TRI_InvalidatePlanCacheVocBase(vocbase);
   }
 
   TRI_WRITE_UNLOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
@@ -4873,13 +4941,14 @@ std::vector<TRI_doc_mptr_copy_t> TRI_SelectByExample (
   std::vector<TRI_doc_mptr_copy_t> filtered;
 
   // do a full scan
-  TRI_doc_mptr_t** ptr = (TRI_doc_mptr_t**) (document->_primaryIndex._table);
-  TRI_doc_mptr_t** end = (TRI_doc_mptr_t**) ptr + document->_primaryIndex._nrAlloc;
+  uint64_t const end = TRI_SlotsPrimaryIndex(&document->_primaryIndex);
 
-  for (;  ptr < end;  ++ptr) {
-    if (*ptr != nullptr &&
-        IsExampleMatch(trxCollection, shaper, *ptr, length, pids, values)) {
-      filtered.push_back(**ptr);
+  for (uint64_t position = 0;  position < end;  ++position) {
+    TRI_doc_mptr_t* mptr = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
+
+    if (mptr != nullptr &&
+        IsExampleMatch(trxCollection, shaper, mptr, length, pids, values)) {
+      filtered.push_back(*mptr);
     }
   }
   return filtered;
@@ -4900,12 +4969,12 @@ CountingAggregation* TRI_AggregateBySingleAttribute (
   TRI_shaper_t* shaper = document->getShaper();
 
   // do a full scan
-  TRI_doc_mptr_t** ptr = (TRI_doc_mptr_t**) (document->_primaryIndex._table);
-  TRI_doc_mptr_t** end = (TRI_doc_mptr_t**) ptr + document->_primaryIndex._nrAlloc;
+  uint64_t const end = TRI_SlotsPrimaryIndex(&document->_primaryIndex);
+
+  for (uint64_t position = 0;  position < end;  ++position) {
+    TRI_doc_mptr_t* m = TRI_SlotPrimaryIndex(&document->_primaryIndex, position);
 
-  for (;  ptr < end;  ++ptr) {
-    if (*ptr != nullptr) {
-      TRI_doc_mptr_t* m = *ptr;
+    if (m != nullptr) {
       TRI_shape_sid_t sid;
       TRI_EXTRACT_SHAPE_IDENTIFIER_MARKER(sid, m->getDataPtr());
       TRI_shape_access_t const* accessor = TRI_FindAccessorVocShaper(shaper, 
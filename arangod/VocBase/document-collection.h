@@ -300,6 +300,7 @@ typedef struct TRI_doc_collection_info_s {
   TRI_voc_ssize_t _numberAttributes;
   TRI_voc_ssize_t _numberTransactions;
   TRI_voc_ssize_t _numberIndexes;
+  TRI_voc_ssize_t _numberIndexFillPending;
 
   int64_t         _sizeAlive;
   int64_t         _sizeDead;
@@ -375,6 +376,8 @@ public:
   std::set<TRI_voc_tid_t>*     _failedTransactions;
 
   std::atomic<int64_t>         _uncollectedLogfileEntries;
+  // number of documents not yet inserted into indexes that are being filled
+  std::atomic<int64_t>         _indexFillPending;
   int64_t                      _numberDocuments;
   TRI_read_write_lock_t        _compactionLock;
   double                       _lastCompaction;
@@ -29,6 +29,7 @@
 
 #include "index.h"
 
+#include "Basics/Barrier.h"
 #include "Basics/conversions.h"
 #include "Basics/Exceptions.h"
 #include "Basics/fasthash.h"
@@ -36,6 +37,7 @@
 #include "Basics/json.h"
 #include "Basics/logging.h"
 #include "Basics/string-buffer.h"
+#include "Basics/ThreadPool.h"
 #include "Basics/tri-strings.h"
 #include "Basics/json-utilities.h"
 #include "Basics/JsonHelper.h"
@@ -58,6 +60,97 @@
 // --SECTION--                                                             INDEX
 // -----------------------------------------------------------------------------
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimum number of documents per partition for batch inserts
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const MinBatchPartitionSize = 16384;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of documents after which batch inserts report progress
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const BatchProgressSize = 4096;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief distributes partitioned index work to the index threads
+///
+/// the last partition is processed by the calling thread. the function
+/// returns when all partitions are processed. it must not be called from an
+/// index thread itself, as this thread would then wait for tasks queued
+/// behind it
+////////////////////////////////////////////////////////////////////////////////
+
+static int DistributeIndexWork (TRI_document_collection_t* document,
+                                size_t numPartitions,
+                                std::function<int(size_t)> const& work) {
+  std::atomic<int> result(TRI_ERROR_NO_ERROR);
+
+  auto setError = [&result] (int res) -> void {
+    if (res != TRI_ERROR_NO_ERROR) {
+      int expected = TRI_ERROR_NO_ERROR;
+      result.compare_exchange_strong(expected, res, std::memory_order_acquire);
+    }
+  };
+
+  auto runPartition = [&work, &setError] (size_t partition) -> void {
+    int res;
+
+    try {
+      res = work(partition);
+    }
+    catch (triagens::basics::Exception const& ex) {
+      res = ex.code();
+    }
+    catch (...) {
+      res = TRI_ERROR_INTERNAL;
+    }
+
+    setError(res);
+  };
+
+  auto indexPool = static_cast<triagens::basics::ThreadPool*>(document->_vocbase->_server->_indexPool);
+
+  {
+    triagens::basics::Barrier barrier(numPartitions);
+
+    for (size_t i = 0;  i < numPartitions;  ++i) {
+      if (indexPool != nullptr && i != (numPartitions - 1)) {
+        auto task = [&runPartition, &barrier, i] () -> void {
+          triagens::arango::TransactionBase trx(true);
+          runPartition(i);
+          barrier.join();
+        };
+
+        try {
+          indexPool->enqueue(task);
+        }
+        catch (...) {
+          setError(TRI_ERROR_INTERNAL);
+          barrier.join();
+        }
+      }
+      else {
+        // the calling thread is already inside a transaction
+        runPartition(i);
+        barrier.join();
+      }
+    }
+
+    // barrier waits here until all partitions are processed
+  }
+
+  return result.load();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -98,6 +191,7 @@ void TRI_InitIndex (TRI_index_t* idx,
   idx->removeIndex            = nullptr;
   idx->cleanup                = nullptr;
   idx->sizeHint               = nullptr;
+  idx->batchInsert            = nullptr;
   idx->postInsert             = nullptr;
 
   LOG_TRACE("initialising index of type %s", TRI_TypeNameIndex(idx->_type));
@@ -500,7 +594,7 @@ static int RemovePrimary (TRI_index_t* idx,
 ////////////////////////////////////////////////////////////////////////////////
 
 static size_t MemoryPrimary (TRI_index_t const* idx) {
-  return static_cast<size_t>(idx->_collection->_primaryIndex._nrAlloc) * sizeof(void*);
+  return static_cast<size_t>(TRI_SlotsPrimaryIndex(&idx->_collection->_primaryIndex)) * sizeof(void*);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1276,31 +1370,34 @@ static int SkiplistIndexHelper (TRI_skiplist_index_t const* skiplistIndex,
     TRI_FillShapedSub(&subObjects[j], &shapedObject, ptr);
   }
 
+  SkiplistIndex_normalizeElement(skiplistIndex->_skiplistIndex, skiplistElement);
+
   return res;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief inserts a document into a skip list index
+/// @brief creates the skip list index element for a document
+///
+/// element is set to nullptr if the document is not indexed at all
 ////////////////////////////////////////////////////////////////////////////////
 
-static int InsertSkiplistIndex (TRI_index_t* idx,
-                                TRI_doc_mptr_t const* doc,
-                                bool isRollback) {
-
-  TRI_skiplist_index_t* skiplistIndex = (TRI_skiplist_index_t*) idx;
+static int CreateSkiplistElement (TRI_skiplist_index_t* skiplistIndex,
+                                  TRI_doc_mptr_t const* doc,
+                                  TRI_skiplist_index_element_t*& skiplistElement) {
+  skiplistElement = nullptr;
 
   // ...........................................................................
   // Allocate storage to shaped json objects stored as a simple list.
   // These will be used for comparisions
   // ...........................................................................
 
-  auto skiplistElement = static_cast<TRI_skiplist_index_element_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, SkiplistIndex_ElementSize(skiplistIndex->_skiplistIndex), false));
+  auto element = static_cast<TRI_skiplist_index_element_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, SkiplistIndex_ElementSize(skiplistIndex->_skiplistIndex), false));
 
-  if (skiplistElement == nullptr) {
+  if (element == nullptr) {
     return TRI_ERROR_OUT_OF_MEMORY;
   }
 
-  int res = SkiplistIndexHelper(skiplistIndex, skiplistElement, doc);
+  int res = SkiplistIndexHelper(skiplistIndex, element, doc);
   // ...........................................................................
   // most likely the cause of this error is that the index is sparse
   // and not all attributes the index needs are set -- so the document
@@ -1318,8 +1415,8 @@ static int InsertSkiplistIndex (TRI_index_t* idx,
   // .........................................................................
 
   if (res == TRI_ERROR_ARANGO_INDEX_DOCUMENT_ATTRIBUTE_MISSING) {
-    if (idx->_sparse) {
-      TRI_Free(TRI_UNKNOWN_MEM_ZONE, skiplistElement);
+    if (skiplistIndex->base._sparse) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, element);
       return TRI_ERROR_NO_ERROR;
     }
 
@@ -1327,7 +1424,29 @@ static int InsertSkiplistIndex (TRI_index_t* idx,
   }
 
   if (res != TRI_ERROR_NO_ERROR) {
-    TRI_Free(TRI_UNKNOWN_MEM_ZONE, skiplistElement);
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, element);
+    return res;
+  }
+
+  skiplistElement = element;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts a document into a skip list index
+////////////////////////////////////////////////////////////////////////////////
+
+static int InsertSkiplistIndex (TRI_index_t* idx,
+                                TRI_doc_mptr_t const* doc,
+                                bool isRollback) {
+
+  TRI_skiplist_index_t* skiplistIndex = (TRI_skiplist_index_t*) idx;
+
+  TRI_skiplist_index_element_t* skiplistElement;
+  int res = CreateSkiplistElement(skiplistIndex, doc, skiplistElement);
+
+  if (res != TRI_ERROR_NO_ERROR || skiplistElement == nullptr) {
     return res;
   }
 
@@ -1336,6 +1455,76 @@ static int InsertSkiplistIndex (TRI_index_t* idx,
   return SkiplistIndex_insert(skiplistIndex->_skiplistIndex, skiplistElement);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts many documents into a skip list index
+///
+/// the documents are split into partitions. for each partition the index
+/// elements are created and sorted, using the index threads. the sorted runs
+/// are then merged and the skip list is built from the merged run in one go
+////////////////////////////////////////////////////////////////////////////////
+
+static int BatchInsertSkiplistIndex (TRI_index_t* idx,
+                                     std::vector<TRI_doc_mptr_t const*> const* documents,
+                                     size_t numThreads,
+                                     std::function<void(size_t)> const& progress) {
+  TRI_skiplist_index_t* skiplistIndex = (TRI_skiplist_index_t*) idx;
+
+  size_t const n = documents->size();
+  // do not create tiny partitions
+  size_t const numPartitions = (std::max)((size_t) 1, (std::min)(numThreads, n / MinBatchPartitionSize));
+
+  std::vector<std::vector<TRI_skiplist_index_element_t*>> runs(numPartitions);
+
+  auto fillRun = [&] (size_t partition) -> int {
+    size_t const lower = n * partition / numPartitions;
+    size_t const upper = n * (partition + 1) / numPartitions;
+
+    auto& run = runs[partition];
+    run.reserve(upper - lower);
+
+    size_t reported = lower;
+
+    for (size_t i = lower; i < upper; ++i) {
+      TRI_skiplist_index_element_t* skiplistElement;
+      int res = CreateSkiplistElement(skiplistIndex, (*documents)[i], skiplistElement);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+
+      if (skiplistElement != nullptr) {
+        run.push_back(skiplistElement);
+      }
+
+      if (i + 1 - reported == BatchProgressSize) {
+        progress(BatchProgressSize);
+        reported = i + 1;
+      }
+    }
+
+    SkiplistIndex_sortElements(skiplistIndex->_skiplistIndex, run);
+
+    // the rest of the partition is reported by the caller when the index
+    // is complete
+
+    return TRI_ERROR_NO_ERROR;
+  };
+
+  int res = DistributeIndexWork(idx->_collection, numPartitions, fillRun);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    for (auto& run : runs) {
+      for (auto element : run) {
+        TRI_Free(TRI_UNKNOWN_MEM_ZONE, element);
+      }
+    }
+    return res;
+  }
+
+  // ownership for all elements is transferred to the index
+  return SkiplistIndex_insertSorted(skiplistIndex->_skiplistIndex, runs);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the memory used by the index
 ////////////////////////////////////////////////////////////////////////////////
@@ -1481,6 +1670,7 @@ TRI_index_t* TRI_CreateSkiplistIndex (TRI_document_collection_t* document,
   idx->memory   = MemorySkiplistIndex;
   idx->json     = JsonSkiplistIndex;
   idx->insert   = InsertSkiplistIndex;
+  idx->batchInsert = BatchInsertSkiplistIndex;
   idx->remove   = RemoveSkiplistIndex;
 
   // ...........................................................................
@@ -1554,8 +1744,39 @@ void TRI_FreeSkiplistIndex (TRI_index_t* idx) {
 struct TextExtractorContext {
   std::vector<std::pair<char const*, size_t>>* _positions;
   TRI_shaper_t*                                _shaper;
+  std::deque<std::string>*                     _uncompressed;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add the value of a string shape to the extracted strings
+////////////////////////////////////////////////////////////////////////////////
+
+static void ExtractText (TextExtractorContext* context,
+                         TRI_shape_t const* shape,
+                         char const* shapedJson) {
+  char* text;
+  size_t textLength;
+
+  try {
+    if (shape->_type == TRI_SHAPE_COMPRESSED_STRING) {
+      // the uncompressed strings must live until the words are extracted
+      size_t const length = TRI_LengthCompressedStringShapedJson(shapedJson);
+      context->_uncompressed->emplace_back(length, '\0');
+      std::string& value = context->_uncompressed->back();
+
+      if (TRI_UncompressStringShapedJson(shapedJson, &value[0])) {
+        context->_positions->emplace_back(value.c_str(), length - 1);
+      }
+    }
+    else if (TRI_StringValueShapedJson(shape, shapedJson, &text, &textLength)) {
+      // add string value found
+      context->_positions->emplace_back(text, textLength);
+    }
+  }
+  catch (...) {
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief walk over an array shape and extract the string values
 ////////////////////////////////////////////////////////////////////////////////
@@ -1566,18 +1787,7 @@ static bool ArrayTextExtractor (TRI_shaper_t* shaper,
                                 char const* shapedJson, 
                                 uint64_t length, 
                                 void* data) {
-  char* text;
-  size_t textLength;
-  bool ok = TRI_StringValueShapedJson(shape, shapedJson, &text, &textLength);
-
-  if (ok) {
-    // add string value found
-    try {
-      static_cast<TextExtractorContext*>(data)->_positions->emplace_back(text, textLength);
-    }
-    catch (...) {
-    }
-  }
+  ExtractText(static_cast<TextExtractorContext*>(data), shape, shapedJson);
   return true;
 }
 
@@ -1595,20 +1805,9 @@ static bool ListTextExtractor (TRI_shaper_t* shaper,
     TRI_IterateShapeDataArray(static_cast<TextExtractorContext*>(data)->_shaper, shape, shapedJson, ArrayTextExtractor, data);
   }
   else if (shape->_type == TRI_SHAPE_SHORT_STRING ||
-           shape->_type == TRI_SHAPE_LONG_STRING) {
-
-    char* text;
-    size_t textLength;
-    bool ok = TRI_StringValueShapedJson(shape, shapedJson, &text, &textLength);
-
-    if (ok) {
-      // add string value found
-      try {
-        static_cast<TextExtractorContext*>(data)->_positions->emplace_back(text, textLength);
-      }
-      catch (...) {
-      }
-    }
+           shape->_type == TRI_SHAPE_LONG_STRING ||
+           shape->_type == TRI_SHAPE_COMPRESSED_STRING) {
+    ExtractText(static_cast<TextExtractorContext*>(data), shape, shapedJson);
   }
 
   return true;
@@ -1654,9 +1853,27 @@ static TRI_fulltext_wordlist_t* GetWordlist (TRI_index_t* idx,
     // parse the document text
     words = TRI_get_words(text, textLength, (size_t) fulltextIndex->_minWordLength, (size_t) TRI_FULLTEXT_MAX_WORD_LENGTH, true);
   }
+  else if (shape->_type == TRI_SHAPE_COMPRESSED_STRING) {
+    size_t const textLength = TRI_LengthCompressedStringShapedJson(shapedJson._data.data);
+    char* text = static_cast<char*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, textLength, false));
+
+    if (text == nullptr) {
+      return nullptr;
+    }
+
+    if (! TRI_UncompressStringShapedJson(shapedJson._data.data, text)) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, text);
+      return nullptr;
+    }
+
+    // parse the document text
+    words = TRI_get_words(text, textLength - 1, (size_t) fulltextIndex->_minWordLength, (size_t) TRI_FULLTEXT_MAX_WORD_LENGTH, true);
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, text);
+  }
   else if (shape->_type == TRI_SHAPE_ARRAY) {
     std::vector<std::pair<char const*, size_t>> values;
-    TextExtractorContext context{ &values, shaper };
+    std::deque<std::string> uncompressed;
+    TextExtractorContext context{ &values, shaper, &uncompressed };
     TRI_IterateShapeDataArray(shaper, shape, shapedJson._data.data, ArrayTextExtractor, &context);
   
     words = nullptr; 
@@ -1673,7 +1890,8 @@ static TRI_fulltext_wordlist_t* GetWordlist (TRI_index_t* idx,
            shape->_type == TRI_SHAPE_HOMOGENEOUS_LIST ||
            shape->_type == TRI_SHAPE_HOMOGENEOUS_SIZED_LIST) {
     std::vector<std::pair<char const*, size_t>> values;
-    TextExtractorContext context{ &values, shaper };
+    std::deque<std::string> uncompressed;
+    TextExtractorContext context{ &values, shaper, &uncompressed };
     TRI_IterateShapeDataList(shaper, shape, shapedJson._data.data, ListTextExtractor, &context);
   
     words = nullptr; 
@@ -43,6 +43,8 @@
 #include "SkipLists/skiplistIndex.h"
 #include "VocBase/voc-types.h"
 
+#include <functional>
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                              forward declarations
 // -----------------------------------------------------------------------------
@@ -123,6 +125,12 @@ typedef struct TRI_index_s {
   // give index a hint about the expected size
   int (*sizeHint) (struct TRI_index_s*, size_t);
 
+  // NULL by default. will only be called if non-NULL
+  // inserts many documents at once, using up to the given number of threads.
+  // the callback is invoked with the number of documents processed so far
+  // and may be called concurrently from several threads
+  int (*batchInsert) (struct TRI_index_s*, std::vector<struct TRI_doc_mptr_t const*> const*, size_t, std::function<void(size_t)> const&);
+
   // .........................................................................................
   // the following functions are called by the query machinery which attempting to determine an
   // appropriate index and when using the index to obtain a result set.
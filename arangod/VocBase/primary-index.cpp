@@ -33,6 +33,26 @@
 #include "Basics/hashes.h"
 #include "VocBase/document-collection.h"
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief storage for the tombstone marker
+////////////////////////////////////////////////////////////////////////////////
+
+static char TombstoneStorage;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marker for entries removed from a table that is being migrated
+////////////////////////////////////////////////////////////////////////////////
+
+void* const TRI_PrimaryIndexTombstone = &TombstoneStorage;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
@@ -45,6 +65,18 @@ static inline uint64_t InitialSize () {
   return 251;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of old table slots migrated per insert or remove
+///
+/// a migration starts when the index is half full and the new table is about
+/// twice as big, so the migration must advance by at least two slots per
+/// insert to be finished before the new table needs to grow
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint64_t MigrationBatchSize () {
+  return 64;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief resizes the index
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,7 +86,172 @@ static inline bool ShouldResize (TRI_primary_index_t const* idx) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief resizes the index
+/// @brief comparison function, compares a master pointer to another
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool IsDifferentKeyElement (TRI_doc_mptr_t const* header,
+                                          void const* element) {
+  TRI_doc_mptr_t const* e = static_cast<TRI_doc_mptr_t const*>(element);
+
+  // only after that compare actual keys
+  return (header->_hash != e->_hash || strcmp(TRI_EXTRACT_MARKER_KEY(header), TRI_EXTRACT_MARKER_KEY(e)) != 0);  // ONLY IN INDEX, PROTECTED by RUNTIME
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief comparison function, compares a hash/key to a master pointer
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool IsDifferentHashElement (char const* key, uint64_t hash, void const* element) {
+  TRI_doc_mptr_t const* e = static_cast<TRI_doc_mptr_t const*>(element);
+
+  return (hash != e->_hash || strcmp(key, TRI_EXTRACT_MARKER_KEY(e)) != 0);  // ONLY IN INDEX, PROTECTED by RUNTIME
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adds an element to a table that is known not to contain it
+////////////////////////////////////////////////////////////////////////////////
+
+static inline void AddToTable (void** table,
+                               uint64_t n,
+                               void* element) {
+  uint64_t const hash = static_cast<TRI_doc_mptr_t const*>(element)->_hash;
+  uint64_t i, k;
+
+  i = k = hash % n;
+
+  for (; i < n && table[i] != nullptr; ++i);
+  if (i == n) {
+    for (i = 0; i < k && table[i] != nullptr; ++i);
+  }
+
+  TRI_ASSERT_EXPENSIVE(i < n);
+
+  table[i] = element;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finds a key in the old table
+///
+/// returns the position of the element, or _nrOldAlloc if the key is not
+/// contained in the not yet migrated part of the old table. the old table is
+/// never inserted into, so it contains each key at most once. an element
+/// found before the migration position has been moved to the new table, and
+/// is only a stale copy
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t FindInOldTable (TRI_primary_index_t const* idx,
+                                char const* key,
+                                uint64_t hash) {
+  uint64_t const n = idx->_nrOldAlloc;
+  uint64_t i = hash % n;
+
+  TRI_ASSERT_EXPENSIVE(idx->_oldTable != nullptr);
+
+  while (idx->_oldTable[i] != nullptr) {
+    void const* element = idx->_oldTable[i];
+
+    if (element != TRI_PrimaryIndexTombstone &&
+        ! IsDifferentHashElement(key, hash, element)) {
+      return (i >= idx->_migratePosition ? i : n);
+    }
+
+    i = TRI_IncModU64(i, n);
+  }
+
+  return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief frees the old table after a migration
+////////////////////////////////////////////////////////////////////////////////
+
+static void DiscardOldTable (TRI_primary_index_t* idx) {
+  if (idx->_oldTable != nullptr) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, idx->_oldTable);
+    idx->_oldTable = nullptr;
+  }
+
+  idx->_nrOldAlloc      = 0;
+  idx->_migratePosition = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief migrates up to count slots of the old table into the new table
+////////////////////////////////////////////////////////////////////////////////
+
+static void MigrateSlots (TRI_primary_index_t* idx,
+                          uint64_t count) {
+  if (idx->_oldTable == nullptr) {
+    return;
+  }
+
+  uint64_t const n = idx->_nrOldAlloc;
+  uint64_t const end = (n - idx->_migratePosition > count ? idx->_migratePosition + count : n);
+
+  for (uint64_t i = idx->_migratePosition; i < end; ++i) {
+    void* element = idx->_oldTable[i];
+
+    if (element != nullptr && element != TRI_PrimaryIndexTombstone) {
+      AddToTable(idx->_table, idx->_nrAlloc, element);
+    }
+  }
+
+  idx->_migratePosition = end;
+
+  if (end == n) {
+    DiscardOldTable(idx);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finishes a pending migration at once
+////////////////////////////////////////////////////////////////////////////////
+
+static void FinishMigration (TRI_primary_index_t* idx) {
+  if (idx->_nrUsed == 0) {
+    // only tombstones and stale copies left
+    DiscardOldTable(idx);
+  }
+  else {
+    MigrateSlots(idx, idx->_nrOldAlloc);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief starts migrating the index into a bigger table
+///
+/// only the new table is allocated here. the entries are moved into it by
+/// the following inserts and removals, so no single operation has to rehash
+/// the complete index
+////////////////////////////////////////////////////////////////////////////////
+
+static bool StartMigration (TRI_primary_index_t* idx,
+                            uint64_t targetSize) {
+  TRI_ASSERT(targetSize > idx->_nrAlloc);
+
+  // the previous migration should have finished long ago
+  FinishMigration(idx);
+
+  void** table = static_cast<void**>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, (size_t) (targetSize * sizeof(void*)), true));
+
+  if (table == nullptr) {
+    return false;
+  }
+
+  idx->_oldTable        = idx->_table;
+  idx->_nrOldAlloc      = idx->_nrAlloc;
+  idx->_migratePosition = 0;
+
+  idx->_table   = table;
+  idx->_nrAlloc = targetSize;
+
+  MigrateSlots(idx, MigrationBatchSize());
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief resizes the index at once
 ////////////////////////////////////////////////////////////////////////////////
 
 static bool ResizePrimaryIndex (TRI_primary_index_t* idx,
@@ -62,6 +259,8 @@ static bool ResizePrimaryIndex (TRI_primary_index_t* idx,
                                 bool allowShrink) {
   TRI_ASSERT(targetSize > 0);
 
+  FinishMigration(idx);
+
   if (idx->_nrAlloc >= targetSize && ! allowShrink) {
     return true;
   }
@@ -81,22 +280,8 @@ static bool ResizePrimaryIndex (TRI_primary_index_t* idx,
 
     // table is already cleared by allocate, now copy old data
     for (uint64_t j = 0; j < oldAlloc; j++) {
-      TRI_doc_mptr_t const* element = static_cast<TRI_doc_mptr_t const*>(oldTable[j]);
-
-      if (element != nullptr) {
-        uint64_t const hash = element->_hash;
-        uint64_t i, k;
-
-        i = k = hash % targetSize;
-
-        for (; i < targetSize && idx->_table[i] != nullptr; ++i);
-        if (i == targetSize) {
-          for (i = 0; i < k && idx->_table[i] != nullptr; ++i);
-        }
-
-        TRI_ASSERT_EXPENSIVE(i < targetSize);
-
-        idx->_table[i] = (void*) element;
+      if (oldTable[j] != nullptr) {
+        AddToTable(idx->_table, targetSize, oldTable[j]);
       }
     }
   }
@@ -107,28 +292,6 @@ static bool ResizePrimaryIndex (TRI_primary_index_t* idx,
   return true;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief comparison function, compares a master pointer to another
-////////////////////////////////////////////////////////////////////////////////
-
-static inline bool IsDifferentKeyElement (TRI_doc_mptr_t const* header,
-                                          void const* element) {
-  TRI_doc_mptr_t const* e = static_cast<TRI_doc_mptr_t const*>(element);
-
-  // only after that compare actual keys
-  return (header->_hash != e->_hash || strcmp(TRI_EXTRACT_MARKER_KEY(header), TRI_EXTRACT_MARKER_KEY(e)) != 0);  // ONLY IN INDEX, PROTECTED by RUNTIME
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief comparison function, compares a hash/key to a master pointer
-////////////////////////////////////////////////////////////////////////////////
-
-static inline bool IsDifferentHashElement (char const* key, uint64_t hash, void const* element) {
-  TRI_doc_mptr_t const* e = static_cast<TRI_doc_mptr_t const*>(element);
-
-  return (hash != e->_hash || strcmp(key, TRI_EXTRACT_MARKER_KEY(e)) != 0);  // ONLY IN INDEX, PROTECTED by RUNTIME
-}
-
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -138,8 +301,11 @@ static inline bool IsDifferentHashElement (char const* key, uint64_t hash, void
 ////////////////////////////////////////////////////////////////////////////////
 
 int TRI_InitPrimaryIndex (TRI_primary_index_t* idx) {
-  idx->_nrAlloc = 0;
-  idx->_nrUsed  = 0;
+  idx->_nrAlloc         = 0;
+  idx->_nrUsed          = 0;
+  idx->_nrOldAlloc      = 0;
+  idx->_migratePosition = 0;
+  idx->_oldTable        = nullptr;
 
   idx->_table = static_cast<void**>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, (size_t) (InitialSize() * sizeof(void*)), true));
 
@@ -181,6 +347,8 @@ int TRI_AutoResizePrimaryIndex (TRI_primary_index_t* idx) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void TRI_DestroyPrimaryIndex (TRI_primary_index_t* idx) {
+  DiscardOldTable(idx);
+
   if (idx->_table != nullptr) {
     TRI_Free(TRI_UNKNOWN_MEM_ZONE, idx->_table);
     idx->_table = nullptr;
@@ -218,6 +386,16 @@ void* TRI_LookupByKeyPrimaryIndex (TRI_primary_index_t* idx,
 
   TRI_ASSERT_EXPENSIVE(i < n);
 
+  if (idx->_table[i] == nullptr && idx->_oldTable != nullptr) {
+    // the element may not have been migrated yet. lookups run under the
+    // read lock, so they must not advance the migration themselves
+    uint64_t const j = FindInOldTable(idx, key, hash);
+
+    if (j < idx->_nrOldAlloc) {
+      return idx->_oldTable[j];
+    }
+  }
+
   // return whatever we found
   return idx->_table[i];
 }
@@ -234,10 +412,13 @@ int TRI_InsertKeyPrimaryIndex (TRI_primary_index_t* idx,
 
   if (ShouldResize(idx)) {
     // check for out-of-memory
-    if (! ResizePrimaryIndex(idx, (uint64_t) (2 * idx->_nrAlloc + 1), false)) {
+    if (! StartMigration(idx, (uint64_t) (2 * idx->_nrAlloc + 1))) {
       return TRI_ERROR_OUT_OF_MEMORY;
     }
   }
+  else {
+    MigrateSlots(idx, MigrationBatchSize());
+  }
 
   uint64_t const n = idx->_nrAlloc;
   uint64_t i, k;
@@ -255,6 +436,14 @@ int TRI_InsertKeyPrimaryIndex (TRI_primary_index_t* idx,
 
   void* old = idx->_table[i];
 
+  if (old == nullptr && idx->_oldTable != nullptr) {
+    uint64_t const j = FindInOldTable(idx, TRI_EXTRACT_MARKER_KEY(header), header->_hash);  // ONLY IN INDEX, PROTECTED by RUNTIME
+
+    if (j < idx->_nrOldAlloc) {
+      old = idx->_oldTable[j];
+    }
+  }
+
   // if we found an element, return
   if (old != nullptr) {
     *found = old;
@@ -277,6 +466,10 @@ int TRI_InsertKeyPrimaryIndex (TRI_primary_index_t* idx,
 
 void TRI_InsertKeyPrimaryIndex (TRI_primary_index_t* idx,
                                 TRI_doc_mptr_t const* header) {
+  if (idx->_oldTable != nullptr) {
+    FinishMigration(idx);
+  }
+
   uint64_t const n = idx->_nrAlloc;
   uint64_t i, k;
 
@@ -302,6 +495,8 @@ void TRI_InsertKeyPrimaryIndex (TRI_primary_index_t* idx,
 
 void* TRI_RemoveKeyPrimaryIndex (TRI_primary_index_t* idx,
                                  char const* key) {
+  MigrateSlots(idx, MigrationBatchSize());
+
   uint64_t const hash = TRI_HashKeyPrimaryIndex(key);
   uint64_t const n = idx->_nrAlloc;
   uint64_t i, k;
@@ -316,29 +511,44 @@ void* TRI_RemoveKeyPrimaryIndex (TRI_primary_index_t* idx,
 
   TRI_ASSERT_EXPENSIVE(i < n);
 
-  // if we did not find such an item return false
-  if (idx->_table[i] == nullptr) {
-    return nullptr;
-  }
-
-  // remove item
   void* old = idx->_table[i];
-  idx->_table[i] = nullptr;
-  idx->_nrUsed--;
 
-  // and now check the following places for items to move here
-  k = TRI_IncModU64(i, n);
+  if (old == nullptr) {
+    if (idx->_oldTable == nullptr) {
+      // if we did not find such an item return false
+      return nullptr;
+    }
 
-  while (idx->_table[k] != nullptr) {
-    uint64_t j = (static_cast<TRI_doc_mptr_t const*>(idx->_table[k])->_hash) % n;
+    uint64_t const j = FindInOldTable(idx, key, hash);
 
-    if ((i < k && ! (i < j && j <= k)) || (k < i && ! (i < j || j <= k))) {
-      idx->_table[i] = idx->_table[k];
-      idx->_table[k] = nullptr;
-      i = k;
+    if (j == idx->_nrOldAlloc) {
+      return nullptr;
     }
 
-    k = TRI_IncModU64(k, n);
+    // the old table must keep its probe sequences, so leave a tombstone
+    old = idx->_oldTable[j];
+    idx->_oldTable[j] = TRI_PrimaryIndexTombstone;
+    idx->_nrUsed--;
+  }
+  else {
+    // remove item
+    idx->_table[i] = nullptr;
+    idx->_nrUsed--;
+
+    // and now check the following places for items to move here
+    k = TRI_IncModU64(i, n);
+
+    while (idx->_table[k] != nullptr) {
+      uint64_t j = (static_cast<TRI_doc_mptr_t const*>(idx->_table[k])->_hash) % n;
+
+      if ((i < k && ! (i < j && j <= k)) || (k < i && ! (i < j || j <= k))) {
+        idx->_table[i] = idx->_table[k];
+        idx->_table[k] = nullptr;
+        i = k;
+      }
+
+      k = TRI_IncModU64(k, n);
+    }
   }
 
   if (idx->_nrUsed == 0) {
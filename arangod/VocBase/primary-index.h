@@ -32,7 +32,7 @@
 #define ARANGODB_VOC_BASE_PRIMARY__INDEX_H 1
 
 #include "Basics/Common.h"
-#include "Basics/hashes.h"
+#include "Basics/fasthash.h"
 #include "Basics/locks.h"
 
 struct TRI_doc_mptr_t;
@@ -43,16 +43,36 @@ struct TRI_doc_mptr_t;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief associative array of pointers
+///
+/// the index grows incrementally: when the table becomes too full, a bigger
+/// table is allocated and the entries of the previous table are migrated into
+/// it a few slots at a time by the following inserts and removals. while a
+/// migration is in progress, an entry is either in _table or in _oldTable at
+/// a position >= _migratePosition. the old table is never inserted into.
+/// entries removed from it are replaced by TRI_PrimaryIndexTombstone so that
+/// probe sequences stay intact. use TRI_SlotsPrimaryIndex and
+/// TRI_SlotPrimaryIndex to iterate over all entries
 ////////////////////////////////////////////////////////////////////////////////
 
 typedef struct TRI_primary_index_s {
-  uint64_t _nrAlloc;     // the size of the table
-  uint64_t _nrUsed;      // the number of used entries
+  uint64_t _nrAlloc;          // the size of the table
+  uint64_t _nrUsed;           // the number of used entries in both tables
+
+  void** _table;              // the table itself
 
-  void** _table;         // the table itself
+  uint64_t _nrOldAlloc;       // the size of the old table, 0 if not migrating
+  uint64_t _migratePosition;  // next slot of the old table to migrate
+
+  void** _oldTable;           // the table being migrated, or nullptr
 }
 TRI_primary_index_t;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marker for entries removed from a table that is being migrated
+////////////////////////////////////////////////////////////////////////////////
+
+extern void* const TRI_PrimaryIndexTombstone;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -64,7 +84,9 @@ TRI_primary_index_t;
 int TRI_InitPrimaryIndex (TRI_primary_index_t*);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief initialises the index
+/// @brief resizes the index so that it can hold the given number of entries.
+/// this finishes a pending migration and rehashes the whole index at once,
+/// so it should only be used when the collection is opened
 ////////////////////////////////////////////////////////////////////////////////
 
 int TRI_ResizePrimaryIndex (TRI_primary_index_t*, 
@@ -88,19 +110,59 @@ void TRI_DestroyPrimaryIndex (TRI_primary_index_t*);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief hash the key
+///
+/// the hash is only kept in memory (TRI_doc_mptr_t::_hash) and is recomputed
+/// whenever a collection is loaded, so the hash function can be changed
+/// without affecting existing data
 ////////////////////////////////////////////////////////////////////////////////
   
-static inline uint64_t TRI_HashKeyPrimaryIndex (char const* key) {
-  return TRI_FnvHashString(key);
+static inline uint64_t TRI_HashKeyPrimaryIndex (char const* key,
+                                                size_t length) {
+  return fasthash64(static_cast<void const*>(key), length, 0xdeadbeefdeadbeefULL);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief hash the key
 ////////////////////////////////////////////////////////////////////////////////
   
-static inline uint64_t TRI_HashKeyPrimaryIndex (char const* key,
-                                                size_t length) {
-  return TRI_FnvHashPointer(static_cast<void const*>(key), length);
+static inline uint64_t TRI_HashKeyPrimaryIndex (char const* key) {
+  return TRI_HashKeyPrimaryIndex(key, strlen(key));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of slots to iterate over with TRI_SlotPrimaryIndex
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint64_t TRI_SlotsPrimaryIndex (TRI_primary_index_t const* idx) {
+  return idx->_nrAlloc + idx->_nrOldAlloc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the element at a slot position, or nullptr if the slot is
+/// empty. positions beyond TRI_SlotsPrimaryIndex are treated as empty, so a
+/// position remembered across a resize is safe to use
+////////////////////////////////////////////////////////////////////////////////
+
+static inline struct TRI_doc_mptr_t* TRI_SlotPrimaryIndex (TRI_primary_index_t const* idx,
+                                                           uint64_t position) {
+  if (position < idx->_nrAlloc) {
+    return static_cast<struct TRI_doc_mptr_t*>(idx->_table[position]);
+  }
+
+  position -= idx->_nrAlloc;
+
+  if (position < idx->_migratePosition || position >= idx->_nrOldAlloc) {
+    // already migrated or out of range
+    return nullptr;
+  }
+
+  void* element = idx->_oldTable[position];
+
+  if (element == TRI_PrimaryIndexTombstone) {
+    return nullptr;
+  }
+
+  return static_cast<struct TRI_doc_mptr_t*>(element);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
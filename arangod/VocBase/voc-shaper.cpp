@@ -602,6 +602,8 @@ TRI_shaper_t* TRI_CreateVocShaper (TRI_vocbase_t* vocbase,
     return nullptr;
   }
 
+  shaper->base._compressStrings = document->_info._compressStrings;
+
   res = InitStep1VocShaper(shaper);
 
   if (res != TRI_ERROR_NO_ERROR) {
@@ -1148,6 +1150,65 @@ static void DestroyAttributesVector (TRI_vector_t* vector) {
   TRI_DestroyVector(vector);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compares two shapes, at least one of which is a compressed string.
+/// compressed strings are uncompressed and compared like long strings
+////////////////////////////////////////////////////////////////////////////////
+
+static int CompareCompressedStrings (TRI_shaped_json_t left,
+                                     TRI_shape_t const* leftShape,
+                                     TRI_shaper_t* leftShaper,
+                                     TRI_shaped_json_t right,
+                                     TRI_shape_t const* rightShape,
+                                     TRI_shaper_t* rightShaper) {
+  char* leftString = nullptr;
+  char* rightString = nullptr;
+  bool ok = true;
+
+  if (leftShape->_type == TRI_SHAPE_COMPRESSED_STRING) {
+    size_t const length = TRI_LengthCompressedStringShapedJson(left._data.data);
+    leftString = TRI_UncompressLongStringShapedJson(TRI_UNKNOWN_MEM_ZONE, left._data.data);
+    ok = (leftString != nullptr);
+
+    left._sid = BasicShapes::TRI_SHAPE_SID_LONG_STRING;
+    left._data.data = leftString;
+    left._data.length = (uint32_t) (sizeof(TRI_shape_length_long_string_t) + length);
+  }
+
+  if (ok && rightShape->_type == TRI_SHAPE_COMPRESSED_STRING) {
+    size_t const length = TRI_LengthCompressedStringShapedJson(right._data.data);
+    rightString = TRI_UncompressLongStringShapedJson(TRI_UNKNOWN_MEM_ZONE, right._data.data);
+    ok = (rightString != nullptr);
+
+    right._sid = BasicShapes::TRI_SHAPE_SID_LONG_STRING;
+    right._data.data = rightString;
+    right._data.length = (uint32_t) (sizeof(TRI_shape_length_long_string_t) + length);
+  }
+
+  int result = -1;
+
+  if (ok) {
+    result = TRI_CompareShapeTypes(nullptr,
+                                   nullptr,
+                                   &left,
+                                   leftShaper,
+                                   nullptr,
+                                   nullptr,
+                                   &right,
+                                   rightShaper);
+  }
+
+  if (leftString != nullptr) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, leftString);
+  }
+
+  if (rightString != nullptr) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, rightString);
+  }
+
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief compares two shapes
 ///
@@ -1210,6 +1271,10 @@ int TRI_CompareShapeTypes (char const* leftDocument,
   TRI_shape_type_t leftType   = leftShape->_type;
   TRI_shape_type_t rightType  = rightShape->_type;
 
+  if (leftType == TRI_SHAPE_COMPRESSED_STRING || rightType == TRI_SHAPE_COMPRESSED_STRING) {
+    return CompareCompressedStrings(left, leftShape, leftShaper, right, rightShape, rightShaper);
+  }
+
   // ...........................................................................
   // check ALL combinations of leftType and rightType
   // ...........................................................................
@@ -1588,6 +1653,154 @@ int TRI_CompareShapeTypes (char const* leftDocument,
   return 0; //shut the vc++ up
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes a binary key for a shape into buffer
+///
+/// the type byte comes first, so values of different types are ordered as in
+/// TRI_CompareShapeTypes. booleans and numbers have a fixed length, strings
+/// use the zero-terminated collator sort key. lists and arrays are compared
+/// recursively by TRI_CompareShapeTypes, so their key is just the type
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_NormalizeShapeType (TRI_shaped_json_t const* value,
+                               TRI_shaper_t* shaper,
+                               uint8_t* buffer,
+                               size_t size,
+                               bool& complete) {
+  complete = false;
+
+  if (size == 0) {
+    return 0;
+  }
+
+  TRI_shape_t const* shape = shaper->lookupShapeId(shaper, value->_sid);
+
+  if (shape == nullptr) {
+    return 0;
+  }
+
+  switch (shape->_type) {
+    case TRI_SHAPE_ILLEGAL: {
+      buffer[0] = 0x01;
+      complete = true;
+      return 1;
+    }
+
+    case TRI_SHAPE_NULL: {
+      buffer[0] = 0x02;
+      complete = true;
+      return 1;
+    }
+
+    case TRI_SHAPE_BOOLEAN: {
+      buffer[0] = 0x03;
+
+      if (size < 2) {
+        return 1;
+      }
+
+      buffer[1] = *((TRI_shape_boolean_t*) value->_data.data) ? 0x01 : 0x00;
+      complete = true;
+      return 2;
+    }
+
+    case TRI_SHAPE_NUMBER: {
+      buffer[0] = 0x04;
+
+      TRI_shape_number_t number = *((TRI_shape_number_t*) value->_data.data);
+
+      if (number == 0.0) {
+        // -0.0 and 0.0 are equal
+        number = 0.0;
+      }
+
+      uint64_t bits;
+      memcpy(&bits, &number, sizeof(bits));
+
+      // flip the sign bit of positive numbers and all bits of negative
+      // numbers, so the big-endian bytes compare like the numbers
+      if (bits & (1ULL << 63)) {
+        bits = ~bits;
+      }
+      else {
+        bits |= (1ULL << 63);
+      }
+
+      size_t n = 1;
+
+      for (int shift = 56; shift >= 0 && n < size; shift -= 8) {
+        buffer[n++] = (uint8_t) (bits >> shift);
+      }
+
+      complete = (n == 1 + sizeof(bits));
+      return n;
+    }
+
+    case TRI_SHAPE_SHORT_STRING:
+    case TRI_SHAPE_LONG_STRING: {
+      buffer[0] = 0x05;
+
+      char const* s;
+      size_t length;
+
+      if (shape->_type == TRI_SHAPE_SHORT_STRING) {
+        s = (char const*) (sizeof(TRI_shape_length_short_string_t) + value->_data.data);
+        length = (size_t) *((TRI_shape_length_short_string_t*) value->_data.data) - 1;
+      }
+      else {
+        s = (char const*) (sizeof(TRI_shape_length_long_string_t) + value->_data.data);
+        length = (size_t) *((TRI_shape_length_long_string_t*) value->_data.data) - 1;
+      }
+
+      size_t const keyLength = triagens::basics::Utf8Helper::DefaultUtf8Helper.sortKeyUtf8(s, length, buffer + 1, size - 1);
+
+      if (keyLength == 0) {
+        // no collator, leave the comparison to TRI_CompareShapeTypes
+        return 1;
+      }
+
+      if (keyLength > size - 1) {
+        return size;
+      }
+
+      complete = true;
+      return 1 + keyLength;
+    }
+
+    case TRI_SHAPE_COMPRESSED_STRING: {
+      // normalize the uncompressed string
+      TRI_shaped_json_t uncompressed;
+      uncompressed._sid = BasicShapes::TRI_SHAPE_SID_LONG_STRING;
+      uncompressed._data.length = (uint32_t) (sizeof(TRI_shape_length_long_string_t) + TRI_LengthCompressedStringShapedJson(value->_data.data));
+      uncompressed._data.data = TRI_UncompressLongStringShapedJson(TRI_UNKNOWN_MEM_ZONE, value->_data.data);
+
+      if (uncompressed._data.data == nullptr) {
+        buffer[0] = 0x05;
+        return 1;
+      }
+
+      size_t const n = TRI_NormalizeShapeType(&uncompressed, shaper, buffer, size, complete);
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, uncompressed._data.data);
+
+      return n;
+    }
+
+    case TRI_SHAPE_HOMOGENEOUS_LIST:
+    case TRI_SHAPE_HOMOGENEOUS_SIZED_LIST:
+    case TRI_SHAPE_LIST: {
+      buffer[0] = 0x06;
+      return 1;
+    }
+
+    case TRI_SHAPE_ARRAY: {
+      buffer[0] = 0x07;
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
 void TRI_InspectShapedSub (TRI_shaped_sub_t const* element,
                            char const* shapedJson,
                            TRI_shaped_json_t& shaped) {
@@ -134,6 +134,23 @@ int TRI_CompareShapeTypes (char const* leftDocument,
                            TRI_shaped_json_t const* rightShaped,
                            TRI_shaper_t* rightShaper);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes a binary key for a shape into buffer
+///
+/// the keys of two values compare with memcmp in the same order as
+/// TRI_CompareShapeTypes compares the values, as long as neither key is cut
+/// off. at most size bytes are written, and the number of bytes written is
+/// returned. complete is set to false if the key of another value must not
+/// be appended, i.e. if the key was truncated or the value is a list or an
+/// array, whose keys only consist of their type
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_NormalizeShapeType (TRI_shaped_json_t const* value,
+                               TRI_shaper_t* shaper,
+                               uint8_t* buffer,
+                               size_t size,
+                               bool& complete);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief extracts the shape identifier pointer from a marker
 ////////////////////////////////////////////////////////////////////////////////
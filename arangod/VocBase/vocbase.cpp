@@ -223,6 +223,9 @@ static bool UnregisterCollection (TRI_vocbase_t* vocbase,
 
   TRI_WRITE_UNLOCK_COLLECTIONS_VOCBASE(vocbase);
 
+  // cached plans may refer to the collection
+  TRI_InvalidatePlanCacheVocBase(vocbase);
+
   return true;
 }
 
@@ -2294,6 +2297,10 @@ int TRI_RenameCollectionVocBase (TRI_vocbase_t* vocbase,
 
   TRI_ReadUnlockReadWriteLock(&vocbase->_inventoryLock);
 
+  if (res == TRI_ERROR_NO_ERROR) {
+    TRI_InvalidatePlanCacheVocBase(vocbase);
+  }
+
   TRI_FreeString(TRI_CORE_MEM_ZONE, oldName);
 
   return res;
@@ -2538,6 +2545,18 @@ TRI_voc_tick_t TRI_NextQueryIdVocBase (TRI_vocbase_t* vocbase) {
   return QueryId.fetch_add(1, std::memory_order_seq_cst);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes all cached query plans of a database
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_InvalidatePlanCacheVocBase (TRI_vocbase_t* vocbase) {
+  auto queryList = static_cast<triagens::aql::QueryList*>(vocbase->_queries);
+
+  if (queryList != nullptr) {
+    queryList->planCache()->invalidate();
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -655,6 +655,13 @@ bool TRI_IsAllowedNameVocBase (bool,
 
 TRI_voc_tick_t TRI_NextQueryIdVocBase (TRI_vocbase_t*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes all cached query plans of a database, called when a
+/// collection or an index is created or dropped
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_InvalidatePlanCacheVocBase (TRI_vocbase_t*);
+
 #endif
 
 // -----------------------------------------------------------------------------
@@ -29,7 +29,9 @@
 
 #include "CollectorThread.h"
 
+#include "Basics/Barrier.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/ThreadPool.h"
 #include "Basics/hashes.h"
 #include "Basics/logging.h"
 #include "Basics/ConditionLocker.h"
@@ -282,7 +284,8 @@ uint64_t const CollectorThread::Interval = 1000000;
 ////////////////////////////////////////////////////////////////////////////////
 
 CollectorThread::CollectorThread (LogfileManager* logfileManager,
-                                  TRI_server_t* server)
+                                  TRI_server_t* server,
+                                  size_t numThreads)
   : Thread("WalCollector"),
     _logfileManager(logfileManager),
     _server(server),
@@ -290,9 +293,15 @@ CollectorThread::CollectorThread (LogfileManager* logfileManager,
     _operationsQueueLock(),
     _operationsQueue(),
     _operationsQueueInUse(false),
+    _numPartitions(numThreads > 0 ? numThreads : 1),
+    _workerPool(nullptr),
     _stop(0),
     _numPendingOperations(0) {
 
+  if (_numPartitions > 1) {
+    _workerPool = new triagens::basics::ThreadPool(_numPartitions - 1, "WalCollectorWorker");
+  }
+
   allowAsynchronousCancelation();
 }
 
@@ -301,6 +310,7 @@ CollectorThread::CollectorThread (LogfileManager* logfileManager,
 ////////////////////////////////////////////////////////////////////////////////
 
 CollectorThread::~CollectorThread () {
+  delete _workerPool;
 }
 
 // -----------------------------------------------------------------------------
@@ -456,92 +466,166 @@ bool CollectorThread::processQueuedOperations () {
 
   // go on without the mutex!
 
-  // process operations for each collection
-  for (auto it = _operationsQueue.begin(); it != _operationsQueue.end(); ++it) {
-    auto& operations = (*it).second;
-    TRI_ASSERT(! operations.empty());
-
-    for (auto it2 = operations.begin(); it2 != operations.end(); /* no hoisting */ ) {
-      Logfile* logfile = (*it2)->logfile;
-
-      int res = TRI_ERROR_INTERNAL;
-
-      try {
-        res = processCollectionOperations((*it2));
-      }
-      catch (triagens::basics::Exception const& ex) {
-        res = ex.code();
+  // process operations for each collection. the collections are spread over
+  // the partitions, so the operations of a collection are still processed in
+  // order by a single thread. the map itself is not modified here
+  executePartitioned([this] (size_t partition) -> void {
+    for (auto it = _operationsQueue.begin(); it != _operationsQueue.end(); ++it) {
+      if (this->partition((*it).first) == partition) {
+        processCollectionQueue((*it).second);
       }
+    }
+  });
 
-      if (res == TRI_ERROR_LOCK_TIMEOUT) {
-        // could not acquire write-lock for collection in time
-        // do not delete the operations
-        ++it2;
-        continue;
-      }
+  // finally remove all entries from the map with empty vectors
+  {
+    MUTEX_LOCKER(_operationsQueueLock);
 
-      if (res == TRI_ERROR_NO_ERROR) {
-        LOG_TRACE("queued operations applied successfully");
-      }
-      else if (res == TRI_ERROR_ARANGO_DATABASE_NOT_FOUND ||
-               res == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
-        // these are expected errors
-        LOG_TRACE("removing queued operations for already deleted collection");
-        res = TRI_ERROR_NO_ERROR;
+    for (auto it = _operationsQueue.begin(); it != _operationsQueue.end(); /* no hoisting */) {
+      if ((*it).second.empty()) {
+        it = _operationsQueue.erase(it);
       }
       else {
-        LOG_WARNING("got unexpected error code while applying queued operations: %s", TRI_errno_string(res));
+        ++it;
       }
+    }
 
-      if (res == TRI_ERROR_NO_ERROR) {
-        uint64_t numOperations = (*it2)->operations->size();
-        uint64_t maxNumPendingOperations = _logfileManager->throttleWhenPending();
-
-        if (maxNumPendingOperations > 0 && 
-            _numPendingOperations >= maxNumPendingOperations &&
-            (_numPendingOperations - numOperations) < maxNumPendingOperations) {
-          // write-throttling was active, but can be turned off now
-          _logfileManager->deactivateWriteThrottling();
-          LOG_INFO("deactivating write-throttling");
-        }
+    // the queue can now be used by others, too
+    _operationsQueueInUse = false;
+  }
+
+  return true;
+}
 
-        _numPendingOperations -= numOperations;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the queued operations of a single collection
+////////////////////////////////////////////////////////////////////////////////
 
-        // delete the object
-        delete (*it2);
+void CollectorThread::processCollectionQueue (std::vector<CollectorCache*>& operations) {
+  TRI_ASSERT(! operations.empty());
 
-        // delete the element from the vector while iterating over the vector
-        it2 = operations.erase(it2);
+  for (auto it2 = operations.begin(); it2 != operations.end(); /* no hoisting */ ) {
+    Logfile* logfile = (*it2)->logfile;
 
-        _logfileManager->decreaseCollectQueueSize(logfile);
-      }
-      else {
-        // do not delete the object but advance in the operations vector
-        ++it2;
+    int res = TRI_ERROR_INTERNAL;
+
+    try {
+      res = processCollectionOperations((*it2));
+    }
+    catch (triagens::basics::Exception const& ex) {
+      res = ex.code();
+    }
+    catch (...) {
+      res = TRI_ERROR_INTERNAL;
+    }
+
+    if (res == TRI_ERROR_LOCK_TIMEOUT) {
+      // could not acquire write-lock for collection in time
+      // do not delete the operations
+      ++it2;
+      continue;
+    }
+
+    if (res == TRI_ERROR_NO_ERROR) {
+      LOG_TRACE("queued operations applied successfully");
+    }
+    else if (res == TRI_ERROR_ARANGO_DATABASE_NOT_FOUND ||
+             res == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+      // these are expected errors
+      LOG_TRACE("removing queued operations for already deleted collection");
+      res = TRI_ERROR_NO_ERROR;
+    }
+    else {
+      LOG_WARNING("got unexpected error code while applying queued operations: %s", TRI_errno_string(res));
+    }
+
+    if (res == TRI_ERROR_NO_ERROR) {
+      uint64_t numOperations = (*it2)->operations->size();
+      uint64_t maxNumPendingOperations = _logfileManager->throttleWhenPending();
+
+      // other partitions may update the counter concurrently
+      uint64_t numPendingOperations = _numPendingOperations.fetch_sub(numOperations);
+
+      if (maxNumPendingOperations > 0 && 
+          numPendingOperations >= maxNumPendingOperations &&
+          (numPendingOperations - numOperations) < maxNumPendingOperations) {
+        // write-throttling was active, but can be turned off now
+        _logfileManager->deactivateWriteThrottling();
+        LOG_INFO("deactivating write-throttling");
       }
+
+      // delete the object
+      delete (*it2);
+
+      // delete the element from the vector while iterating over the vector
+      it2 = operations.erase(it2);
+
+      _logfileManager->decreaseCollectQueueSize(logfile);
     }
+    else {
+      // do not delete the object but advance in the operations vector
+      ++it2;
+    }
+  }
+}
 
-    // next collection
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the worker partition responsible for a collection
+////////////////////////////////////////////////////////////////////////////////
+
+size_t CollectorThread::partition (TRI_voc_cid_t cid) const {
+  if (_numPartitions == 1) {
+    return 0;
   }
 
-  // finally remove all entries from the map with empty vectors
-  {
-    MUTEX_LOCKER(_operationsQueueLock);
+  return static_cast<size_t>(TRI_FnvHashPointer(&cid, sizeof(TRI_voc_cid_t)) % _numPartitions);
+}
 
-    for (auto it = _operationsQueue.begin(); it != _operationsQueue.end(); /* no hoisting */) {
-      if ((*it).second.empty()) {
-        it = _operationsQueue.erase(it);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run the work for all partitions, using the worker pool, and wait
+/// until all partitions are done
+////////////////////////////////////////////////////////////////////////////////
+
+void CollectorThread::executePartitioned (std::function<void(size_t)> const& work) {
+  if (_workerPool == nullptr) {
+    work(0);
+    return;
+  }
+
+  // the collector thread may be cancelled asynchronously. it must not go away
+  // while the workers still use the data it handed out, so the cancellation
+  // is deferred until all partitions have joined the barrier
+  TRI_DisableCancelation();
+
+  // the work and the barrier are owned by all tasks together and not by the
+  // stack of this thread
+  auto sharedWork = std::make_shared<std::function<void(size_t)>>(work);
+  auto barrier = std::make_shared<triagens::basics::Barrier>(_numPartitions);
+
+  for (size_t i = 0;  i < _numPartitions;  ++i) {
+    if (i != (_numPartitions - 1)) {
+      auto task = [sharedWork, barrier, i] () -> void {
+        (*sharedWork)(i);
+        barrier->join();
+      };
+
+      try {
+        _workerPool->enqueue(task);
+        continue;
       }
-      else {
-        ++it;
+      catch (...) {
+        // fall back to doing the work in this thread
       }
     }
 
-    // the queue can now be used by others, too
-    _operationsQueueInUse = false;
+    (*sharedWork)(i);
+    barrier->join();
   }
 
-  return true;
+  // wait until all partitions are processed
+  barrier->synchronize();
+
+  TRI_EnableCancelation();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -738,103 +822,161 @@ int CollectorThread::collect (Logfile* logfile) {
   TRI_ASSERT(df != nullptr);
 
   // create a state for the collector, beginning with the list of failed transactions
-  CollectorState state;
-  state.failedTransactions = _logfileManager->getFailedTransactions();
+  // the state is shared with the workers of the partitions
+  auto state = std::make_shared<CollectorState>();
+  state->failedTransactions = _logfileManager->getFailedTransactions();
 /*
   if (_inRecovery) {
-    state.droppedCollections = _logfileManager->getDroppedCollections();
-    state.droppedDatabases   = _logfileManager->getDroppedDatabases();
+    state->droppedCollections = _logfileManager->getDroppedCollections();
+    state->droppedDatabases   = _logfileManager->getDroppedDatabases();
   }
 */
 
   // scan all markers in logfile, this will fill the state
-  bool result = TRI_IterateDatafile(df, &ScanMarker, static_cast<void*>(&state));
+  bool result = TRI_IterateDatafile(df, &ScanMarker, static_cast<void*>(state.get()));
 
   if (! result) {
     return TRI_ERROR_INTERNAL;
   }
 
   // get an aggregated list of all collection ids
-  std::set<TRI_voc_cid_t> collectionIds;
-  for (auto it = state.structuralOperations.begin(); it != state.structuralOperations.end(); ++it) {
+  auto collectionIds = std::make_shared<std::set<TRI_voc_cid_t>>();
+  for (auto it = state->structuralOperations.begin(); it != state->structuralOperations.end(); ++it) {
     auto cid = (*it).first;
 
-    if (! ShouldIgnoreCollection(&state, cid)) {
-      collectionIds.insert((*it).first);
+    if (! ShouldIgnoreCollection(state.get(), cid)) {
+      collectionIds->insert((*it).first);
     }
   }
 
-  for (auto it = state.documentOperations.begin(); it != state.documentOperations.end(); ++it) {
+  for (auto it = state->documentOperations.begin(); it != state->documentOperations.end(); ++it) {
     auto cid = (*it).first;
 
-    if (state.structuralOperations.find(cid) == state.structuralOperations.end() &&
-        ! ShouldIgnoreCollection(&state, cid)) {
-      collectionIds.insert(cid);
+    if (state->structuralOperations.find(cid) == state->structuralOperations.end() &&
+        ! ShouldIgnoreCollection(state.get(), cid)) {
+      collectionIds->insert(cid);
     }
   }
 
-  // now for each collection, write all surviving markers into collection datafiles
-  for (auto it = collectionIds.begin(); it != collectionIds.end(); ++it) {
-    auto cid = (*it);
-
-    OperationsType sortedOperations;
-
-    // insert structural operations - those are already sorted by tick
-    if (state.structuralOperations.find(cid) != state.structuralOperations.end()) {
-      OperationsType const& ops = state.structuralOperations[cid];
-
-      sortedOperations.insert(sortedOperations.begin(), ops.begin(), ops.end());
-      TRI_ASSERT_EXPENSIVE(sortedOperations.size() == ops.size());
-    }
+  // now for each collection, write all surviving markers into collection datafiles.
+  // the collections are spread over the partitions. the logfiles are still
+  // collected one after the other, so the markers of each collection are
+  // transferred in tick order
+  auto results = std::make_shared<std::vector<int>>(_numPartitions, TRI_ERROR_NO_ERROR);
 
-    // insert document operations - those are sorted by key, not by tick
-    if (state.documentOperations.find(cid) != state.documentOperations.end()) {
-      DocumentOperationsType const& ops = state.documentOperations[cid];
+  executePartitioned([this, logfile, state, collectionIds, results] (size_t partition) -> void {
+    for (auto it = collectionIds->begin(); it != collectionIds->end(); ++it) {
+      auto cid = (*it);
 
-
-      for (auto it2 = ops.begin(); it2 != ops.end(); ++it2) {
-        sortedOperations.push_back((*it2).second);
+      if (this->partition(cid) != partition) {
+        continue;
       }
 
-      // sort vector by marker tick
-      std::sort(sortedOperations.begin(), sortedOperations.end(), [] (TRI_df_marker_t const* left, TRI_df_marker_t const* right) {
-        return (left->_tick < right->_tick);
-      });
-    }
-
-    if (! sortedOperations.empty()) {
-      int res = TRI_ERROR_INTERNAL;
+      int res = collectCollection(logfile, state.get(), cid);
 
-      try {
-        res = transferMarkers(logfile, cid, state.collections[cid], state.operationsCount[cid], sortedOperations);
-      }
-      catch (triagens::basics::Exception const& ex) {
-        res = ex.code();
-      }
-      catch (...) {
-        res = TRI_ERROR_INTERNAL;
-      }
-
-      if (res != TRI_ERROR_NO_ERROR &&
-          res != TRI_ERROR_ARANGO_DATABASE_NOT_FOUND &&
-          res != TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
-        LOG_WARNING("got unexpected error in CollectorThread::collect: %s", TRI_errno_string(res));
+      if (res != TRI_ERROR_NO_ERROR) {
         // abort early
-        return res;
+        (*results)[partition] = res;
+        return;
       }
     }
+  });
+
+  for (auto res : *results) {
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
   }
 
   // TODO: what to do if an error has occurred?
 
   // remove all handled transactions from failedTransactions list
-  if (! state.handledTransactions.empty()) {
-    _logfileManager->unregisterFailedTransactions(state.handledTransactions);
+  if (! state->handledTransactions.empty()) {
+    _logfileManager->unregisterFailedTransactions(state->handledTransactions);
   }
   
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief transfer the markers of one collection found in a logfile
+////////////////////////////////////////////////////////////////////////////////
+
+int CollectorThread::collectCollection (Logfile* logfile,
+                                        CollectorState const* state,
+                                        TRI_voc_cid_t cid) {
+  OperationsType sortedOperations;
+
+  // insert structural operations - those are already sorted by tick
+  auto structural = state->structuralOperations.find(cid);
+
+  if (structural != state->structuralOperations.end()) {
+    OperationsType const& ops = (*structural).second;
+
+    sortedOperations.insert(sortedOperations.begin(), ops.begin(), ops.end());
+    TRI_ASSERT_EXPENSIVE(sortedOperations.size() == ops.size());
+  }
+
+  // insert document operations - those are sorted by key, not by tick
+  auto documents = state->documentOperations.find(cid);
+
+  if (documents != state->documentOperations.end()) {
+    DocumentOperationsType const& ops = (*documents).second;
+
+    for (auto it2 = ops.begin(); it2 != ops.end(); ++it2) {
+      sortedOperations.push_back((*it2).second);
+    }
+
+    // sort vector by marker tick
+    std::sort(sortedOperations.begin(), sortedOperations.end(), [] (TRI_df_marker_t const* left, TRI_df_marker_t const* right) {
+      return (left->_tick < right->_tick);
+    });
+  }
+
+  if (sortedOperations.empty()) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  // the state is shared between the partitions, so it must not be modified
+  TRI_voc_tick_t databaseId = 0;
+  auto database = state->collections.find(cid);
+
+  if (database != state->collections.end()) {
+    databaseId = (*database).second;
+  }
+
+  int64_t operationsCount = 0;
+  auto count = state->operationsCount.find(cid);
+
+  if (count != state->operationsCount.end()) {
+    operationsCount = (*count).second;
+  }
+
+  int res = TRI_ERROR_INTERNAL;
+
+  try {
+    res = transferMarkers(logfile, cid, databaseId, operationsCount, sortedOperations);
+  }
+  catch (triagens::basics::Exception const& ex) {
+    res = ex.code();
+  }
+  catch (...) {
+    res = TRI_ERROR_INTERNAL;
+  }
+
+  if (res == TRI_ERROR_ARANGO_DATABASE_NOT_FOUND ||
+      res == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+    // these are expected errors
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_WARNING("got unexpected error in CollectorThread::collect: %s", TRI_errno_string(res));
+  }
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief transfer markers into a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -1150,16 +1292,17 @@ int CollectorThread::queueOperations (triagens::wal::Logfile* logfile,
   
   uint64_t numOperations = cache->operations->size();
 
+  // other partitions may update the counter concurrently
+  uint64_t numPendingOperations = _numPendingOperations.fetch_add(numOperations);
+
   if (maxNumPendingOperations > 0 && 
-      _numPendingOperations < maxNumPendingOperations &&
-      (_numPendingOperations + numOperations) >= maxNumPendingOperations) {
+      numPendingOperations < maxNumPendingOperations &&
+      (numPendingOperations + numOperations) >= maxNumPendingOperations) {
     // activate write-throttling!
     _logfileManager->activateWriteThrottling();
     LOG_WARNING("queued more than %llu pending WAL collector operations. now activating write-throttling", 
                 (unsigned long long) maxNumPendingOperations);
   }
-  
-  _numPendingOperations += numOperations;
 
   // we have put the object into the queue successfully
   // now set the original pointer to null so it isn't double-freed
@@ -1399,14 +1542,12 @@ void CollectorThread::finishMarker (char const* walPosition,
   // re-use the original WAL marker's tick
   marker->_tick = tick;
 
-  // calculate the CRC
-  TRI_voc_crc_t crc = TRI_InitialCrc32();
-  crc = TRI_BlockCrc32(crc, const_cast<char*>(datafilePosition), marker->_size);
-  marker->_crc = TRI_FinalCrc32(crc);
-
   TRI_datafile_t* datafile = cache->lastDatafile;
   TRI_ASSERT(datafile != nullptr);
 
+  // calculate the CRC, using the checksum function of the target journal
+  marker->_crc = TRI_ChecksumMarkerDatafile(datafile->_version, marker);
+
   // update ticks
   TRI_UpdateTicksDatafile(datafile, marker);
 
@@ -39,13 +39,19 @@
 #include "VocBase/document-collection.h"
 #include "VocBase/voc-types.h"
 #include "Wal/Logfile.h"
+#include <functional>
 
+struct CollectorState;
 struct TRI_datafile_s;
 struct TRI_df_marker_s;
 struct TRI_document_collection_t;
 struct TRI_server_s;
 
 namespace triagens {
+  namespace basics {
+    class ThreadPool;
+  }
+
   namespace wal {
 
     class LogfileManager;
@@ -210,7 +216,8 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         CollectorThread (LogfileManager*,
-                         struct TRI_server_s*);
+                         struct TRI_server_s*,
+                         size_t);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the collector thread
@@ -254,6 +261,14 @@ namespace triagens {
 
         void signal ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of operations waiting to be processed
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t numPendingOperations () const {
+          return _numPendingOperations.load();
+        }
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    Thread methods
 // -----------------------------------------------------------------------------
@@ -296,6 +311,26 @@ namespace triagens {
 
         bool processQueuedOperations ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the queued operations of a single collection
+////////////////////////////////////////////////////////////////////////////////
+
+        void processCollectionQueue (std::vector<CollectorCache*>&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the worker partition responsible for a collection
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t partition (TRI_voc_cid_t) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run the work for all partitions, using the worker pool, and wait
+/// until all partitions are done. the work function must not throw, and all
+/// data it uses must be owned by it, not borrowed from the caller's stack
+////////////////////////////////////////////////////////////////////////////////
+
+        void executePartitioned (std::function<void(size_t)> const&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief process all operations for a single collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -308,6 +343,14 @@ namespace triagens {
 
         int collect (Logfile*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief transfer the markers of one collection found in a logfile
+////////////////////////////////////////////////////////////////////////////////
+
+        int collectCollection (Logfile*,
+                               CollectorState const*,
+                               TRI_voc_cid_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief transfer markers into a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -416,6 +459,20 @@ namespace triagens {
 
         bool _operationsQueueInUse;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of partitions the collections are spread over. each
+/// partition is handled by one thread at a time
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t const _numPartitions;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pool of worker threads. the collector thread itself handles the
+/// last partition, so the pool has one thread less than there are partitions
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::ThreadPool* _workerPool;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief stop flag
 ////////////////////////////////////////////////////////////////////////////////
@@ -426,7 +483,7 @@ namespace triagens {
 /// @brief number of pending operations in collector queue
 ////////////////////////////////////////////////////////////////////////////////
 
-        uint64_t _numPendingOperations;
+        std::atomic<uint64_t> _numPendingOperations;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief wait interval for the collector thread when idle
@@ -194,6 +194,19 @@ char* Logfile::reserve (size_t size) {
   return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief move the current write position forward to a position up to
+/// which space was reserved without calling reserve()
+////////////////////////////////////////////////////////////////////////////////
+
+void Logfile::advanceWritePosition (uint32_t position) {
+  TRI_ASSERT(position >= _df->_currentSize);
+  TRI_ASSERT(position <= allocatedSize());
+
+  _df->_next        = _df->_data + position;
+  _df->_currentSize = static_cast<TRI_voc_size_t>(position);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create a header marker
 ////////////////////////////////////////////////////////////////////////////////
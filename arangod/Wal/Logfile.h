@@ -206,6 +206,30 @@ namespace triagens {
           return static_cast<uint64_t>(allocatedSize() - _df->_currentSize - overhead());
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the current write position
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint32_t writePosition () const {
+          return static_cast<uint32_t>(_df->_currentSize);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the highest write position usable for markers
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint32_t maxWritePosition () const {
+          return static_cast<uint32_t>(allocatedSize() - overhead());
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the memory at the specified write position
+////////////////////////////////////////////////////////////////////////////////
+
+        inline char* memory (uint32_t position) const {
+          return _df->_data + position;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief whether or not a marker of the specified size can be written into
 /// the logfile
@@ -350,6 +374,13 @@ namespace triagens {
 
         char* reserve (size_t);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief move the current write position forward to a position up to
+/// which space was reserved without calling reserve()
+////////////////////////////////////////////////////////////////////////////////
+
+        void advanceWritePosition (uint32_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create a header marker
 ////////////////////////////////////////////////////////////////////////////////
@@ -74,6 +74,14 @@ static inline uint64_t MinSyncInterval () {
   return 5;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum value for --wal.collector-threads
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t MaxCollectorThreads () {
+  return 64;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief minimum value for --wal.logfile-size
 ////////////////////////////////////////////////////////////////////////////////
@@ -139,6 +147,7 @@ LogfileManager::LogfileManager (TRI_server_t* server,
     _syncInterval(100),
     _maxThrottleWait(15000),
     _throttleWhenPending(0),
+    _collectorThreads(2),
     _allowOversizeEntries(true),
     _ignoreLogfileErrors(false),
     _ignoreRecoveryErrors(false),
@@ -233,6 +242,7 @@ void LogfileManager::initialise (std::string* path,
 void LogfileManager::setupOptions (std::map<std::string, triagens::basics::ProgramOptionsDescription>& options) {
   options["Write-ahead log options:help-wal"]
     ("wal.allow-oversize-entries", &_allowOversizeEntries, "allow entries that are bigger than --wal.logfile-size")
+    ("wal.collector-threads", &_collectorThreads, "number of threads the WAL collector spreads the collections over")
     ("wal.directory", &_directory, "logfile directory")
     ("wal.historic-logfiles", &_historicLogfiles, "maximum number of historic logfiles to keep after collection")
     ("wal.ignore-logfile-errors", &_ignoreLogfileErrors, "ignore logfile errors. this will read recoverable data from corrupted logfiles but ignore any unrecoverable data")
@@ -302,6 +312,10 @@ bool LogfileManager::prepare () {
     LOG_FATAL_AND_EXIT("invalid value for --wal.throttle-when-pending. Please use a value of at least %llu", (unsigned long long) MinThrottleWhenPending());
   }
 
+  if (_collectorThreads < 1 || _collectorThreads > MaxCollectorThreads()) {
+    LOG_FATAL_AND_EXIT("invalid value for --wal.collector-threads. Please use a value between 1 and %lu", (unsigned long) MaxCollectorThreads());
+  }
+
   if (_syncInterval < MinSyncInterval()) {
     LOG_FATAL_AND_EXIT("invalid value for --wal.sync-interval. Please use a value of at least %llu", (unsigned long long) MinSyncInterval());
   }
@@ -833,6 +847,14 @@ SlotInfoCopy LogfileManager::allocateAndWrite (void* src,
     SlotInfoCopy copy(slotInfo.slot);
 
     finalise(slotInfo, waitForSync);
+
+    TRI_IF_FAILURE("LogfileManager::requireSyncedWrite") {
+      // a waitForSync write must not be acknowledged before it is synced
+      if (waitForSync && _slots->lastCommittedTick() < copy.tick) {
+        return SlotInfoCopy(TRI_ERROR_ARANGO_SYNC_TIMEOUT);
+      }
+    }
+
     return copy;
   }
   catch (...) {
@@ -867,6 +889,14 @@ SlotInfoCopy LogfileManager::allocateAndWrite (void* src,
     SlotInfoCopy copy(slotInfo.slot);
 
     finalise(slotInfo, waitForSync);
+
+    TRI_IF_FAILURE("LogfileManager::requireSyncedWrite") {
+      // a waitForSync write must not be acknowledged before it is synced
+      if (waitForSync && _slots->lastCommittedTick() < copy.tick) {
+        return SlotInfoCopy(TRI_ERROR_ARANGO_SYNC_TIMEOUT);
+      }
+    }
+
     return copy;
   }
   catch (...) {
@@ -1319,6 +1349,40 @@ Logfile* LogfileManager::getCollectableLogfile () {
   return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of sealed logfiles that are not yet collected
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t LogfileManager::numPendingLogfiles () {
+  uint64_t result = 0;
+
+  READ_LOCKER(_logfilesLock);
+
+  for (auto it = _logfiles.begin(); it != _logfiles.end(); ++it) {
+    Logfile* logfile = (*it).second;
+
+    if (logfile != nullptr &&
+        (logfile->status() == Logfile::StatusType::SEALED ||
+         logfile->status() == Logfile::StatusType::COLLECTION_REQUESTED)) {
+      ++result;
+    }
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of operations waiting for the collector
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t LogfileManager::numPendingCollectorOperations () {
+  if (_collectorThread == nullptr) {
+    return 0;
+  }
+
+  return _collectorThread->numPendingOperations();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a logfile to remove. this may return nullptr
 ////////////////////////////////////////////////////////////////////////////////
@@ -1770,7 +1834,7 @@ void LogfileManager::stopAllocatorThread () {
 ////////////////////////////////////////////////////////////////////////////////
 
 int LogfileManager::startCollectorThread () {
-  _collectorThread = new CollectorThread(this, _server);
+  _collectorThread = new CollectorThread(this, _server, _collectorThreads);
 
   if (_collectorThread == nullptr) {
     return TRI_ERROR_INTERNAL;
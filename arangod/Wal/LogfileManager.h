@@ -363,6 +363,26 @@ namespace triagens {
           }
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the value of --wal.collector-threads
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint32_t collectorThreads () const {
+          return _collectorThreads;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of sealed logfiles that are not yet collected
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t numPendingLogfiles ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of operations waiting for the collector
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t numPendingCollectorOperations ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief registers a transaction
 ////////////////////////////////////////////////////////////////////////////////
@@ -954,6 +974,21 @@ namespace triagens {
 
         uint64_t _throttleWhenPending;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of WAL collector threads
+/// @startDocuBlock WalLogfileCollectorThreads
+/// `--wal.collector-threads`
+///
+/// The number of threads the write-ahead log garbage collector uses for
+/// transferring operations into the collection datafiles. Each collection is
+/// handled by one thread at a time, so the operations of a collection are
+/// still applied in order. More threads help if there are write operations
+/// on many collections at the same time. The default value is *2*.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t _collectorThreads;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief whether or not oversize entries are allowed
 /// @startDocuBlock WalLogfileAllowOversizeEntries
@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Write-ahead log lock-free slot and space reservations
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_WAL_RESERVATIONS_H
+#define ARANGODB_WAL_RESERVATIONS_H 1
+
+#include "Basics/Common.h"
+
+namespace triagens {
+  namespace wal {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class Reservations
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the handout position of the slot ring and the write position in
+/// the current logfile, packed into a single atomic value
+///
+/// writers reserve a slot and the space for their marker with a single
+/// compare-and-swap on this value. whatever must be ordered with the
+/// reservation (e.g. fetching a tick) is done between reading the value and
+/// the compare-and-swap: if the compare-and-swap succeeds, nothing else was
+/// reserved in between.
+///
+/// switching the logfile locks the reservations, so all writers fall back to
+/// the slow path until the new logfile is published by unlock().
+////////////////////////////////////////////////////////////////////////////////
+
+    class Reservations {
+
+      private:
+
+        Reservations (Reservations const&) = delete;
+        Reservations& operator= (Reservations const&) = delete;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     public consts
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief write position value for locked reservations
+////////////////////////////////////////////////////////////////////////////////
+
+        static uint32_t const LockedOffset = UINT32_MAX;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                      constructors and destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the reservations for a ring with the specified number of
+/// slots. the reservations are locked initially
+////////////////////////////////////////////////////////////////////////////////
+
+        explicit Reservations (size_t numberOfSlots)
+          : _numberOfSlots(static_cast<uint32_t>(numberOfSlots)),
+            _maxPosition((UINT32_MAX / static_cast<uint32_t>(numberOfSlots)) * static_cast<uint32_t>(numberOfSlots)),
+            _state(Pack(0, LockedOffset)) {
+
+          TRI_ASSERT(numberOfSlots > 0 && numberOfSlots < UINT32_MAX);
+        }
+
+        ~Reservations () {
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reserve the next slot and size bytes of the logfile
+///
+/// commit is called with the slot index and the write position right before
+/// the compare-and-swap. it must check whether there is enough space left.
+/// if it returns false, nothing is reserved. returns false if the
+/// reservations are locked or commit returned false
+////////////////////////////////////////////////////////////////////////////////
+
+        template<typename F>
+        bool tryReserve (uint32_t size,
+                         F const& commit,
+                         size_t& slotIndex,
+                         uint32_t& offset) {
+          uint64_t state = _state.load(std::memory_order_acquire);
+
+          while (true) {
+            uint32_t const position = Position(state);
+            offset = Offset(state);
+
+            if (offset == LockedOffset) {
+              return false;
+            }
+
+            slotIndex = static_cast<size_t>(position % _numberOfSlots);
+
+            if (! commit(slotIndex, offset)) {
+              return false;
+            }
+
+            if (_state.compare_exchange_weak(state, Pack(next(position), offset + size),
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+              return true;
+            }
+          }
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lock the reservations. returns the handout position and the write
+/// position, which is LockedOffset if there was no logfile
+///
+/// must only be called by one thread at a time, i.e. under a mutex
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t lock (uint32_t& offset) {
+          uint64_t state = _state.load(std::memory_order_acquire);
+
+          while (! _state.compare_exchange_weak(state, Pack(Position(state), LockedOffset),
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+          }
+
+          offset = Offset(state);
+          return Position(state);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief publish new handout and write positions. an offset of LockedOffset
+/// keeps the reservations locked
+////////////////////////////////////////////////////////////////////////////////
+
+        void unlock (uint32_t position,
+                     uint32_t offset) {
+          _state.store(Pack(position, offset), std::memory_order_release);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the current handout position
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t position () const {
+          return Position(_state.load(std::memory_order_acquire));
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the current write position, or LockedOffset
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t offset () const {
+          return Offset(_state.load(std::memory_order_acquire));
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the slot index for a handout position
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t slotIndex (uint32_t position) const {
+          return static_cast<size_t>(position % _numberOfSlots);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the handout position following the specified one
+///
+/// positions wrap around at a multiple of the number of slots, so the slot
+/// index always advances by one
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t next (uint32_t position) const {
+          if (++position >= _maxPosition) {
+            return 0;
+          }
+          return position;
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+        static inline uint64_t Pack (uint32_t position,
+                                     uint32_t offset) {
+          return (static_cast<uint64_t>(position) << 32) | static_cast<uint64_t>(offset);
+        }
+
+        static inline uint32_t Position (uint64_t state) {
+          return static_cast<uint32_t>(state >> 32);
+        }
+
+        static inline uint32_t Offset (uint64_t state) {
+          return static_cast<uint32_t>(state & 0xffffffffULL);
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of slots in the ring
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t const _numberOfSlots;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief handout positions wrap around at this value
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t const _maxPosition;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief handout position (upper 32 bits) and write position (lower 32 bits)
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _state;
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -147,7 +147,7 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         inline bool isUnused () const {
-          return _status == StatusType::UNUSED;
+          return _status.load(std::memory_order_acquire) == StatusType::UNUSED;
         }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -155,7 +155,7 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         inline bool isUsed () const {
-          return _status == StatusType::USED;
+          return _status.load(std::memory_order_acquire) == StatusType::USED;
         }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -163,8 +163,9 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         inline bool isReturned () const {
-          return (_status == StatusType::RETURNED ||
-                  _status == StatusType::RETURNED_WFS);
+          StatusType const status = _status.load(std::memory_order_acquire);
+          return (status == StatusType::RETURNED ||
+                  status == StatusType::RETURNED_WFS);
         }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -172,7 +173,7 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         inline bool waitForSync () const {
-          return (_status == StatusType::RETURNED_WFS);
+          return (_status.load(std::memory_order_acquire) == StatusType::RETURNED_WFS);
         }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -231,10 +232,11 @@ namespace triagens {
         uint32_t _size;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief slot status
+/// @brief slot status. writers publish a slot by changing its status, so
+/// the other members are visible to whoever sees the new status
 ////////////////////////////////////////////////////////////////////////////////
 
-        StatusType _status;
+        std::atomic<StatusType> _status;
 
     };
 
@@ -54,15 +54,17 @@ Slots::Slots (LogfileManager* logfileManager,
     _lock(),
     _slots(new Slot[numberOfSlots]),
     _numberOfSlots(numberOfSlots),
-    _freeSlots(numberOfSlots),
     _waiting(0),
-    _handoutIndex(0),
+    _reservations(numberOfSlots),
+    _handoutPosition(0),
     _recycleIndex(0),
     _logfile(nullptr),
-    _lastAssignedTick(0),
+    _activeLogfile(nullptr),
     _lastCommittedTick(0),
     _lastCommittedDataTick(0),
-    _numEvents(0)  {
+    _numEvents(0),
+    _numUsedSlots(0),
+    _numSyncWaiters(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -127,119 +129,27 @@ int Slots::flush (bool waitForSync) {
 ////////////////////////////////////////////////////////////////////////////////
 
 Slot::TickType Slots::lastCommittedTick () {
-  MUTEX_LOCKER(_lock);
-  return _lastCommittedTick;
+  return _lastCommittedTick.load();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief return the next unused slot
+/// @brief return the number of slots that are handed out but not yet
+/// returned, and the number of threads waiting for their slots to be synced
 ////////////////////////////////////////////////////////////////////////////////
 
-SlotInfo Slots::nextUnused (uint32_t size) {
-  // we need to use the aligned size for writing
-  uint32_t alignedSize = TRI_DF_ALIGN_BLOCK(size);
-  int iterations = 0;
-  bool hasWaited = false;
-
-  TRI_ASSERT(size > 0);
-
-  while (++iterations < 1000) {
-    {
-      MUTEX_LOCKER(_lock);
-
-      Slot* slot = &_slots[_handoutIndex];
-      TRI_ASSERT(slot != nullptr);
-
-      if (slot->isUnused()) {
-        if (hasWaited) {
-          CONDITION_LOCKER(guard, _condition);
-          TRI_ASSERT(_waiting > 0);
-          --_waiting;
-          hasWaited = false;
-        }
-
-        // cycle until we have a valid logfile
-        while (_logfile == nullptr ||
-               _logfile->freeSize() < static_cast<uint64_t>(alignedSize)) {
-
-          if (_logfile != nullptr) {
-            // seal existing logfile by creating a footer marker
-            int res = writeFooter(slot);
-
-            if (res != TRI_ERROR_NO_ERROR) {
-              return SlotInfo(res);
-            }
-
-            // advance to next slot
-            slot = &_slots[_handoutIndex];
-            _logfileManager->setLogfileSealRequested(_logfile);
-
-            _logfile = nullptr;
-          }
-
-          // fetch the next free logfile (this may create a new one)
-          Logfile::StatusType status = newLogfile(alignedSize);
-
-          if (_logfile == nullptr) {
-            usleep(10 * 1000);
-
-            TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
-              return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
-            }
-
-            // try again in next iteration
-          }
-          else if (status == Logfile::StatusType::EMPTY) {
-            // inititialise the empty logfile by writing a header marker
-            int res = writeHeader(slot);
-
-            if (res != TRI_ERROR_NO_ERROR) {
-              return SlotInfo(res);
-            }
-
-            // advance to next slot
-            slot = &_slots[_handoutIndex];
-            _logfileManager->setLogfileOpen(_logfile);
-          }
-          else {
-            TRI_ASSERT(status == Logfile::StatusType::OPEN);
-          }
-        }
-
-        // if we get here, we got a free slot for the actual data...
-
-        char* mem = _logfile->reserve(alignedSize);
-
-        if (mem == nullptr) {
-          return SlotInfo(TRI_ERROR_INTERNAL);
-        }
-
-        // only in this case we return a valid slot
-        slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout());
-
-        return SlotInfo(slot);
-      }
-    }
-
-    // if we get here, all slots are busy
-    CONDITION_LOCKER(guard, _condition);
-    if (! hasWaited) {
-      ++_waiting;
-      hasWaited = true;
-    }
-
-    bool mustWait;
-    {
-      MUTEX_LOCKER(_lock);
-      mustWait = (_freeSlots == 0);
-    }
+void Slots::groupCommitState (uint32_t& numUsedSlots,
+                              uint32_t& numSyncWaiters) {
+  numUsedSlots   = _numUsedSlots;
+  numSyncWaiters = _numSyncWaiters;
+}
 
-    if (mustWait) {
-      guard.wait(10 * 1000);
-    }
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the next unused slot
+////////////////////////////////////////////////////////////////////////////////
 
-  return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
+SlotInfo Slots::nextUnused (uint32_t size) {
+  void* oldLegend = nullptr;
+  return reserveSlot(size, false, 0, 0, 0, oldLegend);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -255,125 +165,7 @@ SlotInfo Slots::nextUnused (uint32_t size,
                             uint32_t legendOffset,
                             void*& oldLegend) {
                             // legendOffset 0 means no legend included
-  // we need to use the aligned size for writing
-  uint32_t alignedSize = TRI_DF_ALIGN_BLOCK(size);
-  int iterations = 0;
-  bool hasWaited = false;
-
-  TRI_ASSERT(size > 0);
-
-  while (++iterations < 1000) {
-    {
-      MUTEX_LOCKER(_lock);
-
-      Slot* slot = &_slots[_handoutIndex];
-      TRI_ASSERT(slot != nullptr);
-
-      if (slot->isUnused()) {
-        if (hasWaited) {
-          CONDITION_LOCKER(guard, _condition);
-          TRI_ASSERT(_waiting > 0);
-          --_waiting;
-          hasWaited = false;
-        }
-
-        // cycle until we have a valid logfile
-        while (_logfile == nullptr ||
-               _logfile->freeSize() < static_cast<uint64_t>(alignedSize)) {
-
-          if (_logfile != nullptr) {
-            // seal existing logfile by creating a footer marker
-            int res = writeFooter(slot);
-
-            if (res != TRI_ERROR_NO_ERROR) {
-              return SlotInfo(res);
-            }
-
-            // advance to next slot
-            slot = &_slots[_handoutIndex];
-            _logfileManager->setLogfileSealRequested(_logfile);
-
-            _logfile = nullptr;
-          }
-
-          // fetch the next free logfile (this may create a new one)
-          Logfile::StatusType status = newLogfile(alignedSize);
-
-          if (_logfile == nullptr) {
-            usleep(10 * 1000);
-
-            TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
-              return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
-            }
-
-            // try again in next iteration
-          }
-          else if (status == Logfile::StatusType::EMPTY) {
-            // inititialise the empty logfile by writing a header marker
-            int res = writeHeader(slot);
-
-            if (res != TRI_ERROR_NO_ERROR) {
-              return SlotInfo(res);
-            }
-
-            // advance to next slot
-            slot = &_slots[_handoutIndex];
-            _logfileManager->setLogfileOpen(_logfile);
-          }
-          else {
-            TRI_ASSERT(status == Logfile::StatusType::OPEN);
-          }
-        }
-
-        // if we get here, we got a free slot for the actual data...
-        
-        // Now sort out the legend business:
-        if (legendOffset == 0) {
-          void* legend = _logfile->lookupLegend(cid, sid);
-          if (nullptr == legend) {
-            // Bad, we would need a legend for this marker
-            return SlotInfo(TRI_ERROR_LEGEND_NOT_IN_WAL_FILE);
-          }
-          oldLegend = legend;
-        }
-
-        char* mem = _logfile->reserve(alignedSize);
-
-        if (mem == nullptr) {
-          return SlotInfo(TRI_ERROR_INTERNAL);
-        }
-
-        if (legendOffset != 0) {
-          void* legend = static_cast<void*>(mem + legendOffset);
-          _logfile->cacheLegend(cid, sid, legend);
-        }
-
-        // only in this case we return a valid slot
-        slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout());
-
-        return SlotInfo(slot);
-      }
-    }
-
-    // if we get here, all slots are busy
-    CONDITION_LOCKER(guard, _condition);
-    if (! hasWaited) {
-      ++_waiting;
-      hasWaited = true;
-    }
-
-    bool mustWait;
-    {
-      MUTEX_LOCKER(_lock);
-      mustWait = (_freeSlots == 0);
-    }
-
-    if (mustWait) {
-      guard.wait(10 * 1000);
-    }
-  }
-
-  return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
+  return reserveSlot(size, true, cid, sid, legendOffset, oldLegend);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -387,16 +179,23 @@ void Slots::returnUsed (SlotInfo& slotInfo,
 
   TRI_ASSERT(tick > 0);
 
-  {
-    MUTEX_LOCKER(_lock);
-    slotInfo.slot->setReturned(waitForSync);
-    ++_numEvents;
+  if (waitForSync) {
+    ++_numSyncWaiters;
   }
 
+  // publishing the slot does not need the lock
+  slotInfo.slot->setReturned(waitForSync);
+  ++_numEvents;
+  --_numUsedSlots;
+
   _logfileManager->signalSync();
 
   if (waitForSync) {
+    // all waiters up to the last committed tick are woken by the same sync
     waitForTick(tick);
+
+    TRI_ASSERT(_numSyncWaiters > 0);
+    --_numSyncWaiters;
   }
 }
 
@@ -418,8 +217,9 @@ SyncRegion Slots::getSyncRegion () {
     if (! slot->isReturned()) {
       // found a slot that is not yet returned
       // if it belongs to another logfile, we can seal the logfile we created
-      // the region for
-      auto otherId = slot->logfileId();
+      // the region for. slots that are still unused may be in the middle
+      // of a lock-free handout, so we only look at used ones
+      auto otherId = (slot->isUsed() ? slot->logfileId() : 0);
       if (region.logfileId != 0 && otherId != 0 && 
           otherId != region.logfileId) {
         region.canSeal = true;
@@ -440,6 +240,7 @@ SyncRegion Slots::getSyncRegion () {
       region.firstSlotIndex = slotIndex;
       region.lastSlotIndex  = slotIndex;
       region.waitForSync    = slot->waitForSync();
+      region.numSyncWaiters = (slot->waitForSync() ? 1 : 0);
     }
     else {
       if (slot->logfileId() != region.logfileId) {
@@ -455,6 +256,10 @@ SyncRegion Slots::getSyncRegion () {
       region.size += (uint32_t) (static_cast<char*>(slot->mem()) - (region.mem + region.size) + slot->size());
       region.lastSlotIndex = slotIndex;
       region.waitForSync |= slot->waitForSync();
+
+      if (slot->waitForSync()) {
+        ++region.numSyncWaiters;
+      }
     }
 
     if (++slotIndex >= _numberOfSlots) {
@@ -489,7 +294,7 @@ void Slots::returnSyncRegion (SyncRegion const& region) {
       // note last tick
       Slot::TickType tick = slot->tick();
       TRI_ASSERT(tick >= _lastCommittedTick);
-      _lastCommittedTick = tick;
+      _lastCommittedTick.store(tick);
 
       // update the data tick
       TRI_df_marker_t const* m = static_cast<TRI_df_marker_t const*>(slot->mem());
@@ -503,7 +308,6 @@ void Slots::returnSyncRegion (SyncRegion const& region) {
       region.logfile->update(m);
 
       slot->setUnused();
-      ++_freeSlots;
 
       // update recycle index, too
       if (++_recycleIndex >= _numberOfSlots) {
@@ -542,6 +346,15 @@ void Slots::getActiveLogfileRegion (Logfile* logfile,
 
   begin = datafile->_data;
   end   = begin + datafile->_currentSize;
+
+  if (logfile == _activeLogfile.load()) {
+    // lock-free reservations are not yet reflected in the datafile
+    uint32_t const offset = _reservations.offset();
+
+    if (offset != Reservations::LockedOffset) {
+      end = begin + offset;
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -576,102 +389,400 @@ int Slots::closeLogfile (Slot::TickType& lastCommittedTick,
   worked = false;
 
   while (++iterations < 1000) {
+    int res = TRI_ERROR_NO_ERROR;
+    bool done = false;
+    bool busy = false;
+
     {
       MUTEX_LOCKER(_lock);
 
       lastCommittedTick = _lastCommittedTick;
 
-      Slot* slot = &_slots[_handoutIndex];
+      lockReservations();
+
+      Slot* slot = &_slots[_reservations.slotIndex(_handoutPosition)];
       TRI_ASSERT(slot != nullptr);
 
       if (slot->isUnused()) {
-        if (hasWaited) {
-          CONDITION_LOCKER(guard, _condition);
-          TRI_ASSERT(_waiting > 0);
-          --_waiting;
-          hasWaited = false;
-        }
-
-        if (_logfile != nullptr) {
-          if (_logfile->status() == Logfile::StatusType::EMPTY) {
-            // no need to seal a still-empty logfile
-            return TRI_ERROR_NO_ERROR;
-          }
-
-          // seal existing logfile by creating a footer marker
-          int res = writeFooter(slot);
-
-          if (res != TRI_ERROR_NO_ERROR) {
-            LOG_ERROR("could not write logfile footer: %s", TRI_errno_string(res));
-            return res;
-          }
-
-          _logfileManager->setLogfileSealRequested(_logfile);
-
-          // advance to next slot
-          slot = &_slots[_handoutIndex];
-
-          // invalidate the logfile so for the next write we'll use a
-          // new one
-          _logfile = nullptr;
-
-          // fall-through intentional
-        }
-
-        TRI_ASSERT(_logfile == nullptr);
-        // fetch the next free logfile (this may create a new one)
-        // note: as we don't have a real marker to write the size does
-        // not matter (we use a size of 1 as  it must be > 0)
-        Logfile::StatusType status = newLogfile(1);
-
-        if (_logfile == nullptr) {
-          TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
-            return TRI_ERROR_ARANGO_NO_JOURNAL;
-          }
-
-          usleep(10 * 1000);
-          // try again in next iteration
-        }
-        else if (status == Logfile::StatusType::EMPTY) {
-          // inititialise the empty logfile by writing a header marker
-          int res = writeHeader(slot);
-
-          if (res != TRI_ERROR_NO_ERROR) {
-            LOG_ERROR("could not write logfile header: %s", TRI_errno_string(res));
-            return res;
-          }
-
-          _logfileManager->setLogfileOpen(_logfile);
-          worked = true;
-          return TRI_ERROR_NO_ERROR;
-        }
-        else {
-          TRI_ASSERT(status == Logfile::StatusType::OPEN);
-          worked = false;
-          return TRI_ERROR_NO_ERROR;
-        }
+        res = closeLogfileLocked(slot, worked, done);
       }
+      else {
+        busy = true;
+      }
+
+      unlockReservations();
     }
 
-    // if we get here, all slots are busy
-    CONDITION_LOCKER(guard, _condition);
-    if (! hasWaited) {
-      ++_waiting;
-      hasWaited = true;
+    if (done) {
+      if (hasWaited) {
+        CONDITION_LOCKER(guard, _condition);
+        TRI_ASSERT(_waiting > 0);
+        --_waiting;
+      }
+
+      return res;
     }
 
-    bool mustWait;
-    {
+    if (busy) {
+      // if we get here, all slots are busy
+      waitForFreeSlot(hasWaited);
+    }
+  }
+
+  return TRI_ERROR_ARANGO_NO_JOURNAL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief close the logfile with the lock held and the reservations locked
+////////////////////////////////////////////////////////////////////////////////
+
+int Slots::closeLogfileLocked (Slot* slot,
+                               bool& worked,
+                               bool& done) {
+  done = true;
+
+  if (_logfile != nullptr) {
+    if (_logfile->status() == Logfile::StatusType::EMPTY) {
+      // no need to seal a still-empty logfile
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    // seal existing logfile by creating a footer marker
+    int res = writeFooter(slot);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_ERROR("could not write logfile footer: %s", TRI_errno_string(res));
+      return res;
+    }
+
+    _logfileManager->setLogfileSealRequested(_logfile);
+
+    // advance to next slot
+    slot = &_slots[_reservations.slotIndex(_handoutPosition)];
+
+    // invalidate the logfile so for the next write we'll use a
+    // new one
+    _logfile = nullptr;
+
+    // fall-through intentional
+  }
+
+  TRI_ASSERT(_logfile == nullptr);
+  // fetch the next free logfile (this may create a new one)
+  // note: as we don't have a real marker to write the size does
+  // not matter (we use a size of 1 as  it must be > 0)
+  Logfile::StatusType status = newLogfile(1);
+
+  if (_logfile == nullptr) {
+    TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
+      return TRI_ERROR_ARANGO_NO_JOURNAL;
+    }
+
+    usleep(10 * 1000);
+    // try again in next iteration
+    done = false;
+    return TRI_ERROR_NO_ERROR;
+  }
+  else if (status == Logfile::StatusType::EMPTY) {
+    // inititialise the empty logfile by writing a header marker
+    int res = writeHeader(slot);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_ERROR("could not write logfile header: %s", TRI_errno_string(res));
+      return res;
+    }
+
+    _logfileManager->setLogfileOpen(_logfile);
+    worked = true;
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  TRI_ASSERT(status == Logfile::StatusType::OPEN);
+  worked = false;
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the next unused slot, common implementation
+///
+/// writers first try to reserve a slot lock-free. only if the logfile is
+/// full, there is no logfile yet or all slots are busy, they acquire the
+/// lock
+////////////////////////////////////////////////////////////////////////////////
+
+SlotInfo Slots::reserveSlot (uint32_t size,
+                             bool useLegend,
+                             TRI_voc_cid_t cid,
+                             TRI_shape_sid_t sid,
+                             uint32_t legendOffset,
+                             void*& oldLegend) {
+  int iterations = 0;
+  bool hasWaited = false;
+
+  TRI_ASSERT(size > 0);
+
+  while (++iterations < 1000) {
+    int res = TRI_ERROR_NO_ERROR;
+    Slot* slot = tryReserveSlot(size, useLegend, cid, sid, legendOffset, oldLegend, res);
+
+    if (slot == nullptr && res == TRI_ERROR_NO_ERROR) {
       MUTEX_LOCKER(_lock);
-      mustWait = (_freeSlots == 0);
+
+      lockReservations();
+      res = reserveSlotLocked(size, useLegend, cid, sid, legendOffset, oldLegend, slot);
+      unlockReservations();
     }
 
-    if (mustWait) {
-      guard.wait(10 * 1000);
+    if (res != TRI_ERROR_NO_ERROR || slot != nullptr) {
+      if (hasWaited) {
+        CONDITION_LOCKER(guard, _condition);
+        TRI_ASSERT(_waiting > 0);
+        --_waiting;
+      }
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return SlotInfo(res);
+      }
+
+      // only in this case we return a valid slot
+      return SlotInfo(slot);
     }
+
+    // if we get here, all slots are busy
+    waitForFreeSlot(hasWaited);
   }
 
-  return TRI_ERROR_ARANGO_NO_JOURNAL;
+  return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief try to reserve the next slot without the lock
+///
+/// returns nullptr if the slow path must be taken. res is only set for
+/// errors that the slow path would report, too
+////////////////////////////////////////////////////////////////////////////////
+
+Slot* Slots::tryReserveSlot (uint32_t size,
+                             bool useLegend,
+                             TRI_voc_cid_t cid,
+                             TRI_shape_sid_t sid,
+                             uint32_t legendOffset,
+                             void*& oldLegend,
+                             int& res) {
+  // we need to use the aligned size for writing
+  uint32_t const alignedSize = TRI_DF_ALIGN_BLOCK(size);
+
+  Logfile* logfile = nullptr;
+  Slot::TickType tick = 0;
+
+  // called with the state of the reservations we try to advance. if the
+  // reservation succeeds, the logfile and the tick belong to this state
+  auto commit = [&] (size_t slotIndex, uint32_t offset) -> bool {
+    res = TRI_ERROR_NO_ERROR;
+
+    // this is the logfile of the reservations state, or any later state
+    // gets published, which will make the compare-and-swap fail
+    logfile = _activeLogfile.load();
+
+    if (logfile == nullptr ||
+        static_cast<uint64_t>(offset) + alignedSize > logfile->maxWritePosition()) {
+      // logfile must be switched
+      return false;
+    }
+
+    if (! _slots[slotIndex].isUnused()) {
+      // all slots are busy
+      return false;
+    }
+
+    if (useLegend && legendOffset == 0) {
+      void* legend = logfile->lookupLegend(cid, sid);
+
+      if (nullptr == legend) {
+        // Bad, we would need a legend for this marker
+        res = TRI_ERROR_LEGEND_NOT_IN_WAL_FILE;
+        return false;
+      }
+      oldLegend = legend;
+    }
+
+    // the tick must be fetched after reading the state, so the ticks of
+    // the slots increase in handout order
+    tick = static_cast<Slot::TickType>(TRI_NewTickServer());
+    return true;
+  };
+
+  size_t slotIndex;
+  uint32_t offset;
+
+  if (! _reservations.tryReserve(alignedSize, commit, slotIndex, offset)) {
+    return nullptr;
+  }
+
+  char* mem = logfile->memory(offset);
+
+  if (useLegend && legendOffset != 0) {
+    void* legend = static_cast<void*>(mem + legendOffset);
+    logfile->cacheLegend(cid, sid, legend);
+  }
+
+  Slot* slot = &_slots[slotIndex];
+  ++_numUsedSlots;
+  slot->setUsed(static_cast<void*>(mem), size, logfile->id(), tick);
+
+  return slot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reserve the next slot with the lock held and the reservations
+/// locked, switching the logfile if required
+///
+/// slot is set to nullptr if all slots are busy
+////////////////////////////////////////////////////////////////////////////////
+
+int Slots::reserveSlotLocked (uint32_t size,
+                              bool useLegend,
+                              TRI_voc_cid_t cid,
+                              TRI_shape_sid_t sid,
+                              uint32_t legendOffset,
+                              void*& oldLegend,
+                              Slot*& result) {
+  // we need to use the aligned size for writing
+  uint32_t const alignedSize = TRI_DF_ALIGN_BLOCK(size);
+
+  result = nullptr;
+
+  Slot* slot = &_slots[_reservations.slotIndex(_handoutPosition)];
+  TRI_ASSERT(slot != nullptr);
+
+  if (! slot->isUnused()) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  // cycle until we have a valid logfile
+  while (_logfile == nullptr ||
+         _logfile->freeSize() < static_cast<uint64_t>(alignedSize)) {
+
+    if (_logfile != nullptr) {
+      // seal existing logfile by creating a footer marker
+      int res = writeFooter(slot);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+
+      // advance to next slot
+      slot = &_slots[_reservations.slotIndex(_handoutPosition)];
+      _logfileManager->setLogfileSealRequested(_logfile);
+
+      _logfile = nullptr;
+    }
+
+    // fetch the next free logfile (this may create a new one)
+    Logfile::StatusType status = newLogfile(alignedSize);
+
+    if (_logfile == nullptr) {
+      usleep(10 * 1000);
+
+      TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
+        return TRI_ERROR_ARANGO_NO_JOURNAL;
+      }
+
+      // try again in next iteration
+    }
+    else if (status == Logfile::StatusType::EMPTY) {
+      // inititialise the empty logfile by writing a header marker
+      int res = writeHeader(slot);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+
+      // advance to next slot
+      slot = &_slots[_reservations.slotIndex(_handoutPosition)];
+      _logfileManager->setLogfileOpen(_logfile);
+    }
+    else {
+      TRI_ASSERT(status == Logfile::StatusType::OPEN);
+    }
+  }
+
+  // if we get here, we got a free slot for the actual data...
+
+  // Now sort out the legend business:
+  if (useLegend && legendOffset == 0) {
+    void* legend = _logfile->lookupLegend(cid, sid);
+    if (nullptr == legend) {
+      // Bad, we would need a legend for this marker
+      return TRI_ERROR_LEGEND_NOT_IN_WAL_FILE;
+    }
+    oldLegend = legend;
+  }
+
+  char* mem = _logfile->reserve(alignedSize);
+
+  if (mem == nullptr) {
+    return TRI_ERROR_INTERNAL;
+  }
+
+  if (useLegend && legendOffset != 0) {
+    void* legend = static_cast<void*>(mem + legendOffset);
+    _logfile->cacheLegend(cid, sid, legend);
+  }
+
+  slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout());
+  result = slot;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lock the reservations, so the logfile can be switched
+////////////////////////////////////////////////////////////////////////////////
+
+void Slots::lockReservations () {
+  uint32_t offset;
+  _handoutPosition = _reservations.lock(offset);
+
+  if (_logfile != nullptr && offset != Reservations::LockedOffset) {
+    // make the datafile reflect the lock-free reservations
+    _logfile->advanceWritePosition(offset);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief unlock the reservations and publish the current logfile
+////////////////////////////////////////////////////////////////////////////////
+
+void Slots::unlockReservations () {
+  // the logfile must be visible before the state that refers to it
+  _activeLogfile.store(_logfile);
+
+  if (_logfile == nullptr) {
+    _reservations.unlock(_handoutPosition, Reservations::LockedOffset);
+  }
+  else {
+    _reservations.unlock(_handoutPosition, _logfile->writePosition());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until the slot to hand out next is free
+////////////////////////////////////////////////////////////////////////////////
+
+void Slots::waitForFreeSlot (bool& hasWaited) {
+  CONDITION_LOCKER(guard, _condition);
+
+  if (! hasWaited) {
+    ++_waiting;
+    hasWaited = true;
+  }
+
+  Slot const* slot = &_slots[_reservations.slotIndex(_reservations.position())];
+
+  if (! slot->isUnused()) {
+    guard.wait(10 * 1000);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -688,6 +799,7 @@ int Slots::writeHeader (Slot* slot) {
   slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), handout());
   slot->fill(&header.base, size);
   slot->setReturned(false); // sync
+  --_numUsedSlots;
 
   return TRI_ERROR_NO_ERROR;
 }
@@ -708,25 +820,23 @@ int Slots::writeFooter (Slot* slot) {
   slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), handout());
   slot->fill(&footer.base, size);
   slot->setReturned(true); // sync
+  --_numUsedSlots;
 
   return TRI_ERROR_NO_ERROR;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief handout a region and advance the handout index
+/// @brief handout a region and advance the handout position
+/// this must only be called while the reservations are locked
 ////////////////////////////////////////////////////////////////////////////////
 
 Slot::TickType Slots::handout () {
-  TRI_ASSERT(_freeSlots > 0);
-  _freeSlots--;
+  TRI_ASSERT(_slots[_reservations.slotIndex(_handoutPosition)].isUnused());
+  ++_numUsedSlots;
 
-  if (++_handoutIndex ==_numberOfSlots) {
-    // wrap around
-    _handoutIndex = 0;
-  }
- 
-  _lastAssignedTick = static_cast<Slot::TickType>(TRI_NewTickServer());
-  return _lastAssignedTick;
+  _handoutPosition = _reservations.next(_handoutPosition);
+
+  return static_cast<Slot::TickType>(TRI_NewTickServer());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
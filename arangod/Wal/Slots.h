@@ -34,6 +34,7 @@
 #include "Basics/ConditionVariable.h"
 #include "Basics/Mutex.h"
 #include "Wal/Logfile.h"
+#include "Wal/Reservations.h"
 #include "Wal/Slot.h"
 #include "Wal/SyncRegion.h"
 
@@ -156,6 +157,14 @@ namespace triagens {
 
         Slot::TickType lastCommittedTick ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of slots that are handed out but not yet
+/// returned, and the number of threads waiting for their slots to be synced
+////////////////////////////////////////////////////////////////////////////////
+
+        void groupCommitState (uint32_t&,
+                               uint32_t&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the next unused slot
 ////////////////////////////////////////////////////////////////////////////////
@@ -220,6 +229,68 @@ namespace triagens {
         int closeLogfile (Slot::TickType&,
                           bool&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the next unused slot, common implementation
+////////////////////////////////////////////////////////////////////////////////
+
+        SlotInfo reserveSlot (uint32_t,
+                              bool,
+                              TRI_voc_cid_t,
+                              TRI_shape_sid_t,
+                              uint32_t,
+                              void*&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief try to reserve the next slot without the lock
+////////////////////////////////////////////////////////////////////////////////
+
+        Slot* tryReserveSlot (uint32_t,
+                              bool,
+                              TRI_voc_cid_t,
+                              TRI_shape_sid_t,
+                              uint32_t,
+                              void*&,
+                              int&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reserve the next slot with the lock held and the reservations
+/// locked, switching the logfile if required
+////////////////////////////////////////////////////////////////////////////////
+
+        int reserveSlotLocked (uint32_t,
+                               bool,
+                               TRI_voc_cid_t,
+                               TRI_shape_sid_t,
+                               uint32_t,
+                               void*&,
+                               Slot*&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief close the logfile with the lock held and the reservations locked
+////////////////////////////////////////////////////////////////////////////////
+
+        int closeLogfileLocked (Slot*,
+                                bool&,
+                                bool&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lock the reservations, so the logfile can be switched
+////////////////////////////////////////////////////////////////////////////////
+
+        void lockReservations ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief unlock the reservations and publish the current logfile
+////////////////////////////////////////////////////////////////////////////////
+
+        void unlockReservations ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until the slot to hand out next is free
+////////////////////////////////////////////////////////////////////////////////
+
+        void waitForFreeSlot (bool&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief write a header marker
 ////////////////////////////////////////////////////////////////////////////////
@@ -233,7 +304,7 @@ namespace triagens {
         int writeFooter (Slot*);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief handout a region and advance the handout index
+/// @brief handout a region and advance the handout position
 ////////////////////////////////////////////////////////////////////////////////
 
         Slot::TickType handout ();
@@ -270,7 +341,8 @@ namespace triagens {
         basics::ConditionVariable _condition;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief mutex protecting the slots interface
+/// @brief mutex protecting logfile switches and the sync regions. writers
+/// only acquire it if they cannot reserve a slot lock-free
 ////////////////////////////////////////////////////////////////////////////////
 
         basics::Mutex _lock;
@@ -288,22 +360,23 @@ namespace triagens {
         size_t const _numberOfSlots;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief the number of currently free slots
+/// @brief whether or not someone is waiting for a slot
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _freeSlots;
+        uint32_t _waiting;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief whether or not someone is waiting for a slot
+/// @brief handout position and write position for lock-free reservations
 ////////////////////////////////////////////////////////////////////////////////
 
-        uint32_t _waiting;
+        Reservations _reservations;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief the index of the slot to hand out next
+/// @brief the position of the slot to hand out next, only valid while the
+/// reservations are locked
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _handoutIndex;
+        uint32_t _handoutPosition;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the index of the slot to recycle
@@ -318,16 +391,16 @@ namespace triagens {
         Logfile* _logfile;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief last assigned tick value
+/// @brief the logfile lock-free reservations are made in
 ////////////////////////////////////////////////////////////////////////////////
 
-        Slot::TickType _lastAssignedTick;
+        std::atomic<Logfile*> _activeLogfile;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief last committed tick value
 ////////////////////////////////////////////////////////////////////////////////
 
-        Slot::TickType _lastCommittedTick;
+        std::atomic<Slot::TickType> _lastCommittedTick;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief last committed data tick value
@@ -339,7 +412,19 @@ namespace triagens {
 /// @brief number of log events handled
 ////////////////////////////////////////////////////////////////////////////////
 
-        uint64_t _numEvents;
+        std::atomic<uint64_t> _numEvents;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of slots handed out but not yet returned
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint32_t> _numUsedSlots;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of threads waiting in returnUsed for a sync
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint32_t> _numSyncWaiters;
 
     };
 
@@ -46,6 +46,7 @@ namespace triagens {
           logfileStatus(Logfile::StatusType::UNKNOWN),
           firstSlotIndex(0),
           lastSlotIndex(0),
+          numSyncWaiters(0),
           waitForSync(false),
           checkMore(false),
           canSeal(false) {
@@ -61,6 +62,7 @@ namespace triagens {
       Logfile::StatusType  logfileStatus;
       size_t               firstSlotIndex;
       size_t               lastSlotIndex;
+      uint32_t             numSyncWaiters;
       bool                 waitForSync;
       bool                 checkMore;
       bool                 canSeal;
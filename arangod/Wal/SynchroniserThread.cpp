@@ -59,6 +59,8 @@ SynchroniserThread::SynchroniserThread (LogfileManager* logfileManager,
     _waiting(0),
     _stop(0),
     _syncInterval(syncInterval),
+    _averageSyncTime(0.0),
+    _groupCommitDelay(0),
     _logfileCache() {
 
   allowAsynchronousCancelation();
@@ -128,6 +130,8 @@ void SynchroniserThread::run () {
       iterations = 0;
 
       try {
+        waitForGroupCommit();
+
         // sync as much as we can in this loop
         bool checkMore = false;
         while (true) {
@@ -199,6 +203,7 @@ int SynchroniserThread::doSync (bool& checkMore) {
   int fd = getLogfileDescriptor(region.logfileId);
   TRI_ASSERT(fd >= 0);
   void** mmHandle = nullptr;
+  double const start = TRI_microtime();
   bool result = TRI_MSync(fd, mmHandle, region.mem, region.mem + region.size);
 
   LOG_TRACE("syncing logfile %llu, region %p - %p, length: %lu, wfs: %s",
@@ -215,6 +220,7 @@ int SynchroniserThread::doSync (bool& checkMore) {
   }
 
   // all ok
+  adjustGroupCommitDelay(region, TRI_microtime() - start);
 
   if (status == Logfile::StatusType::SEAL_REQUESTED) {
     // we might not yet be able to seal the logfile yet, for example in
@@ -251,6 +257,85 @@ int SynchroniserThread::doSync (bool& checkMore) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait a little for writers that still hold slots, so their
+/// waitForSync operations can be synced in the same batch
+////////////////////////////////////////////////////////////////////////////////
+
+void SynchroniserThread::waitForGroupCommit () {
+  uint64_t delay = _groupCommitDelay;
+
+  TRI_IF_FAILURE("SynchroniserThread::maxGroupCommitDelay") {
+    // always group, as long as possible
+    delay = _syncInterval;
+  }
+
+  if (delay == 0) {
+    return;
+  }
+
+  double const end = TRI_microtime() + static_cast<double>(delay) / 1000000.0;
+
+  while (_stop == 0) {
+    uint32_t numUsedSlots;
+    uint32_t numSyncWaiters;
+    _logfileManager->slots()->groupCommitState(numUsedSlots, numSyncWaiters);
+
+    if (numUsedSlots == 0 || numSyncWaiters == 0) {
+      // no one left to batch with, or no one waiting for the sync
+      return;
+    }
+
+    double const now = TRI_microtime();
+
+    if (now >= end) {
+      return;
+    }
+
+    // returning a slot signals our condition
+    CONDITION_LOCKER(guard, _condition);
+    guard.wait(static_cast<uint64_t>((end - now) * 1000000.0) + 1);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adjust the group commit delay after a sync
+////////////////////////////////////////////////////////////////////////////////
+
+void SynchroniserThread::adjustGroupCommitDelay (SyncRegion const& region,
+                                                 double syncTime) {
+  if (! region.waitForSync) {
+    return;
+  }
+
+  if (_averageSyncTime == 0.0) {
+    _averageSyncTime = syncTime;
+  }
+  else {
+    _averageSyncTime = 0.8 * _averageSyncTime + 0.2 * syncTime;
+  }
+
+  uint64_t maxDelay = static_cast<uint64_t>(_averageSyncTime * 1000000.0);
+
+  if (maxDelay > _syncInterval) {
+    maxDelay = _syncInterval;
+  }
+
+  if (region.numSyncWaiters > 1) {
+    // writers arrive faster than we can sync. waiting a bit longer will
+    // put more of them into the next batch
+    _groupCommitDelay += maxDelay / 8 + 1;
+
+    if (_groupCommitDelay > maxDelay) {
+      _groupCommitDelay = maxDelay;
+    }
+  }
+  else {
+    // a single writer per sync: don't make it wait for others
+    _groupCommitDelay /= 2;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a logfile descriptor (it caches the descriptor for performance)
 ////////////////////////////////////////////////////////////////////////////////
@@ -116,6 +116,20 @@ namespace triagens {
 
         int doSync (bool&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait a little for writers that still hold slots, so their
+/// waitForSync operations can be synced in the same batch
+////////////////////////////////////////////////////////////////////////////////
+
+        void waitForGroupCommit ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adjust the group commit delay after a sync
+////////////////////////////////////////////////////////////////////////////////
+
+        void adjustGroupCommitDelay (SyncRegion const&,
+                                     double);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a logfile descriptor (it caches the descriptor for performance)
 ////////////////////////////////////////////////////////////////////////////////
@@ -158,6 +172,22 @@ namespace triagens {
 
         uint64_t const _syncInterval;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief moving average of the duration of a sync (in seconds)
+////////////////////////////////////////////////////////////////////////////////
+
+        double _averageSyncTime;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current group commit delay (in microseconds)
+///
+/// the delay grows while syncs batch more than one waitForSync operation,
+/// and shrinks when they don't. it is never longer than an average sync
+/// nor longer than the sync interval
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _groupCommitDelay;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief logfile descriptor cache
 ////////////////////////////////////////////////////////////////////////////////
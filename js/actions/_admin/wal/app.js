@@ -209,6 +209,59 @@ actions.defineHttp({
   }
 });
 
+////////////////////////////////////////////////////////////////////////////////
+/// @startDocuBlock JSF_get_admin_wal_statistics
+///
+/// @RESTHEADER{GET /_admin/wal/statistics, Returns the state of the write-ahead log garbage collector}
+///
+/// @RESTDESCRIPTION
+///
+/// Returns how far the write-ahead log garbage collector is behind. The
+/// result is a JSON object with the following attributes:
+/// - *pendingLogfiles*: the number of full logfiles that are not yet
+///   collected
+/// - *pendingOperations*: the number of operations that were transferred
+///   into collection datafiles, but are still waiting to be applied to the
+///   collections
+/// - *collectorThreads*: the number of garbage collector threads
+/// - *writeThrottled*: whether or not write-throttling is currently active
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// Is returned if the operation succeeds.
+///
+/// @RESTRETURNCODE{405}
+/// is returned when an invalid HTTP method is used.
+/// @endDocuBlock
+///
+/// @EXAMPLES
+///
+/// @EXAMPLE_ARANGOSH_RUN{RestWalStatisticsGet}
+///     var url = "/_admin/wal/statistics";
+///     var response = logCurlRequest('GET', url);
+///
+///     assert(response.code === 200);
+///
+///     logJsonResponse(response);
+/// @END_EXAMPLE_ARANGOSH_RUN
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+actions.defineHttp({
+  url : "_admin/wal/statistics",
+  prefix : false,
+
+  callback : function (req, res) {
+    if (req.requestType !== actions.GET) {
+      actions.resultUnsupported(req, res);
+      return;
+    }
+
+    actions.resultOk(req, res, actions.HTTP_OK, internal.wal.statistics());
+  }
+});
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -66,6 +66,7 @@ function collectionRepresentation (collection, showProperties, showCount, showFi
 
     result.doCompact     = properties.doCompact;
     result.isVolatile    = properties.isVolatile;
+    result.compressStrings = properties.compressStrings;
     result.journalSize   = properties.journalSize;
     result.keyOptions    = properties.keyOptions;
     result.waitForSync   = properties.waitForSync;
@@ -132,6 +133,10 @@ function parseBodyForCreateCollection (req, res) {
     r.parameter.isVolatile = body.isVolatile;
   }
 
+  if (body.hasOwnProperty("compressStrings")) {
+    r.parameter.compressStrings = body.compressStrings;
+  }
+
   if (body.hasOwnProperty("journalSize")) {
     r.parameter.journalSize = body.journalSize;
   }
@@ -206,6 +211,12 @@ function parseBodyForCreateCollection (req, res) {
 ///   should threrefore be used for cache-type collections only, and not 
 ///   for data that cannot be re-created otherwise.
 ///
+/// - *compressStrings* (optional, default is *false*): If *true* then string
+///   values of at least 256 bytes are stored deflated. This saves disk space
+///   and memory for documents with long texts, at the expense of CPU time
+///   when the strings are written or read. The option cannot be changed
+///   after the collection was created.
+///
 /// - *keyOptions* (optional) additional options for key generation. If
 ///   specified, then *keyOptions* should be a JSON array containing the
 ///   following attributes (note: some of them are optional):
@@ -321,6 +332,7 @@ function post_api_collection (req, res) {
     result.name = collection.name();
     result.waitForSync = r.parameter.waitForSync || false;
     result.isVolatile = r.parameter.isVolatile || false;
+    result.compressStrings = r.parameter.compressStrings || false;
     result.isSystem = r.parameter.isSystem || false;
     result.status = collection.status();
     result.type = collection.type();
@@ -489,6 +501,9 @@ function get_api_collections (req, res) {
 ///   kept in memory only and ArangoDB will not write or sync the data
 ///   to disk.
 ///
+/// - *compressStrings*: If *true* then long string values are stored
+///   deflated.
+///
 /// In a cluster setup, the result will also contain the following attributes:
 /// - *numberOfShards*: the number of shards of the collection.
 ///
@@ -662,6 +677,9 @@ function get_api_collections (req, res) {
 ///
 /// * *figures.indexes.size*: The total memory allocated for indexes in bytes.
 ///
+/// * *figures.indexes.fillPending*: The number of documents that still need to
+///   be inserted into indexes of the collection that are currently being built.
+///
 /// * *figures.maxTick*: The tick of the last marker that was stored in a journal
 ///   of the collection. This might be 0 if the collection does not yet have
 ///   a journal.
@@ -79,6 +79,14 @@ exports.wal = {
       return exports.arango.GET("/_admin/wal/properties", "");
     }
 
+    throw "not connected";
+  },
+
+  statistics: function () {
+    if (exports.arango) {
+      return exports.arango.GET("/_admin/wal/statistics", "");
+    }
+
     throw "not connected";
   }
 };
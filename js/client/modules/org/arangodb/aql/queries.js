@@ -112,6 +112,32 @@ exports.kill = function (id) {
   return requestResult;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the plan cache statistics
+////////////////////////////////////////////////////////////////////////////////
+
+exports.planCache = function () {
+  var db = internal.db;
+
+  var requestResult = db._connection.GET("/_api/query/plan-cache", "");
+  arangosh.checkRequestResult(requestResult);
+
+  return requestResult;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clears the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+exports.clearPlanCache = function () {
+  var db = internal.db;
+
+  var requestResult = db._connection.DELETE("/_api/query/plan-cache", "");
+  arangosh.checkRequestResult(requestResult);
+
+  return requestResult;
+};
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -330,6 +330,7 @@ ArangoCollection.prototype.properties = function (properties) {
     "journalSize": true,
     "isSystem": false,
     "isVolatile": false,
+    "compressStrings": false,
     "waitForSync": true,
     "shardKeys": false,
     "numberOfShards": false,
@@ -313,7 +313,7 @@ ArangoDatabase.prototype._create = function (name, properties, type) {
 
   if (properties !== undefined) {
     [ "waitForSync", "journalSize", "isSystem", "isVolatile",
-      "doCompact", "keyOptions", "shardKeys", "numberOfShards",
+      "doCompact", "compressStrings", "keyOptions", "shardKeys", "numberOfShards",
       "distributeShardsLike" ].forEach(function(p) {
       if (properties.hasOwnProperty(p)) {
         body[p] = properties[p];
@@ -410,6 +410,22 @@ function processQuery (query, explain) {
   };
 
 
+  var projection = function (node) {
+    if (node.projections && node.projections.length > 0) {
+      return ", projections: " + node.projections.map(function(attr) { return "`" + attr + "`"; }).join(", ");
+    }
+    return "";
+  };
+
+  var vertexConditions = function (node) {
+    if (node.vertexConditions && node.vertexConditions.length > 0) {
+      return ", vertex filter: " + node.vertexConditions.map(function(condition) {
+        return "`" + condition.attribute.join(".") + "` " + condition.operator + " " + JSON.stringify(condition.value);
+      }).join(" && ");
+    }
+    return "";
+  };
+
   var label = function (node) { 
     switch (node.type) {
       case "SingletonNode":
@@ -418,9 +434,11 @@ function processQuery (query, explain) {
         return keyword("EMPTY") + "   " + annotation("/* empty result set */");
       case "EnumerateCollectionNode":
         collectionVariables[node.outVariable.id] = node.collection;
-        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* full collection scan" + (node.random ? ", random order" : "") + " */");
+        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* full collection scan" + (node.random ? ", random order" : "") + projection(node) + " */");
       case "EnumerateListNode":
         return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + variableName(node.inVariable) + "   " + annotation("/* list iteration */");
+      case "TraversalNode":
+        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + func("TRAVERSAL") + "(" + collection(node.vertexCollection) + ", " + collection(node.edgeCollection) + ", " + variableName(node.inVariable) + ", " + value(JSON.stringify(node.direction)) + ")   " + annotation("/* native traversal" + vertexConditions(node) + " */");
       case "IndexRangeNode":
         collectionVariables[node.outVariable.id] = node.collection;
         var index = node.index;
@@ -428,7 +446,7 @@ function processQuery (query, explain) {
         index.collection = node.collection;
         index.node = node.id;
         indexes.push(index);
-        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* " + (node.reverse ? "reverse " : "") + node.index.type + " index scan") + annotation("*/");
+        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* " + (node.reverse ? "reverse " : "") + node.index.type + " index scan" + projection(node)) + annotation("*/");
       case "CalculationNode":
         return keyword("LET") + " " + variableName(node.outVariable) + " = " + buildExpression(node.expression);
       case "FilterNode":
@@ -437,6 +455,9 @@ function processQuery (query, explain) {
         return keyword("COLLECT") + " " + node.aggregates.map(function(node) {
           return variableName(node.outVariable) + " = " + variableName(node.inVariable);
         }).join(", ") + 
+                 (node.aggregateFunctions ? " " + keyword("AGGREGATE") + " " + node.aggregateFunctions.map(function(node) {
+                   return variableName(node.outVariable) + " = " + func(node.type) + "(" + variableName(node.inVariable) + ")";
+                 }).join(", ") : "") +
                  (node.count ? " " + keyword("WITH COUNT") : "") + 
                  (node.outVariable ? " " + keyword("INTO") + " " + variableName(node.outVariable) : "") +
                  (node.keepVariables ? " " + keyword("KEEP") + " " + node.keepVariables.map(function(variable) { return variableName(variable); }).join(", ") : "") + 
@@ -501,6 +522,7 @@ function processQuery (query, explain) {
   var postHandle = function (node) {
     if ([ "EnumerateCollectionNode",
           "EnumerateListNode",
+          "TraversalNode",
           "IndexRangeNode",
           "SubqueryNode" ].indexOf(node.type) !== -1) {
       level++;
@@ -636,6 +636,24 @@ function CREATE_REGEX_PATTERN (chars) {
   return pattern;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the regex used to trim a string
+///
+/// the characters may contain an invalid range such as "z-a", which cannot be
+/// compiled. this is reported as an invalid argument, as the C++ version does
+////////////////////////////////////////////////////////////////////////////////
+
+function CREATE_TRIM_REGEX (pattern, func) {
+  'use strict';
+
+  try {
+    return new RegExp(pattern, 'g');
+  }
+  catch (err) {
+    THROW(func, INTERNAL.errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, func);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief compile a regex from a string pattern
 ////////////////////////////////////////////////////////////////////////////////
@@ -2003,7 +2021,7 @@ function AQL_TRIM (value, chars) {
   }
 
   var pattern = CREATE_REGEX_PATTERN(chars);
-  return AQL_TO_STRING(value).replace(new RegExp("(^[" + pattern + "]+|[" + pattern + "]+$)", 'g'), '');
+  return AQL_TO_STRING(value).replace(CREATE_TRIM_REGEX("(^[" + pattern + "]+|[" + pattern + "]+$)", "TRIM"), '');
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2020,7 +2038,7 @@ function AQL_LTRIM (value, chars) {
     chars = "^[" + CREATE_REGEX_PATTERN(chars) + "]+";
   }
 
-  return AQL_TO_STRING(value).replace(new RegExp(chars, 'g'), '');
+  return AQL_TO_STRING(value).replace(CREATE_TRIM_REGEX(chars, "LTRIM"), '');
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2037,7 +2055,7 @@ function AQL_RTRIM (value, chars) {
     chars = "[" + CREATE_REGEX_PATTERN(chars) + "]+$";
   }
 
-  return AQL_TO_STRING(value).replace(new RegExp(chars, 'g'), '');
+  return AQL_TO_STRING(value).replace(CREATE_TRIM_REGEX(chars, "RTRIM"), '');
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2085,6 +2103,12 @@ function AQL_SUBSTITUTE (value, search, replace, limit) {
   var pattern, patterns, replacements = { }, sWeight = TYPEWEIGHT(search);
   value = AQL_TO_STRING(value);
 
+  if (sWeight !== TYPEWEIGHT_OBJECT && sWeight !== TYPEWEIGHT_ARRAY) {
+    // any other search value is used as a string
+    search = AQL_TO_STRING(search);
+    sWeight = TYPEWEIGHT_STRING;
+  }
+
   if (sWeight === TYPEWEIGHT_OBJECT) {
     patterns = [ ];
     KEYS(search, false).forEach(function(k) {
@@ -1,5 +1,5 @@
 /*global AQL_QUERIES_SLOW, AQL_QUERIES_CURRENT, AQL_QUERIES_PROPERTIES,
-  AQL_QUERIES_KILL */
+  AQL_QUERIES_KILL, AQL_QUERIES_PLAN_CACHE */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief AQL query management
@@ -90,6 +90,26 @@ exports.kill = function (id) {
   return AQL_QUERIES_KILL(id);
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the plan cache statistics
+////////////////////////////////////////////////////////////////////////////////
+
+exports.planCache = function () {
+  'use strict';
+
+  return AQL_QUERIES_PLAN_CACHE();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clears the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+exports.clearPlanCache = function () {
+  'use strict';
+
+  AQL_QUERIES_PLAN_CACHE(true);
+};
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -0,0 +1,182 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for compiled expressions
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+var errors = require("internal").errors;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function compiledExpressionsTestSuite () {
+  var paramNone = { optimizer: { rules: [ "-all" ] } };
+  var c;
+
+  var getExpressionTypes = function (query) {
+    return AQL_EXPLAIN(query, { }, paramNone).plan.nodes.filter(function(node) {
+      return node.type === "CalculationNode";
+    }).map(function(node) {
+      return node.expressionType;
+    });
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      for (var i = 0; i < 100; ++i) {
+        c.save({ _key: "test" + i, value: i, name: "test" + (i % 10), sub: { a: i, b: [ i ] }, flag: (i % 2 === 0) });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test which expressions are compiled
+////////////////////////////////////////////////////////////////////////////////
+
+    testExpressionTypes : function () {
+      var queries = [
+        [ "FOR i IN " + c.name() + " FILTER i.value > 5 && i.name == 'test1' RETURN i", [ "compiled" ] ],
+        [ "FOR i IN " + c.name() + " RETURN i.value * 2 + 1", [ "compiled" ] ],
+        [ "FOR i IN " + c.name() + " RETURN i.sub.a", [ "compiled" ] ],
+        [ "FOR i IN " + c.name() + " RETURN i.value", [ "attribute" ] ],
+        [ "FOR i IN " + c.name() + " RETURN [ i.value ]", [ "simple" ] ],
+        [ "FOR i IN " + c.name() + " RETURN UPPER(i.name)", [ "simple" ] ],
+        [ "FOR i IN " + c.name() + " RETURN TRIM(i.name)", [ "v8" ] ]
+      ];
+
+      queries.forEach(function(query) {
+        assertEqual(query[1], getExpressionTypes(query[0]), query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test comparisons on documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testComparisons : function () {
+      var query = "FOR i IN " + c.name() + " FILTER i.value > 5 && i.name == 'test1' SORT i.value RETURN i.value";
+      assertEqual([ 11, 21, 31, 41, 51, 61, 71, 81, 91 ], AQL_EXECUTE(query).json);
+
+      query = "FOR i IN " + c.name() + " FILTER i.value <= 3 || i.name >= 'test9' SORT i.value RETURN i.value";
+      assertEqual([ 0, 1, 2, 3, 9, 19, 29, 39, 49, 59, 69, 79, 89, 99 ], AQL_EXECUTE(query).json);
+
+      query = "FOR i IN " + c.name() + " FILTER i.sub.a != i.value || i._key == 'test42' RETURN i.value";
+      assertEqual([ 42 ], AQL_EXECUTE(query).json);
+
+      query = "FOR i IN " + c.name() + " FILTER i.flag == true && i.value < 10 SORT i.value RETURN i.value";
+      assertEqual([ 0, 2, 4, 6, 8 ], AQL_EXECUTE(query).json);
+
+      query = "FOR i IN " + c.name() + " FILTER i.sub.b == [ 17 ] && i.missing == null RETURN i.value";
+      assertEqual([ 17 ], AQL_EXECUTE(query).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test IN and NOT IN
+////////////////////////////////////////////////////////////////////////////////
+
+    testIn : function () {
+      var query = "FOR i IN " + c.name() + " FILTER i.value IN [ 99, 3, 17, 1000 ] SORT i.value RETURN i.value";
+      assertEqual([ 3, 17, 99 ], AQL_EXECUTE(query).json);
+
+      query = "FOR i IN " + c.name() + " FILTER i.value < 5 && i.value NOT IN [ 1, 2 ] SORT i.value RETURN i.value";
+      assertEqual([ 0, 3, 4 ], AQL_EXECUTE(query).json);
+
+      query = "FOR i IN " + c.name() + " FILTER i.value < 3 SORT i.value RETURN i.value IN i.sub";
+      assertEqual([ false, false, false ], AQL_EXECUTE(query).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test logical operators and the ternary operator return values
+////////////////////////////////////////////////////////////////////////////////
+
+    testLogicalValues : function () {
+      var query = "FOR i IN [ 0, 1, 2 ] LET a = i && 'yes' LET b = i || 'no' LET c = ! i LET d = i > 0 ? i.x || i : 'none' RETURN [ a, b, c, d ]";
+      assertEqual([ [ 0, "no", true, "none" ], [ "yes", 1, false, 1 ], [ "yes", 2, false, 2 ] ], AQL_EXECUTE(query, { }, paramNone).json);
+
+      query = "FOR i IN " + c.name() + " FILTER i.value < 2 SORT i.value RETURN i.flag ? i.name : i.sub";
+      assertEqual([ "test0", { a: 1, b: [ 1 ] } ], AQL_EXECUTE(query).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test arithmetic
+////////////////////////////////////////////////////////////////////////////////
+
+    testArithmetic : function () {
+      var query = "FOR i IN " + c.name() + " FILTER i.value < 4 SORT i.value LET a = i.value + 1 LET b = i.value - 1 LET c = i.value * 2.5 LET d = i.value / 2 LET e = i.value % 3 LET f = -(i.value + 1) LET g = +i.name RETURN [ a, b, c, d, e, f, g ]";
+      assertEqual([ [ 1, -1, 0, 0, 0, -1, null ],
+                    [ 2, 0, 2.5, 0.5, 1, -2, null ],
+                    [ 3, 1, 5, 1, 2, -3, null ],
+                    [ 4, 2, 7.5, 1.5, 0, -4, null ] ], AQL_EXECUTE(query).json);
+
+      query = "FOR i IN [ null, true, false, '', ' 12 ', '0x10', '1e3', 'abc', '12abc', [ ], [ 3 ], [ 1, 2 ], { } ] RETURN i + 1";
+      assertEqual([ 1, 2, 1, 1, 13, 17, 1001, null, null, 1, 4, null, null ], AQL_EXECUTE(query, { }, paramNone).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test division by zero
+////////////////////////////////////////////////////////////////////////////////
+
+    testDivisionByZero : function () {
+      var query = "FOR i IN [ 0, 1 ] LET a = 1 / i LET b = 1 % i RETURN [ a, b ]";
+      var result = AQL_EXECUTE(query, { }, paramNone);
+
+      assertEqual([ [ null, null ], [ 1, 0 ] ], result.json);
+      assertEqual(errors.ERROR_QUERY_DIVISION_BY_ZERO.code, result.warnings[0].code);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(compiledExpressionsTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @\\}\\)"
+// End:
@@ -0,0 +1,164 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for full collection scans of large collections
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+///
+/// the outermost loop over a collection reads the primary index in windows of
+/// up to 65536 documents and returns each window in datafile order. the
+/// collection is bigger than one window, so the scans cross window boundaries
+////////////////////////////////////////////////////////////////////////////////
+
+function enumerateCollectionSuite () {
+  var cn = "UnitTestsAhuacatlEnumerateCollection";
+  var n = 70000;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks that the values are distinct numbers between 0 and n - 1
+////////////////////////////////////////////////////////////////////////////////
+
+  var checkDistinct = function (values) {
+    var seen = { };
+
+    values.forEach(function (value) {
+      assertTrue(value >= 0 && value < n, value);
+      assertTrue(! seen.hasOwnProperty(value), value);
+      seen[value] = true;
+    });
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      db._create(cn);
+
+      AQL_EXECUTE("FOR i IN 0.." + (n - 1) + " INSERT { _key: CONCAT('test', i), value: i } IN " + cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a full scan returns every document exactly once
+////////////////////////////////////////////////////////////////////////////////
+
+    testFullScan : function () {
+      var result = AQL_EXECUTE("FOR doc IN " + cn + " RETURN doc.value");
+
+      assertEqual(n, result.json.length);
+      assertEqual(n, result.stats.scannedFull);
+      checkDistinct(result.json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a full scan after updates and removals returns every remaining
+/// document exactly once, in its latest revision
+////////////////////////////////////////////////////////////////////////////////
+
+    testFullScanAfterModifications : function () {
+      AQL_EXECUTE("FOR doc IN " + cn + " FILTER doc.value % 7 == 0 REMOVE doc IN " + cn);
+      AQL_EXECUTE("FOR doc IN " + cn + " FILTER doc.value % 3 == 0 UPDATE doc WITH { updated: true } IN " + cn);
+
+      var result = AQL_EXECUTE("FOR doc IN " + cn + " RETURN [ doc.value, doc.updated ]").json;
+      var expected = n - Math.ceil(n / 7);
+
+      assertEqual(expected, result.length);
+      checkDistinct(result.map(function (doc) { return doc[0]; }));
+
+      result.forEach(function (doc) {
+        assertTrue(doc[0] % 7 !== 0, doc);
+        assertEqual(doc[0] % 3 === 0 ? true : null, doc[1], doc);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skipping with LIMIT across the window boundaries
+////////////////////////////////////////////////////////////////////////////////
+
+    testLimitAcrossWindows : function () {
+      var query = "FOR doc IN " + cn + " LIMIT @offset, @count RETURN doc.value";
+      var offsets = [ 1000, 63990, 64000, 65530, 65536, 65537, 69990 ];
+      var counts = [ 1, 20, 10000, n ];
+
+      offsets.forEach(function (offset) {
+        counts.forEach(function (count) {
+          var result = AQL_EXECUTE(query, { offset: offset, count: count }, { fullCount: true });
+          var message = "offset: " + offset + ", count: " + count;
+
+          assertEqual(Math.min(count, n - offset), result.json.length, message);
+          checkDistinct(result.json);
+
+          // the rest of the collection is skipped to compute the full count,
+          // so every document must have been handed out exactly once
+          assertEqual(n, result.stats.fullCount, message);
+          assertEqual(n, result.stats.scannedFull, message);
+        });
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reading all documents after a skip across the first window
+////////////////////////////////////////////////////////////////////////////////
+
+    testLimitRemainder : function () {
+      var result = AQL_EXECUTE("FOR doc IN " + cn + " LIMIT 65530, " + n + " RETURN doc.value");
+
+      assertEqual(n - 65530, result.json.length);
+      assertEqual(n, result.stats.scannedFull);
+      checkDistinct(result.json);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(enumerateCollectionSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
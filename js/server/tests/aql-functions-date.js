@@ -740,6 +740,57 @@ function ahuacatlDateFunctionsTestSuite () {
       }); 
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test date_timestamp function with unusual date strings
+////////////////////////////////////////////////////////////////////////////////
+
+    testDateTimestampEdgeCases : function () {
+      var values = [
+        [ "2016-02-29", 1456704000000 ],
+        [ "2000-02-29", 951782400000 ],
+        [ "1900-02-29", -2203891200000 ],
+        [ "2015-02-29", 1425168000000 ],
+        [ "2015-02-31", 1425340800000 ],
+        [ "2015-04-31", 1430438400000 ],
+        [ "2015-01-02T03:04:05.1", 1420167845100 ],
+        [ "2015-01-02T03:04:05.123456", 1420167845123 ],
+        [ "2015-01-02T03:04:05.9999", 1420167845999 ],
+        [ "2015-01-02t03:04:05z", 1420167845000 ],
+        [ "2015-01-02T03:04:05+01:30", 1420162445000 ],
+        [ "2015-01-02T03:04:05-0130", 1420173245000 ],
+        [ "+002015-01-02", 1420156800000 ],
+        [ "-000001-12-31T23:59:59Z", -62167219201000 ],
+        [ " 2015-01-02 ", 1420156800000 ]
+      ];
+
+      values.forEach(function (value) {
+        var actual = getQueryResults("RETURN DATE_TIMESTAMP(@value)", { value: value[0] });
+        assertEqual([ value[1] ], actual);
+        
+        // the same string as a constant is evaluated at query compile time
+        actual = getQueryResults("RETURN DATE_TIMESTAMP(" + JSON.stringify(value[0]) + ")");
+        assertEqual([ value[1] ], actual);
+      }); 
+
+      values = [
+        "2015-01-02T",
+        "2015-01-02T03",
+        "2015-01-02Tfoo",
+        "2015-01-02T03:04:05.",
+        "2015-01-02T03:04:05+",
+        "2015-01-02T03:04:05Zfoo",
+        "20150102",
+        "15-01-02",
+        "2015-01-02T23:59:60Z",
+        "2015-01-02T24:00:00Z"
+      ];
+
+      values.forEach(function(value) {
+        assertEqual([ null ], getQueryResults("RETURN DATE_TIMESTAMP(@value)", { value: value }));
+        assertQueryWarningAndNull(errors.ERROR_QUERY_INVALID_DATE_VALUE.code, "RETURN DATE_ISO8601(@value)", { value: value });
+      });  
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test date_iso8601 function
 ////////////////////////////////////////////////////////////////////////////////
@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false, maxlen: 500 */
-/*global assertEqual */
+/*global assertEqual, fail */
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tests for query language, functions
 ///
@@ -33,6 +33,7 @@ var jsunity = require("jsunity");
 var helper = require("org/arangodb/aql-helper");
 var getQueryResults = helper.getQueryResults;
 var assertQueryError = helper.assertQueryError;
+var aql = require("org/arangodb/aql");
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test suite
@@ -1217,6 +1218,59 @@ function ahuacatlStringFunctionsTestSuite () {
       assertEqual(10, actual[1].length);
       assertEqual(100, actual[2].length);
       assertEqual(1000, actual[3].length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test string functions with characters outside the BMP
+///
+/// positions and lengths are counted in UTF-16 units, as in JavaScript. the
+/// results must be the same as the ones of the JavaScript implementation
+////////////////////////////////////////////////////////////////////////////////
+
+    testNonBmpStrings : function () {
+      var value = "a\ud83d\ude00b\ud83d\ude00c";
+      var tests = [
+        [ "CHAR_LENGTH(@value)", 7, aql.AQL_CHAR_LENGTH(value) ],
+        [ "SUBSTRING(@value, 1, 2)", "\ud83d\ude00", aql.AQL_SUBSTRING(value, 1, 2) ],
+        [ "LEFT(@value, 3)", "a\ud83d\ude00", aql.AQL_LEFT(value, 3) ],
+        [ "RIGHT(@value, 3)", "\ud83d\ude00c", aql.AQL_RIGHT(value, 3) ],
+        [ "CONTAINS(@value, 'b', true)", 3, aql.AQL_CONTAINS(value, "b", true) ],
+        [ "FIND_FIRST(@value, '\ud83d\ude00', 2)", 4, aql.AQL_FIND_FIRST(value, "\ud83d\ude00", 2) ],
+        [ "FIND_LAST(@value, '\ud83d\ude00')", 4, aql.AQL_FIND_LAST(value, "\ud83d\ude00") ],
+        [ "SPLIT(@value, '\ud83d\ude00')", [ "a", "b", "c" ], aql.AQL_SPLIT(value, "\ud83d\ude00") ],
+        [ "SPLIT(@value, '\ud83d\ude00', 2)", [ "a", "b" ], aql.AQL_SPLIT(value, "\ud83d\ude00", 2) ],
+        [ "TRIM(@value, 'ac\ud83d\ude00')", "b", aql.AQL_TRIM(value, "ac\ud83d\ude00") ],
+        [ "LTRIM(@value, 'a\ud83d\ude00')", "b\ud83d\ude00c", aql.AQL_LTRIM(value, "a\ud83d\ude00") ],
+        [ "RTRIM(@value, 'c\ud83d\ude00')", "a\ud83d\ude00b", aql.AQL_RTRIM(value, "c\ud83d\ude00") ],
+        [ "LIKE(@value, 'a_b%')", false, aql.AQL_LIKE(value, "a_b%") ],
+        [ "LIKE(@value, 'a__b%')", true, aql.AQL_LIKE(value, "a__b%") ],
+        [ "SUBSTITUTE(@value, '\ud83d\ude00', 'x')", "axbxc", aql.AQL_SUBSTITUTE(value, "\ud83d\ude00", "x") ],
+        [ "REVERSE(REVERSE(@value))", value, aql.AQL_REVERSE(aql.AQL_REVERSE(value)) ],
+        [ "CHAR_LENGTH(TRIM(SUBSTRING(@value, 1, 1)))", 1, aql.AQL_CHAR_LENGTH(aql.AQL_TRIM(aql.AQL_SUBSTRING(value, 1, 1))) ]
+      ];
+
+      tests.forEach(function (test) {
+        assertEqual([ test[1] ], getQueryResults("RETURN " + test[0], { value: value }), test[0]);
+        assertEqual(test[1], test[2], test[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test trim functions with an invalid character range
+////////////////////////////////////////////////////////////////////////////////
+
+    testTrimInvalidRange : function () {
+      assertQueryError(errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH.code, "RETURN TRIM('abc', 'z-a')"); 
+      assertQueryError(errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH.code, "RETURN LTRIM('abc', 'z-a')"); 
+      assertQueryError(errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH.code, "RETURN RTRIM(@value, 'z-a')", { value: "abc" }); 
+
+      try {
+        aql.AQL_TRIM("abc", "z-a");
+        fail();
+      }
+      catch (err) {
+        assertEqual(errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH.code, err.errorNum);
+      }
     }
 
   };
@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false, maxlen: 500 */
-/*global assertEqual, assertNull, assertTrue, assertFalse */
+/*global assertEqual, assertNull, assertTrue, assertFalse, AQL_EXECUTE */
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tests for query language, functions
 ///
@@ -2672,6 +2672,43 @@ function ahuacatlFunctionsTestSuite () {
       });
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test matches function with unusual arguments
+////////////////////////////////////////////////////////////////////////////////
+
+    testMatchesEdgeCases : function () {
+      var tests = [
+        [ { a: 1 }, { a: 1 }, false, true ],
+        [ { a: 1 }, { a: 2 }, true, -1 ],
+        [ { a: 1 }, { b: null }, true, 0 ],
+        [ { a: null }, { a: null, b: null }, false, true ],
+        [ { a: { b: [ 1, 2 ] } }, { a: { b: [ 1, 2 ] } }, false, true ],
+        [ { a: { b: [ 1, 2 ] } }, { a: { b: [ 1 ] } }, false, false ],
+        [ { a: { b: 1, c: 2 } }, [ { a: { c: 2, b: 1 } } ], true, 0 ],
+        [ { a: "\ud83d\ude00" }, [ { a: "\ud83d\ude01" }, { a: "\ud83d\ude00" } ], true, 1 ],
+        [ [ { a: 1 } ], [ { a: 1 } ], false, false ],
+        [ null, [ { } ], true, false ],
+        [ "a", [ { } ], false, false ]
+      ];
+
+      tests.forEach(function (data) {
+        var query = "RETURN MATCHES(" + JSON.stringify(data[0]) + ", " + JSON.stringify(data[1]) + ", " + JSON.stringify(data[2]) + ")";
+        assertEqual([ data[3] ], getQueryResults(query), query);
+
+        // evaluate the same call at runtime
+        query = "FOR doc IN [ @doc ] RETURN MATCHES(doc, @examples, @flag)";
+        assertEqual([ data[3] ], getQueryResults(query, { doc: data[0], examples: data[1], flag: data[2] }), query);
+      });
+
+      var result = AQL_EXECUTE("RETURN MATCHES({ a: 1 }, [ ])");
+      assertEqual([ false ], result.json);
+      assertEqual(errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH.code, result.warnings[0].code);
+
+      result = AQL_EXECUTE("RETURN MATCHES({ a: 1 }, [ 1, { a: 1 } ], true)");
+      assertEqual([ 1 ], result.json);
+      assertEqual(errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH.code, result.warnings[0].code);
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test variance function
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,134 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global fail, assertEqual, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for the transfer formats of AqlItemBlocks in the cluster
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+var db = internal.db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+///
+/// the DB servers answer in the binary format if the coordinator asks for it
+/// and in Json otherwise. the failure points on the coordinator suppress the
+/// Accept header or reject Json answers
+////////////////////////////////////////////////////////////////////////////////
+
+function itemBlockFormatClusterSuite () {
+  var cn = "UnitTestsBlockFormat";
+  var n = 3000;
+
+  var queries = [
+    "FOR d IN " + cn + " SORT d.value RETURN d",
+    "FOR d IN " + cn + " SORT d.value RETURN [ d.value, d.name, d.values ]",
+    "FOR d IN " + cn + " LET r = 1..(d.value % 4) SORT d.value RETURN [ d._key, r ]",
+    "FOR d IN " + cn + " FILTER d.value % 10 == 0 SORT d.value RETURN d._id"
+  ];
+
+  var executeAll = function () {
+    return queries.map(function (query) {
+      return AQL_EXECUTE(query).json;
+    });
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      internal.debugClearFailAt();
+      db._drop(cn);
+      var c = db._create(cn, { numberOfShards: 3 });
+
+      for (var i = 0; i < n; ++i) {
+        if (i % 2 === 0) {
+          c.save({ value: i, name: "test" + i });
+        }
+        else {
+          c.save({ value: i, values: [ i, null, "äöü" ] });
+        }
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      internal.debugClearFailAt();
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the DB servers answer in the binary format by default
+////////////////////////////////////////////////////////////////////////////////
+
+    testBinaryFormat : function () {
+      var expected = executeAll();
+      assertEqual(n, expected[0].length);
+
+      internal.debugSetFailAt("RemoteBlock::requireBinaryFormat");
+      assertEqual(expected, executeAll());
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the DB servers answer in Json if the binary format is not accepted
+////////////////////////////////////////////////////////////////////////////////
+
+    testJsonFallback : function () {
+      var expected = executeAll();
+
+      internal.debugSetFailAt("RemoteBlock::noBinaryFormat");
+      assertEqual(expected, executeAll());
+
+      // the answers are really in Json
+      internal.debugSetFailAt("RemoteBlock::requireBinaryFormat");
+
+      try {
+        AQL_EXECUTE(queries[0]);
+        fail();
+      }
+      catch (err) {
+        assertEqual(internal.errors.ERROR_DEBUG.code, err.errorNum);
+      }
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+if (internal.debugCanUseFailAt()) {
+  jsunity.run(itemBlockFormatClusterSuite);
+}
+
+return jsunity.done();
@@ -0,0 +1,210 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for the transfer formats of AqlItemBlocks
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+var db = internal.db;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     block formats
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+///
+/// the failure points make every block pass through the binary or the Json
+/// format on its way from one execution block to the next, as if it was sent
+/// to another cluster node. the results must not change
+////////////////////////////////////////////////////////////////////////////////
+
+function itemBlockFormatSuite () {
+  var cn1 = "UnitTestsBlockFormat1";
+  var cn2 = "UnitTestsBlockFormat2";
+  var en = "UnitTestsBlockFormatEdges";
+  var failurePoints = [ "ExecutionBlock::binaryRoundTrip", "ExecutionBlock::jsonRoundTrip" ];
+
+  // execute the query directly and with each format, and compare the results
+  var check = function (query) {
+    internal.debugClearFailAt();
+    var expected = AQL_EXECUTE(query).json;
+
+    failurePoints.forEach(function (fp) {
+      internal.debugClearFailAt();
+      internal.debugSetFailAt(fp);
+
+      var actual = AQL_EXECUTE(query).json;
+      assertEqual(expected, actual, fp + ": " + query);
+    });
+
+    internal.debugClearFailAt();
+    return expected;
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      internal.debugClearFailAt();
+      db._drop(cn1);
+      db._drop(cn2);
+      db._drop(en);
+
+      var c1 = db._create(cn1);
+      var c2 = db._create(cn2);
+      var e = db._createEdgeCollection(en);
+      var i;
+
+      for (i = 0; i < 2500; ++i) {
+        // documents with different shapes
+        if (i % 3 === 0) {
+          c1.save({ _key: "test" + i, value: i, name: "test" + i });
+        }
+        else if (i % 3 === 1) {
+          c1.save({ _key: "test" + i, value: i, values: [ i, "x", null, true ], sub: { a: i, b: { c: -i } } });
+        }
+        else {
+          c1.save({ _key: "test" + i, value: i, name: null, double: i / 7, text: "äöü€" + i });
+        }
+      }
+
+      for (i = 0; i < 100; ++i) {
+        c2.save({ _key: "other" + i, value: i * 2, other: true });
+        e.save(cn1 + "/test" + i, cn2 + "/other" + i, { value: i });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      internal.debugClearFailAt();
+      db._drop(cn1);
+      db._drop(cn2);
+      db._drop(en);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief JSON values
+////////////////////////////////////////////////////////////////////////////////
+
+    testJsonValues : function () {
+      check("FOR i IN 1..1500 RETURN { i: i, s: CONCAT('value', i), a: [ i, null, true, false, 1.5, -0.25, 'äöü' ], o: { n: { m: -i } } }");
+      check("FOR i IN [ null, true, false, 0, -1, 1e100, -1e-100, '', 'abc', [ ], { } ] RETURN i");
+      // the same Json value in many rows and registers
+      check("FOR i IN 1..1500 LET a = { a: [ 1, 2, 3 ] } LET b = a RETURN [ i, a, b ]");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief documents from collections
+////////////////////////////////////////////////////////////////////////////////
+
+    testShapedValues : function () {
+      var result = check("FOR d IN " + cn1 + " SORT d.value RETURN d");
+      assertEqual(2500, result.length);
+      assertEqual(cn1 + "/test0", result[0]._id);
+
+      // the same document in several registers
+      check("FOR d IN " + cn1 + " LET x = d SORT d.value DESC RETURN [ d, x, d.value ]");
+
+      // edges
+      result = check("FOR e IN " + en + " SORT e.value RETURN e");
+      assertEqual(100, result.length);
+      assertEqual(cn1 + "/test0", result[0]._from);
+      assertEqual(cn2 + "/other0", result[0]._to);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief documents from different collections in different registers
+////////////////////////////////////////////////////////////////////////////////
+
+    testCollectionMapping : function () {
+      var result = check("FOR a IN " + cn1 + " FOR b IN " + cn2 + " FILTER a.value == b.value SORT a.value RETURN [ a, b ]");
+      assertEqual(100, result.length);
+
+      result.forEach(function (pair) {
+        assertEqual(cn1 + "/" + pair[0]._key, pair[0]._id);
+        assertEqual(cn2 + "/" + pair[1]._key, pair[1]._id);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief subquery results
+////////////////////////////////////////////////////////////////////////////////
+
+    testDocvecValues : function () {
+      check("FOR i IN 1..20 LET s = (FOR j IN 1..i RETURN j) RETURN s");
+      check("FOR i IN 1..5 LET s = (FOR d IN " + cn1 + " FILTER d.value < i * 100 SORT d.value RETURN d) RETURN [ i, s ]");
+      check("FOR i IN 1..3 LET s = (FOR d IN " + cn1 + " SORT d.value LIMIT 1100 RETURN d.value) RETURN LENGTH(s)");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ranges
+////////////////////////////////////////////////////////////////////////////////
+
+    testRangeValues : function () {
+      check("FOR i IN 1..2000 RETURN i");
+      check("FOR i IN 1..50 LET r = -i..i RETURN [ i, r ]");
+      check("FOR i IN 1..10 FOR j IN i..(i * 2) RETURN [ i, j ]");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief registers that are cleared or not set
+////////////////////////////////////////////////////////////////////////////////
+
+    testEmptyRegisters : function () {
+      check("FOR d IN " + cn1 + " LET x = d.value * 2 FILTER x > 10 SORT d.value RETURN d.value");
+      check("FOR i IN 1..1500 LET a = i * 2 LET b = a + 1 LET c = b * 2 FILTER c % 3 == 0 RETURN i");
+      check("FOR d IN " + cn1 + " COLLECT v = d.value % 7 INTO g RETURN [ v, LENGTH(g) ]");
+    }
+
+  };
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                              main
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+if (internal.debugCanUseFailAt()) {
+  jsunity.run(itemBlockFormatSuite);
+}
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
@@ -0,0 +1,196 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, AQL_EXECUTE, AQL_EXPLAIN */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for COLLECT w/ AGGREGATE
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+var errors = internal.errors;
+var db = require("org/arangodb").db;
+var helper = require("org/arangodb/aql-helper");
+var assertQueryError = helper.assertQueryError;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerAggregateTestSuite () {
+  var c;
+
+  return {
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      for (var i = 0; i < 2000; ++i) {
+        c.save({ group: "test" + (i % 10), value: i });
+      }
+    },
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test invalid syntax
+////////////////////////////////////////////////////////////////////////////////
+
+    testInvalidSyntax : function () {
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length = RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGAT length = LENGTH(i) RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT class = i.group AGGREGATE RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT class = i.group INTO g AGGREGATE length = LENGTH(i) RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT class = i.group AGGREGATE length = LENGTH(i) INTO g RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT class = i.group AGGREGATE length = LENGTH(i) WITH COUNT INTO g RETURN 1");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test invalid aggregate expressions
+////////////////////////////////////////////////////////////////////////////////
+
+    testInvalidAggregateExpression : function () {
+      var code = errors.ERROR_QUERY_INVALID_AGGREGATE_EXPRESSION.code;
+      assertQueryError(code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length = 1 RETURN length");
+      assertQueryError(code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length = i.value RETURN length");
+      assertQueryError(code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length = LENGTH(i) + 1 RETURN length");
+      assertQueryError(code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length = CONCAT(i.group) RETURN length");
+      assertQueryError(code, "FOR i IN " + c.name() + " COLLECT class = i.group AGGREGATE length = SUM(class) RETURN length");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test total aggregation
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateTotal : function () {
+      var query = "FOR i IN " + c.name() + " COLLECT AGGREGATE length = LENGTH(i), count = COUNT(i.value), min = MIN(i.value), max = MAX(i.value), sum = SUM(i.value), avg = AVERAGE(i.value) RETURN { length: length, count: count, min: min, max: max, sum: sum, avg: avg }";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual(1, results.json.length);
+      assertEqual({ length: 2000, count: 2000, min: 0, max: 1999, sum: 1999000, avg: 999.5 }, results.json[0]);
+
+      var plan = AQL_EXPLAIN(query).plan;
+      // must not have a SortNode
+      assertEqual(-1, plan.nodes.map(function(node) { return node.type; }).indexOf("SortNode"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test total aggregation without input
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateTotalEmpty : function () {
+      var query = "FOR i IN " + c.name() + " FILTER i.value < 0 COLLECT AGGREGATE length = LENGTH(i), min = MIN(i.value), max = MAX(i.value), sum = SUM(i.value), avg = AVG(i.value) RETURN [ length, min, max, sum, avg ]";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual([ [ 0, null, null, 0, null ] ], results.json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test aggregation per group, with both collect methods
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateGroups : function () {
+      [ "sorted", "hash" ].forEach(function(method) {
+        var query = "FOR i IN " + c.name() + " COLLECT group = i.group AGGREGATE length = LENGTH(i), min = MIN(i.value), max = MAX(i.value), sum = SUM(i.value), avg = AVERAGE(i.value) OPTIONS { method: '" + method + "' } SORT group RETURN { group: group, length: length, min: min, max: max, sum: sum, avg: avg }";
+
+        var expected = AQL_EXECUTE("FOR i IN " + c.name() + " COLLECT group = i.group INTO g SORT group RETURN { group: group, length: LENGTH(g), min: MIN(g[*].i.value), max: MAX(g[*].i.value), sum: SUM(g[*].i.value), avg: AVERAGE(g[*].i.value) }").json;
+
+        var results = AQL_EXECUTE(query);
+        assertEqual(10, results.json.length);
+        assertEqual(expected, results.json);
+        assertEqual({ group: "test3", length: 200, min: 3, max: 1993, sum: 199600, avg: 998 }, results.json[3]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test aggregation of expressions and nulls
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateExpressions : function () {
+      var query = "FOR i IN " + c.name() + " COLLECT group = i.value % 2 AGGREGATE min = MIN(i.value >= 1000 ? null : i.value), max = MAX(CONCAT('x', i.value)), sum = SUM(i.value < 4 ? i.value : null), avg = AVG(i.missing) SORT group RETURN [ group, min, max, sum, avg ]";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual([ [ 0, 0, "x998", 2, null ], [ 1, 1, "x999", 4, null ] ], results.json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test invalid values for SUM
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateSumInvalid : function () {
+      var query = "FOR i IN " + c.name() + " COLLECT AGGREGATE sum = SUM(i.group), avg = AVERAGE(i.value) RETURN [ sum, avg ]";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual([ [ null, 999.5 ] ], results.json);
+      assertEqual(errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH.code, results.warnings[0].code);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test aggregation inside a subquery
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateSubquery : function () {
+      var query = "FOR j IN [ 'test1', 'test2' ] LET s = (FOR i IN " + c.name() + " FILTER i.group == j COLLECT AGGREGATE max = MAX(i.value) RETURN max) RETURN s[0]";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual([ 1991, 1992 ], results.json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test explain output
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateExplain : function () {
+      var query = "FOR i IN " + c.name() + " COLLECT group = i.group AGGREGATE sum = SUM(i.value) RETURN [ group, sum ]";
+
+      var nodes = AQL_EXPLAIN(query, null, { allPlans: true }).plans[0].nodes.filter(function(node) {
+        return node.type === "AggregateNode";
+      });
+      assertEqual(1, nodes.length);
+      assertEqual(1, nodes[0].aggregateFunctions.length);
+      assertEqual("sum", nodes[0].aggregateFunctions[0].outVariable.name);
+      assertEqual("SUM", nodes[0].aggregateFunctions[0].type);
+      // the argument is evaluated by a calculation in front of the COLLECT
+      assertEqual("#", nodes[0].aggregateFunctions[0].inVariable.name[0]);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerAggregateTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
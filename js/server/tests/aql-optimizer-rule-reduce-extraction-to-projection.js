@@ -0,0 +1,183 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "reduce-extraction-to-projection";
+  // various choices to control the optimizer:
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var c, e;
+
+  var getProjections = function (result) {
+    var nodes = result.plan.nodes.filter(function(node) { 
+      return node.type === "EnumerateCollectionNode" || node.type === "IndexRangeNode"; 
+    });
+    assertEqual(1, nodes.length);
+    return nodes[0].projections;
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      db._drop("UnitTestsEdges");
+      c = db._create("UnitTestsCollection");
+      c.ensureSkiplist("value");
+      e = db._createEdgeCollection("UnitTestsEdges");
+
+      for (var i = 0; i < 2000; ++i) {
+        c.save({ _key: "test" + i, value: i, group: i % 7, sub: { a: i, b: [ i ] } });
+      }
+      for (i = 0; i < 100; ++i) {
+        e.save(c.name() + "/test" + i, c.name() + "/test" + (i + 1), { value: i });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+      db._drop("UnitTestsEdges");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [
+        "FOR i IN " + c.name() + " RETURN i.value",
+        "FOR i IN " + c.name() + " FILTER i.value > 10 RETURN [ i.group, i.value ]"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+
+        result = AQL_EXPLAIN(query, { }, paramDisabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        "FOR i IN " + c.name() + " RETURN i", // complete document returned
+        "FOR i IN " + c.name() + " RETURN 1", // document not used at all
+        "FOR i IN " + c.name() + " RETURN MERGE(i, { a: 1 })", // passed to a function
+        "FOR i IN " + c.name() + " RETURN HAS(i, 'value')", // passed to a function
+        "FOR i IN " + c.name() + " RETURN i['0']", // indexed access
+        "FOR i IN " + c.name() + " SORT i RETURN i.value", // sorted by document
+        "FOR i IN " + c.name() + " COLLECT g = i.group INTO docs RETURN g", // document kept in groups
+        "FOR i IN " + c.name() + " LET x = (FOR j IN 1..2 RETURN i) RETURN x", // used in subquery
+        "FOR i IN " + c.name() + " REMOVE i IN " + c.name() // used in modification
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        [ "FOR i IN " + c.name() + " RETURN i.value", [ "value" ] ],
+        [ "FOR i IN " + c.name() + " FILTER i.group == 3 RETURN [ i.value, i._key ]", [ "_key", "group", "value" ] ],
+        [ "FOR i IN " + c.name() + " RETURN i.sub.a", [ "sub" ] ],
+        [ "FOR i IN " + c.name() + " LET x = (FOR j IN 1..2 RETURN i.value + j) RETURN [ i._id, x ]", [ "_id", "value" ] ],
+        [ "FOR i IN " + c.name() + " FILTER i.value == 3 RETURN [ i.value, i.group ]", [ "group", "value" ] ],
+        [ "FOR i IN " + e.name() + " RETURN [ i._from, i._to ]", [ "_from", "_to" ] ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, { optimizer: { rules: [ "+all" ] } });
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+        assertEqual(query[1], getProjections(result), query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [
+        "FOR i IN " + c.name() + " SORT i.value RETURN i.value",
+        "FOR i IN " + c.name() + " FILTER i.group == 3 SORT i.value RETURN [ i.value, i._key, i._id, i._rev ]",
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN [ i.sub.a, i.sub.b[0], i.sub.c, i.missing ]",
+        "FOR i IN " + c.name() + " FILTER i.value >= 10 && i.value < 20 SORT i.value RETURN { v: i.value, g: i.group }",
+        "FOR i IN " + c.name() + " FILTER i.value == 17 RETURN [ i._from, i._to, i._key ]",
+        "FOR i IN " + c.name() + " COLLECT g = i.group AGGREGATE s = SUM(i.value) RETURN [ g, s ]",
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 5 LET x = (FOR j IN 1..2 RETURN i.value + j) RETURN x",
+        "FOR i IN " + e.name() + " SORT i.value RETURN [ i._from, i._to, i.value ]"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, paramDisabled).json;
+        var actual = AQL_EXECUTE(query, { }, { optimizer: { rules: [ "+all" ] } }).json;
+        assertEqual(expected, actual, query);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
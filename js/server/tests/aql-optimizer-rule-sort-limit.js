@@ -0,0 +1,181 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "sort-limit";
+  // various choices to control the optimizer:
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var c;
+
+  var getSortNode = function (result) {
+    var nodes = result.plan.nodes.filter(function(node) { return node.type === "SortNode"; });
+    assertEqual(1, nodes.length);
+    return nodes[0];
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      for (var i = 0; i < 5000; ++i) {
+        c.save({ value: i, group: i % 7 });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i",
+        "FOR i IN " + c.name() + " SORT i.value DESC LIMIT 5, 10 RETURN i"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertEqual(0, getSortNode(result).limit, query);
+
+        result = AQL_EXPLAIN(query, { }, paramDisabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertEqual(0, getSortNode(result).limit, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        "FOR i IN " + c.name() + " SORT i.value RETURN i", // no limit
+        "FOR i IN " + c.name() + " LIMIT 10 SORT i.value RETURN i", // limit before sort
+        "FOR i IN " + c.name() + " SORT i.value FILTER i.group == 1 LIMIT 10 RETURN i", // filter in between
+        "FOR i IN " + c.name() + " SORT i.value FOR j IN 1..2 LIMIT 10 RETURN i", // enumeration in between
+        "FOR i IN " + c.name() + " SORT i.value LET x = FAIL(1) LIMIT 10 RETURN x" // calculation may throw
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertEqual(0, getSortNode(result).limit, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect with fullCount
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffectFullCount : function () {
+      var query = "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i";
+      var result = AQL_EXPLAIN(query, { }, { fullCount: true, optimizer: { rules: [ "-all", "+" + ruleName ] } });
+      assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      assertEqual(0, getSortNode(result).limit, query);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        [ "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i", 10 ],
+        [ "FOR i IN " + c.name() + " SORT i.value DESC LIMIT 5, 10 RETURN i", 15 ],
+        [ "FOR i IN " + c.name() + " SORT i.group, i.value LIMIT 0, 1 RETURN i", 1 ],
+        [ "FOR i IN " + c.name() + " SORT i.value LET x = i.value + 1 LIMIT 3 RETURN x", 3 ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+        assertEqual(query[1], getSortNode(result).limit, query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.value DESC LIMIT 5, 10 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.group DESC, i.value LIMIT 100, 20 RETURN [ i.group, i.value ]",
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 4990, 20 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 6000 RETURN i.value",
+        "FOR i IN 1..3 LET values = (FOR j IN " + c.name() + " SORT j.value DESC LIMIT i RETURN j.value) RETURN values"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, paramNone).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
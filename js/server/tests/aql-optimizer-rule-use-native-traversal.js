@@ -0,0 +1,331 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, fail, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "use-native-traversal";
+  // various choices to control the optimizer:
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var vn = "UnitTestsVertices";
+  var vn2 = "UnitTestsOtherVertices";
+  var en = "UnitTestsEdges";
+
+  var countTraversalNodes = function (result) {
+    return result.plan.nodes.filter(function(node) { return node.type === "TraversalNode"; }).length;
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(vn);
+      db._drop(en);
+      var v = db._create(vn);
+      var e = db._createEdgeCollection(en);
+      var i;
+
+      // a tree with some cross links and a cycle
+      for (i = 0; i < 40; ++i) {
+        v.save({ _key: "v" + i, value: i, even: (i % 2 === 0) });
+      }
+      for (i = 1; i < 40; ++i) {
+        e.save(vn + "/v" + Math.floor((i - 1) / 3), vn + "/v" + i, { weight: i % 4 });
+      }
+      e.save(vn + "/v7", vn + "/v2", { weight: 9 });
+      e.save(vn + "/v12", vn + "/v0", { weight: 9 });
+      e.save(vn + "/v3", vn + "/v3", { weight: 9 });
+      // edge pointing to a non-existing vertex
+      e.save(vn + "/v1", vn + "/missing", { weight: 9 });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(vn);
+      db._drop(vn2);
+      db._drop(en);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') RETURN t",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'any', { maxDepth: 2 }) RETURN t"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertEqual(0, countTraversalNodes(result), query);
+
+        result = AQL_EXPLAIN(query, { }, paramDisabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertEqual(0, countTraversalNodes(result), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        // direction not constant
+        "FOR d IN [ 'outbound' ] FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', d) RETURN t",
+        // options not constant
+        "FOR d IN [ 1 ] FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound', { maxDepth: d }) RETURN t",
+        // unsupported options
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound', { order: 'postorder' }) RETURN t",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound', { visitor: 'foo::bar' }) RETURN t",
+        // not used in a FOR loop
+        "RETURN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound')"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertEqual(0, countTraversalNodes(result), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') RETURN t",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", '" + vn + "/v0', 'inbound', { paths: true }) RETURN t",
+        "FOR v IN " + vn + " FOR t IN TRAVERSAL(" + vn + ", " + en + ", v, 'any', { maxDepth: 1 }) RETURN t",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound', { strategy: 'breadthfirst', uniqueness: { vertices: 'global' } }) RETURN t"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertEqual(1, countTraversalNodes(result), query);
+
+        result = AQL_EXPLAIN(query);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertEqual(1, countTraversalNodes(result), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var prefix = "FOR t IN TRAVERSAL(" + vn + ", " + en + ", ";
+      var queries = [
+        prefix + "'v0', 'outbound') RETURN t.vertex._key",
+        prefix + "'v0', 'outbound', { paths: true }) RETURN t",
+        prefix + "'" + vn + "/v5', 'inbound', { paths: true }) RETURN t",
+        prefix + "'v1', 'any', { maxDepth: 3 }) RETURN t.vertex._key",
+        prefix + "'v1', 'any', { minDepth: 2, maxDepth: 3, paths: true }) RETURN t",
+        prefix + "'v0', 'outbound', { maxDepth: null }) RETURN t.vertex._key",
+        prefix + "'v0', 'any', { strategy: 'breadthfirst', maxDepth: 3 }) RETURN t.vertex._key",
+        prefix + "'v0', 'any', { strategy: 'breadthfirst', uniqueness: { vertices: 'global', edges: 'none' } }) RETURN t.vertex._key",
+        prefix + "'v0', 'any', { uniqueness: { vertices: 'path', edges: 'global' }, paths: true }) RETURN t",
+        prefix + "'v0', 'any', { strategy: 'breadthfirst', uniqueness: { vertices: 'path' }, maxDepth: 4 }) RETURN t.vertex._key",
+        prefix + "'v0', 'outbound', { followEdges: [ { weight: 1 }, { weight: 2 } ] }) RETURN t.vertex._key",
+        prefix + "'v0', 'outbound', { filterVertices: [ { even: true } ] }) RETURN t.vertex._key",
+        prefix + "'v0', 'outbound', { filterVertices: [ { even: true } ], vertexFilterMethod: [ 'exclude' ] }) RETURN t.vertex._key",
+        prefix + "'v0', 'outbound', { filterVertices: [ { even: false } ], vertexFilterMethod: 'prune' }) RETURN t.vertex._key",
+        prefix + "{ _id: '" + vn + "/v3' }, 'outbound', { paths: true }) RETURN t",
+        prefix + "'missing', 'outbound') RETURN t",
+        prefix + "'v0', 'outbound') LIMIT 3, 5 RETURN t.vertex._key",
+        "FOR v IN " + vn + " SORT v.value FOR t IN TRAVERSAL(" + vn + ", " + en + ", v, 'outbound', { maxDepth: 2 }) RETURN [ v._key, t.vertex._key ]"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, paramNone).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+
+        actual = AQL_EXECUTE(query).json;
+        assertEqual(expected, actual, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test maxIterations
+////////////////////////////////////////////////////////////////////////////////
+
+    testMaxIterations : function () {
+      var query = "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound', { maxIterations: 5 }) RETURN t";
+
+      try {
+        AQL_EXECUTE(query, { }, paramEnabled);
+        fail();
+      }
+      catch (err) {
+        assertEqual(require("internal").errors.ERROR_GRAPH_TOO_MANY_ITERATIONS.code, err.errorNum);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test edges into a second vertex collection
+////////////////////////////////////////////////////////////////////////////////
+
+    testSecondVertexCollection : function () {
+      db._drop(vn2);
+      var v2 = db._create(vn2);
+      var e = db._collection(en);
+      var i;
+
+      for (i = 0; i < 5; ++i) {
+        v2.save({ _key: "w" + i, value: 100 + i });
+      }
+      e.save(vn + "/v39", vn2 + "/w0", { weight: 1 });
+      e.save(vn2 + "/w0", vn2 + "/w1", { weight: 1 });
+      e.save(vn2 + "/w1", vn + "/v38", { weight: 1 });
+      e.save(vn2 + "/w1", vn2 + "/w2", { weight: 1 });
+
+      // the second collection is part of the query, so its vertices are found
+      var queries = [
+        "LET n = LENGTH(" + vn2 + ") FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') RETURN [ n, t.vertex._id ]",
+        "LET n = LENGTH(" + vn2 + ") FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v39', 'any', { maxDepth: 4, paths: true }) RETURN [ n, t ]",
+        "LET n = LENGTH(" + vn2 + ") FOR t IN TRAVERSAL(" + vn + ", " + en + ", '" + vn2 + "/w1', 'inbound') RETURN [ n, t.vertex._id ]"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, paramNone).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+        assertNotEqual(-1, JSON.stringify(actual).indexOf(vn2 + "/w0"), query);
+      });
+
+      // the second collection is not part of the query. its vertices are read
+      // anyway, as the JavaScript traversal does
+      queries = [
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') RETURN t.vertex._id",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v39', 'any', { maxDepth: 4, paths: true }) RETURN t",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", '" + vn2 + "/w0', 'outbound') RETURN t.vertex._id",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.vertex.value >= 100 RETURN t.vertex"
+      ];
+
+      queries.forEach(function(query) {
+        assertEqual(1, countTraversalNodes(AQL_EXPLAIN(query, { }, paramEnabled)), query);
+
+        var expected = AQL_EXECUTE(query, { }, paramNone).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+        assertNotEqual(-1, JSON.stringify(actual).indexOf(vn2 + "/w"), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that FILTERs on the vertex are moved into the traversal
+////////////////////////////////////////////////////////////////////////////////
+
+    testFiltersMovedIntoTraversal : function () {
+      var queries = [
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.vertex.value == 4 RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.vertex.value < 10 RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER 10 < t.vertex.value RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.vertex.value != 3 RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'any', { maxDepth: 3 }) FILTER t.vertex._key IN [ 'v1', 'v5', 'v30', 'foo' ] RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.vertex.even == true && t.vertex.value >= 20 RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.vertex.sub.value == 7 RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.vertex.missing == null RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') LET k = t.vertex._key FILTER t.vertex.value > 30 RETURN k",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.vertex.value > 5 LIMIT 3 RETURN t.vertex._key"
+      ];
+
+      db._collection(vn).update(vn + "/v7", { sub: { value: 7 } });
+
+      queries.forEach(function(query) {
+        var plan = AQL_EXPLAIN(query, { }, paramEnabled).plan;
+        assertEqual(1, countTraversalNodes({ plan: plan }), query);
+        assertEqual(0, plan.nodes.filter(function(node) { return node.type === "FilterNode"; }).length, query);
+        assertTrue(plan.nodes.filter(function(node) { return node.type === "TraversalNode"; })[0].vertexConditions.length > 0, query);
+
+        var expected = AQL_EXECUTE(query, { }, paramNone).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that other FILTERs are left alone
+////////////////////////////////////////////////////////////////////////////////
+
+    testFiltersNotMovedIntoTraversal : function () {
+      var queries = [
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.vertex.value == 4 || t.vertex.value == 5 RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.edge.weight == 1 RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER t.vertex.value == t.vertex.value RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') FILTER 3 IN t.vertex.values RETURN t.vertex._key",
+        "FOR t IN TRAVERSAL(" + vn + ", " + en + ", 'v0', 'outbound') LIMIT 5 FILTER t.vertex.value == 4 RETURN t.vertex._key"
+      ];
+
+      queries.forEach(function(query) {
+        var plan = AQL_EXPLAIN(query, { }, paramEnabled).plan;
+        assertEqual(1, countTraversalNodes({ plan: plan }), query);
+        assertEqual(1, plan.nodes.filter(function(node) { return node.type === "FilterNode"; }).length, query);
+
+        var expected = AQL_EXECUTE(query, { }, paramNone).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
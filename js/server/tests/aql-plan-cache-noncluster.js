@@ -0,0 +1,222 @@
+/*jshint globalstrict:false, strict:false */
+/*global assertEqual, assertTrue */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for the AQL plan cache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+var queries = require("org/arangodb/aql/queries");
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        plan cache
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite: plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+function PlanCacheSuite () {
+  var cn = "UnitTestsPlanCache";
+  var c;
+
+  var execute = function (query, bindVars) {
+    return internal.db._query(query, bindVars, null, { cachePlan: true }).toArray();
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      internal.db._drop(cn);
+      c = internal.db._create(cn);
+
+      for (var i = 0; i < 100; ++i) {
+        c.save({ _key: "test" + i, value: i, name: "name" + (i % 10) });
+      }
+
+      queries.clearPlanCache();
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      internal.db._drop(cn);
+      queries.clearPlanCache();
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a plan is only cached when the option is set
+////////////////////////////////////////////////////////////////////////////////
+
+    testCacheOption : function () {
+      var query = "FOR doc IN " + cn + " FILTER doc.value == 1 RETURN doc.value";
+      var before = queries.planCache();
+
+      internal.db._query(query).toArray();
+      assertEqual(before.misses, queries.planCache().misses);
+      assertEqual(0, queries.planCache().plans);
+
+      assertEqual([ 1 ], execute(query, { }));
+      assertEqual(before.misses + 1, queries.planCache().misses);
+      assertEqual(1, queries.planCache().plans);
+
+      // differences in whitespace do not matter
+      assertEqual([ 1 ], execute(query.replace(/ /g, "   "), { }));
+      assertEqual(before.hits + 1, queries.planCache().hits);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a compared bind parameter shares one plan for all values
+////////////////////////////////////////////////////////////////////////////////
+
+    testTemplatedParameter : function () {
+      var query = "FOR doc IN " + cn + " FILTER doc.name == @name SORT doc.value RETURN doc.value";
+      var before = queries.planCache();
+
+      for (var i = 0; i < 10; ++i) {
+        assertEqual([ i, i + 10, i + 20, i + 30, i + 40, i + 50, i + 60, i + 70, i + 80, i + 90 ],
+                    execute(query, { name: "name" + i }));
+      }
+
+      var after = queries.planCache();
+      assertEqual(before.misses + 1, after.misses);
+      assertEqual(before.hits + 9, after.hits);
+      assertEqual(1, after.plans);
+
+      // a value of another type needs another plan
+      assertEqual([ ], execute(query, { name: 1 }));
+      assertEqual(after.misses + 1, queries.planCache().misses);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief numeric bind parameters
+////////////////////////////////////////////////////////////////////////////////
+
+    testNumericParameter : function () {
+      var query = "FOR doc IN " + cn + " FILTER doc.value >= @min RETURN doc.value";
+
+      for (var i = 0; i < 100; i += 7) {
+        assertEqual(100 - i, execute(query, { min: i }).length);
+      }
+
+      assertEqual(1, queries.planCache().plans);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bind parameters that the optimizer may combine are cached per value
+////////////////////////////////////////////////////////////////////////////////
+
+    testExactParameters : function () {
+      var query = "FOR doc IN " + cn + " FILTER doc.value > @min && doc.value < @max " +
+                  "SORT doc.value LIMIT @limit RETURN doc.value";
+
+      assertEqual([ 11, 12, 13 ], execute(query, { min: 10, max: 20, limit: 3 }));
+      assertEqual([ 51, 52 ], execute(query, { min: 50, max: 53, limit: 5 }));
+      assertEqual([ 11, 12, 13 ], execute(query, { min: 10, max: 20, limit: 3 }));
+      assertEqual([ ], execute(query, { min: 20, max: 10, limit: 3 }));
+
+      assertEqual(3, queries.planCache().plans);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creating or dropping an index invalidates the cache
+////////////////////////////////////////////////////////////////////////////////
+
+    testInvalidateIndex : function () {
+      var query = "FOR doc IN " + cn + " FILTER doc.value == @value RETURN doc._key";
+
+      assertEqual([ "test42" ], execute(query, { value: 42 }));
+      assertEqual(1, queries.planCache().plans);
+
+      var before = queries.planCache().invalidations;
+      var idx = c.ensureHashIndex("value");
+      assertTrue(queries.planCache().invalidations > before);
+      assertEqual(0, queries.planCache().plans);
+
+      assertEqual([ "test43" ], execute(query, { value: 43 }));
+      var plan = internal.db._createStatement({ query: query, bindVars: { value: 43 } }).explain().plan;
+      assertEqual(1, plan.nodes.filter(function (node) { return node.type === "IndexRangeNode"; }).length);
+
+      c.dropIndex(idx);
+      assertEqual(0, queries.planCache().plans);
+      assertEqual([ "test44" ], execute(query, { value: 44 }));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dropping a collection invalidates the cache
+////////////////////////////////////////////////////////////////////////////////
+
+    testInvalidateDrop : function () {
+      var query = "FOR doc IN " + cn + " FILTER doc.value == @value RETURN doc._key";
+
+      assertEqual([ "test1" ], execute(query, { value: 1 }));
+
+      internal.db._drop(cn);
+      assertEqual(0, queries.planCache().plans);
+
+      c = internal.db._create(cn);
+      c.save({ _key: "foo", value: 1 });
+      assertEqual([ "foo" ], execute(query, { value: 1 }));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clearing the cache
+////////////////////////////////////////////////////////////////////////////////
+
+    testClear : function () {
+      execute("FOR doc IN " + cn + " RETURN 1", { });
+      assertEqual(1, queries.planCache().plans);
+
+      queries.clearPlanCache();
+      assertEqual(0, queries.planCache().plans);
+    }
+
+  };
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                              main
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(PlanCacheSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
+
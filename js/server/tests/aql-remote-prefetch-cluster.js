@@ -0,0 +1,190 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global fail, assertEqual, assertTrue, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for prefetching remote blocks in the cluster
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var db = require("org/arangodb").db;
+var jsunity = require("jsunity");
+var helper = require("org/arangodb/aql-helper");
+var errors = require("internal").errors;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+///
+/// the coordinator keeps one getSome request per remote block in flight. the
+/// queries below stop consuming, fail or re-initialize the remote blocks
+/// while such a request is pending
+////////////////////////////////////////////////////////////////////////////////
+
+function remotePrefetchTestSuite () {
+  var cn = "UnitTestsRemotePrefetch";
+  var n = 6000;
+  var c;
+
+  var explain = function (query) {
+    return helper.getCompactPlan(AQL_EXPLAIN(query)).map(function(node) {
+      return node.type;
+    });
+  };
+
+  var range = function (from, to) {
+    var result = [ ];
+    for (var i = from; i < to; ++i) {
+      result.push(i);
+    }
+    return result;
+  };
+
+  // the collection must still be usable after a query left a prefetch behind
+  var checkUsable = function () {
+    assertEqual([ n ], AQL_EXECUTE("RETURN LENGTH(" + cn + ")").json);
+    assertEqual(10, AQL_EXECUTE("FOR d IN " + cn + " LIMIT 10 RETURN d").json.length);
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn, { numberOfShards: 3 });
+
+      for (var i = 0; i < n; ++i) {
+        c.save({ value: i });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+      c = null;
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief all rows arrive exactly once, concatenated and merged
+////////////////////////////////////////////////////////////////////////////////
+
+    testFetchAll : function () {
+      var query = "FOR d IN " + cn + " RETURN d.value";
+      assertTrue(explain(query).indexOf("RemoteNode") !== -1, query);
+
+      var actual = AQL_EXECUTE(query).json;
+      actual.sort(function (l, r) { return l - r; });
+      assertEqual(range(0, n), actual);
+
+      query = "FOR d IN " + cn + " SORT d.value RETURN d.value";
+      assertEqual(range(0, n), AQL_EXECUTE(query).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief LIMIT stops consuming while a prefetch is in flight. the shutdown
+/// must discard it
+////////////////////////////////////////////////////////////////////////////////
+
+    testLimitCancelsPrefetch : function () {
+      var query = "FOR d IN " + cn + " LIMIT 10 RETURN d.value";
+
+      for (var i = 0; i < 10; ++i) {
+        assertEqual(10, AQL_EXECUTE(query).json.length);
+      }
+
+      query = "FOR d IN " + cn + " SORT d.value LIMIT 1500, 10 RETURN d.value";
+      assertEqual(range(1500, 1510), AQL_EXECUTE(query).json);
+
+      checkUsable();
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skipping consumes prefetched rows first
+////////////////////////////////////////////////////////////////////////////////
+
+    testSkipPrefetched : function () {
+      var query = "FOR d IN " + cn + " LIMIT 1000, 2000 RETURN d.value";
+      assertEqual(2000, AQL_EXECUTE(query).json.length);
+
+      var result = AQL_EXECUTE(query, { }, { fullCount: true });
+      assertEqual(2000, result.json.length);
+      assertEqual(n, result.stats.fullCount);
+
+      checkUsable();
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief errors raised on the DB server are reported with their error code,
+/// also when they are raised by a prefetched request
+////////////////////////////////////////////////////////////////////////////////
+
+    testErrorInPrefetchedRequest : function () {
+      var query = "FOR d IN " + cn + " RETURN d.value == " + (n - 10) + " ? FAIL('prefetch failure') : d.value";
+
+      // the calculation must be executed on the DB servers
+      var nodes = explain(query);
+      assertTrue(nodes.indexOf("CalculationNode") < nodes.indexOf("RemoteNode"), nodes);
+
+      for (var i = 0; i < 3; ++i) {
+        try {
+          AQL_EXECUTE(query);
+          fail();
+        }
+        catch (err) {
+          assertEqual(errors.ERROR_QUERY_FAIL_CALLED.code, err.errorNum);
+        }
+      }
+
+      checkUsable();
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remote blocks in a subquery are re-initialized for every outer row,
+/// which discards their prefetched data
+////////////////////////////////////////////////////////////////////////////////
+
+    testReinitializeDiscardsPrefetch : function () {
+      var query = "FOR i IN 1..5 LET sub = (FOR d IN " + cn + " FILTER d.value >= i LIMIT 3 RETURN d.value) RETURN LENGTH(sub)";
+      assertEqual([ 3, 3, 3, 3, 3 ], AQL_EXECUTE(query).json);
+
+      query = "FOR i IN 1..3 LET sub = (FOR d IN " + cn + " RETURN 1) RETURN LENGTH(sub)";
+      assertEqual([ n, n, n ], AQL_EXECUTE(query).json);
+
+      checkUsable();
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(remotePrefetchTestSuite);
+
+return jsunity.done();
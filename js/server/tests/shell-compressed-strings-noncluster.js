@@ -0,0 +1,198 @@
+/*jshint globalstrict:false, strict:false */
+/*global fail, assertEqual, assertTrue, assertFalse */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test collections with compressed strings
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                compressed strings
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite: compressed strings
+////////////////////////////////////////////////////////////////////////////////
+
+function CompressedStringsSuite () {
+  var ERRORS = internal.errors;
+  var cn = "UnitTestsCompressedStrings";
+  var c;
+
+  var longString = function (prefix, n) {
+    var s = prefix;
+    for (var i = 0; i < n; ++i) {
+      s += " the quick brown fox jumps over the lazy dog " + (i % 10);
+    }
+    return s;
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      internal.db._drop(cn);
+      c = internal.db._create(cn, { compressStrings : true });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      internal.db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the property is reported and cannot be changed
+////////////////////////////////////////////////////////////////////////////////
+
+    testProperties : function () {
+      assertTrue(c.properties().compressStrings);
+
+      try {
+        c.properties({ compressStrings : false });
+        fail();
+      }
+      catch (err) {
+        assertEqual(ERRORS.ERROR_BAD_PARAMETER.code, err.errorNum);
+      }
+
+      c.unload();
+      c = null;
+      internal.wait(2);
+      c = internal.db._collection(cn);
+      assertTrue(c.properties().compressStrings);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief strings of all lengths survive a round trip
+////////////////////////////////////////////////////////////////////////////////
+
+    testRoundTrip : function () {
+      var values = [ "", "a", "foo", longString("x", 1), longString("y", 10), longString("z", 1000) ];
+
+      values.forEach(function (value, i) {
+        c.save({ _key: "test" + i, value: value, nested: { list: [ value, value ] } });
+      });
+
+      values.forEach(function (value, i) {
+        var doc = c.document("test" + i);
+        assertEqual(value, doc.value);
+        assertEqual([ value, value ], doc.nested.list);
+      });
+
+      var result = internal.db._query("FOR doc IN " + cn + " SORT doc._key RETURN doc.value").toArray();
+      assertEqual(values, result);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief random data that does not compress is stored as is
+////////////////////////////////////////////////////////////////////////////////
+
+    testIncompressible : function () {
+      var value = "";
+      for (var i = 0; i < 1000; ++i) {
+        value += String.fromCharCode(33 + Math.floor(Math.random() * 90));
+      }
+
+      c.save({ _key: "test", value: value });
+      assertEqual(value, c.document("test").value);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compressed strings can be found by example and in indexes
+////////////////////////////////////////////////////////////////////////////////
+
+    testIndexes : function () {
+      c.ensureHashIndex("value");
+      c.ensureSkiplist("sorted");
+      c.ensureFulltextIndex("text");
+
+      for (var i = 0; i < 20; ++i) {
+        c.save({ value: longString("value" + (i % 5), 20),
+                 sorted: longString(String.fromCharCode(97 + (19 - i)), 20),
+                 text: longString("unicorn" + i, 20) });
+      }
+
+      assertEqual(4, c.byExample({ value: longString("value3", 20) }).toArray().length);
+      assertEqual(0, c.byExample({ value: longString("value7", 20) }).toArray().length);
+
+      var sorted = internal.db._query("FOR doc IN " + cn + " SORT doc.sorted RETURN doc.sorted").toArray();
+      assertEqual(20, sorted.length);
+      for (i = 1; i < sorted.length; ++i) {
+        assertTrue(sorted[i - 1] < sorted[i]);
+      }
+
+      var range = c.range("sorted", longString("c", 20), longString("f", 20)).toArray();
+      assertEqual(3, range.length);
+
+      assertEqual(1, c.fulltext("text", "unicorn7").toArray().length);
+      assertEqual(20, c.fulltext("text", "fox").toArray().length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief documents are unchanged after the collection was reloaded
+////////////////////////////////////////////////////////////////////////////////
+
+    testReload : function () {
+      var value = longString("reload", 100);
+      c.save({ _key: "test", value: value });
+
+      internal.wal.flush(true, true);
+      c.unload();
+      c = null;
+      internal.wait(2);
+
+      c = internal.db._collection(cn);
+      assertEqual(value, c.document("test").value);
+      assertFalse(c.properties().isVolatile);
+    }
+
+  };
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                              main
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(CompressedStringsSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
+
@@ -0,0 +1,279 @@
+/*jshint globalstrict:false, strict:false */
+/*global fail, assertEqual, assertTrue, assertFalse */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the primary index while it grows
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+var db = internal.db;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     primary index
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite: primary index growth
+///
+/// the primary index starts with 251 slots and is migrated into a table of
+/// about twice the size whenever it gets half full. the migration advances
+/// with every insert and remove, so the operations below run while the
+/// documents are spread over both tables
+////////////////////////////////////////////////////////////////////////////////
+
+function PrimaryIndexGrowthSuite () {
+  var cn = "UnitTestsPrimaryIndexGrowth";
+  var c;
+
+  // check all keys up to n against the expected state
+  var checkAll = function (n, live) {
+    var count = 0;
+
+    for (var i = 0; i < n; ++i) {
+      var key = "test" + i;
+
+      if (live.hasOwnProperty(key)) {
+        assertTrue(c.exists(key), key);
+        assertEqual(live[key], c.document(key).value);
+        ++count;
+      }
+      else {
+        assertFalse(c.exists(key), key);
+      }
+    }
+
+    assertEqual(count, c.count());
+  };
+
+  // full scan, which must see every document exactly once
+  var checkScan = function (live) {
+    var expected = Object.keys(live).map(function (key) {
+      return live[key];
+    }).sort(function (l, r) { return l - r; });
+
+    var actual = c.toArray().map(function (doc) {
+      return doc.value;
+    }).sort(function (l, r) { return l - r; });
+
+    assertEqual(expected, actual);
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts and removes across several growth thresholds
+////////////////////////////////////////////////////////////////////////////////
+
+    testGrowWithInterleavedRemoves : function () {
+      var i, n = 12000;
+      var live = { };
+
+      for (i = 0; i < n; ++i) {
+        var key = "test" + i;
+        c.save({ _key: key, value: i });
+        live[key] = i;
+        assertTrue(c.exists(key));
+
+        if (i % 3 === 2) {
+          // remove the document inserted before, while the table may be
+          // in migration
+          var removed = "test" + (i - 1);
+          c.remove(removed);
+          delete live[removed];
+          assertFalse(c.exists(removed));
+        }
+
+        // an older key that may still live in the old table
+        var old = "test" + Math.floor(i / 2);
+        assertEqual(live.hasOwnProperty(old), c.exists(old));
+
+        if (i % 128 === 0) {
+          checkAll(i + 1, live);
+        }
+      }
+
+      checkAll(n, live);
+      checkScan(live);
+
+      // the index is rebuilt on load
+      internal.wal.flush(true, true);
+      c.unload();
+      c = null;
+      internal.wait(2);
+      c = db._collection(cn);
+
+      checkAll(n, live);
+      checkScan(live);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief re-inserts removed keys while the index grows
+////////////////////////////////////////////////////////////////////////////////
+
+    testReinsertRemovedKeys : function () {
+      var i, n = 4000;
+      var live = { };
+
+      for (i = 0; i < n; ++i) {
+        c.save({ _key: "test" + i, value: i });
+        live["test" + i] = i;
+      }
+
+      for (i = 1; i < n; i += 2) {
+        c.remove("test" + i);
+        delete live["test" + i];
+      }
+
+      checkAll(n, live);
+
+      // re-insert the removed keys and grow the index further
+      for (i = 1; i < 3 * n; i += 2) {
+        c.save({ _key: "test" + i, value: i + n });
+        live["test" + i] = i + n;
+
+        if (i % 1024 === 1) {
+          checkAll(3 * n, live);
+        }
+      }
+
+      checkAll(3 * n, live);
+      checkScan(live);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief grows the index inside a transaction and rolls it back
+////////////////////////////////////////////////////////////////////////////////
+
+    testGrowInTransactionRollback : function () {
+      var i, n = 5000;
+      var live = { };
+
+      for (i = 0; i < 100; ++i) {
+        c.save({ _key: "test" + i, value: i });
+        live["test" + i] = i;
+      }
+
+      var mismatches = null;
+
+      try {
+        db._executeTransaction({
+          collections: { write: cn },
+          action: function () {
+            var i;
+
+            for (i = 100; i < n; ++i) {
+              c.save({ _key: "test" + i, value: i });
+
+              if (i % 2 === 0) {
+                // removes the keys 50 to n / 2 - 1
+                c.remove("test" + (i / 2));
+              }
+            }
+
+            mismatches = [ ];
+            for (i = 0; i < n; ++i) {
+              var expected = (i < 50 || i >= n / 2);
+              if (expected !== c.exists("test" + i)) {
+                mismatches.push(i);
+              }
+            }
+
+            throw "rollback";
+          }
+        });
+        fail();
+      }
+      catch (err) {
+      }
+
+      assertEqual([ ], mismatches);
+
+      // the rollback removes the inserted documents and re-inserts the
+      // removed ones, again crossing growth thresholds
+      checkAll(n, live);
+      checkScan(live);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief truncate during growth
+////////////////////////////////////////////////////////////////////////////////
+
+    testTruncateAndGrow : function () {
+      var i, n = 3000;
+      var live = { };
+
+      for (i = 0; i < n; ++i) {
+        c.save({ _key: "test" + i, value: i });
+      }
+
+      c.truncate();
+      checkAll(n, live);
+
+      for (i = 0; i < n; ++i) {
+        c.save({ _key: "test" + i, value: -i });
+        live["test" + i] = -i;
+      }
+
+      checkAll(n, live);
+      checkScan(live);
+    }
+
+  };
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                              main
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(PrimaryIndexGrowthSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
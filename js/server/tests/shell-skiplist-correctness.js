@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false */
-/*global assertEqual */
+/*global assertEqual, assertTrue, AQL_EXPLAIN */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test the correctness of a skip-list index
@@ -286,6 +286,72 @@ function SkipListCorrSuite() {
                   "FOR x IN "+cn+" FILTER x.v > 4 RETURN x").length, 2);
       assertEqual(getQueryResults(
                   "FOR x IN "+cn+" FILTER x.v >= 4 RETURN x").length, 3);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: index order and range queries over values whose key prefixes
+/// decide the order, or must not decide it
+////////////////////////////////////////////////////////////////////////////////
+
+    testCorrectnessKeyPrefixes : function () {
+      var p = "abcdefghijklmnopqrstuvwxyz0123456789";
+      var values = [
+        null, false, true,
+        -1e300, -1000.5, -1, -0.5, -1e-300, -0, 0, 1e-300, 0.5, 1, 2, 10, 1000.5, 1e300,
+        "", " ", "0", "1", "10", "9", "a", "A", "ab", "äb", "b", "Müller", "Mueller",
+        // strings longer than the key prefix, and equal up to the prefix
+        p, p + "a", p + "B", p + "b", p.substr(0, 21), p.substr(0, 22), p.substr(0, 21) + "z",
+        "€€€€€€€€€€", "€€€€€€€€€€€", "€€€€€€€€€€a",
+        [ ], [ 1 ], [ 1, 2 ], [ null ], [ "a" ],
+        { }, { a: 1 }, { a: "b" }
+      ];
+
+      coll.ensureSkiplist("v");
+      coll.ensureSkiplist("a", "v");
+
+      values.forEach(function (value, i) {
+        // w is not indexed
+        coll.save({ v: value, w: value, a: i % 3 });
+        coll.save({ v: value, w: value, a: (i + 1) % 3 });
+      });
+
+      var indexed = "FOR x IN " + cn + " SORT x.v RETURN x.v";
+      var nodes = AQL_EXPLAIN(indexed).plan.nodes.map(function (node) {
+        return node.type;
+      });
+      assertEqual(-1, nodes.indexOf("SortNode"));
+      assertTrue(nodes.indexOf("IndexRangeNode") !== -1);
+
+      // the index order is the order of AQL
+      assertEqual(getQueryResults("FOR x IN " + cn + " SORT x.w RETURN x.w"),
+                  getQueryResults(indexed));
+      assertEqual(getQueryResults("FOR x IN " + cn + " SORT x.a, x.w RETURN [ x.a, x.w ]"),
+                  getQueryResults("FOR x IN " + cn + " SORT x.a, x.v RETURN [ x.a, x.v ]"));
+
+      [ "==", "<", "<=", ">", ">=" ].forEach(function (op) {
+        values.forEach(function (value) {
+          var bind = { value: value };
+
+          assertEqual(getQueryResults("FOR x IN " + cn + " FILTER x.w " + op + " @value SORT x.w RETURN x.w", bind),
+                      getQueryResults("FOR x IN " + cn + " FILTER x.v " + op + " @value SORT x.v RETURN x.v", bind),
+                      JSON.stringify(value) + " " + op);
+
+          assertEqual(getQueryResults("FOR x IN " + cn + " FILTER x.a == 1 && x.w " + op + " @value SORT x.w RETURN x.w", bind),
+                      getQueryResults("FOR x IN " + cn + " FILTER x.a == 1 && x.v " + op + " @value SORT x.v RETURN x.v", bind),
+                      JSON.stringify(value) + " " + op);
+        });
+      });
+
+      // ranges between two values
+      values.forEach(function (low) {
+        values.forEach(function (high) {
+          var bind = { low: low, high: high };
+
+          assertEqual(getQueryResults("FOR x IN " + cn + " FILTER x.w >= @low && x.w < @high SORT x.w RETURN x.w", bind),
+                      getQueryResults("FOR x IN " + cn + " FILTER x.v >= @low && x.v < @high SORT x.v RETURN x.v", bind),
+                      JSON.stringify(low) + " " + JSON.stringify(high));
+        });
+      });
     }
   };
 }
@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false */
-/*global fail, assertEqual, assertNotEqual  */
+/*global fail, assertEqual, assertNotEqual, assertTrue  */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test the skip-list index
@@ -728,6 +728,86 @@ function SkipListSuite() {
       
       result = collection.byConditionSkiplist(idx.id, { a: [["==", "1"]], b: [["==", "2"]] }).toArray();
       assertEqual(0, result.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: index creation and reload with many existing documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testCreationManyDocuments : function () {
+      var i, n = 50000;
+
+      for (i = 0; i < n; ++i) {
+        collection.save({ value: (i * 7919) % n, group: i % 3 });
+      }
+
+      var check = function () {
+        var result = collection.byConditionSkiplist(idx.id, { value: [[">=", 0]] }).toArray();
+        assertEqual(n, result.length);
+        for (i = 0; i < n; ++i) {
+          assertEqual(i, result[i].value);
+        }
+
+        result = collection.byConditionSkiplist(idx2.id, { group: [["==", 1]] }).toArray();
+        assertEqual(Math.floor(n / 3), result.length);
+
+        assertEqual(0, collection.figures().indexes.fillPending);
+      };
+
+      var idx = collection.ensureSkiplist("value", { unique: true });
+      var idx2 = collection.ensureSkiplist("group");
+      check();
+
+      // indexes are rebuilt on load
+      internal.wal.flush(true, true);
+      collection.unload();
+      internal.wait(2);
+      check();
+
+      // duplicates must be detected when building a unique index
+      collection.dropIndex(idx);
+      collection.save({ value: 17 });
+      try {
+        collection.ensureUniqueSkiplist("value");
+        fail();
+      }
+      catch (err) {
+        assertEqual(errors.ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED.code, err.errorNum);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: fill progress is reported while the index is being filled
+////////////////////////////////////////////////////////////////////////////////
+
+    testCreationFillProgress : function () {
+      if (! internal.debugCanUseFailAt()) {
+        return;
+      }
+
+      var i, n = 50000;
+
+      for (i = 0; i < n; ++i) {
+        collection.save({ value: i });
+      }
+
+      assertEqual(0, collection.figures().indexes.fillPending);
+
+      // with this failure point, only the progress reported while filling is
+      // subtracted from the figure, but not the rest when the index is done
+      internal.debugSetFailAt("FillIndex::keepPending");
+      try {
+        collection.ensureSkiplist("value");
+        var pending = collection.figures().indexes.fillPending;
+        assertTrue(pending >= 0);
+        assertTrue(pending < n / 2);
+
+        collection.ensureHashIndex("value");
+        assertEqual(pending, collection.figures().indexes.fillPending);
+      }
+      finally {
+        internal.debugClearFailAt();
+      }
     }
 
   };
@@ -187,6 +187,67 @@ function walFailureSuite () {
 
       internal.debugClearFailAt();
       assertEqual(1005, c.count());
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that waitForSync writes are synced before they are
+/// acknowledged while the synchroniser groups commits
+////////////////////////////////////////////////////////////////////////////////
+
+    testGroupCommitWaitForSync : function () {
+      var tasks = require("org/arangodb/tasks");
+      var rn = "UnitTestsWalResults";
+      var i, n = 200, numTasks = 4;
+
+      db._drop(rn);
+      var r = db._create(rn);
+
+      internal.debugSetFailAt("SynchroniserThread::maxGroupCommitDelay");
+      internal.debugSetFailAt("LogfileManager::requireSyncedWrite");
+
+      // a single writer
+      for (i = 0; i < 50; ++i) {
+        c.save({ _key: "single" + i }, true);
+      }
+
+      // concurrent writers, with and without waitForSync
+      for (i = 0; i < numTasks; ++i) {
+        tasks.register({
+          offset: 0,
+          params: { cn: cn, rn: rn, task: i, n: n },
+          command: function (params) {
+            var db = require("internal").db;
+            var c = db._collection(params.cn);
+            var errors = [ ];
+
+            for (var j = 0; j < params.n; ++j) {
+              try {
+                c.save({ _key: "task" + params.task + "-" + j }, j % 4 !== 0);
+              }
+              catch (err) {
+                errors.push(err.errorNum);
+              }
+            }
+
+            db._collection(params.rn).save({ task: params.task, errors: errors });
+          }
+        });
+      }
+
+      var tries = 0;
+      while (r.count() < numTasks && ++tries < 120) {
+        internal.wait(0.5);
+      }
+
+      internal.debugClearFailAt();
+
+      assertEqual(numTasks, r.count());
+      r.toArray().forEach(function (result) {
+        assertEqual([ ], result.errors, result.task);
+      });
+      assertEqual(50 + numTasks * n, c.count());
+
+      db._drop(rn);
     }
 
   };
@@ -274,6 +335,75 @@ function walSuite () {
       assertEqual(p.throttleWhenPending, result2.throttleWhenPending);
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test statistics
+////////////////////////////////////////////////////////////////////////////////
+
+    testReadStatistics : function () {
+      var s = internal.wal.statistics();
+
+      assertTrue(s.hasOwnProperty("pendingLogfiles"));
+      assertTrue(s.hasOwnProperty("pendingOperations"));
+      assertTrue(s.hasOwnProperty("collectorThreads"));
+      assertTrue(s.hasOwnProperty("writeThrottled"));
+      assertTrue(s.collectorThreads >= 1);
+
+      internal.wal.flush(true, true);
+
+      s = internal.wal.statistics();
+      assertEqual(0, s.pendingLogfiles);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect many collections at once
+////////////////////////////////////////////////////////////////////////////////
+
+    testCollectManyCollections : function () {
+      var i, j, n = 20;
+      var collections = [ ];
+
+      for (i = 0; i < n; ++i) {
+        db._drop(cn + i);
+        collections.push(db._create(cn + i));
+      }
+
+      internal.wal.flush(true, true);
+
+      for (j = 0; j < 100; ++j) {
+        for (i = 0; i < n; ++i) {
+          collections[i].save({ _key: "test" + j, value: j });
+          if (j % 10 === 0) {
+            collections[i].update("test0", { value: j });
+          }
+        }
+      }
+
+      internal.wal.flush(true, true);
+
+      for (i = 0; i < n; ++i) {
+        var tries = 0; 
+        var fig;
+        while (++tries < 20) {
+          fig = collections[i].figures();
+          if (fig.uncollectedLogfileEntries === 0) {
+            break;
+          }
+          internal.wait(1, false);
+        }
+
+        assertEqual(0, fig.uncollectedLogfileEntries);
+        assertEqual(100, collections[i].count());
+        assertEqual(90, collections[i].document("test0").value);
+
+        testHelper.waitUnload(collections[i]);
+        assertEqual(100, collections[i].count());
+        assertEqual(90, collections[i].document("test0").value);
+        assertEqual(99, collections[i].document("test99").value);
+
+        db._drop(cn + i);
+      }
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test max tick
 ////////////////////////////////////////////////////////////////////////////////
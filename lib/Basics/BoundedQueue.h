@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lock-free bounded multi-producer multi-consumer queue
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_BOUNDED_QUEUE_H
+#define ARANGODB_BASICS_BOUNDED_QUEUE_H 1
+
+#include "Basics/Common.h"
+
+namespace triagens {
+  namespace basics {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class BoundedQueue
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lock-free bounded FIFO queue for any number of producers and
+/// consumers
+///
+/// this is Dmitry Vyukov's array-based queue: every cell carries a sequence
+/// number that tells producers and consumers whether the cell is free or
+/// filled for the current round. producers and consumers only contend on
+/// their own position counter. the capacity is rounded up to a power of two.
+////////////////////////////////////////////////////////////////////////////////
+
+    template<typename T>
+    class BoundedQueue {
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief queue cell
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Cell {
+          std::atomic<size_t> _sequence;
+          T _value;
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        BoundedQueue (BoundedQueue const&) = delete;
+        BoundedQueue& operator= (BoundedQueue const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the queue
+////////////////////////////////////////////////////////////////////////////////
+
+        explicit BoundedQueue (size_t capacity)
+          : _capacity(RoundCapacity(capacity)),
+            _mask(_capacity - 1),
+            _cells(new Cell[_capacity]),
+            _enqueuePosition(0),
+            _padding(),
+            _dequeuePosition(0) {
+
+          for (size_t i = 0; i < _capacity; ++i) {
+            _cells[i]._sequence.store(i, std::memory_order_relaxed);
+          }
+        }
+
+        ~BoundedQueue () {
+          delete[] _cells;
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append an item. returns false if the queue is full
+////////////////////////////////////////////////////////////////////////////////
+
+        bool push (T value) {
+          Cell* cell;
+          size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+
+          while (true) {
+            cell = &_cells[position & _mask];
+            size_t const sequence = cell->_sequence.load(std::memory_order_acquire);
+            intptr_t const diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (diff == 0) {
+              if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+              }
+            }
+            else if (diff < 0) {
+              // full
+              return false;
+            }
+            else {
+              position = _enqueuePosition.load(std::memory_order_relaxed);
+            }
+          }
+
+          cell->_value = value;
+          cell->_sequence.store(position + 1, std::memory_order_release);
+
+          return true;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove the first item. returns false if the queue is empty
+////////////////////////////////////////////////////////////////////////////////
+
+        bool pop (T& value) {
+          Cell* cell;
+          size_t position = _dequeuePosition.load(std::memory_order_relaxed);
+
+          while (true) {
+            cell = &_cells[position & _mask];
+            size_t const sequence = cell->_sequence.load(std::memory_order_acquire);
+            intptr_t const diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+            if (diff == 0) {
+              if (_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+              }
+            }
+            else if (diff < 0) {
+              // empty
+              return false;
+            }
+            else {
+              position = _dequeuePosition.load(std::memory_order_relaxed);
+            }
+          }
+
+          value = cell->_value;
+          cell->_sequence.store(position + _mask + 1, std::memory_order_release);
+
+          return true;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief approximate number of items in the queue
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t size () const {
+          size_t const enqueued = _enqueuePosition.load(std::memory_order_relaxed);
+          size_t const dequeued = _dequeuePosition.load(std::memory_order_relaxed);
+
+          return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief capacity of the queue
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t capacity () const {
+          return _capacity;
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief round the capacity up to the next power of two
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t RoundCapacity (size_t capacity) {
+          size_t result = 2;
+
+          while (result < capacity) {
+            result <<= 1;
+          }
+
+          return result;
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief capacity, always a power of two
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t const _capacity;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief mask for calculating cell positions
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t const _mask;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cells
+////////////////////////////////////////////////////////////////////////////////
+
+        Cell* _cells;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief next position to write to
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<size_t> _enqueuePosition;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief padding, keeps producers and consumers on different cache lines
+////////////////////////////////////////////////////////////////////////////////
+
+        char _padding[64 - sizeof(std::atomic<size_t>)];
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief next position to read from
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<size_t> _dequeuePosition;
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
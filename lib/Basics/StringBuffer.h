@@ -128,6 +128,17 @@ namespace triagens {
           return TRI_DeflateStringBuffer(&_buffer, bufferSize);
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compress the buffer using the specified compression level, with
+/// either a gzip or a zlib header
+////////////////////////////////////////////////////////////////////////////////
+
+        int compress (size_t bufferSize,
+                      int level,
+                      bool gzip) {
+          return TRI_CompressStringBuffer(&_buffer, bufferSize, level, gzip);
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief uncompress the buffer into stringstream out, using zlib-inflate
 ////////////////////////////////////////////////////////////////////////////////
@@ -210,21 +221,14 @@ namespace triagens {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief uncompress the buffer into StringBuffer out, using zlib-inflate
+///
+/// the buffer may contain gzip, zlib or raw deflate data
 ////////////////////////////////////////////////////////////////////////////////
 
         int inflate (triagens::basics::StringBuffer& out,
                      size_t bufferSize = 16384,
                      size_t skip = 0) {
-          z_stream strm;
-
-          strm.zalloc   = Z_NULL;
-          strm.zfree    = Z_NULL;
-          strm.opaque   = Z_NULL;
-          strm.avail_in = 0;
-          strm.next_in  = Z_NULL;
-
           size_t len = this->length();
-          bool raw = true;
 
           if (len < skip) {
             len = 0;
@@ -233,73 +237,7 @@ namespace triagens {
             len -= skip;
           }
 
-          unsigned char* start = ((unsigned char*) this->c_str()) + skip;
-
-          // nginx seems to skip the header - which is wrong according to the
-          // RFC. The following is a hack to find out, if a header is present.
-          // There is a 1 in 31 chance that this will not work.
-          if (2 <= len) {
-            uint32_t first = (((uint32_t) start[0]) << 8) | ((uint32_t) start[1]);
-
-            if (first % 31 == 0) {
-              raw = false;
-            }
-          }
-            
-          int res = raw ? inflateInit2(&strm, -15) : inflateInit(&strm);
-
-          if (res != Z_OK) {
-            return TRI_ERROR_OUT_OF_MEMORY;
-          }
-
-          char* buffer = new char[bufferSize];
-
-          if (buffer == 0) {
-            (void) inflateEnd(&strm);
-
-            return TRI_ERROR_OUT_OF_MEMORY;
-          }
-
-          strm.avail_in = (int) len;
-          strm.next_in = start;
-
-          do {
-            if (strm.avail_in == 0) {
-              break;
-            }
-
-            do {
-              strm.avail_out = (uInt) bufferSize;
-              strm.next_out  = (unsigned char*) buffer;
-
-              res = ::inflate(&strm, Z_NO_FLUSH);
-              TRI_ASSERT(res != Z_STREAM_ERROR);
-
-              switch (res) {
-                case Z_NEED_DICT:
-                case Z_DATA_ERROR:
-                case Z_MEM_ERROR: {
-                  (void) inflateEnd(&strm);
-                  delete[] buffer;
-
-                  return TRI_ERROR_INTERNAL;
-                }
-              }
-
-              out.appendText(buffer, bufferSize - strm.avail_out);
-            }
-            while (strm.avail_out == 0);
-          }
-          while (res != Z_STREAM_END);
-
-          (void) inflateEnd(&strm);
-          delete[] buffer;
-
-          if (res != Z_STREAM_END) {
-            return TRI_ERROR_NO_ERROR;
-          }
-
-          return TRI_ERROR_INTERNAL;
+          return TRI_InflateStringBuffer(out.stringBuffer(), this->c_str() + skip, len, bufferSize);
         }
 
 ////////////////////////////////////////////////////////////////////////////////
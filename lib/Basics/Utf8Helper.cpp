@@ -34,6 +34,7 @@
 #include "unicode/normalizer2.h"
 #include "unicode/brkiter.h"
 #include "unicode/ucasemap.h"
+#include "unicode/uiter.h"
 #include "unicode/uclean.h"
 #include "unicode/unorm2.h"
 #include "unicode/ustdio.h"
@@ -133,6 +134,39 @@ int Utf8Helper::compareUtf16 (const uint16_t* left, size_t leftLength, const uin
   return _coll->compare((const UChar*) left, (int32_t) leftLength, (const UChar*) right, (int32_t) rightLength);
 }
 
+size_t Utf8Helper::sortKeyUtf8 (char const* value,
+                                size_t length,
+                                uint8_t* buffer,
+                                size_t size) const {
+  if (! _coll) {
+    LOG_ERROR("no Collator in Utf8Helper::sortKeyUtf8()!");
+    return 0;
+  }
+
+  // getSortKey() does not promise to write a prefix of the key into a buffer
+  // that is too small. ucol_nextSortKeyPart() is made for partial keys. it
+  // produces the same bytes as getSortKey(), except the terminator
+  UCharIterator iter;
+  uiter_setUTF8(&iter, value, (int32_t) length);
+
+  uint32_t state[2] = { 0, 0 };
+  UErrorCode status = U_ZERO_ERROR;
+
+  int32_t result = ucol_nextSortKeyPart(_coll->toUCollator(), &iter, state, buffer, (int32_t) size, &status);
+
+  if (U_FAILURE(status) || result < 0) {
+    return 0;
+  }
+
+  if ((size_t) result == size) {
+    // the key might be longer than the buffer. report it as cut off
+    return size + 1;
+  }
+
+  buffer[result] = 0;
+  return (size_t) result + 1;
+}
+
 bool Utf8Helper::setCollatorLanguage (std::string const& lang) {
 #ifdef _WIN32
   TRI_FixIcuDataEnv();
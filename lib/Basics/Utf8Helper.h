@@ -108,6 +108,22 @@ namespace triagens {
 
         int compareUtf16 (const uint16_t* left, size_t leftLength, const uint16_t* right, size_t rightLength) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the collator sort key for an utf8 string
+///
+/// comparing two sort keys with memcmp yields the same order as compareUtf8.
+/// sort keys are zero-terminated and contain no other zero bytes. at most
+/// size bytes are written to buffer. if the key is longer, the buffer holds
+/// its first size bytes. returns the length of the sort key including the
+/// terminator, a value greater than size if the key was cut off, or 0 if
+/// there is no collator
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t sortKeyUtf8 (char const* value,
+                            size_t length,
+                            uint8_t* buffer,
+                            size_t size) const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief set collator by language
 /// @param lang   Lowercase two-letter or three-letter ISO-639 code.
@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lock-free work-stealing deque
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_WORK_STEALING_DEQUE_H
+#define ARANGODB_BASICS_WORK_STEALING_DEQUE_H 1
+
+#include "Basics/Common.h"
+
+namespace triagens {
+  namespace basics {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           class WorkStealingDeque
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lock-free work-stealing deque (Chase/Lev)
+///
+/// the deque has a single owner, which is the only thread that may call
+/// push() and pop(). push() and pop() work on the bottom end of the deque.
+/// any other thread may call steal(), which takes an item from the top end.
+/// the memory ordering follows Le, Pop, Cohen, Nardelli: "Correct and
+/// Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+///
+/// the deque grows when full. replaced buffers are kept until the deque is
+/// destroyed, because a concurrent thief might still read from them.
+/// T must be trivially copyable, typically a pointer type.
+////////////////////////////////////////////////////////////////////////////////
+
+    template<typename T>
+    class WorkStealingDeque {
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief circular item buffer
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Buffer {
+          explicit Buffer (int64_t capacity)
+            : _capacity(capacity),
+              _mask(capacity - 1),
+              _items(new std::atomic<T>[static_cast<size_t>(capacity)]),
+              _previous(nullptr) {
+          }
+
+          ~Buffer () {
+            delete[] _items;
+          }
+
+          T get (int64_t index) const {
+            return _items[index & _mask].load(std::memory_order_relaxed);
+          }
+
+          void put (int64_t index, T value) {
+            _items[index & _mask].store(value, std::memory_order_relaxed);
+          }
+
+          Buffer* grow (int64_t bottom, int64_t top) const {
+            Buffer* buffer = new Buffer(_capacity * 2);
+
+            for (int64_t i = top; i < bottom; ++i) {
+              buffer->put(i, get(i));
+            }
+
+            return buffer;
+          }
+
+          int64_t const _capacity;
+          int64_t const _mask;
+          std::atomic<T>* _items;
+          Buffer* _previous;
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        WorkStealingDeque (WorkStealingDeque const&) = delete;
+        WorkStealingDeque& operator= (WorkStealingDeque const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the deque. the initial capacity must be a power of two
+////////////////////////////////////////////////////////////////////////////////
+
+        explicit WorkStealingDeque (size_t initialCapacity = 64)
+          : _top(0),
+            _padding(),
+            _bottom(0),
+            _buffer(new Buffer(static_cast<int64_t>(initialCapacity))) {
+          TRI_ASSERT(initialCapacity > 0);
+          TRI_ASSERT((initialCapacity & (initialCapacity - 1)) == 0);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the deque, including all buffers that were replaced
+////////////////////////////////////////////////////////////////////////////////
+
+        ~WorkStealingDeque () {
+          Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+
+          while (buffer != nullptr) {
+            Buffer* previous = buffer->_previous;
+            delete buffer;
+            buffer = previous;
+          }
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief push an item at the bottom. must only be called by the owner.
+/// may throw if the deque needs to grow and memory allocation fails
+////////////////////////////////////////////////////////////////////////////////
+
+        void push (T value) {
+          int64_t const bottom = _bottom.load(std::memory_order_relaxed);
+          int64_t const top = _top.load(std::memory_order_acquire);
+          Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+
+          if (bottom - top > buffer->_capacity - 1) {
+            Buffer* grown = buffer->grow(bottom, top);
+            grown->_previous = buffer;
+            _buffer.store(grown, std::memory_order_release);
+            buffer = grown;
+          }
+
+          buffer->put(bottom, value);
+          std::atomic_thread_fence(std::memory_order_release);
+          _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pop an item from the bottom. must only be called by the owner.
+/// returns false if the deque is empty
+////////////////////////////////////////////////////////////////////////////////
+
+        bool pop (T& value) {
+          int64_t const bottom = _bottom.load(std::memory_order_relaxed) - 1;
+          Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+          _bottom.store(bottom, std::memory_order_relaxed);
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          int64_t top = _top.load(std::memory_order_relaxed);
+
+          if (top > bottom) {
+            // deque was empty
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+          }
+
+          value = buffer->get(bottom);
+
+          if (top == bottom) {
+            // last item. race against thieves
+            bool const won = _top.compare_exchange_strong(top, top + 1,
+                                                          std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+          }
+
+          return true;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief steal an item from the top. may be called by any thread.
+/// returns false if the deque is empty or if another thread took the item
+/// concurrently
+////////////////////////////////////////////////////////////////////////////////
+
+        bool steal (T& value) {
+          int64_t top = _top.load(std::memory_order_acquire);
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          int64_t const bottom = _bottom.load(std::memory_order_acquire);
+
+          if (top >= bottom) {
+            return false;
+          }
+
+          Buffer* buffer = _buffer.load(std::memory_order_acquire);
+          value = buffer->get(top);
+
+          return _top.compare_exchange_strong(top, top + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief approximate number of items in the deque
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t size () const {
+          int64_t const bottom = _bottom.load(std::memory_order_relaxed);
+          int64_t const top = _top.load(std::memory_order_relaxed);
+
+          return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief index of the top item, modified by thieves and the owner.
+/// top and bottom are kept on different cache lines
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<int64_t> _top;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief padding
+////////////////////////////////////////////////////////////////////////////////
+
+        char _padding[64 - sizeof(std::atomic<int64_t>)];
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief index after the bottom item, only modified by the owner
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<int64_t> _bottom;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current buffer
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<Buffer*> _buffer;
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -29,6 +29,11 @@
 
 #include "hashes.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__x86_64))
+#define TRI_HAVE_SSE42_CRC32C 1
+#include <cpuid.h>
+#endif
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                               FNV
 // -----------------------------------------------------------------------------
@@ -566,6 +571,176 @@ uint32_t TRI_Crc32HashString (char const* data) {
   return TRI_FinalCrc32(crc);
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                            CRC32C
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief precomputed lookup values for crc32c 8 bytes-at-a-time calculation
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t Crc32CLookup[8][256];
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generates the CRC32C lookup tables
+////////////////////////////////////////////////////////////////////////////////
+
+static void GenerateCrc32CLookup (void) {
+  // reflected Castagnoli polynomial
+  uint32_t const polynomial = 0x82F63B78;
+
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t value = i;
+
+    for (int j = 0; j < 8; ++j) {
+      value = (value >> 1) ^ ((value & 1) ? polynomial : 0);
+    }
+
+    Crc32CLookup[0][i] = value;
+  }
+
+  for (uint32_t i = 0; i < 256; ++i) {
+    for (int k = 1; k < 8; ++k) {
+      uint32_t const previous = Crc32CLookup[k - 1][i];
+      Crc32CLookup[k][i] = (previous >> 8) ^ Crc32CLookup[0][previous & 0xFF];
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, slicing-by-8 version
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t SoftwareBlockCrc32C (uint32_t value, char const* data, size_t length) {
+  uint8_t const* current = reinterpret_cast<uint8_t const*>(data);
+
+  // process eight bytes at once
+  while (length >= 8) {
+    uint32_t one;
+    uint32_t two;
+    memcpy(&one, current, sizeof(uint32_t));
+    memcpy(&two, current + 4, sizeof(uint32_t));
+    one ^= value;
+
+    value = Crc32CLookup[0][(two>>24) & 0xFF] ^
+            Crc32CLookup[1][(two>>16) & 0xFF] ^
+            Crc32CLookup[2][(two>> 8) & 0xFF] ^
+            Crc32CLookup[3][ two      & 0xFF] ^
+            Crc32CLookup[4][(one>>24) & 0xFF] ^
+            Crc32CLookup[5][(one>>16) & 0xFF] ^
+            Crc32CLookup[6][(one>> 8) & 0xFF] ^
+            Crc32CLookup[7][ one      & 0xFF];
+    current += 8;
+    length -= 8;
+  }
+
+  // remaining 1 to 7 bytes
+  while (length--) {
+    value = (value >> 8) ^ Crc32CLookup[0][(value & 0xFF) ^ *current++];
+  }
+
+  return value;
+}
+
+#ifdef TRI_HAVE_SSE42_CRC32C
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, SSE4.2 version
+///
+/// must only be called if the CPU supports SSE4.2
+////////////////////////////////////////////////////////////////////////////////
+
+__attribute__((target("sse4.2")))
+static uint32_t HardwareBlockCrc32C (uint32_t value, char const* data, size_t length) {
+  uint8_t const* current = reinterpret_cast<uint8_t const*>(data);
+
+  // align the input to 8 bytes
+  while (length > 0 && (reinterpret_cast<uintptr_t>(current) & 7) != 0) {
+    value = __builtin_ia32_crc32qi(value, *current++);
+    --length;
+  }
+
+  uint64_t value64 = value;
+
+  while (length >= 8) {
+    value64 = __builtin_ia32_crc32di(value64, *reinterpret_cast<uint64_t const*>(current));
+    current += 8;
+    length -= 8;
+  }
+
+  value = static_cast<uint32_t>(value64);
+
+  while (length > 0) {
+    value = __builtin_ia32_crc32qi(value, *current++);
+    --length;
+  }
+
+  return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the CPU supports SSE4.2
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CpuSupportsSse42 (void) {
+  unsigned int eax, ebx, ecx, edx;
+
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+
+  return (ecx & bit_SSE4_2) != 0;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the CRC32C implementation in use, determined on initialisation
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t (*BlockCrc32C) (uint32_t, char const*, size_t) = SoftwareBlockCrc32C;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32C (uint32_t value, char const* data, size_t length) {
+  return BlockCrc32C(value, data, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes a CRC32C for memory blobs
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_Crc32CHashPointer (void const* data, size_t length) {
+  uint32_t crc;
+
+  crc = TRI_InitialCrc32();
+  crc = TRI_BlockCrc32C(crc, static_cast<char const*>(data), length);
+
+  return TRI_FinalCrc32(crc);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not CRC32C values are computed in hardware
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HasHardwareCrc32C () {
+  return BlockCrc32C != SoftwareBlockCrc32C;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                            MODULE
 // -----------------------------------------------------------------------------
@@ -594,6 +769,13 @@ void TRI_InitialiseHashes () {
   }
 
   GenerateCrc32Polynomial();
+  GenerateCrc32CLookup();
+
+#ifdef TRI_HAVE_SSE42_CRC32C
+  if (CpuSupportsSse42()) {
+    BlockCrc32C = HardwareBlockCrc32C;
+  }
+#endif
 
   Initialised = true;
 }
@@ -120,6 +120,35 @@ uint32_t TRI_Crc32HashPointer (void const*, size_t);
 
 uint32_t TRI_Crc32HashString (char const*);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                            CRC32C
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C (Castagnoli) value of data block
+///
+/// use TRI_InitialCrc32() and TRI_FinalCrc32() to start and finish the
+/// calculation. uses the SSE4.2 crc32 instruction if the CPU supports it
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32C (uint32_t, char const* data, size_t length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes a CRC32C for memory blobs
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_Crc32CHashPointer (void const*, size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not CRC32C values are computed in hardware
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HasHardwareCrc32C (void);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                            MODULE
 // -----------------------------------------------------------------------------
@@ -162,6 +162,24 @@ int TRI_ProtectMMFile (void* memoryAddress,
   return TRI_ERROR_SYS_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// @brief give advice about a region in a memory-mapped file
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_MMFileAdvise (void const* memoryAddress,
+                       size_t numOfBytesToAdvise,
+                       int advice) {
+  static uintptr_t const pageSize = static_cast<uintptr_t>(getpagesize());
+
+  // madvise() wants the start of a page
+  uintptr_t const start = reinterpret_cast<uintptr_t>(memoryAddress);
+  uintptr_t const aligned = start - (start % pageSize);
+
+  if (madvise(reinterpret_cast<void*>(aligned), numOfBytesToAdvise + (start - aligned), advice) != 0) {
+    LOG_TRACE("madvise(%d) failed: %s", advice, strerror(errno));
+  }
+}
+
 #endif
 
 // -----------------------------------------------------------------------------
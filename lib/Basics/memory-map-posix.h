@@ -49,6 +49,14 @@
 #define TRI_MMAP_ANONYMOUS MAP_ANON
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief advice for memory-mapped regions, used with TRI_MMFileAdvise
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_MADVISE_NORMAL     MADV_NORMAL
+#define TRI_MADVISE_SEQUENTIAL MADV_SEQUENTIAL
+#define TRI_MADVISE_WILLNEED   MADV_WILLNEED
+
 #endif
 
 #endif
@@ -328,6 +328,16 @@ int TRI_ProtectMMFile(void* memoryAddress,  size_t numOfBytesToProtect, int flag
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// @brief give advice about a region in a memory-mapped file. there is no
+// equivalent of madvise() for mapped views, so this does nothing
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_MMFileAdvise (void const* memoryAddress,
+                       size_t numOfBytesToAdvise,
+                       int advice) {
+}
+
 
 #endif
 
@@ -75,6 +75,14 @@
 #define PROT_GROWSDOWN  0x01000000      /* Extend change to start of growsdown vma (mprotect only).  */
 #define PROT_GROWSUP    0x02000000      /* Extend change to start of growsup vma (mprotect only).  */
 
+////////////////////////////////////////////////////////////////////////////////
+// Dummy advice flags, TRI_MMFileAdvise does nothing under windows
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_MADVISE_NORMAL     0
+#define TRI_MADVISE_SEQUENTIAL 2
+#define TRI_MADVISE_WILLNEED   3
+
 #endif
 
 #endif
@@ -111,6 +111,16 @@ int TRI_ProtectMMFile (void* memoryAddress,
                        int fileDescriptor,
                        void** mmHandle);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief gives the kernel advice about the use of a region of a memory
+/// mapped file. the region does not need to be page-aligned. the advice is
+/// only a hint, so failures are not reported
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_MMFileAdvise (void const* memoryAddress,
+                       size_t numOfBytesToAdvise,
+                       int advice);
+
 #endif
 
 // -----------------------------------------------------------------------------
@@ -408,6 +408,94 @@ int SkipList::insert (void* doc) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts many documents into a skiplist in one go
+////////////////////////////////////////////////////////////////////////////////
+
+int SkipList::insertSorted (std::vector<void*> const& docs) {
+  if (_nrUsed > 0) {
+    // cannot simply append to an existing list
+    for (auto doc : docs) {
+      int res = insert(doc);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+    }
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  size_t const n = docs.size();
+
+  // check the order and the unique constraint first, so nothing needs to be
+  // undone later
+  for (size_t i = 1; i < n; i++) {
+    int cmp = _cmp_elm_elm(_cmpdata, docs[i - 1], docs[i], SKIPLIST_CMP_TOTORDER);
+
+    if (cmp > 0) {
+      // input is not sorted
+      TRI_ASSERT(false);
+      return TRI_ERROR_INTERNAL;
+    }
+
+    if (cmp == 0) {
+      // duplicate in the proper total order
+      return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+    }
+
+    if (_unique &&
+        0 == _cmp_elm_elm(_cmpdata, docs[i - 1], docs[i], SKIPLIST_CMP_PREORDER)) {
+      return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+    }
+  }
+
+  std::vector<SkipListNode*> nodes;
+
+  try {
+    nodes.reserve(n);
+
+    for (size_t i = 0; i < n; i++) {
+      nodes.push_back(allocNode(0));
+    }
+  }
+  catch (...) {
+    for (auto node : nodes) {
+      freeNode(node);
+    }
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  // tails[lev] is the rightmost node with height > lev
+  SkipListNode* tails[TRI_SKIPLIST_MAX_HEIGHT];
+  int lev;
+
+  for (lev = 0; lev < TRI_SKIPLIST_MAX_HEIGHT; lev++) {
+    tails[lev] = _start;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    SkipListNode* newNode = nodes[i];
+    newNode->_doc = docs[i];
+
+    if (newNode->_height > _start->_height) {
+      // _start is already initialised with nullptr to the top
+      _start->_height = newNode->_height;
+    }
+
+    newNode->_prev = tails[0];
+
+    for (lev = 0; lev < newNode->_height; lev++) {
+      tails[lev]->_next[lev] = newNode;
+      tails[lev] = newNode;
+    }
+  }
+
+  _end = tails[0];
+  _nrUsed += n;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief removes a document from a skiplist
 ///
@@ -207,6 +207,20 @@ namespace triagens {
 
         int insert (void* doc);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts many documents into a skiplist in one go
+///
+/// The documents must already be sorted according to the proper total
+/// order. If the skiplist is empty, the list is built level by level
+/// from left to right without doing any lookups, which is much cheaper
+/// than inserting the documents one by one. Otherwise this falls back to
+/// calling insert() for each document. Returns the same error codes as
+/// insert(). For an empty skiplist nothing is inserted in case of an
+/// error.
+////////////////////////////////////////////////////////////////////////////////
+
+        int insertSorted (std::vector<void*> const& docs);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief removes a document from a skiplist
 ///
@@ -407,6 +407,17 @@ void  TRI_FreeStringBuffer (TRI_memory_zone_t* zone, TRI_string_buffer_t * self)
 
 int TRI_DeflateStringBuffer (TRI_string_buffer_t* self,
                              size_t bufferSize) {
+  return TRI_CompressStringBuffer(self, bufferSize, Z_DEFAULT_COMPRESSION, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compress the string buffer using the specified compression level
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_CompressStringBuffer (TRI_string_buffer_t* self,
+                              size_t bufferSize,
+                              int level,
+                              bool gzip) {
   TRI_string_buffer_t deflated;
   const char* ptr;
   const char* end;
@@ -418,8 +429,9 @@ int TRI_DeflateStringBuffer (TRI_string_buffer_t* self,
   strm.zfree  = Z_NULL;
   strm.opaque = Z_NULL;
 
-  // initialise deflate procedure
-  res = deflateInit(&strm, Z_DEFAULT_COMPRESSION);
+  // initialise deflate procedure. adding 16 to the window bits makes zlib
+  // write a gzip header and trailer
+  res = deflateInit2(&strm, level, Z_DEFLATED, gzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY);
 
   if (res != Z_OK) {
     return TRI_ERROR_OUT_OF_MEMORY;
@@ -489,6 +501,83 @@ int TRI_DeflateStringBuffer (TRI_string_buffer_t* self,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief uncompress data and append it to the string buffer
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_InflateStringBuffer (TRI_string_buffer_t* self,
+                             char const* data,
+                             size_t length,
+                             size_t bufferSize) {
+  unsigned char const* start = (unsigned char const*) data;
+  int windowBits = -15;
+
+  if (length >= 2) {
+    if (start[0] == 0x1f && start[1] == 0x8b) {
+      // gzip magic bytes
+      windowBits = 15 + 16;
+    }
+    else if (((((uint32_t) start[0]) << 8) | ((uint32_t) start[1])) % 31 == 0) {
+      // nginx seems to skip the zlib header - which is wrong according to the
+      // RFC. a valid zlib header is a multiple of 31. there is a 1 in 31
+      // chance that raw data looks like a header
+      windowBits = 15;
+    }
+  }
+
+  z_stream strm;
+  strm.zalloc   = Z_NULL;
+  strm.zfree    = Z_NULL;
+  strm.opaque   = Z_NULL;
+  strm.avail_in = 0;
+  strm.next_in  = Z_NULL;
+
+  int res = inflateInit2(&strm, windowBits);
+
+  if (res != Z_OK) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  char* buffer = (char*) TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, bufferSize, false);
+
+  if (buffer == nullptr) {
+    (void) inflateEnd(&strm);
+
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  strm.avail_in = (uInt) length;
+  strm.next_in  = (unsigned char*) start;
+  res = Z_OK;
+
+  while (res != Z_STREAM_END) {
+    strm.avail_out = (uInt) bufferSize;
+    strm.next_out  = (unsigned char*) buffer;
+
+    res = inflate(&strm, Z_NO_FLUSH);
+
+    if (res != Z_OK && res != Z_STREAM_END) {
+      // Z_BUF_ERROR means the input was truncated
+      (void) inflateEnd(&strm);
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, buffer);
+
+      return res == Z_MEM_ERROR ? TRI_ERROR_OUT_OF_MEMORY : TRI_ERROR_INTERNAL;
+    }
+
+    if (TRI_AppendString2StringBuffer(self, buffer, bufferSize - strm.avail_out) != TRI_ERROR_NO_ERROR) {
+      (void) inflateEnd(&strm);
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, buffer);
+
+      return TRI_ERROR_OUT_OF_MEMORY;
+    }
+  }
+
+  (void) inflateEnd(&strm);
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, buffer);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief ensure the string buffer has a specific capacity
 ////////////////////////////////////////////////////////////////////////////////
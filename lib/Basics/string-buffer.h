@@ -116,6 +116,29 @@ void TRI_FreeStringBuffer (TRI_memory_zone_t*, TRI_string_buffer_t *);
 int TRI_DeflateStringBuffer (TRI_string_buffer_t*,
                              size_t);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compress the string buffer using the specified compression level.
+/// if gzip is true, a gzip header and trailer are written, otherwise a zlib
+/// header and trailer
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_CompressStringBuffer (TRI_string_buffer_t*,
+                              size_t,
+                              int,
+                              bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief uncompress data and append it to the string buffer
+///
+/// the data may be gzip, zlib or raw deflate data. the format is detected
+/// from the first bytes
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_InflateStringBuffer (TRI_string_buffer_t*,
+                             char const*,
+                             size_t,
+                             size_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief ensure the string buffer has a specific capacity
 ////////////////////////////////////////////////////////////////////////////////
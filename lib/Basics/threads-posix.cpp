@@ -224,6 +224,22 @@ void TRI_AllowCancelation () {
   pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, 0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief disable cancellation of the current thread temporarily
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_DisableCancelation () {
+  pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief enable cancellation of the current thread again
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_EnableCancelation () {
+  pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, 0);
+}
+
 #endif
 
 // -----------------------------------------------------------------------------
@@ -228,6 +228,22 @@ void TRI_AllowCancelation(void) {
   // TODO: No native implementation of this
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief disable cancellation of the current thread temporarily
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_DisableCancelation(void) {
+  // threads are not cancelled asynchronously on Windows
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief enable cancellation of the current thread again
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_EnableCancelation(void) {
+  // threads are not cancelled asynchronously on Windows
+}
+
 
 
 
@@ -126,6 +126,21 @@ bool TRI_IsSelfThread (TRI_thread_t* thread);
 
 void TRI_AllowCancelation (void);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief disable cancellation of the current thread temporarily
+///
+/// a cancellation requested in the meantime is acted upon as soon as the
+/// cancellation is enabled again
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_DisableCancelation (void);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief enable cancellation of the current thread again
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_EnableCancelation (void);
+
 #endif
 
 // -----------------------------------------------------------------------------
@@ -167,6 +167,7 @@ void TRI_InitialiseErrorMessages () {
   REG_ERROR(ERROR_QUERY_INVALID_ARITHMETIC_VALUE, "invalid arithmetic value");
   REG_ERROR(ERROR_QUERY_DIVISION_BY_ZERO, "division by zero");
   REG_ERROR(ERROR_QUERY_ARRAY_EXPECTED, "array expected");
+  REG_ERROR(ERROR_QUERY_INVALID_AGGREGATE_EXPRESSION, "invalid aggregate expression");
   REG_ERROR(ERROR_QUERY_FAIL_CALLED, "FAIL(%s) called");
   REG_ERROR(ERROR_QUERY_GEO_INDEX_MISSING, "no suitable geo index found for geo restriction on '%s'");
   REG_ERROR(ERROR_QUERY_FULLTEXT_INDEX_MISSING, "no suitable fulltext index found for fulltext query on '%s'");
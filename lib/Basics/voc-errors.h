@@ -412,6 +412,9 @@
 /// - 1563: @LIT{array expected}
 ///   Will be raised when a non-array operand is used for an operation that
 ///   expects an array argument operand.
+/// - 1564: @LIT{invalid aggregate expression}
+///   Will be raised when an AGGREGATE expression of a COLLECT statement is not
+///   a call of a supported aggregate function with one argument.
 /// - 1569: @LIT{FAIL(\%s) called}
 ///   Will be raised when the function FAIL() is called from inside a query.
 /// - 1570: @LIT{no suitable geo index found for geo restriction on '\%s'}
@@ -2352,6 +2355,17 @@ void TRI_InitialiseErrorMessages ();
 
 #define TRI_ERROR_QUERY_ARRAY_EXPECTED                                    (1563)
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief 1564: ERROR_QUERY_INVALID_AGGREGATE_EXPRESSION
+///
+/// invalid aggregate expression
+///
+/// Will be raised when an AGGREGATE expression of a COLLECT statement is not a
+/// call of a supported aggregate function with one argument.
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_ERROR_QUERY_INVALID_AGGREGATE_EXPRESSION                      (1564)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief 1569: ERROR_QUERY_FAIL_CALLED
 ///
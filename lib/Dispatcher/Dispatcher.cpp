@@ -344,8 +344,10 @@ void Dispatcher::reportStatus () {
                 (int) q->_nrWaiting,
                 (int) q->_nrStopped,
                 (int) q->_nrSpecial,
-                (q->_monopolizer ? "yes" : "no"));
+                (q->_monopolizer.load() != nullptr ? "yes" : "no"));
 #endif
+      q->reportQueueDepths();
+
       CONDITION_LOCKER(guard, q->_accessQueue);
 
       for (set<DispatcherThread*>::iterator j = q->_startedThreads.begin();  j != q->_startedThreads.end(); ++j) {
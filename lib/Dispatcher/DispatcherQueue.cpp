@@ -35,12 +35,23 @@
 #include "DispatcherQueue.h"
 
 #include "Basics/ConditionLocker.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/logging.h"
 #include "Dispatcher/DispatcherThread.h"
 
 using namespace std;
 using namespace triagens::rest;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private constants
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximal capacity of the injection queue
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const MaxInjectedJobs = 1 << 20;
+
 // -----------------------------------------------------------------------------
 // constructors and destructors
 // -----------------------------------------------------------------------------
@@ -59,7 +70,12 @@ DispatcherQueue::DispatcherQueue (Scheduler* scheduler,
   : _name(name),
     _threadData(threadData),
     _accessQueue(),
-    _readyJobs(),
+    _localQueues(),
+    _injectedJobs((std::min)(maxSize, MaxInjectedJobs)),
+    _nrReady(0),
+    _accessJobs(),
+    _waitingJobs(),
+    _canceledJobs(),
     _runningJobs(),
     _maxSize(maxSize),
     _stopping(0),
@@ -79,6 +95,14 @@ DispatcherQueue::DispatcherQueue (Scheduler* scheduler,
     _scheduler(scheduler),
     _dispatcher(dispatcher),
     createDispatcherThread(creator) {
+
+  // threads started for special or blocked jobs may also get a local queue
+  size_t const n = (std::max)((size_t) 2, 2 * nrThreads);
+  _localQueues.reserve(n);
+
+  for (size_t i = 0;  i < n;  ++i) {
+    _localQueues.emplace_back(new LocalQueue());
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -89,6 +113,10 @@ DispatcherQueue::~DispatcherQueue () {
   if (_stopping == 0) {
     beginShutdown();
   }
+
+  for (auto it = _localQueues.begin();  it != _localQueues.end();  ++it) {
+    delete *it;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -97,92 +125,127 @@ DispatcherQueue::~DispatcherQueue () {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief adds a job
+///
+/// jobs created by a job running in one of the queue's threads are pushed
+/// onto the local queue of that thread, all other jobs are put into the
+/// injection queue. neither requires the queue lock.
 ////////////////////////////////////////////////////////////////////////////////
 
 bool DispatcherQueue::addJob (Job* job) {
   TRI_ASSERT(job != nullptr);
 
-  CONDITION_LOCKER(guard, _accessQueue);
-
   // queue is full
-  if (_readyJobs.size() >= _maxSize) {
+  if (_nrReady.fetch_add(1) >= _maxSize) {
+    --_nrReady;
     return false;
   }
 
   // if all threads are blocked, we start new threads
   if (0 == _nrWaiting && _nrRunning + _nrStarted <= _nrBlocked) {
-    startQueueThread();
+    CONDITION_LOCKER(guard, _accessQueue);
+
+    if (0 == _nrWaiting && _nrRunning + _nrStarted <= _nrBlocked) {
+      startQueueThread();
+    }
   }
 
-  // add the job to the list of ready jobs
-  try {
-    _readyJobs.emplace_back(job);
+  // register jobs that can be canceled
+  uint64_t const jobId = job->id();
+
+  if (jobId != 0) {
+    MUTEX_LOCKER(_accessJobs);
+
+    try {
+      _waitingJobs.emplace(jobId, job);
+    }
+    catch (...) {
+      --_nrReady;
+      return false;
+    }
   }
-  catch (...) { 
+
+  bool added = false;
+  DispatcherThread* current = DispatcherThread::currentDispatcherThread;
+
+  if (current != nullptr &&
+      current->_queue == this &&
+      current->_working &&
+      current->_localQueue != DispatcherThread::NoLocalQueue) {
+    try {
+      _localQueues[current->_localQueue]->_jobs.push(job);
+      added = true;
+    }
+    catch (...) {
+      // fall back to the injection queue
+    }
+  }
+
+  if (! added) {
+    added = _injectedJobs.push(job);
+  }
+
+  // the job must not be accessed from here on, it might already be running
+
+  if (! added) {
     // could not add job
+    if (jobId != 0) {
+      MUTEX_LOCKER(_accessJobs);
+      _waitingJobs.erase(jobId);
+    }
+
+    --_nrReady;
     return false;
   }
 
-  // wake up the _dispatcher queue threads
-  if (0 < _nrWaiting) {
-    guard.broadcast();
-  }
+  // wake up a dispatcher queue thread
+  wakeupThread();
 
   return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tries to cancel a job
+///
+/// a canceled job that has not started yet stays in its queue. it is cleaned
+/// up instead of being executed when a thread takes it.
 ////////////////////////////////////////////////////////////////////////////////
 
 bool DispatcherQueue::cancelJob (uint64_t jobId) {
-  CONDITION_LOCKER(guard, _accessQueue);
-
   if (jobId == 0) {
     return false;
   }
 
+  MUTEX_LOCKER(_accessJobs);
+
   // job is already running, try to cancel it
-  for (set<Job*>::iterator it = _runningJobs.begin();  it != _runningJobs.end();  ++it) {
-    Job* job = *it;
+  auto it = _runningJobs.find(jobId);
 
-    if (job->id() == jobId) {
-      job->cancel(true);
-      return true;
-    }
+  if (it != _runningJobs.end()) {
+    (*it).second->cancel(true);
+    return true;
   }
 
   // maybe there is a waiting job with this it, try to remove it
-  for (list<Job*>::iterator it = _readyJobs.begin();  it != _readyJobs.end();  ++it) {
-    Job* job = *it;
-
-    if (job->id() == jobId) {
-      bool canceled = job->cancel(false);
+  auto it2 = _waitingJobs.find(jobId);
 
-      if (canceled) {
-        try {
-          job->setDispatcherThread(nullptr);
-          job->cleanup();
-        }
-        catch (...) {
-#ifdef TRI_HAVE_POSIX_THREADS
-          if (_stopping != 0) {
-            LOG_WARNING("caught cancellation exception during cleanup");
-            throw;
-          }
-#endif
-
-          LOG_WARNING("caught error while cleaning up!");
-        }
+  if (it2 == _waitingJobs.end()) {
+    return false;
+  }
 
-        _readyJobs.erase(it);
-      }
+  Job* job = (*it2).second;
+  bool canceled = job->cancel(false);
 
-      return true;
+  if (canceled) {
+    try {
+      _canceledJobs.emplace(job);
+      _waitingJobs.erase(it2);
+    }
+    catch (...) {
+      LOG_WARNING("caught error while canceling job!");
     }
   }
 
-  return false;
+  return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -197,11 +260,14 @@ void DispatcherQueue::specializeThread (DispatcherThread* thread) {
 
     _nrRunning--;
     _nrSpecial++;
+    thread->_executing = false;
 
     startQueueThread();
 
-    if (_monopolizer == thread) {
-      _monopolizer = nullptr;
+    DispatcherThread* expected = thread;
+
+    if (_monopolizer.compare_exchange_strong(expected, nullptr)) {
+      guard.broadcast();
     }
   }
 }
@@ -211,8 +277,6 @@ void DispatcherQueue::specializeThread (DispatcherThread* thread) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void DispatcherQueue::blockThread (DispatcherThread* thread) {
-  CONDITION_LOCKER(guard, _accessQueue);
-
   if (thread->_jobType == Job::READ_JOB || thread->_jobType == Job::WRITE_JOB) {
     _nrBlocked++;
   }
@@ -223,15 +287,16 @@ void DispatcherQueue::blockThread (DispatcherThread* thread) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void DispatcherQueue::unblockThread (DispatcherThread* thread) {
-  CONDITION_LOCKER(guard, _accessQueue);
-
   if (thread->_jobType == Job::READ_JOB || thread->_jobType == Job::WRITE_JOB) {
-    if (_nrBlocked == 0) {
-      LOG_ERROR("unblocking too many threads");
-    }
-    else {
-      _nrBlocked--;
+    size_t nrBlocked = _nrBlocked.load();
+
+    do {
+      if (nrBlocked == 0) {
+        LOG_ERROR("unblocking too many threads");
+        return;
+      }
     }
+    while (! _nrBlocked.compare_exchange_weak(nrBlocked, nrBlocked - 1));
   }
 }
 
@@ -270,25 +335,7 @@ void DispatcherQueue::beginShutdown () {
   _stopping = 1;
   
   // kill all jobs in the queue that were not yet executed
-  {
-    CONDITION_LOCKER(guard, _accessQueue);
-    for (auto it = _readyJobs.begin();  it != _readyJobs.end();  ++it) {
-      Job* job = *it;
-
-      bool canceled = job->cancel(false);
-
-      if (canceled) {
-        try {
-          job->setDispatcherThread(nullptr);
-          job->cleanup();
-        }
-        catch (...) {
-        }
-      }
-    }
-    _readyJobs.clear();
-  }
-
+  cancelReadyJobs();
 
   for (size_t count = 0;  count < MAX_TRIES;  ++count) {
     {
@@ -384,6 +431,290 @@ bool DispatcherQueue::startQueueThread () {
   return ok;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reports the queue depths, for debugging
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::reportQueueDepths () {
+  CONDITION_LOCKER(guard, _accessQueue);
+
+  LOG_DEBUG("dispatcher queue '%s': ready = %d, injected = %d",
+            _name.c_str(),
+            (int) _nrReady,
+            (int) _injectedJobs.size());
+
+  for (size_t i = 0;  i < _localQueues.size();  ++i) {
+    LocalQueue* queue = _localQueues[i];
+
+    if (queue->_owner == nullptr && queue->_jobs.size() == 0) {
+      continue;
+    }
+
+    LOG_DEBUG("dispatcher queue '%s', local queue %d: depth = %d, stolen = %llu, owner = %s",
+              _name.c_str(),
+              (int) i,
+              (int) queue->_jobs.size(),
+              (unsigned long long) queue->_nrStolen.load(),
+              (queue->_owner != nullptr ? "yes" : "no"));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief takes the next ready job, without locking the queue
+////////////////////////////////////////////////////////////////////////////////
+
+Job* DispatcherQueue::fetchJob (DispatcherThread* thread) {
+  Job* job = nullptr;
+  size_t const own = thread->_localQueue;
+
+  // jobs created by our own jobs first
+  if (own != DispatcherThread::NoLocalQueue &&
+      _localQueues[own]->_jobs.pop(job)) {
+    --_nrReady;
+    return job;
+  }
+
+  // then jobs from other threads
+  if (_injectedJobs.pop(job)) {
+    --_nrReady;
+    return job;
+  }
+
+  // finally try to steal from the other dispatcher threads
+  size_t const n = _localQueues.size();
+
+  for (size_t i = 0;  i < n;  ++i) {
+    size_t const victim = (thread->_stealPosition + i) % n;
+
+    if (victim == own) {
+      continue;
+    }
+
+    LocalQueue* queue = _localQueues[victim];
+
+    if (queue->_jobs.steal(job)) {
+      queue->_nrStolen++;
+
+      // next time, start with the same victim
+      thread->_stealPosition = victim;
+
+      --_nrReady;
+      return job;
+    }
+  }
+
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wakes up one waiting thread, if there is one
+///
+/// an idle thread increases _nrWaiting before it checks _nrReady, whereas
+/// addJob increases _nrReady before it checks _nrWaiting. so either the
+/// idle thread sees the new job, or we see the waiting thread.
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::wakeupThread () {
+  if (0 < _nrWaiting.load()) {
+    CONDITION_LOCKER(guard, _accessQueue);
+    guard.signal();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief assigns a free local queue to a thread, must hold _accessQueue
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::acquireLocalQueue (DispatcherThread* thread) {
+  size_t const n = _localQueues.size();
+
+  for (size_t i = 0;  i < n;  ++i) {
+    LocalQueue* queue = _localQueues[i];
+
+    if (queue->_owner == nullptr) {
+      queue->_owner = thread;
+      thread->_localQueue = i;
+      thread->_stealPosition = (i + 1) % n;
+      return;
+    }
+  }
+
+  // all local queues are in use. the thread will only use the shared queues
+  thread->_localQueue = DispatcherThread::NoLocalQueue;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief gives the thread's local queue back, must hold _accessQueue
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::releaseLocalQueue (DispatcherThread* thread) {
+  if (thread->_localQueue != DispatcherThread::NoLocalQueue) {
+    _localQueues[thread->_localQueue]->_owner = nullptr;
+    thread->_localQueue = DispatcherThread::NoLocalQueue;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief makes the thread the monopolizer of the queue
+///
+/// a thread marks itself as executing before it checks for a monopolizer,
+/// whereas the monopolizer is set before the executing threads are checked.
+/// so either the thread sees the monopolizer, or the monopolizer waits for
+/// the thread. this is only used for WRITE_JOBs, which are rare, so we
+/// simply poll
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::monopolize (DispatcherThread* thread) {
+  while (true) {
+    DispatcherThread* expected = nullptr;
+
+    if (_monopolizer.compare_exchange_strong(expected, thread)) {
+      break;
+    }
+
+    // another monopolistic job is running, let it finish first
+    thread->_executing = false;
+
+    while (_monopolizer.load() != nullptr) {
+      usleep(1000);
+    }
+
+    thread->_executing = true;
+  }
+
+  // other threads will not start new jobs now
+  while (true) {
+    bool busy = false;
+
+    {
+      CONDITION_LOCKER(guard, _accessQueue);
+
+      for (auto it = _startedThreads.begin();  it != _startedThreads.end();  ++it) {
+        if (*it != thread && (*it)->_executing.load()) {
+          busy = true;
+          break;
+        }
+      }
+    }
+
+    if (! busy) {
+      break;
+    }
+
+    usleep(1000);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ends the monopolization of the queue by the thread, if any
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::unmonopolize (DispatcherThread* thread) {
+  if (_monopolizer.load(std::memory_order_relaxed) != thread) {
+    return;
+  }
+
+  DispatcherThread* expected = thread;
+
+  if (_monopolizer.compare_exchange_strong(expected, nullptr)) {
+    CONDITION_LOCKER(guard, _accessQueue);
+    guard.broadcast();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief registers a job that is about to run
+////////////////////////////////////////////////////////////////////////////////
+
+bool DispatcherQueue::beginJob (Job* job) {
+  uint64_t const jobId = job->id();
+
+  if (jobId == 0) {
+    return true;
+  }
+
+  MUTEX_LOCKER(_accessJobs);
+
+  auto it = _canceledJobs.find(job);
+
+  if (it != _canceledJobs.end()) {
+    _canceledJobs.erase(it);
+    return false;
+  }
+
+  _waitingJobs.erase(jobId);
+
+  try {
+    _runningJobs.emplace(jobId, job);
+  }
+  catch (...) {
+    // job cannot be canceled while running
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief unregisters a job after it has run
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::endJob (uint64_t jobId) {
+  if (jobId == 0) {
+    return;
+  }
+
+  MUTEX_LOCKER(_accessJobs);
+  _runningJobs.erase(jobId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cancels and removes all ready jobs
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::cancelReadyJobs () {
+  auto cancel = [this] (Job* job) -> void {
+    --_nrReady;
+
+    bool canceled = false;
+    uint64_t const jobId = job->id();
+
+    if (jobId != 0) {
+      MUTEX_LOCKER(_accessJobs);
+      _waitingJobs.erase(jobId);
+      canceled = (_canceledJobs.erase(job) > 0);
+    }
+
+    if (canceled || job->cancel(false)) {
+      try {
+        job->setDispatcherThread(nullptr);
+        job->cleanup();
+      }
+      catch (...) {
+      }
+    }
+  };
+
+  Job* job;
+
+  while (_injectedJobs.pop(job)) {
+    cancel(job);
+  }
+
+  for (auto it = _localQueues.begin();  it != _localQueues.end();  ++it) {
+    LocalQueue* queue = *it;
+
+    while (queue->_jobs.size() > 0) {
+      if (queue->_jobs.steal(job)) {
+        cancel(job);
+      }
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -33,7 +33,10 @@
 
 #include "Basics/Common.h"
 
+#include "Basics/BoundedQueue.h"
 #include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
+#include "Basics/WorkStealingDeque.h"
 #include "Dispatcher/Dispatcher.h"
 
 // -----------------------------------------------------------------------------
@@ -61,6 +64,32 @@ namespace triagens {
         DispatcherQueue (DispatcherQueue const&);
         DispatcherQueue& operator= (DispatcherQueue const&);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief job queue owned by a single dispatcher thread
+///
+/// jobs added by a dispatcher thread of this queue are pushed onto the
+/// thread's local queue. idle threads steal jobs from the local queues of
+/// other threads.
+////////////////////////////////////////////////////////////////////////////////
+
+        struct LocalQueue {
+          LocalQueue ()
+            : _jobs(),
+              _owner(nullptr),
+              _nrStolen(0) {
+          }
+
+          basics::WorkStealingDeque<Job*> _jobs;
+          DispatcherThread* _owner;
+          std::atomic<uint64_t> _nrStolen;
+        };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -165,6 +194,85 @@ namespace triagens {
           return _name;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reports the queue depths, for debugging
+////////////////////////////////////////////////////////////////////////////////
+
+        void reportQueueDepths ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief takes the next ready job, without locking the queue
+///
+/// the thread's local queue is checked first, then the injection queue, and
+/// finally the local queues of other threads. returns nullptr if no job is
+/// ready.
+////////////////////////////////////////////////////////////////////////////////
+
+        Job* fetchJob (DispatcherThread*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wakes up one waiting thread, if there is one
+////////////////////////////////////////////////////////////////////////////////
+
+        void wakeupThread ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief assigns a free local queue to a thread, must hold _accessQueue
+////////////////////////////////////////////////////////////////////////////////
+
+        void acquireLocalQueue (DispatcherThread*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief gives the thread's local queue back, must hold _accessQueue
+///
+/// jobs left in the local queue can still be stolen by other threads and will
+/// be taken over by the next owner
+////////////////////////////////////////////////////////////////////////////////
+
+        void releaseLocalQueue (DispatcherThread*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief registers a job that is about to run
+///
+/// returns false if the job was canceled while it was waiting, in which case
+/// it must not be executed
+////////////////////////////////////////////////////////////////////////////////
+
+        bool beginJob (Job*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief unregisters a job after it has run
+////////////////////////////////////////////////////////////////////////////////
+
+        void endJob (uint64_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief makes the thread the monopolizer of the queue
+///
+/// waits until all other threads have finished their current jobs. the
+/// thread must already be marked as executing
+////////////////////////////////////////////////////////////////////////////////
+
+        void monopolize (DispatcherThread*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ends the monopolization of the queue by the thread, if any
+////////////////////////////////////////////////////////////////////////////////
+
+        void unmonopolize (DispatcherThread*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cancels and removes all ready jobs
+////////////////////////////////////////////////////////////////////////////////
+
+        void cancelReadyJobs ();
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -184,22 +292,56 @@ namespace triagens {
         void* _threadData;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief monopolistic jobs
+/// @brief protects the thread bookkeeping, idle threads wait on it
+///
+/// adding and fetching jobs does not use this lock
 ////////////////////////////////////////////////////////////////////////////////
 
         basics::ConditionVariable _accessQueue;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief list of ready jobs
+/// @brief local job queues of the dispatcher threads
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<LocalQueue*> _localQueues;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief injection queue for jobs added by other threads (e.g. scheduler)
+////////////////////////////////////////////////////////////////////////////////
+
+        basics::BoundedQueue<Job*> _injectedJobs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of ready jobs in all queues
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<size_t> _nrReady;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief protects the registry of jobs with ids
+////////////////////////////////////////////////////////////////////////////////
+
+        basics::Mutex _accessJobs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ready jobs with an id, which can be canceled
+///
+/// jobs without an id cannot be canceled and are not registered
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_map<uint64_t, Job*> _waitingJobs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ready jobs that were canceled before they ran
 ////////////////////////////////////////////////////////////////////////////////
 
-        std::list<Job*> _readyJobs;
+        std::unordered_set<Job*> _canceledJobs;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief current running job
+/// @brief running jobs with an id
 ////////////////////////////////////////////////////////////////////////////////
 
-        std::set<Job*> _runningJobs;
+        std::unordered_map<uint64_t, Job*> _runningJobs;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief maximum queue size (number of jobs)
@@ -217,7 +359,7 @@ namespace triagens {
 /// @brief monopolistic job
 ////////////////////////////////////////////////////////////////////////////////
 
-        DispatcherThread* _monopolizer;
+        std::atomic<DispatcherThread*> _monopolizer;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief list of started threads
@@ -242,7 +384,7 @@ namespace triagens {
 /// soon be available for the dispatcher queue.
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _nrStarted;
+        std::atomic<size_t> _nrStarted;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief number of threads that are up
@@ -256,7 +398,7 @@ namespace triagens {
 /// 1, if a thread enters a special job.
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _nrUp;
+        std::atomic<size_t> _nrUp;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief number of running jobs
@@ -266,7 +408,7 @@ namespace triagens {
 /// job, this number is decreaes by 1.
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _nrRunning;
+        std::atomic<size_t> _nrRunning;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief number of waiting jobs
@@ -276,7 +418,7 @@ namespace triagens {
 /// number is decreased by 1.
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _nrWaiting;
+        std::atomic<size_t> _nrWaiting;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief number of stopped jobs
@@ -286,7 +428,7 @@ namespace triagens {
 /// list are deleted and the number is reset to zero.
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _nrStopped;
+        std::atomic<size_t> _nrStopped;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief number of special jobs
@@ -300,7 +442,7 @@ namespace triagens {
 /// started. This will increase the number _nrStarted.
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _nrSpecial;
+        std::atomic<size_t> _nrSpecial;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief number of blocked threads
@@ -308,7 +450,7 @@ namespace triagens {
 /// The number of threads, that are blocked for some reason. 
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _nrBlocked;
+        std::atomic<size_t> _nrBlocked;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief total number of threads
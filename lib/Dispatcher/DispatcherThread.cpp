@@ -61,7 +61,11 @@ DispatcherThread::DispatcherThread (DispatcherQueue* queue)
             ? std::string("_def")
             : std::string("_aql"))),
     _queue(queue),
-    _jobType(Job::READ_JOB) {
+    _jobType(Job::READ_JOB),
+    _localQueue(NoLocalQueue),
+    _stealPosition(0),
+    _working(false),
+    _executing(false) {
   allowAsynchronousCancelation();
 }
 
@@ -84,214 +88,243 @@ void DispatcherThread::run () {
   _queue->_nrUp++;
 
   _queue->_startedThreads.insert(this);
+  _queue->acquireLocalQueue(this);
+
+  _queue->_accessQueue.unlock();
 
   // iterate until we are shutting down.
   while (_jobType != Job::SPECIAL_JOB && _queue->_stopping == 0) {
 
-    // delete old jobs
-    for (list<DispatcherThread*>::iterator i = _queue->_stoppedThreads.begin();  i != _queue->_stoppedThreads.end();  ++i) {
-      delete *i;
-    }
+    // announce that we are going to execute a job. a monopolistic job waits
+    // until all other executing threads are done
+    _executing = true;
 
-    _queue->_stoppedThreads.clear();
-    _queue->_nrStopped = 0;
+    Job* job = nullptr;
 
-    // a job is waiting to execute
-    if (  ! _queue->_readyJobs.empty()
-         && _queue->_monopolizer == 0
-         && ! (_queue->_readyJobs.front()->type() == Job::WRITE_JOB && 1 < _queue->_nrRunning)) {
+    if (_queue->_monopolizer.load() == nullptr) {
+      // try next job, this does not lock the queue
+      job = _queue->fetchJob(this);
+    }
 
-      // try next job
-      Job* job = _queue->_readyJobs.front();
-      _queue->_readyJobs.pop_front();
+    // a job is waiting to execute
+    if (job != nullptr) {
 
       // handle job type
       _jobType = job->type();
 
       // start a new thread for special jobs
       if (_jobType == Job::SPECIAL_JOB) {
+        _queue->_accessQueue.lock();
+
         _queue->_nrRunning--;
         _queue->_nrSpecial++;
+        _executing = false;
         _queue->startQueueThread();
+
+        _queue->_accessQueue.unlock();
       }
 
       // monopolize queue
       else if (_jobType == Job::WRITE_JOB) {
-        _queue->_monopolizer = this;
+        _queue->monopolize(this);
       }
 
-      // set running job
-      _queue->_runningJobs.insert(job);
-
-      // now release the queue lock (initialise is inside the lock, work outside)
-      _queue->_accessQueue.unlock();
-
-      // do the work (this might change the job type)
-      Job::status_t status(Job::JOB_FAILED);
+      uint64_t const jobId = job->id();
 
-      try {
-        RequestStatisticsAgentSetQueueEnd(job);
-
-        // set current thread
-        job->setDispatcherThread(this);
-
-        // and do all the dirty work
-        status = job->work();
-      }
-      catch (Exception const& ex) {
+      // set running job
+      if (! _queue->beginJob(job)) {
+        // the job was canceled before it ran
         try {
-          job->handleError(ex);
-        }
-        catch (Exception const& ex) {
-          LOG_WARNING("caught error while handling error: %s", ex.what());
-        }
-        catch (std::exception const& ex) {
-          LOG_WARNING("caught error while handling error: %s", ex.what());
+          job->setDispatcherThread(nullptr);
+          job->cleanup();
         }
         catch (...) {
-          LOG_WARNING("caught error while handling error!");
+          LOG_WARNING("caught error while cleaning up!");
         }
-
-        status = Job::status_t(Job::JOB_FAILED);
       }
-      catch (std::exception const& ex) {
+      else {
+        // do the work (this might change the job type)
+        Job::status_t status(Job::JOB_FAILED);
+
+        _working = true;
+
         try {
-          Exception ex2(TRI_ERROR_INTERNAL, string("job failed with unknown in work: ") + ex.what(), __FILE__, __LINE__);
+          RequestStatisticsAgentSetQueueEnd(job);
+
+          // set current thread
+          job->setDispatcherThread(this);
 
-          job->handleError(ex2);
+          // and do all the dirty work
+          status = job->work();
         }
         catch (Exception const& ex) {
-          LOG_WARNING("caught error while handling error: %s", ex.what());
+          try {
+            job->handleError(ex);
+          }
+          catch (Exception const& ex) {
+            LOG_WARNING("caught error while handling error: %s", ex.what());
+          }
+          catch (std::exception const& ex) {
+            LOG_WARNING("caught error while handling error: %s", ex.what());
+          }
+          catch (...) {
+            LOG_WARNING("caught error while handling error!");
+          }
+
+          status = Job::status_t(Job::JOB_FAILED);
         }
         catch (std::exception const& ex) {
-          LOG_WARNING("caught error while handling error: %s", ex.what());
+          try {
+            Exception ex2(TRI_ERROR_INTERNAL, string("job failed with unknown in work: ") + ex.what(), __FILE__, __LINE__);
+
+            job->handleError(ex2);
+          }
+          catch (Exception const& ex) {
+            LOG_WARNING("caught error while handling error: %s", ex.what());
+          }
+          catch (std::exception const& ex) {
+            LOG_WARNING("caught error while handling error: %s", ex.what());
+          }
+          catch (...) {
+            LOG_WARNING("caught error while handling error!");
+          }
+
+          status = Job::status_t(Job::JOB_FAILED);
         }
         catch (...) {
-          LOG_WARNING("caught error while handling error!");
-        }
-
-        status = Job::status_t(Job::JOB_FAILED);
-      }
-      catch (...) {
 #ifdef TRI_HAVE_POSIX_THREADS
-        if (_queue->_stopping != 0) {
-          LOG_WARNING("caught cancellation exception during work");
-          throw;
-        }
+          if (_queue->_stopping != 0) {
+            LOG_WARNING("caught cancellation exception during work");
+            throw;
+          }
 #endif
 
-        try {
-          Exception ex(TRI_ERROR_INTERNAL, "job failed with unknown error in work", __FILE__, __LINE__);
+          try {
+            Exception ex(TRI_ERROR_INTERNAL, "job failed with unknown error in work", __FILE__, __LINE__);
 
-          job->handleError(ex);
-        }
-        catch (Exception const& ex) {
-          LOG_WARNING("caught error while handling error: %s", DIAGNOSTIC_INFORMATION(ex));
-        }
-        catch (std::exception const& ex) {
-          LOG_WARNING("caught error while handling error: %s", ex.what());
-        }
-        catch (...) {
-          LOG_WARNING("caught error while handling error!");
+            job->handleError(ex);
+          }
+          catch (Exception const& ex) {
+            LOG_WARNING("caught error while handling error: %s", DIAGNOSTIC_INFORMATION(ex));
+          }
+          catch (std::exception const& ex) {
+            LOG_WARNING("caught error while handling error: %s", ex.what());
+          }
+          catch (...) {
+            LOG_WARNING("caught error while handling error!");
+          }
+
+          status = Job::status_t(Job::JOB_FAILED);
         }
 
-        status = Job::status_t(Job::JOB_FAILED);
-      }
+        _working = false;
 
-      // clear running job
-      _queue->_accessQueue.lock();
-      _queue->_runningJobs.erase(job);
-      _queue->_accessQueue.unlock();
+        // clear running job
+        _queue->endJob(jobId);
 
-      // trigger GC
-      tick(false);
+        // trigger GC
+        tick(false);
 
-      // detached jobs (status == JOB::DETACH) might be killed asynchronously by other means
-      // it is not safe to use detached jobs after job->work()
+        // detached jobs (status == JOB::DETACH) might be killed asynchronously by other means
+        // it is not safe to use detached jobs after job->work()
 
-      if (status.status == Job::JOB_DETACH) {
-        // we must do absolutely nothing with dispatched jobs here because they might be
-        // killed asynchronously and this is not under our control
-      }
+        if (status.status == Job::JOB_DETACH) {
+          // we must do absolutely nothing with dispatched jobs here because they might be
+          // killed asynchronously and this is not under our control
+        }
 
-      // normal jobs
-      else {
+        // normal jobs
+        else {
 
-        // finish jobs
-        try {
-          job->setDispatcherThread(0);
+          // finish jobs
+          try {
+            job->setDispatcherThread(0);
 
-          if (status.status == Job::JOB_DONE) {
-            job->cleanup();
-          }
-          else if (status.status == Job::JOB_REQUEUE) {
-            if (0.0 < status.sleep) {
-              _queue->_scheduler->registerTask(
-                new RequeueTask(_queue->_scheduler,
-                                _queue->_dispatcher,
-                                status.sleep,
-                                job));
+            if (status.status == Job::JOB_DONE) {
+              job->cleanup();
             }
-            else {
-              _queue->_dispatcher->addJob(job);
+            else if (status.status == Job::JOB_REQUEUE) {
+              if (0.0 < status.sleep) {
+                _queue->_scheduler->registerTask(
+                  new RequeueTask(_queue->_scheduler,
+                                  _queue->_dispatcher,
+                                  status.sleep,
+                                  job));
+              }
+              else {
+                _queue->_dispatcher->addJob(job);
+              }
+            }
+            else if (status.status == Job::JOB_FAILED) {
+              job->cleanup();
             }
           }
-          else if (status.status == Job::JOB_FAILED) {
-            job->cleanup();
-          }
-        }
-        catch (...) {
+          catch (...) {
 #ifdef TRI_HAVE_POSIX_THREADS
-          if (_queue->_stopping != 0) {
-            LOG_WARNING("caught cancellation exception during cleanup");
-            throw;
-          }
+            if (_queue->_stopping != 0) {
+              LOG_WARNING("caught cancellation exception during cleanup");
+              throw;
+            }
 #endif
 
-          LOG_WARNING("caught error while cleaning up!");
+            LOG_WARNING("caught error while cleaning up!");
+          }
         }
       }
 
-      // require the lock
-      _queue->_accessQueue.lock();
-
       // cleanup
-      _queue->_monopolizer = 0;
+      _queue->unmonopolize(this);
 
-      if (0 < _queue->_nrWaiting && ! _queue->_readyJobs.empty()) {
-        _queue->_accessQueue.broadcast();
-      }
+      _executing = false;
     }
     else {
+      _executing = false;
 
       // cleanup without holding a lock
-      _queue->_accessQueue.unlock();
       tick(true);
+
       _queue->_accessQueue.lock();
 
+      // delete old threads
+      for (list<DispatcherThread*>::iterator i = _queue->_stoppedThreads.begin();  i != _queue->_stoppedThreads.end();  ++i) {
+        delete *i;
+      }
+
+      _queue->_stoppedThreads.clear();
+      _queue->_nrStopped = 0;
+
       // there is a chance, that we created more threads than necessary
       if (_queue->_nrThreads + _queue->_nrBlocked < _queue->_nrRunning + _queue->_nrStarted + _queue->_nrWaiting) {
         double n = TRI_microtime();
 
         if (_queue->_lastChanged + _queue->_gracePeriod < n) {
           _queue->_lastChanged = n;
+          _queue->_accessQueue.unlock();
           break;
         }
       }
 
-      // wait, if there are no jobs
-      if (_queue->_readyJobs.empty()) {
-        _queue->_nrRunning--;
-        _queue->_nrWaiting++;
+      // wait, if there are no jobs. we must announce that we are waiting
+      // before checking for jobs, see DispatcherQueue::wakeupThread
+      _queue->_nrRunning--;
+      _queue->_nrWaiting++;
 
+      if ((_queue->_nrReady.load() == 0 || _queue->_monopolizer.load() != nullptr) &&
+          _queue->_stopping == 0) {
         _queue->_accessQueue.wait();
-
-        _queue->_nrWaiting--;
-        _queue->_nrRunning++;
       }
+
+      _queue->_nrWaiting--;
+      _queue->_nrRunning++;
+
+      _queue->_accessQueue.unlock();
     }
   }
 
+  _queue->_accessQueue.lock();
+
+  _queue->releaseLocalQueue(this);
+
   _queue->_stoppedThreads.push_back(this);
   _queue->_startedThreads.erase(this);
 
@@ -354,6 +387,12 @@ void DispatcherThread::tick (bool) {
 
 thread_local DispatcherThread* DispatcherThread::currentDispatcherThread = nullptr;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marker for threads without a local queue
+////////////////////////////////////////////////////////////////////////////////
+
+size_t const DispatcherThread::NoLocalQueue = SIZE_MAX;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -144,6 +144,38 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         Job::JobType _jobType;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief position of the thread's local queue, or NoLocalQueue
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _localQueue;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief local queue to start stealing from
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _stealPosition;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the thread is inside Job::work()
+///
+/// jobs added while working go to the thread's local queue
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _working;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the thread is about to execute or executes a job
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<bool> _executing;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marker for threads without a local queue
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t const NoLocalQueue;
     };
   }
 }
@@ -103,6 +103,7 @@ ApplicationEndpointServer::ApplicationEndpointServer (ApplicationServer* applica
     _keepAliveTimeout(300.0),
     _defaultApiCompatibility(0),
     _allowMethodOverride(false),
+    _compressResponseThreshold(4096),
     _backlogSize(64),
     _httpsKeyfile(),
     _cafile(),
@@ -215,6 +216,7 @@ void ApplicationEndpointServer::setupOptions (map<string, ProgramOptionsDescript
   options["Server Options:help-admin"]
     ("server.allow-method-override", &_allowMethodOverride, "allow HTTP method override using special headers")
     ("server.backlog-size", &_backlogSize, "listen backlog size")
+    ("server.compress-response-threshold", &_compressResponseThreshold, "minimum body size in bytes for compressed responses (0 = never compress)")
     ("server.default-api-compatibility", &_defaultApiCompatibility, "default API compatibility version")
     ("server.keep-alive-timeout", &_keepAliveTimeout, "keep-alive timeout in seconds")
     ("server.reuse-address", &_reuseAddress, "try to reuse address")
@@ -558,6 +560,7 @@ bool ApplicationEndpointServer::prepare () {
   _handlerFactory = new HttpHandlerFactory(_authenticationRealm,
                                            _defaultApiCompatibility,
                                            _allowMethodOverride,
+                                           _compressResponseThreshold,
                                            _setContext,
                                            _contextData);
 
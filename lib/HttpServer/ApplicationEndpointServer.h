@@ -432,6 +432,24 @@ namespace triagens {
 
         bool _allowMethodOverride;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimum size of compressed responses
+/// @startDocuBlock serverCompressResponseThreshold
+/// `--server.compress-response-threshold`
+///
+/// Response bodies of at least this many bytes are compressed if the client
+/// sends an *Accept-Encoding* header containing *gzip* or *deflate*. The
+/// compression is done with the fastest compression level by the dispatcher
+/// thread that produced the response, so it does not delay other connections.
+/// Streamed (chunked) responses and responses that are already compressed
+/// are sent as is.
+///
+/// A value of 0 disables response compression. The default value is 4096.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _compressResponseThreshold;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief listen backlog size
 /// @startDocuBlock serverBacklog
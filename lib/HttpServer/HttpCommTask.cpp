@@ -153,13 +153,15 @@ HttpCommTask::HttpCommTask (HttpServer* server,
     _connectionInfo(info),
     _server(server),
     _writeBuffers(),
+    _writeBuffersSegments(),
 #ifdef TRI_ENABLE_FIGURES
     _writeBuffersStats(),
 #endif
     _readPosition(0),
     _bodyPosition(0),
     _bodyLength(0),
-    _requestPending(false),
+    _pipeline(),
+    _requestId(0),
     _closeRequested(false),
     _readRequestBody(false),
     _request(nullptr),
@@ -171,7 +173,6 @@ HttpCommTask::HttpCommTask (HttpServer* server,
     _fullUrl(),
     _origin(),
     _denyCredentials(false),
-    _acceptDeflate(false),
     _newRequest(true),
     _startPosition(0),
     _sinceCompactification(0),
@@ -214,6 +215,31 @@ HttpCommTask::~HttpCommTask () {
     delete i;
   }
 
+  for (auto& i : _writeBuffersSegments) {
+    for (auto j : i) {
+      delete j;
+    }
+  }
+
+  // free responses that were not queued yet
+  for (auto& i : _pipeline) {
+    delete i._buffer;
+
+    for (auto j : i._segments) {
+      delete j;
+    }
+
+    for (auto j : i._chunks) {
+      delete j;
+    }
+
+#ifdef TRI_ENABLE_FIGURES
+    if (i._statistics != nullptr) {
+      TRI_ReleaseRequestStatistics(i._statistics);
+    }
+#endif
+  }
+
 #ifdef TRI_ENABLE_FIGURES
 
   for (auto i : _writeBuffersStats) {
@@ -258,20 +284,37 @@ void HttpCommTask::beginShutdown ()  {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief handles response
+/// @brief handles the response for the request currently being processed
 ////////////////////////////////////////////////////////////////////////////////
 
-void HttpCommTask::handleResponse (HttpResponse * response)  {
-  if (response->isChunked()) {
-    _requestPending = true;
-    _isChunked = true;
-  }
-  else {
-    _requestPending = false;
-    _isChunked = false;
+void HttpCommTask::handleResponse (HttpResponse* response)  {
+  pipelined_request_t& request = currentRequest();
+
+  request._handler = nullptr;
+  request._statistics = RequestStatisticsAgent::transfer();
+
+  addResponse(response, request);
+  queueResponses();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief handles the response a handler created for its request
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpCommTask::handleResponse (HttpHandler* handler,
+                                   HttpResponse* response) {
+  for (auto& request : _pipeline) {
+    if (request._handler == handler) {
+      request._handler = nullptr;
+      request._statistics = handler->RequestStatisticsAgent::transfer();
+
+      addResponse(response, request);
+      queueResponses();
+      return;
+    }
   }
 
-  addResponse(response);
+  LOG_WARNING("got a response for an unknown request, giving up");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -279,7 +322,12 @@ void HttpCommTask::handleResponse (HttpResponse * response)  {
 ////////////////////////////////////////////////////////////////////////////////
 
 bool HttpCommTask::processRead () {
-  if (_requestPending || _readBuffer->c_str() == nullptr) {
+  if (_closeRequested || _readBuffer->c_str() == nullptr) {
+    return false;
+  }
+
+  // read ahead only as far as the previous requests allow
+  if (_newRequest && ! _pipeline.empty() && ! canPipelineRequest()) {
     return false;
   }
 
@@ -296,12 +344,12 @@ bool HttpCommTask::processRead () {
 #endif
 
       _newRequest      = false;
+      _requestId++;
       _startPosition   = _readPosition;
       _httpVersion     = HttpRequest::HTTP_UNKNOWN;
       _requestType     = HttpRequest::HTTP_REQUEST_ILLEGAL;
       _fullUrl         = "";
       _denyCredentials = false;
-      _acceptDeflate   = false;
 
       _sinceCompactification++;
     }
@@ -510,18 +558,15 @@ bool HttpCommTask::processRead () {
         bool found;
         string const& expect = _request->header("expect", found);
 
-        if (found && StringUtils::trim(expect) == "100-continue") {
+        // the interim response must not overtake the responses of previous
+        // requests. the client will send the body after a timeout then
+        if (found && StringUtils::trim(expect) == "100-continue" && _pipeline.empty()) {
           LOG_TRACE("received a 100-continue request");
 
           StringBuffer* buffer = new StringBuffer(TRI_UNKNOWN_MEM_ZONE);
           buffer->appendText("HTTP/1.1 100 (Continue)\r\n\r\n");
 
-          _writeBuffers.push_back(buffer);
-
-#ifdef TRI_ENABLE_FIGURES
-          _writeBuffersStats.push_back(0);
-#endif
-
+          addWriteBuffer(buffer);
           fillWriteBuffer();
         }
       }
@@ -544,11 +589,20 @@ bool HttpCommTask::processRead () {
       return false;
     }
 
-    // read "bodyLength" from read buffer and add this body to "httpRequest"
-    _request->setBody(_readBuffer->c_str() + _bodyPosition, _bodyLength);
-
     LOG_TRACE("%s", string(_readBuffer->c_str() + _bodyPosition, _bodyLength).c_str());
 
+    // read "bodyLength" from read buffer and add this body to "httpRequest"
+    if (_bodyLength >= MinimalAdoptBodySize &&
+        _readBuffer->length() == _bodyPosition + _bodyLength) {
+      // no further request has been received yet. hand the read buffer over
+      // to the request instead of copying the body. the next read will
+      // allocate a new buffer
+      _request->adoptBody(_readBuffer->steal(), _bodyPosition, _bodyLength);
+    }
+    else {
+      _request->setBody(_readBuffer->c_str() + _bodyPosition, _bodyLength);
+    }
+
     // remove body from read buffer and reset read position
     _readRequestBody = false;
     handleRequest = true;
@@ -672,17 +726,20 @@ bool HttpCommTask::processRead () {
 
 void HttpCommTask::sendChunk (StringBuffer* buffer) {
   if (_isChunked) {
-    _writeBuffers.push_back(buffer);
-
-#ifdef TRI_ENABLE_FIGURES
-    _writeBuffersStats.push_back(0);
-#endif
-
+    addWriteBuffer(buffer);
     fillWriteBuffer();
+    return;
   }
-  else {
-    delete buffer;
+
+  // the chunked response is still waiting for previous responses
+  for (auto& request : _pipeline) {
+    if (request._isChunked && ! request._chunkedFinished) {
+      request._chunks.push_back(buffer);
+      return;
+    }
   }
+
+  delete buffer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -690,20 +747,28 @@ void HttpCommTask::sendChunk (StringBuffer* buffer) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void HttpCommTask::finishedChunked () {
-  StringBuffer* buffer = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, 6);
-  buffer->appendText("0\r\n\r\n");
-
-  _writeBuffers.push_back(buffer);
+  if (_isChunked) {
+    StringBuffer* buffer = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, 6);
+    buffer->appendText("0\r\n\r\n");
 
-#ifdef TRI_ENABLE_FIGURES
-  _writeBuffersStats.push_back(0);
-#endif
+    addWriteBuffer(buffer);
+    _isChunked = false;
 
-  _isChunked = false;
-  _requestPending = false;
+    // responses held back by the chunked response can be written now
+    queueResponses();
+  }
+  else {
+    for (auto& request : _pipeline) {
+      if (request._isChunked && ! request._chunkedFinished) {
+        request._chunkedFinished = true;
+        break;
+      }
+    }
+  }
 
-  fillWriteBuffer();
-  processRead();
+  while (processRead()) {
+    // process all requests that can be processed now
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -719,13 +784,66 @@ void HttpCommTask::setupDone () {
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief reads data from the socket
+/// @brief returns the pipeline entry of the request currently being processed
+////////////////////////////////////////////////////////////////////////////////
+
+HttpCommTask::pipelined_request_t& HttpCommTask::currentRequest () {
+  if (_pipeline.empty() || _pipeline.back()._id != _requestId) {
+    _pipeline.emplace_back();
+
+    pipelined_request_t& request = _pipeline.back();
+    request._id                 = _requestId;
+    request._handler            = nullptr;
+    request._requestType        = _requestType;
+    request._httpVersion        = _httpVersion;
+    request._fullUrl            = _fullUrl;
+    request._origin             = _origin;
+    request._denyCredentials    = _denyCredentials;
+    request._closeRequested     = _closeRequested;
+    request._originalBodyLength = _originalBodyLength;
+    request._buffer             = nullptr;
+    request._statistics         = nullptr;
+    request._isChunked          = false;
+    request._chunkedFinished    = false;
+  }
+
+  return _pipeline.back();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether the next request may be read while previous
+/// requests are still being executed
+////////////////////////////////////////////////////////////////////////////////
+
+bool HttpCommTask::canPipelineRequest () const {
+  if (_pipeline.size() >= MaximalPipelinedRequests) {
+    return false;
+  }
+
+  HttpRequest::HttpRequestType type = _pipeline.back()._requestType;
+
+  if (type != HttpRequest::HTTP_REQUEST_GET &&
+      type != HttpRequest::HTTP_REQUEST_HEAD) {
+    return false;
+  }
+
+  // peek at the method of the next request
+  char const* ptr = _readBuffer->c_str() + _readPosition;
+  size_t const length = _readBuffer->length() - _readPosition;
+
+  return (length >= 4 && memcmp(ptr, "GET ", 4) == 0) ||
+         (length >= 5 && memcmp(ptr, "HEAD ", 5) == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes the response of a request into its pipeline entry
 ////////////////////////////////////////////////////////////////////////////////
 
-void HttpCommTask::addResponse (HttpResponse* response) {
+void HttpCommTask::addResponse (HttpResponse* response,
+                                pipelined_request_t& request) {
 
   // CORS response handling
-  if (! _origin.empty()) {
+  if (! request._origin.empty()) {
 
     // the request contained an Origin header. We have to send back the
     // access-control-allow-origin header now
@@ -740,10 +858,10 @@ void HttpCommTask::addResponse (HttpResponse* response) {
     // x-arango-replication-lasttick, x-arango-replication-active");
 
     // send back original value of "Origin" header
-    response->setHeader("access-control-allow-origin", strlen("access-control-allow-origin"), _origin);
+    response->setHeader("access-control-allow-origin", strlen("access-control-allow-origin"), request._origin);
 
     // send back "Access-Control-Allow-Credentials" header
-    if (_denyCredentials) {
+    if (request._denyCredentials) {
       response->setHeader("access-control-allow-credentials", "false");
     }
     else {
@@ -753,7 +871,7 @@ void HttpCommTask::addResponse (HttpResponse* response) {
   // CORS request handling EOF
 
   // set "connection" header
-  if (_closeRequested) {
+  if (request._closeRequested || _closeRequested) {
     response->setHeader("connection", strlen("connection"), "Close");
   }
   else {
@@ -763,72 +881,144 @@ void HttpCommTask::addResponse (HttpResponse* response) {
 
   size_t responseBodyLength = response->bodySize();
 
-  if (_requestType == HttpRequest::HTTP_REQUEST_HEAD) {
+  if (request._requestType == HttpRequest::HTTP_REQUEST_HEAD) {
     // clear body if this is an HTTP HEAD request
     // HEAD must not return a body
     response->headResponse(responseBodyLength);
   }
-  // else {
-  //    // to enable automatic deflating of responses, active this.
-  //   // deflate takes a lot of CPU time so it should only be enabled for
-  //   // dedicated purposes and not generally
-  //   if (responseBodyLength > 16384  && _acceptDeflate) {
-  //     response->deflate();
-  //     responseBodyLength = response->bodySize();
-  //   }
-  // }
+
+  request._isChunked = response->isChunked();
+
+  // responses are compressed by the dispatcher thread that created them, see
+  // HttpHandler::compressResponse. compressing here would block the scheduler
+
+  // big bodies are not copied behind the header, but sent as a segment of
+  // their own. the socket task writes all segments with a single system call
+  bool const bodySegment = (request._requestType != HttpRequest::HTTP_REQUEST_HEAD &&
+                            response->body().length() >= MinimalBodySegmentSize);
 
   // reserve some outbuffer size
   StringBuffer* buffer
-    = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, responseBodyLength + 128);
+    = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, (bodySegment ? 0 : responseBodyLength) + 128);
+
+  std::vector<StringBuffer*> segments;
 
   // write header
   response->writeHeader(buffer);
 
   // write body
-  if (_requestType != HttpRequest::HTTP_REQUEST_HEAD) {
-    if (_isChunked) {
+  if (request._requestType != HttpRequest::HTTP_REQUEST_HEAD) {
+    if (request._isChunked) {
       if (0 != responseBodyLength) {
         buffer->appendHex(response->body().length());
         buffer->appendText("\r\n");
-        buffer->appendText(response->body());
-        buffer->appendText("\r\n");
+
+        if (bodySegment) {
+          segments.push_back(stealBody(response));
+
+          StringBuffer* trailer = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, 2);
+          trailer->appendText("\r\n");
+          segments.push_back(trailer);
+        }
+        else {
+          buffer->appendText(response->body());
+          buffer->appendText("\r\n");
+        }
       }
     }
+    else if (bodySegment) {
+      segments.push_back(stealBody(response));
+    }
     else {
       buffer->appendText(response->body());
     }
   }
 
-  _writeBuffers.push_back(buffer);
-          
+  request._buffer = buffer;
+  request._segments = std::move(segments);
+
   LOG_TRACE("HTTP WRITE FOR %p: %s", (void*) this, buffer->c_str());
-          
+
   // clear body
   response->body().clear();
-          
+
   double totalTime = 0.0;
 
 #ifdef TRI_ENABLE_FIGURES
-  _writeBuffersStats.push_back(RequestStatisticsAgent::transfer());
-  totalTime = RequestStatisticsAgent::elapsedSinceReadStart();
+  if (request._statistics != nullptr && request._statistics->_readStart != 0.0) {
+    totalTime = TRI_StatisticsTime() - request._statistics->_readStart;
+  }
 #endif
 
   // disable the following statement to prevent excessive logging of incoming requests
   LOG_USAGE(",\"http-request\",\"%s\",\"%s\",\"%s\",%d,%llu,%llu,\"%s\",%.6f",
             _connectionInfo.clientAddress.c_str(),
-            HttpRequest::translateMethod(_requestType).c_str(),
-            HttpRequest::translateVersion(_httpVersion).c_str(),
+            HttpRequest::translateMethod(request._requestType).c_str(),
+            HttpRequest::translateVersion(request._httpVersion).c_str(),
             (int) response->responseCode(),
-            (unsigned long long) _originalBodyLength,
+            (unsigned long long) request._originalBodyLength,
             (unsigned long long) responseBodyLength,
-            _fullUrl.c_str(),
+            request._fullUrl.c_str(),
             totalTime);
-          
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief moves the responses that are next in order to the write buffers
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpCommTask::queueResponses () {
+  while (! _isChunked && ! _pipeline.empty()) {
+    pipelined_request_t& request = _pipeline.front();
+
+    if (request._buffer == nullptr) {
+      // response is still missing
+      break;
+    }
+
+    _writeBuffers.push_back(request._buffer);
+    _writeBuffersSegments.push_back(std::move(request._segments));
+
+#ifdef TRI_ENABLE_FIGURES
+    _writeBuffersStats.push_back(request._statistics);
+#endif
+
+    if (request._isChunked) {
+      for (auto chunk : request._chunks) {
+        addWriteBuffer(chunk);
+      }
+
+      if (request._chunkedFinished) {
+        StringBuffer* buffer = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, 6);
+        buffer->appendText("0\r\n\r\n");
+
+        addWriteBuffer(buffer);
+      }
+      else {
+        // further chunks are written directly
+        _isChunked = true;
+      }
+    }
+
+    _pipeline.pop_front();
+  }
+
   // start output
   fillWriteBuffer();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief appends a buffer without statistics to the write buffers
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpCommTask::addWriteBuffer (StringBuffer* buffer) {
+  _writeBuffers.push_back(buffer);
+  _writeBuffersSegments.emplace_back();
+
+#ifdef TRI_ENABLE_FIGURES
+  _writeBuffersStats.push_back(0);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// check the content-length header of a request and fail it is broken
 ////////////////////////////////////////////////////////////////////////////////
@@ -872,6 +1062,21 @@ bool HttpCommTask::checkContentLength (bool expectContentLength) {
   if (_bodyLength > 0) {
     // we'll read the body
     _readRequestBody = true;
+
+    // make room for big bodies at once instead of growing the read buffer
+    // step by step, which would copy the body over and over. the announced
+    // length is not trusted beyond MaximalBodyReserveSize, the buffer grows
+    // further while the body arrives
+    if (_bodyLength >= MinimalAdoptBodySize &&
+        _bodyPosition + _bodyLength > _readBuffer->length()) {
+      size_t missing = _bodyPosition + _bodyLength - _readBuffer->length();
+
+      if (missing > MaximalBodyReserveSize) {
+        missing = MaximalBodyReserveSize;
+      }
+
+      _readBuffer->reserve(missing);
+    }
   }
 
   // everything's fine
@@ -887,6 +1092,9 @@ void HttpCommTask::fillWriteBuffer () {
     StringBuffer * buffer = _writeBuffers.front();
     _writeBuffers.pop_front();
 
+    std::vector<StringBuffer*> segments(std::move(_writeBuffersSegments.front()));
+    _writeBuffersSegments.pop_front();
+
 #ifdef TRI_ENABLE_FIGURES
     TRI_request_statistics_t* statistics = _writeBuffersStats.front();
     _writeBuffersStats.pop_front();
@@ -894,10 +1102,26 @@ void HttpCommTask::fillWriteBuffer () {
     TRI_request_statistics_t* statistics = nullptr;
 #endif
 
-    setWriteBuffer(buffer, statistics);
+    if (segments.empty()) {
+      setWriteBuffer(buffer, statistics);
+    }
+    else {
+      setWriteBuffer(buffer, segments, statistics);
+    }
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief moves the body out of a response, without copying it
+////////////////////////////////////////////////////////////////////////////////
+
+StringBuffer* HttpCommTask::stealBody (HttpResponse* response) {
+  StringBuffer* body = new StringBuffer(TRI_UNKNOWN_MEM_ZONE);
+  body->swap(&response->body());
+
+  return body;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief handles CORS options
 ////////////////////////////////////////////////////////////////////////////////
@@ -953,16 +1177,8 @@ void HttpCommTask::processRequest (uint32_t compatibility) {
     return;
   }
 
-  bool found;
-  string const& acceptEncoding = _request->header("accept-encoding", found);
-
-  if (found) {
-    if (acceptEncoding.find("deflate") != string::npos) {
-      _acceptDeflate = true;
-    }
-  }
-
   // check for an async request
+  bool found;
   string const& asyncExecution = _request->header("x-arango-async", found);
 
   // clear request object
@@ -1005,6 +1221,10 @@ void HttpCommTask::processRequest (uint32_t compatibility) {
 
   // synchronous request
   else {
+    // the handler passes on the response itself, and possibly only after
+    // further requests have been read
+    currentRequest()._handler = handler;
+
     ok = _server->handleRequest(this, handler);
   }
 
@@ -1038,7 +1258,6 @@ void HttpCommTask::resetState (bool close) {
   if (close) {
     clearRequest();
 
-    _requestPending = false;
     _closeRequested = true;
 
     _readPosition    = 0;
@@ -1046,8 +1265,6 @@ void HttpCommTask::resetState (bool close) {
     _bodyLength      = 0;
   }
   else {
-    _requestPending = true;
-
     bool compact = false;
 
     if (_sinceCompactification > COMPACT_EVERY) {
@@ -1057,7 +1274,12 @@ void HttpCommTask::resetState (bool close) {
       compact = true;
     }
 
-    if (compact) {
+    if (_readBuffer->c_str() == nullptr) {
+      // the read buffer was handed over to the request
+      _sinceCompactification = 0;
+      _readPosition = 0;
+    }
+    else if (compact) {
       _readBuffer->erase_front(_bodyPosition + _bodyLength);
 
       _sinceCompactification = 0;
@@ -1225,7 +1447,7 @@ void HttpCommTask::completedWriteBuffer () {
 
   fillWriteBuffer();
 
-  if (! _clientClosed && _closeRequested && ! hasWriteBuffer() && _writeBuffers.empty() && ! _isChunked) {
+  if (! _clientClosed && _closeRequested && ! hasWriteBuffer() && _writeBuffers.empty() && _pipeline.empty() && ! _isChunked) {
     _clientClosed = true;
     _server->handleCommunicationClosed(this);
   }
@@ -39,6 +39,7 @@
 namespace triagens {
   namespace rest {
     class HttpCommTask;
+    class HttpHandler;
     class HttpServer;
     class HttpResponse;
     class HttpRequest;
@@ -79,6 +80,36 @@ namespace triagens {
       HttpCommTask (HttpCommTask const&) = delete;
       HttpCommTask const& operator= (HttpCommTask const&) = delete;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bodies of at least this size are not copied out of the read buffer,
+/// but the read buffer is handed over to the request
+////////////////////////////////////////////////////////////////////////////////
+
+      static size_t const MinimalAdoptBodySize = 64 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximal number of bytes reserved for a body before it arrives
+///
+/// the content-length is announced by the client, so larger bodies must not
+/// be allocated before the data is actually received
+////////////////////////////////////////////////////////////////////////////////
+
+      static size_t const MaximalBodyReserveSize = 4 * 1024 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief response bodies of at least this size are not copied into the
+/// write buffer, but sent as a separate segment
+////////////////////////////////////////////////////////////////////////////////
+
+      static size_t const MinimalBodySegmentSize = 16 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximal number of pipelined requests of a connection that are
+/// executed at the same time
+////////////////////////////////////////////////////////////////////////////////
+
+      static size_t const MaximalPipelinedRequests = 8;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -120,11 +151,17 @@ namespace triagens {
         void beginShutdown ();
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief handles response
+/// @brief handles the response for the request currently being processed
 ////////////////////////////////////////////////////////////////////////////////
 
         void handleResponse (HttpResponse*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief handles the response a handler created for its request
+////////////////////////////////////////////////////////////////////////////////
+
+        void handleResponse (HttpHandler*, HttpResponse*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief reads data from the socket
 ////////////////////////////////////////////////////////////////////////////////
@@ -149,6 +186,38 @@ namespace triagens {
 
         void setupDone ();
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a request that has been read, but whose response is not yet written
+///
+/// the request object itself is gone when the response arrives, so everything
+/// needed for the response is kept here. a response is held back until the
+/// responses of all previous requests of the connection have been queued
+////////////////////////////////////////////////////////////////////////////////
+
+        struct pipelined_request_t {
+          uint64_t _id;
+          HttpHandler* _handler;
+          HttpRequest::HttpRequestType _requestType;
+          HttpRequest::HttpVersion _httpVersion;
+          std::string _fullUrl;
+          std::string _origin;
+          bool _denyCredentials;
+          bool _closeRequested;
+          size_t _originalBodyLength;
+          basics::StringBuffer* _buffer;
+          std::vector<basics::StringBuffer*> _segments;
+          TRI_request_statistics_t* _statistics;
+          bool _isChunked;
+          bool _chunkedFinished;
+          std::vector<basics::StringBuffer*> _chunks;
+        };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -156,10 +225,39 @@ namespace triagens {
       private:
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief reads data from the socket
+/// @brief returns the pipeline entry of the request currently being processed
+////////////////////////////////////////////////////////////////////////////////
+
+        pipelined_request_t& currentRequest ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether the next request may be read while previous
+/// requests are still being executed
+///
+/// only GET and HEAD requests are executed side by side, and not while a
+/// request with another method is executed. this keeps changes and reads of
+/// the same client in order
+////////////////////////////////////////////////////////////////////////////////
+
+        bool canPipelineRequest () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes the response of a request into its pipeline entry
+////////////////////////////////////////////////////////////////////////////////
+
+        void addResponse (HttpResponse*, pipelined_request_t&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief moves the responses that are next in order to the write buffers
+////////////////////////////////////////////////////////////////////////////////
+
+        void queueResponses ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief appends a buffer without statistics to the write buffers
 ////////////////////////////////////////////////////////////////////////////////
 
-        void addResponse (HttpResponse*);
+        void addWriteBuffer (basics::StringBuffer*);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// check the content-length header of a request and fail it is broken
@@ -173,6 +271,12 @@ namespace triagens {
 
         void fillWriteBuffer ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief moves the body out of a response, without copying it
+////////////////////////////////////////////////////////////////////////////////
+
+        static basics::StringBuffer* stealBody (HttpResponse*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief handles CORS options
 ////////////////////////////////////////////////////////////////////////////////
@@ -302,6 +406,12 @@ namespace triagens {
 
         std::deque<basics::StringBuffer*> _writeBuffers;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief further segments of the write buffers, e.g. response bodies
+////////////////////////////////////////////////////////////////////////////////
+
+        std::deque<std::vector<basics::StringBuffer*>> _writeBuffersSegments;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief statistics buffers
 ////////////////////////////////////////////////////////////////////////////////
@@ -329,10 +439,17 @@ namespace triagens {
         size_t _bodyLength;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief true if request is complete but not handled
+/// @brief requests that have been read, in order, until their responses are
+/// queued for writing
+////////////////////////////////////////////////////////////////////////////////
+
+        std::deque<pipelined_request_t> _pipeline;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief id of the request currently being read
 ////////////////////////////////////////////////////////////////////////////////
 
-        bool _requestPending;
+        uint64_t _requestId;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief true if a close has been requested by the client
@@ -404,12 +521,6 @@ namespace triagens {
 
         bool _denyCredentials;
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief whether the client accepts deflate algorithm
-////////////////////////////////////////////////////////////////////////////////
-
-        bool _acceptDeflate;
-
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief new request started
 ////////////////////////////////////////////////////////////////////////////////
@@ -436,6 +547,8 @@ namespace triagens {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief true if within a chunked response
+///
+/// no further responses are written until the chunked response is finished
 ////////////////////////////////////////////////////////////////////////////////
 
         bool _isChunked;
@@ -30,9 +30,12 @@
 #include "HttpHandler.h"
 
 #include "Basics/logging.h"
+#include "Basics/StringUtils.h"
+#include "HttpServer/HttpHandlerFactory.h"
 #include "HttpServer/HttpServerJob.h"
 #include "Rest/HttpRequest.h"
 
+using namespace triagens::basics;
 using namespace triagens::rest;
 
 // -----------------------------------------------------------------------------
@@ -122,6 +125,83 @@ HttpResponse* HttpHandler::stealResponse () {
   return tmp;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compress the response if the client accepts a compressed response
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpHandler::compressResponse () {
+  if (_server == nullptr || _request == nullptr || _response == nullptr) {
+    return;
+  }
+
+  uint64_t const threshold = _server->compressionThreshold();
+
+  if (threshold == 0 ||
+      _response->bodySize() < threshold ||
+      _response->isChunked() ||
+      _response->isHeadResponse() ||
+      _request->requestType() == HttpRequest::HTTP_REQUEST_HEAD) {
+    return;
+  }
+
+  bool found;
+  _response->header("content-encoding", strlen("content-encoding"), found);
+
+  if (found) {
+    // the handler has compressed the body itself
+    return;
+  }
+
+  char const* acceptEncoding = _request->header("accept-encoding", found);
+
+  if (! found) {
+    return;
+  }
+
+  bool gzip = false;
+  bool deflate = false;
+
+  for (auto& part : StringUtils::split(acceptEncoding, ',')) {
+    // a quality value of 0 means "not acceptable"
+    std::vector<std::string> params = StringUtils::split(part, ';');
+
+    if (params.empty()) {
+      continue;
+    }
+
+    std::string const coding = StringUtils::tolower(StringUtils::trim(params[0]));
+
+    bool acceptable = true;
+
+    for (size_t i = 1; i < params.size(); ++i) {
+      std::string const param = StringUtils::trim(params[i]);
+
+      if (param.size() > 2 && param[0] == 'q' && param[1] == '=') {
+        acceptable = (StringUtils::doubleDecimal(param.substr(2)) > 0.0);
+      }
+    }
+
+    if (coding == "gzip" || coding == "x-gzip") {
+      gzip = acceptable;
+    }
+    else if (coding == "deflate") {
+      deflate = acceptable;
+    }
+  }
+
+  if (! gzip && ! deflate) {
+    return;
+  }
+
+  int res = _response->compress(gzip, Z_BEST_SPEED);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    // the body is lost if compression failed half-way
+    LOG_WARNING("unable to compress response: %s", TRI_errno_string(res));
+    _response = createResponse(HttpResponse::SERVER_ERROR);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   Handler methods
 // -----------------------------------------------------------------------------
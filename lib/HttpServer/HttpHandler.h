@@ -125,6 +125,16 @@ namespace triagens {
 
         HttpResponse* stealResponse ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compress the response if the client accepts a compressed response
+/// and the body is big enough
+///
+/// this is called by the dispatcher thread that executed the handler, so the
+/// compression does not block the scheduler thread
+////////////////////////////////////////////////////////////////////////////////
+
+        void compressResponse ();
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   Handler methods
 // -----------------------------------------------------------------------------
@@ -86,11 +86,13 @@ namespace {
 HttpHandlerFactory::HttpHandlerFactory (std::string const& authenticationRealm,
                                         int32_t minCompatibility,
                                         bool allowMethodOverride,
+                                        uint64_t compressionThreshold,
                                         context_fptr setContext,
                                         void* setContextData)
   : _authenticationRealm(authenticationRealm),
     _minCompatibility(minCompatibility),
     _allowMethodOverride(allowMethodOverride),
+    _compressionThreshold(compressionThreshold),
     _setContext(setContext),
     _setContextData(setContextData),
     _notFound(0) {
@@ -104,6 +106,7 @@ HttpHandlerFactory::HttpHandlerFactory (HttpHandlerFactory const& that)
   : _authenticationRealm(that._authenticationRealm),
     _minCompatibility(that._minCompatibility),
     _allowMethodOverride(that._allowMethodOverride),
+    _compressionThreshold(that._compressionThreshold),
     _setContext(that._setContext),
     _setContextData(that._setContextData),
     _constructors(that._constructors),
@@ -121,6 +124,7 @@ HttpHandlerFactory& HttpHandlerFactory::operator= (HttpHandlerFactory const& tha
     _authenticationRealm = that._authenticationRealm;
     _minCompatibility = that._minCompatibility;
     _allowMethodOverride = that._allowMethodOverride;
+    _compressionThreshold = that._compressionThreshold;
     _setContext = that._setContext;
     _setContextData = that._setContextData;
     _constructors = that._constructors;
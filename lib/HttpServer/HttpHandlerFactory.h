@@ -116,6 +116,7 @@ namespace triagens {
         HttpHandlerFactory (std::string const&,
                             int32_t,
                             bool,
+                            uint64_t,
                             context_fptr,
                             void*);
 
@@ -161,6 +162,15 @@ namespace triagens {
 
         virtual size_restriction_t sizeRestrictions () const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the minimum body size for compressed responses, 0 means
+/// responses are never compressed
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t compressionThreshold () const {
+          return _compressionThreshold;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief authenticates a new request, wrapper method
 ////////////////////////////////////////////////////////////////////////////////
@@ -237,6 +247,12 @@ namespace triagens {
 
         bool _allowMethodOverride;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimum body size for compressed responses
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _compressionThreshold;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief set context callback
 ////////////////////////////////////////////////////////////////////////////////
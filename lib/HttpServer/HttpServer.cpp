@@ -389,50 +389,62 @@ void HttpServer::handleCommunicationFailure (HttpCommTask* task) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void HttpServer::handleAsync (HttpCommTask* task) {
+  std::vector<HttpHandler*> handlers;
+
   GENERAL_SERVER_LOCK(&_mappingLock);
 
-  auto&& it = _task2handler.find(task);
+  // a task has several handlers if requests are pipelined, and one signal
+  // might stand for several finished jobs. collect all handlers whose job
+  // is done
+  auto&& range = _task2handler.equal_range(task);
 
-  if (it == _task2handler.end() || it->second._task != task) {
-    LOG_WARNING("cannot find a task for the handler, giving up");
+  for (auto it = range.first;  it != range.second;) {
+    HttpHandler* handler = it->second;
+    auto&& jt = _handlers.find(handler);
 
-    GENERAL_SERVER_UNLOCK(&_mappingLock);
-    return;
+    if (jt != _handlers.end() && jt->second._job == nullptr) {
+      handlers.push_back(handler);
+
+      _handlers.erase(jt);
+      it = _task2handler.erase(it);
+    }
+    else {
+      ++it;
+    }
   }
 
-  handler_task_job_t element = it->second;
-  _task2handler.erase(it);
+  GENERAL_SERVER_UNLOCK(&_mappingLock);
 
-  HttpHandler* handler = element._handler;
-  _handlers.erase(handler);
+  if (handlers.empty()) {
+    LOG_DEBUG("cannot find a finished handler for the task");
+    return;
+  }
 
-  GENERAL_SERVER_UNLOCK(&_mappingLock);
+  for (auto handler : handlers) {
+    HttpResponse * response = handler->getResponse();
 
-  HttpResponse * response = handler->getResponse();
+    if (response == nullptr) {
+      basics::Exception err(TRI_ERROR_INTERNAL, 
+                            "no response received from handler",
+                            __FILE__, __LINE__);
 
-  if (response == nullptr) {
-    basics::Exception err(TRI_ERROR_INTERNAL, 
-                          "no response received from handler",
-                          __FILE__, __LINE__);
+      handler->handleError(err);
+      response = handler->getResponse();
+    }
 
-    handler->handleError(err);
-    response = handler->getResponse();
-  }
+    if (response == nullptr) {
+      LOG_ERROR("cannot get any response");
+    }
+    else {
+      task->handleResponse(handler, response);
+    }
 
-  if (response == nullptr) {
     delete handler;
-    LOG_ERROR("cannot get any response");
-
-    return;
   }
 
-  handler->RequestStatisticsAgent::transfer(task);
-
-  task->handleResponse(response);
-          
-  delete handler;
-              
-  task->processRead();
+  // process the requests that can be processed now
+  while (task->processRead()) {
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -507,7 +519,7 @@ bool HttpServer::handleRequest (HttpCommTask* task, HttpHandler* handler) {
       Handler::status_t status = handleRequestDirectly(task, handler);
 
       if (status.status != Handler::HANDLER_REQUEUE) {
-        shutdownHandlerByTask(task);
+        shutdownHandler(handler);
         return true;
       }
     }
@@ -526,7 +538,7 @@ bool HttpServer::handleRequest (HttpCommTask* task, HttpHandler* handler) {
 
         LOG_WARNING("task is indirect, but handler failed to create a job - this cannot work!");
 
-        shutdownHandlerByTask(task);
+        shutdownHandler(handler);
         return false;
       }
 
@@ -540,7 +552,7 @@ bool HttpServer::handleRequest (HttpCommTask* task, HttpHandler* handler) {
 
       LOG_WARNING("no dispatcher is known");
 
-      shutdownHandlerByTask(task);
+      shutdownHandler(handler);
       return false;
     }
   }
@@ -682,10 +694,9 @@ Handler::status_t HttpServer::handleRequestDirectly (HttpCommTask* task, HttpHan
     }
 
     RequestStatisticsAgentSetRequestEnd(handler);
-    handler->RequestStatisticsAgent::transfer(task);
 
     if (response != nullptr) {
-      task->handleResponse(response);
+      task->handleResponse(handler, response);
     }
     else {
       LOG_ERROR("cannot get any response");
@@ -711,58 +722,105 @@ Handler::status_t HttpServer::handleRequestDirectly (HttpCommTask* task, HttpHan
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief shut downs a handler for a task
+/// @brief shut downs all handlers of a task
 ////////////////////////////////////////////////////////////////////////////////
 
 void HttpServer::shutdownHandlerByTask (Task* task) {
+  std::vector<HttpHandler*> handlers;
+
   GENERAL_SERVER_LOCK(&_mappingLock);
 
   // remove the task from the map
-  auto&& it = _task2handler.find(task);
+  auto&& range = _task2handler.equal_range(task);
 
-  if (it == _task2handler.end() || it->second._task != task) {
+  if (range.first == range.second) {
     LOG_DEBUG("shutdownHandler called, but no handler is known for task");
 
     GENERAL_SERVER_UNLOCK(&_mappingLock);
     return;
   }
 
-  handler_task_job_t& element = it->second;
-  HttpHandler* handler = element._handler;
+  for (auto it = range.first;  it != range.second;  ++it) {
+    HttpHandler* handler = releaseHandler(it->second);
 
-  _task2handler.erase(it);
+    if (handler != nullptr) {
+      handlers.push_back(handler);
+    }
+  }
 
-  // check if the handler contains a job or not
-  auto&& jt = _handlers.find(handler);
+  _task2handler.erase(range.first, range.second);
 
-  if (jt == _handlers.end() || jt->second._handler != handler) {
-    LOG_DEBUG("shutdownHandler called, but handler of task is unknown");
+  GENERAL_SERVER_UNLOCK(&_mappingLock);
+
+  for (auto handler : handlers) {
+    delete handler;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shut downs a handler
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpServer::shutdownHandler (HttpHandler* handler) {
+  GENERAL_SERVER_LOCK(&_mappingLock);
+
+  auto&& it = _handlers.find(handler);
+
+  if (it == _handlers.end() || it->second._handler != handler) {
+    LOG_DEBUG("shutdownHandler called, but handler is unknown");
 
     GENERAL_SERVER_UNLOCK(&_mappingLock);
     return;
   }
 
-  // if we do not know a job, delete handler
-  handler_task_job_t& element2 = jt->second;
-  Job* job = element2._job;
+  // remove the handler from the task map
+  auto&& range = _task2handler.equal_range(it->second._task);
 
-  if (job == nullptr) {
-    _handlers.erase(jt);
+  for (auto jt = range.first;  jt != range.second;  ++jt) {
+    if (jt->second == handler) {
+      _task2handler.erase(jt);
+      break;
+    }
+  }
 
-    GENERAL_SERVER_UNLOCK(&_mappingLock);
+  handler = releaseHandler(handler);
+
+  GENERAL_SERVER_UNLOCK(&_mappingLock);
 
+  if (handler != nullptr) {
     delete handler;
-    return;
   }
+}
 
-  // initiate shutdown if a job is known
-  else {
-    element2._task = nullptr;
-    job->beginShutdown();
+////////////////////////////////////////////////////////////////////////////////
+/// @brief releases a handler, the mapping lock must be held
+///
+/// returns the handler if it must be deleted. if the handler still has a job,
+/// the job is shut down and deletes the handler when done
+////////////////////////////////////////////////////////////////////////////////
 
-    GENERAL_SERVER_UNLOCK(&_mappingLock);
-    return;
+HttpHandler* HttpServer::releaseHandler (HttpHandler* handler) {
+  auto&& it = _handlers.find(handler);
+
+  if (it == _handlers.end() || it->second._handler != handler) {
+    LOG_DEBUG("shutdownHandler called, but handler of task is unknown");
+    return nullptr;
+  }
+
+  // if we do not know a job, delete handler
+  handler_task_job_t& element = it->second;
+  Job* job = element._job;
+
+  if (job == nullptr) {
+    _handlers.erase(it);
+    return handler;
   }
+
+  // initiate shutdown if a job is known
+  element._task = nullptr;
+  job->beginShutdown();
+
+  return nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -778,7 +836,7 @@ void HttpServer::registerHandler (HttpHandler* handler, HttpCommTask* task) {
   element._job = nullptr;
 
   _handlers[handler] = element;
-  _task2handler[task] = element;
+  _task2handler.emplace(task, handler);
 
   GENERAL_SERVER_UNLOCK(&_mappingLock);
 }
@@ -291,11 +291,23 @@ namespace triagens {
         Handler::status_t handleRequestDirectly (HttpCommTask* task, HttpHandler * handler);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief shut downs a handler for a task
+/// @brief shut downs all handlers of a task
 ////////////////////////////////////////////////////////////////////////////////
 
         void shutdownHandlerByTask (Task* task);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shut downs a handler
+////////////////////////////////////////////////////////////////////////////////
+
+        void shutdownHandler (HttpHandler* handler);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief releases a handler, the mapping lock must be held
+////////////////////////////////////////////////////////////////////////////////
+
+        HttpHandler* releaseHandler (HttpHandler* handler);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief registers a task
 ////////////////////////////////////////////////////////////////////////////////
@@ -375,10 +387,12 @@ namespace triagens {
         std::unordered_map<HttpHandler*, handler_task_job_t> _handlers;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief map task to handler
+/// @brief map task to its handlers
+///
+/// a task has several handlers if it executes pipelined requests
 ////////////////////////////////////////////////////////////////////////////////
 
-        std::unordered_map<Task*, handler_task_job_t> _task2handler;
+        std::unordered_multimap<Task*, HttpHandler*> _task2handler;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief keep-alive timeout
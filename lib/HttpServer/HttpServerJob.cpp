@@ -149,6 +149,14 @@ Job::status_t HttpServerJob::work () {
   }
 
   _handler->finalizeExecute();
+
+  // compress here and not in the comm task, as that runs in the scheduler
+  // thread. results of detached jobs are fetched later, possibly with
+  // different request headers
+  if (! _isDetached) {
+    _handler->compressResponse();
+  }
+
   RequestStatisticsAgentSetRequestEnd(_handler);
 
   LOG_TRACE("finished job %p with status %d", (void*) this, (int) status.status);
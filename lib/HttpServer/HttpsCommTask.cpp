@@ -346,18 +346,25 @@ bool HttpsCommTask::trySSLWrite () {
   size_t len = 0;
 
   if (nullptr != _writeBuffer) {
-    TRI_ASSERT(_writeBuffer->length() >= writeLength);
+    size_t const total = writeBufferLength();
+    TRI_ASSERT(total >= writeLength);
 
     // size_t is unsigned, should never get < 0
-    len = _writeBuffer->length() - writeLength;
+    len = total - writeLength;
   }
 
   // write buffer to SSL connection
   int nr = 0;
 
   if (0 < len) {
+    // SSL_write cannot gather, so the segments are written one after the
+    // other. a retry uses the same segment and offset, as SSL requires
+    char const* data;
+    size_t length;
+    currentWriteSegment(data, length);
+
     ERR_clear_error();
-    nr = SSL_write(_ssl, _writeBuffer->begin() + writeLength, (int) len);
+    nr = SSL_write(_ssl, data, (int) length);
 
     if (nr <= 0) {
       int res = SSL_get_error(_ssl, nr);
@@ -414,9 +421,7 @@ bool HttpsCommTask::trySSLWrite () {
   }
 
   if (len == 0) {
-    if (ownBuffer) {
-      delete _writeBuffer;
-    }
+    releaseWriteBuffer();
 
     callCompletedWriteBuffer = true;
   }
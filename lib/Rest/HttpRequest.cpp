@@ -510,6 +510,63 @@ int HttpRequest::setBody (char const* newBody,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpRequest::adoptBody (char* memory,
+                             size_t offset,
+                             size_t length) {
+  TRI_ASSERT(memory[offset + length] == '\0');
+
+  _freeables.push_back(memory);
+
+  _body = memory + offset;
+  _contentLength = (int64_t) length;
+  _bodySize = length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+int HttpRequest::uncompressBody () {
+  bool found;
+  char const* encoding = header("content-encoding", found);
+
+  if (! found) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  if (! TRI_CaseEqualString(encoding, "gzip") &&
+      ! TRI_CaseEqualString(encoding, "x-gzip") &&
+      ! TRI_CaseEqualString(encoding, "deflate")) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+
+  int res = TRI_InflateStringBuffer(buffer.stringBuffer(), body(), bodySize(), 16384);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res == TRI_ERROR_OUT_OF_MEMORY ? res : TRI_ERROR_BAD_PARAMETER;
+  }
+
+  if (buffer.empty()) {
+    res = setBody("", 0);
+  }
+  else {
+    size_t const length = buffer.length();
+    adoptBody(buffer.steal(), 0, length);
+  }
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    _headers.erase("content-encoding");
+  }
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief sets a header field
 ////////////////////////////////////////////////////////////////////////////////
@@ -521,6 +521,26 @@ namespace triagens {
 
         int setBody (char const* newBody, size_t length);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief take over a memory block that contains the body
+///
+/// the body starts at the specified offset, and must be followed by a NUL
+/// byte. the memory must have been allocated in TRI_UNKNOWN_MEM_ZONE and is
+/// freed together with the request. this avoids copying big bodies
+////////////////////////////////////////////////////////////////////////////////
+
+        void adoptBody (char* memory, size_t offset, size_t length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief uncompress the body if it was sent with a content-encoding of gzip
+/// or deflate
+///
+/// the content-encoding header is removed afterwards, so calling this
+/// more than once is harmless
+////////////////////////////////////////////////////////////////////////////////
+
+        int uncompressBody ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief set a header field
 ////////////////////////////////////////////////////////////////////////////////
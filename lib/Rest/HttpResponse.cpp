@@ -842,13 +842,23 @@ void HttpResponse::headResponse (size_t size) {
 ////////////////////////////////////////////////////////////////////////////////
 
 int HttpResponse::deflate (size_t bufferSize) {
-  int res = _body.deflate(bufferSize);
+  return compress(false, Z_DEFAULT_COMPRESSION, bufferSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compresses the response body with the specified compression level
+////////////////////////////////////////////////////////////////////////////////
+
+int HttpResponse::compress (bool gzip,
+                            int level,
+                            size_t bufferSize) {
+  int res = _body.compress(bufferSize, level, gzip);
 
   if (res != TRI_ERROR_NO_ERROR) {
     return res;
   }
 
-  setHeader("content-encoding", strlen("content-encoding"), "deflate");
+  setHeader("content-encoding", strlen("content-encoding"), gzip ? "gzip" : "deflate");
   return TRI_ERROR_NO_ERROR;
 }
 
@@ -368,6 +368,17 @@ namespace triagens {
 
         int deflate (size_t = 16384);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compresses the response body with the specified compression level
+///
+/// the body must already be set. sets the content-encoding header to gzip or
+/// deflate
+////////////////////////////////////////////////////////////////////////////////
+
+        int compress (bool,
+                      int,
+                      size_t = 16384);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
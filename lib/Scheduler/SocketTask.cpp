@@ -32,6 +32,10 @@
 
 #include <errno.h>
 
+#ifdef TRI_HAVE_LINUX_SOCKETS
+#include <sys/uio.h>
+#endif
+
 #include "Basics/MutexLocker.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/logging.h"
@@ -58,6 +62,7 @@ SocketTask::SocketTask (TRI_socket_t socket, double keepAliveTimeout)
     _commSocket(socket),
     _keepAliveTimeout(keepAliveTimeout),
     _writeBuffer(nullptr),
+    _writeSegments(),
 #ifdef TRI_ENABLE_FIGURES
     _writeBufferStatistics(0),
 #endif
@@ -89,6 +94,10 @@ SocketTask::~SocketTask () {
     delete _writeBuffer;
   }
 
+  for (auto segment : _writeSegments) {
+    delete segment;
+  }
+
 #ifdef TRI_ENABLE_FIGURES
 
   if (_writeBufferStatistics != nullptr) {
@@ -176,14 +185,49 @@ bool SocketTask::handleWrite () {
   size_t len = 0;
 
   if (nullptr != _writeBuffer) {
-    TRI_ASSERT(_writeBuffer->length() >= writeLength);
-    len = _writeBuffer->length() - writeLength;
+    size_t const total = writeBufferLength();
+    TRI_ASSERT(total >= writeLength);
+    len = total - writeLength;
   }
 
   int nr = 0;
 
   if (0 < len) {
-    nr = TRI_WRITE_SOCKET(_commSocket, _writeBuffer->begin() + writeLength, (int) len, 0);
+    if (_writeSegments.empty()) {
+      nr = TRI_WRITE_SOCKET(_commSocket, _writeBuffer->begin() + writeLength, (int) len, 0);
+    }
+    else {
+#ifdef TRI_HAVE_LINUX_SOCKETS
+      // gather the unsent parts of all segments, so they go out with a
+      // single system call
+      struct iovec iov[MAX_WRITE_SEGMENTS];
+      int n = 0;
+      size_t offset = writeLength;
+
+      for (size_t i = 0; i <= _writeSegments.size() && n < (int) MAX_WRITE_SEGMENTS; ++i) {
+        StringBuffer* segment = (i == 0 ? _writeBuffer : _writeSegments[i - 1]);
+        size_t const length = segment->length();
+
+        if (offset >= length) {
+          offset -= length;
+          continue;
+        }
+
+        iov[n].iov_base = const_cast<char*>(segment->begin()) + offset;
+        iov[n].iov_len = length - offset;
+        offset = 0;
+        ++n;
+      }
+
+      nr = (int) writev(_commSocket.fileDescriptor, iov, n);
+#else
+      char const* data;
+      size_t length;
+      currentWriteSegment(data, length);
+
+      nr = TRI_WRITE_SOCKET(_commSocket, data, (int) length, 0);
+#endif
+    }
 
     if (nr < 0) {
       if (errno == EINTR) {
@@ -203,9 +247,7 @@ bool SocketTask::handleWrite () {
   }
 
   if (len == 0) {
-    if (nullptr != _writeBuffer && ownBuffer) {
-      delete _writeBuffer;
-    }
+    releaseWriteBuffer();
 
     callCompletedWriteBuffer = true;
   }
@@ -256,6 +298,10 @@ void SocketTask::setWriteBuffer (StringBuffer* buffer,
   if (_writeBufferStatistics != nullptr) {
     _writeBufferStatistics->_writeStart = TRI_StatisticsTime();
     _writeBufferStatistics->_sentBytes += buffer->length();
+
+    for (auto segment : _writeSegments) {
+      _writeBufferStatistics->_sentBytes += segment->length();
+    }
   }
 
 #endif
@@ -300,6 +346,95 @@ void SocketTask::setWriteBuffer (StringBuffer* buffer,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sets an active write buffer, followed by further segments
+////////////////////////////////////////////////////////////////////////////////
+
+void SocketTask::setWriteBuffer (StringBuffer* buffer,
+                                 std::vector<StringBuffer*>& segments,
+                                 TRI_request_statistics_t* statistics) {
+  TRI_ASSERT(_writeSegments.empty());
+
+  for (auto segment : segments) {
+    if (segment->empty()) {
+      delete segment;
+    }
+    else {
+      _writeSegments.push_back(segment);
+    }
+  }
+
+  segments.clear();
+
+  if (buffer->empty() && ! _writeSegments.empty()) {
+    // the first segment must not be empty, as an empty write buffer
+    // completes the write immediately
+    delete buffer;
+    buffer = _writeSegments.front();
+    _writeSegments.erase(_writeSegments.begin());
+  }
+
+  setWriteBuffer(buffer, statistics, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the total length of the write buffer and its segments
+////////////////////////////////////////////////////////////////////////////////
+
+size_t SocketTask::writeBufferLength () const {
+  if (_writeBuffer == nullptr) {
+    return 0;
+  }
+
+  size_t length = _writeBuffer->length();
+
+  for (auto segment : _writeSegments) {
+    length += segment->length();
+  }
+
+  return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the unsent part of the segment that is written next
+////////////////////////////////////////////////////////////////////////////////
+
+void SocketTask::currentWriteSegment (char const*& data,
+                                      size_t& length) const {
+  size_t offset = writeLength;
+
+  for (size_t i = 0; i <= _writeSegments.size(); ++i) {
+    StringBuffer const* segment = (i == 0 ? _writeBuffer : _writeSegments[i - 1]);
+
+    if (offset < segment->length()) {
+      data = segment->begin() + offset;
+      length = segment->length() - offset;
+      return;
+    }
+
+    offset -= segment->length();
+  }
+
+  data = nullptr;
+  length = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief frees the write buffer and its segments after they have been sent
+////////////////////////////////////////////////////////////////////////////////
+
+void SocketTask::releaseWriteBuffer () {
+  if (nullptr != _writeBuffer && ownBuffer) {
+    delete _writeBuffer;
+  }
+
+  for (auto segment : _writeSegments) {
+    delete segment;
+  }
+
+  _writeSegments.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checks for presence of an active write buffer
 ////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +73,8 @@ namespace triagens {
       private:
         static size_t const READ_BLOCK_SIZE = 10000;
 
+        static size_t const MAX_WRITE_SEGMENTS = 16;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -165,6 +167,38 @@ namespace triagens {
                              TRI_request_statistics_t*,
                              bool ownBuffer = true);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sets an active write buffer, followed by further segments
+///
+/// the segments are sent right after the write buffer, without copying them
+/// into it. the task takes over the write buffer and the segments
+////////////////////////////////////////////////////////////////////////////////
+
+        void setWriteBuffer (basics::StringBuffer*,
+                             std::vector<basics::StringBuffer*>&,
+                             TRI_request_statistics_t*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the total length of the write buffer and its segments
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t writeBufferLength () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the unsent part of the segment that is written next
+///
+/// used for connections that cannot write several segments at once
+////////////////////////////////////////////////////////////////////////////////
+
+        void currentWriteSegment (char const*&,
+                                  size_t&) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief frees the write buffer and its segments after they have been sent
+////////////////////////////////////////////////////////////////////////////////
+
+        void releaseWriteBuffer ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checks for presence of an active write buffer
 ////////////////////////////////////////////////////////////////////////////////
@@ -243,6 +277,14 @@ namespace triagens {
 
         basics::StringBuffer* _writeBuffer;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief further segments of the current write, sent after the write buffer
+///
+/// the segments are always owned by the task
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<basics::StringBuffer*> _writeSegments;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the current write buffer statistics
 ////////////////////////////////////////////////////////////////////////////////
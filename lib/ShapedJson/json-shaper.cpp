@@ -375,6 +375,7 @@ char const* TRI_AttributeNameShapePid (TRI_shaper_t* shaper,
 
 int TRI_InitShaper (TRI_shaper_t* shaper, TRI_memory_zone_t* zone) {
   shaper->_memoryZone = zone;
+  shaper->_compressStrings = false;
 
   int res = TRI_InitAssociativeSynced(&shaper->_attributePathsByName,
                                       zone,
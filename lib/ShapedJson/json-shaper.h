@@ -92,6 +92,8 @@ typedef struct TRI_shaper_s {
   TRI_mutex_t _attributePathLock;
 
   TRI_memory_zone_t* _memoryZone;
+
+  bool _compressStrings;
 }
 TRI_shaper_t;
 
@@ -37,6 +37,7 @@
 #include "Basics/tri-strings.h"
 #include "Basics/vector.h"
 #include "ShapedJson/json-shaper.h"
+#include "Zip/zip.h"
 
 // #define DEBUG_JSON_SHAPER 1
 
@@ -117,6 +118,12 @@ void TRI_PrintShape (TRI_shaper_t* shaper, TRI_shape_t const* shape, int indent)
              (unsigned int) shape->_dataSize);
       break;
 
+    case TRI_SHAPE_COMPRESSED_STRING:
+      printf("%*sCOMPRESSED STRING sid: %u, data size: %u\n", indent, "",
+             (unsigned int) shape->_sid,
+             (unsigned int) shape->_dataSize);
+      break;
+
     case TRI_SHAPE_ARRAY:
       array = (TRI_array_shape_t const*) shape;
       n = array->_fixedEntries + array->_variableEntries;
@@ -258,6 +265,15 @@ static void PrintShapeValues (TRI_shape_value_t* values,
                p->_value + sizeof(TRI_shape_length_long_string_t));
         break;
 
+      case TRI_SHAPE_COMPRESSED_STRING:
+        printf("COMPRESSED STRING aid: %u, sid: %u, fixed: %s, size: %u, length: %u",
+               (unsigned int) p->_aid,
+               (unsigned int) p->_sid,
+               p->_fixedSized ? "yes" : "no",
+               (unsigned int) p->_size,
+               (unsigned int) TRI_LengthCompressedStringShapedJson(p->_value));
+        break;
+
       case TRI_SHAPE_ARRAY:
         printf("ARRAY aid: %u, sid: %u, fixed: %s, size: %u",
                (unsigned int) p->_aid,
@@ -312,6 +328,7 @@ static int WeightShapeType (TRI_shape_type_t type) {
     case TRI_SHAPE_NUMBER:                 return 300;
     case TRI_SHAPE_SHORT_STRING:           return 400;
     case TRI_SHAPE_LONG_STRING:            return 500;
+    case TRI_SHAPE_COMPRESSED_STRING:      return 550;
     case TRI_SHAPE_HOMOGENEOUS_SIZED_LIST: return 600;
     case TRI_SHAPE_ARRAY:                  return 700;
     case TRI_SHAPE_LIST:                   return 800;
@@ -411,7 +428,7 @@ static bool FillShapeValueNumber (TRI_shaper_t* shaper, TRI_shape_value_t* dst,
 /// @brief converts a string into TRI_shape_value_t
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool FillShapeValueString (TRI_shaper_t* shaper, TRI_shape_value_t* dst, TRI_json_t const* json) {
+static bool FillShapeValueString (TRI_shaper_t* shaper, TRI_shape_value_t* dst, TRI_json_t const* json, bool create) {
   char* ptr;
 
   if (json->_value._string.length <= TRI_SHAPE_SHORT_STRING_CUT) { // includes '\0'
@@ -433,6 +450,13 @@ static bool FillShapeValueString (TRI_shaper_t* shaper, TRI_shape_value_t* dst,
            json->_value._string.data,
            json->_value._string.length);
   }
+  else if (TRI_FillShapeValueCompressedString(shaper,
+                                              dst,
+                                              json->_value._string.data,
+                                              json->_value._string.length - 1,
+                                              create)) {
+    return true;
+  }
   else {
     dst->_type = TRI_SHAPE_LONG_STRING;
     dst->_sid = BasicShapes::TRI_SHAPE_SID_LONG_STRING;
@@ -952,7 +976,7 @@ static bool FillShapeValueJson (TRI_shaper_t* shaper,
 
     case TRI_JSON_STRING:
     case TRI_JSON_STRING_REFERENCE:
-      return FillShapeValueString(shaper, dst, json);
+      return FillShapeValueString(shaper, dst, json, create);
 
     case TRI_JSON_OBJECT:
       return FillShapeValueArray(shaper, dst, json, level, create);
@@ -1029,6 +1053,35 @@ static TRI_json_t* JsonShapeDataLongString (TRI_shaper_t* shaper,
   return TRI_CreateStringCopyJson(shaper->_memoryZone, data, l - 1);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a data compressed string blob into a json object
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_json_t* JsonShapeDataCompressedString (TRI_shaper_t* shaper,
+                                                  TRI_shape_t const* shape,
+                                                  char const* data,
+                                                  uint64_t size) {
+  size_t const l = TRI_LengthCompressedStringShapedJson(data);
+  char* value = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, l, false));
+
+  if (value == nullptr) {
+    return nullptr;
+  }
+
+  if (! TRI_UncompressStringShapedJson(data, value)) {
+    TRI_Free(shaper->_memoryZone, value);
+    return nullptr;
+  }
+
+  TRI_json_t* json = TRI_CreateStringJson(shaper->_memoryZone, value, l - 1);
+
+  if (json == nullptr) {
+    TRI_Free(shaper->_memoryZone, value);
+  }
+
+  return json;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief converts a data array blob into a json object
 ////////////////////////////////////////////////////////////////////////////////
@@ -1400,6 +1453,9 @@ static TRI_json_t* JsonShapeData (TRI_shaper_t* shaper,
     case TRI_SHAPE_LONG_STRING:
       return JsonShapeDataLongString(shaper, shape, data, size);
 
+    case TRI_SHAPE_COMPRESSED_STRING:
+      return JsonShapeDataCompressedString(shaper, shape, data, size);
+
     case TRI_SHAPE_ARRAY:
       return JsonShapeDataArray(shaper, shape, data, size);
 
@@ -1563,6 +1619,35 @@ static bool StringifyJsonShapeDataLongString (TRI_shaper_t* shaper,
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stringifies a data compressed string blob into a string buffer
+////////////////////////////////////////////////////////////////////////////////
+
+static bool StringifyJsonShapeDataCompressedString (TRI_shaper_t* shaper,
+                                                    TRI_string_buffer_t* buffer,
+                                                    TRI_shape_t const* shape,
+                                                    char const* data,
+                                                    uint64_t size) {
+  size_t const l = TRI_LengthCompressedStringShapedJson(data);
+  char* value = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, l, false));
+
+  if (value == nullptr) {
+    return false;
+  }
+
+  bool ok = TRI_UncompressStringShapedJson(data, value);
+
+  if (ok) {
+    ok = (TRI_AppendCharStringBuffer(buffer, '"') == TRI_ERROR_NO_ERROR &&
+          TRI_AppendJsonEncodedStringStringBuffer(buffer, value, true) == TRI_ERROR_NO_ERROR &&
+          TRI_AppendCharStringBuffer(buffer, '"') == TRI_ERROR_NO_ERROR);
+  }
+
+  TRI_Free(shaper->_memoryZone, value);
+
+  return ok;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief stringifies a data array blob into a json object
 ////////////////////////////////////////////////////////////////////////////////
@@ -2044,6 +2129,9 @@ static bool StringifyJsonShapeData (TRI_shaper_t* shaper,
     case TRI_SHAPE_LONG_STRING:
       return StringifyJsonShapeDataLongString(shaper, buffer, shape, data, size);
 
+    case TRI_SHAPE_COMPRESSED_STRING:
+      return StringifyJsonShapeDataCompressedString(shaper, buffer, shape, data, size);
+
     case TRI_SHAPE_ARRAY:
       return StringifyJsonShapeDataArray(shaper, buffer, shape, data, size, true, nullptr);
 
@@ -2412,6 +2500,128 @@ bool TRI_StringValueShapedJson (TRI_shape_t const* shape,
   return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the length of a compressed string, including the final '\0'
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_LengthCompressedStringShapedJson (char const* data) {
+  return (size_t) * (TRI_shape_length_long_string_t const*) data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief uncompresses a compressed string into buffer
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_UncompressStringShapedJson (char const* data,
+                                     char* buffer) {
+  TRI_shape_length_long_string_t l = * (TRI_shape_length_long_string_t const*) data;
+  data += sizeof(TRI_shape_length_long_string_t);
+
+  TRI_shape_length_long_string_t c = * (TRI_shape_length_long_string_t const*) data;
+  data += sizeof(TRI_shape_length_long_string_t);
+
+  uLongf length = (uLongf) (l - 1);
+
+  if (uncompress((Bytef*) buffer, &length, (Bytef const*) data, (uLong) c) != Z_OK ||
+      length != (uLongf) (l - 1)) {
+    LOG_ERROR("cannot uncompress string value");
+    buffer[0] = '\0';
+    return false;
+  }
+
+  buffer[l - 1] = '\0';
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns a copy of a compressed string in the layout of a long
+/// string, or nullptr on error
+////////////////////////////////////////////////////////////////////////////////
+
+char* TRI_UncompressLongStringShapedJson (TRI_memory_zone_t* zone,
+                                          char const* data) {
+  size_t const l = TRI_LengthCompressedStringShapedJson(data);
+  char* result = static_cast<char*>(TRI_Allocate(zone, sizeof(TRI_shape_length_long_string_t) + l, false));
+
+  if (result == nullptr) {
+    return nullptr;
+  }
+
+  * (TRI_shape_length_long_string_t*) result = (TRI_shape_length_long_string_t) l;
+
+  if (! TRI_UncompressStringShapedJson(data, result + sizeof(TRI_shape_length_long_string_t))) {
+    TRI_Free(zone, result);
+    return nullptr;
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a string into a compressed TRI_shape_value_t
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_FillShapeValueCompressedString (TRI_shaper_t* shaper,
+                                         TRI_shape_value_t* dst,
+                                         char const* value,
+                                         size_t length,
+                                         bool create) {
+  if (! shaper->_compressStrings ||
+      length + 1 < TRI_SHAPE_COMPRESSED_STRING_CUT ||
+      length >= (size_t) UINT32_MAX) {
+    return false;
+  }
+
+  size_t const header = 2 * sizeof(TRI_shape_length_long_string_t);
+  uLongf compressedLength = compressBound((uLong) length);
+  char* ptr = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, header + compressedLength, false));
+
+  if (ptr == nullptr) {
+    return false;
+  }
+
+  // always use the same compression level, so equal strings are stored with
+  // equal bytes
+  if (compress2((Bytef*) (ptr + header), &compressedLength, (Bytef const*) value, (uLong) length, Z_DEFAULT_COMPRESSION) != Z_OK ||
+      header + compressedLength >= sizeof(TRI_shape_length_long_string_t) + length + 1) {
+    // not worth it
+    TRI_Free(shaper->_memoryZone, ptr);
+    return false;
+  }
+
+  TRI_compressed_string_shape_t* shape = static_cast<TRI_compressed_string_shape_t*>(TRI_Allocate(shaper->_memoryZone, sizeof(TRI_compressed_string_shape_t), true));
+
+  if (shape == nullptr) {
+    TRI_Free(shaper->_memoryZone, ptr);
+    return false;
+  }
+
+  shape->base._size = sizeof(TRI_compressed_string_shape_t);
+  shape->base._type = TRI_SHAPE_COMPRESSED_STRING;
+  shape->base._dataSize = TRI_SHAPE_SIZE_VARIABLE;
+
+  // note: if 'found' is not a nullptr, the shaper will have freed variable 'shape'!
+  TRI_shape_t const* found = shaper->findShape(shaper, &shape->base, create);
+
+  if (found == nullptr) {
+    TRI_Free(shaper->_memoryZone, shape);
+    TRI_Free(shaper->_memoryZone, ptr);
+    return false;
+  }
+
+  dst->_type = found->_type;
+  dst->_sid = found->_sid;
+  dst->_fixedSized = false;
+  dst->_size = header + compressedLength;
+  dst->_value = ptr;
+
+  * (TRI_shape_length_long_string_t*) ptr = (TRI_shape_length_long_string_t) (length + 1);
+  * (TRI_shape_length_long_string_t*) (ptr + sizeof(TRI_shape_length_long_string_t)) = (TRI_shape_length_long_string_t) compressedLength;
+
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief stringifies a data blob into a string buffer
 ////////////////////////////////////////////////////////////////////////////////
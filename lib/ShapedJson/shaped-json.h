@@ -64,6 +64,8 @@
 /// - @ref TRI_short_string_shape_t for short strings of size less then
 ///     @ref TRI_SHAPE_SHORT_STRING_CUT, this includes the trailing null
 /// - @ref TRI_long_string_shape_t for strings longer than the above limit
+/// - @ref TRI_compressed_string_shape_t for deflated long strings, used in
+///     collections with the @c compressStrings property
 /// - @ref TRI_list_shape_t for arbitrary lists
 /// - @ref TRI_homogeneous_list_shape_t for lists of objects of the same shape
 /// - @ref TRI_homogeneous_sized_list_shape_t for lists of objects of the same
@@ -180,6 +182,13 @@ struct TRI_string_buffer_s;
 
 #define TRI_SHAPE_SHORT_STRING_CUT 7
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimum size of strings that are compressed, including the
+/// trailing '\0'
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_SHAPE_COMPRESSED_STRING_CUT 256
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief indicator for variable sized data
 ////////////////////////////////////////////////////////////////////////////////
@@ -228,7 +237,8 @@ typedef enum {
   TRI_SHAPE_ARRAY                  = 6,
   TRI_SHAPE_LIST                   = 7,
   TRI_SHAPE_HOMOGENEOUS_LIST       = 8,
-  TRI_SHAPE_HOMOGENEOUS_SIZED_LIST = 9
+  TRI_SHAPE_HOMOGENEOUS_SIZED_LIST = 9,
+  TRI_SHAPE_COMPRESSED_STRING      = 10
 }
 TRI_shape_type_e;
 
@@ -522,6 +532,65 @@ typedef struct TRI_long_string_shape_s {
 }
 TRI_long_string_shape_t;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief json shape, compressed string
+///
+/// A @c TRI_compressed_string_shape_t describes a long string value whose
+/// characters are stored deflated. It is not a basic shape, so the shaper of
+/// a collection creates it on first use. There are no additional attributes.
+///
+/// <table border>
+///   <tr>
+///     <td>@c TRI_shape_sid_t</td>
+///     <td>_sid</td>
+///     <td>shape identifier</td>
+///   </tr>
+///   <tr>
+///     <td>@c TRI_shape_type_t</td>
+///     <td>_type</td>
+///     <td>always @c TRI_SHAPE_COMPRESSED_STRING</td>
+///   </tr>
+///   <tr>
+///     <td>@c TRI_shape_size_t</td>
+///     <td>_size</td>
+///     <td>total size of the shape, always sizeof(TRI_compressed_string_shape_t)</td>
+///   </tr>
+///   <tr>
+///     <td>@c TRI_shape_size_t</td>
+///     <td>_dataSize</td>
+///     <td>always @c TRI_SHAPE_SIZE_VARIABLE</td>
+///   </tr>
+/// </table>
+///
+/// The memory layout of the corresponding shaped JSON is as follows
+///
+/// <table border>
+///   <tr>
+///     <td>@c TRI_shape_length_long_string_t</td>
+///     <td>_length</td>
+///     <td>the length of the uncompressed string including the final '\0'</td>
+///   </tr>
+///   <tr>
+///     <td>@c TRI_shape_length_long_string_t</td>
+///     <td>_compressedLength</td>
+///     <td>the length of the deflated data</td>
+///   </tr>
+///   <tr>
+///     <td>@c char</td>
+///     <td>_value[_compressedLength]</td>
+///     <td>the deflated string, without the final '\0'</td>
+///   </tr>
+/// </table>
+///
+/// The compression level is fixed, so equal strings are always stored with
+/// equal bytes. Indexes that compare shaped values with memcmp rely on this.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct TRI_compressed_string_shape_s {
+  TRI_shape_t base;
+}
+TRI_compressed_string_shape_t;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief json shape, array
 ///
@@ -1047,7 +1116,8 @@ void TRI_PrintShape (struct TRI_shaper_s* shaper,
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the string value encoded in a shaped json
 /// this will return the pointer to the string and the string length in the
-/// variables passed by reference
+/// variables passed by reference. compressed strings must be uncompressed
+/// with TRI_UncompressStringShapedJson instead
 ////////////////////////////////////////////////////////////////////////////////
 
 bool TRI_StringValueShapedJson (TRI_shape_t const*,
@@ -1055,6 +1125,44 @@ bool TRI_StringValueShapedJson (TRI_shape_t const*,
                                 char**,
                                 size_t*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a string into a compressed TRI_shape_value_t
+///
+/// returns false if the shaper does not compress strings, if the string is
+/// too short or does not compress well. the caller must then store it as
+/// a long string
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_FillShapeValueCompressedString (struct TRI_shaper_s*,
+                                         TRI_shape_value_t*,
+                                         char const*,
+                                         size_t,
+                                         bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the length of a compressed string, including the final '\0'
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_LengthCompressedStringShapedJson (char const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief uncompresses a compressed string into buffer
+///
+/// the buffer must hold TRI_LengthCompressedStringShapedJson() bytes. the
+/// string is terminated with '\0'
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_UncompressStringShapedJson (char const*,
+                                     char*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns a copy of a compressed string in the layout of a long
+/// string, or nullptr on error. the result must be freed with TRI_Free
+////////////////////////////////////////////////////////////////////////////////
+
+char* TRI_UncompressLongStringShapedJson (TRI_memory_zone_t*,
+                                          char const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief stringifies a data blob into a string buffer
 ////////////////////////////////////////////////////////////////////////////////
@@ -424,7 +424,7 @@ namespace triagens {
         _writeBuffer.appendText(ConnectionCloseHeader, strlen(ConnectionCloseHeader));
       }
       _writeBuffer.appendText("User-Agent: ArangoDB\r\n");
-      _writeBuffer.appendText("Accept-Encoding: deflate\r\n");
+      _writeBuffer.appendText("Accept-Encoding: gzip, deflate\r\n");
 
       // do basic authorization
       if (! _pathToBasicAuth.empty()) {
@@ -639,9 +639,21 @@ namespace triagens {
         return;
       }
 
-      // body is compressed using deflate. inflate it
+      // body is compressed using deflate or gzip. inflate it
       if (_result->isDeflated()) {
-        _readBuffer.inflate(_result->getBody(), 16384, _readBufferOffset);
+        int res = TRI_InflateStringBuffer(_result->getBody().stringBuffer(),
+                                          _readBuffer.c_str() + _readBufferOffset,
+                                          _result->getContentLength(),
+                                          16384);
+
+        if (res != TRI_ERROR_NO_ERROR) {
+          setErrorMessage("unable to uncompress response body", true);
+          // reset connection
+          this->close();
+          _state = DEAD;
+
+          return;
+        }
       }
 
       // body is not compressed
@@ -749,6 +761,26 @@ namespace triagens {
 
         // last chunk length was 0, therefore we are finished
         if (_nextChunkedSize == 0) {
+          // the chunks together form the compressed body
+          if (_result->isDeflated()) {
+            StringBuffer compressed(TRI_UNKNOWN_MEM_ZONE);
+            compressed.swap(&_result->getBody());
+
+            int res = TRI_InflateStringBuffer(_result->getBody().stringBuffer(),
+                                              compressed.c_str(),
+                                              compressed.length(),
+                                              16384);
+
+            if (res != TRI_ERROR_NO_ERROR) {
+              setErrorMessage("unable to uncompress response body", true);
+              // reset connection
+              this->close();
+              _state = DEAD;
+
+              return;
+            }
+          }
+
           _result->setResultType(SimpleHttpResult::COMPLETE);
 
           _state = FINISHED;
@@ -170,6 +170,20 @@ namespace triagens {
               (value[6] == 'e' || value[6] == 'E')) {
             _deflated = true;
           }
+          else if (valueLength == strlen("gzip") &&
+                   (value[0] == 'g' || value[0] == 'G') &&
+                   (value[1] == 'z' || value[1] == 'Z') &&
+                   (value[2] == 'i' || value[2] == 'I') &&
+                   (value[3] == 'p' || value[3] == 'P')) {
+            // the inflater detects the gzip header itself
+            _deflated = true;
+          }
+
+          if (_deflated) {
+            // the client hands out the uncompressed body, so the header must
+            // not be passed on, e.g. when a coordinator forwards a response
+            return;
+          }
         }
       }
 
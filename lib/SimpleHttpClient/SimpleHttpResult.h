@@ -178,7 +178,8 @@ namespace triagens {
       }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief returns true if "content-encoding: deflate"
+/// @brief returns true if "content-encoding: deflate" or "content-encoding:
+/// gzip"
 ////////////////////////////////////////////////////////////////////////////////
 
       bool isDeflated () const {
@@ -209,7 +209,8 @@ static int FillShapeValueNumber (TRI_shaper_t* shaper,
 
 static int FillShapeValueString (TRI_shaper_t* shaper,
                                  TRI_shape_value_t* dst,
-                                 v8::Handle<v8::String> const json) {
+                                 v8::Handle<v8::String> const json,
+                                 bool create) {
   char* ptr;
 
   TRI_Utf8ValueNFC str(TRI_UNKNOWN_MEM_ZONE, json);
@@ -245,6 +246,9 @@ static int FillShapeValueString (TRI_shaper_t* shaper,
       * ((TRI_shape_length_short_string_t*) ptr) = (TRI_shape_length_short_string_t) size + 1;
       memcpy(ptr + sizeof(TRI_shape_length_short_string_t), *str, size + 1);
     }
+    else if (TRI_FillShapeValueCompressedString(shaper, dst, *str, size, create)) {
+      return TRI_ERROR_NO_ERROR;
+    }
     else {
       dst->_type = TRI_SHAPE_LONG_STRING;
       dst->_sid = BasicShapes::TRI_SHAPE_SID_LONG_STRING;
@@ -875,11 +879,11 @@ static int FillShapeValueJson (v8::Isolate* isolate,
   }
 
   if (json->IsString()) {
-    return FillShapeValueString(shaper, dst, json->ToString());
+    return FillShapeValueString(shaper, dst, json->ToString(), create);
   }
 
   if (json->IsStringObject()) {
-    return FillShapeValueString(shaper, dst, v8::Handle<v8::StringObject>::Cast(json)->ValueOf());
+    return FillShapeValueString(shaper, dst, v8::Handle<v8::StringObject>::Cast(json)->ValueOf(), create);
   }
 
   else if (json->IsArray()) {
@@ -898,7 +902,7 @@ static int FillShapeValueJson (v8::Isolate* isolate,
         v8::Handle<v8::Value> result = toJson->Call(o, 0, &args);
 
         if (! result.IsEmpty()) {
-          return FillShapeValueString(shaper, dst, result->ToString());
+          return FillShapeValueString(shaper, dst, result->ToString(), create);
         }
       }
     }
@@ -1001,6 +1005,33 @@ static v8::Handle<v8::Value> JsonShapeDataLongString (v8::Isolate* isolate,
   return TRI_V8_PAIR_STRING(data, l - 1);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a data compressed string blob into a json object
+////////////////////////////////////////////////////////////////////////////////
+
+static v8::Handle<v8::Value> JsonShapeDataCompressedString (v8::Isolate* isolate,
+                                                            TRI_shaper_t* shaper,
+                                                            TRI_shape_t const* shape,
+                                                            char const* data,
+                                                            size_t size) {
+  v8::EscapableHandleScope scope(isolate);
+
+  size_t const l = TRI_LengthCompressedStringShapedJson(data);
+  char* value = static_cast<char*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, l, false));
+
+  if (value == nullptr || ! TRI_UncompressStringShapedJson(data, value)) {
+    if (value != nullptr) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, value);
+    }
+    return scope.Escape<v8::Value>(v8::Null(isolate));
+  }
+
+  v8::Handle<v8::Value> result = TRI_V8_PAIR_STRING(value, l - 1);
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, value);
+
+  return scope.Escape<v8::Value>(result);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief merges a data array blob into an existing json object
 ////////////////////////////////////////////////////////////////////////////////
@@ -1422,6 +1453,9 @@ static v8::Handle<v8::Value> JsonShapeData (v8::Isolate* isolate,
     case TRI_SHAPE_LONG_STRING:
       return JsonShapeDataLongString(isolate, shaper, shape, data, size);
 
+    case TRI_SHAPE_COMPRESSED_STRING:
+      return JsonShapeDataCompressedString(isolate, shaper, shape, data, size);
+
     case TRI_SHAPE_ARRAY:
       return JsonShapeDataArray(isolate, shaper, shape, data, size);
 
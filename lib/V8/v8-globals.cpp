@@ -75,6 +75,7 @@ TRI_v8_global_s::TRI_v8_global_s (v8::Isolate* isolate)
     ClientTransactionIDKey(),
     CodeKey(),
     CompatibilityKey(),
+    CompressStringsKey(),
     ContentTypeKey(),
     CoordTransactionIDKey(),
     DatabaseKey(),
@@ -162,6 +163,7 @@ TRI_v8_global_s::TRI_v8_global_s (v8::Isolate* isolate)
   ClientTransactionIDKey.Reset(isolate, TRI_V8_ASCII_STRING("clientTransactionID"));
   CodeKey.Reset(isolate, TRI_V8_ASCII_STRING("code"));
   CompatibilityKey.Reset(isolate, TRI_V8_ASCII_STRING("compatibility"));
+  CompressStringsKey.Reset(isolate, TRI_V8_ASCII_STRING("compressStrings"));
   ContentTypeKey.Reset(isolate, TRI_V8_ASCII_STRING("contentType"));
   CookiesKey.Reset(isolate, TRI_V8_ASCII_STRING("cookies"));
   CoordTransactionIDKey.Reset(isolate, TRI_V8_ASCII_STRING("coordTransactionID"));
@@ -662,6 +662,12 @@ typedef struct TRI_v8_global_s {
 
   v8::Persistent<v8::String> CompatibilityKey;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief "compressStrings" key name
+////////////////////////////////////////////////////////////////////////////////
+
+  v8::Persistent<v8::String> CompressStringsKey;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief "contentType" key name
 ////////////////////////////////////////////////////////////////////////////////
@@ -31,4 +31,22 @@ PREFIX=`echo ${OUTPUT} | sed -e 's:\.cpp$::'`
 test -f ${PREFIX}.hpp || exit 1
 test -f ${PREFIX}.cpp || exit 1
 
+#############################################################################
+## inline the header
+#############################################################################
+
+## bison >= 3.2 includes the generated header instead of copying it into
+## the parser. only the .cpp and .h files are kept, so put the header back
+## into the parser like older versions of bison do
+
+HEADER=`basename ${PREFIX}.hpp`
+
+if grep -q "^#include \"${HEADER}\"" ${PREFIX}.cpp;  then
+  awk -v header="${PREFIX}.hpp" -v line="#include \"${HEADER}\"" \
+    '$0 == line { while ((getline l < header) > 0) print l; next } { print }' \
+    ${PREFIX}.cpp > ${PREFIX}.cpp.tmp || exit 1
+
+  mv ${PREFIX}.cpp.tmp ${PREFIX}.cpp
+fi
+
 cp ${PREFIX}.hpp ${PREFIX}.h